@@ -0,0 +1,104 @@
+#include <vector>
+
+#include "Benchmark.h"
+#include "Common/Easings.h"
+#include "Common/KeyFrameAnimation.h"
+
+using namespace KashipanEngine;
+using KashipanEngine::Benchmark::DoNotOptimize;
+
+namespace {
+
+constexpr int kEaseSteps = 1024;
+constexpr float kDeltaTime = 1.0f / 60.0f;
+
+/// @brief 全要素にキーフレームを並べたアニメーションを作る
+KeyFrameAnimation MakeAnimation(int keyCount) {
+    KeyFrameAnimation animation;
+    for (int element = 0; element < static_cast<int>(KeyFrameElementType::kElementCount); ++element) {
+        for (int i = 1; i <= keyCount; ++i) {
+            animation.AddKeyFrame(static_cast<KeyFrameElementType>(element),
+                KeyFrame(static_cast<float>(i) * 0.5f, static_cast<float>(i * element), Ease::InOutCubic));
+        }
+    }
+    animation.SetLoop(true);
+    animation.Play();
+    return animation;
+}
+
+} // namespace
+
+//==================================================
+// Easings
+//==================================================
+
+KASHIPAN_BENCHMARK(Ease_InOutCubic1024) {
+    state.SetItemsPerOp(kEaseSteps);
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (int i = 0; i < kEaseSteps; ++i) {
+            sum += Ease::InOutCubic(static_cast<float>(i) / kEaseSteps, 0.0f, 100.0f);
+        }
+        DoNotOptimize(sum);
+    }
+}
+
+KASHIPAN_BENCHMARK(Ease_OutElastic1024) {
+    state.SetItemsPerOp(kEaseSteps);
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (int i = 0; i < kEaseSteps; ++i) {
+            sum += Ease::OutElastic(static_cast<float>(i) / kEaseSteps, 0.0f, 100.0f);
+        }
+        DoNotOptimize(sum);
+    }
+}
+
+KASHIPAN_BENCHMARK(Ease_OutBounce1024) {
+    state.SetItemsPerOp(kEaseSteps);
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (int i = 0; i < kEaseSteps; ++i) {
+            sum += Ease::OutBounce(static_cast<float>(i) / kEaseSteps, 0.0f, 100.0f);
+        }
+        DoNotOptimize(sum);
+    }
+}
+
+KASHIPAN_BENCHMARK(Ease_AutoAllTypes) {
+    state.SetItemsPerOp(EASINGS);
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (int type = 0; type < EASINGS; ++type) {
+            sum += Ease::Auto(30, 60, 0.0f, 100.0f, type);
+        }
+        DoNotOptimize(sum);
+    }
+}
+
+//==================================================
+// KeyFrameAnimation
+//==================================================
+
+KASHIPAN_BENCHMARK(KeyFrameAnimation_Update4Keys) {
+    KeyFrameAnimation animation = MakeAnimation(4);
+    for (auto _ : state) {
+        animation.Update(kDeltaTime);
+        DoNotOptimize(animation.GetCurrentKeyFrameValue(KeyFrameElementType::kPositionX));
+    }
+}
+
+KASHIPAN_BENCHMARK(KeyFrameAnimation_Update64Keys) {
+    KeyFrameAnimation animation = MakeAnimation(64);
+    for (auto _ : state) {
+        animation.Update(kDeltaTime);
+        DoNotOptimize(animation.GetCurrentKeyFrameValue(KeyFrameElementType::kPositionX));
+    }
+}
+
+KASHIPAN_BENCHMARK(KeyFrameAnimation_Build16Keys) {
+    for (auto _ : state) {
+        KeyFrameAnimation animation = MakeAnimation(16);
+        DoNotOptimize(animation.GetDuration());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,5 @@
+#include "Benchmark.h"
+
+int main(int argc, char **argv) {
+    return KashipanEngine::Benchmark::RunAll(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <vector>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <pmmintrin.h>
+#include <xmmintrin.h>
+#endif
+
+#include "Benchmark.h"
+
+namespace KashipanEngine {
+
+namespace Benchmark {
+
+namespace {
+
+// メモリ確保の回数とバイト数(ジョブシステムのワーカーからも呼ばれるのでatomicにする)
+std::atomic<uint64_t> sAllocationCount{ 0 };
+std::atomic<uint64_t> sAllocationBytes{ 0 };
+
+struct Entry {
+    std::string name;
+    std::function<void(State &)> function;
+};
+
+// 静的初期化の順番に依存しないよう、関数内staticで持つ
+std::vector<Entry> &GetEntries() {
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+int64_t NowNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void *Allocate(std::size_t size) {
+    sAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    sAllocationBytes.fetch_add(size, std::memory_order_relaxed);
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *AllocateAligned(std::size_t size, std::align_val_t alignment) {
+    sAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    sAllocationBytes.fetch_add(size, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+#if defined(_MSC_VER)
+    void *p = _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    // aligned_allocはサイズがアライメントの倍数である必要がある
+    const std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+    void *p = std::aligned_alloc(align, rounded);
+#endif
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void FreeAligned(void *p) noexcept {
+#if defined(_MSC_VER)
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+/// @brief 非正規化数を0として扱う(FTZ/DAZ)かどうかを設定する
+void SetFlushDenormals(bool isFlush) noexcept {
+#if defined(_M_X64) || defined(__SSE2__)
+    _MM_SET_FLUSH_ZERO_MODE(isFlush ? _MM_FLUSH_ZERO_ON : _MM_FLUSH_ZERO_OFF);
+    _MM_SET_DENORMALS_ZERO_MODE(isFlush ? _MM_DENORMALS_ZERO_ON : _MM_DENORMALS_ZERO_OFF);
+#else
+    (void)isFlush;
+#endif
+}
+
+} // namespace
+
+State::Iterator State::begin() noexcept {
+    isRunning_ = true;
+    startAllocations_ = GetAllocationCount();
+    startAllocatedBytes_ = GetAllocationBytes();
+    startNs_ = NowNs();
+    return Iterator(this, iterations_);
+}
+
+void State::Stop() noexcept {
+    if (!isRunning_) {
+        return;
+    }
+    const int64_t endNs = NowNs();
+    isRunning_ = false;
+    elapsedNs_ = static_cast<double>(endNs - startNs_);
+    allocations_ = GetAllocationCount() - startAllocations_;
+    allocatedBytes_ = GetAllocationBytes() - startAllocatedBytes_;
+}
+
+bool Register(const char *name, std::function<void(State &)> function) {
+    GetEntries().push_back({ name, std::move(function) });
+    return true;
+}
+
+uint64_t GetAllocationCount() noexcept {
+    return sAllocationCount.load(std::memory_order_relaxed);
+}
+
+uint64_t GetAllocationBytes() noexcept {
+    return sAllocationBytes.load(std::memory_order_relaxed);
+}
+
+int RunAll(int argc, char **argv) {
+    std::string_view filter;
+    double minTimeSec = 0.25;
+    int repetitions = 3;
+    bool isFlushDenormals = true;
+    bool isListOnly = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg.starts_with("--filter=")) {
+            filter = arg.substr(std::strlen("--filter="));
+        } else if (arg.starts_with("--min-time=")) {
+            minTimeSec = std::atof(argv[i] + std::strlen("--min-time="));
+        } else if (arg.starts_with("--repetitions=")) {
+            repetitions = std::max(1, std::atoi(argv[i] + std::strlen("--repetitions=")));
+        } else if (arg == "--quick") {
+            minTimeSec = 0.02;
+        } else if (arg == "--denormals") {
+            isFlushDenormals = false;
+        } else if (arg == "--list") {
+            isListOnly = true;
+        } else {
+            std::fprintf(stderr,
+                "usage: %s [--filter=<substring>] [--min-time=<sec>] [--repetitions=<n>] [--quick] [--denormals] [--list]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // コンパイラがスカラー計算をSSEのパック命令で行うと、使わないレーンに前のベンチマークの値が残る。
+    // それが非正規化数だと計算が数十倍遅くなり、実行順で結果が変わってしまうのでFTZ/DAZを有効にしておく
+    SetFlushDenormals(isFlushDenormals);
+
+    auto &entries = GetEntries();
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.name < b.name; });
+
+    if (!isListOnly) {
+        std::printf("%-44s %12s %12s %12s %10s %12s\n",
+            "benchmark", "iterations", "ns/op", "ns/item", "allocs/op", "bytes/op");
+    }
+
+    const double minTimeNs = minTimeSec * 1e9;
+    for (const auto &entry : entries) {
+        if (!filter.empty() && entry.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        if (isListOnly) {
+            std::printf("%s\n", entry.name.c_str());
+            continue;
+        }
+
+        // 計測時間がminTimeを超えるまで回数を増やして測り直す
+        uint64_t iterations = 1;
+        State state(iterations);
+        for (;;) {
+            state = State(iterations);
+            entry.function(state);
+            state.Stop();
+            const double elapsed = state.GetElapsedNs();
+            if (elapsed >= minTimeNs || iterations >= 1'000'000'000ull) {
+                break;
+            }
+            const double scale = elapsed > 0.0 ? (minTimeNs * 1.2) / elapsed : 100.0;
+            const uint64_t next = static_cast<uint64_t>(static_cast<double>(iterations) * std::min(scale, 100.0));
+            iterations = std::max(next, iterations + 1);
+        }
+
+        // 他の処理に割り込まれた回を除くため、同じ回数で測り直して一番速い結果を使う
+        for (int repetition = 1; repetition < repetitions; ++repetition) {
+            State retry(iterations);
+            entry.function(retry);
+            retry.Stop();
+            if (retry.GetElapsedNs() < state.GetElapsedNs()) {
+                state = retry;
+            }
+        }
+
+        const double iterationCount = static_cast<double>(state.GetIterations());
+        const double nsPerOp = state.GetElapsedNs() / iterationCount;
+        char nsPerItem[32] = "-";
+        if (state.GetItemsPerOp() != 0) {
+            std::snprintf(nsPerItem, sizeof(nsPerItem), "%.3f", nsPerOp / static_cast<double>(state.GetItemsPerOp()));
+        }
+        std::printf("%-44s %12llu %12.3f %12s %10.2f %12.1f  %s\n",
+            entry.name.c_str(),
+            static_cast<unsigned long long>(state.GetIterations()),
+            nsPerOp,
+            nsPerItem,
+            static_cast<double>(state.GetAllocations()) / iterationCount,
+            static_cast<double>(state.GetAllocatedBytes()) / iterationCount,
+            state.GetLabel().c_str());
+        std::fflush(stdout);
+    }
+    return 0;
+}
+
+} // namespace Benchmark
+
+} // namespace KashipanEngine
+
+// メモリ確保を数えるためにグローバルのnew/deleteを置き換える
+void *operator new(std::size_t size) {
+    return KashipanEngine::Benchmark::Allocate(size);
+}
+void *operator new[](std::size_t size) {
+    return KashipanEngine::Benchmark::Allocate(size);
+}
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return KashipanEngine::Benchmark::AllocateAligned(size, alignment);
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return KashipanEngine::Benchmark::AllocateAligned(size, alignment);
+}
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+void operator delete[](void *p) noexcept {
+    std::free(p);
+}
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+void operator delete[](void *p, std::size_t) noexcept {
+    std::free(p);
+}
+void operator delete(void *p, std::align_val_t) noexcept {
+    KashipanEngine::Benchmark::FreeAligned(p);
+}
+void operator delete[](void *p, std::align_val_t) noexcept {
+    KashipanEngine::Benchmark::FreeAligned(p);
+}
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+    KashipanEngine::Benchmark::FreeAligned(p);
+}
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept {
+    KashipanEngine::Benchmark::FreeAligned(p);
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+
+/*
+CPUだけで動くモジュール(Math / Easings / KeyFrameAnimation / 衝突判定)のマイクロベンチマーク。
+  KASHIPAN_BENCHMARK(名前) { for (auto _ : state) { ... } }
+の形で書くと自動で登録され、1回あたりの時間(ns/op)とメモリ確保の回数・バイト数を出力する。
+時間は何度か測り直したうちの一番速い結果を使う。
+state.SetItemsPerOp()で1回に処理する要素数を指定すると、1要素あたりの時間(ns/item)も出力する。
+state.SetLabel()で指定した文字列は結果の行末に出力する(判定した組の数など、時間以外の比較用)。
+*/
+
+#define KASHIPAN_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define KASHIPAN_BENCHMARK_CONCAT(a, b) KASHIPAN_BENCHMARK_CONCAT_IMPL(a, b)
+
+/// @brief ベンチマークを定義して登録する
+#define KASHIPAN_BENCHMARK(name)                                                                    \
+    static void name(KashipanEngine::Benchmark::State &state);                                      \
+    static const bool KASHIPAN_BENCHMARK_CONCAT(kRegistered_, name) =                              \
+        KashipanEngine::Benchmark::Register(#name, name);                                           \
+    static void name([[maybe_unused]] KashipanEngine::Benchmark::State &state)
+
+namespace KashipanEngine {
+
+namespace Benchmark {
+
+/// @brief ベンチマーク1つ分の計測状態
+class State {
+public:
+    /// @brief 範囲forで回すためのイテレータ。ループを抜けるときに計測を止める
+    /// @brief ループ変数の型(使わないので中身は無い)
+    struct Value {
+        Value() noexcept {}
+        ~Value() noexcept {}
+    };
+
+    class Iterator {
+    public:
+        Iterator(State *state, uint64_t remaining) noexcept : state_(state), remaining_(remaining) {}
+        Value operator*() const noexcept { return Value(); }
+        Iterator &operator++() noexcept {
+            --remaining_;
+            return *this;
+        }
+        bool operator!=(const Iterator &) noexcept {
+            if (remaining_ != 0) {
+                return true;
+            }
+            state_->Stop();
+            return false;
+        }
+
+    private:
+        State *state_;
+        uint64_t remaining_;
+    };
+
+    explicit State(uint64_t iterations) noexcept : iterations_(iterations) {}
+
+    /// @brief 計測を開始する(範囲forの開始時に呼ばれる)
+    Iterator begin() noexcept;
+    Iterator end() noexcept { return Iterator(this, 0); }
+
+    /// @brief 計測を止める
+    void Stop() noexcept;
+
+    /// @brief 計測するループの回数を取得
+    uint64_t GetIterations() const noexcept { return iterations_; }
+
+    /// @brief 1回のループで処理する要素数を設定する
+    /// @param items 要素数
+    void SetItemsPerOp(uint64_t items) noexcept { itemsPerOp_ = items; }
+    uint64_t GetItemsPerOp() const noexcept { return itemsPerOp_; }
+
+    /// @brief 結果の行末に出力する文字列を設定する
+    /// @param label 出力する文字列
+    void SetLabel(std::string label) { label_ = std::move(label); }
+    const std::string &GetLabel() const noexcept { return label_; }
+
+    /// @brief 計測した時間(ns)を取得
+    double GetElapsedNs() const noexcept { return elapsedNs_; }
+    /// @brief 計測中のメモリ確保回数を取得
+    uint64_t GetAllocations() const noexcept { return allocations_; }
+    /// @brief 計測中のメモリ確保バイト数を取得
+    uint64_t GetAllocatedBytes() const noexcept { return allocatedBytes_; }
+
+private:
+    uint64_t iterations_;
+    uint64_t itemsPerOp_ = 0;
+    std::string label_;
+
+    int64_t startNs_ = 0;
+    uint64_t startAllocations_ = 0;
+    uint64_t startAllocatedBytes_ = 0;
+    bool isRunning_ = false;
+
+    double elapsedNs_ = 0.0;
+    uint64_t allocations_ = 0;
+    uint64_t allocatedBytes_ = 0;
+};
+
+/// @brief ベンチマークを登録する
+/// @param name ベンチマーク名
+/// @param function ベンチマーク本体
+/// @return 登録できたかどうか(静的初期化で呼ぶための戻り値)
+bool Register(const char *name, std::function<void(State &)> function);
+
+/// @brief 登録したベンチマークを実行して結果を出力する
+/// @param argc コマンドライン引数の数
+/// @param argv コマンドライン引数
+/// @return 終了コード
+int RunAll(int argc, char **argv);
+
+/// @brief 現在までのメモリ確保回数を取得
+uint64_t GetAllocationCount() noexcept;
+/// @brief 現在までのメモリ確保バイト数を取得
+uint64_t GetAllocationBytes() noexcept;
+
+/// @brief 計算結果が最適化で消されないようにする
+template <typename T>
+inline void DoNotOptimize(const T &value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+/// @brief 値が書き換えられたとみなさせて、ループの外に計算を出されないようにする
+template <typename T>
+inline void DoNotOptimize(T &value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : "+m,r"(value) : : "memory");
+#else
+    static volatile void *sink;
+    sink = &value;
+#endif
+}
+
+/// @brief メモリの読み書きが最適化で省かれないようにする
+inline void ClobberMemory() noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+} // namespace Benchmark
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "BulletStore.h"
+#include "Math/Matrix4x4.h"
+
+using namespace KashipanEngine;
+using KashipanEngine::Benchmark::DoNotOptimize;
+
+namespace {
+
+// 同時に飛んでいる弾の数(消えた分は毎フレーム補充する)
+constexpr size_t kBulletCount = 10000;
+// 1フレームの時間
+constexpr float kDeltaTime = 1.0f / 60.0f;
+// 結果を比べる前に進めるフレーム数
+constexpr int kVerifyFrameCount = 300;
+// 曲がる弾が1フレームで目標の方向へ向きを補間する割合
+constexpr float kSteerRate = 0.1f;
+
+const Vector3 kForward(0.0f, 0.0f, 1.0f);
+const Vector3 kUp(0.0f, 1.0f, 0.0f);
+const Vector3 kBulletScale(1.0f, 1.0f, 3.0f);
+const Vector4 kBulletColor(255.0f, 255.0f, 255.0f, 255.0f);
+
+/// @brief フレームごとに動く目標(プレイヤーの位置の代わり)
+Vector3 GetTargetPosition(int frame) {
+    const float angle = static_cast<float>(frame) * 0.02f;
+    return Vector3(std::cos(angle) * 20.0f, 2.0f, std::sin(angle) * 20.0f);
+}
+
+/// @brief 弾の出現パラメータを決まった順番で作る(2つの実装に同じ順番で同じ弾を出す)
+class Spawner {
+public:
+    struct Params {
+        Vector3 position;
+        Vector3 direction;
+        float speed;
+        float lifeTime;
+        bool isSteer;
+    };
+
+    Params Next() {
+        std::uniform_real_distribution<float> distPosition(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> distDirection(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> distSpeed(16.0f, 48.0f);
+        // 寿命はフレームの途中にして、数え方の違いで消えるフレームがずれないようにする
+        std::uniform_int_distribution<int> distLifeFrames(30, 180);
+        Params params;
+        params.position = Vector3(distPosition(random_), distPosition(random_) * 0.2f + 20.0f, distPosition(random_));
+        params.direction = Vector3(distDirection(random_), distDirection(random_), distDirection(random_)).Normalize();
+        params.speed = distSpeed(random_);
+        params.lifeTime = (static_cast<float>(distLifeFrames(random_)) + 0.5f) * kDeltaTime;
+        params.isSteer = (random_() & 1) != 0;
+        return params;
+    }
+
+private:
+    std::mt19937 random_{ 24680 };
+};
+
+//--------- 以前の実装と同じく、1つずつのオブジェクトをリストで持つ ---------//
+
+/// @brief WorldTransformと同じ情報を持つ変換(GPUのリソースは持たない)
+struct ListTransform {
+    Vector3 translate;
+    Quaternion rotate = Quaternion::Identity();
+    Vector3 scale = kBulletScale;
+    Matrix4x4 worldMatrix;
+};
+
+/// @brief 以前のEnemyBullet・PlayerBulletと同じく、仮想関数で更新する弾
+class ListBullet {
+public:
+    ListBullet(const Spawner::Params &params) : kLifeTime(params.lifeTime), speed_(params.speed) {
+        transform_ = std::make_unique<ListTransform>();
+        transform_->translate = params.position;
+        transform_->rotate = Quaternion::LookRotation(params.direction, kUp);
+        velocity_ = params.direction;
+    }
+    virtual ~ListBullet() = default;
+
+    bool IsAlive() const { return isAlive_; }
+    const ListTransform &GetTransform() const { return *transform_; }
+
+    virtual void Update(const Vector3 &targetPosition) = 0;
+
+    void CalculateWorldMatrix() {
+        transform_->worldMatrix.MakeAffine(transform_->scale, transform_->rotate, transform_->translate);
+    }
+
+protected:
+    void Move() {
+        transform_->translate += velocity_ * speed_ * kDeltaTime;
+        lifeTimeCounter_ += kDeltaTime;
+        if (lifeTimeCounter_ >= kLifeTime) {
+            isAlive_ = false;
+        }
+    }
+
+    const float kLifeTime;
+    float lifeTimeCounter_ = 0.0f;
+    float speed_;
+    bool isAlive_ = true;
+    std::unique_ptr<ListTransform> transform_;
+    Vector3 velocity_;
+};
+
+/// @brief 真っすぐ進む弾
+class ListStraightBullet final : public ListBullet {
+public:
+    using ListBullet::ListBullet;
+    void Update(const Vector3 &) override {
+        Move();
+    }
+};
+
+/// @brief 以前のEnemyBulletと同じく、目標の方向へ曲がりながら進む弾
+class ListSteerBullet final : public ListBullet {
+public:
+    using ListBullet::ListBullet;
+    void Update(const Vector3 &targetPosition) override {
+        const Quaternion toTarget = Quaternion::LookRotation(targetPosition - transform_->translate, kUp);
+        transform_->rotate = Quaternion::SlerpFast(transform_->rotate, toTarget, kSteerRate);
+        velocity_ = transform_->rotate.RotateVector(kForward);
+        Move();
+    }
+};
+
+/// @brief リストで持つ弾の場面
+struct ListScene {
+    std::list<std::unique_ptr<ListBullet>> bullets;
+    Spawner spawner;
+    int frame = 0;
+
+    ListScene() {
+        Refill();
+    }
+    void Refill() {
+        while (bullets.size() < kBulletCount) {
+            const Spawner::Params params = spawner.Next();
+            if (params.isSteer) {
+                bullets.push_back(std::make_unique<ListSteerBullet>(params));
+            } else {
+                bullets.push_back(std::make_unique<ListStraightBullet>(params));
+            }
+        }
+    }
+    /// @brief 1フレーム分の更新・削除・補充
+    /// @return 消えた弾の数
+    size_t Step() {
+        const Vector3 targetPosition = GetTargetPosition(frame++);
+        for (auto &bullet : bullets) {
+            bullet->Update(targetPosition);
+        }
+        const size_t removedCount = bullets.remove_if([](const std::unique_ptr<ListBullet> &bullet) {
+            return !bullet->IsAlive();
+            });
+        Refill();
+        return removedCount;
+    }
+};
+
+//--------- BulletStore ---------//
+
+/// @brief BulletStoreで持つ弾の場面
+struct StoreScene {
+    BulletStore bullets;
+    Spawner spawner;
+    int frame = 0;
+
+    StoreScene() {
+        Refill();
+    }
+    void Refill() {
+        while (bullets.GetCount() < kBulletCount) {
+            const Spawner::Params params = spawner.Next();
+            bullets.Spawn(params.position, params.direction * params.speed, 0.5f, params.lifeTime,
+                params.isSteer ? BulletStore::State::kSteer : BulletStore::State::kStraight, kBulletColor);
+        }
+    }
+    /// @brief 1フレーム分の更新・削除・補充
+    /// @return 消えた弾の数
+    size_t Step() {
+        bullets.Steer(GetTargetPosition(frame++), kSteerRate);
+        bullets.Update(kDeltaTime);
+        bullets.RemoveDead();
+        const size_t removedCount = kBulletCount - bullets.GetCount();
+        Refill();
+        return removedCount;
+    }
+};
+
+/// @brief 位置の合計(並び順によらない比較用)
+Vector3 SumPositions(const ListScene &scene) {
+    Vector3 sum(0.0f, 0.0f, 0.0f);
+    for (const auto &bullet : scene.bullets) {
+        sum += bullet->GetTransform().translate;
+    }
+    return sum;
+}
+Vector3 SumPositions(const StoreScene &scene) {
+    Vector3 sum(0.0f, 0.0f, 0.0f);
+    for (const Vector3 &position : scene.bullets.GetPositions()) {
+        sum += position;
+    }
+    return sum;
+}
+
+/// @brief 2つの実装を同じフレーム数だけ進め、弾の数と位置の合計が一致するか調べる
+std::string Verify() {
+    ListScene listScene;
+    StoreScene storeScene;
+    size_t removedCount = 0;
+    size_t countMismatches = 0;
+    for (int frame = 0; frame < kVerifyFrameCount; ++frame) {
+        const size_t listRemoved = listScene.Step();
+        const size_t storeRemoved = storeScene.Step();
+        removedCount += storeRemoved;
+        countMismatches += listRemoved != storeRemoved ? 1 : 0;
+    }
+    const Vector3 difference = SumPositions(listScene) - SumPositions(storeScene);
+    const float averageError = difference.Length() / static_cast<float>(kBulletCount);
+    return "despawned/frame=" + std::to_string(removedCount / kVerifyFrameCount) +
+        " count mismatches=" + std::to_string(countMismatches) + " avg position error=" + std::to_string(averageError);
+}
+
+} // namespace
+
+//==================================================
+// 弾の更新と削除(10000個の弾。ops = 1フレーム分、items = 弾の数)
+// 半分は真っすぐ、半分は目標へ曲がりながら進み、寿命が尽きた弾を消して消えた分を補充する
+// Listは以前のEnemyBullet・PlayerBulletと同じく、弾ごとにnewしたオブジェクトと変換をstd::listで持ち、仮想関数で更新してremove_ifで消す
+// StoreはBulletStore(項目ごとの配列に持ち、末尾の弾を移して詰める)
+// Frameのラベルは2つの実装を300フレーム進めて比べたもの。count mismatchesは消えた弾の数が違ったフレーム数(0になる)、
+// avg position errorは位置の合計の差を弾の数で割ったもの(速さを掛ける順番の違いによる丸めの差だけ)
+// Extractは描画用に全ての弾のワールド行列を求める処理
+//==================================================
+
+KASHIPAN_BENCHMARK(Bullets_List_Frame) {
+    ListScene scene;
+    state.SetItemsPerOp(kBulletCount);
+    for (auto _ : state) {
+        scene.Step();
+    }
+    state.SetLabel(Verify());
+}
+
+KASHIPAN_BENCHMARK(Bullets_Store_Frame) {
+    StoreScene scene;
+    state.SetItemsPerOp(kBulletCount);
+    for (auto _ : state) {
+        scene.Step();
+    }
+    state.SetLabel(Verify());
+}
+
+KASHIPAN_BENCHMARK(Bullets_List_Extract) {
+    ListScene scene;
+    state.SetItemsPerOp(kBulletCount);
+    for (auto _ : state) {
+        for (auto &bullet : scene.bullets) {
+            bullet->CalculateWorldMatrix();
+        }
+        DoNotOptimize(scene.bullets.front()->GetTransform().worldMatrix);
+    }
+}
+
+KASHIPAN_BENCHMARK(Bullets_Store_Extract) {
+    StoreScene scene;
+    std::vector<Matrix4x4> worldMatrices(kBulletCount);
+    state.SetItemsPerOp(kBulletCount);
+    for (auto _ : state) {
+        const auto positions = scene.bullets.GetPositions();
+        const auto rotations = scene.bullets.GetRotations();
+        for (uint32_t i = 0; i < scene.bullets.GetCount(); ++i) {
+            worldMatrices[i].MakeAffine(kBulletScale, rotations[i], positions[i]);
+        }
+        DoNotOptimize(worldMatrices.data());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,718 @@
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "CollisionManager.h"
+#include "Common/JobSystem.h"
+#include "Math/Broadphase.h"
+#include "Math/Collider.h"
+#include "Math/ColliderBatch.h"
+#include "Math/MathObjects/AABB.h"
+#include "Math/MathObjects/Lines.h"
+#include "Math/MathObjects/Plane.h"
+#include "Math/MathObjects/Sphere.h"
+#include "Math/MathObjects/Triangle.h"
+
+using namespace KashipanEngine;
+using KashipanEngine::Benchmark::DoNotOptimize;
+
+namespace {
+
+constexpr size_t kShapeCount = 256;
+constexpr size_t kBatchCount = 1024;
+constexpr size_t kMovingCount = 10000;
+
+/// @brief 計測用の衝突判定オブジェクト(位置と半径だけを持つ)
+class BenchCollider : public Collider {
+public:
+    BenchCollider(const Vector3 &position, float radius, uint32_t attribute, uint32_t mask) : position_(position) {
+        SetRadius(radius);
+        SetCollisionAttribute(attribute);
+        SetCollisionMask(mask);
+    }
+
+    void OnCollision() override {
+        ++hitCount_;
+    }
+    Vector3 GetWorldPosition() override {
+        return position_;
+    }
+
+    uint32_t GetHitCount() const {
+        return hitCount_;
+    }
+    void SetPosition(const Vector3 &position) {
+        position_ = position;
+    }
+
+private:
+    Vector3 position_;
+    uint32_t hitCount_ = 0;
+};
+
+Vector3 RandomVector3(std::mt19937 &random, float range) {
+    std::uniform_real_distribution<float> dist(-range, range);
+    return Vector3(dist(random), dist(random), dist(random));
+}
+
+std::vector<Math::Sphere> RandomSpheres(size_t count) {
+    std::mt19937 random(2468);
+    std::uniform_real_distribution<float> radius(0.5f, 2.0f);
+    std::vector<Math::Sphere> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.emplace_back(RandomVector3(random, 50.0f), radius(random));
+    }
+    return result;
+}
+
+std::vector<Math::AABB> RandomAABBs(size_t count) {
+    std::mt19937 random(1357);
+    std::uniform_real_distribution<float> size(0.5f, 4.0f);
+    std::vector<Math::AABB> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Vector3 min = RandomVector3(random, 50.0f);
+        result.emplace_back(min, min + Vector3(size(random), size(random), size(random)));
+    }
+    return result;
+}
+
+std::vector<Math::Segment> RandomSegments(size_t count) {
+    std::mt19937 random(9753);
+    std::vector<Math::Segment> result(count);
+    for (auto &segment : result) {
+        segment.origin = RandomVector3(random, 50.0f);
+        segment.diff = RandomVector3(random, 20.0f);
+    }
+    return result;
+}
+
+/// @brief 球の配列をSoAに並べ替えて持つ
+struct SphereArrays {
+    explicit SphereArrays(const std::vector<Math::Sphere> &spheres) {
+        for (const auto &sphere : spheres) {
+            centerX.push_back(sphere.center.x);
+            centerY.push_back(sphere.center.y);
+            centerZ.push_back(sphere.center.z);
+            radius.push_back(sphere.radius);
+        }
+    }
+    Math::SphereSoA GetSoA() const {
+        return Math::SphereSoA{ centerX, centerY, centerZ, radius };
+    }
+
+    std::vector<float> centerX, centerY, centerZ, radius;
+};
+
+/// @brief AABBの配列をSoAに並べ替えて持つ
+struct AABBArrays {
+    explicit AABBArrays(const std::vector<Math::AABB> &aabbs) {
+        for (const auto &aabb : aabbs) {
+            minX.push_back(aabb.min.x);
+            minY.push_back(aabb.min.y);
+            minZ.push_back(aabb.min.z);
+            maxX.push_back(aabb.max.x);
+            maxY.push_back(aabb.max.y);
+            maxZ.push_back(aabb.max.z);
+        }
+    }
+    Math::AABBSoA GetSoA() const {
+        return Math::AABBSoA{ minX, minY, minZ, maxX, maxY, maxZ };
+    }
+
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+};
+
+Math::Ray MakeBenchRay() {
+    Math::Ray ray;
+    ray.origin = Vector3(-60.0f, 1.0f, -2.0f);
+    ray.diff = Vector3(1.0f, 0.05f, 0.02f);
+    return ray;
+}
+
+/// @brief 自機・自弾・敵・敵弾を想定した属性で衝突判定オブジェクトを作る
+std::vector<std::unique_ptr<BenchCollider>> MakeColliders(size_t count) {
+    constexpr uint32_t kPlayer = 0b0001;
+    constexpr uint32_t kEnemy = 0b0010;
+    std::mt19937 random(4321);
+    std::vector<std::unique_ptr<BenchCollider>> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const bool isPlayerSide = (i % 2) == 0;
+        result.push_back(std::make_unique<BenchCollider>(RandomVector3(random, 50.0f), 1.0f,
+            isPlayerSide ? kPlayer : kEnemy, isPlayerSide ? ~kPlayer : ~kEnemy));
+    }
+    return result;
+}
+
+void RunCollisionManager(Benchmark::State &state, size_t count) {
+    auto colliders = MakeColliders(count);
+    // 登録は最初の1回だけ
+    CollisionManager manager;
+    for (auto &collider : colliders) {
+        manager.RegisterCollider(collider.get());
+    }
+    state.SetItemsPerOp(count);
+    for (auto _ : state) {
+        manager.Update();
+    }
+    DoNotOptimize(colliders.front()->GetHitCount());
+    state.SetLabel("candidates=" + std::to_string(manager.GetCandidatePairCount()) +
+        " hits=" + std::to_string(manager.GetHitPairCount()));
+}
+
+/// @brief 箱の中を跳ね返りながら動き回る球(弾を想定)
+class MovingScene {
+public:
+    static constexpr float kHalfExtent = 100.0f;
+    static constexpr float kDeltaTime = 1.0f / 60.0f;
+
+    explicit MovingScene(size_t count) {
+        constexpr uint32_t kPlayer = 0b0001;
+        constexpr uint32_t kEnemy = 0b0010;
+        std::mt19937 random(8642);
+        std::uniform_real_distribution<float> radius(0.5f, 1.0f);
+        for (size_t i = 0; i < count; ++i) {
+            const bool isPlayerSide = (i % 2) == 0;
+            colliders_.push_back(std::make_unique<BenchCollider>(RandomVector3(random, kHalfExtent), radius(random),
+                isPlayerSide ? kPlayer : kEnemy, isPlayerSide ? ~kPlayer : ~kEnemy));
+            velocities_.push_back(RandomVector3(random, 20.0f));
+        }
+    }
+
+    /// @brief 1フレーム分動かす
+    void Step() {
+        for (size_t i = 0; i < colliders_.size(); ++i) {
+            Vector3 position = colliders_[i]->GetWorldPosition() + velocities_[i] * kDeltaTime;
+            Vector3 &velocity = velocities_[i];
+            if (position.x < -kHalfExtent || position.x > kHalfExtent) velocity.x = -velocity.x;
+            if (position.y < -kHalfExtent || position.y > kHalfExtent) velocity.y = -velocity.y;
+            if (position.z < -kHalfExtent || position.z > kHalfExtent) velocity.z = -velocity.z;
+            colliders_[i]->SetPosition(position);
+        }
+    }
+
+    std::vector<std::unique_ptr<BenchCollider>> &GetColliders() {
+        return colliders_;
+    }
+
+private:
+    std::vector<std::unique_ptr<BenchCollider>> colliders_;
+    std::vector<Vector3> velocities_;
+};
+
+/// @brief 登録し直しと総当たりを毎フレーム行う、以前のCollisionManagerと同じ処理
+/// @return 球同士の判定を行った組の数
+uint64_t UpdateBruteForce(std::list<Collider *> &colliders, const std::vector<std::unique_ptr<BenchCollider>> &source) {
+    colliders.clear();
+    for (auto &collider : source) {
+        colliders.push_back(collider.get());
+    }
+    uint64_t pairTests = 0;
+    for (auto itrA = colliders.begin(); itrA != colliders.end(); ++itrA) {
+        auto itrB = itrA;
+        ++itrB;
+        for (; itrB != colliders.end(); ++itrB) {
+            if (((*itrA)->GetCollisionAttribute() & (*itrB)->GetCollisionMask()) == 0 ||
+                ((*itrB)->GetCollisionAttribute() & (*itrA)->GetCollisionMask()) == 0) {
+                continue;
+            }
+            ++pairTests;
+            Math::Sphere sphereA((*itrA)->GetWorldPosition(), (*itrA)->GetRadius());
+            Math::Sphere sphereB((*itrB)->GetWorldPosition(), (*itrB)->GetRadius());
+            if (sphereA.IsCollision(sphereB)) {
+                (*itrA)->OnCollision();
+                (*itrB)->OnCollision();
+            }
+        }
+    }
+    return pairTests;
+}
+
+/// @brief 広域判定を作る関数を取得
+template <class T>
+CollisionManager::BroadphaseFactory MakeBroadphaseFactory() {
+    return []() { return std::make_unique<T>(); };
+}
+
+void RunMovingBroadphase(Benchmark::State &state, CollisionManager::BroadphaseFactory factory) {
+    MovingScene scene(kMovingCount);
+    CollisionManager manager;
+    manager.SetBroadphase(std::move(factory));
+    for (auto &collider : scene.GetColliders()) {
+        manager.RegisterCollider(collider.get());
+    }
+    state.SetItemsPerOp(kMovingCount);
+    for (auto _ : state) {
+        scene.Step();
+        manager.Update();
+    }
+    state.SetLabel("pair tests=" + std::to_string(manager.GetCandidatePairCount()) +
+        " hits=" + std::to_string(manager.GetHitPairCount()));
+}
+
+/// @brief 自機と自弾の列、敵と敵弾の列が撃ち合う場面(同じ陣営の弾同士が密に重なる)
+class StressScene {
+public:
+    static constexpr size_t kEnemyCount = 300;
+    static constexpr size_t kStreamCount = 8;
+    static constexpr size_t kBulletsPerStream = 250;
+    static constexpr float kBulletSpacing = 0.3f;
+    static constexpr float kBulletSpeed = 0.6f;
+
+    StressScene() {
+        constexpr uint32_t kPlayer = 0b0001;
+        constexpr uint32_t kEnemy = 0b0010;
+        std::mt19937 random(1122);
+        std::uniform_real_distribution<float> spread(-30.0f, 30.0f);
+        std::uniform_real_distribution<float> depth(30.0f, 120.0f);
+
+        colliders_.push_back(std::make_unique<BenchCollider>(Vector3(0.0f, 0.0f, 0.0f), 1.0f, kPlayer, ~kPlayer));
+        std::vector<Vector3> enemyPositions;
+        for (size_t i = 0; i < kEnemyCount; ++i) {
+            enemyPositions.emplace_back(spread(random), spread(random), depth(random));
+            colliders_.push_back(std::make_unique<BenchCollider>(enemyPositions.back(), 1.5f, kEnemy, ~kEnemy));
+        }
+        // 自弾は自機から敵へ、敵弾は(自弾の狙いとは別の)敵から自機へ列になって飛ぶ
+        constexpr size_t kEnemyStride = kEnemyCount / kStreamCount;
+        for (size_t stream = 0; stream < kStreamCount; ++stream) {
+            AddStream(Vector3(0.0f, 0.0f, 0.0f), enemyPositions[stream * kEnemyStride], kPlayer);
+            AddStream(enemyPositions[stream * kEnemyStride + kEnemyStride / 2], Vector3(0.0f, 0.0f, 0.0f), kEnemy);
+        }
+    }
+
+    /// @brief 1フレーム分弾を進める(終点を過ぎた弾は始点に戻す)
+    void Step() {
+        for (auto &bullet : bullets_) {
+            bullet.distance += kBulletSpeed;
+            if (bullet.distance > bullet.length) {
+                // 撃ち直したものとして扱い、始点へ戻る経路では判定しない
+                bullet.distance -= bullet.length;
+                bullet.collider->ResetSweep();
+            }
+            bullet.collider->SetPosition(bullet.start + bullet.direction * bullet.distance);
+        }
+    }
+
+    std::vector<std::unique_ptr<BenchCollider>> &GetColliders() {
+        return colliders_;
+    }
+
+private:
+    struct Bullet {
+        BenchCollider *collider;
+        Vector3 start;
+        Vector3 direction;
+        float length;
+        float distance;
+    };
+
+    void AddStream(const Vector3 &start, const Vector3 &end, uint32_t attribute) {
+        const Vector3 direction = (end - start).Normalize();
+        const float length = (end - start).Length();
+        for (size_t i = 0; i < kBulletsPerStream; ++i) {
+            const float distance = static_cast<float>(i) * kBulletSpacing;
+            colliders_.push_back(std::make_unique<BenchCollider>(start + direction * distance, 0.5f, attribute, ~attribute));
+            bullets_.push_back(Bullet{ colliders_.back().get(), start, direction, length, distance });
+        }
+    }
+
+    std::vector<std::unique_ptr<BenchCollider>> colliders_;
+    std::vector<Bullet> bullets_;
+};
+
+/// @brief 全てのオブジェクトを1つの広域判定にかけ、候補をマスクで弾く(グループ分けしない場合)
+void RunStressFlat(Benchmark::State &state, std::unique_ptr<Math::Broadphase> broadphase) {
+    StressScene scene;
+    auto &colliders = scene.GetColliders();
+    const size_t count = colliders.size();
+    std::vector<float> centerX(count), centerY(count), centerZ(count), radius(count);
+    std::vector<Math::CollisionPair> pairs;
+    std::vector<Math::CollisionPair> hitPairs;
+    size_t maskRejects = 0;
+    state.SetItemsPerOp(count);
+    for (auto _ : state) {
+        scene.Step();
+        for (size_t i = 0; i < count; ++i) {
+            const Vector3 position = colliders[i]->GetWorldPosition();
+            centerX[i] = position.x;
+            centerY[i] = position.y;
+            centerZ[i] = position.z;
+            radius[i] = colliders[i]->GetRadius();
+        }
+        broadphase->FindPairs(Math::SphereSoA{ centerX, centerY, centerZ, radius }, pairs);
+        maskRejects = 0;
+        hitPairs.clear();
+        for (const auto &pair : pairs) {
+            const BenchCollider &a = *colliders[pair.indexA];
+            const BenchCollider &b = *colliders[pair.indexB];
+            if ((a.GetCollisionAttribute() & b.GetCollisionMask()) == 0 ||
+                (b.GetCollisionAttribute() & a.GetCollisionMask()) == 0) {
+                ++maskRejects;
+                continue;
+            }
+            const Math::Sphere sphereA(Vector3(centerX[pair.indexA], centerY[pair.indexA], centerZ[pair.indexA]), radius[pair.indexA]);
+            const Math::Sphere sphereB(Vector3(centerX[pair.indexB], centerY[pair.indexB], centerZ[pair.indexB]), radius[pair.indexB]);
+            if (Math::Collider::IsCollision(sphereA, sphereB)) {
+                hitPairs.push_back(pair);
+            }
+        }
+        // CollisionManagerと同じく、並べ替えてから通知する
+        std::sort(hitPairs.begin(), hitPairs.end(), [](const Math::CollisionPair &a, const Math::CollisionPair &b) {
+            return a.indexA != b.indexA ? a.indexA < b.indexA : a.indexB < b.indexB;
+            });
+        for (const auto &pair : hitPairs) {
+            colliders[pair.indexA]->OnCollision();
+            colliders[pair.indexB]->OnCollision();
+        }
+    }
+    state.SetLabel("candidates=" + std::to_string(pairs.size()) + " mask rejects=" + std::to_string(maskRejects) +
+        " hits=" + std::to_string(hitPairs.size()));
+}
+
+/// @brief ハードウェアのスレッドの数だけ使うジョブシステムを取得
+JobSystem *GetJobSystem() {
+    static JobSystem jobSystem;
+    return &jobSystem;
+}
+
+/// @brief CollisionManagerで属性とマスクの組み合わせごとに分けて判定する
+void RunStressBucketed(Benchmark::State &state, CollisionManager::BroadphaseFactory factory, JobSystem *jobSystem = GetJobSystem()) {
+    StressScene scene;
+    CollisionManager manager;
+    manager.SetBroadphase(std::move(factory));
+    manager.SetJobSystem(jobSystem);
+    for (auto &collider : scene.GetColliders()) {
+        manager.RegisterCollider(collider.get());
+    }
+    state.SetItemsPerOp(manager.GetColliderCount());
+    for (auto _ : state) {
+        scene.Step();
+        manager.Update();
+    }
+    state.SetLabel("candidates=" + std::to_string(manager.GetCandidatePairCount()) +
+        " skipped pairs=" + std::to_string(manager.GetSkippedPairCount()) +
+        " hits=" + std::to_string(manager.GetHitPairCount()));
+}
+
+} // namespace
+
+//==================================================
+// Math::Collider
+//==================================================
+
+KASHIPAN_BENCHMARK(Collider_SphereSphere) {
+    const auto spheres = RandomSpheres(kShapeCount);
+    state.SetItemsPerOp(kShapeCount);
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        for (size_t i = 0; i < kShapeCount; ++i) {
+            hits += Math::Collider::IsCollision(spheres[i], spheres[(i + 1) % kShapeCount]);
+        }
+        DoNotOptimize(hits);
+    }
+}
+
+KASHIPAN_BENCHMARK(Collider_SpherePlane) {
+    const auto spheres = RandomSpheres(kShapeCount);
+    const Math::Plane plane(Vector3(0.0f, 1.0f, 0.0f).Normalize(), 3.0f);
+    state.SetItemsPerOp(kShapeCount);
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        for (size_t i = 0; i < kShapeCount; ++i) {
+            hits += Math::Collider::IsCollision(spheres[i], plane);
+        }
+        DoNotOptimize(hits);
+    }
+}
+
+KASHIPAN_BENCHMARK(Collider_AABBAABB) {
+    const auto boxes = RandomAABBs(kShapeCount);
+    state.SetItemsPerOp(kShapeCount);
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        for (size_t i = 0; i < kShapeCount; ++i) {
+            hits += Math::Collider::IsCollision(boxes[i], boxes[(i + 1) % kShapeCount]);
+        }
+        DoNotOptimize(hits);
+    }
+}
+
+KASHIPAN_BENCHMARK(Collider_AABBSphere) {
+    const auto boxes = RandomAABBs(kShapeCount);
+    const auto spheres = RandomSpheres(kShapeCount);
+    state.SetItemsPerOp(kShapeCount);
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        for (size_t i = 0; i < kShapeCount; ++i) {
+            hits += Math::Collider::IsCollision(boxes[i], spheres[i]);
+        }
+        DoNotOptimize(hits);
+    }
+}
+
+KASHIPAN_BENCHMARK(Collider_AABBSegment) {
+    const auto boxes = RandomAABBs(kShapeCount);
+    const auto segments = RandomSegments(kShapeCount);
+    state.SetItemsPerOp(kShapeCount);
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        for (size_t i = 0; i < kShapeCount; ++i) {
+            hits += Math::Collider::IsCollision(boxes[i], segments[i]);
+        }
+        DoNotOptimize(hits);
+    }
+}
+
+KASHIPAN_BENCHMARK(Collider_TriangleSegment) {
+    const Math::Triangle triangle({ -10.0f, 0.0f, -10.0f }, { 10.0f, 0.0f, -10.0f }, { 0.0f, 0.0f, 10.0f });
+    const auto segments = RandomSegments(kShapeCount);
+    state.SetItemsPerOp(kShapeCount);
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        for (size_t i = 0; i < kShapeCount; ++i) {
+            hits += Math::Collider::IsCollision(triangle, segments[i]);
+        }
+        DoNotOptimize(hits);
+    }
+}
+
+// 移動量はRandomSegmentsの差分ベクトルを使う
+KASHIPAN_BENCHMARK(Collider_SweptSphereSphere) {
+    const auto spheres = RandomSpheres(kShapeCount);
+    const auto segments = RandomSegments(kShapeCount);
+    state.SetItemsPerOp(kShapeCount);
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        float time = 0.0f;
+        for (size_t i = 0; i < kShapeCount; ++i) {
+            const size_t j = (i + 1) % kShapeCount;
+            hits += Math::Collider::IsCollision(spheres[i], segments[i].diff, spheres[j], segments[j].diff, time);
+        }
+        DoNotOptimize(hits);
+        DoNotOptimize(time);
+    }
+}
+
+KASHIPAN_BENCHMARK(Collider_SweptSphereAABB) {
+    const auto boxes = RandomAABBs(kShapeCount);
+    const auto spheres = RandomSpheres(kShapeCount);
+    const auto segments = RandomSegments(kShapeCount);
+    state.SetItemsPerOp(kShapeCount);
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        float time = 0.0f;
+        for (size_t i = 0; i < kShapeCount; ++i) {
+            hits += Math::Collider::IsCollision(spheres[i], segments[i].diff, boxes[i], time);
+        }
+        DoNotOptimize(hits);
+        DoNotOptimize(time);
+    }
+}
+
+//==================================================
+// Math::Collider(SoAの一括判定、items = 判定した数)
+// *_Scalarは同じ判定をスカラー版のIsCollisionで1つずつ行ったもの
+//==================================================
+
+KASHIPAN_BENCHMARK(ColliderBatch_SphereSpheres_Scalar) {
+    const auto spheres = RandomSpheres(kBatchCount);
+    const Math::Sphere query(Vector3(0.0f, 0.0f, 0.0f), 10.0f);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        for (const auto &sphere : spheres) {
+            hits += Math::Collider::IsCollision(query, sphere);
+        }
+        DoNotOptimize(hits);
+    }
+}
+
+KASHIPAN_BENCHMARK(ColliderBatch_SphereSpheres_Mask) {
+    const SphereArrays spheres(RandomSpheres(kBatchCount));
+    const Math::Sphere query(Vector3(0.0f, 0.0f, 0.0f), 10.0f);
+    std::vector<uint64_t> mask(Math::Collider::GetMaskWordCount(kBatchCount));
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        DoNotOptimize(Math::Collider::IsCollision(query, spheres.GetSoA(), mask));
+    }
+}
+
+KASHIPAN_BENCHMARK(ColliderBatch_SphereSpheres_Indices) {
+    const SphereArrays spheres(RandomSpheres(kBatchCount));
+    const Math::Sphere query(Vector3(0.0f, 0.0f, 0.0f), 10.0f);
+    std::vector<uint32_t> indices(kBatchCount);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        DoNotOptimize(Math::Collider::GetCollisionIndices(query, spheres.GetSoA(), indices));
+    }
+}
+
+KASHIPAN_BENCHMARK(ColliderBatch_SphereAABBs_Scalar) {
+    const auto boxes = RandomAABBs(kBatchCount);
+    const Math::Sphere query(Vector3(0.0f, 0.0f, 0.0f), 10.0f);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        for (const auto &box : boxes) {
+            hits += Math::Collider::IsCollision(box, query);
+        }
+        DoNotOptimize(hits);
+    }
+}
+
+KASHIPAN_BENCHMARK(ColliderBatch_SphereAABBs_Mask) {
+    const AABBArrays boxes(RandomAABBs(kBatchCount));
+    const Math::Sphere query(Vector3(0.0f, 0.0f, 0.0f), 10.0f);
+    std::vector<uint64_t> mask(Math::Collider::GetMaskWordCount(kBatchCount));
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        DoNotOptimize(Math::Collider::IsCollision(query, boxes.GetSoA(), mask));
+    }
+}
+
+KASHIPAN_BENCHMARK(ColliderBatch_RaySpheres_Scalar) {
+    const auto spheres = RandomSpheres(kBatchCount);
+    const Math::Ray ray = MakeBenchRay();
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        for (const auto &sphere : spheres) {
+            hits += Math::Collider::IsCollision(sphere, ray);
+        }
+        DoNotOptimize(hits);
+    }
+}
+
+KASHIPAN_BENCHMARK(ColliderBatch_RaySpheres_Mask) {
+    const SphereArrays spheres(RandomSpheres(kBatchCount));
+    const Math::Ray ray = MakeBenchRay();
+    std::vector<uint64_t> mask(Math::Collider::GetMaskWordCount(kBatchCount));
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        DoNotOptimize(Math::Collider::IsCollision(ray, spheres.GetSoA(), mask));
+    }
+}
+
+KASHIPAN_BENCHMARK(ColliderBatch_RayAABBs_Scalar) {
+    const auto boxes = RandomAABBs(kBatchCount);
+    const Math::Ray ray = MakeBenchRay();
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        for (const auto &box : boxes) {
+            hits += Math::Collider::IsCollision(box, ray);
+        }
+        DoNotOptimize(hits);
+    }
+}
+
+KASHIPAN_BENCHMARK(ColliderBatch_RayAABBs_Mask) {
+    const AABBArrays boxes(RandomAABBs(kBatchCount));
+    const Math::Ray ray = MakeBenchRay();
+    std::vector<uint64_t> mask(Math::Collider::GetMaskWordCount(kBatchCount));
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        DoNotOptimize(Math::Collider::IsCollision(ray, boxes.GetSoA(), mask));
+    }
+}
+
+KASHIPAN_BENCHMARK(ColliderBatch_SpherePairs_Scalar) {
+    const auto spheres = RandomSpheres(kBatchCount);
+    std::vector<Math::CollisionPair> pairs;
+    state.SetItemsPerOp(kBatchCount * (kBatchCount - 1) / 2);
+    for (auto _ : state) {
+        pairs.clear();
+        for (size_t a = 0; a < kBatchCount; ++a) {
+            for (size_t b = a + 1; b < kBatchCount; ++b) {
+                if (Math::Collider::IsCollision(spheres[a], spheres[b])) {
+                    pairs.push_back(Math::CollisionPair{ static_cast<uint32_t>(a), static_cast<uint32_t>(b) });
+                }
+            }
+        }
+        DoNotOptimize(pairs.size());
+    }
+}
+
+KASHIPAN_BENCHMARK(ColliderBatch_SpherePairs) {
+    const SphereArrays spheres(RandomSpheres(kBatchCount));
+    std::vector<Math::CollisionPair> pairs;
+    state.SetItemsPerOp(kBatchCount * (kBatchCount - 1) / 2);
+    for (auto _ : state) {
+        pairs.clear();
+        DoNotOptimize(Math::Collider::GetCollisionPairs(spheres.GetSoA(), pairs));
+    }
+}
+
+//==================================================
+// CollisionManager(ops = 1フレーム分、items = 登録数)
+//==================================================
+
+KASHIPAN_BENCHMARK(CollisionManager_Update64) {
+    RunCollisionManager(state, 64);
+}
+
+KASHIPAN_BENCHMARK(CollisionManager_Update256) {
+    RunCollisionManager(state, 256);
+}
+
+KASHIPAN_BENCHMARK(CollisionManager_Update1024) {
+    RunCollisionManager(state, 1024);
+}
+
+//==================================================
+// 10000個の動く球(ops = 1フレーム分の移動と判定、items = 球の数)
+// BruteForceは以前のCollisionManagerと同じ総当たり。pair testsは球同士の判定(広域判定では候補)の数
+//==================================================
+
+KASHIPAN_BENCHMARK(Moving10k_BruteForce) {
+    MovingScene scene(kMovingCount);
+    std::list<Collider *> colliders;
+    uint64_t pairTests = 0;
+    state.SetItemsPerOp(kMovingCount);
+    for (auto _ : state) {
+        scene.Step();
+        pairTests = UpdateBruteForce(colliders, scene.GetColliders());
+    }
+    state.SetLabel("pair tests=" + std::to_string(pairTests));
+}
+
+KASHIPAN_BENCHMARK(Moving10k_HashGrid) {
+    RunMovingBroadphase(state, MakeBroadphaseFactory<Math::HashGridBroadphase>());
+}
+
+KASHIPAN_BENCHMARK(Moving10k_SweepAndPrune) {
+    RunMovingBroadphase(state, MakeBroadphaseFactory<Math::SweepAndPruneBroadphase>());
+}
+
+//==================================================
+// 撃ち合いの場面(ops = 1フレーム分の移動と判定、items = オブジェクトの数)
+// Flatは全体を1つの広域判定にかけてからマスクで弾く。Bucketedは陣営ごとに分けて、衝突しうる陣営の組だけを調べる
+// mask rejectsは広域判定を通ったのにマスクで弾いた組、skipped pairsはグループ分けで調べずに済んだ組(総当たりの場合の数)
+// SingleThreadは検出をスレッドを使わずに行う(それ以外はハードウェアのスレッドの数のジョブシステムを使う)
+//==================================================
+
+KASHIPAN_BENCHMARK(Stress_Flat_SweepAndPrune) {
+    RunStressFlat(state, std::make_unique<Math::SweepAndPruneBroadphase>());
+}
+
+KASHIPAN_BENCHMARK(Stress_Bucketed_SweepAndPrune) {
+    RunStressBucketed(state, MakeBroadphaseFactory<Math::SweepAndPruneBroadphase>());
+}
+
+KASHIPAN_BENCHMARK(Stress_Flat_HashGrid) {
+    RunStressFlat(state, std::make_unique<Math::HashGridBroadphase>());
+}
+
+KASHIPAN_BENCHMARK(Stress_Bucketed_HashGrid) {
+    RunStressBucketed(state, MakeBroadphaseFactory<Math::HashGridBroadphase>());
+}
+
+KASHIPAN_BENCHMARK(Stress_Bucketed_HashGrid_SingleThread) {
+    RunStressBucketed(state, MakeBroadphaseFactory<Math::HashGridBroadphase>(), nullptr);
+}
\ No newline at end of file
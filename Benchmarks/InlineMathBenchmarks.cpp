@@ -0,0 +1,272 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Math/Matrix4x4.h"
+#include "Math/Vector3.h"
+
+using namespace KashipanEngine;
+using KashipanEngine::Benchmark::DoNotOptimize;
+
+#if defined(_MSC_VER)
+#define KASHIPAN_BENCH_NOINLINE __declspec(noinline)
+#else
+#define KASHIPAN_BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+
+// 1回に処理するワールド変換と衝突判定オブジェクトの数
+constexpr size_t kTransformCount = 1024;
+constexpr size_t kColliderCount = 4096;
+
+/// @brief 数学の型の定義が.cppにあった頃と同じ、翻訳単位の外への関数呼び出しで計算する実装。
+/// 以前のMakeAffineは軸ごとの回転行列と拡大縮小・平行移動の行列を作り、行列の積を4回行っていた
+namespace Legacy {
+
+KASHIPAN_BENCH_NOINLINE Matrix4x4 Multiply(const Matrix4x4 &a, const Matrix4x4 &b) noexcept {
+    return a * b;
+}
+KASHIPAN_BENCH_NOINLINE void MakeRotateX(Matrix4x4 &m, float radian) noexcept {
+    m.MakeRotateX(radian);
+}
+KASHIPAN_BENCH_NOINLINE void MakeRotateY(Matrix4x4 &m, float radian) noexcept {
+    m.MakeRotateY(radian);
+}
+KASHIPAN_BENCH_NOINLINE void MakeRotateZ(Matrix4x4 &m, float radian) noexcept {
+    m.MakeRotateZ(radian);
+}
+KASHIPAN_BENCH_NOINLINE void MakeScale(Matrix4x4 &m, const Vector3 &scale) noexcept {
+    m.MakeScale(scale);
+}
+KASHIPAN_BENCH_NOINLINE void MakeTranslate(Matrix4x4 &m, const Vector3 &translate) noexcept {
+    m.MakeTranslate(translate);
+}
+KASHIPAN_BENCH_NOINLINE void MakeAffine(Matrix4x4 &m, const Vector3 &scale, const Vector3 &rotate, const Vector3 &translate) noexcept {
+    Matrix4x4 mX, mY, mZ, mT, mS;
+    MakeRotateX(mX, rotate.x);
+    MakeRotateY(mY, rotate.y);
+    MakeRotateZ(mZ, rotate.z);
+    MakeTranslate(mT, translate);
+    MakeScale(mS, scale);
+    m = Multiply(Multiply(mS, Multiply(Multiply(mX, mY), mZ)), mT);
+}
+KASHIPAN_BENCH_NOINLINE Vector3 Add(const Vector3 &a, const Vector3 &b) noexcept {
+    return a + b;
+}
+KASHIPAN_BENCH_NOINLINE Vector3 Subtract(const Vector3 &a, const Vector3 &b) noexcept {
+    return a - b;
+}
+KASHIPAN_BENCH_NOINLINE Vector3 Scale(const Vector3 &v, float scalar) noexcept {
+    return v * scalar;
+}
+KASHIPAN_BENCH_NOINLINE Vector3 Divide(const Vector3 &v, float scalar) noexcept {
+    return v / scalar;
+}
+KASHIPAN_BENCH_NOINLINE float Length(const Vector3 &v) noexcept {
+    return v.Length();
+}
+
+} // namespace Legacy
+
+/// @brief ワールド変換の入力(WorldTransformの拡大縮小・回転・平行移動)
+struct TransformInputs {
+    std::vector<Vector3> scales;
+    std::vector<Vector3> rotates;
+    std::vector<Vector3> translates;
+    Matrix4x4 parent;
+
+    TransformInputs() : scales(kTransformCount), rotates(kTransformCount), translates(kTransformCount) {
+        std::mt19937 random(3141);
+        std::uniform_real_distribution<float> distScale(0.5f, 2.0f);
+        std::uniform_real_distribution<float> distAngle(-3.14f, 3.14f);
+        std::uniform_real_distribution<float> distPosition(-100.0f, 100.0f);
+        for (size_t i = 0; i < kTransformCount; ++i) {
+            scales[i] = { distScale(random), distScale(random), distScale(random) };
+            rotates[i] = { distAngle(random), distAngle(random), distAngle(random) };
+            translates[i] = { distPosition(random), distPosition(random), distPosition(random) };
+        }
+        parent.MakeAffine({ 1.0f, 1.0f, 1.0f }, { 0.1f, 0.2f, 0.3f }, { 5.0f, 0.0f, -5.0f });
+    }
+};
+
+/// @brief CollisionManager::UpdateBoundsとDetectContactsが使う位置と半径
+struct ColliderInputs {
+    std::vector<Vector3> previousPositions;
+    std::vector<Vector3> positions;
+    std::vector<float> radii;
+
+    ColliderInputs() : previousPositions(kColliderCount), positions(kColliderCount), radii(kColliderCount) {
+        std::mt19937 random(2718);
+        std::uniform_real_distribution<float> distPosition(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> distMove(-2.0f, 2.0f);
+        std::uniform_real_distribution<float> distRadius(0.5f, 3.0f);
+        for (size_t i = 0; i < kColliderCount; ++i) {
+            previousPositions[i] = { distPosition(random), distPosition(random), distPosition(random) };
+            positions[i] = previousPositions[i] + Vector3(distMove(random), distMove(random), distMove(random));
+            radii[i] = distRadius(random);
+        }
+    }
+};
+
+/// @brief 2つの行列の配列の要素の差の最大
+float MaxDifference(const std::vector<Matrix4x4> &a, const std::vector<Matrix4x4> &b) {
+    float maxDifference = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (int row = 0; row < 4; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                maxDifference = std::max(maxDifference, std::abs(a[i].m[row][column] - b[i].m[row][column]));
+            }
+        }
+    }
+    return maxDifference;
+}
+
+/// @brief 以前の実装でワールド行列を計算する(TransferMatrixのCPU側の処理)
+void TransferMatricesLegacy(const TransformInputs &inputs, std::vector<Matrix4x4> &outMatrices) {
+    for (size_t i = 0; i < kTransformCount; ++i) {
+        Matrix4x4 world;
+        Legacy::MakeAffine(world, inputs.scales[i], inputs.rotates[i], inputs.translates[i]);
+        outMatrices[i] = Legacy::Multiply(world, inputs.parent);
+    }
+}
+
+/// @brief 今の実装でワールド行列を計算する(TransferMatrixのCPU側の処理)
+void TransferMatrices(const TransformInputs &inputs, std::vector<Matrix4x4> &outMatrices) {
+    for (size_t i = 0; i < kTransformCount; ++i) {
+        Matrix4x4 world;
+        world.MakeAffine(inputs.scales[i], inputs.rotates[i], inputs.translates[i]);
+        world *= inputs.parent;
+        outMatrices[i] = world;
+    }
+}
+
+} // namespace
+
+//==================================================
+// 数学の型をヘッダーのみにする前後の比較(items = 1回に処理するワールド変換または衝突判定オブジェクトの数)
+// Beforeは定義が.cppにあった頃と同じく、演算を翻訳単位の外への関数呼び出しで行う(MakeAffineは行列の積4回)
+// Afterは今のヘッダーの定義で、インライン展開される(MakeAffineは展開済みの式)
+// TransferMatrixはWorldTransform::TransferMatrixのCPU側(アフィン行列を作り、親の行列を掛けて書き込む)
+// CollisionBoundsはCollisionManager::UpdateBoundsの移動前後を囲む球の計算、
+// CollisionNormalsはDetectContactsの接触の深さと法線の計算
+// Afterのラベルのmax diffはBeforeとの要素の差の最大(式の展開の順番の違いによる丸め誤差だけになる)
+//==================================================
+
+KASHIPAN_BENCHMARK(InlineMath_MakeAffine_Before) {
+    const TransformInputs inputs;
+    state.SetItemsPerOp(kTransformCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kTransformCount; ++i) {
+            Matrix4x4 m;
+            Legacy::MakeAffine(m, inputs.scales[i], inputs.rotates[i], inputs.translates[i]);
+            DoNotOptimize(m);
+        }
+    }
+}
+
+KASHIPAN_BENCHMARK(InlineMath_MakeAffine_After) {
+    const TransformInputs inputs;
+    state.SetItemsPerOp(kTransformCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kTransformCount; ++i) {
+            Matrix4x4 m;
+            m.MakeAffine(inputs.scales[i], inputs.rotates[i], inputs.translates[i]);
+            DoNotOptimize(m);
+        }
+    }
+}
+
+KASHIPAN_BENCHMARK(InlineMath_TransferMatrix_Before) {
+    const TransformInputs inputs;
+    std::vector<Matrix4x4> matrices(kTransformCount);
+    state.SetItemsPerOp(kTransformCount);
+    for (auto _ : state) {
+        TransferMatricesLegacy(inputs, matrices);
+        DoNotOptimize(matrices.data());
+    }
+}
+
+KASHIPAN_BENCHMARK(InlineMath_TransferMatrix_After) {
+    const TransformInputs inputs;
+    std::vector<Matrix4x4> matrices(kTransformCount);
+    state.SetItemsPerOp(kTransformCount);
+    for (auto _ : state) {
+        TransferMatrices(inputs, matrices);
+        DoNotOptimize(matrices.data());
+    }
+    std::vector<Matrix4x4> legacyMatrices(kTransformCount);
+    TransferMatricesLegacy(inputs, legacyMatrices);
+    state.SetLabel("max diff=" + std::to_string(MaxDifference(matrices, legacyMatrices)));
+}
+
+KASHIPAN_BENCHMARK(InlineMath_CollisionBounds_Before) {
+    const ColliderInputs inputs;
+    std::vector<Vector3> centers(kColliderCount);
+    std::vector<float> boundsRadii(kColliderCount);
+    state.SetItemsPerOp(kColliderCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kColliderCount; ++i) {
+            centers[i] = Legacy::Scale(Legacy::Add(inputs.previousPositions[i], inputs.positions[i]), 0.5f);
+            boundsRadii[i] = inputs.radii[i] +
+                Legacy::Length(Legacy::Subtract(inputs.positions[i], inputs.previousPositions[i])) * 0.5f;
+        }
+        DoNotOptimize(centers.data());
+        DoNotOptimize(boundsRadii.data());
+    }
+}
+
+KASHIPAN_BENCHMARK(InlineMath_CollisionBounds_After) {
+    const ColliderInputs inputs;
+    std::vector<Vector3> centers(kColliderCount);
+    std::vector<float> boundsRadii(kColliderCount);
+    state.SetItemsPerOp(kColliderCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kColliderCount; ++i) {
+            centers[i] = (inputs.previousPositions[i] + inputs.positions[i]) * 0.5f;
+            boundsRadii[i] = inputs.radii[i] + (inputs.positions[i] - inputs.previousPositions[i]).Length() * 0.5f;
+        }
+        DoNotOptimize(centers.data());
+        DoNotOptimize(boundsRadii.data());
+    }
+}
+
+KASHIPAN_BENCHMARK(InlineMath_CollisionNormals_Before) {
+    const ColliderInputs inputs;
+    std::vector<Vector3> normals(kColliderCount);
+    std::vector<float> depths(kColliderCount);
+    state.SetItemsPerOp(kColliderCount);
+    for (auto _ : state) {
+        // 隣り合うオブジェクトを候補の組として、接触の深さと法線を求める
+        for (size_t i = 0; i < kColliderCount; ++i) {
+            const size_t j = (i + 1) % kColliderCount;
+            const Vector3 difference = Legacy::Subtract(inputs.positions[j], inputs.positions[i]);
+            const float distance = Legacy::Length(difference);
+            depths[i] = inputs.radii[i] + inputs.radii[j] - distance;
+            normals[i] = distance > 0.0f ? Legacy::Divide(difference, distance) : Vector3(0.0f, 1.0f, 0.0f);
+        }
+        DoNotOptimize(normals.data());
+        DoNotOptimize(depths.data());
+    }
+}
+
+KASHIPAN_BENCHMARK(InlineMath_CollisionNormals_After) {
+    const ColliderInputs inputs;
+    std::vector<Vector3> normals(kColliderCount);
+    std::vector<float> depths(kColliderCount);
+    state.SetItemsPerOp(kColliderCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kColliderCount; ++i) {
+            const size_t j = (i + 1) % kColliderCount;
+            const Vector3 difference = inputs.positions[j] - inputs.positions[i];
+            const float distance = difference.Length();
+            depths[i] = inputs.radii[i] + inputs.radii[j] - distance;
+            normals[i] = distance > 0.0f ? difference / distance : Vector3(0.0f, 1.0f, 0.0f);
+        }
+        DoNotOptimize(normals.data());
+        DoNotOptimize(depths.data());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Common/JobSystem.h"
+
+using namespace KashipanEngine;
+using KashipanEngine::Benchmark::DoNotOptimize;
+
+namespace {
+
+// 取り合いを測るベンチマークのスレッドの数(コアが少ない環境でも取り合いが起きるように4以上にする)
+const uint32_t kStressThreadCount = std::max(std::thread::hardware_concurrency(), 4u);
+
+// ParallelForで調べる要素の数
+constexpr uint32_t kElementCount = 100000;
+// 入れ子のParallelForの外側と内側の数
+constexpr uint32_t kOuterCount = 64;
+constexpr uint32_t kInnerCount = 1000;
+// 依存関係でつないだジョブの列の数と長さ
+constexpr uint32_t kChainCount = 64;
+constexpr uint32_t kChainLength = 16;
+// 小さいジョブの数
+constexpr uint32_t kSmallJobCount = 10000;
+// スケーリングを測る要素の数と、1つのジョブで計算する要素の数
+constexpr uint32_t kScalingElementCount = 1u << 16;
+constexpr uint32_t kScalingGrainSize = 256;
+
+/// @brief grainSizeごとにParallelForを回す
+void RunParallelForCoverage(Benchmark::State &state, uint32_t grainSize) {
+    JobSystem jobSystem(kStressThreadCount);
+    std::vector<uint32_t> visits(kElementCount);
+    state.SetItemsPerOp(kElementCount);
+    for (auto _ : state) {
+        jobSystem.ParallelFor(0, kElementCount, grainSize, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                ++visits[i];
+            }
+            });
+        DoNotOptimize(visits.data());
+    }
+    state.SetLabel("threads=" + std::to_string(jobSystem.GetThreadCount()));
+}
+
+/// @brief 重い計算(スケーリングを測るための1要素分の処理)
+float HeavyWork(uint32_t index) {
+    float value = static_cast<float>(index) * 0.001f;
+    for (int i = 0; i < 64; ++i) {
+        value = std::sin(value) * 0.5f + std::cos(value * 1.3f) * 0.5f + 0.01f;
+    }
+    return value;
+}
+
+/// @brief threadCountのスレッドで重い計算をParallelForで回す
+void RunScaling(Benchmark::State &state, uint32_t threadCount) {
+    JobSystem jobSystem(threadCount);
+    std::vector<float> results(kScalingElementCount);
+    state.SetItemsPerOp(kScalingElementCount);
+    for (auto _ : state) {
+        jobSystem.ParallelFor(0, kScalingElementCount, kScalingGrainSize, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                results[i] = HeavyWork(i);
+            }
+            });
+        DoNotOptimize(results.data());
+    }
+    state.SetLabel("threads=" + std::to_string(threadCount) + " hardware=" +
+        std::to_string(std::thread::hardware_concurrency()));
+}
+
+} // namespace
+
+//==================================================
+// JobSystemの取り合い(ops = 1回分、items = 要素かジョブの数)
+// どれもスレッドを4つ以上使う。結果が正しいかはTests/JobSystemTests.cppで調べる
+// CoverageはgrainSizeごとのParallelFor、Nestedはジョブの中から呼ぶParallelFor
+// Chainは依存するカウンタでつないだジョブの列、SmallJobsは1つのカウンタで待つ小さいジョブ
+//==================================================
+
+KASHIPAN_BENCHMARK(JobSystem_Coverage_Grain1) {
+    RunParallelForCoverage(state, 1);
+}
+
+KASHIPAN_BENCHMARK(JobSystem_Coverage_Grain7) {
+    RunParallelForCoverage(state, 7);
+}
+
+KASHIPAN_BENCHMARK(JobSystem_Coverage_Grain1000) {
+    RunParallelForCoverage(state, 1000);
+}
+
+KASHIPAN_BENCHMARK(JobSystem_Nested) {
+    JobSystem jobSystem(kStressThreadCount);
+    std::vector<uint32_t> visits(kOuterCount * kInnerCount);
+    state.SetItemsPerOp(kOuterCount * kInnerCount);
+    for (auto _ : state) {
+        jobSystem.ParallelFor(0, kOuterCount, 1, [&](uint32_t outerBegin, uint32_t outerEnd) {
+            for (uint32_t outer = outerBegin; outer < outerEnd; ++outer) {
+                jobSystem.ParallelFor(0, kInnerCount, 16, [&, outer](uint32_t begin, uint32_t end) {
+                    for (uint32_t inner = begin; inner < end; ++inner) {
+                        ++visits[outer * kInnerCount + inner];
+                    }
+                    });
+            }
+            });
+        DoNotOptimize(visits.data());
+    }
+    state.SetLabel("threads=" + std::to_string(jobSystem.GetThreadCount()));
+}
+
+KASHIPAN_BENCHMARK(JobSystem_Chain) {
+    JobSystem jobSystem(kStressThreadCount);
+    std::vector<uint32_t> steps(kChainCount);
+    state.SetItemsPerOp(kChainCount * kChainLength);
+    for (auto _ : state) {
+        std::vector<JobSystem::Counter> counters(kChainCount * kChainLength);
+        // 積んでいる間にも前のジョブが実行されるので、依存先がまだ終わっていない場合と終わった場合の両方を通る
+        for (uint32_t s = 0; s < kChainLength; ++s) {
+            for (uint32_t c = 0; c < kChainCount; ++c) {
+                const JobSystem::Counter *dependency = s > 0 ? &counters[c * kChainLength + s - 1] : nullptr;
+                jobSystem.Run([&, c, s]() { steps[c] = s + 1; }, counters[c * kChainLength + s], dependency);
+            }
+        }
+        for (uint32_t c = 0; c < kChainCount; ++c) {
+            jobSystem.Wait(counters[c * kChainLength + kChainLength - 1]);
+        }
+        // 列の途中のジョブも全て終わってからカウンタを破棄する
+        for (const JobSystem::Counter &counter : counters) {
+            jobSystem.Wait(counter);
+        }
+        DoNotOptimize(steps.data());
+    }
+    state.SetLabel("threads=" + std::to_string(jobSystem.GetThreadCount()));
+}
+
+KASHIPAN_BENCHMARK(JobSystem_SmallJobs) {
+    JobSystem jobSystem(kStressThreadCount);
+    std::vector<uint32_t> visits(kSmallJobCount);
+    state.SetItemsPerOp(kSmallJobCount);
+    for (auto _ : state) {
+        JobSystem::Counter counter;
+        // 半分はジョブの中から積む
+        for (uint32_t i = 0; i < kSmallJobCount; i += 2) {
+            jobSystem.Run([&, i]() {
+                ++visits[i];
+                jobSystem.Run([&, i]() { ++visits[i + 1]; }, counter);
+                }, counter);
+        }
+        jobSystem.Wait(counter);
+        DoNotOptimize(visits.data());
+    }
+    state.SetLabel("threads=" + std::to_string(jobSystem.GetThreadCount()));
+}
+
+//==================================================
+// JobSystemのスケーリング(ops = 1回分のParallelFor、items = 要素の数)
+// 1要素あたり三角関数を128回呼ぶ計算を、スレッドの数を変えて256要素ずつのジョブで回す
+// Serialはジョブシステムを使わない同じ計算。hardwareより多いスレッドの結果は参考(取り合いになるので速くならない)
+//==================================================
+
+KASHIPAN_BENCHMARK(JobSystem_Scaling_Serial) {
+    std::vector<float> results(kScalingElementCount);
+    state.SetItemsPerOp(kScalingElementCount);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < kScalingElementCount; ++i) {
+            results[i] = HeavyWork(i);
+        }
+        DoNotOptimize(results.data());
+    }
+}
+
+KASHIPAN_BENCHMARK(JobSystem_Scaling_1) {
+    RunScaling(state, 1);
+}
+
+KASHIPAN_BENCHMARK(JobSystem_Scaling_2) {
+    RunScaling(state, 2);
+}
+
+KASHIPAN_BENCHMARK(JobSystem_Scaling_4) {
+    RunScaling(state, 4);
+}
+
+KASHIPAN_BENCHMARK(JobSystem_Scaling_8) {
+    RunScaling(state, 8);
+}
+
+KASHIPAN_BENCHMARK(JobSystem_Scaling_16) {
+    RunScaling(state, 16);
+}
+
+KASHIPAN_BENCHMARK(JobSystem_Scaling_Hardware) {
+    RunScaling(state, std::thread::hardware_concurrency());
+}
\ No newline at end of file
@@ -0,0 +1,403 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Math/CatmullRomSpline.h"
+#include "Math/FastMath.h"
+#include "Math/Matrix4x4.h"
+#include "Math/Quaternion.h"
+#include "Math/TransformBatch.h"
+#include "Math/Vector3.h"
+
+using namespace KashipanEngine;
+using KashipanEngine::Benchmark::DoNotOptimize;
+
+namespace {
+
+constexpr size_t kBatchCount = 1024;
+
+Vector3 RandomVector3(std::mt19937 &random, float range) {
+    std::uniform_real_distribution<float> dist(-range, range);
+    return Vector3(dist(random), dist(random), dist(random));
+}
+
+std::vector<Vector3> RandomVector3s(size_t count, float range) {
+    std::mt19937 random(12345);
+    std::vector<Vector3> result(count);
+    for (auto &v : result) {
+        v = RandomVector3(random, range);
+    }
+    return result;
+}
+
+std::vector<float> RandomFloats(size_t count, float min, float max) {
+    std::mt19937 random(6789);
+    std::uniform_real_distribution<float> dist(min, max);
+    std::vector<float> result(count);
+    for (auto &v : result) {
+        v = dist(random);
+    }
+    return result;
+}
+
+Matrix4x4 MakeTestMatrix() {
+    Matrix4x4 matrix;
+    matrix.MakeAffine({ 1.5f, 2.0f, 0.5f }, { 0.3f, -1.2f, 2.1f }, { 10.0f, -4.0f, 3.0f });
+    return matrix;
+}
+
+} // namespace
+
+//==================================================
+// Matrix4x4
+//==================================================
+
+KASHIPAN_BENCHMARK(Matrix4x4_Multiply) {
+    Matrix4x4 a = MakeTestMatrix();
+    Matrix4x4 b = a.Inverse();
+    for (auto _ : state) {
+        DoNotOptimize(a);
+        DoNotOptimize(b);
+        Matrix4x4 c = a * b;
+        DoNotOptimize(c);
+    }
+}
+
+KASHIPAN_BENCHMARK(Matrix4x4_Inverse) {
+    Matrix4x4 a = MakeTestMatrix();
+    for (auto _ : state) {
+        DoNotOptimize(a);
+        Matrix4x4 c = a.Inverse();
+        DoNotOptimize(c);
+    }
+}
+
+KASHIPAN_BENCHMARK(Matrix4x4_InverseAffine) {
+    Matrix4x4 a = MakeTestMatrix();
+    for (auto _ : state) {
+        DoNotOptimize(a);
+        Matrix4x4 c = a.InverseAffine();
+        DoNotOptimize(c);
+    }
+}
+
+KASHIPAN_BENCHMARK(Matrix4x4_InverseRigid) {
+    Matrix4x4 a;
+    a.MakeAffine({ 1.0f, 1.0f, 1.0f }, { 0.3f, -1.2f, 2.1f }, { 10.0f, -4.0f, 3.0f });
+    for (auto _ : state) {
+        DoNotOptimize(a);
+        Matrix4x4 c = a.InverseRigid();
+        DoNotOptimize(c);
+    }
+}
+
+KASHIPAN_BENCHMARK(Matrix4x4_MakeAffineEuler) {
+    Vector3 scale(1.5f, 2.0f, 0.5f);
+    Vector3 rotate(0.3f, -1.2f, 2.1f);
+    Vector3 translate(10.0f, -4.0f, 3.0f);
+    for (auto _ : state) {
+        DoNotOptimize(rotate);
+        Matrix4x4 m;
+        m.MakeAffine(scale, rotate, translate);
+        DoNotOptimize(m);
+    }
+}
+
+KASHIPAN_BENCHMARK(Matrix4x4_MakeAffineQuaternion) {
+    Vector3 scale(1.5f, 2.0f, 0.5f);
+    Quaternion rotate = Quaternion::FromEuler({ 0.3f, -1.2f, 2.1f });
+    Vector3 translate(10.0f, -4.0f, 3.0f);
+    for (auto _ : state) {
+        DoNotOptimize(rotate);
+        Matrix4x4 m;
+        m.MakeAffine(scale, rotate, translate);
+        DoNotOptimize(m);
+    }
+}
+
+//==================================================
+// Vector3
+//==================================================
+
+KASHIPAN_BENCHMARK(Vector3_Transform) {
+    Matrix4x4 m = MakeTestMatrix();
+    Vector3 v(1.0f, 2.0f, 3.0f);
+    for (auto _ : state) {
+        DoNotOptimize(v);
+        Vector3 r = v.Transform(m);
+        DoNotOptimize(r);
+    }
+}
+
+KASHIPAN_BENCHMARK(Vector3_Normalize) {
+    Vector3 v(1.0f, 2.0f, 3.0f);
+    for (auto _ : state) {
+        DoNotOptimize(v);
+        Vector3 r = v.Normalize();
+        DoNotOptimize(r);
+    }
+}
+
+KASHIPAN_BENCHMARK(Vector3_Slerp) {
+    Vector3 a = Vector3(1.0f, 0.2f, 0.0f).Normalize();
+    Vector3 b = Vector3(-0.3f, 1.0f, 0.5f).Normalize();
+    for (auto _ : state) {
+        DoNotOptimize(a);
+        Vector3 r = Vector3::Slerp(a, b, 0.37f);
+        DoNotOptimize(r);
+    }
+}
+
+KASHIPAN_BENCHMARK(Vector3_CatmullRomPosition) {
+    const std::vector<Vector3> points = RandomVector3s(16, 10.0f);
+    float t = 0.0f;
+    for (auto _ : state) {
+        t += 0.001f;
+        if (t > 1.0f) {
+            t = 0.0f;
+        }
+        Vector3 r = Vector3::CatmullRomPosition(points, t);
+        DoNotOptimize(r);
+    }
+}
+
+KASHIPAN_BENCHMARK(CatmullRomSpline_GetPosition) {
+    const CatmullRomSpline spline(RandomVector3s(16, 10.0f), false);
+    const float step = spline.GetLength() / 1000.0f;
+    float distance = 0.0f;
+    for (auto _ : state) {
+        distance += step;
+        if (distance > spline.GetLength()) {
+            distance = 0.0f;
+        }
+        Vector3 r = spline.GetPosition(distance);
+        DoNotOptimize(r);
+    }
+}
+
+KASHIPAN_BENCHMARK(CatmullRomSpline_GetFrame) {
+    const CatmullRomSpline spline(RandomVector3s(16, 10.0f), true);
+    const float step = spline.GetLength() / 1000.0f;
+    float distance = 0.0f;
+    for (auto _ : state) {
+        distance = spline.WrapDistance(distance + step);
+        CatmullRomSpline::Frame frame = spline.GetFrame(distance);
+        DoNotOptimize(frame);
+    }
+}
+
+KASHIPAN_BENCHMARK(CatmullRomSpline_Build16Points) {
+    const std::vector<Vector3> points = RandomVector3s(16, 10.0f);
+    CatmullRomSpline spline;
+    for (auto _ : state) {
+        spline.SetControlPoints(points, true);
+        DoNotOptimize(spline.GetLength());
+    }
+}
+
+//==================================================
+// TransformBatch
+//==================================================
+
+KASHIPAN_BENCHMARK(TransformPoints_Loop1024) {
+    const Matrix4x4 m = MakeTestMatrix();
+    const std::vector<Vector3> in = RandomVector3s(kBatchCount, 100.0f);
+    std::vector<Vector3> out(kBatchCount);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kBatchCount; ++i) {
+            out[i] = in[i].Transform(m);
+        }
+        DoNotOptimize(out.data());
+        Benchmark::ClobberMemory();
+    }
+}
+
+KASHIPAN_BENCHMARK(TransformPoints_Batch1024) {
+    const Matrix4x4 m = MakeTestMatrix();
+    const std::vector<Vector3> in = RandomVector3s(kBatchCount, 100.0f);
+    std::vector<Vector3> out(kBatchCount);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        Math::TransformPoints(in, m, out);
+        DoNotOptimize(out.data());
+        Benchmark::ClobberMemory();
+    }
+}
+
+KASHIPAN_BENCHMARK(TransformPointsAffine_SoA1024) {
+    const Matrix4x4 m = MakeTestMatrix();
+    const std::vector<float> x = RandomFloats(kBatchCount, -100.0f, 100.0f);
+    const std::vector<float> y = RandomFloats(kBatchCount, -100.0f, 100.0f);
+    const std::vector<float> z = RandomFloats(kBatchCount, -100.0f, 100.0f);
+    std::vector<float> outX(kBatchCount), outY(kBatchCount), outZ(kBatchCount);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        Math::TransformPointsAffineSoA(x, y, z, m, outX, outY, outZ);
+        DoNotOptimize(outX.data());
+        Benchmark::ClobberMemory();
+    }
+}
+
+//==================================================
+// Quaternion
+//==================================================
+
+KASHIPAN_BENCHMARK(Quaternion_FromEuler) {
+    Vector3 rotate(0.3f, -1.2f, 2.1f);
+    for (auto _ : state) {
+        DoNotOptimize(rotate);
+        Quaternion q = Quaternion::FromEuler(rotate);
+        DoNotOptimize(q);
+    }
+}
+
+KASHIPAN_BENCHMARK(Quaternion_Slerp) {
+    Quaternion a = Quaternion::FromEuler({ 0.3f, -1.2f, 2.1f });
+    Quaternion b = Quaternion::FromEuler({ -0.7f, 0.4f, 0.2f });
+    for (auto _ : state) {
+        DoNotOptimize(a);
+        Quaternion q = Quaternion::Slerp(a, b, 0.37f);
+        DoNotOptimize(q);
+    }
+}
+
+KASHIPAN_BENCHMARK(Quaternion_SlerpFast) {
+    Quaternion a = Quaternion::FromEuler({ 0.3f, -1.2f, 2.1f });
+    Quaternion b = Quaternion::FromEuler({ -0.7f, 0.4f, 0.2f });
+    for (auto _ : state) {
+        DoNotOptimize(a);
+        Quaternion q = Quaternion::SlerpFast(a, b, 0.37f);
+        DoNotOptimize(q);
+    }
+}
+
+KASHIPAN_BENCHMARK(Quaternion_RotateVector) {
+    Quaternion q = Quaternion::FromEuler({ 0.3f, -1.2f, 2.1f });
+    Vector3 v(1.0f, 2.0f, 3.0f);
+    for (auto _ : state) {
+        DoNotOptimize(v);
+        Vector3 r = q.RotateVector(v);
+        DoNotOptimize(r);
+    }
+}
+
+//==================================================
+// FastMath(std版と比較する)
+//==================================================
+
+KASHIPAN_BENCHMARK(SinCos_Std1024) {
+    const std::vector<float> x = RandomFloats(kBatchCount, -10.0f, 10.0f);
+    std::vector<float> s(kBatchCount), c(kBatchCount);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kBatchCount; ++i) {
+            s[i] = std::sin(x[i]);
+            c[i] = std::cos(x[i]);
+        }
+        DoNotOptimize(s.data());
+        DoNotOptimize(c.data());
+        Benchmark::ClobberMemory();
+    }
+}
+
+KASHIPAN_BENCHMARK(SinCos_Fast1024) {
+    const std::vector<float> x = RandomFloats(kBatchCount, -10.0f, 10.0f);
+    std::vector<float> s(kBatchCount), c(kBatchCount);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kBatchCount; ++i) {
+            Math::Fast::SinCos(x[i], s[i], c[i]);
+        }
+        DoNotOptimize(s.data());
+        DoNotOptimize(c.data());
+        Benchmark::ClobberMemory();
+    }
+}
+
+KASHIPAN_BENCHMARK(SinCos_FastBatch1024) {
+    const std::vector<float> x = RandomFloats(kBatchCount, -10.0f, 10.0f);
+    std::vector<float> s(kBatchCount), c(kBatchCount);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        Math::Fast::SinCos(x, s, c);
+        DoNotOptimize(s.data());
+        DoNotOptimize(c.data());
+        Benchmark::ClobberMemory();
+    }
+}
+
+KASHIPAN_BENCHMARK(Atan2_Std1024) {
+    const std::vector<float> y = RandomFloats(kBatchCount, -10.0f, 10.0f);
+    const std::vector<float> x = RandomFloats(kBatchCount, -10.0f, 10.0f);
+    std::vector<float> out(kBatchCount);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kBatchCount; ++i) {
+            out[i] = std::atan2(y[i], x[i]);
+        }
+        DoNotOptimize(out.data());
+        Benchmark::ClobberMemory();
+    }
+}
+
+KASHIPAN_BENCHMARK(Atan2_FastBatch1024) {
+    const std::vector<float> y = RandomFloats(kBatchCount, -10.0f, 10.0f);
+    const std::vector<float> x = RandomFloats(kBatchCount, -10.0f, 10.0f);
+    std::vector<float> out(kBatchCount);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        Math::Fast::Atan2(y, x, out);
+        DoNotOptimize(out.data());
+        Benchmark::ClobberMemory();
+    }
+}
+
+KASHIPAN_BENCHMARK(Rsqrt_Std1024) {
+    const std::vector<float> x = RandomFloats(kBatchCount, 0.01f, 100.0f);
+    std::vector<float> out(kBatchCount);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kBatchCount; ++i) {
+            out[i] = 1.0f / std::sqrt(x[i]);
+        }
+        DoNotOptimize(out.data());
+        Benchmark::ClobberMemory();
+    }
+}
+
+KASHIPAN_BENCHMARK(Rsqrt_FastBatch1024) {
+    const std::vector<float> x = RandomFloats(kBatchCount, 0.01f, 100.0f);
+    std::vector<float> out(kBatchCount);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        Math::Fast::Rsqrt(x, out);
+        DoNotOptimize(out.data());
+        Benchmark::ClobberMemory();
+    }
+}
+
+KASHIPAN_BENCHMARK(Exp_Std1024) {
+    const std::vector<float> x = RandomFloats(kBatchCount, -20.0f, 20.0f);
+    std::vector<float> out(kBatchCount);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kBatchCount; ++i) {
+            out[i] = std::exp(x[i]);
+        }
+        DoNotOptimize(out.data());
+        Benchmark::ClobberMemory();
+    }
+}
+
+KASHIPAN_BENCHMARK(Exp_FastBatch1024) {
+    const std::vector<float> x = RandomFloats(kBatchCount, -20.0f, 20.0f);
+    std::vector<float> out(kBatchCount);
+    state.SetItemsPerOp(kBatchCount);
+    for (auto _ : state) {
+        Math::Fast::Exp(x, out);
+        DoNotOptimize(out.data());
+        Benchmark::ClobberMemory();
+    }
+}
\ No newline at end of file
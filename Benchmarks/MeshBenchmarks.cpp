@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Math/Collider.h"
+#include "Math/TriangleBVH.h"
+#include "Math/MathObjects/Lines.h"
+#include "Math/MathObjects/Sphere.h"
+#include "Math/MathObjects/Triangle.h"
+
+using namespace KashipanEngine;
+using KashipanEngine::Benchmark::DoNotOptimize;
+
+namespace {
+
+constexpr size_t kRayCount = 4096;
+constexpr size_t kSphereCount = 1024;
+
+/// @brief 計測用のメッシュ(位置とインデックスだけ)
+struct BenchMesh {
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    Vector3 min;
+    Vector3 max;
+};
+
+/// @brief Resources以下のobjファイルから位置と面だけを読む(三角形への分け方と左手系への変換はModelと同じ)
+BenchMesh LoadMesh(const std::string &path) {
+    BenchMesh mesh;
+    std::vector<Vector3> positions;
+    std::ifstream file(std::string(KASHIPAN_RESOURCE_DIRECTORY) + "/" + path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream s(line);
+        std::string identifier;
+        s >> identifier;
+        if (identifier == "v") {
+            Vector3 position;
+            s >> position.x >> position.y >> position.z;
+            position.x *= -1.0f;
+            positions.push_back(position);
+        } else if (identifier == "f") {
+            const uint32_t offset = static_cast<uint32_t>(mesh.positions.size());
+            std::string vertexDefinition;
+            while (s >> vertexDefinition) {
+                mesh.positions.push_back(positions[std::stoi(vertexDefinition.substr(0, vertexDefinition.find('/'))) - 1]);
+            }
+            const uint32_t count = static_cast<uint32_t>(mesh.positions.size()) - offset;
+            for (uint32_t i = 0; i + 2 < count; ++i) {
+                if (i % 2 == 0) {
+                    mesh.indices.insert(mesh.indices.end(), { offset + i + 2, offset + i + 1, offset + i });
+                } else {
+                    mesh.indices.insert(mesh.indices.end(), { offset + i - 1, offset + i + 2, offset + i + 1 });
+                }
+            }
+        }
+    }
+
+    mesh.min = Vector3(1e30f);
+    mesh.max = Vector3(-1e30f);
+    for (const Vector3 &position : mesh.positions) {
+        mesh.min = Vector3(std::min(mesh.min.x, position.x), std::min(mesh.min.y, position.y), std::min(mesh.min.z, position.z));
+        mesh.max = Vector3(std::max(mesh.max.x, position.x), std::max(mesh.max.y, position.y), std::max(mesh.max.z, position.z));
+    }
+    return mesh;
+}
+
+/// @brief メッシュの境界ボックスの中の点
+Vector3 RandomPointInBounds(std::mt19937 &random, const BenchMesh &mesh) {
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    Vector3 point(dist(random), dist(random), dist(random));
+    point *= mesh.max - mesh.min;
+    return mesh.min + point;
+}
+
+/// @brief 境界ボックスの外側からボックスの中の点へ向かう半直線
+std::vector<Math::Ray> MakeRays(const BenchMesh &mesh) {
+    std::mt19937 random(2468);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    const Vector3 center = (mesh.min + mesh.max) * 0.5f;
+    const float radius = (mesh.max - mesh.min).Length();
+    std::vector<Math::Ray> rays(kRayCount);
+    for (auto &ray : rays) {
+        Vector3 direction(dist(random), dist(random), dist(random));
+        if (direction.LengthSquared() < 1e-6f) {
+            direction = Vector3(0.0f, 0.0f, 1.0f);
+        }
+        ray.origin = center + direction.Normalize() * radius;
+        ray.diff = RandomPointInBounds(random, mesh) - ray.origin;
+    }
+    return rays;
+}
+
+/// @brief 境界ボックスの中の、対角線の5%の半径の球
+std::vector<Math::Sphere> MakeSpheres(const BenchMesh &mesh) {
+    std::mt19937 random(1357);
+    const float radius = (mesh.max - mesh.min).Length() * 0.05f;
+    std::vector<Math::Sphere> spheres;
+    for (size_t i = 0; i < kSphereCount; ++i) {
+        spheres.emplace_back(RandomPointInBounds(random, mesh), radius);
+    }
+    return spheres;
+}
+
+/// @brief 1秒あたりの数を結果の行末に出力する
+void SetRateLabel(Benchmark::State &state, const BenchMesh &mesh, const char *unit) {
+    const double count = static_cast<double>(state.GetIterations()) * state.GetItemsPerOp();
+    state.SetLabel("triangles=" + std::to_string(mesh.indices.size() / 3) + " " + unit + "/s=" +
+        std::to_string(static_cast<uint64_t>(count / state.GetElapsedNs() * 1e9)));
+}
+
+void RunBuild(Benchmark::State &state, const char *path) {
+    const BenchMesh mesh = LoadMesh(path);
+    Math::TriangleBVH bvh;
+    state.SetItemsPerOp(mesh.indices.size() / 3);
+    for (auto _ : state) {
+        bvh.Build(mesh.positions, mesh.indices);
+        DoNotOptimize(bvh);
+    }
+    state.SetLabel("triangles=" + std::to_string(bvh.GetTriangleCount()) + " nodes=" + std::to_string(bvh.GetNodeCount()));
+}
+
+void RunRefit(Benchmark::State &state, const char *path) {
+    const BenchMesh mesh = LoadMesh(path);
+    Math::TriangleBVH bvh;
+    bvh.Build(mesh.positions, mesh.indices);
+    // 少しずらした頂点と元の頂点を交互に使う
+    std::vector<Vector3> moved = mesh.positions;
+    for (size_t i = 0; i < moved.size(); ++i) {
+        moved[i].y += 0.01f * static_cast<float>(i % 7);
+    }
+    state.SetItemsPerOp(mesh.indices.size() / 3);
+    bool isMoved = false;
+    for (auto _ : state) {
+        isMoved = !isMoved;
+        bvh.Refit(isMoved ? moved : mesh.positions);
+        DoNotOptimize(bvh);
+    }
+}
+
+/// @brief 全ての三角形をMath::Colliderで判定する(BVHが無い場合)
+void RunRaycastBruteForce(Benchmark::State &state, const char *path) {
+    const BenchMesh mesh = LoadMesh(path);
+    const auto rays = MakeRays(mesh);
+    std::vector<Math::Triangle> triangles;
+    for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+        triangles.emplace_back(mesh.positions[mesh.indices[i]], mesh.positions[mesh.indices[i + 1]], mesh.positions[mesh.indices[i + 2]]);
+    }
+    state.SetItemsPerOp(rays.size());
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        for (const auto &ray : rays) {
+            for (const auto &triangle : triangles) {
+                if (Math::Collider::IsCollision(triangle, ray)) {
+                    ++hits;
+                    break;
+                }
+            }
+        }
+        DoNotOptimize(hits);
+    }
+    SetRateLabel(state, mesh, "rays");
+}
+
+void RunRaycast(Benchmark::State &state, const char *path, bool isAnyHit) {
+    const BenchMesh mesh = LoadMesh(path);
+    const auto rays = MakeRays(mesh);
+    Math::TriangleBVH bvh;
+    bvh.Build(mesh.positions, mesh.indices);
+    state.SetItemsPerOp(rays.size());
+    for (auto _ : state) {
+        uint32_t hits = 0;
+        for (const auto &ray : rays) {
+            if (isAnyHit) {
+                hits += bvh.IsCollision(ray);
+            } else {
+                Math::TriangleBVH::RaycastHit hit;
+                hits += bvh.Raycast(ray, hit);
+            }
+        }
+        DoNotOptimize(hits);
+    }
+    SetRateLabel(state, mesh, "rays");
+}
+
+void RunSphereOverlap(Benchmark::State &state, const char *path) {
+    const BenchMesh mesh = LoadMesh(path);
+    const auto spheres = MakeSpheres(mesh);
+    Math::TriangleBVH bvh;
+    bvh.Build(mesh.positions, mesh.indices);
+    std::vector<uint32_t> triangles;
+    state.SetItemsPerOp(spheres.size());
+    for (auto _ : state) {
+        triangles.clear();
+        for (const auto &sphere : spheres) {
+            bvh.GetOverlappingTriangles(sphere, triangles);
+        }
+        DoNotOptimize(triangles.data());
+    }
+    SetRateLabel(state, mesh, "queries");
+}
+
+} // namespace
+
+//==================================================
+// TriangleBVH(Resources以下のモデル。items = 三角形の数、または半直線・球の数)
+// BruteForceは全ての三角形をMath::Colliderで判定したもの(当たった時点で打ち切る)
+//==================================================
+
+KASHIPAN_BENCHMARK(BVH_Build_Skydome) {
+    RunBuild(state, "Skydome/skydome.obj");
+}
+
+KASHIPAN_BENCHMARK(BVH_Build_Enemy) {
+    RunBuild(state, "Enemy/enemy.obj");
+}
+
+KASHIPAN_BENCHMARK(BVH_Refit_Skydome) {
+    RunRefit(state, "Skydome/skydome.obj");
+}
+
+KASHIPAN_BENCHMARK(BVH_RaycastBruteForce_Skydome) {
+    RunRaycastBruteForce(state, "Skydome/skydome.obj");
+}
+
+KASHIPAN_BENCHMARK(BVH_RaycastClosest_Skydome) {
+    RunRaycast(state, "Skydome/skydome.obj", false);
+}
+
+KASHIPAN_BENCHMARK(BVH_RaycastAny_Skydome) {
+    RunRaycast(state, "Skydome/skydome.obj", true);
+}
+
+KASHIPAN_BENCHMARK(BVH_RaycastBruteForce_Enemy) {
+    RunRaycastBruteForce(state, "Enemy/enemy.obj");
+}
+
+KASHIPAN_BENCHMARK(BVH_RaycastClosest_Enemy) {
+    RunRaycast(state, "Enemy/enemy.obj", false);
+}
+
+KASHIPAN_BENCHMARK(BVH_RaycastAny_Enemy) {
+    RunRaycast(state, "Enemy/enemy.obj", true);
+}
+
+KASHIPAN_BENCHMARK(BVH_RaycastClosest_Player) {
+    RunRaycast(state, "player/player.obj", false);
+}
+
+KASHIPAN_BENCHMARK(BVH_SphereOverlap_Skydome) {
+    RunSphereOverlap(state, "Skydome/skydome.obj");
+}
+
+KASHIPAN_BENCHMARK(BVH_SphereOverlap_Enemy) {
+    RunSphereOverlap(state, "Enemy/enemy.obj");
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Common/ObjectPool.h"
+
+using namespace KashipanEngine;
+using KashipanEngine::Benchmark::DoNotOptimize;
+
+namespace {
+
+// 1フレームに出すオブジェクトの数と、オブジェクトが消えるまでのフレーム数の範囲
+constexpr uint32_t kSpawnPerFrame = 32;
+constexpr int kMinLifeFrames = 30;
+constexpr int kMaxLifeFrames = 90;
+// 同時に出ているオブジェクトの数の最大(プールはこの数だけ先に作っておく)
+constexpr size_t kWarmUpCount = static_cast<size_t>(kSpawnPerFrame) * kMaxLifeFrames;
+// モデルとワールド変換のバッファの代わりに持つデータの大きさ(float)
+constexpr size_t kResourceSize = 1024;
+// 結果を比べる前に進めるフレーム数
+constexpr int kVerifyFrameCount = 300;
+
+// 作ったオブジェクトの数(作る処理が呼ばれた回数を数える)
+uint64_t sCreatedCount = 0;
+
+/// @brief 作る時にリソースを用意する重いオブジェクト(PlayerBulletやEnemyのモデルとバッファの代わり)
+class ResourceObject {
+public:
+    ResourceObject() : resource_(kResourceSize) {
+        // モデルの読み込みとバッファへの書き込みの代わり
+        for (size_t i = 0; i < resource_.size(); ++i) {
+            resource_[i] = static_cast<float>(i) * 0.5f;
+        }
+        ++sCreatedCount;
+    }
+
+    /// @brief 出し直す(リソースは作り直さない)
+    void Initialize(int lifeFrames) {
+        lifeFrames_ = lifeFrames;
+        resource_[0] = static_cast<float>(lifeFrames);
+    }
+    /// @brief 1フレーム進める
+    /// @return まだ残っているか
+    bool Update() {
+        return --lifeFrames_ > 0;
+    }
+
+private:
+    std::vector<float> resource_;
+    int lifeFrames_ = 0;
+};
+
+/// @brief 出すオブジェクトの寿命を決まった順番で作る(2つの実装に同じ順番で同じ寿命を渡す)
+class Spawner {
+public:
+    int Next() {
+        return distLifeFrames_(random_);
+    }
+
+private:
+    std::mt19937 random_{ 13579 };
+    std::uniform_int_distribution<int> distLifeFrames_{ kMinLifeFrames, kMaxLifeFrames };
+};
+
+/// @brief 以前のGameSceneと同じく、出す時にmake_uniqueで作って消える時に破棄する場面
+struct NewScene {
+    std::vector<std::unique_ptr<ResourceObject>> objects;
+    Spawner spawner;
+
+    /// @brief 1フレーム分の更新・削除・追加
+    /// @return 残っているオブジェクトの数
+    size_t Step() {
+        std::erase_if(objects, [](const std::unique_ptr<ResourceObject> &object) {
+            return !object->Update();
+            });
+        for (uint32_t i = 0; i < kSpawnPerFrame; ++i) {
+            auto &object = objects.emplace_back(std::make_unique<ResourceObject>());
+            object->Initialize(spawner.Next());
+        }
+        return objects.size();
+    }
+};
+
+/// @brief ObjectPoolから取り出して、消える時にプールに戻す場面
+struct PoolScene {
+    ObjectPool<ResourceObject> pool{ []() { return std::make_unique<ResourceObject>(); } };
+    std::vector<ObjectPool<ResourceObject>::Handle> objects;
+    Spawner spawner;
+
+    PoolScene() {
+        pool.WarmUp(kWarmUpCount);
+    }
+    /// @brief 1フレーム分の更新・削除・追加
+    /// @return 残っているオブジェクトの数
+    size_t Step() {
+        std::erase_if(objects, [](const ObjectPool<ResourceObject>::Handle &object) {
+            return !object->Update();
+            });
+        for (uint32_t i = 0; i < kSpawnPerFrame; ++i) {
+            auto &object = objects.emplace_back(pool.Acquire());
+            object->Initialize(spawner.Next());
+        }
+        return objects.size();
+    }
+};
+
+/// @brief 2つの実装を同じフレーム数だけ進め、残っている数が一致するかとプールの統計を調べる
+std::string Verify() {
+    NewScene newScene;
+    PoolScene poolScene;
+    size_t countMismatches = 0;
+    for (int frame = 0; frame < kVerifyFrameCount; ++frame) {
+        countMismatches += newScene.Step() != poolScene.Step() ? 1 : 0;
+    }
+    return "count mismatches=" + std::to_string(countMismatches) +
+        " peak=" + std::to_string(poolScene.pool.GetHighWaterMark()) +
+        " warm-up=" + std::to_string(kWarmUpCount) +
+        " grown=" + std::to_string(poolScene.pool.GetGrownCount());
+}
+
+/// @brief ベンチマークのフレームの間に作ったオブジェクトの数を1フレームあたりにして返す
+std::string CreatedPerFrame(uint64_t createdCount, uint64_t frameCount) {
+    return "created/frame=" + std::to_string(frameCount > 0 ?
+        static_cast<double>(createdCount) / static_cast<double>(frameCount) : 0.0);
+}
+
+} // namespace
+
+//==================================================
+// オブジェクトの使い回し(ops = 1フレーム分、items = 1フレームに出すオブジェクトの数)
+// 毎フレーム32個のオブジェクトを出し、30～90フレームで消す(同時に出ている数は2000前後)
+// オブジェクトは作る時に4KBのリソースを用意する(PlayerBulletやEnemyのモデルとワールド変換のバッファの代わり)
+// Newは以前のGameSceneと同じく、出す時にmake_uniqueで作って消える時に破棄する
+// PoolはObjectPool(同時に出る数の最大まで先に作っておき、取り出して初期化し、消える時にプールに戻す)
+// created/frameは測っている間に1フレームで作ったオブジェクトの数(Poolは0になる)
+// Poolのラベルは2つの実装を300フレーム進めて比べたもの。count mismatchesは残っている数が違ったフレーム数(0になる)、
+// peakは同時に取り出されていた数の最大、grownは空きが無くて取り出す時に作った数(0になる)
+//==================================================
+
+KASHIPAN_BENCHMARK(ObjectPool_New_Frame) {
+    NewScene scene;
+    const uint64_t createdBefore = sCreatedCount;
+    uint64_t frameCount = 0;
+    state.SetItemsPerOp(kSpawnPerFrame);
+    for (auto _ : state) {
+        DoNotOptimize(scene.Step());
+        ++frameCount;
+    }
+    state.SetLabel(CreatedPerFrame(sCreatedCount - createdBefore, frameCount));
+}
+
+KASHIPAN_BENCHMARK(ObjectPool_Pool_Frame) {
+    PoolScene scene;
+    const uint64_t createdBefore = sCreatedCount;
+    uint64_t frameCount = 0;
+    state.SetItemsPerOp(kSpawnPerFrame);
+    for (auto _ : state) {
+        DoNotOptimize(scene.Step());
+        ++frameCount;
+    }
+    // Verifyの中でも作るので、先に数えておく
+    const std::string createdPerFrame = CreatedPerFrame(sCreatedCount - createdBefore, frameCount);
+    state.SetLabel(createdPerFrame + " " + Verify());
+}
\ No newline at end of file
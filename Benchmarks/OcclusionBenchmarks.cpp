@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "OcclusionScene.h"
+#include "Math/OcclusionCuller.h"
+
+using namespace KashipanEngine;
+using KashipanEngine::Benchmark::DoNotOptimize;
+
+namespace {
+
+/// @brief 割合を百分率の文字列にする
+std::string ToPercent(size_t count, size_t total) {
+    const double percent = total ? 100.0 * static_cast<double>(count) / static_cast<double>(total) : 0.0;
+    std::string text = std::to_string(percent);
+    return text.substr(0, text.find('.') + 2) + "%";
+}
+
+} // namespace
+
+//==================================================
+// OcclusionCuller(地面と16個の大きな箱を遮蔽物に、3000個の小さな箱をカメラ8か所で判定する。items = 物体の数)
+// Frameは遮蔽物を描いてから全ての物体を判定する1フレーム分。culledは隠れていると判定した割合、
+// hiddenは画素の中心を通る半直線で調べて実際に見えなかった割合、falseCullsは見えていたのに隠れていると判定した数
+// (場面と検証はTests/OcclusionScene.cppにあり、falseCullsが0であることはTests/OcclusionCullerTests.cppで確かめる)
+//==================================================
+
+KASHIPAN_BENCHMARK(Occlusion_Frame) {
+    const Test::OcclusionScene scene = Test::MakeOcclusionScene();
+    const Test::OcclusionVerification verification = Test::VerifyOcclusion(scene);
+    Math::OcclusionCuller culler;
+    state.SetItemsPerOp(scene.objects.size());
+    size_t frame = 0;
+    for (auto _ : state) {
+        Test::RenderOccluders(culler, scene, scene.viewProjections[frame++ % scene.viewProjections.size()]);
+        uint32_t visibleCount = 0;
+        for (const auto &object : scene.objects) {
+            visibleCount += culler.IsVisible(Vector3(-0.5f), Vector3(0.5f), object.worldMatrix);
+        }
+        DoNotOptimize(visibleCount);
+    }
+    const size_t total = scene.objects.size() * scene.viewProjections.size();
+    state.SetLabel("culled=" + ToPercent(verification.culled, total) + " hidden=" + ToPercent(verification.hidden, total) +
+        " falseCulls=" + std::to_string(verification.falseCulls) + " us/frame=" +
+        std::to_string(static_cast<double>(state.GetElapsedNs()) / static_cast<double>(state.GetIterations()) * 1e-3));
+}
+
+KASHIPAN_BENCHMARK(Occlusion_RasterizeOccluders) {
+    const Test::OcclusionScene scene = Test::MakeOcclusionScene();
+    Math::OcclusionCuller culler;
+    state.SetItemsPerOp(scene.objects.size());
+    size_t frame = 0;
+    uint32_t triangleCount = 0;
+    for (auto _ : state) {
+        Test::RenderOccluders(culler, scene, scene.viewProjections[frame++ % scene.viewProjections.size()]);
+        triangleCount += culler.GetRasterizedTriangleCount();
+        DoNotOptimize(culler);
+    }
+    state.SetLabel("rasterizedTriangles/frame=" + std::to_string(triangleCount / std::max<uint64_t>(1, state.GetIterations())));
+}
+
+KASHIPAN_BENCHMARK(Occlusion_TestBounds) {
+    const Test::OcclusionScene scene = Test::MakeOcclusionScene();
+    std::vector<Math::OcclusionCuller> cullers(scene.viewProjections.size());
+    for (size_t i = 0; i < cullers.size(); ++i) {
+        Test::RenderOccluders(cullers[i], scene, scene.viewProjections[i]);
+    }
+    state.SetItemsPerOp(scene.objects.size());
+    size_t frame = 0;
+    for (auto _ : state) {
+        const auto &culler = cullers[frame++ % cullers.size()];
+        uint32_t visibleCount = 0;
+        for (const auto &object : scene.objects) {
+            visibleCount += culler.IsVisible(Vector3(-0.5f), Vector3(0.5f), object.worldMatrix);
+        }
+        DoNotOptimize(visibleCount);
+    }
+}
\ No newline at end of file
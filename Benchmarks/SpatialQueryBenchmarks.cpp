@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Math/RenderingPipeline.h"
+#include "Math/SpatialQuery.h"
+
+using namespace KashipanEngine;
+using KashipanEngine::Benchmark::DoNotOptimize;
+
+namespace {
+
+constexpr size_t kEnemyCount = 5000;
+constexpr size_t kQueryCount = 1024;
+constexpr size_t kTargetCount = 3;
+constexpr float kLockOnRange = 50.0f;
+
+/// @brief 計測用の敵(位置だけを持つ)
+struct BenchEnemy {
+    Vector3 position;
+};
+
+/// @brief 自機の前方の横長の空間に散らばった敵(GameSceneと同じくstd::list<std::unique_ptr>で持つ)
+std::list<std::unique_ptr<BenchEnemy>> MakeEnemies() {
+    std::mt19937 random(97531);
+    std::uniform_real_distribution<float> distX(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> distY(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> distZ(-100.0f, 300.0f);
+    std::list<std::unique_ptr<BenchEnemy>> enemies;
+    for (size_t i = 0; i < kEnemyCount; ++i) {
+        enemies.push_back(std::make_unique<BenchEnemy>(BenchEnemy{ Vector3(distX(random), distY(random), distZ(random)) }));
+    }
+    return enemies;
+}
+
+/// @brief 原点から+zを向いたカメラのビュープロジェクション行列
+Matrix4x4 MakeCameraViewProjection() {
+    return MakeViewMatrix(Vector3(0.0f, 0.0f, -10.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f)) *
+        MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 1000.0f);
+}
+
+/// @brief 敵の位置をSoAにして持つ
+struct EnemyPositions {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+
+    EnemyPositions() = default;
+    explicit EnemyPositions(const std::list<std::unique_ptr<BenchEnemy>> &enemies) {
+        for (const auto &enemy : enemies) {
+            x.push_back(enemy->position.x);
+            y.push_back(enemy->position.y);
+            z.push_back(enemy->position.z);
+        }
+    }
+};
+
+/// @brief LockOn::Updateと同じく、範囲内の敵の位置だけを集める
+void GatherInRange(const std::list<std::unique_ptr<BenchEnemy>> &enemies, const Vector3 &referencePoint, float range,
+    EnemyPositions &outPositions) {
+    outPositions.x.clear();
+    outPositions.y.clear();
+    outPositions.z.clear();
+    const float rangeSquared = range * range;
+    for (const auto &enemy : enemies) {
+        if ((enemy->position - referencePoint).LengthSquared() > rangeSquared) {
+            continue;
+        }
+        outPositions.x.push_back(enemy->position.x);
+        outPositions.y.push_back(enemy->position.y);
+        outPositions.z.push_back(enemy->position.z);
+    }
+}
+
+/// @brief 以前のLockOn::Updateと同じ処理(全ての敵との距離を平方根で求め、範囲内を全て並べ替えて先頭を取る)
+size_t LockOnSortAll(const std::list<std::unique_ptr<BenchEnemy>> &enemies, const Vector3 &referencePoint,
+    float range, std::list<BenchEnemy *> &outTargets) {
+    outTargets.clear();
+    std::vector<std::pair<BenchEnemy *, float>> candidates;
+    for (auto &enemy : enemies) {
+        float distance = referencePoint.Distance(enemy->position);
+        if (distance <= range) {
+            candidates.emplace_back(enemy.get(), distance);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+        [](const std::pair<BenchEnemy *, float> &a, const std::pair<BenchEnemy *, float> &b) {
+            return a.second < b.second;
+        });
+    for (size_t i = 0; i < std::min(candidates.size(), kTargetCount); ++i) {
+        outTargets.push_back(candidates[i].first);
+    }
+    return outTargets.size();
+}
+
+/// @brief 探索の中心(敵と同じ空間の中)
+std::vector<Vector3> MakeQueryCenters() {
+    std::mt19937 random(86420);
+    std::uniform_real_distribution<float> distX(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> distY(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> distZ(-100.0f, 300.0f);
+    std::vector<Vector3> centers(kQueryCount);
+    for (auto &center : centers) {
+        center = Vector3(distX(random), distY(random), distZ(random));
+    }
+    return centers;
+}
+
+/// @brief 全ての点との距離の2乗を候補にする
+std::vector<Math::SpatialQuery::Result> MakeCandidates(const EnemyPositions &positions, const Vector3 &center) {
+    std::vector<Math::SpatialQuery::Result> candidates(positions.x.size());
+    for (uint32_t i = 0; i < candidates.size(); ++i) {
+        candidates[i] = { i, (Vector3(positions.x[i], positions.y[i], positions.z[i]) - center).LengthSquared() };
+    }
+    return candidates;
+}
+
+} // namespace
+
+//==================================================
+// LockOn(5000体の敵から、自機に近い3体を選ぶ1フレーム分。items = 敵の数)
+// SortAllは以前のLockOn::Updateと同じ処理。SpatialQueryはLockOnと同じく、リストから範囲内の位置を集めて
+// グリッドを作らずにBuildするところから含む
+//==================================================
+
+KASHIPAN_BENCHMARK(LockOn_SortAll_Range50) {
+    const auto enemies = MakeEnemies();
+    std::list<BenchEnemy *> targets;
+    state.SetItemsPerOp(kEnemyCount);
+    for (auto _ : state) {
+        DoNotOptimize(LockOnSortAll(enemies, Vector3(0.0f), kLockOnRange, targets));
+    }
+}
+
+KASHIPAN_BENCHMARK(LockOn_SortAll_RangeAll) {
+    const auto enemies = MakeEnemies();
+    std::list<BenchEnemy *> targets;
+    state.SetItemsPerOp(kEnemyCount);
+    for (auto _ : state) {
+        DoNotOptimize(LockOnSortAll(enemies, Vector3(0.0f), 1.0e4f, targets));
+    }
+}
+
+KASHIPAN_BENCHMARK(LockOn_SpatialQuery_Range50) {
+    const auto enemies = MakeEnemies();
+    Math::SpatialQuery query;
+    EnemyPositions positions;
+    Math::SpatialQuery::Result results[kTargetCount];
+    state.SetItemsPerOp(kEnemyCount);
+    for (auto _ : state) {
+        GatherInRange(enemies, Vector3(0.0f), kLockOnRange, positions);
+        query.Build(positions.x, positions.y, positions.z, Math::SpatialQuery::kNoGrid);
+        DoNotOptimize(query.FindNearest(Vector3(0.0f), kLockOnRange, results));
+    }
+}
+
+KASHIPAN_BENCHMARK(LockOn_SpatialQuery_RangeAll) {
+    const auto enemies = MakeEnemies();
+    Math::SpatialQuery query;
+    EnemyPositions positions;
+    Math::SpatialQuery::Result results[kTargetCount];
+    state.SetItemsPerOp(kEnemyCount);
+    for (auto _ : state) {
+        GatherInRange(enemies, Vector3(0.0f), 1.0e4f, positions);
+        query.Build(positions.x, positions.y, positions.z, Math::SpatialQuery::kNoGrid);
+        DoNotOptimize(query.FindNearest(Vector3(0.0f), 1.0e4f, results));
+    }
+}
+
+KASHIPAN_BENCHMARK(LockOn_SpatialQuery_Frustum) {
+    const auto enemies = MakeEnemies();
+    const Matrix4x4 viewProjection = MakeCameraViewProjection();
+    Math::SpatialQuery query;
+    EnemyPositions positions;
+    Math::SpatialQuery::Result results[kTargetCount];
+    state.SetItemsPerOp(kEnemyCount);
+    for (auto _ : state) {
+        GatherInRange(enemies, Vector3(0.0f), kLockOnRange, positions);
+        query.Build(positions.x, positions.y, positions.z, Math::SpatialQuery::kNoGrid);
+        DoNotOptimize(query.FindNearestInFrustum(Vector3(0.0f), kLockOnRange, viewProjection, results));
+    }
+}
+
+//==================================================
+// SpatialQuery(5000点。Buildはitems = 点の数、Find*はitems = 探索の数)
+// Find*は誘導弾のように、1回のBuildに対して多数の中心から探す場合。*_NoGridはグリッドを作らずに全ての点を調べたもの
+//==================================================
+
+KASHIPAN_BENCHMARK(SpatialQuery_Build) {
+    const EnemyPositions positions(MakeEnemies());
+    Math::SpatialQuery query;
+    state.SetItemsPerOp(kEnemyCount);
+    for (auto _ : state) {
+        query.Build(positions.x, positions.y, positions.z);
+        DoNotOptimize(query);
+    }
+}
+
+KASHIPAN_BENCHMARK(SpatialQuery_FindNearest_K3) {
+    const EnemyPositions positions(MakeEnemies());
+    const auto centers = MakeQueryCenters();
+    Math::SpatialQuery query;
+    query.Build(positions.x, positions.y, positions.z);
+    Math::SpatialQuery::Result results[kTargetCount];
+    state.SetItemsPerOp(kQueryCount);
+    for (auto _ : state) {
+        size_t found = 0;
+        for (const auto &center : centers) {
+            found += query.FindNearest(center, kLockOnRange, results);
+        }
+        DoNotOptimize(found);
+    }
+}
+
+KASHIPAN_BENCHMARK(SpatialQuery_FindNearestInCone_K3) {
+    const EnemyPositions positions(MakeEnemies());
+    const auto centers = MakeQueryCenters();
+    Math::SpatialQuery query;
+    query.Build(positions.x, positions.y, positions.z);
+    Math::SpatialQuery::Result results[kTargetCount];
+    // 前方の半角30度
+    const float cosHalfAngle = 0.8660254f;
+    state.SetItemsPerOp(kQueryCount);
+    for (auto _ : state) {
+        size_t found = 0;
+        for (const auto &center : centers) {
+            found += query.FindNearestInCone(center, kLockOnRange, Vector3(0.0f, 0.0f, 1.0f), cosHalfAngle, results);
+        }
+        DoNotOptimize(found);
+    }
+}
+
+KASHIPAN_BENCHMARK(SpatialQuery_FindNearest_K3_NoGrid) {
+    const EnemyPositions positions(MakeEnemies());
+    const auto centers = MakeQueryCenters();
+    Math::SpatialQuery query;
+    query.Build(positions.x, positions.y, positions.z, Math::SpatialQuery::kNoGrid);
+    Math::SpatialQuery::Result results[kTargetCount];
+    state.SetItemsPerOp(kQueryCount);
+    for (auto _ : state) {
+        size_t found = 0;
+        for (const auto &center : centers) {
+            found += query.FindNearest(center, kLockOnRange, results);
+        }
+        DoNotOptimize(found);
+    }
+}
+
+KASHIPAN_BENCHMARK(SpatialQuery_Build_NoGrid) {
+    const EnemyPositions positions(MakeEnemies());
+    Math::SpatialQuery query;
+    state.SetItemsPerOp(kEnemyCount);
+    for (auto _ : state) {
+        query.Build(positions.x, positions.y, positions.z, Math::SpatialQuery::kNoGrid);
+        DoNotOptimize(query);
+    }
+}
+
+//==================================================
+// SelectNearest(5000個の候補から3個を選ぶ。items = 候補の数)
+// FullSortは候補全体をstd::sortで並べ替えた場合
+//==================================================
+
+KASHIPAN_BENCHMARK(SpatialQuery_SelectNearest_K3) {
+    const auto candidates = MakeCandidates(EnemyPositions(MakeEnemies()), Vector3(0.0f));
+    auto work = candidates;
+    state.SetItemsPerOp(candidates.size());
+    for (auto _ : state) {
+        std::copy(candidates.begin(), candidates.end(), work.begin());
+        DoNotOptimize(Math::SpatialQuery::SelectNearest(work, kTargetCount));
+    }
+}
+
+KASHIPAN_BENCHMARK(SpatialQuery_SelectNearest_FullSort) {
+    const auto candidates = MakeCandidates(EnemyPositions(MakeEnemies()), Vector3(0.0f));
+    auto work = candidates;
+    state.SetItemsPerOp(candidates.size());
+    for (auto _ : state) {
+        std::copy(candidates.begin(), candidates.end(), work.begin());
+        std::sort(work.begin(), work.end(), [](const auto &a, const auto &b) { return a.distanceSquared < b.distanceSquared; });
+        DoNotOptimize(work.data());
+    }
+}
\ No newline at end of file
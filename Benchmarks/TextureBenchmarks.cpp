@@ -0,0 +1,67 @@
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Common/ImageDecoder.h"
+#include "Common/MipGenerator.h"
+
+using namespace KashipanEngine;
+using KashipanEngine::Benchmark::DoNotOptimize;
+
+namespace {
+
+/// @brief Resources以下のファイルをそのまま読む
+std::vector<uint8_t> LoadFile(const std::string &path) {
+    std::ifstream file(std::string(KASHIPAN_RESOURCE_DIRECTORY) + "/" + path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+/// @brief 画像を読み込んでデコードする(読み込めなければ空)
+DecodedImage LoadImage(const std::string &path) {
+    DecodedImage image;
+    if (!ImageDecoder::LoadFromFile(std::string(KASHIPAN_RESOURCE_DIRECTORY) + "/" + path, image)) {
+        image = DecodedImage();
+    }
+    return image;
+}
+
+/// @brief 画像のミップマップを全て作る
+void RunMipGeneration(Benchmark::State &state, const std::string &path) {
+    const DecodedImage image = LoadImage(path);
+    std::vector<DecodedImage> mips;
+    state.SetItemsPerOp(static_cast<uint64_t>(image.width) * image.height);
+    for (auto _ : state) {
+        DoNotOptimize(MipGenerator::Generate(image, mips));
+    }
+    state.SetLabel(std::to_string(image.width) + "x" + std::to_string(image.height) +
+        " levels=" + std::to_string(mips.size() + 1));
+}
+
+} // namespace
+
+//==================================================
+// テクスチャの読み込み(ops = 画像1枚分、items = 元画像のピクセル数)
+// DecodeはImageDecoderでのPNGのデコード(ファイルの読み込みは含まない)
+// MipはMipGeneratorで1x1までのミップマップを作る処理(リニアへの変換・縮小・sRGBへの丸め)
+// Skydomeは2160x1080で、奇数の辺(135, 67, 33...)を3タップで縮小するレベルを含む
+// OpenMPを有効にしていないビルドなので1スレッドでの時間
+//==================================================
+
+KASHIPAN_BENCHMARK(Texture_Decode_Skydome) {
+    const std::vector<uint8_t> file = LoadFile("Skydome/skydome.png");
+    DecodedImage image;
+    for (auto _ : state) {
+        DoNotOptimize(ImageDecoder::Decode(file.data(), file.size(), image));
+    }
+    state.SetItemsPerOp(static_cast<uint64_t>(image.width) * image.height);
+}
+
+KASHIPAN_BENCHMARK(Texture_Mip_Skydome) {
+    RunMipGeneration(state, "Skydome/skydome.png");
+}
+
+KASHIPAN_BENCHMARK(Texture_Mip_UvChecker) {
+    RunMipGeneration(state, "uvChecker.png");
+}
\ No newline at end of file
@@ -1 +0,0 @@
-#include "BaseEnemyState.h"
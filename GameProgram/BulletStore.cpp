@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <cassert>
+#include <Math/Collider.h>
+#include <Math/MathObjects/Sphere.h>
+#include "BulletStore.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 弾のモデルの前方向と上方向
+const Vector3 kForward(0.0f, 0.0f, 1.0f);
+const Vector3 kUp(0.0f, 1.0f, 0.0f);
+
+/// @brief 末尾の要素を移して詰める
+template<class T>
+void SwapRemove(std::vector<T> &values, uint32_t index) {
+    values[index] = values.back();
+    values.pop_back();
+}
+
+} // namespace
+
+BulletStore::BulletStore() :
+    broadphase_(std::make_unique<Math::HashGridBroadphase>()) {
+}
+
+uint32_t BulletStore::Spawn(const Vector3 &position, const Vector3 &velocity, float radius, float lifeTime, State state,
+    const Vector4 &color, uint32_t targetId) {
+    assert(state != State::kHoming || targetId != kNoTarget);
+    const uint32_t index = GetCount();
+    positions_.push_back(position);
+    previousPositions_.push_back(position);
+    velocities_.push_back(velocity);
+    rotations_.push_back(Quaternion::LookRotation(velocity, kUp));
+    radii_.push_back(radius);
+    lifeTimes_.push_back(lifeTime);
+    states_.push_back(state);
+    colors_.push_back(color);
+    targetIds_.push_back(state == State::kHoming ? targetId : kNoTarget);
+    isAlive_.push_back(true);
+    boundsX_.push_back(position.x);
+    boundsY_.push_back(position.y);
+    boundsZ_.push_back(position.z);
+    boundsRadius_.push_back(radius);
+    return index;
+}
+
+void BulletStore::Steer(const Vector3 &targetPosition, float t) {
+    const uint32_t count = GetCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (states_[i] != State::kSteer) {
+            continue;
+        }
+        // 向きを目標の方向へ補間し、向いている方向を速度にする
+        const Quaternion toTarget = Quaternion::LookRotation(targetPosition - positions_[i], kUp);
+        rotations_[i] = Quaternion::SlerpFast(rotations_[i], toTarget, t);
+        velocities_[i] = rotations_[i].RotateVector(kForward) * velocities_[i].Length();
+    }
+}
+
+void BulletStore::Home(std::span<const uint32_t> targetIndices, std::span<const Vector3> targetPositions, float speed) {
+    const uint32_t count = GetCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (states_[i] != State::kHoming) {
+            continue;
+        }
+        // 居なくなった目標はReleaseTargetsで先に外しておく
+        assert(targetIds_[i] < targetIndices.size() && targetIndices[targetIds_[i]] < targetPositions.size());
+        const Vector3 toTarget = targetPositions[targetIndices[targetIds_[i]]] - positions_[i];
+        // 目標に重なっている時は向きを変えない
+        if (toTarget.LengthSquared() == 0.0f) {
+            continue;
+        }
+        velocities_[i] = toTarget.Normalize() * speed;
+        rotations_[i] = Quaternion::LookRotation(velocities_[i], kUp);
+    }
+}
+
+void BulletStore::ReleaseTargets(std::span<const uint32_t> targetIds, const Vector4 &color) {
+    if (targetIds.empty()) {
+        return;
+    }
+    const uint32_t count = GetCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (states_[i] != State::kHoming || std::find(targetIds.begin(), targetIds.end(), targetIds_[i]) == targetIds.end()) {
+            continue;
+        }
+        states_[i] = State::kStraight;
+        targetIds_[i] = kNoTarget;
+        colors_[i] = color;
+    }
+}
+
+void BulletStore::Update(float deltaTime) {
+    const uint32_t count = GetCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        const Vector3 previous = positions_[i];
+        const Vector3 movement = velocities_[i] * deltaTime;
+        previousPositions_[i] = previous;
+        positions_[i] = previous + movement;
+
+        lifeTimes_[i] -= deltaTime;
+        if (lifeTimes_[i] <= 0.0f) {
+            isAlive_[i] = false;
+        }
+
+        // 移動前と移動後の球の両方を囲む球
+        const Vector3 center = previous + movement * 0.5f;
+        boundsX_[i] = center.x;
+        boundsY_[i] = center.y;
+        boundsZ_[i] = center.z;
+        boundsRadius_[i] = radii_[i] + movement.Length() * 0.5f;
+    }
+}
+
+void BulletStore::FindHits(const Math::SphereSoA &targets, std::span<const Vector3> targetPreviousPositions,
+    std::vector<Math::CollisionPair> &outHits) {
+    assert(targetPreviousPositions.size() == targets.Size());
+    outHits.clear();
+    if (positions_.empty() || targets.Size() == 0) {
+        return;
+    }
+
+    // 相手の移動前と移動後の球の両方を囲む球
+    const size_t targetCount = targets.Size();
+    targetBoundsX_.resize(targetCount);
+    targetBoundsY_.resize(targetCount);
+    targetBoundsZ_.resize(targetCount);
+    targetBoundsRadius_.resize(targetCount);
+    for (size_t i = 0; i < targetCount; ++i) {
+        const Vector3 position(targets.centerX[i], targets.centerY[i], targets.centerZ[i]);
+        const Vector3 center = (targetPreviousPositions[i] + position) * 0.5f;
+        targetBoundsX_[i] = center.x;
+        targetBoundsY_[i] = center.y;
+        targetBoundsZ_[i] = center.z;
+        targetBoundsRadius_[i] = targets.radius[i] + (position - targetPreviousPositions[i]).Length() * 0.5f;
+    }
+
+    const Math::SphereSoA bounds{ boundsX_, boundsY_, boundsZ_, boundsRadius_ };
+    const Math::SphereSoA targetBounds{ targetBoundsX_, targetBoundsY_, targetBoundsZ_, targetBoundsRadius_ };
+    broadphase_->FindPairs(bounds, targetBounds, candidates_);
+    for (const Math::CollisionPair &candidate : candidates_) {
+        const uint32_t index = candidate.indexA;
+        if (!isAlive_[index]) {
+            continue;
+        }
+        // 弾も相手も、前の位置から今の位置までの移動全体で判定する
+        const uint32_t targetIndex = candidate.indexB;
+        const Math::Sphere bullet(previousPositions_[index], radii_[index]);
+        const Math::Sphere target(targetPreviousPositions[targetIndex], targets.radius[targetIndex]);
+        const Vector3 targetPosition(targets.centerX[targetIndex], targets.centerY[targetIndex], targets.centerZ[targetIndex]);
+        float time;
+        if (Math::Collider::IsCollision(bullet, positions_[index] - previousPositions_[index],
+            target, targetPosition - target.center, time)) {
+            outHits.push_back(candidate);
+        }
+    }
+}
+
+void BulletStore::RemoveDead() {
+    // 後ろから詰めると、移してきた弾をもう一度調べずに済む
+    for (uint32_t i = GetCount(); i-- > 0;) {
+        if (!isAlive_[i]) {
+            RemoveAt(i);
+        }
+    }
+}
+
+void BulletStore::Clear() {
+    positions_.clear();
+    previousPositions_.clear();
+    velocities_.clear();
+    rotations_.clear();
+    radii_.clear();
+    lifeTimes_.clear();
+    states_.clear();
+    colors_.clear();
+    targetIds_.clear();
+    isAlive_.clear();
+    boundsX_.clear();
+    boundsY_.clear();
+    boundsZ_.clear();
+    boundsRadius_.clear();
+}
+
+void BulletStore::RemoveAt(uint32_t index) {
+    assert(index < GetCount());
+    SwapRemove(positions_, index);
+    SwapRemove(previousPositions_, index);
+    SwapRemove(velocities_, index);
+    SwapRemove(rotations_, index);
+    SwapRemove(radii_, index);
+    SwapRemove(lifeTimes_, index);
+    SwapRemove(states_, index);
+    SwapRemove(colors_, index);
+    SwapRemove(targetIds_, index);
+    SwapRemove(isAlive_, index);
+    SwapRemove(boundsX_, index);
+    SwapRemove(boundsY_, index);
+    SwapRemove(boundsZ_, index);
+    SwapRemove(boundsRadius_, index);
+}
\ No newline at end of file
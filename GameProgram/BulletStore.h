@@ -0,0 +1,165 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include <Math/Broadphase.h>
+#include <Math/Quaternion.h>
+#include <Math/Vector3.h>
+#include <Math/Vector4.h>
+
+/// @brief 弾をまとめて持つ入れ物(SoA)
+/// @details 弾のように数が多く振る舞いが単純なものを、1つずつのオブジェクトではなく項目ごとの配列で持つ。
+/// 位置・速度・半径・残りの寿命・状態・向き・色などは別々の配列で、更新・衝突判定・描画への書き出しはそれぞれ必要な配列だけを
+/// 先頭から順に読む。
+///   Spawn      : 末尾に1つ追加する
+///   Steer      : kSteer状態の弾の向きを目標の位置へ補間し、速度をその向きにする(速さは変えない)
+///   Home       : kHoming状態の弾を、弾ごとの目標の位置へ真っすぐ向ける
+///   ReleaseTargets : 居なくなった目標を追っている弾をkStraightに戻す(目標の番号を使い回す前に呼ぶ)
+///   Update     : 全ての弾を進めて寿命を減らし、衝突判定用の移動の経路を囲む球を求める。寿命が尽きた弾には消える印を付ける
+///   FindHits   : 弾の移動の経路全体と、動いている球の集まりの移動の経路全体との衝突を調べる
+///   Kill       : 弾に消える印を付ける(衝突した時など)
+///   RemoveDead : 消える印の付いた弾を、末尾の弾を移して詰める(順番は変わる)
+/// 添字はRemoveDeadを呼ぶまで変わらない。消える印の付いた弾もRemoveDeadまでは配列に残るが、FindHitsでは当たらない。
+class BulletStore {
+public:
+    /// @brief 弾の動き方
+    enum class State : uint8_t {
+        kStraight,  // 速度のまま真っすぐ進む
+        kSteer,     // Steerで目標の方向へ曲がりながら進む
+        kHoming,    // Homeで弾ごとの目標へ向かう
+    };
+
+    /// @brief 目標が無いことを表す目標の番号
+    static constexpr uint32_t kNoTarget = UINT32_MAX;
+
+    BulletStore();
+
+    /// @brief 弾を追加する
+    /// @param position 位置
+    /// @param velocity 速度(向きは速度の方向になる)
+    /// @param radius 衝突判定の半径
+    /// @param lifeTime 消えるまでの時間(秒)
+    /// @param state 動き方
+    /// @param color 描画する色
+    /// @param targetId 追う目標の番号(kHomingの時だけ使う)
+    /// @return 追加した弾の添字
+    uint32_t Spawn(const KashipanEngine::Vector3 &position, const KashipanEngine::Vector3 &velocity,
+        float radius, float lifeTime, State state, const KashipanEngine::Vector4 &color, uint32_t targetId = kNoTarget);
+
+    /// @brief kSteer状態の弾を目標の方向へ曲げる
+    /// @param targetPosition 目標の位置
+    /// @param t 向きの補間の割合(0～1)
+    void Steer(const KashipanEngine::Vector3 &targetPosition, float t);
+
+    /// @brief kHoming状態の弾を、それぞれの目標の位置へ向ける
+    /// @param targetIndices 目標の番号ごとの、targetPositionsの添字
+    /// @param targetPositions 目標の位置
+    /// @param speed 目標へ向かう速さ
+    void Home(std::span<const uint32_t> targetIndices, std::span<const KashipanEngine::Vector3> targetPositions, float speed);
+
+    /// @brief 目標を追っている弾を真っすぐ進むように戻す(速度はそのまま)
+    /// @param targetIds 居なくなった目標の番号
+    /// @param color 戻した弾の色
+    void ReleaseTargets(std::span<const uint32_t> targetIds, const KashipanEngine::Vector4 &color);
+
+    /// @brief 弾を進める
+    /// @param deltaTime 経過時間(秒)
+    void Update(float deltaTime);
+
+    /// @brief 弾と球の集まりの衝突を調べる
+    /// @details 弾は直前のUpdateの移動全体で、球は前の位置から今の位置までの移動全体で判定する(同じ時間に動いたとみなす)
+    /// @param targets 相手の球(今の位置)
+    /// @param targetPreviousPositions 相手の前の位置(targetsと同じ数。止まっているものは今の位置と同じにする)
+    /// @param outHits 当たった組の出力先(indexAが弾、indexBが相手の添字。中身は置き換えられる)
+    void FindHits(const KashipanEngine::Math::SphereSoA &targets,
+        std::span<const KashipanEngine::Vector3> targetPreviousPositions, std::vector<KashipanEngine::Math::CollisionPair> &outHits);
+
+    /// @brief 弾に消える印を付ける
+    /// @param index 弾の添字
+    void Kill(uint32_t index) {
+        isAlive_[index] = false;
+    }
+
+    /// @brief 消える印の付いた弾を詰める
+    void RemoveDead();
+
+    /// @brief 全ての弾を消す
+    void Clear();
+
+    /// @brief 弾の数を取得(消える印が付いていてまだ詰めていないものも含む)
+    [[nodiscard]] uint32_t GetCount() const noexcept {
+        return static_cast<uint32_t>(positions_.size());
+    }
+    /// @brief 消える印が付いていないか
+    [[nodiscard]] bool IsAlive(uint32_t index) const noexcept {
+        return isAlive_[index] != 0;
+    }
+    /// @brief 位置の配列を取得
+    [[nodiscard]] std::span<const KashipanEngine::Vector3> GetPositions() const noexcept {
+        return positions_;
+    }
+    /// @brief 直前のUpdateで進める前の位置の配列を取得
+    [[nodiscard]] std::span<const KashipanEngine::Vector3> GetPreviousPositions() const noexcept {
+        return previousPositions_;
+    }
+    /// @brief 速度の配列を取得
+    [[nodiscard]] std::span<const KashipanEngine::Vector3> GetVelocities() const noexcept {
+        return velocities_;
+    }
+    /// @brief 向きの配列を取得(+Zが進む方向)
+    [[nodiscard]] std::span<const KashipanEngine::Quaternion> GetRotations() const noexcept {
+        return rotations_;
+    }
+    /// @brief 半径の配列を取得
+    [[nodiscard]] std::span<const float> GetRadii() const noexcept {
+        return radii_;
+    }
+    /// @brief 残りの寿命の配列を取得
+    [[nodiscard]] std::span<const float> GetLifeTimes() const noexcept {
+        return lifeTimes_;
+    }
+    /// @brief 動き方の配列を取得
+    [[nodiscard]] std::span<const State> GetStates() const noexcept {
+        return states_;
+    }
+    /// @brief 色の配列を取得
+    [[nodiscard]] std::span<const KashipanEngine::Vector4> GetColors() const noexcept {
+        return colors_;
+    }
+    /// @brief 追っている目標の番号の配列を取得(追っていなければkNoTarget)
+    [[nodiscard]] std::span<const uint32_t> GetTargetIds() const noexcept {
+        return targetIds_;
+    }
+
+private:
+    /// @brief 末尾の弾を移して詰める
+    void RemoveAt(uint32_t index);
+
+    // 今の位置と、直前のUpdateで進める前の位置
+    std::vector<KashipanEngine::Vector3> positions_;
+    std::vector<KashipanEngine::Vector3> previousPositions_;
+    std::vector<KashipanEngine::Vector3> velocities_;
+    std::vector<KashipanEngine::Quaternion> rotations_;
+    std::vector<float> radii_;
+    std::vector<float> lifeTimes_;
+    std::vector<State> states_;
+    std::vector<KashipanEngine::Vector4> colors_;
+    std::vector<uint32_t> targetIds_;
+    std::vector<uint8_t> isAlive_;
+    // 移動前と移動後の球の両方を囲む球(広域判定に渡す)
+    std::vector<float> boundsX_;
+    std::vector<float> boundsY_;
+    std::vector<float> boundsZ_;
+    std::vector<float> boundsRadius_;
+
+    // 相手の移動の経路を囲む球(FindHitsで求める。使い回す)
+    std::vector<float> targetBoundsX_;
+    std::vector<float> targetBoundsY_;
+    std::vector<float> targetBoundsZ_;
+    std::vector<float> targetBoundsRadius_;
+
+    // FindHitsの広域判定と、その候補(使い回す)
+    std::unique_ptr<KashipanEngine::Math::Broadphase> broadphase_;
+    std::vector<KashipanEngine::Math::CollisionPair> candidates_;
+};
\ No newline at end of file
@@ -1 +1,32 @@
 #include "Collider.h"
+#include "CollisionManager.h"
+
+Collider::~Collider() {
+    Unregister();
+}
+
+void Collider::SetCollisionAttribute(const std::bitset<8> &attribute) {
+    collisionAttribute_ = attribute;
+    if (collisionManager_) {
+        collisionManager_->OnColliderFilterChanged(this);
+    }
+}
+
+void Collider::SetCollisionMask(const std::bitset<8> &mask) {
+    collisionMask_ = mask;
+    if (collisionManager_) {
+        collisionManager_->OnColliderFilterChanged(this);
+    }
+}
+
+void Collider::ResetSweep() {
+    if (collisionManager_) {
+        collisionManager_->OnColliderSweepReset(this);
+    }
+}
+
+void Collider::Unregister() {
+    if (collisionManager_) {
+        collisionManager_->UnregisterCollider(this);
+    }
+}
\ No newline at end of file
@@ -1,9 +1,19 @@
 #pragma once
 #include <Math/Vector3.h>
 #include <bitset>
+#include <cstdint>
+
+class CollisionManager;
 
 class Collider {
 public:
+    Collider() = default;
+    // 登録先の情報を持つのでコピーしない
+    Collider(const Collider &) = delete;
+    Collider &operator=(const Collider &) = delete;
+    // 登録されていれば登録を解除する
+    virtual ~Collider();
+
     // 衝突時に呼ばれる関数
     virtual void OnCollision() = 0;
 
@@ -20,14 +30,16 @@ public:
         return radius_;
     }
 
-protected:
-    void SetCollisionAttribute(const std::bitset<8> &attribute) {
-        collisionAttribute_ = attribute;
-    }
+    // 衝突判定は前回の判定からの移動の経路全体で行うので、瞬間移動した時はこれを呼んで経路を切る
+    void ResetSweep();
 
-    void SetCollisionMask(const std::bitset<8> &mask) {
-        collisionMask_ = mask;
-    }
+    // 登録されていれば登録を解除する(破棄せずにプールに戻す時など)
+    void Unregister();
+
+protected:
+    // 登録済みなら登録先のグループも入れ替える
+    void SetCollisionAttribute(const std::bitset<8> &attribute);
+    void SetCollisionMask(const std::bitset<8> &mask);
 
     void SetRadius(float radius) {
         radius_ = radius;
@@ -40,5 +52,12 @@ private:
     std::bitset<8> collisionMask_ = 0b11111111;
 
     float radius_;
+
+    friend class CollisionManager;
+    // 登録先の衝突管理(未登録ならnullptr)
+    CollisionManager *collisionManager_ = nullptr;
+    // 登録先でのグループと、グループ内での添字
+    uint32_t collisionGroup_ = 0;
+    uint32_t collisionIndex_ = 0;
 };
 
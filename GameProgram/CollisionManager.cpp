@@ -1,39 +1,322 @@
+#include <algorithm>
+#include <cassert>
+#include <Math/Collider.h>
 #include <Math/MathObjects/Sphere.h>
+#include <Common/JobSystem.h>
 #include "CollisionManager.h"
 
 using namespace KashipanEngine;
 
-void CollisionManager::AddCollider(Collider *collider) {
-    colliders_.push_back(collider);
+namespace {
+
+// 1つのスレッドがまとめて判定する候補の数
+constexpr uint32_t kChunkSize = 1024;
+
+/// @brief count個から2つを選ぶ組の数
+uint64_t GetPairCount(uint64_t count) {
+    return count < 2 ? 0 : count * (count - 1) / 2;
+}
+
+/// @brief [0, count)を1つずつのジョブに分けて並列に実行する(ジョブシステムが無ければこのスレッドで実行する)
+template<class Function>
+void ParallelFor(JobSystem *jobSystem, uint32_t count, const Function &function) {
+    if (jobSystem) {
+        jobSystem->ParallelFor(0, count, 1, function);
+    } else {
+        function(0, count);
+    }
+}
+
+/// @brief 末尾の要素を移して詰める
+template<class T>
+void SwapRemove(std::vector<T> &values, uint32_t index) {
+    values[index] = values.back();
+    values.pop_back();
+}
+
+} // namespace
+
+CollisionManager::CollisionManager() :
+    broadphaseFactory_([]() { return std::make_unique<Math::SweepAndPruneBroadphase>(); }) {
+}
+
+CollisionManager::~CollisionManager() {
+    // 先に破棄されるので、登録されたままのオブジェクトから参照を外す
+    for (Group &group : groups_) {
+        for (Collider *collider : group.colliders) {
+            if (collider) {
+                collider->collisionManager_ = nullptr;
+            }
+        }
+    }
+}
+
+void CollisionManager::RegisterCollider(Collider *collider) {
+    assert(collider && collider->collisionManager_ == nullptr);
+    const uint32_t groupIndex = FindOrCreateGroup(collider->GetCollisionAttribute(), collider->GetCollisionMask());
+    Group &group = groups_[groupIndex];
+    collider->collisionManager_ = this;
+    collider->collisionGroup_ = groupIndex;
+    collider->collisionIndex_ = static_cast<uint32_t>(group.colliders.size());
+    group.colliders.push_back(collider);
+    // 位置はUpdateで取得し直す
+    group.previousPositions.emplace_back();
+    group.positions.emplace_back();
+    group.radii.push_back(0.0f);
+    group.hasPrevious.push_back(false);
+    group.boundsX.push_back(0.0f);
+    group.boundsY.push_back(0.0f);
+    group.boundsZ.push_back(0.0f);
+    group.boundsRadius.push_back(0.0f);
+}
+
+Vector3 CollisionManager::GetSweepStart(Collider *collider) const {
+    assert(collider && collider->collisionManager_ == this);
+    const Group &group = groups_[collider->collisionGroup_];
+    if (!group.hasPrevious[collider->collisionIndex_]) {
+        return collider->GetWorldPosition();
+    }
+    return group.previousPositions[collider->collisionIndex_];
 }
 
-void CollisionManager::ClearColliders() {
-    colliders_.clear();
+void CollisionManager::UnregisterCollider(Collider *collider) {
+    assert(collider && collider->collisionManager_ == this);
+    Group &group = groups_[collider->collisionGroup_];
+    const uint32_t index = collider->collisionIndex_;
+    collider->collisionManager_ = nullptr;
+    if (isUpdating_) {
+        // 判定中は添字を変えられないので、空けておいてUpdateの最後に詰める
+        group.colliders[index] = nullptr;
+        hasPendingRemoval_ = true;
+        return;
+    }
+
+    RemoveAt(group, index);
+}
+
+void CollisionManager::SetBroadphase(BroadphaseFactory factory) {
+    assert(factory);
+    broadphaseFactory_ = std::move(factory);
+    for (GroupPair &groupPair : groupPairs_) {
+        groupPair.broadphase = broadphaseFactory_();
+    }
 }
 
 void CollisionManager::Update() {
-    // リスト内のペアを総当たり
-    auto itrA = colliders_.begin();
-    for (; itrA != colliders_.end(); ++itrA) {
-        auto itrB = itrA;
-        ++itrB; // itrBはitrAの次の要素から開始
-        for (; itrB != colliders_.end(); ++itrB) {
-            if (((*itrA)->GetCollisionAttribute() & (*itrB)->GetCollisionMask()) == 0 ||
-                ((*itrB)->GetCollisionAttribute() & (*itrA)->GetCollisionMask()) == 0) {
-                continue; // 衝突しない場合はスキップ
+    // 検出(ゲーム側の処理を呼ばないので並列に行える)
+    UpdateBounds();
+    FindCandidates();
+    DetectContacts();
+
+    // 通知
+    DispatchContacts();
+    if (hasPendingRemoval_) {
+        RemovePendingColliders();
+    }
+}
+
+size_t CollisionManager::GetColliderCount() const {
+    size_t count = 0;
+    for (const Group &group : groups_) {
+        count += group.colliders.size();
+    }
+    return count;
+}
+
+void CollisionManager::OnColliderFilterChanged(Collider *collider) {
+    const Group &group = groups_[collider->collisionGroup_];
+    if (group.attribute == collider->GetCollisionAttribute() && group.mask == collider->GetCollisionMask()) {
+        return;
+    }
+    UnregisterCollider(collider);
+    RegisterCollider(collider);
+}
+
+uint32_t CollisionManager::FindOrCreateGroup(const std::bitset<8> &attribute, const std::bitset<8> &mask) {
+    for (size_t i = 0; i < groups_.size(); ++i) {
+        if (groups_[i].attribute == attribute && groups_[i].mask == mask) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+
+    // 新しいグループと、既存のグループ(自身を含む)のうち互いに衝突しうるものを組にする
+    const uint32_t newIndex = static_cast<uint32_t>(groups_.size());
+    Group &newGroup = groups_.emplace_back();
+    newGroup.attribute = attribute;
+    newGroup.mask = mask;
+    for (uint32_t i = 0; i <= newIndex; ++i) {
+        const Group &other = groups_[i];
+        if ((attribute & other.mask).none() || (other.attribute & mask).none()) {
+            continue;
+        }
+        groupPairs_.push_back(GroupPair{ i, newIndex, broadphaseFactory_() });
+    }
+    return newIndex;
+}
+
+void CollisionManager::OnColliderSweepReset(Collider *collider) {
+    groups_[collider->collisionGroup_].hasPrevious[collider->collisionIndex_] = false;
+}
+
+void CollisionManager::UpdateBounds() {
+    // 位置の取得は1フレームに1オブジェクト1回だけ
+    for (Group &group : groups_) {
+        for (size_t i = 0; i < group.colliders.size(); ++i) {
+            const Vector3 position = group.colliders[i]->GetWorldPosition();
+            const float radius = group.colliders[i]->GetRadius();
+            group.previousPositions[i] = group.hasPrevious[i] ? group.positions[i] : position;
+            group.positions[i] = position;
+            group.radii[i] = radius;
+            group.hasPrevious[i] = true;
+
+            // 移動前と移動後の球の両方を囲む球
+            const Vector3 center = (group.previousPositions[i] + position) * 0.5f;
+            group.boundsX[i] = center.x;
+            group.boundsY[i] = center.y;
+            group.boundsZ[i] = center.z;
+            group.boundsRadius[i] = radius + (position - group.previousPositions[i]).Length() * 0.5f;
+        }
+    }
+}
+
+void CollisionManager::FindCandidates() {
+    // 総当たりの組の数から、調べるグループの組の分を引いたものが飛ばせた組の数
+    uint64_t checkedPairCount = 0;
+    for (const GroupPair &groupPair : groupPairs_) {
+        const size_t countA = groups_[groupPair.groupA].colliders.size();
+        const size_t countB = groups_[groupPair.groupB].colliders.size();
+        checkedPairCount += groupPair.groupA == groupPair.groupB ? GetPairCount(countA) :
+            static_cast<uint64_t>(countA) * countB;
+    }
+    skippedPairCount_ = GetPairCount(GetColliderCount()) - checkedPairCount;
+
+    // 広域判定はグループの組ごとに別のインスタンスなので、組ごとに並列に行える
+    ParallelFor(jobSystem_, static_cast<uint32_t>(groupPairs_.size()), [this](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            GroupPair &groupPair = groupPairs_[i];
+            // グループ内の属性とマスクは全て同じなので、マスクは調べ直さなくて良い
+            const Math::SphereSoA spheresA = groups_[groupPair.groupA].GetBounds();
+            if (groupPair.groupA == groupPair.groupB) {
+                groupPair.broadphase->FindPairs(spheresA, groupPair.candidates);
+            } else {
+                groupPair.broadphase->FindPairs(spheresA, groups_[groupPair.groupB].GetBounds(), groupPair.candidates);
             }
-            CheckCollisionPair(*itrA, *itrB);
+        }
+        });
+
+    // 候補を一定の数ずつの範囲に分ける
+    candidatePairCount_ = 0;
+    chunks_.clear();
+    for (uint32_t i = 0; i < groupPairs_.size(); ++i) {
+        const uint32_t count = static_cast<uint32_t>(groupPairs_[i].candidates.size());
+        candidatePairCount_ += count;
+        for (uint32_t begin = 0; begin < count; begin += kChunkSize) {
+            chunks_.push_back(Chunk{ i, begin, std::min(begin + kChunkSize, count) });
         }
     }
 }
 
-void CollisionManager::CheckCollisionPair(Collider *colliderA, Collider *colliderB) {
-    // 判定用の球
-    Math::Sphere sphereA(colliderA->GetWorldPosition(), colliderA->GetRadius());
-    Math::Sphere sphereB(colliderB->GetWorldPosition(), colliderB->GetRadius());
+void CollisionManager::DetectContacts() {
+    if (chunkContacts_.size() < chunks_.size()) {
+        chunkContacts_.resize(chunks_.size());
+    }
+
+    // 範囲ごとに別の出力先に書くので、スレッド間で共有して書き換えるものは無い
+    const uint32_t chunkCount = static_cast<uint32_t>(chunks_.size());
+    ParallelFor(jobSystem_, chunkCount, [this](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const Chunk &chunk = chunks_[i];
+            const GroupPair &groupPair = groupPairs_[chunk.groupPair];
+            const Group &groupA = groups_[groupPair.groupA];
+            const Group &groupB = groups_[groupPair.groupB];
+            std::vector<Contact> &contacts = chunkContacts_[i];
+            contacts.clear();
+            for (uint32_t c = chunk.begin; c < chunk.end; ++c) {
+                const uint32_t indexA = groupPair.candidates[c].indexA;
+                const uint32_t indexB = groupPair.candidates[c].indexB;
+                // 前回の位置から今回の位置までの移動全体で判定する
+                const Math::Sphere sphereA(groupA.previousPositions[indexA], groupA.radii[indexA]);
+                const Math::Sphere sphereB(groupB.previousPositions[indexB], groupB.radii[indexB]);
+                const Vector3 velocityA = groupA.positions[indexA] - sphereA.center;
+                const Vector3 velocityB = groupB.positions[indexB] - sphereB.center;
+                float time;
+                if (!Math::Collider::IsCollision(sphereA, velocityA, sphereB, velocityB, time)) {
+                    continue;
+                }
+
+                Contact &contact = contacts.emplace_back();
+                contact.groupA = groupPair.groupA;
+                contact.indexA = indexA;
+                contact.groupB = groupPair.groupB;
+                contact.indexB = indexB;
+                contact.time = time;
+                // 今回の位置で重なっていればその位置で、すり抜けていれば接触した時点で法線を求める
+                Vector3 difference = groupB.positions[indexB] - groupA.positions[indexA];
+                float distance = difference.Length();
+                contact.depth = sphereA.radius + sphereB.radius - distance;
+                if (contact.depth < 0.0f) {
+                    difference = (sphereB.center + velocityB * time) - (sphereA.center + velocityA * time);
+                    distance = difference.Length();
+                    contact.depth = 0.0f;
+                }
+                contact.normal = distance > 0.0f ? difference / distance : Vector3(0.0f, 1.0f, 0.0f);
+            }
+        }
+        });
+
+    contacts_.clear();
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        contacts_.insert(contacts_.end(), chunkContacts_[i].begin(), chunkContacts_[i].end());
+    }
+
+    // 広域判定の方法によらず同じ順番にする
+    std::sort(contacts_.begin(), contacts_.end(), [](const Contact &a, const Contact &b) {
+        if (a.groupA != b.groupA) return a.groupA < b.groupA;
+        if (a.indexA != b.indexA) return a.indexA < b.indexA;
+        if (a.groupB != b.groupB) return a.groupB < b.groupB;
+        return a.indexB < b.indexB;
+        });
+}
+
+void CollisionManager::DispatchContacts() {
+    isUpdating_ = true;
+    for (const Contact &contact : contacts_) {
+        Collider *colliderA = groups_[contact.groupA].colliders[contact.indexA];
+        Collider *colliderB = groups_[contact.groupB].colliders[contact.indexB];
+        // 通知の途中で登録を解除されたものは飛ばす
+        if (colliderA && colliderB) {
+            colliderA->OnCollision();
+            colliderB->OnCollision();
+        }
+    }
+    isUpdating_ = false;
+}
+
+void CollisionManager::RemovePendingColliders() {
+    hasPendingRemoval_ = false;
+    for (Group &group : groups_) {
+        // 後ろから詰めるので、移してくる末尾の要素は常に登録済みのもの
+        for (size_t i = group.colliders.size(); i > 0; --i) {
+            if (!group.colliders[i - 1]) {
+                RemoveAt(group, static_cast<uint32_t>(i - 1));
+            }
+        }
+    }
+}
 
-    if (sphereA.IsCollision(sphereB)) {
-        colliderA->OnCollision();
-        colliderB->OnCollision();
+void CollisionManager::RemoveAt(Group &group, uint32_t index) {
+    // 末尾の要素を空いた場所に移す
+    const uint32_t lastIndex = static_cast<uint32_t>(group.colliders.size() - 1);
+    if (index != lastIndex) {
+        group.colliders[lastIndex]->collisionIndex_ = index;
     }
+    SwapRemove(group.colliders, index);
+    SwapRemove(group.previousPositions, index);
+    SwapRemove(group.positions, index);
+    SwapRemove(group.radii, index);
+    SwapRemove(group.hasPrevious, index);
+    SwapRemove(group.boundsX, index);
+    SwapRemove(group.boundsY, index);
+    SwapRemove(group.boundsZ, index);
+    SwapRemove(group.boundsRadius, index);
 }
\ No newline at end of file
@@ -1,15 +1,176 @@
 #pragma once
-#include <list>
+#include <bitset>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <Math/Broadphase.h>
 #include "Collider.h"
 
+namespace KashipanEngine {
+class JobSystem;
+} // namespace KashipanEngine
+
+/// @brief 衝突判定の管理
+/// @details 衝突判定オブジェクトは一度登録すれば、破棄されるかUnregisterColliderを呼ぶまで判定され続ける。
+/// 登録されたオブジェクトは衝突属性と衝突マスクの組み合わせごとのグループに分けて持ち、
+/// 互いに衝突しうるグループの組(自機陣営×敵陣営など)だけを広域判定にかける。同じ陣営同士のように
+/// マスクで弾かれる組は、個々の組を列挙せずにまとめて飛ばす。
+/// Updateは次の2段階に分かれている。
+///   検出: 登録されたオブジェクトの位置を1度ずつ取得し、広域判定で境界ボックスが重なる組に絞ってから球同士の判定を行い、
+///         接触情報をバッファに書き出す。ゲーム側の処理は呼ばないので、ジョブシステムで並列に行う。
+///         判定は前回のUpdateの位置から今回の位置までの移動全体で行う(連続衝突判定)ので、速い弾でもすり抜けない
+///         (広域判定にも移動の経路全体を囲む球を渡す)
+///   通知: 接触情報を(グループ, 添字)の順に並べ替えてから、1つのスレッドでOnCollisionを呼ぶ
+/// 並べ替えてから通知するので、スレッドの数や広域判定の方法によらず接触情報と通知の順番は同じになる。
 class CollisionManager {
 public:
-    void AddCollider(Collider *collider);
-    void ClearColliders();
+    /// @brief 衝突していた組の接触情報
+    struct Contact {
+        // 衝突した2つのオブジェクトのグループと、グループ内での添字
+        uint32_t groupA;
+        uint32_t indexA;
+        uint32_t groupB;
+        uint32_t indexB;
+        // AからBへ向かう単位ベクトル(中心が一致している場合は上向き)
+        KashipanEngine::Vector3 normal;
+        // 今回の位置でのめり込みの深さ(移動の途中だけで接触していた場合は0で、法線は接触した時点のもの)
+        float depth;
+        // 最初に接触した時刻(前回の位置から今回の位置までの移動に対する割合0～1)
+        float time;
+    };
+
+    /// @brief 広域判定を作る関数(グループの組ごとに1つずつ作る)
+    using BroadphaseFactory = std::function<std::unique_ptr<KashipanEngine::Math::Broadphase>()>;
+
+    CollisionManager();
+    ~CollisionManager();
+
+    /// @brief 衝突判定オブジェクトを登録する
+    /// @param collider 登録するオブジェクト(他のCollisionManagerに登録されていないこと)
+    void RegisterCollider(Collider *collider);
+    /// @brief 衝突判定オブジェクトの登録を解除する(Colliderの破棄時にも呼ばれる)
+    /// @param collider 解除するオブジェクト
+    void UnregisterCollider(Collider *collider);
+
+    /// @brief 広域判定の方法を設定する(既定はSweepAndPruneBroadphase)
+    /// @param factory 広域判定を作る関数
+    void SetBroadphase(BroadphaseFactory factory);
+
+    /// @brief 検出を並列に行うジョブシステムを設定する(nullptrならUpdateを呼んだスレッドだけで行う)
+    /// @param jobSystem ジョブシステム(このCollisionManagerより長く生きること)
+    void SetJobSystem(KashipanEngine::JobSystem *jobSystem) {
+        jobSystem_ = jobSystem;
+    }
+
+    /// @brief 登録されたオブジェクト同士の衝突判定を行い、衝突している組のOnCollisionを呼ぶ
     void Update();
 
+    /// @brief 直前のUpdateの接触情報を取得(グループ、添字の順に並んでいる)
+    const std::vector<Contact> &GetContacts() const {
+        return contacts_;
+    }
+    /// @brief 接触情報のグループと添字からオブジェクトを取得
+    /// @return 登録されているオブジェクト(OnCollisionの中などで登録を解除されていればnullptr)
+    Collider *GetCollider(uint32_t group, uint32_t index) const {
+        return groups_[group].colliders[index];
+    }
+
+    /// @brief 直前のUpdateで判定した移動の経路の始めの位置を取得
+    /// @details 直前のUpdateの後に登録されたかResetSweepを呼ばれたオブジェクトは、経路を持たないので今の位置を返す
+    /// @param collider 登録されているオブジェクト
+    KashipanEngine::Vector3 GetSweepStart(Collider *collider) const;
+
+    /// @brief 登録されているオブジェクトの数を取得
+    size_t GetColliderCount() const;
+    /// @brief 衝突属性と衝突マスクの組み合わせの数を取得
+    size_t GetGroupCount() const {
+        return groups_.size();
+    }
+    /// @brief 直前のUpdateで広域判定が出した候補の組の数を取得
+    size_t GetCandidatePairCount() const {
+        return candidatePairCount_;
+    }
+    /// @brief 直前のUpdateで衝突していた組の数を取得
+    size_t GetHitPairCount() const {
+        return contacts_.size();
+    }
+    /// @brief 直前のUpdateで、マスクで弾かれるグループの組だったため調べずに済んだ組の数を取得
+    uint64_t GetSkippedPairCount() const {
+        return skippedPairCount_;
+    }
+
 private:
-    void CheckCollisionPair(Collider *colliderA, Collider *colliderB);
+    friend class Collider;
+
+    /// @brief 衝突属性と衝突マスクが同じオブジェクトの集まり
+    struct Group {
+        std::bitset<8> attribute;
+        std::bitset<8> mask;
+        // 登録されたオブジェクト(Collider::collisionIndex_がこの配列の添字)
+        std::vector<Collider *> colliders;
+        // 前回と今回の位置、半径
+        std::vector<KashipanEngine::Vector3> previousPositions;
+        std::vector<KashipanEngine::Vector3> positions;
+        std::vector<float> radii;
+        // 前回の位置を持っているか(登録した直後とResetSweepの後は持っていない)
+        std::vector<uint8_t> hasPrevious;
+        // 前回から今回までの移動の経路全体を囲む球(SoA、広域判定に渡す)
+        std::vector<float> boundsX;
+        std::vector<float> boundsY;
+        std::vector<float> boundsZ;
+        std::vector<float> boundsRadius;
+
+        KashipanEngine::Math::SphereSoA GetBounds() const {
+            return KashipanEngine::Math::SphereSoA{ boundsX, boundsY, boundsZ, boundsRadius };
+        }
+    };
+    /// @brief 互いに衝突しうるグループの組
+    struct GroupPair {
+        uint32_t groupA;
+        uint32_t groupB;
+        std::unique_ptr<KashipanEngine::Math::Broadphase> broadphase;
+        // 広域判定が出した候補の組
+        std::vector<KashipanEngine::Math::CollisionPair> candidates;
+    };
+    /// @brief 1つのスレッドがまとめて判定する候補の範囲
+    struct Chunk {
+        uint32_t groupPair;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    /// @brief 衝突属性か衝突マスクが変わったオブジェクトを入れ直す(Colliderから呼ばれる)
+    void OnColliderFilterChanged(Collider *collider);
+    /// @brief 次のUpdateでは移動の経路を使わずに今の位置だけで判定する(Colliderから呼ばれる)
+    void OnColliderSweepReset(Collider *collider);
+    /// @brief 衝突属性と衝突マスクに合うグループを取得する(無ければ作る)
+    uint32_t FindOrCreateGroup(const std::bitset<8> &attribute, const std::bitset<8> &mask);
+    /// @brief 登録されたオブジェクトの位置と半径を取得し直し、移動の経路を囲む球を求める
+    void UpdateBounds();
+    /// @brief 候補の組を広域判定で列挙する(グループの組ごとに並列)
+    void FindCandidates();
+    /// @brief 候補の組を球同士で判定し、接触情報をcontacts_に書き出す(候補の範囲ごとに並列)
+    void DetectContacts();
+    /// @brief 接触情報の順にOnCollisionを呼ぶ
+    void DispatchContacts();
+    /// @brief Update中に解除されたオブジェクトを詰める
+    void RemovePendingColliders();
+    /// @brief 末尾の要素を移して詰める
+    void RemoveAt(Group &group, uint32_t index);
+
+    std::vector<Group> groups_;
+    std::vector<GroupPair> groupPairs_;
+    BroadphaseFactory broadphaseFactory_;
+
+    KashipanEngine::JobSystem *jobSystem_ = nullptr;
+    std::vector<Chunk> chunks_;
+    // 範囲ごとの接触情報(範囲の順につなげるとスレッドの数によらず同じになる)
+    std::vector<std::vector<Contact>> chunkContacts_;
+    std::vector<Contact> contacts_;
+    size_t candidatePairCount_ = 0;
+    uint64_t skippedPairCount_ = 0;
 
-    std::list<Collider *> colliders_;
+    // Update中(OnCollisionの中)に解除されたオブジェクトがあるか
+    bool isUpdating_ = false;
+    bool hasPendingRemoval_ = false;
 };
\ No newline at end of file
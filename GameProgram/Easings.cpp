@@ -1,6 +1,9 @@
 #include <math.h>
 #include "Easings.h"
+// MSVCのmath.hは_USE_MATH_DEFINES無しではM_PIを定義しない(定義済みの環境ではそれを使う)
+#ifndef M_PI
 #define M_PI (4.0f * atanf(1.0f))
+#endif
 
 const char *Ease::easeName_[EASINGS] = {
 		"EASE_NONE",
@@ -0,0 +1,145 @@
+#include <cassert>
+#include <limits>
+#include <Math/Collider.h>
+#include "Easings.h"
+#include "EnemyStore.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief 末尾の要素を移して詰める
+template<class T>
+void SwapRemove(std::vector<T> &values, uint32_t index) {
+    values[index] = values.back();
+    values.pop_back();
+}
+
+} // namespace
+
+uint32_t EnemyStore::Spawn(const Vector3 &startPosition, const Vector3 &endPosition,
+    int easeType, float easeTime, float fireTime, float radius, const Vector4 &color) {
+    // 消えた敵の番号があれば使い回す
+    uint32_t id;
+    if (freeIds_.empty()) {
+        id = static_cast<uint32_t>(indexById_.size());
+        indexById_.push_back(kNoIndex);
+    } else {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+    }
+    const uint32_t index = GetCount();
+    indexById_[id] = index;
+
+    positions_.push_back(startPosition);
+    previousPositions_.push_back(startPosition);
+    startPositions_.push_back(startPosition);
+    endPositions_.push_back(endPosition);
+    easeTypes_.push_back(easeType);
+    easeTimers_.push_back(0.0f);
+    easeTimes_.push_back(easeTime);
+    fireTimers_.push_back(fireTime);
+    radii_.push_back(radius);
+    colors_.push_back(color);
+    isAlive_.push_back(true);
+    ids_.push_back(id);
+    return id;
+}
+
+void EnemyStore::Update(float deltaTime, std::vector<uint32_t> &outFired) {
+    outFired.clear();
+    const uint32_t count = GetCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        // 経過時間の位置へ動かしてから時間を進める
+        const float timer = easeTimers_[i];
+        const Vector3 &start = startPositions_[i];
+        const Vector3 &end = endPositions_[i];
+        previousPositions_[i] = positions_[i];
+        positions_[i] = Vector3(
+            Ease::Auto(timer, easeTimes_[i], start.x, end.x, easeTypes_[i]),
+            Ease::Auto(timer, easeTimes_[i], start.y, end.y, easeTypes_[i]),
+            Ease::Auto(timer, easeTimes_[i], start.z, end.z, easeTypes_[i])
+        );
+        easeTimers_[i] = timer + deltaTime;
+
+        // 最後の位置まで動いたら消える
+        if (easeTimers_[i] >= easeTimes_[i]) {
+            isAlive_[i] = false;
+        }
+
+        // 弾は1発だけ撃つ
+        fireTimers_[i] -= deltaTime;
+        if (fireTimers_[i] <= 0.0f) {
+            fireTimers_[i] = std::numeric_limits<float>::infinity();
+            outFired.push_back(i);
+        }
+    }
+}
+
+void EnemyStore::FindHits(const Math::Sphere &sphere, const Vector3 &previousPosition, std::vector<uint32_t> &outHits) const {
+    outHits.clear();
+    const Math::Sphere start(previousPosition, sphere.radius);
+    const Vector3 movement = sphere.center - previousPosition;
+    const uint32_t count = GetCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!isAlive_[i]) {
+            continue;
+        }
+        const Math::Sphere enemy(previousPositions_[i], radii_[i]);
+        float time;
+        if (Math::Collider::IsCollision(start, movement, enemy, positions_[i] - previousPositions_[i], time)) {
+            outHits.push_back(i);
+        }
+    }
+}
+
+void EnemyStore::RemoveDead(std::vector<uint32_t> &outRemovedIds) {
+    outRemovedIds.clear();
+    // 後ろから詰めると、移してきた敵をもう一度調べずに済む
+    for (uint32_t i = GetCount(); i-- > 0;) {
+        if (!isAlive_[i]) {
+            outRemovedIds.push_back(ids_[i]);
+            RemoveAt(i);
+        }
+    }
+}
+
+void EnemyStore::Clear() {
+    positions_.clear();
+    previousPositions_.clear();
+    startPositions_.clear();
+    endPositions_.clear();
+    easeTypes_.clear();
+    easeTimers_.clear();
+    easeTimes_.clear();
+    fireTimers_.clear();
+    radii_.clear();
+    colors_.clear();
+    isAlive_.clear();
+    ids_.clear();
+    indexById_.clear();
+    freeIds_.clear();
+}
+
+void EnemyStore::RemoveAt(uint32_t index) {
+    assert(index < GetCount());
+    // 消える敵の番号を空け、末尾の敵の番号が移した先を指すようにする
+    const uint32_t id = ids_[index];
+    const uint32_t lastId = ids_.back();
+    indexById_[lastId] = index;
+    indexById_[id] = kNoIndex;
+    freeIds_.push_back(id);
+
+    SwapRemove(positions_, index);
+    SwapRemove(previousPositions_, index);
+    SwapRemove(startPositions_, index);
+    SwapRemove(endPositions_, index);
+    SwapRemove(easeTypes_, index);
+    SwapRemove(easeTimers_, index);
+    SwapRemove(easeTimes_, index);
+    SwapRemove(fireTimers_, index);
+    SwapRemove(radii_, index);
+    SwapRemove(colors_, index);
+    SwapRemove(isAlive_, index);
+    SwapRemove(ids_, index);
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <Math/MathObjects/Sphere.h>
+#include <Math/Vector3.h>
+#include <Math/Vector4.h>
+
+/// @brief 敵をまとめて持つ入れ物(SoA)
+/// @details BulletStoreと同じく、敵を1つずつのオブジェクトではなく項目ごとの配列で持つ。
+/// 敵は出現した位置から最後の位置までイージングで動き、イージングが終わると消える。出現してから決まった時間で1発だけ弾を撃つ。
+///   Spawn      : 末尾に1つ追加し、敵の番号を返す
+///   Update     : 全ての敵を動かし、弾を撃つ敵の添字を返す。イージングが終わった敵には消える印を付ける
+///   FindHits   : 動いている1つの球と、敵の移動の経路全体との衝突を調べる
+///   Kill       : 敵に消える印を付ける(衝突した時など)
+///   RemoveDead : 消える印の付いた敵を、末尾の敵を移して詰める(順番は変わる)。消えた敵の番号を返す
+/// 添字はRemoveDeadで変わるので、フレームをまたいで敵を指す時(ロックオンや追いかける弾)は番号を使い、FindIndexで添字を引く。
+/// 番号は消えた敵のものを使い回すので、RemoveDeadが返した番号を持っている側は、次のSpawnより前にその番号を手放すこと。
+class EnemyStore {
+public:
+    /// @brief 居ない敵を表す添字
+    static constexpr uint32_t kNoIndex = UINT32_MAX;
+
+    /// @brief 敵を追加する
+    /// @param startPosition 出現する位置
+    /// @param endPosition 最後の位置
+    /// @param easeType 使うイージング(EaseType)
+    /// @param easeTime 最後の位置まで動く時間(秒)
+    /// @param fireTime 出現してから弾を撃つまでの時間(秒)
+    /// @param radius 衝突判定の半径
+    /// @param color 描画する色
+    /// @return 追加した敵の番号
+    uint32_t Spawn(const KashipanEngine::Vector3 &startPosition, const KashipanEngine::Vector3 &endPosition,
+        int easeType, float easeTime, float fireTime, float radius, const KashipanEngine::Vector4 &color);
+
+    /// @brief 敵を動かす
+    /// @param deltaTime 経過時間(秒)
+    /// @param outFired 弾を撃つ敵の添字の出力先(中身は置き換えられる)
+    void Update(float deltaTime, std::vector<uint32_t> &outFired);
+
+    /// @brief 動いている球と敵の衝突を調べる
+    /// @details 球も敵も、前の位置から今の位置までの移動全体で判定する(同じ時間に動いたとみなす)
+    /// @param sphere 相手の球(今の位置)
+    /// @param previousPosition 相手の前の位置
+    /// @param outHits 当たった敵の添字の出力先(中身は置き換えられる)
+    void FindHits(const KashipanEngine::Math::Sphere &sphere, const KashipanEngine::Vector3 &previousPosition,
+        std::vector<uint32_t> &outHits) const;
+
+    /// @brief 敵に消える印を付ける
+    /// @param index 敵の添字
+    void Kill(uint32_t index) {
+        isAlive_[index] = false;
+    }
+
+    /// @brief 消える印の付いた敵を詰める
+    /// @param outRemovedIds 消えた敵の番号の出力先(中身は置き換えられる)
+    void RemoveDead(std::vector<uint32_t> &outRemovedIds);
+
+    /// @brief 全ての敵を消す(番号も全て使い回せるようになる)
+    void Clear();
+
+    /// @brief 敵の数を取得(消える印が付いていてまだ詰めていないものも含む)
+    [[nodiscard]] uint32_t GetCount() const noexcept {
+        return static_cast<uint32_t>(positions_.size());
+    }
+    /// @brief 消える印が付いていないか
+    [[nodiscard]] bool IsAlive(uint32_t index) const noexcept {
+        return isAlive_[index] != 0;
+    }
+    /// @brief 番号から添字を引く
+    /// @return 添字(居なければkNoIndex)
+    [[nodiscard]] uint32_t FindIndex(uint32_t id) const noexcept {
+        return id < indexById_.size() ? indexById_[id] : kNoIndex;
+    }
+    /// @brief 番号ごとの添字の配列を取得(居ない番号はkNoIndex)
+    [[nodiscard]] std::span<const uint32_t> GetIndicesById() const noexcept {
+        return indexById_;
+    }
+    /// @brief 番号の配列を取得
+    [[nodiscard]] std::span<const uint32_t> GetIds() const noexcept {
+        return ids_;
+    }
+    /// @brief 位置の配列を取得
+    [[nodiscard]] std::span<const KashipanEngine::Vector3> GetPositions() const noexcept {
+        return positions_;
+    }
+    /// @brief 直前のUpdateで動かす前の位置の配列を取得
+    [[nodiscard]] std::span<const KashipanEngine::Vector3> GetPreviousPositions() const noexcept {
+        return previousPositions_;
+    }
+    /// @brief 半径の配列を取得
+    [[nodiscard]] std::span<const float> GetRadii() const noexcept {
+        return radii_;
+    }
+    /// @brief 色の配列を取得
+    [[nodiscard]] std::span<const KashipanEngine::Vector4> GetColors() const noexcept {
+        return colors_;
+    }
+
+private:
+    /// @brief 末尾の敵を移して詰める
+    void RemoveAt(uint32_t index);
+
+    // 今の位置と、直前のUpdateで動かす前の位置
+    std::vector<KashipanEngine::Vector3> positions_;
+    std::vector<KashipanEngine::Vector3> previousPositions_;
+    // イージングの最初と最後の位置、種類、経過時間、かける時間
+    std::vector<KashipanEngine::Vector3> startPositions_;
+    std::vector<KashipanEngine::Vector3> endPositions_;
+    std::vector<int> easeTypes_;
+    std::vector<float> easeTimers_;
+    std::vector<float> easeTimes_;
+    // 弾を撃つまでの残りの時間(撃った後は無限大)
+    std::vector<float> fireTimers_;
+    std::vector<float> radii_;
+    std::vector<KashipanEngine::Vector4> colors_;
+    std::vector<uint8_t> isAlive_;
+    std::vector<uint32_t> ids_;
+
+    // 番号ごとの添字と、使い回せる番号
+    std::vector<uint32_t> indexById_;
+    std::vector<uint32_t> freeIds_;
+};
\ No newline at end of file
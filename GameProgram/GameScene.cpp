@@ -1,8 +1,11 @@
 ﻿#include "GameScene.h"
+#include <algorithm>
 #include <fstream>
+#include <numbers>
 #include <Base/Renderer.h>
 #include <Base/WinApp.h>
 #include <Base/Input.h>
+#include <Base/Texture.h>
 #include <2d/ImGuiManager.h>
 
 using namespace KashipanEngine;
@@ -14,6 +17,48 @@ Engine *sKashipanEngine = nullptr;
 Renderer *sRenderer = nullptr;
 // WinAppへのポインタ
 WinApp *sWinApp = nullptr;
+
+// 敵の弾の寿命(秒)と速さ
+const float kEnemyBulletLifeTime = 5.0f;
+const float kEnemyBulletSpeed = 32.0f;
+// 敵の弾の衝突判定の半径
+const float kEnemyBulletRadius = 0.5f;
+// 敵の弾が1フレームでプレイヤーの方向へ向きを補間する割合
+const float kEnemyBulletSteerRate = 0.1f;
+// 敵の弾のモデルの拡縮(進む方向に伸ばす)
+const Vector3 kEnemyBulletScale(1.0f, 1.0f, 3.0f);
+// 敵の弾の色
+const Vector4 kEnemyBulletColor(255.0f, 255.0f, 255.0f, 255.0f);
+
+// プレイヤーの弾の衝突判定の半径と、敵を追いかける速さ
+const float kPlayerBulletRadius = 0.5f;
+const float kPlayerBulletHomingSpeed = 16.0f;
+// プレイヤーの弾の色(真っすぐ進む弾と、敵を追いかける弾)
+const Vector4 kPlayerBulletColor(255.0f, 255.0f, 255.0f, 255.0f);
+const Vector4 kPlayerBulletHomingColor(255.0f, 0.0f, 0.0f, 255.0f);
+
+// 敵の衝突判定の半径と色
+const float kEnemyRadius = 1.0f;
+const Vector4 kEnemyColor(255.0f, 255.0f, 255.0f, 255.0f);
+// 出現してから弾を撃つまでの時間(秒)
+const float kEnemyFireTime = 2.0f;
+// 敵の向き(横向き)
+const Vector3 kEnemyRotate(0.0f, std::numbers::pi_v<float> / 2.0f, 0.0f);
+
+// 最初に作っておく敵・プレイヤーの弾・敵の弾の描画用のワールド変換の数
+// (ゲーム中に同時に出る数の最大より多くしておけば、ゲーム中にモデルやバッファを作らない)
+const size_t kEnemyTransformWarmUpCount = 32;
+const size_t kPlayerBulletTransformWarmUpCount = 64;
+const size_t kEnemyBulletTransformWarmUpCount = 256;
+
+Vector3 TransformNormal(const Vector3 &v, const Matrix4x4 &m) {
+    // ベクトルを変換するための行列を適用
+    Vector3 result;
+    result.x = v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0];
+    result.y = v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1];
+    result.z = v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2];
+    return result;
+}
 }
 
 GameScene::GameScene(Engine *engine) {
@@ -37,19 +82,33 @@ GameScene::GameScene(Engine *engine) {
     firstPersonCamera_->CalculateMatrix();
     // レンダラーにカメラを設定
     sRenderer->SetCamera(thirdPersonCamera_.get());
+    // 地面などの遮蔽物に隠れるオブジェクトは描画しない
+    sRenderer->SetOcclusionCulling(true);
 
     // カメラコントローラーのインスタンスを作成
     railCameraController_ = std::make_unique<RailCameraController>(thirdPersonCamera_.get(), sRenderer);
 
-    // 敵の弾初期化
-    enemyBulletModel_ = std::make_unique<Model>("Resources/Bullet", "bullet.obj");
-    enemyBulletModel_->SetRenderer(sRenderer);
-    EnemyBullet::Initialize(enemyBulletModel_.get());
+    // UI用の小さいテクスチャはアトラスにまとめて読み込む
+    Texture::LoadAtlas({
+        "Resources/reticle.png",
+        "Resources/target_reticle.png",
+    });
+
+    // 敵と弾の描画の初期化(描画用のワールド変換とモデルは破棄せずに使い回すので、先にまとめて作っておく)
+    enemyRenderer_ = std::make_unique<InstanceRenderer>(sRenderer, "Resources/Enemy", "enemy.obj", Vector3(1.0f));
+    enemyRenderer_->WarmUp(kEnemyTransformWarmUpCount, std::span(&kEnemyColor, 1));
+    playerBulletRenderer_ = std::make_unique<InstanceRenderer>(sRenderer, "Resources/Bullet", "bullet.obj", Vector3(1.0f));
+    const Vector4 playerBulletColors[] = { kPlayerBulletColor, kPlayerBulletHomingColor };
+    playerBulletRenderer_->WarmUp(kPlayerBulletTransformWarmUpCount, playerBulletColors);
+    enemyBulletRenderer_ = std::make_unique<InstanceRenderer>(sRenderer, "Resources/Bullet", "bullet.obj", kEnemyBulletScale);
+    enemyBulletRenderer_->WarmUp(kEnemyBulletTransformWarmUpCount, std::span(&kEnemyBulletColor, 1));
+    // 衝突判定管理クラスのインスタンスを作成(プレイヤーの移動の経路を求めるのに使う)
+    collisionManager_ = std::make_unique<CollisionManager>();
+    collisionManager_->SetJobSystem(sKashipanEngine->GetJobSystem());
     // プレイヤーのインスタンスを作成
     player_ = std::make_unique<Player>(sKashipanEngine, thirdPersonCamera_.get());
     player_->SetGameScene(this);
-    // 衝突判定管理クラスのインスタンスを作成
-    collisionManager_ = std::make_unique<CollisionManager>();
+    collisionManager_->RegisterCollider(player_.get());
     // スカイドームのインスタンスを作成
     skydome_ = std::make_unique<Skydome>(sKashipanEngine);
     // 地面のインスタンスを作成
@@ -106,43 +165,31 @@ void GameScene::Update() {
 
     } else {
         //reticle_->Update();
-        auto targetEnemies = lockOn_->GetTargetEnemies();
-        if (targetEnemies.empty()) {
+        const auto &targetEnemyIds = lockOn_->GetTargetEnemyIds();
+        if (targetEnemyIds.empty()) {
             playerBulletShootPos = Vector3(0.0f, 0.0f, 1.0f);
         }
     }
     
     player_->SetShootDirection(playerBulletShootPos);
-    player_->SetTargetEnemies(lockOn_->GetTargetEnemies());
+    player_->SetTargetEnemyIds(lockOn_->GetTargetEnemyIds());
     player_->Update();
-    EnemyBullet::SetTargetPosition(player_->GetWorldPosition());
-    for (auto &enemy : enemies_) {
-        enemy->SetPlayerPosition(player_->GetWorldPosition());
-        enemy->Update();
-    }
-    lockOn_->CheckTargetExist();
-    for (auto &playerBullet : playerBullets_) {
-        playerBullet->CheckTargetEnemyExist();
-    }
-    enemies_.remove_if([](const std::unique_ptr<Enemy> &enemy) {
-        return !enemy->IsAlive();
-        });
-
-    // 弾の更新
-    for (auto &bullet : playerBullets_) {
-        bullet->Update();
-    }
-    for (auto &bullet : enemyBullets_) {
-        bullet->Update();
-    }
+    // 敵を動かし、撃つ時間になった敵から弾を撃つ
+    enemies_.Update(Engine::GetDeltaTime(), firedEnemies_);
+    FireEnemyBullets();
+    lockOn_->CheckTargetExist(enemies_);
+    RemoveDeadEnemies();
+
+    // 弾の更新(プレイヤーの弾は追いかける敵の方へ向けてから進める)
+    playerBullets_.Home(enemies_.GetIndicesById(), enemies_.GetPositions(), kPlayerBulletHomingSpeed);
+    playerBullets_.Update(Engine::GetDeltaTime());
+    // 敵の弾はプレイヤーの方向へ曲げてから進める
+    enemyBullets_.Steer(player_->GetWorldPosition(), kEnemyBulletSteerRate);
+    enemyBullets_.Update(Engine::GetDeltaTime());
 
     // 弾の削除処理
-    playerBullets_.remove_if([](const std::unique_ptr<PlayerBullet> &bullet) {
-        return !bullet->IsAlive();
-        });
-    enemyBullets_.remove_if([](const std::unique_ptr<EnemyBullet> &bullet) {
-        return !bullet->IsAlive();
-        });
+    playerBullets_.RemoveDead();
+    enemyBullets_.RemoveDead();
 
     CheckAllCollisions();
     //railCameraController_->Update();
@@ -165,6 +212,26 @@ void GameScene::Draw() {
     ImGui::InputInt("Frame Rate", &frameRate, 1, 240);
     ImGui::Text("FPS: %d", Engine::GetFPS());
     ImGui::Text("Delta Time: %.3f ms", Engine::GetDeltaTime() * 1000.0f);
+    ImGui::Text("SRV Switches: %u (Skipped: %u)",
+        sRenderer->GetDescriptorSwitchCount(), sRenderer->GetSkippedDescriptorSwitchCount());
+    ImGui::Text("Sprite Draw Calls: %u", sRenderer->GetSpriteDrawCallCount());
+    ImGui::Text("Vertex Transfers: %u", Object::GetVertexTransferCount());
+    int textureBudgetMB = static_cast<int>(Texture::GetMemoryBudget() / (1024 * 1024));
+    if (ImGui::InputInt("Texture Budget (MB, 0 = unlimited)", &textureBudgetMB, 1, 16)) {
+        Texture::SetMemoryBudget(static_cast<uint64_t>(textureBudgetMB < 0 ? 0 : textureBudgetMB) * 1024 * 1024);
+    }
+    ImGui::Text("Texture Memory: %.2f MB",
+        static_cast<double>(Texture::GetResidentMemorySize()) / (1024.0 * 1024.0));
+    // grownが増え続けるならWarmUpの数が足りていない
+    ImGui::Text("Enemies: %u / %zu transforms, %zu models (grown %zu)",
+        enemies_.GetCount(), enemyRenderer_->GetTransformCount(),
+        enemyRenderer_->GetModelCount(), enemyRenderer_->GetGrownCount());
+    ImGui::Text("Player Bullets: %u / %zu transforms, %zu models (grown %zu)",
+        playerBullets_.GetCount(), playerBulletRenderer_->GetTransformCount(),
+        playerBulletRenderer_->GetModelCount(), playerBulletRenderer_->GetGrownCount());
+    ImGui::Text("Enemy Bullets: %u / %zu transforms, %zu models (grown %zu)",
+        enemyBullets_.GetCount(), enemyBulletRenderer_->GetTransformCount(),
+        enemyBulletRenderer_->GetModelCount(), enemyBulletRenderer_->GetGrownCount());
     ImGui::End();
 
     sKashipanEngine->SetFrameRate(frameRate);
@@ -182,36 +249,125 @@ void GameScene::Draw() {
     if (perspectiveType_ == PerspectiveType::ThirdPerson) {
         player_->Draw();
     }
-    for (auto &enemy : enemies_) {
-        enemy->Draw();
-    }
-    for (auto &bullet : playerBullets_) {
-        bullet->Draw();
-    }
-    for (auto &bullet : enemyBullets_) {
-        bullet->Draw();
-    }
+    enemyRenderer_->Draw(enemies_.GetPositions(), kEnemyRotate, enemies_.GetColors());
+    playerBulletRenderer_->Draw(playerBullets_.GetPositions(), playerBullets_.GetRotations(), playerBullets_.GetColors());
+    enemyBulletRenderer_->Draw(enemyBullets_.GetPositions(), enemyBullets_.GetRotations(), enemyBullets_.GetColors());
     //reticle_->Draw();
     lockOn_->Draw();
 
     sRenderer->PostDraw();
 }
 
+void GameScene::AddPlayerBullet(const KashipanEngine::Vector3 &position,
+    const KashipanEngine::Vector3 &velocity, float lifeTime, uint32_t targetEnemyId) {
+    if (targetEnemyId == BulletStore::kNoTarget) {
+        playerBullets_.Spawn(position, velocity, kPlayerBulletRadius, lifeTime,
+            BulletStore::State::kStraight, kPlayerBulletColor);
+    } else {
+        playerBullets_.Spawn(position, velocity, kPlayerBulletRadius, lifeTime,
+            BulletStore::State::kHoming, kPlayerBulletHomingColor, targetEnemyId);
+    }
+}
+
+void GameScene::AddEnemyBullet(const KashipanEngine::Vector3 &position, const KashipanEngine::Vector3 &direction) {
+    enemyBullets_.Spawn(position, direction.Normalize() * kEnemyBulletSpeed,
+        kEnemyBulletRadius, kEnemyBulletLifeTime, BulletStore::State::kSteer, kEnemyBulletColor);
+}
+
+void GameScene::FireEnemyBullets() {
+    // 敵から見たプレイヤーの方向を、以前の敵のワールド行列と同じく敵の向きで回してから撃つ
+    Matrix4x4 enemyRotateMatrix;
+    enemyRotateMatrix.MakeRotate(kEnemyRotate);
+    const Vector3 playerPosition = player_->GetWorldPosition();
+    const auto positions = enemies_.GetPositions();
+    for (uint32_t index : firedEnemies_) {
+        const Vector3 direction = (playerPosition - positions[index]).Normalize();
+        AddEnemyBullet(positions[index], TransformNormal(direction, enemyRotateMatrix));
+    }
+}
+
+void GameScene::RemoveDeadEnemies() {
+    // 消えた敵を追っていた弾は、番号が使い回される前に真っすぐ進むように戻す
+    enemies_.RemoveDead(removedEnemyIds_);
+    playerBullets_.ReleaseTargets(removedEnemyIds_, kPlayerBulletColor);
+}
+
 void GameScene::CheckAllCollisions() {
-    collisionManager_->ClearColliders();
+    // プレイヤーだけ登録してあるので、ここではプレイヤーの移動の経路を求める
+    collisionManager_->Update();
+    CheckEnemyCollisions();
+    CheckEnemyBulletCollisions();
+    RemoveDeadEnemies();
+    playerBullets_.RemoveDead();
+    enemyBullets_.RemoveDead();
+}
 
-    collisionManager_->AddCollider(player_.get());
-    for (auto &enemy : enemies_) {
-        collisionManager_->AddCollider(enemy.get());
+void GameScene::CheckEnemyCollisions() {
+    // プレイヤーの弾と敵(どちらも消える)
+    const auto positions = enemies_.GetPositions();
+    enemyX_.clear();
+    enemyY_.clear();
+    enemyZ_.clear();
+    for (const Vector3 &position : positions) {
+        enemyX_.push_back(position.x);
+        enemyY_.push_back(position.y);
+        enemyZ_.push_back(position.z);
     }
-    for (auto &bullet : playerBullets_) {
-        collisionManager_->AddCollider(bullet.get());
+    playerBullets_.FindHits(Math::SphereSoA{ enemyX_, enemyY_, enemyZ_, enemies_.GetRadii() },
+        enemies_.GetPreviousPositions(), playerBulletHits_);
+    for (const Math::CollisionPair &hit : playerBulletHits_) {
+        playerBullets_.Kill(hit.indexA);
+        enemies_.Kill(hit.indexB);
     }
-    for (auto &bullet : enemyBullets_) {
-        collisionManager_->AddCollider(bullet.get());
+
+    // プレイヤーと敵(敵だけ消える)
+    enemies_.FindHits(Math::Sphere(player_->GetWorldPosition(), player_->GetRadius()),
+        collisionManager_->GetSweepStart(player_.get()), playerHits_);
+    for (uint32_t index : playerHits_) {
+        enemies_.Kill(index);
+        player_->OnCollision();
     }
+    // 敵の弾の相手に消えたプレイヤーの弾を含めないよう、ここで詰めておく
+    playerBullets_.RemoveDead();
+}
 
-    collisionManager_->Update();
+void GameScene::CheckEnemyBulletCollisions() {
+    // 当たる相手(敵陣営以外)の位置と半径を集めてまとめて判定する。0番がプレイヤー、その後にプレイヤーの弾
+    enemyBulletTargetX_.clear();
+    enemyBulletTargetY_.clear();
+    enemyBulletTargetZ_.clear();
+    enemyBulletTargetRadius_.clear();
+    enemyBulletTargetPreviousPositions_.clear();
+    // 相手も移動の経路全体で判定する(弾とすれ違う時もすり抜けない)
+    auto addTarget = [this](const Vector3 &position, const Vector3 &previousPosition, float radius) {
+        enemyBulletTargetPreviousPositions_.push_back(previousPosition);
+        enemyBulletTargetX_.push_back(position.x);
+        enemyBulletTargetY_.push_back(position.y);
+        enemyBulletTargetZ_.push_back(position.z);
+        enemyBulletTargetRadius_.push_back(radius);
+        };
+    addTarget(player_->GetWorldPosition(), collisionManager_->GetSweepStart(player_.get()), player_->GetRadius());
+    const auto playerBulletPositions = playerBullets_.GetPositions();
+    const auto playerBulletPreviousPositions = playerBullets_.GetPreviousPositions();
+    const auto playerBulletRadii = playerBullets_.GetRadii();
+    for (uint32_t i = 0; i < playerBullets_.GetCount(); ++i) {
+        addTarget(playerBulletPositions[i], playerBulletPreviousPositions[i], playerBulletRadii[i]);
+    }
+
+    enemyBullets_.FindHits(Math::SphereSoA{ enemyBulletTargetX_, enemyBulletTargetY_, enemyBulletTargetZ_,
+        enemyBulletTargetRadius_ }, enemyBulletTargetPreviousPositions_, enemyBulletHits_);
+    // CollisionManagerと同じく、広域判定の方法によらず同じ順番で通知する
+    std::sort(enemyBulletHits_.begin(), enemyBulletHits_.end(), [](const Math::CollisionPair &a, const Math::CollisionPair &b) {
+        return a.indexA != b.indexA ? a.indexA < b.indexA : a.indexB < b.indexB;
+        });
+    for (const Math::CollisionPair &hit : enemyBulletHits_) {
+        enemyBullets_.Kill(hit.indexA);
+        if (hit.indexB == 0) {
+            player_->OnCollision();
+        } else {
+            playerBullets_.Kill(hit.indexB - 1);
+        }
+    }
 }
 
 void GameScene::LoadEnemyPopData() {
@@ -311,5 +467,5 @@ void GameScene::UpdateEnemyPopCommands() {
 }
 
 void GameScene::PopEnemy(const KashipanEngine::Vector3 &startPos, const KashipanEngine::Vector3 &endPos, int useEasingNum, float easeMaxTime) {
-    enemies_.push_back(std::make_unique<Enemy>(sKashipanEngine, this, startPos, endPos, useEasingNum, easeMaxTime));
+    enemies_.Spawn(startPos, endPos, useEasingNum, easeMaxTime, kEnemyFireTime, kEnemyRadius, kEnemyColor);
 }
\ No newline at end of file
@@ -1,8 +1,4 @@
-<<<<<<< HEAD
 ﻿#pragma once
-=======
-#pragma once
->>>>>>> chaptor3のマージ
 #include <sstream>
 #include <KashipanEngine.h>
 #include <Objects.h>
@@ -11,9 +7,9 @@
 #include <Common/GridLine.h>
 
 #include "Player.h"
-#include "PlayerBullet.h"
-#include "Enemy.h"
-#include "EnemyBullet.h"
+#include "BulletStore.h"
+#include "EnemyStore.h"
+#include "InstanceRenderer.h"
 #include "CollisionManager.h"
 #include "Skydome.h"
 #include "Ground.h"
@@ -31,14 +27,11 @@ public:
     // コンストラクタ
     GameScene(Engine *kashipanEngine);
     
-    // プレイヤーの弾の追加
-    void AddPlayerBullet(std::unique_ptr<PlayerBullet> &bullet) {
-        playerBullets_.push_back(std::move(bullet));
-    }
+    // プレイヤーの弾の追加(targetEnemyIdがBulletStore::kNoTargetでなければ、その番号の敵を追いかける)
+    void AddPlayerBullet(const KashipanEngine::Vector3 &position,
+        const KashipanEngine::Vector3 &velocity, float lifeTime, uint32_t targetEnemyId);
     // 敵の弾の追加
-    void AddEnemyBullet(std::unique_ptr<EnemyBullet> &bullet) {
-        enemyBullets_.push_back(std::move(bullet));
-    }
+    void AddEnemyBullet(const KashipanEngine::Vector3 &position, const KashipanEngine::Vector3 &direction);
 
 	// 更新
 	void Update();
@@ -46,7 +39,11 @@ public:
 	void Draw();
 
 private:
+    void FireEnemyBullets();
+    void RemoveDeadEnemies();
     void CheckAllCollisions();
+    void CheckEnemyCollisions();
+    void CheckEnemyBulletCollisions();
     void LoadEnemyPopData();
     void UpdateEnemyPopCommands();
     void PopEnemy(const KashipanEngine::Vector3 &startPos, const KashipanEngine::Vector3 &endPos,
@@ -54,9 +51,9 @@ private:
 
     // プレイヤー
     std::unique_ptr<Player> player_;
-    // 敵
-    std::list<std::unique_ptr<Enemy>> enemies_;
-    // 衝突管理
+    // 敵(数が多いので1つずつのオブジェクトにせず、まとめて配列で持つ)
+    EnemyStore enemies_;
+    // 衝突管理(プレイヤーの移動の経路を求める。敵と弾はそれぞれの入れ物でまとめて判定する)
     std::unique_ptr<CollisionManager> collisionManager_;
     // スカイドーム
     std::unique_ptr<Skydome> skydome_;
@@ -67,12 +64,30 @@ private:
     // ロックオン
     std::unique_ptr<LockOn> lockOn_;
 
-    // プレイヤーの弾
-    std::list<std::unique_ptr<PlayerBullet>> playerBullets_;
-    // 敵の弾
-    std::list<std::unique_ptr<EnemyBullet>> enemyBullets_;
-    // 敵の弾のモデル
-    std::unique_ptr<KashipanEngine::Model> enemyBulletModel_;
+    // プレイヤーの弾と敵の弾(敵と同じく、まとめて配列で持つ)
+    BulletStore playerBullets_;
+    BulletStore enemyBullets_;
+    // 敵・プレイヤーの弾・敵の弾の描画(添字ごとのワールド変換と色ごとのモデルを使い回す)
+    std::unique_ptr<InstanceRenderer> enemyRenderer_;
+    std::unique_ptr<InstanceRenderer> playerBulletRenderer_;
+    std::unique_ptr<InstanceRenderer> enemyBulletRenderer_;
+
+    // 弾を撃つ敵の添字と、消えた敵の番号(毎フレーム入れ直す。バッファは使い回す)
+    std::vector<uint32_t> firedEnemies_;
+    std::vector<uint32_t> removedEnemyIds_;
+    // プレイヤーの弾が当たる敵の位置と、当たった組・プレイヤーに当たった敵
+    std::vector<float> enemyX_;
+    std::vector<float> enemyY_;
+    std::vector<float> enemyZ_;
+    std::vector<KashipanEngine::Math::CollisionPair> playerBulletHits_;
+    std::vector<uint32_t> playerHits_;
+    // 敵の弾が当たる相手(0番がプレイヤー、その後にプレイヤーの弾)の位置・半径・前の位置
+    std::vector<float> enemyBulletTargetX_;
+    std::vector<float> enemyBulletTargetY_;
+    std::vector<float> enemyBulletTargetZ_;
+    std::vector<float> enemyBulletTargetRadius_;
+    std::vector<KashipanEngine::Vector3> enemyBulletTargetPreviousPositions_;
+    std::vector<KashipanEngine::Math::CollisionPair> enemyBulletHits_;
 
     // カメラコントローラー
     std::unique_ptr<RailCameraController> railCameraController_;
@@ -20,6 +20,8 @@ Ground::Ground(Engine *kashipanEngine) {
         auto modelState = modelData.GetStatePtr();
         modelState.material->enableLighting = false;
     }
+    // 地面より下にあるものは描画しない
+    model_->SetOccluder(true);
 }
 
 void Ground::Update() {
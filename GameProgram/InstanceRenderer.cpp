@@ -0,0 +1,74 @@
+#include <cassert>
+#include <Base/Renderer.h>
+#include "InstanceRenderer.h"
+
+using namespace KashipanEngine;
+
+InstanceRenderer::InstanceRenderer(Renderer *renderer, std::string directoryPath, std::string fileName,
+    const Vector3 &scale) :
+    renderer_(renderer),
+    directoryPath_(std::move(directoryPath)),
+    fileName_(std::move(fileName)),
+    scale_(scale) {
+    assert(renderer_ != nullptr);
+}
+
+void InstanceRenderer::WarmUp(size_t count, std::span<const Vector4> colors) {
+    for (size_t i = transforms_.size(); i < count; ++i) {
+        GetTransform(i);
+    }
+    for (const Vector4 &color : colors) {
+        GetModel(color);
+    }
+    isWarmedUp_ = true;
+}
+
+void InstanceRenderer::Draw(std::span<const Vector3> positions, std::span<const Quaternion> rotations,
+    std::span<const Vector4> colors) {
+    assert(rotations.size() == positions.size() && colors.size() == positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        WorldTransform &transform = GetTransform(i);
+        transform.translate_ = positions[i];
+        transform.rotateQuaternion_ = rotations[i];
+        transform.isUseQuaternion_ = true;
+        GetModel(colors[i]).Draw(transform);
+    }
+}
+
+void InstanceRenderer::Draw(std::span<const Vector3> positions, const Vector3 &rotate, std::span<const Vector4> colors) {
+    assert(colors.size() == positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        WorldTransform &transform = GetTransform(i);
+        transform.translate_ = positions[i];
+        transform.rotate_ = rotate;
+        transform.isUseQuaternion_ = false;
+        GetModel(colors[i]).Draw(transform);
+    }
+}
+
+WorldTransform &InstanceRenderer::GetTransform(size_t index) {
+    while (transforms_.size() <= index) {
+        auto &transform = transforms_.emplace_back(std::make_unique<WorldTransform>());
+        transform->scale_ = scale_;
+        grownCount_ += isWarmedUp_ ? 1 : 0;
+    }
+    return *transforms_[index];
+}
+
+Model &InstanceRenderer::GetModel(const Vector4 &color) {
+    for (size_t i = 0; i < modelColors_.size(); ++i) {
+        const Vector4 &modelColor = modelColors_[i];
+        if (modelColor.x == color.x && modelColor.y == color.y && modelColor.z == color.z && modelColor.w == color.w) {
+            return *models_[i];
+        }
+    }
+    // 初めての色はモデルを作り、マテリアルの色を設定しておく
+    auto &model = models_.emplace_back(std::make_unique<Model>(directoryPath_, fileName_));
+    model->SetRenderer(renderer_);
+    for (auto &modelData : model->GetModels()) {
+        modelData.GetStatePtr().material->color = color;
+    }
+    modelColors_.push_back(color);
+    grownCount_ += isWarmedUp_ ? 1 : 0;
+    return *model;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+#include <KashipanEngine.h>
+#include <Objects.h>
+#include <Objects/WorldTransform.h>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+/// @brief SoAの入れ物(EnemyStore・BulletStore)の中身を、同じモデルでまとめて描画する
+/// @details 定数バッファはワールド変換とモデル(マテリアル)ごとに1つなので、添字ごとのワールド変換と色ごとのモデルを持つ。
+/// どちらも足りない分だけ作り、数が減っても破棄せずに使い回す。WarmUpで先に作っておけば、ゲーム中にリソースを作らない。
+class InstanceRenderer {
+public:
+    /// @brief コンストラクタ
+    /// @param renderer 描画に使うレンダラー
+    /// @param directoryPath モデルのディレクトリ
+    /// @param fileName モデルのファイル名
+    /// @param scale モデルの拡縮
+    InstanceRenderer(KashipanEngine::Renderer *renderer, std::string directoryPath, std::string fileName,
+        const KashipanEngine::Vector3 &scale);
+
+    /// @brief ワールド変換の数がcountになるまでと、colorsの色のモデルを作っておく
+    void WarmUp(size_t count, std::span<const KashipanEngine::Vector4> colors);
+
+    /// @brief 位置・向き・色の配列の通りに描画する
+    void Draw(std::span<const KashipanEngine::Vector3> positions, std::span<const KashipanEngine::Quaternion> rotations,
+        std::span<const KashipanEngine::Vector4> colors);
+    /// @brief 位置・色の配列の通りに、全て同じ向き(オイラー角)で描画する
+    void Draw(std::span<const KashipanEngine::Vector3> positions, const KashipanEngine::Vector3 &rotate,
+        std::span<const KashipanEngine::Vector4> colors);
+
+    /// @brief 作ったワールド変換の数を取得(同時に描画した数の最大)
+    [[nodiscard]] size_t GetTransformCount() const noexcept {
+        return transforms_.size();
+    }
+    /// @brief 作ったモデルの数を取得(描画した色の数)
+    [[nodiscard]] size_t GetModelCount() const noexcept {
+        return models_.size();
+    }
+    /// @brief WarmUpの後に足りずに作ったワールド変換とモデルの数を取得(WarmUpの数が足りていれば0のまま)
+    [[nodiscard]] size_t GetGrownCount() const noexcept {
+        return grownCount_;
+    }
+
+private:
+    /// @brief 添字のワールド変換を取得する(無ければ作る)
+    KashipanEngine::WorldTransform &GetTransform(size_t index);
+    /// @brief 色のモデルを取得する(無ければ作る)
+    KashipanEngine::Model &GetModel(const KashipanEngine::Vector4 &color);
+
+    KashipanEngine::Renderer *renderer_;
+    std::string directoryPath_;
+    std::string fileName_;
+    KashipanEngine::Vector3 scale_;
+
+    // 添字ごとのワールド変換
+    std::vector<std::unique_ptr<KashipanEngine::WorldTransform>> transforms_;
+    // 色ごとのモデル(色の数は少ないので、順番に比べて探す)
+    std::vector<KashipanEngine::Vector4> modelColors_;
+    std::vector<std::unique_ptr<KashipanEngine::Model>> models_;
+    // WarmUpを呼んだか、呼んだ後に作った数
+    bool isWarmedUp_ = false;
+    size_t grownCount_ = 0;
+};
\ No newline at end of file
@@ -2,7 +2,6 @@
 #include <numbers>
 #include <algorithm>
 #include "LockOn.h"
-#include "Enemy.h"
 
 using namespace KashipanEngine;
 
@@ -11,45 +10,59 @@ LockOn::LockOn(Engine *kashipanEngine, KashipanEngine::Camera *camera) {
     camera_ = camera;
 
     reticles_.resize(maxLockOnCount_);
+    queryResults_.resize(maxLockOnCount_);
+    currentTargetEnemyIds_.reserve(maxLockOnCount_);
     for (auto &reticle : reticles_) {
         reticle = std::make_unique<Reticle2D>(kashipanEngine_, camera_, Vector3(0.0f),
             "Resources/target_reticle.png");
     }
 }
 
-void LockOn::CheckTargetExist() {
-    currentTargetEnemies_.remove_if([](Enemy *enemy) {
-        return enemy == nullptr || !enemy->IsAlive();
+void LockOn::CheckTargetExist(const EnemyStore &enemies) {
+    std::erase_if(currentTargetEnemyIds_, [&enemies](uint32_t id) {
+        const uint32_t index = enemies.FindIndex(id);
+        return index == EnemyStore::kNoIndex || !enemies.IsAlive(index);
         });
 }
 
-void LockOn::Update(std::list<std::unique_ptr<Enemy>> &enemies) {
-    currentTargetEnemies_.clear();
-    if (enemies.empty()) {
+void LockOn::Update(const EnemyStore &enemies) {
+    currentTargetEnemyIds_.clear();
+    if (enemies.GetCount() == 0) {
         return;
     }
 
-    std::vector<std::pair<Enemy*, float>> candidates;
-    for (auto &enemy : enemies) {
-        float distance = referencePoint_.Distance(enemy->GetWorldPosition());
-        if (distance <= lockOnRange_) {
-            candidates.emplace_back(enemy.get(), distance);
+    enemyIds_.clear();
+    enemyX_.clear();
+    enemyY_.clear();
+    enemyZ_.clear();
+    // 範囲の外の敵は探索に渡さない(平方根は取らずに距離の2乗で比べる)
+    const float rangeSquared = lockOnRange_ * lockOnRange_;
+    const auto positions = enemies.GetPositions();
+    for (uint32_t i = 0; i < enemies.GetCount(); ++i) {
+        const Vector3 &position = positions[i];
+        if (!enemies.IsAlive(i) || (position - referencePoint_).LengthSquared() > rangeSquared) {
+            continue;
         }
+        enemyIds_.push_back(enemies.GetIds()[i]);
+        enemyX_.push_back(position.x);
+        enemyY_.push_back(position.y);
+        enemyZ_.push_back(position.z);
     }
+    // 1フレームに1回しか探さないので、グリッドは作らずに範囲内の全ての敵を調べる
+    spatialQuery_.Build(enemyX_, enemyY_, enemyZ_, Math::SpatialQuery::kNoGrid);
 
-    std::sort(candidates.begin(), candidates.end(),
-        [](const std::pair<Enemy*, float> &a, const std::pair<Enemy*, float> &b) {
-            return a.second < b.second; // 距離が近い順にソート
-        });
-
-    for (int i = 0; i < std::min(static_cast<int>(candidates.size()), maxLockOnCount_); ++i) {
-        currentTargetEnemies_.push_back(candidates[i].first);
-        reticles_[i]->SetReticleTo3D(candidates[i].first->GetWorldPosition());
+    // 範囲の中で、カメラに映っている敵を近い順に選ぶ
+    const size_t count = spatialQuery_.FindNearestInFrustum(referencePoint_, lockOnRange_,
+        camera_->GetViewMatrix() * camera_->GetProjectionMatrix(), queryResults_);
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t candidate = queryResults_[i].index;
+        currentTargetEnemyIds_.push_back(enemyIds_[candidate]);
+        reticles_[i]->SetReticleTo3D(Vector3(enemyX_[candidate], enemyY_[candidate], enemyZ_[candidate]));
     }
 }
 
 void LockOn::Draw() {
-    for (size_t i = 0; i < currentTargetEnemies_.size(); ++i) {
+    for (size_t i = 0; i < currentTargetEnemyIds_.size(); ++i) {
         reticles_[i]->Draw();
     }
 }
\ No newline at end of file
@@ -1,11 +1,11 @@
 #pragma once
 #include <Math/Vector2.h>
+#include <Math/SpatialQuery.h>
 #include <memory>
-#include <list>
+#include <vector>
+#include "EnemyStore.h"
 #include "Reticle2D.h"
 
-class Enemy;
-
 class LockOn {
 public:
     LockOn(Engine *kashipanEngine, KashipanEngine::Camera *camera);
@@ -14,13 +14,15 @@ public:
         referencePoint_ = point;
     }
 
-    std::list<Enemy *> GetTargetEnemies() {
-        return currentTargetEnemies_;
+    /// @brief ロックオンしている敵の番号を取得
+    const std::vector<uint32_t> &GetTargetEnemyIds() const {
+        return currentTargetEnemyIds_;
     }
 
-    void CheckTargetExist();
+    /// @brief 消える印の付いた敵をロックオンから外す
+    void CheckTargetExist(const EnemyStore &enemies);
 
-    void Update(std::list<std::unique_ptr<Enemy>> &enemies);
+    void Update(const EnemyStore &enemies);
     void Draw();
 
 private:
@@ -33,7 +35,16 @@ private:
     KashipanEngine::Vector3 referencePoint_;
 
     std::vector<std::unique_ptr<Reticle2D>> reticles_;
-    std::list<Enemy *> currentTargetEnemies_;
+    // ロックオンしている敵の番号(maxLockOnCount_個分を確保しておき、毎フレーム入れ直す)
+    std::vector<uint32_t> currentTargetEnemyIds_;
+
+    // 敵の位置の近傍探索(毎フレーム位置を入れ直す。バッファは使い回す)
+    KashipanEngine::Math::SpatialQuery spatialQuery_;
+    std::vector<uint32_t> enemyIds_;
+    std::vector<float> enemyX_;
+    std::vector<float> enemyY_;
+    std::vector<float> enemyZ_;
+    std::vector<KashipanEngine::Math::SpatialQuery::Result> queryResults_;
 
     float lockOnRange_ = 50.0f;
     int maxLockOnCount_ = 3;
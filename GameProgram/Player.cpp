@@ -1,8 +1,4 @@
-<<<<<<< HEAD
 ﻿#include <Base/Renderer.h>
-=======
-#include <Base/Renderer.h>
->>>>>>> chaptor3のマージ
 #include <Base/Input.h>
 #include <Math/Camera.h>
 #include <numbers>
@@ -260,32 +256,22 @@ void Player::ShootBullet() {
     const Vector3 kBulletVelocity(shootDirection_ * 32.0f);
     const Vector3 kShootPos = GetWorldPosition();
 
-    if (targetEnemies_.empty()) {
-        std::unique_ptr<PlayerBullet> bullet = std::make_unique<PlayerBullet>(
-            sKashipanEngine,
+    if (!targetEnemyIds_ || targetEnemyIds_->empty()) {
+        gameScene_->AddPlayerBullet(
             kShootPos,
             TransformNormal(kBulletVelocity, worldTransform_->worldMatrix_),
             5.0f,
-            nullptr
-        );
-
-        gameScene_->AddPlayerBullet(
-            bullet
+            BulletStore::kNoTarget
         );
         return;
     }
 
-    for (auto &targetEnemy : targetEnemies_) {
-        std::unique_ptr<PlayerBullet> bullet = std::make_unique<PlayerBullet>(
-            sKashipanEngine,
+    for (uint32_t targetEnemyId : *targetEnemyIds_) {
+        gameScene_->AddPlayerBullet(
             kShootPos,
             TransformNormal(kBulletVelocity, worldTransform_->worldMatrix_),
             5.0f,
-            targetEnemy
-        );
-
-        gameScene_->AddPlayerBullet(
-            bullet
+            targetEnemyId
         );
     }
 }
@@ -1,19 +1,13 @@
-<<<<<<< HEAD
 ﻿#pragma once
-=======
-#pragma once
->>>>>>> chaptor3のマージ
 #include <KashipanEngine.h>
 #include <Objects.h>
 #include <Objects/WorldTransform.h>
-#include <list>
 #include <memory>
+#include <vector>
 
 #include "Collider.h"
-#include "PlayerBullet.h"
 
 class GameScene;
-class Enemy;
 
 class Player : public Collider {
 public:
@@ -41,8 +35,9 @@ public:
     void SetShootDirection(const KashipanEngine::Vector3 &shootDirection) {
         shootDirection_ = shootDirection;
     }
-    void SetTargetEnemies(const std::list<Enemy *> &targetEnemies) {
-        targetEnemies_ = targetEnemies;
+    /// @brief ロックオン中の敵の番号を設定する(リストはコピーせずに参照するので、Updateが終わるまで変更しないこと)
+    void SetTargetEnemyIds(const std::vector<uint32_t> &targetEnemyIds) {
+        targetEnemyIds_ = &targetEnemyIds;
     }
 
     KashipanEngine::Vector3 GetWorldPosition() override {
@@ -111,6 +106,6 @@ private:
 
     // 弾の発射方向
     KashipanEngine::Vector3 shootDirection_;
-    // ターゲット
-    std::list<Enemy *> targetEnemies_;
+    // ターゲットの敵の番号(LockOnが持つリストを参照する)
+    const std::vector<uint32_t> *targetEnemyIds_ = nullptr;
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <Math/Camera.h>
+#include <Math/CatmullRomSpline.h>
 #include <Objects/Lines.h>
 #include <Objects/WorldTransform.h>
 #include <memory>
@@ -12,22 +13,23 @@ public:
     void SetCamera(KashipanEngine::Camera *camera);
     void SetLoop(bool isLoop) {
         isLoop_ = isLoop;
+        spline_.SetLoop(isLoop);
     }
     
     void Update();
     void DebugDraw();
 
 private:
-    float GetTime() const;
     void CatmullRomLines(KashipanEngine::Renderer *renderer);
 
     std::vector<KashipanEngine::Vector3> points_;
+    KashipanEngine::CatmullRomSpline spline_;
     std::unique_ptr<KashipanEngine::Lines> lines_;
     std::unique_ptr<KashipanEngine::WorldTransform> worldTransform_;
-    KashipanEngine::Vector3 nextPos_;
     KashipanEngine::Camera *camera_;
 
-    float time_ = 0.0f;
+    // 始点からの移動距離
+    float distance_ = 0.0f;
     float moveSpeed = 32.0f;
     bool isLoop_ = true;
 };
@@ -1,6 +1,7 @@
 #include "Reticle2D.h"
 #include <Base/Texture.h>
 #include <Base/Input.h>
+#include <Math/TransformBatch.h>
 
 using namespace KashipanEngine;
 
@@ -66,8 +67,11 @@ void Reticle2D::MovePos() {
 
     // 逆投影
     Matrix4x4 invViewProj = (camera_->GetProjectionMatrix() * camera_->GetViewMatrix()).Inverse();
-    Vector3 worldNear = ndcNear.Transform(invViewProj);
-    Vector3 worldFar = ndcFar.Transform(invViewProj);
+    Vector3 ndcPoints[2] = { ndcNear, ndcFar };
+    Vector3 worldPoints[2];
+    Math::TransformPoints(ndcPoints, invViewProj, worldPoints);
+    const Vector3 &worldNear = worldPoints[0];
+    const Vector3 &worldFar = worldPoints[1];
 
     // レイ方向
     Vector3 rayDir = (worldFar - worldNear).Normalize();
@@ -9,6 +9,14 @@ public:
 
     void Update();
 
+    // 経過時間を0に戻して最初からやり直す(呼び出す関数はそのまま)
+    void Reset(float time, bool isLoop) {
+        callTime_ = time;
+        isLoop_ = isLoop;
+        elapsedTime_ = 0.0f;
+        isFinished_ = false;
+    }
+
     void Stop() {
         isFinished_ = true;
     }
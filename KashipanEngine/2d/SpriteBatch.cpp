@@ -0,0 +1,147 @@
+#include <cstring>
+
+#include "SpriteBatch.h"
+#include "Common/ConvertColor.h"
+#include "Common/Logs.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+/// @brief マテリアル1つ分のCBufferのサイズ(CBVは256バイト境界に揃える必要がある)
+constexpr UINT kMaterialStride = (sizeof(Material) + 255) & ~255u;
+
+} // namespace
+
+SpriteBatch::SpriteBatch() {
+    // 全てのスプライト分の頂点とインデックスをまとめたメッシュを作る
+    mesh_ = PrimitiveDrawer::CreateMesh<VertexData>(kMaxSpriteCount * 4, kMaxSpriteCount * 6);
+    // インデックスはスプライトの並びに関係なく同じなので先に書き込んでおく
+    for (UINT i = 0; i < kMaxSpriteCount; ++i) {
+        const uint32_t vertex = i * 4;
+        mesh_->indexBufferMap[i * 6 + 0] = vertex + 0;
+        mesh_->indexBufferMap[i * 6 + 1] = vertex + 1;
+        mesh_->indexBufferMap[i * 6 + 2] = vertex + 2;
+        mesh_->indexBufferMap[i * 6 + 3] = vertex + 1;
+        mesh_->indexBufferMap[i * 6 + 4] = vertex + 3;
+        mesh_->indexBufferMap[i * 6 + 5] = vertex + 2;
+    }
+
+    materialResource_ = PrimitiveDrawer::CreateBufferResources(static_cast<UINT64>(kMaterialStride) * kMaxRunCount);
+    materialResource_->Map(0, nullptr, reinterpret_cast<void **>(&materialMap_));
+    transformationMatrixResource_ = PrimitiveDrawer::CreateBufferResources(sizeof(TransformationMatrix));
+    transformationMatrixResource_->Map(0, nullptr, reinterpret_cast<void **>(&transformationMatrixMap_));
+
+    sprites_.reserve(kMaxSpriteCount);
+    keys_.reserve(kMaxSpriteCount);
+    order_.reserve(kMaxSpriteCount);
+    ranges_.reserve(kMaxSpriteCount);
+    runs_.reserve(kMaxRunCount);
+}
+
+void SpriteBatch::Clear() {
+    sprites_.clear();
+    keys_.clear();
+    breaks_.clear();
+    runs_.clear();
+}
+
+void SpriteBatch::Add(const SpriteState &spriteState) {
+    if (sprites_.size() >= kMaxSpriteCount) {
+        if (!isOverflowLogged_) {
+            Log("SpriteBatch is full. Extra sprites are not drawn.", kLogLevelFlagWarning);
+            isOverflowLogged_ = true;
+        }
+        return;
+    }
+    sprites_.push_back(spriteState);
+
+    SpriteSortKey key;
+    key.layer = spriteState.layer;
+    key.blendMode = static_cast<int>(spriteState.blendMode);
+    key.textureIndex = spriteState.textureIndex;
+    key.enableLighting = spriteState.enableLighting;
+    key.color = spriteState.color;
+    keys_.push_back(key);
+}
+
+void SpriteBatch::Break() {
+    const uint32_t position = static_cast<uint32_t>(sprites_.size());
+    if (position == 0 || (!breaks_.empty() && breaks_.back() == position)) {
+        return;
+    }
+    breaks_.push_back(position);
+}
+
+const std::vector<SpriteBatch::DrawRun> &SpriteBatch::Build(const Matrix4x4 &viewProjectionMatrix) {
+    runs_.clear();
+    if (sprites_.empty()) {
+        return runs_;
+    }
+
+    // 頂点はワールド変換済みで書き込むので、WVPはビュープロジェクションだけで良い
+    transformationMatrixMap_->wvp = viewProjectionMatrix;
+    transformationMatrixMap_->world = Matrix4x4::Identity();
+
+    // 並べ方に合わせて描く順番を決め、まとめて描く範囲ごとに描画を作る
+    SpriteOrder::Build(keys_, breaks_, sortMode_, order_, ranges_);
+    for (UINT i = 0; i < order_.size(); ++i) {
+        WriteVertices(sprites_[order_[i]], mesh_->vertexBufferMap + static_cast<size_t>(i) * 4);
+    }
+    for (const SpriteRange &range : ranges_) {
+        if (runs_.size() >= kMaxRunCount) {
+            if (!isOverflowLogged_) {
+                Log("SpriteBatch run count exceeded. Extra sprites are not drawn.", kLogLevelFlagWarning);
+                isOverflowLogged_ = true;
+            }
+            break;
+        }
+
+        const SpriteState &sprite = sprites_[order_[range.first]];
+        Material material;
+        material.color = ConvertColor(sprite.color);
+        material.enableLighting = sprite.enableLighting;
+        const size_t materialOffset = static_cast<size_t>(kMaterialStride) * runs_.size();
+        std::memcpy(materialMap_ + materialOffset, &material, sizeof(Material));
+
+        DrawRun run;
+        run.firstSprite = range.first;
+        run.spriteCount = range.count;
+        run.textureIndex = sprite.textureIndex;
+        run.blendMode = sprite.blendMode;
+        run.materialAddress = materialResource_->GetGPUVirtualAddress() + materialOffset;
+        runs_.push_back(run);
+    }
+
+    return runs_;
+}
+
+void SpriteBatch::WriteVertices(const SpriteState &spriteState, VertexData *vertices) {
+    const Matrix4x4 &world = spriteState.worldMatrix;
+    const Matrix4x4 &uv = spriteState.uvTransform;
+    const float width = spriteState.size.x;
+    const float height = spriteState.size.y;
+
+    // Spriteのメッシュと同じ並び(左下、左上、右下、右上)
+    const float localX[4] = { 0.0f, 0.0f, width, width };
+    const float localY[4] = { height, 0.0f, height, 0.0f };
+    const float texU[4] = { spriteState.uvMin.x, spriteState.uvMin.x, spriteState.uvMax.x, spriteState.uvMax.x };
+    const float texV[4] = { spriteState.uvMax.y, spriteState.uvMin.y, spriteState.uvMax.y, spriteState.uvMin.y };
+
+    // マテリアルを共有するため、ワールド変換とUV変換はここで済ませておく
+    for (int i = 0; i < 4; ++i) {
+        const float x = localX[i];
+        const float y = localY[i];
+        VertexData vertex;
+        vertex.position.x = x * world.m[0][0] + y * world.m[1][0] + world.m[3][0];
+        vertex.position.y = x * world.m[0][1] + y * world.m[1][1] + world.m[3][1];
+        vertex.position.z = x * world.m[0][2] + y * world.m[1][2] + world.m[3][2];
+        vertex.position.w = x * world.m[0][3] + y * world.m[1][3] + world.m[3][3];
+        vertex.texCoord.x = texU[i] * uv.m[0][0] + texV[i] * uv.m[1][0] + uv.m[3][0];
+        vertex.texCoord.y = texU[i] * uv.m[0][1] + texV[i] * uv.m[1][1] + uv.m[3][1];
+        vertex.normal = { 0.0f, 0.0f, -1.0f };
+        vertices[i] = vertex;
+    }
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,147 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <d3d12.h>
+#include <wrl.h>
+
+#include "3d/PrimitiveDrawer.h"
+#include "Common/Material.h"
+#include "Common/SpriteOrder.h"
+#include "Common/TransformationMatrix.h"
+#include "Math/Matrix4x4.h"
+#include "Math/Vector2.h"
+#include "Math/Vector4.h"
+
+namespace KashipanEngine {
+
+/// @brief スプライトをまとめて描画するためのバッチ
+/// @details 既定では追加した順番(レイヤーが違うものはレイヤーの順)に描き、続けて追加された同じ条件のスプライトだけを
+/// 1回の描画にまとめる。SetSortModeでkTextureにすると、レイヤーの中でテクスチャなどの順に並べ替えてまとめる。
+/// Breakで区切った前後では、並べ替えもまとめもしない(間に別の2Dオブジェクトを描くため)。
+class SpriteBatch {
+public:
+    /// @brief 1枚のスプライトの情報
+    struct SpriteState {
+        /// @brief ワールド行列
+        Matrix4x4 worldMatrix;
+        /// @brief UV変換行列
+        Matrix4x4 uvTransform;
+        /// @brief スプライトの大きさ
+        Vector2 size;
+        /// @brief UVの左上
+        Vector2 uvMin = { 0.0f, 0.0f };
+        /// @brief UVの右下
+        Vector2 uvMax = { 1.0f, 1.0f };
+        /// @brief 色(0～255)
+        Vector4 color = { 255.0f, 255.0f, 255.0f, 255.0f };
+        /// @brief テクスチャのインデックス
+        int textureIndex = -1;
+        /// @brief 描画順のレイヤー。小さいほど先に描画する
+        int layer = 0;
+        /// @brief ブレンドモード
+        BlendMode blendMode = kBlendModeNormal;
+        /// @brief Lightingの有効無効
+        bool enableLighting = false;
+    };
+
+    /// @brief 1回の描画でまとめて描くスプライトの範囲
+    struct DrawRun {
+        /// @brief 最初のスプライトの位置
+        UINT firstSprite = 0;
+        /// @brief スプライトの数
+        UINT spriteCount = 0;
+        /// @brief テクスチャのインデックス
+        int textureIndex = -1;
+        /// @brief ブレンドモード
+        BlendMode blendMode = kBlendModeNormal;
+        /// @brief マテリアル用CBufferのアドレス
+        D3D12_GPU_VIRTUAL_ADDRESS materialAddress = 0;
+    };
+
+    /// @brief 1フレームで描画できるスプライトの最大数
+    static constexpr UINT kMaxSpriteCount = 4096;
+    /// @brief 1フレームで発行できる描画の最大数
+    static constexpr UINT kMaxRunCount = 1024;
+
+    /// @brief コンストラクタ。バッファを確保する
+    SpriteBatch();
+
+    /// @brief 追加したスプライトを全て消す
+    void Clear();
+
+    /// @brief スプライトを追加する
+    /// @param spriteState スプライトの情報
+    void Add(const SpriteState &spriteState);
+
+    /// @brief ここまでに追加したスプライトと、この後に追加するスプライトを区切る
+    void Break();
+
+    /// @brief 並べ方の設定(既定はkSubmissionOrder)
+    /// @param sortMode 並べ方
+    void SetSortMode(SpriteSortMode sortMode) {
+        sortMode_ = sortMode;
+    }
+
+    /// @brief スプライトを並べ替えてバッファに書き込み、描画の範囲を作る
+    /// @param viewProjectionMatrix 2D描画用のビュープロジェクション行列
+    /// @return 描画の範囲
+    const std::vector<DrawRun> &Build(const Matrix4x4 &viewProjectionMatrix);
+
+    /// @brief メッシュの取得
+    /// @return メッシュ
+    Mesh<VertexData> *GetMesh() const {
+        return mesh_.get();
+    }
+
+    /// @brief TransformationMatrix用のCBufferのアドレスの取得
+    /// @return CBufferのアドレス
+    D3D12_GPU_VIRTUAL_ADDRESS GetTransformationMatrixAddress() const {
+        return transformationMatrixResource_->GetGPUVirtualAddress();
+    }
+
+    /// @brief 追加されたスプライトの数の取得
+    /// @return スプライトの数
+    UINT GetSpriteCount() const {
+        return static_cast<UINT>(sprites_.size());
+    }
+
+    /// @brief 前回のBuildで作った描画の数の取得
+    /// @return 描画の数
+    UINT GetRunCount() const {
+        return static_cast<UINT>(runs_.size());
+    }
+
+private:
+    /// @brief 頂点を書き込む
+    /// @param spriteState スプライトの情報
+    /// @param vertices 書き込み先の4頂点
+    static void WriteVertices(const SpriteState &spriteState, VertexData *vertices);
+
+    /// @brief 追加されたスプライトと、その並べ替え用の情報
+    std::vector<SpriteState> sprites_;
+    std::vector<SpriteSortKey> keys_;
+    /// @brief 区切りの位置
+    std::vector<uint32_t> breaks_;
+    /// @brief 並べ方
+    SpriteSortMode sortMode_ = SpriteSortMode::kSubmissionOrder;
+    /// @brief 描く順番と、まとめて描く範囲
+    std::vector<uint32_t> order_;
+    std::vector<SpriteRange> ranges_;
+    /// @brief 描画の範囲
+    std::vector<DrawRun> runs_;
+
+    /// @brief まとめて描画するためのメッシュ
+    std::unique_ptr<Mesh<VertexData>> mesh_;
+    /// @brief 描画ごとのマテリアル用のリソース
+    Microsoft::WRL::ComPtr<ID3D12Resource> materialResource_;
+    /// @brief マテリアル用のリソースのマップ
+    uint8_t *materialMap_ = nullptr;
+    /// @brief TransformationMatrix用のリソース
+    Microsoft::WRL::ComPtr<ID3D12Resource> transformationMatrixResource_;
+    /// @brief TransformationMatrix用のリソースのマップ
+    TransformationMatrix *transformationMatrixMap_ = nullptr;
+    /// @brief 最大数を超えたことをログに出したか
+    bool isOverflowLogged_ = false;
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
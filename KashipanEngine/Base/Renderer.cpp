@@ -10,6 +10,7 @@
 #include "Math/Camera.h"
 #include "Math/RenderingPipeline.h"
 #include "3d/DirectionalLight.h"
+#include "Objects/Object.h"
 
 #include "Common/Logs.h"
 #include "Common/ConvertColor.h"
@@ -111,6 +112,9 @@ Renderer::Renderer(WinApp *winApp, DirectXCommon *dxCommon, ImGuiManager *imguiM
     linePipelineSet_[kLineNormal] = PrimitiveDrawer::CreateLinePipeline(kLineNormal);
     linePipelineSet_[kLineThickness] = PrimitiveDrawer::CreateLinePipeline(kLineThickness);
 
+    // スプライトバッチの生成
+    spriteBatch_ = std::make_unique<SpriteBatch>();
+
     // 初期化完了のログを出力
     Log("Renderer Initialized.");
     LogNewLine();
@@ -128,6 +132,8 @@ Renderer::~Renderer() {
 }
 
 void Renderer::PreDraw() {
+    // 追い出されていたテクスチャの転送は、描画より先にコマンドリストに積む
+    Texture::BeginFrame();
     dxCommon_->PreDraw();
     dxCommon_->ClearDepthStencil();
     imguiManager_->BeginFrame();
@@ -140,6 +146,11 @@ void Renderer::PreDraw() {
     drawObjects_.clear();
     drawAlphaObjects_.clear();
     draw2DObjects_.clear();
+    draw2DSpriteCounts_.clear();
+    drawOccluders_.clear();
+    spriteBatch_->Clear();
+    // 頂点バッファへの転送回数をリセット
+    Object::ResetVertexTransferCount();
     // グリッドラインのクリア
     drawLines_.clear();
 
@@ -176,9 +187,12 @@ void Renderer::PreDraw() {
     // 形状を設定
     dxCommon_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
     // シグネチャを設定
-    dxCommon_->GetCommandList()->SetGraphicsRootSignature(pipelineSet_[kFillModeSolid][blendMode_].rootSignature.Get());
+    currentRootSignature_ = pipelineSet_[kFillModeSolid][blendMode_].rootSignature.Get();
+    dxCommon_->GetCommandList()->SetGraphicsRootSignature(currentRootSignature_);
     // パイプラインを設定
-    dxCommon_->GetCommandList()->SetPipelineState(pipelineSet_[kFillModeSolid][blendMode_].pipelineState.Get());
+    currentPipelineState_ = pipelineSet_[kFillModeSolid][blendMode_].pipelineState.Get();
+    dxCommon_->GetCommandList()->SetPipelineState(currentPipelineState_);
+    currentSrvHandle_ = {};
 
     // デバッグカメラが有効ならデバッグカメラの処理
     if (isUseDebugCamera_) {
@@ -192,14 +206,20 @@ void Renderer::PostDraw() {
         directionalLight_ = &sDefaultDirectionalLight;
     }
 
+    // SRVの切り替え回数をリセット
+    descriptorSwitchCount_ = 0;
+    skippedDescriptorSwitchCount_ = 0;
+
     // 平行光源の設定
     SetLightBuffer(directionalLight_);
+    // 遮蔽物に隠れるオブジェクトを取り除く
+    CullOccludedObjects();
     // 通常のオブジェクトの描画
     DrawCommon(drawObjects_);
     // 半透明オブジェクトの描画
     DrawCommon(drawAlphaObjects_);
-    // 2Dオブジェクトの描画
-    DrawCommon(draw2DObjects_);
+    // 2Dオブジェクトとスプライトの描画
+    Draw2D();
     // 線の描画
     for (auto &line : drawLines_) {
         DrawLine(&line);
@@ -207,6 +227,8 @@ void Renderer::PostDraw() {
 
     imguiManager_->EndFrame();
     dxCommon_->PostDraw();
+    // GPUの完了を待った後なので、使われていないテクスチャを追い出せる
+    Texture::EndFrame();
 }
 
 void Renderer::ToggleDebugCamera() {
@@ -226,7 +248,10 @@ void Renderer::DrawSetLine(LineState &lineState) {
 void Renderer::DrawSet(const ObjectState &objectState, bool isUseCamera, bool isSemitransparent) {
     // カメラが設定されていないものは2Dオブジェクトとして扱う
     if (isUseCamera == false) {
+        // 前後に設定されたスプライトと描く順番が入れ替わらないよう、スプライトのバッチを区切る
         draw2DObjects_.push_back(objectState);
+        draw2DSpriteCounts_.push_back(spriteBatch_->GetSpriteCount());
+        spriteBatch_->Break();
     } else {
         // カメラが設定されているものは3Dオブジェクトとして扱う
         if (isSemitransparent) {
@@ -239,6 +264,44 @@ void Renderer::DrawSet(const ObjectState &objectState, bool isUseCamera, bool is
     }
 }
 
+void Renderer::DrawSetOccluder(const OccluderState &occluderState) {
+    drawOccluders_.push_back(occluderState);
+}
+
+void Renderer::CullOccludedObjects() {
+    occlusionCulledCount_ = 0;
+    Camera *camera = isUseDebugCamera_ ? sDebugCamera.get() : sCameraPtr;
+    if (!isOcclusionCulling_ || drawOccluders_.empty() || camera == nullptr) {
+        return;
+    }
+
+    // 描画に使うのと同じビュープロジェクション行列で遮蔽物を描く
+    camera->SetWorldMatrix(Matrix4x4::Identity());
+    camera->CalculateMatrix();
+    occlusionCuller_.BeginFrame(camera->GetViewMatrix() * camera->GetProjectionMatrix());
+    for (const auto &occluder : drawOccluders_) {
+        occlusionCuller_.RenderOccluder(occluder.positions, occluder.indices, *occluder.worldMatrix);
+    }
+    occlusionCuller_.EndOccluders();
+
+    // 境界ボックスが隠れているオブジェクトを取り除く(遮蔽物自身は手前の面が同じ深度なので残る)
+    const auto isOccluded = [this](const ObjectState &objectState) {
+        return objectState.hasLocalBounds &&
+            !occlusionCuller_.IsVisible(objectState.localBoundsMin, objectState.localBoundsMax, *objectState.worldMatrix);
+    };
+    const size_t objectCount = drawObjects_.size() + drawAlphaObjects_.size();
+    std::erase_if(drawObjects_, isOccluded);
+    std::erase_if(drawAlphaObjects_, isOccluded);
+    occlusionCulledCount_ = static_cast<uint32_t>(objectCount - drawObjects_.size() - drawAlphaObjects_.size());
+}
+
+void Renderer::DrawSetSprite(const SpriteBatch::SpriteState &spriteState) {
+    // 現在のブレンドモードで描画するスプライトとして追加
+    SpriteBatch::SpriteState state = spriteState;
+    state.blendMode = blendMode_;
+    spriteBatch_->Add(state);
+}
+
 void Renderer::SetLightBuffer(DirectionalLight *light) {
     // 光源のリソースを生成
     static auto directionalLightResource = PrimitiveDrawer::CreateBufferResources(sizeof(DirectionalLight));
@@ -267,9 +330,17 @@ void Renderer::DrawCommon(std::vector<ObjectState> &objects) {
 
 void Renderer::DrawCommon(ObjectState *objectState) {
     dxCommon_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    // ルートシグネチャを設定
-    dxCommon_->GetCommandList()->SetGraphicsRootSignature(pipelineSet_[objectState->fillMode][blendMode_].rootSignature.Get());
-    dxCommon_->GetCommandList()->SetPipelineState(pipelineSet_[objectState->fillMode][blendMode_].pipelineState.Get());
+    // ルートシグネチャを設定。変わったときはルート引数が無効になるのでSRVも設定し直す
+    const PipeLineSet &pipelineSet = pipelineSet_[objectState->fillMode][blendMode_];
+    if (currentRootSignature_ != pipelineSet.rootSignature.Get()) {
+        currentRootSignature_ = pipelineSet.rootSignature.Get();
+        dxCommon_->GetCommandList()->SetGraphicsRootSignature(currentRootSignature_);
+        currentSrvHandle_ = {};
+    }
+    if (currentPipelineState_ != pipelineSet.pipelineState.Get()) {
+        currentPipelineState_ = pipelineSet.pipelineState.Get();
+        dxCommon_->GetCommandList()->SetPipelineState(currentPipelineState_);
+    }
 
     // Cameraがnullptrの場合は2D描画
     if (objectState->isUseCamera == false) {
@@ -288,11 +359,20 @@ void Renderer::DrawCommon(ObjectState *objectState) {
     }
 
     // SRVのDescriptorTableの先頭を設定。2はrootParameter[2]である。
+    // アトラスを共有しているテクスチャが続く場合は設定を省略する
+    D3D12_GPU_DESCRIPTOR_HANDLE srvHandle;
     if ((objectState->fillMode == kFillModeWireframe) ||
         objectState->useTextureIndex <= 0) {
-        dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(2, Texture::GetTexture(0).srvHandleGPU);
+        srvHandle = Texture::Use(0).srvHandleGPU;
+    } else {
+        srvHandle = Texture::Use(objectState->useTextureIndex).srvHandleGPU;
+    }
+    if (currentSrvHandle_.ptr != srvHandle.ptr) {
+        currentSrvHandle_ = srvHandle;
+        dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(2, srvHandle);
+        ++descriptorSwitchCount_;
     } else {
-        dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(2, Texture::GetTexture(objectState->useTextureIndex).srvHandleGPU);
+        ++skippedDescriptorSwitchCount_;
     }
 
     // VBVを設定
@@ -312,10 +392,66 @@ void Renderer::DrawCommon(ObjectState *objectState) {
     }
 }
 
+void Renderer::Draw2D() {
+    // スプライトは並べ替えて頂点を書き込み、同じ条件が続く範囲ごとに1回で描画する。
+    // 2Dオブジェクトの位置でバッチを区切ってあるので、範囲が2Dオブジェクトをまたぐことはない
+    const auto &runs = spriteBatch_->Build(viewMatrix2D_ * projectionMatrix2D_);
+    spriteDrawCallCount_ = static_cast<uint32_t>(runs.size());
+    size_t runIndex = 0;
+    for (size_t i = 0; i < draw2DObjects_.size(); ++i) {
+        DrawSpriteRuns(runs, runIndex, draw2DSpriteCounts_[i]);
+        DrawCommon(&draw2DObjects_[i]);
+    }
+    DrawSpriteRuns(runs, runIndex, spriteBatch_->GetSpriteCount());
+}
+
+void Renderer::DrawSpriteRuns(const std::vector<SpriteBatch::DrawRun> &runs, size_t &runIndex, UINT endSprite) {
+    if (runIndex >= runs.size() || runs[runIndex].firstSprite >= endSprite) {
+        return;
+    }
+
+    auto commandList = dxCommon_->GetCommandList();
+    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    commandList->IASetVertexBuffers(0, 1, &spriteBatch_->GetMesh()->vertexBufferView);
+    commandList->IASetIndexBuffer(&spriteBatch_->GetMesh()->indexBufferView);
+
+    for (; runIndex < runs.size() && runs[runIndex].firstSprite < endSprite; ++runIndex) {
+        const SpriteBatch::DrawRun &run = runs[runIndex];
+        const PipeLineSet &pipelineSet = pipelineSet_[kFillModeSolid][run.blendMode];
+        if (currentRootSignature_ != pipelineSet.rootSignature.Get()) {
+            currentRootSignature_ = pipelineSet.rootSignature.Get();
+            commandList->SetGraphicsRootSignature(currentRootSignature_);
+            currentSrvHandle_ = {};
+        }
+        if (currentPipelineState_ != pipelineSet.pipelineState.Get()) {
+            currentPipelineState_ = pipelineSet.pipelineState.Get();
+            commandList->SetPipelineState(currentPipelineState_);
+        }
+
+        // SRVのDescriptorTableの先頭を設定
+        const D3D12_GPU_DESCRIPTOR_HANDLE srvHandle =
+            Texture::Use(run.textureIndex <= 0 ? 0 : run.textureIndex).srvHandleGPU;
+        if (currentSrvHandle_.ptr != srvHandle.ptr) {
+            currentSrvHandle_ = srvHandle;
+            commandList->SetGraphicsRootDescriptorTable(2, srvHandle);
+            ++descriptorSwitchCount_;
+        } else {
+            ++skippedDescriptorSwitchCount_;
+        }
+
+        commandList->SetGraphicsRootConstantBufferView(0, run.materialAddress);
+        commandList->SetGraphicsRootConstantBufferView(1, spriteBatch_->GetTransformationMatrixAddress());
+        commandList->DrawIndexedInstanced(run.spriteCount * 6, 1, run.firstSprite * 6, 0, 0);
+    }
+}
+
 void Renderer::DrawLine(LineState *lineState) {
     dxCommon_->GetCommandList()->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_LINELIST);
-    dxCommon_->GetCommandList()->SetGraphicsRootSignature(linePipelineSet_[lineState->lineType].rootSignature.Get());
-    dxCommon_->GetCommandList()->SetPipelineState(linePipelineSet_[lineState->lineType].pipelineState.Get());
+    currentRootSignature_ = linePipelineSet_[lineState->lineType].rootSignature.Get();
+    currentPipelineState_ = linePipelineSet_[lineState->lineType].pipelineState.Get();
+    currentSrvHandle_ = {};
+    dxCommon_->GetCommandList()->SetGraphicsRootSignature(currentRootSignature_);
+    dxCommon_->GetCommandList()->SetPipelineState(currentPipelineState_);
 
     // Cameraがnullptrの場合は2D描画
     if (lineState->isUseCamera == false) {
@@ -2,13 +2,16 @@
 #include <array>
 #include <vector>
 #include <memory>
+#include <span>
 
 #include "Common/PipeLineSet.h"
 #include "Common/TransformationMatrix.h"
 #include "Common/VertexDataLine.h"
 #include "Common/LineOption.h"
 #include "3d/PrimitiveDrawer.h"
+#include "2d/SpriteBatch.h"
 #include "Math/Matrix4x4.h"
+#include "Math/OcclusionCuller.h"
 
 namespace KashipanEngine {
 
@@ -51,6 +54,22 @@ public:
         FillMode fillMode = kFillModeSolid;
         /// @brief カメラを使用するかどうか
         bool isUseCamera = false;
+        /// @brief ローカル座標の境界ボックスがあるかどうか(あればオクルージョンカリングの対象になる)
+        bool hasLocalBounds = false;
+        /// @brief ローカル座標の境界ボックスの最小点
+        Vector3 localBoundsMin;
+        /// @brief ローカル座標の境界ボックスの最大点
+        Vector3 localBoundsMax;
+    };
+
+    /// @brief 遮蔽物の情報
+    struct OccluderState {
+        /// @brief 頂点の位置(ローカル座標)
+        std::span<const Vector3> positions;
+        /// @brief インデックス(3つで1つの三角形)
+        std::span<const uint32_t> indices;
+        /// @brief ワールド行列
+        const Matrix4x4 *worldMatrix = nullptr;
     };
 
     /// @brief ライン情報
@@ -105,6 +124,18 @@ public:
     /// @param camera カメラへのポインタ
     void SetCamera(Camera *camera);
 
+    /// @brief 前のフレームでSRVのディスクリプタテーブルを設定した回数の取得
+    /// @return 設定した回数
+    uint32_t GetDescriptorSwitchCount() const {
+        return descriptorSwitchCount_;
+    }
+
+    /// @brief 前のフレームで同じSRVが続いたため設定を省略した回数の取得
+    /// @return 省略した回数
+    uint32_t GetSkippedDescriptorSwitchCount() const {
+        return skippedDescriptorSwitchCount_;
+    }
+
     /// @brief ブレンドモードの設定
     /// @param blendMode ブレンドモード
     void SetBlendMode(BlendMode blendMode) {
@@ -127,11 +158,47 @@ public:
     /// @param isSemitransparent 半透明オブジェクトかどうか
     void DrawSet(const ObjectState &objectState, bool isUseCamera, bool isSemitransparent);
 
+    /// @brief 遮蔽物の設定。描画の前に遮蔽物を低解像度の深度バッファに描き、その裏に隠れるオブジェクトを描画しない
+    /// @param occluderState 遮蔽物の情報(頂点とワールド行列はPostDrawまで有効であること)
+    void DrawSetOccluder(const OccluderState &occluderState);
+
+    /// @brief オクルージョンカリングの有効・無効の設定
+    /// @param isEnabled 有効にするならtrue
+    void SetOcclusionCulling(bool isEnabled) {
+        isOcclusionCulling_ = isEnabled;
+    }
+
+    /// @brief 前のフレームで遮蔽物に隠れて描画しなかったオブジェクトの数の取得
+    /// @return 描画しなかったオブジェクトの数
+    uint32_t GetOcclusionCulledCount() const {
+        return occlusionCulledCount_;
+    }
+
+    /// @brief 描画するスプライトの設定。スプライトはまとめて描画される
+    /// @param spriteState 描画するスプライトの情報
+    void DrawSetSprite(const SpriteBatch::SpriteState &spriteState);
+
+    /// @brief スプライトの並べ方の設定。既定は呼んだ順番(kSubmissionOrder)で、
+    /// kTextureにするとレイヤーの中で重なりの前後よりテクスチャでまとめることを優先する
+    /// @param sortMode 並べ方
+    void SetSpriteSortMode(SpriteSortMode sortMode) {
+        spriteBatch_->SetSortMode(sortMode);
+    }
+
+    /// @brief 前のフレームでスプライトの描画に使った描画コマンドの数の取得
+    /// @return 描画コマンドの数
+    uint32_t GetSpriteDrawCallCount() const {
+        return spriteDrawCallCount_;
+    }
+
 private:
     /// @brief 平行光源の設定
     /// @param light 平行光源へのポインタ
     void SetLightBuffer(DirectionalLight *light);
 
+    /// @brief 遮蔽物を深度バッファに描き、その裏に隠れるオブジェクトを描画するオブジェクトから取り除く
+    void CullOccludedObjects();
+
     /// @brief 共通の描画処理
     void DrawCommon(std::vector<ObjectState> &objectStates);
 
@@ -141,6 +208,15 @@ private:
     /// @brief グリッド線の描画処理
     void DrawLine(LineState *lineState);
 
+    /// @brief 2Dオブジェクトとスプライトを、設定した順番で描画する
+    void Draw2D();
+
+    /// @brief まとめたスプライトの描画の範囲を、スプライトの位置がendSpriteより前のものまで描画する
+    /// @param runs 描画の範囲
+    /// @param runIndex 次に描画する範囲の位置(描画した分だけ進める)
+    /// @param endSprite 描画するスプライトの位置の終わり
+    void DrawSpriteRuns(const std::vector<SpriteBatch::DrawRun> &runs, size_t &runIndex, UINT endSprite);
+
     /// @brief WinAppインスタンス
     WinApp *winApp_ = nullptr;
     /// @brief DirectXCommonインスタンス
@@ -165,8 +241,32 @@ private:
     std::vector<ObjectState> drawObjects_;
     /// @brief 描画する半透明オブジェクト
     std::vector<ObjectState> drawAlphaObjects_;
-    /// @brief 描画する2Dオブジェクト
+    /// @brief 描画する2Dオブジェクトと、それぞれの前に設定されていたスプライトの数
     std::vector<ObjectState> draw2DObjects_;
+    std::vector<UINT> draw2DSpriteCounts_;
+    /// @brief 遮蔽物
+    std::vector<OccluderState> drawOccluders_;
+    /// @brief オクルージョンカリング
+    Math::OcclusionCuller occlusionCuller_;
+    /// @brief オクルージョンカリングの有効フラグ
+    bool isOcclusionCulling_ = false;
+    /// @brief 遮蔽物に隠れて描画しなかったオブジェクトの数
+    uint32_t occlusionCulledCount_ = 0;
+    /// @brief スプライトをまとめて描画するためのバッチ
+    std::unique_ptr<SpriteBatch> spriteBatch_;
+    /// @brief スプライトの描画に使った描画コマンドの数
+    uint32_t spriteDrawCallCount_ = 0;
+
+    /// @brief 直前に設定したルートシグネチャ
+    ID3D12RootSignature *currentRootSignature_ = nullptr;
+    /// @brief 直前に設定したパイプライン
+    ID3D12PipelineState *currentPipelineState_ = nullptr;
+    /// @brief 直前に設定したSRVのGPUハンドル
+    D3D12_GPU_DESCRIPTOR_HANDLE currentSrvHandle_ = {};
+    /// @brief SRVのディスクリプタテーブルを設定した回数
+    uint32_t descriptorSwitchCount_ = 0;
+    /// @brief 同じSRVが続いたため設定を省略した回数
+    uint32_t skippedDescriptorSwitchCount_ = 0;
 
     /// @brief 2D描画用のビュー行列
     Matrix4x4 viewMatrix2D_ = {};
@@ -4,7 +4,12 @@
 #include "3d/PrimitiveDrawer.h"
 #include "Common/Logs.h"
 #include "Common/ConvertString.h"
+#include "Common/ImageDecoder.h"
+#include "Common/MipGenerator.h"
+#include "Common/AtlasPacker.h"
+#include "Common/TextureResidency.h"
 #include "Common/Descriptors/SRV.h"
+#include <cstring>
 #include <unordered_map>
 
 namespace KashipanEngine {
@@ -17,6 +22,58 @@ DirectXCommon *sDxCommon = nullptr;
 std::unordered_map<std::string, TextureData> sTextureMap;
 /// @brief テクスチャのファイルパス
 std::vector<std::string> sTextureFilePaths;
+/// @brief 作成したアトラスのページ数
+uint32_t sAtlasPageCount = 0;
+/// @brief テクスチャのメモリ予算とLRUの管理
+TextureResidency sResidency;
+/// @brief テクスチャごとのリソースを持っているテクスチャのインデックス(アトラスに詰めたものはページ)
+std::vector<uint32_t> sTextureOwners;
+/// @brief このフレームで読み込み直したテクスチャ。中間リソースをフレームの終わりで解放する
+std::vector<uint32_t> sReloadedTextures;
+/// @brief 読み込み直すテクスチャの作業用
+std::vector<uint32_t> sReloadRequests;
+/// @brief 追い出したテクスチャの作業用
+std::vector<uint32_t> sEvictedTextures;
+
+/// @brief アトラスのページの最大サイズ
+constexpr uint32_t kAtlasPageSize = 2048;
+/// @brief アトラスの画像の周りに付けるガターの幅
+constexpr uint32_t kAtlasGutter = 8;
+/// @brief アトラスのミップマップのレベル数。ガターの幅が1ピクセル以上残る段まで
+constexpr uint32_t kAtlasMipLevels = 4;
+/// @brief 追い出すまでに最低限使われていないフレーム数
+constexpr uint32_t kEvictionIdleFrames = 60;
+
+/// @brief デコード済みの画像からScratchImageを作成する
+/// @param baseImage 元画像
+/// @param mipLevels レベル1以降のミップマップ
+/// @return 作成したScratchImage
+DirectX::ScratchImage CreateScratchImage(const DecodedImage &baseImage, const std::vector<DecodedImage> &mipLevels) {
+    DirectX::ScratchImage image{};
+    HRESULT hr = image.Initialize2D(
+        DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
+        baseImage.width,
+        baseImage.height,
+        1,
+        mipLevels.size() + 1
+    );
+    if (FAILED(hr)) assert(SUCCEEDED(hr));
+
+    // 行ごとのピッチが異なる場合があるので1行ずつコピーする
+    for (size_t mip = 0; mip <= mipLevels.size(); ++mip) {
+        const DecodedImage &srcImage = mip == 0 ? baseImage : mipLevels[mip - 1];
+        const DirectX::Image *dstImage = image.GetImage(mip, 0, 0);
+        const size_t srcRowPitch = static_cast<size_t>(srcImage.width) * 4;
+        for (uint32_t y = 0; y < srcImage.height; ++y) {
+            std::memcpy(
+                dstImage->pixels + dstImage->rowPitch * y,
+                srcImage.pixels.data() + srcRowPitch * y,
+                srcRowPitch
+            );
+        }
+    }
+    return image;
+}
 
 /// @brief テクスチャファイルを読み込んで扱えるようにする
 /// @param filePath テクスチャファイルのパス
@@ -24,6 +81,16 @@ std::vector<std::string> sTextureFilePaths;
 DirectX::ScratchImage LoadTexture(const std::string &filePath) {
     // テクスチャファイルを読み込んで扱えるようにする
     DirectX::ScratchImage image{};
+
+    // PNG/BMPは自前のデコーダで読み込み、ミップマップも並列に生成する
+    DecodedImage decodedImage;
+    std::vector<DecodedImage> mipLevels;
+    if (ImageDecoder::LoadFromFile(filePath, decodedImage) &&
+        MipGenerator::Generate(decodedImage, mipLevels)) {
+        return CreateScratchImage(decodedImage, mipLevels);
+    }
+
+    // 対応していない形式はWICで読み込む
     std::wstring filePathW = ConvertString(filePath);
     HRESULT hr = DirectX::LoadFromWICFile(
         filePathW.c_str(),
@@ -53,7 +120,11 @@ DirectX::ScratchImage LoadTexture(const std::string &filePath) {
     return mipImages;
 }
 
-void CreateTextureResource(const DirectX::TexMetadata &metadata) {
+/// @brief テクスチャリソースを作成する
+/// @param textureResource 作成したリソースの格納先
+/// @param metadata テクスチャのメタデータ
+/// @return GPU上で確保されたサイズ
+uint64_t CreateTextureResource(Microsoft::WRL::ComPtr<ID3D12Resource> &textureResource, const DirectX::TexMetadata &metadata) {
     //==================================================
     // metadataを基にResourceの設定
     //==================================================
@@ -78,16 +149,18 @@ void CreateTextureResource(const DirectX::TexMetadata &metadata) {
     // Resourceを生成する
     //==================================================
 
-    auto textureResource = &sTextureMap[sTextureFilePaths.back()].resource;
     HRESULT hr = sDxCommon->GetDevice()->CreateCommittedResource(
         &heapProperties,                // Heapの設定
         D3D12_HEAP_FLAG_NONE,           // Heapの特殊な設定
         &resourceDesc,                  // Resourceの設定
         D3D12_RESOURCE_STATE_COPY_DEST, // データ転送される設定
         nullptr,                        // Clear最適値。使わないのでnullptr
-        IID_PPV_ARGS(textureResource)   // 作成するResourceポインタへのポインタ
+        IID_PPV_ARGS(&textureResource)  // 作成するResourceポインタへのポインタ
     );
     if (FAILED(hr)) assert(SUCCEEDED(hr));
+
+    // メモリ予算の管理用に実際に確保されたサイズを返す
+    return sDxCommon->GetDevice()->GetResourceAllocationInfo(0, 1, &resourceDesc).SizeInBytes;
 }
 
 Microsoft::WRL::ComPtr<ID3D12Resource> UploadTextureData(ID3D12Resource *texture, const DirectX::ScratchImage &mipImages) {
@@ -118,6 +191,7 @@ Microsoft::WRL::ComPtr<ID3D12Resource> UploadTextureData(ID3D12Resource *texture
     );
 
     // Textureへの転送後は利用できるよう、D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCEに遷移
+    // 描画の途中で読み込み直すこともあるので、スワップチェーンのBarrierの状態は変えない
     D3D12_RESOURCE_BARRIER barrier{};
     barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
     barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
@@ -125,11 +199,106 @@ Microsoft::WRL::ComPtr<ID3D12Resource> UploadTextureData(ID3D12Resource *texture
     barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
     barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
     barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_GENERIC_READ;
-    sDxCommon->SetBarrier(barrier);
+    sDxCommon->GetCommandList()->ResourceBarrier(1, &barrier);
 
     return intermediateResource;
 }
 
+/// @brief テクスチャのSRVを作成する
+/// @param texture SRVを作成するテクスチャ
+/// @param metadata テクスチャのメタデータ
+void CreateTextureSRV(const TextureData &texture, const DirectX::TexMetadata &metadata) {
+    // metadataを基にSRVの設定
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+    srvDesc.Format = metadata.format;
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = UINT(metadata.mipLevels);
+
+    // SRVの生成
+    sDxCommon->GetDevice()->CreateShaderResourceView(
+        texture.resource.Get(),
+        &srvDesc,
+        texture.srvHandleCPU
+    );
+}
+
+/// @brief ScratchImageからテクスチャを作成して登録する
+/// @param name 登録するテクスチャの名前
+/// @param mipImages ミップマップ付きの画像
+/// @param isPinned メモリ予算を超えても追い出さないかどうか
+/// @return 登録したテクスチャのインデックス
+uint32_t CreateTexture(const std::string &name, const DirectX::ScratchImage &mipImages, bool isPinned) {
+    // ミップマップのメタデータを取得
+    const DirectX::TexMetadata &metadata = mipImages.GetMetadata();
+
+    // テクスチャデータを作成
+    TextureData texture = {
+        name,
+        static_cast<uint32_t>(sTextureMap.size()),
+        nullptr,
+        nullptr,
+        // SRVを作成するDescriptorHeapの場所を決める
+        SRV::GetCPUDescriptorHandle(),
+        SRV::GetGPUDescriptorHandle(),
+        // テクスチャのサイズを保存
+        static_cast<uint32_t>(metadata.width),
+        static_cast<uint32_t>(metadata.height)
+    };
+    sTextureMap[name] = texture;
+    sTextureFilePaths.push_back(name);
+    sTextureOwners.push_back(texture.index);
+
+    // テクスチャリソースを作成
+    const uint64_t sizeInBytes = CreateTextureResource(sTextureMap[name].resource, metadata);
+    sResidency.Register(texture.index, sizeInBytes, isPinned);
+
+    // テクスチャリソースをアップロード
+    sTextureMap[name].intermediateResource = UploadTextureData(
+        sTextureMap[name].resource.Get(),
+        mipImages
+    );
+
+    // コマンドを実行
+    sDxCommon->CommandExecute(false);
+    // CommandExecuteはGPUの完了を待つので、転送が終わった中間リソースはすぐに解放できる
+    sTextureMap[name].intermediateResource.Reset();
+
+    // SRVの生成
+    CreateTextureSRV(sTextureMap[name], metadata);
+
+    // Barrierを元に戻す
+    D3D12_RESOURCE_BARRIER barrier{};
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+    barrier.Transition.pResource = sTextureMap[name].resource.Get();
+    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_GENERIC_READ;
+    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
+    sDxCommon->SetBarrier(barrier);
+
+    return sTextureMap[name].index;
+}
+
+/// @brief 追い出したテクスチャをファイルから読み込み直す。
+/// フレームの始めに呼ばれるので、転送はこれから描画するコマンドリストに積むだけで実行はしない
+/// @param index 読み込み直すテクスチャのインデックス
+void ReloadTexture(uint32_t index) {
+    TextureData &texture = sTextureMap[sTextureFilePaths[index]];
+    DirectX::ScratchImage mipImages = LoadTexture(texture.name);
+    const DirectX::TexMetadata &metadata = mipImages.GetMetadata();
+
+    CreateTextureResource(texture.resource, metadata);
+    texture.intermediateResource = UploadTextureData(texture.resource.Get(), mipImages);
+    // SRVは元と同じ場所に作り直すので、インデックスやハンドルは変わらない
+    CreateTextureSRV(texture, metadata);
+
+    sResidency.MarkResident(index);
+    sReloadedTextures.push_back(index);
+
+    Log(std::format("Reload Texture: {} index: {}", texture.name, index), kLogLevelFlagInfo);
+}
+
 } // namespace
 
 void Texture::Initialize(DirectXCommon *dxCommon) {
@@ -162,6 +331,10 @@ void Texture::Finalize() {
     }
     sTextureMap.clear();
     sTextureFilePaths.clear();
+    sTextureOwners.clear();
+    sReloadedTextures.clear();
+    sReloadRequests.clear();
+    sResidency = TextureResidency{};
     // 終了完了のログを出力
     Log("Texture Finalized.");
 }
@@ -175,60 +348,8 @@ uint32_t Texture::Load(const std::string &filePath) {
 
     // テクスチャファイルを読み込んで扱えるようにする
     DirectX::ScratchImage mipImages = LoadTexture(filePath);
-    // ミップマップのメタデータを取得
-    const DirectX::TexMetadata &metadata = mipImages.GetMetadata();
-
-    // テクスチャデータを作成
-    TextureData texture = {
-        filePath,
-        static_cast<uint32_t>(sTextureMap.size()),
-        nullptr,
-        nullptr,
-        // SRVを作成するDescriptorHeapの場所を決める
-        SRV::GetCPUDescriptorHandle(),
-        SRV::GetGPUDescriptorHandle(),
-        // テクスチャのサイズを保存
-        static_cast<uint32_t>(metadata.width),
-        static_cast<uint32_t>(metadata.height)
-    };
-    sTextureMap[filePath] = texture;
-    sTextureFilePaths.push_back(filePath);
-
-    // テクスチャリソースを作成
-    CreateTextureResource(metadata);
-
-    // テクスチャリソースをアップロード
-    sTextureMap[filePath].intermediateResource = UploadTextureData(
-        sTextureMap[filePath].resource.Get(),
-        mipImages
-    );
-
-    // コマンドを実行
-    sDxCommon->CommandExecute(false);
-
-    // metadataを基にSRVの設定
-    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
-    srvDesc.Format = metadata.format;
-    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-    srvDesc.Texture2D.MipLevels = UINT(metadata.mipLevels);
-
-    // SRVの生成
-    sDxCommon->GetDevice()->CreateShaderResourceView(
-        sTextureMap[filePath].resource.Get(),
-        &srvDesc,
-        sTextureMap[filePath].srvHandleCPU
-    );
-
-    // Barrierを元に戻す
-    D3D12_RESOURCE_BARRIER barrier{};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barrier.Transition.pResource = sTextureMap[filePath].resource.Get();
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_GENERIC_READ;
-    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
-    sDxCommon->SetBarrier(barrier);
+    // テクスチャを作成して登録。デフォルトのテクスチャは追い出さない
+    CreateTexture(filePath, mipImages, sTextureFilePaths.empty());
 
     // 読み込んだテクスチャとそのインデックスをログに出力
     Log(std::format("Load Texture: {} ({}x{}) index: {}",
@@ -242,6 +363,89 @@ uint32_t Texture::Load(const std::string &filePath) {
     return static_cast<uint32_t>(sTextureMap[filePath].index);
 }
 
+void Texture::LoadAtlas(const std::vector<std::string> &filePaths) {
+    // 読み込み済みでないものだけデコードする
+    std::vector<std::string> targetFilePaths;
+    std::vector<DecodedImage> images;
+    for (const auto &filePath : filePaths) {
+        if (sTextureMap.find(filePath) != sTextureMap.end()) {
+            Log(std::format("Texture already loaded: {}", filePath), kLogLevelFlagWarning);
+            continue;
+        }
+        DecodedImage image;
+        if (!ImageDecoder::LoadFromFile(filePath, image)) {
+            // 自前でデコードできない形式は個別のテクスチャとして読み込む
+            Load(filePath);
+            continue;
+        }
+        targetFilePaths.push_back(filePath);
+        images.push_back(std::move(image));
+    }
+
+    std::vector<const DecodedImage *> imagePtrs;
+    for (const auto &image : images) {
+        imagePtrs.push_back(&image);
+    }
+    std::vector<AtlasPage> pages;
+    std::vector<AtlasPlacement> placements;
+    AtlasPacker::Pack(imagePtrs, kAtlasPageSize, kAtlasGutter, kAtlasGutter, pages, placements);
+
+    // ページごとにテクスチャを作成する
+    std::vector<uint32_t> pageTextureIndices;
+    for (const auto &page : pages) {
+        std::vector<DecodedImage> mipLevels;
+        if (!MipGenerator::Generate(page.image, mipLevels, kAtlasMipLevels)) {
+            Log("Failed to generate atlas mipmaps.", kLogLevelFlagError);
+            assert(false);
+        }
+        const std::string pageName = std::format("AtlasPage{}", sAtlasPageCount++);
+        // ページは読み込み直す元のファイルが無いので追い出さない
+        pageTextureIndices.push_back(CreateTexture(pageName, CreateScratchImage(page.image, mipLevels), true));
+
+        Log(std::format("Create Atlas: {} ({}x{}) occupancy: {:.1f}%",
+            pageName,
+            page.image.width,
+            page.image.height,
+            page.GetOccupancy() * 100.0f
+        ), kLogLevelFlagInfo);
+    }
+
+    // 詰めた画像はページのSRVを共有し、UVの範囲だけを持つテクスチャとして登録する。
+    // リソースはページだけが持つ
+    for (size_t i = 0; i < targetFilePaths.size(); ++i) {
+        const std::string &filePath = targetFilePaths[i];
+        const AtlasPlacement &placement = placements[i];
+        if (placement.pageIndex == AtlasPlacement::kNotPacked) {
+            Load(filePath);
+            continue;
+        }
+        const TextureData &pageTexture = GetTexture(pageTextureIndices[placement.pageIndex]);
+        const float pageWidth = static_cast<float>(pageTexture.width);
+        const float pageHeight = static_cast<float>(pageTexture.height);
+
+        TextureData texture = pageTexture;
+        texture.name = filePath;
+        texture.index = static_cast<uint32_t>(sTextureMap.size());
+        texture.resource = nullptr;
+        texture.intermediateResource = nullptr;
+        texture.width = placement.width;
+        texture.height = placement.height;
+        texture.uvOffset = Vector2(placement.x / pageWidth, placement.y / pageHeight);
+        texture.uvScale = Vector2(placement.width / pageWidth, placement.height / pageHeight);
+        sTextureMap[filePath] = texture;
+        sTextureFilePaths.push_back(filePath);
+        sTextureOwners.push_back(pageTexture.index);
+
+        Log(std::format("Load Texture: {} ({}x{}) index: {} atlas: {}",
+            filePath,
+            texture.width,
+            texture.height,
+            texture.index,
+            pageTexture.name
+        ), kLogLevelFlagInfo);
+    }
+}
+
 const TextureData &Texture::GetTexture(uint32_t index) {
     // インデックスが範囲外の場合はデフォルトのテクスチャを返す
     if (index >= sTextureFilePaths.size()) {
@@ -262,4 +466,54 @@ const TextureData &Texture::GetTexture(const std::string &filePath) {
     return sTextureMap[filePath];
 }
 
+const TextureData &Texture::Use(uint32_t index) {
+    if (index >= sTextureFilePaths.size()) {
+        index = 0;
+    }
+    // リソースを持っているテクスチャに使用したフレームを記録する。
+    // 追い出されていれば次のフレームの始めに読み込み直すので、このフレームはデフォルトのテクスチャで描画する
+    const uint32_t owner = sTextureOwners[index];
+    if (sResidency.Touch(owner)) {
+        return sTextureMap[sTextureFilePaths[0]];
+    }
+    return sTextureMap[sTextureFilePaths[index]];
+}
+
+void Texture::BeginFrame() {
+    // 前のフレームで追い出されていて使われたものを、描画を積む前に読み込み直す
+    sResidency.TakeReloadRequests(sReloadRequests);
+    for (uint32_t index : sReloadRequests) {
+        ReloadTexture(index);
+    }
+}
+
+void Texture::EndFrame() {
+    // GPUの完了を待った後なので、読み込み直しに使った中間リソースはもう要らない
+    for (uint32_t index : sReloadedTextures) {
+        sTextureMap[sTextureFilePaths[index]].intermediateResource.Reset();
+    }
+    sReloadedTextures.clear();
+
+    // 予算を超えていれば、しばらく使われていないものからリソースを解放する。
+    // SRVの場所はそのまま残しておき、次に使われたときに読み込み直す
+    sResidency.EndFrame(sEvictedTextures);
+    for (uint32_t index : sEvictedTextures) {
+        TextureData &texture = sTextureMap[sTextureFilePaths[index]];
+        texture.resource.Reset();
+        Log(std::format("Evict Texture: {} index: {}", texture.name, index), kLogLevelFlagInfo);
+    }
+}
+
+void Texture::SetMemoryBudget(uint64_t budgetBytes) {
+    sResidency.SetBudget(budgetBytes, kEvictionIdleFrames);
+}
+
+uint64_t Texture::GetMemoryBudget() {
+    return sResidency.GetBudget();
+}
+
+uint64_t Texture::GetResidentMemorySize() {
+    return sResidency.GetResidentBytes();
+}
+
 } // namespace KashipanEngine
@@ -28,6 +28,11 @@ public:
     /// @return テクスチャを読み込んだインデックス
     static uint32_t Load(const std::string &filePath);
 
+    /// @brief 小さいテクスチャをアトラスにまとめて読み込む。
+    /// 読み込んだ後は通常のテクスチャと同じように取得でき、SRVはアトラスのページと共有する
+    /// @param filePaths 読み込むテクスチャのファイル名
+    static void LoadAtlas(const std::vector<std::string> &filePaths);
+
     /// @brief テクスチャデータの取得
     /// @param index テクスチャのインデックス
     /// @return テクスチャデータ
@@ -37,6 +42,33 @@ public:
     /// @param filePath テクスチャのファイルパス
     /// @return テクスチャデータ
     static [[nodiscard]] const TextureData &GetTexture(const std::string &filePath);
+
+    /// @brief 描画に使うテクスチャデータの取得。
+    /// 使用したフレームを記録し、メモリ予算で追い出されていれば次のフレームの始めに読み込み直す。
+    /// 読み込み直すまではデフォルトのテクスチャを返す
+    /// @param index テクスチャのインデックス
+    /// @return テクスチャデータ
+    static const TextureData &Use(uint32_t index);
+
+    /// @brief フレームの始めの処理。描画を積む前に呼ぶ。
+    /// 前のフレームで追い出されていて使われたテクスチャを読み込み直す
+    static void BeginFrame();
+
+    /// @brief フレームの終わりの処理。GPUの完了を待った後に呼ぶ。
+    /// 予算を超えていれば、しばらく使われていないテクスチャを追い出す
+    static void EndFrame();
+
+    /// @brief テクスチャのGPUメモリの予算を設定する
+    /// @param budgetBytes 予算(バイト)。0なら無制限
+    static void SetMemoryBudget(uint64_t budgetBytes);
+
+    /// @brief テクスチャのGPUメモリの予算の取得
+    /// @return 予算(バイト)。0なら無制限
+    static uint64_t GetMemoryBudget();
+
+    /// @brief 常駐しているテクスチャのGPUメモリの合計の取得
+    /// @return 合計(バイト)
+    static uint64_t GetResidentMemorySize();
 };
 
 } // namespace KashipanEngine
\ No newline at end of file
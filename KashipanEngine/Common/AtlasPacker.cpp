@@ -0,0 +1,133 @@
+#include "AtlasPacker.h"
+#include <algorithm>
+#include <cstring>
+
+// imgui側の実装はimgui_draw.cpp内でstaticになっているので、ここでも同じ形で実装を取り込む
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imstb_rectpack.h>
+
+namespace KashipanEngine {
+
+namespace AtlasPacker {
+
+namespace {
+
+/// @brief 値をalignmentの倍数に切り上げる
+uint32_t AlignUp(uint32_t value, uint32_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/// @brief ガター付きで画像をページに書き込む
+/// @param page 書き込み先のページ
+/// @param image 書き込む画像
+/// @param placement 画像の配置
+/// @param gutter ガターの幅
+void BlitWithGutter(DecodedImage &page, const DecodedImage &image, const AtlasPlacement &placement, uint32_t gutter) {
+    const size_t pageRowSize = static_cast<size_t>(page.width) * 4;
+    const size_t imageRowSize = static_cast<size_t>(image.width) * 4;
+
+    // 画像の各行を書き込み、左右に端のピクセルを複製する
+    for (uint32_t y = 0; y < image.height; ++y) {
+        const uint8_t *src = image.pixels.data() + imageRowSize * y;
+        uint8_t *dst = page.pixels.data() + pageRowSize * (placement.y + y) + static_cast<size_t>(placement.x) * 4;
+        std::memcpy(dst, src, imageRowSize);
+        for (uint32_t i = 1; i <= gutter; ++i) {
+            std::memcpy(dst - static_cast<size_t>(i) * 4, src, 4);
+            std::memcpy(dst + imageRowSize + static_cast<size_t>(i - 1) * 4, src + imageRowSize - 4, 4);
+        }
+    }
+
+    // 上下はガター込みの行をそのまま複製する
+    const size_t rowWithGutter = imageRowSize + static_cast<size_t>(gutter) * 8;
+    uint8_t *topRow = page.pixels.data() + pageRowSize * placement.y + static_cast<size_t>(placement.x - gutter) * 4;
+    uint8_t *bottomRow = topRow + pageRowSize * (image.height - 1);
+    for (uint32_t i = 1; i <= gutter; ++i) {
+        std::memcpy(topRow - pageRowSize * i, topRow, rowWithGutter);
+        std::memcpy(bottomRow + pageRowSize * i, bottomRow, rowWithGutter);
+    }
+}
+
+} // namespace
+
+bool Pack(const std::vector<const DecodedImage *> &images, uint32_t pageSize, uint32_t gutter, uint32_t alignment,
+    std::vector<AtlasPage> &outPages, std::vector<AtlasPlacement> &outPlacements) {
+    outPages.clear();
+    outPlacements.assign(images.size(), AtlasPlacement{ AtlasPlacement::kNotPacked });
+    if (alignment == 0 || pageSize < alignment) {
+        return false;
+    }
+
+    // 配置をalignmentの倍数に揃えるため、alignmentを1単位としたグリッド上で詰める
+    const int gridSize = static_cast<int>(pageSize / alignment);
+    std::vector<stbrp_rect> rects;
+    rects.reserve(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        const DecodedImage *image = images[i];
+        if (image == nullptr || image->width == 0 || image->height == 0) {
+            continue;
+        }
+        const uint32_t paddedWidth = AlignUp(image->width + gutter * 2, alignment);
+        const uint32_t paddedHeight = AlignUp(image->height + gutter * 2, alignment);
+        if (paddedWidth > pageSize || paddedHeight > pageSize) {
+            // ページに収まらない画像は詰めない
+            continue;
+        }
+        stbrp_rect rect{};
+        rect.id = static_cast<int>(i);
+        rect.w = static_cast<stbrp_coord>(paddedWidth / alignment);
+        rect.h = static_cast<stbrp_coord>(paddedHeight / alignment);
+        rects.push_back(rect);
+    }
+
+    std::vector<stbrp_node> nodes(gridSize);
+    while (!rects.empty()) {
+        stbrp_context context;
+        stbrp_init_target(&context, gridSize, gridSize, nodes.data(), gridSize);
+        stbrp_pack_rects(&context, rects.data(), static_cast<int>(rects.size()));
+
+        // 配置できた矩形から使った範囲を求める
+        const uint32_t pageIndex = static_cast<uint32_t>(outPages.size());
+        uint32_t usedWidth = 0;
+        uint32_t usedHeight = 0;
+        for (const auto &rect : rects) {
+            if (rect.was_packed) {
+                usedWidth = std::max(usedWidth, static_cast<uint32_t>(rect.x + rect.w) * alignment);
+                usedHeight = std::max(usedHeight, static_cast<uint32_t>(rect.y + rect.h) * alignment);
+            }
+        }
+        if (usedHeight == 0) {
+            break;
+        }
+
+        AtlasPage &page = outPages.emplace_back();
+        page.image.width = usedWidth;
+        page.image.height = usedHeight;
+        page.image.pixels.assign(static_cast<size_t>(usedWidth) * usedHeight * 4, 0);
+
+        // 配置できたものを書き込み、残りは次のページに回す
+        std::vector<stbrp_rect> remainingRects;
+        for (const auto &rect : rects) {
+            if (!rect.was_packed) {
+                remainingRects.push_back(rect);
+                continue;
+            }
+            const DecodedImage &image = *images[rect.id];
+            AtlasPlacement &placement = outPlacements[rect.id];
+            placement.pageIndex = pageIndex;
+            placement.x = static_cast<uint32_t>(rect.x) * alignment + gutter;
+            placement.y = static_cast<uint32_t>(rect.y) * alignment + gutter;
+            placement.width = image.width;
+            placement.height = image.height;
+            BlitWithGutter(page.image, image, placement, gutter);
+            page.usedPixelCount += static_cast<uint64_t>(image.width) * image.height;
+        }
+        rects.swap(remainingRects);
+    }
+
+    return !outPages.empty();
+}
+
+} // namespace AtlasPacker
+
+} // namespace KashipanEngine
\ No newline at end of file
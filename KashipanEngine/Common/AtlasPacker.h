@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Common/ImageDecoder.h"
+
+namespace KashipanEngine {
+
+/// @brief アトラスに詰めた画像の配置
+struct AtlasPlacement {
+    /// @brief 配置されたページ。配置できなかった場合はkNotPacked
+    uint32_t pageIndex = 0;
+    /// @brief ページ内のX座標(ガターを除いた画像の左上)
+    uint32_t x = 0;
+    /// @brief ページ内のY座標(ガターを除いた画像の左上)
+    uint32_t y = 0;
+    /// @brief 画像の幅
+    uint32_t width = 0;
+    /// @brief 画像の高さ
+    uint32_t height = 0;
+
+    /// @brief 配置できなかったことを表すページ番号
+    static constexpr uint32_t kNotPacked = 0xffffffff;
+};
+
+/// @brief アトラスのページ
+struct AtlasPage {
+    /// @brief ページの画像(RGBA8)
+    DecodedImage image;
+    /// @brief 画像が占めているピクセル数(ガターと余白は含まない)
+    uint64_t usedPixelCount = 0;
+
+    /// @brief ページの使用率
+    /// @return 0～1の使用率
+    float GetOccupancy() const {
+        const uint64_t pageArea = static_cast<uint64_t>(image.width) * image.height;
+        return pageArea == 0 ? 0.0f : static_cast<float>(static_cast<double>(usedPixelCount) / pageArea);
+    }
+};
+
+/*
+小さい画像をimstb_rectpackで共有のページに詰める。
+各画像の周りには端のピクセルを複製したガターを付け、配置をalignmentの倍数に揃えるので、
+log2(alignment)段までのミップマップなら隣の画像の色が混ざらない。
+*/
+
+namespace AtlasPacker {
+
+/// @brief 画像をアトラスのページに詰める
+/// @param images 詰める画像
+/// @param pageSize ページの最大の幅と高さ
+/// @param gutter 画像の周りに付けるガターの幅
+/// @param alignment 配置を揃える単位(2の累乗)
+/// @param outPages 作成したページの出力先。サイズは使った範囲まで切り詰める
+/// @param outPlacements 画像ごとの配置の出力先。imagesと同じ順番
+/// @return 1つでもページに配置できたかどうか
+bool Pack(const std::vector<const DecodedImage *> &images, uint32_t pageSize, uint32_t gutter, uint32_t alignment,
+    std::vector<AtlasPage> &outPages, std::vector<AtlasPlacement> &outPlacements);
+
+} // namespace AtlasPacker
+
+} // namespace KashipanEngine
\ No newline at end of file
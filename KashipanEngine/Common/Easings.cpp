@@ -1,6 +1,11 @@
 #include <math.h>
+#include <numbers>
 #include "Easings.h"
-#define M_PI (4.0f * atanf(1.0f))
+
+namespace {
+// 円周率(kPiは環境によって定義されていたりいなかったりするので使わない)
+constexpr float kPi = std::numbers::pi_v<float>;
+} // namespace
 
 namespace KashipanEngine {
 
@@ -261,24 +266,24 @@ float Ease::None(float t, float x1, float x2) {
 }
 
 float Ease::InSine(float t, float x1, float x2) {
-	float easedT = 1.0f - cosf((t * M_PI) / 2.0f);
+	float easedT = 1.0f - cosf((t * kPi) / 2.0f);
 	return (1.0f - easedT) * x1 + easedT * x2;
 }
 
 float Ease::OutSine(float t, float x1, float x2) {
-	float easedT = sinf((t * M_PI) / 2.0f);
+	float easedT = sinf((t * kPi) / 2.0f);
 	return (1.0f - easedT) * x1 + easedT * x2;
 }
 
 float Ease::InOutSine(float t, float x1, float x2) {
-	float easedT = -(cosf(M_PI * t) - 1.0f) / 2.0f;
+	float easedT = -(cosf(kPi * t) - 1.0f) / 2.0f;
 	return (1.0f - easedT) * x1 + easedT * x2;
 }
 
 float Ease::OutInSine(float t, float x1, float x2) {
 	float easedT = t < 0.5f
-		? 0.5f * sinf(M_PI * t)
-		: 1.0f - 0.5f * cosf(M_PI * (t - 0.5f)) * 2.0f;
+		? 0.5f * sinf(kPi * t)
+		: 1.0f - 0.5f * cosf(kPi * (t - 0.5f)) * 2.0f;
 	return (1.0f - easedT) * x1 + easedT * x2;
 }
 
@@ -465,7 +470,7 @@ float Ease::OutInBack(float t, float x1, float x2) {
 }
 
 float Ease::InElastic(float t, float x1, float x2) {
-	static const float c4 = (2.0f * M_PI) / 3.0f;
+	static const float c4 = (2.0f * kPi) / 3.0f;
 
 	float easedT = t == 0.0f ? 0.0f
 		: t == 1.0f ? 1.0f
@@ -474,7 +479,7 @@ float Ease::InElastic(float t, float x1, float x2) {
 }
 
 float Ease::OutElastic(float t, float x1, float x2) {
-	static const float c4 = (2.0f * M_PI) / 3.0f;
+	static const float c4 = (2.0f * kPi) / 3.0f;
 
 	float easedT = t == 0.0f ? 0.0f
 		: t == 1.0f ? 1.0f
@@ -483,7 +488,7 @@ float Ease::OutElastic(float t, float x1, float x2) {
 }
 
 float Ease::InOutElastic(float t, float x1, float x2) {
-	static const float c5 = (2.0f * M_PI) / 4.5f;
+	static const float c5 = (2.0f * kPi) / 4.5f;
 
 	float easedT = t == 0.0f ? 0.0f
 		: t == 1.0f ? 1.0f
@@ -494,7 +499,7 @@ float Ease::InOutElastic(float t, float x1, float x2) {
 }
 
 float Ease::OutInElastic(float t, float x1, float x2) {
-	static const float c5 = (2.0f * M_PI) / 4.5f;
+	static const float c5 = (2.0f * kPi) / 4.5f;
 
 	float easedT = t == 0.0f ? 0.0f
 		: t == 1.0f ? 1.0f
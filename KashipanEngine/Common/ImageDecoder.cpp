@@ -0,0 +1,1026 @@
+#include "ImageDecoder.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define KASHIPAN_IMAGE_DECODER_SSE2
+#endif
+
+namespace KashipanEngine {
+
+namespace ImageDecoder {
+
+namespace {
+
+//==================================================
+// Inflate
+//==================================================
+
+/// @brief 高速テーブルで一度に引ける符号のビット数
+constexpr int kHuffmanFastBits = 10;
+constexpr uint32_t kHuffmanFastMask = (1u << kHuffmanFastBits) - 1;
+
+/// @brief 長さ符号の基本値
+constexpr uint16_t kLengthBase[31] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258, 0, 0
+};
+/// @brief 長さ符号の追加ビット数
+constexpr uint8_t kLengthExtra[31] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0, 0, 0
+};
+/// @brief 距離符号の基本値
+constexpr uint16_t kDistanceBase[32] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577, 0, 0
+};
+/// @brief 距離符号の追加ビット数
+constexpr uint8_t kDistanceExtra[32] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 0, 0
+};
+/// @brief 符号長符号の並び順
+constexpr uint8_t kCodeLengthOrder[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+/// @brief ビット列を反転する
+/// @param code 反転する値
+/// @param bitCount 反転するビット数
+/// @return 反転した値
+uint32_t ReverseBits(uint32_t code, int bitCount) {
+    uint32_t result = 0;
+    for (int i = 0; i < bitCount; ++i) {
+        result = (result << 1) | (code & 1u);
+        code >>= 1;
+    }
+    return result;
+}
+
+/// @brief ハフマン復号テーブル
+struct HuffmanTable {
+    /// @brief 高速テーブル。上位7bitに符号長、下位9bitにシンボル。0なら低速パスで引く
+    uint16_t fast[1 << kHuffmanFastBits];
+    /// @brief 各符号長の先頭の符号
+    uint16_t firstCode[16];
+    /// @brief 各符号長の先頭のシンボル位置
+    uint16_t firstSymbol[16];
+    /// @brief 各符号長の符号の上限(16bitに左詰め)
+    uint32_t maxCode[17];
+    /// @brief 符号順に並べた符号長
+    uint8_t sizes[288];
+    /// @brief 符号順に並べたシンボル
+    uint16_t symbols[288];
+
+    /// @brief 符号長の並びからテーブルを構築する
+    /// @param codeLengths シンボルごとの符号長
+    /// @param count シンボル数
+    /// @return 構築に成功したかどうか
+    bool Build(const uint8_t *codeLengths, int count) {
+        int lengthCounts[17] = {};
+        std::memset(fast, 0, sizeof(fast));
+        for (int i = 0; i < count; ++i) {
+            ++lengthCounts[codeLengths[i]];
+        }
+        lengthCounts[0] = 0;
+        for (int i = 1; i < 16; ++i) {
+            if (lengthCounts[i] > (1 << i)) {
+                return false;
+            }
+        }
+
+        int nextCode[16] = {};
+        int code = 0;
+        int symbolIndex = 0;
+        for (int i = 1; i < 16; ++i) {
+            nextCode[i] = code;
+            firstCode[i] = static_cast<uint16_t>(code);
+            firstSymbol[i] = static_cast<uint16_t>(symbolIndex);
+            code += lengthCounts[i];
+            if (lengthCounts[i] && code - 1 >= (1 << i)) {
+                return false;
+            }
+            maxCode[i] = static_cast<uint32_t>(code) << (16 - i);
+            code <<= 1;
+            symbolIndex += lengthCounts[i];
+        }
+        maxCode[16] = 0x10000;
+
+        for (int i = 0; i < count; ++i) {
+            const int length = codeLengths[i];
+            if (length == 0) {
+                continue;
+            }
+            const int position = nextCode[length] - firstCode[length] + firstSymbol[length];
+            sizes[position] = static_cast<uint8_t>(length);
+            symbols[position] = static_cast<uint16_t>(i);
+            if (length <= kHuffmanFastBits) {
+                const uint16_t fastValue = static_cast<uint16_t>((length << 9) | i);
+                uint32_t j = ReverseBits(static_cast<uint32_t>(nextCode[length]), length);
+                while (j < (1u << kHuffmanFastBits)) {
+                    fast[j] = fastValue;
+                    j += 1u << length;
+                }
+            }
+            ++nextCode[length];
+        }
+        return true;
+    }
+};
+
+/// @brief 64bitのビットバッファを使ったビット読み込み
+struct BitReader {
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+    /// @brief 次に読み込むバイト位置。終端を超えた分は0として読む
+    size_t position = 0;
+    uint64_t bitBuffer = 0;
+    uint32_t bitCount = 0;
+
+    /// @brief ビットバッファを56bit以上まで補充する
+    void Refill() {
+        if (position + 8 <= size) {
+            // 8バイトまとめて読み、入りきった分だけ位置を進める
+            uint64_t value;
+            std::memcpy(&value, data + position, sizeof(value));
+            bitBuffer |= value << bitCount;
+            position += (63 - bitCount) >> 3;
+            bitCount |= 56;
+        } else {
+            while (bitCount <= 56) {
+                const uint64_t value = position < size ? data[position] : 0;
+                bitBuffer |= value << bitCount;
+                ++position;
+                bitCount += 8;
+            }
+        }
+    }
+
+    /// @brief ビットを覗く
+    /// @param count 覗くビット数
+    /// @return 覗いた値
+    uint32_t Peek(uint32_t count) const {
+        return static_cast<uint32_t>(bitBuffer & ((uint64_t(1) << count) - 1));
+    }
+
+    /// @brief ビットを捨てる
+    /// @param count 捨てるビット数
+    void Consume(uint32_t count) {
+        bitBuffer >>= count;
+        bitCount -= count;
+    }
+
+    /// @brief ビットを読む
+    /// @param count 読むビット数(最大32)
+    /// @return 読んだ値
+    uint32_t Read(uint32_t count) {
+        if (bitCount < count) {
+            Refill();
+        }
+        const uint32_t value = Peek(count);
+        Consume(count);
+        return value;
+    }
+
+    /// @brief 終端を超えて読み込んでいないか
+    /// @return 超えていなければtrue
+    bool IsValid() const {
+        return position - (bitCount >> 3) <= size;
+    }
+
+    /// @brief ハフマン符号を1つ復号する
+    /// @param table 使用するテーブル
+    /// @return 復号したシンボル。失敗時は-1
+    int DecodeSymbol(const HuffmanTable &table) {
+        if (bitCount < 16) {
+            Refill();
+        }
+        const uint16_t fastValue = table.fast[bitBuffer & kHuffmanFastMask];
+        if (fastValue) {
+            Consume(fastValue >> 9);
+            return fastValue & 511;
+        }
+        // 高速テーブルに入らない長い符号は符号長ごとに探す
+        const uint32_t code = ReverseBits(Peek(16), 16);
+        int length = kHuffmanFastBits + 1;
+        while (length < 16 && code >= table.maxCode[length]) {
+            ++length;
+        }
+        if (length >= 16) {
+            return -1;
+        }
+        const int position = static_cast<int>(code >> (16 - length)) - table.firstCode[length] + table.firstSymbol[length];
+        if (position < 0 || position >= 288 || table.sizes[position] != length) {
+            return -1;
+        }
+        Consume(static_cast<uint32_t>(length));
+        return table.symbols[position];
+    }
+};
+
+/// @brief 動的ハフマンブロックのテーブルを読み込む
+/// @param reader ビット読み込み
+/// @param literalTable リテラル/長さのテーブルの出力先
+/// @param distanceTable 距離のテーブルの出力先
+/// @return 読み込みに成功したかどうか
+bool ReadDynamicTables(BitReader &reader, HuffmanTable &literalTable, HuffmanTable &distanceTable) {
+    const uint32_t literalCount = reader.Read(5) + 257;
+    const uint32_t distanceCount = reader.Read(5) + 1;
+    const uint32_t codeLengthCount = reader.Read(4) + 4;
+    if (literalCount > 286 || distanceCount > 30) {
+        return false;
+    }
+
+    uint8_t codeLengthSizes[19] = {};
+    for (uint32_t i = 0; i < codeLengthCount; ++i) {
+        codeLengthSizes[kCodeLengthOrder[i]] = static_cast<uint8_t>(reader.Read(3));
+    }
+    HuffmanTable codeLengthTable;
+    if (!codeLengthTable.Build(codeLengthSizes, 19)) {
+        return false;
+    }
+
+    uint8_t lengths[286 + 30] = {};
+    const uint32_t totalCount = literalCount + distanceCount;
+    uint32_t index = 0;
+    while (index < totalCount) {
+        const int symbol = reader.DecodeSymbol(codeLengthTable);
+        if (symbol < 0) {
+            return false;
+        }
+        if (symbol < 16) {
+            lengths[index++] = static_cast<uint8_t>(symbol);
+            continue;
+        }
+        uint8_t fillValue = 0;
+        uint32_t repeat = 0;
+        if (symbol == 16) {
+            if (index == 0) {
+                return false;
+            }
+            fillValue = lengths[index - 1];
+            repeat = reader.Read(2) + 3;
+        } else if (symbol == 17) {
+            repeat = reader.Read(3) + 3;
+        } else {
+            repeat = reader.Read(7) + 11;
+        }
+        if (index + repeat > totalCount) {
+            return false;
+        }
+        std::memset(lengths + index, fillValue, repeat);
+        index += repeat;
+    }
+
+    return literalTable.Build(lengths, static_cast<int>(literalCount)) &&
+        distanceTable.Build(lengths + literalCount, static_cast<int>(distanceCount));
+}
+
+/// @brief 固定ハフマンのテーブルを構築する
+/// @param literalTable リテラル/長さのテーブルの出力先
+/// @param distanceTable 距離のテーブルの出力先
+void BuildFixedTables(HuffmanTable &literalTable, HuffmanTable &distanceTable) {
+    uint8_t lengths[288];
+    std::memset(lengths, 8, 144);
+    std::memset(lengths + 144, 9, 112);
+    std::memset(lengths + 256, 7, 24);
+    std::memset(lengths + 280, 8, 8);
+    literalTable.Build(lengths, 288);
+    uint8_t distanceLengths[32];
+    std::memset(distanceLengths, 5, sizeof(distanceLengths));
+    distanceTable.Build(distanceLengths, 32);
+}
+
+/// @brief ハフマン符号化されたブロックを展開する
+/// @return 展開に成功したかどうか
+bool InflateHuffmanBlock(BitReader &reader, const HuffmanTable &literalTable, const HuffmanTable &distanceTable,
+    uint8_t *dst, size_t dstSize, size_t &outPosition) {
+    uint8_t *out = dst + outPosition;
+    uint8_t *const outEnd = dst + dstSize;
+
+    for (;;) {
+        const int symbol = reader.DecodeSymbol(literalTable);
+        if (symbol < 0) {
+            return false;
+        }
+        if (symbol < 256) {
+            if (out >= outEnd) {
+                return false;
+            }
+            *out++ = static_cast<uint8_t>(symbol);
+            continue;
+        }
+        if (symbol == 256) {
+            break;
+        }
+
+        const int lengthIndex = symbol - 257;
+        if (lengthIndex >= 29) {
+            return false;
+        }
+        const size_t length = kLengthBase[lengthIndex] + reader.Read(kLengthExtra[lengthIndex]);
+        const int distanceSymbol = reader.DecodeSymbol(distanceTable);
+        if (distanceSymbol < 0 || distanceSymbol >= 30) {
+            return false;
+        }
+        const size_t distance = kDistanceBase[distanceSymbol] + reader.Read(kDistanceExtra[distanceSymbol]);
+        if (distance > static_cast<size_t>(out - dst) || length > static_cast<size_t>(outEnd - out)) {
+            return false;
+        }
+
+        const uint8_t *from = out - distance;
+        if (distance >= 8 && static_cast<size_t>(outEnd - out) >= length + 8) {
+            // 8バイト単位でコピーする。はみ出した分は後で上書きされる
+            uint8_t *const copyEnd = out + length;
+            do {
+                uint64_t value;
+                std::memcpy(&value, from, sizeof(value));
+                std::memcpy(out, &value, sizeof(value));
+                out += 8;
+                from += 8;
+            } while (out < copyEnd);
+            out = copyEnd;
+        } else if (distance == 1) {
+            std::memset(out, *from, length);
+            out += length;
+        } else {
+            for (size_t i = 0; i < length; ++i) {
+                out[i] = from[i];
+            }
+            out += length;
+        }
+    }
+
+    outPosition = static_cast<size_t>(out - dst);
+    return true;
+}
+
+//==================================================
+// PNGのフィルタ解除
+//==================================================
+
+/// @brief Paeth予測子
+uint8_t PaethPredictor(int a, int b, int c) {
+    const int p = a + b - c;
+    const int pa = p > a ? p - a : a - p;
+    const int pb = p > b ? p - b : b - p;
+    const int pc = p > c ? p - c : c - p;
+    if (pa <= pb && pa <= pc) {
+        return static_cast<uint8_t>(a);
+    }
+    if (pb <= pc) {
+        return static_cast<uint8_t>(b);
+    }
+    return static_cast<uint8_t>(c);
+}
+
+void UnfilterSubScalar(uint8_t *row, size_t rowBytes, size_t bpp) {
+    for (size_t i = bpp; i < rowBytes; ++i) {
+        row[i] = static_cast<uint8_t>(row[i] + row[i - bpp]);
+    }
+}
+
+void UnfilterUpScalar(uint8_t *row, const uint8_t *prev, size_t rowBytes) {
+    for (size_t i = 0; i < rowBytes; ++i) {
+        row[i] = static_cast<uint8_t>(row[i] + prev[i]);
+    }
+}
+
+void UnfilterAverageScalar(uint8_t *row, const uint8_t *prev, size_t rowBytes, size_t bpp) {
+    for (size_t i = 0; i < bpp; ++i) {
+        row[i] = static_cast<uint8_t>(row[i] + (prev[i] >> 1));
+    }
+    for (size_t i = bpp; i < rowBytes; ++i) {
+        row[i] = static_cast<uint8_t>(row[i] + ((row[i - bpp] + prev[i]) >> 1));
+    }
+}
+
+void UnfilterPaethScalar(uint8_t *row, const uint8_t *prev, size_t rowBytes, size_t bpp) {
+    for (size_t i = 0; i < bpp; ++i) {
+        row[i] = static_cast<uint8_t>(row[i] + prev[i]);
+    }
+    for (size_t i = bpp; i < rowBytes; ++i) {
+        row[i] = static_cast<uint8_t>(row[i] + PaethPredictor(row[i - bpp], prev[i], prev[i - bpp]));
+    }
+}
+
+#ifdef KASHIPAN_IMAGE_DECODER_SSE2
+
+/// @brief 3バイトまたは4バイトのピクセルを読み込む
+template<size_t kBpp>
+__m128i LoadPixel(const uint8_t *p) {
+    int32_t value = 0;
+    std::memcpy(&value, p, kBpp);
+    return _mm_cvtsi32_si128(value);
+}
+
+/// @brief 3バイトまたは4バイトのピクセルを書き込む
+template<size_t kBpp>
+void StorePixel(uint8_t *p, __m128i v) {
+    const int32_t value = _mm_cvtsi128_si32(v);
+    std::memcpy(p, &value, kBpp);
+}
+
+void UnfilterUpSse2(uint8_t *row, const uint8_t *prev, size_t rowBytes) {
+    size_t i = 0;
+    for (; i + 16 <= rowBytes; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(prev + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(row + i), _mm_add_epi8(a, b));
+    }
+    UnfilterUpScalar(row + i, prev + i, rowBytes - i);
+}
+
+/// @brief 4バイトピクセルのSubフィルタ解除。16バイト内でプレフィックス和を取る
+void UnfilterSub4Sse2(uint8_t *row, size_t rowBytes) {
+    __m128i carry = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= rowBytes; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+        x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi8(x, carry);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(row + i), x);
+        // 最後のピクセルを全レーンに複製して次の16バイトへ持ち越す
+        carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    for (; i < rowBytes; i += 4) {
+        const __m128i x = _mm_add_epi8(LoadPixel<4>(row + i), carry);
+        StorePixel<4>(row + i, x);
+        carry = x;
+    }
+}
+
+template<size_t kBpp>
+void UnfilterSubSse2(uint8_t *row, size_t rowBytes) {
+    __m128i a = _mm_setzero_si128();
+    for (size_t i = 0; i < rowBytes; i += kBpp) {
+        a = _mm_add_epi8(a, LoadPixel<kBpp>(row + i));
+        StorePixel<kBpp>(row + i, a);
+    }
+}
+
+template<size_t kBpp>
+void UnfilterAverageSse2(uint8_t *row, const uint8_t *prev, size_t rowBytes) {
+    const __m128i one = _mm_set1_epi8(1);
+    __m128i a = _mm_setzero_si128();
+    for (size_t i = 0; i < rowBytes; i += kBpp) {
+        const __m128i b = LoadPixel<kBpp>(prev + i);
+        // avg_epu8は切り上げなので、奇数になる組み合わせだけ1引いて切り捨てにする
+        __m128i average = _mm_avg_epu8(a, b);
+        average = _mm_sub_epi8(average, _mm_and_si128(_mm_xor_si128(a, b), one));
+        a = _mm_add_epi8(LoadPixel<kBpp>(row + i), average);
+        StorePixel<kBpp>(row + i, a);
+    }
+}
+
+template<size_t kBpp>
+void UnfilterPaethSse2(uint8_t *row, const uint8_t *prev, size_t rowBytes) {
+    const __m128i zero = _mm_setzero_si128();
+    // 16bitに広げた左(a)、左上(c)のピクセル
+    __m128i a = zero;
+    __m128i c = zero;
+    for (size_t i = 0; i < rowBytes; i += kBpp) {
+        const __m128i b = _mm_unpacklo_epi8(LoadPixel<kBpp>(prev + i), zero);
+        __m128i d = _mm_unpacklo_epi8(LoadPixel<kBpp>(row + i), zero);
+
+        // p = a + b - cとしたときの |p - a| = |b - c|, |p - b| = |a - c|, |p - c| = |a + b - 2c|
+        __m128i pa = _mm_sub_epi16(b, c);
+        __m128i pb = _mm_sub_epi16(a, c);
+        __m128i pc = _mm_add_epi16(pa, pb);
+        pa = _mm_max_epi16(pa, _mm_sub_epi16(zero, pa));
+        pb = _mm_max_epi16(pb, _mm_sub_epi16(zero, pb));
+        pc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+        const __m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+
+        const __m128i useA = _mm_cmpeq_epi16(pa, smallest);
+        const __m128i useB = _mm_cmpeq_epi16(pb, smallest);
+        const __m128i bOrC = _mm_or_si128(_mm_and_si128(useB, b), _mm_andnot_si128(useB, c));
+        const __m128i nearest = _mm_or_si128(_mm_and_si128(useA, a), _mm_andnot_si128(useA, bOrC));
+
+        // 上位バイトは0同士なので、8bit加算で桁あふれが隣に漏れない
+        d = _mm_add_epi8(d, nearest);
+        StorePixel<kBpp>(row + i, _mm_packus_epi16(d, d));
+        a = d;
+        c = b;
+    }
+}
+
+#endif // KASHIPAN_IMAGE_DECODER_SSE2
+
+/// @brief 1行分のフィルタを解除する
+/// @param filterType フィルタの種類
+/// @param row フィルタ解除する行
+/// @param prev 1つ上の行(最初の行なら0埋めの行)
+/// @param rowBytes 行のバイト数
+/// @param bpp 1ピクセルあたりのバイト数(1未満なら1)
+/// @return 解除に成功したかどうか
+bool UnfilterRow(uint8_t filterType, uint8_t *row, const uint8_t *prev, size_t rowBytes, size_t bpp) {
+    switch (filterType) {
+        case 0:
+            return true;
+
+        case 1:
+#ifdef KASHIPAN_IMAGE_DECODER_SSE2
+            if (bpp == 4) {
+                UnfilterSub4Sse2(row, rowBytes);
+                return true;
+            }
+            if (bpp == 3) {
+                UnfilterSubSse2<3>(row, rowBytes);
+                return true;
+            }
+#endif
+            UnfilterSubScalar(row, rowBytes, bpp);
+            return true;
+
+        case 2:
+#ifdef KASHIPAN_IMAGE_DECODER_SSE2
+            UnfilterUpSse2(row, prev, rowBytes);
+#else
+            UnfilterUpScalar(row, prev, rowBytes);
+#endif
+            return true;
+
+        case 3:
+#ifdef KASHIPAN_IMAGE_DECODER_SSE2
+            if (bpp == 4) {
+                UnfilterAverageSse2<4>(row, prev, rowBytes);
+                return true;
+            }
+            if (bpp == 3) {
+                UnfilterAverageSse2<3>(row, prev, rowBytes);
+                return true;
+            }
+#endif
+            UnfilterAverageScalar(row, prev, rowBytes, bpp);
+            return true;
+
+        case 4:
+#ifdef KASHIPAN_IMAGE_DECODER_SSE2
+            if (bpp == 4) {
+                UnfilterPaethSse2<4>(row, prev, rowBytes);
+                return true;
+            }
+            if (bpp == 3) {
+                UnfilterPaethSse2<3>(row, prev, rowBytes);
+                return true;
+            }
+#endif
+            UnfilterPaethScalar(row, prev, rowBytes, bpp);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+//==================================================
+// ピクセル形式の変換
+//==================================================
+
+uint32_t ReadBigEndian32(const uint8_t *p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+        (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+uint32_t ReadLittleEndian32(const uint8_t *p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+        (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint16_t ReadLittleEndian16(const uint8_t *p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+/// @brief PNGのカラータイプ
+enum PngColorType {
+    kPngColorTypeGray = 0,
+    kPngColorTypeRGB = 2,
+    kPngColorTypePalette = 3,
+    kPngColorTypeGrayAlpha = 4,
+    kPngColorTypeRGBA = 6,
+};
+
+/// @brief PNGのヘッダー情報
+struct PngHeader {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint8_t bitDepth = 0;
+    uint8_t colorType = 0;
+    uint8_t interlace = 0;
+};
+
+/// @brief カラータイプごとのチャンネル数
+int GetPngChannelCount(uint8_t colorType) {
+    switch (colorType) {
+        case kPngColorTypeGray:         return 1;
+        case kPngColorTypeRGB:          return 3;
+        case kPngColorTypePalette:      return 1;
+        case kPngColorTypeGrayAlpha:    return 2;
+        case kPngColorTypeRGBA:         return 4;
+        default:                        return 0;
+    }
+}
+
+/// @brief 1ピクセル8bit未満の行から指定位置の値を取り出す
+uint8_t GetPackedSample(const uint8_t *row, uint32_t x, uint8_t bitDepth) {
+    const uint32_t bitOffset = x * bitDepth;
+    const uint8_t byte = row[bitOffset >> 3];
+    const uint32_t shift = 8 - bitDepth - (bitOffset & 7);
+    return static_cast<uint8_t>((byte >> shift) & ((1u << bitDepth) - 1));
+}
+
+/// @brief フィルタ解除済みの1行をRGBA8に変換する
+void ConvertPngRow(const PngHeader &header, const uint8_t *row, uint8_t *dst,
+    const uint8_t (*palette)[4], const uint8_t *transparentColor, bool hasTransparentColor) {
+    const uint32_t width = header.width;
+    switch (header.colorType) {
+        case kPngColorTypeRGBA:
+            std::memcpy(dst, row, static_cast<size_t>(width) * 4);
+            break;
+
+        case kPngColorTypeRGB:
+            for (uint32_t x = 0; x < width; ++x) {
+                const uint8_t *src = row + x * 3;
+                dst[x * 4 + 0] = src[0];
+                dst[x * 4 + 1] = src[1];
+                dst[x * 4 + 2] = src[2];
+                dst[x * 4 + 3] = 255;
+                if (hasTransparentColor &&
+                    src[0] == transparentColor[0] && src[1] == transparentColor[1] && src[2] == transparentColor[2]) {
+                    dst[x * 4 + 3] = 0;
+                }
+            }
+            break;
+
+        case kPngColorTypeGrayAlpha:
+            for (uint32_t x = 0; x < width; ++x) {
+                dst[x * 4 + 0] = row[x * 2];
+                dst[x * 4 + 1] = row[x * 2];
+                dst[x * 4 + 2] = row[x * 2];
+                dst[x * 4 + 3] = row[x * 2 + 1];
+            }
+            break;
+
+        case kPngColorTypeGray: {
+            // 8bit未満のグレースケールは0～255に引き伸ばす
+            static constexpr uint8_t kScale[9] = { 0, 255, 85, 0, 17, 0, 0, 0, 1 };
+            const uint8_t scale = kScale[header.bitDepth];
+            for (uint32_t x = 0; x < width; ++x) {
+                const uint8_t sample = header.bitDepth == 8 ? row[x] : GetPackedSample(row, x, header.bitDepth);
+                const uint8_t value = static_cast<uint8_t>(sample * scale);
+                dst[x * 4 + 0] = value;
+                dst[x * 4 + 1] = value;
+                dst[x * 4 + 2] = value;
+                dst[x * 4 + 3] = (hasTransparentColor && sample == transparentColor[0]) ? 0 : 255;
+            }
+            break;
+        }
+
+        case kPngColorTypePalette:
+            for (uint32_t x = 0; x < width; ++x) {
+                const uint8_t index = header.bitDepth == 8 ? row[x] : GetPackedSample(row, x, header.bitDepth);
+                std::memcpy(dst + x * 4, palette[index], 4);
+            }
+            break;
+    }
+}
+
+/// @brief BGR(A)の32bitピクセルをRGBAに並べ替える
+/// @param src BGRAの並び
+/// @param dst RGBAの出力先
+/// @param count ピクセル数
+/// @param useAlpha アルファを使うかどうか。使わない場合は255で埋める
+void SwizzleBgraToRgba(const uint8_t *src, uint8_t *dst, size_t count, bool useAlpha) {
+    size_t i = 0;
+#ifdef KASHIPAN_IMAGE_DECODER_SSE2
+    const __m128i maskG = _mm_set1_epi32(0x0000ff00);
+    const __m128i maskRB = _mm_set1_epi32(0x000000ff);
+    const __m128i maskA = _mm_set1_epi32(static_cast<int>(0xff000000));
+    for (; i + 4 <= count; i += 4) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+        const __m128i r = _mm_and_si128(_mm_srli_epi32(x, 16), maskRB);
+        const __m128i b = _mm_slli_epi32(_mm_and_si128(x, maskRB), 16);
+        const __m128i g = _mm_and_si128(x, maskG);
+        const __m128i a = useAlpha ? _mm_and_si128(x, maskA) : maskA;
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4),
+            _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a)));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i * 4 + 0] = src[i * 4 + 2];
+        dst[i * 4 + 1] = src[i * 4 + 1];
+        dst[i * 4 + 2] = src[i * 4 + 0];
+        dst[i * 4 + 3] = useAlpha ? src[i * 4 + 3] : 255;
+    }
+}
+
+/// @brief 画像サイズとして扱える範囲か
+bool IsValidImageSize(uint32_t width, uint32_t height) {
+    // 16384はD3D12のテクスチャの最大サイズ
+    return width > 0 && height > 0 && width <= 16384 && height <= 16384;
+}
+
+} // namespace
+
+bool InflateZlib(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize, size_t &writtenSize) {
+    writtenSize = 0;
+    if (src == nullptr || srcSize < 2) {
+        return false;
+    }
+    // zlibヘッダーの確認(Deflateで、ウィンドウサイズが32KB以下、プリセット辞書無し)
+    const uint8_t cmf = src[0];
+    const uint8_t flg = src[1];
+    if ((cmf & 0x0f) != 8 || (cmf >> 4) > 7 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20)) {
+        return false;
+    }
+
+    BitReader reader;
+    reader.data = src + 2;
+    reader.size = srcSize - 2;
+
+    HuffmanTable literalTable;
+    HuffmanTable distanceTable;
+    size_t outPosition = 0;
+    bool isFinal = false;
+    while (!isFinal) {
+        isFinal = reader.Read(1) != 0;
+        const uint32_t blockType = reader.Read(2);
+
+        if (blockType == 0) {
+            // 無圧縮ブロックはバイト境界に揃えてからコピーする
+            reader.Consume(reader.bitCount & 7);
+            const size_t bytePosition = reader.position - (reader.bitCount >> 3);
+            reader.bitBuffer = 0;
+            reader.bitCount = 0;
+            reader.position = bytePosition;
+            if (bytePosition + 4 > reader.size) {
+                return false;
+            }
+            const uint16_t length = ReadLittleEndian16(reader.data + bytePosition);
+            const uint16_t lengthComplement = ReadLittleEndian16(reader.data + bytePosition + 2);
+            if (static_cast<uint16_t>(~length) != lengthComplement) {
+                return false;
+            }
+            reader.position += 4;
+            if (reader.position + length > reader.size || outPosition + length > dstSize) {
+                return false;
+            }
+            std::memcpy(dst + outPosition, reader.data + reader.position, length);
+            reader.position += length;
+            outPosition += length;
+            continue;
+        }
+
+        if (blockType == 1) {
+            BuildFixedTables(literalTable, distanceTable);
+        } else if (blockType == 2) {
+            if (!ReadDynamicTables(reader, literalTable, distanceTable)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+
+        if (!InflateHuffmanBlock(reader, literalTable, distanceTable, dst, dstSize, outPosition)) {
+            return false;
+        }
+        if (!reader.IsValid()) {
+            return false;
+        }
+    }
+
+    writtenSize = outPosition;
+    return true;
+}
+
+bool DecodePng(const uint8_t *data, size_t size, DecodedImage &outImage) {
+    static constexpr uint8_t kSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    if (data == nullptr || size < 8 || std::memcmp(data, kSignature, 8) != 0) {
+        return false;
+    }
+
+    PngHeader header;
+    bool hasHeader = false;
+    uint8_t palette[256][4] = {};
+    uint32_t paletteCount = 0;
+    uint8_t transparentColor[3] = {};
+    bool hasTransparentColor = false;
+    std::vector<uint8_t> compressed;
+
+    // チャンクを順に読む。CRCは確認しない
+    size_t offset = 8;
+    bool isEnd = false;
+    while (!isEnd) {
+        if (offset + 12 > size) {
+            return false;
+        }
+        const uint32_t length = ReadBigEndian32(data + offset);
+        const uint8_t *type = data + offset + 4;
+        const uint8_t *chunk = data + offset + 8;
+        if (length > size - offset - 12) {
+            return false;
+        }
+
+        if (std::memcmp(type, "IHDR", 4) == 0) {
+            if (length < 13) {
+                return false;
+            }
+            header.width = ReadBigEndian32(chunk);
+            header.height = ReadBigEndian32(chunk + 4);
+            header.bitDepth = chunk[8];
+            header.colorType = chunk[9];
+            header.interlace = chunk[12];
+            hasHeader = true;
+
+        } else if (std::memcmp(type, "PLTE", 4) == 0) {
+            paletteCount = length / 3;
+            if (paletteCount > 256) {
+                return false;
+            }
+            for (uint32_t i = 0; i < paletteCount; ++i) {
+                palette[i][0] = chunk[i * 3 + 0];
+                palette[i][1] = chunk[i * 3 + 1];
+                palette[i][2] = chunk[i * 3 + 2];
+                palette[i][3] = 255;
+            }
+
+        } else if (std::memcmp(type, "tRNS", 4) == 0) {
+            if (header.colorType == kPngColorTypePalette) {
+                for (uint32_t i = 0; i < length && i < 256; ++i) {
+                    palette[i][3] = chunk[i];
+                }
+            } else if (header.colorType == kPngColorTypeGray && length >= 2) {
+                transparentColor[0] = chunk[1];
+                hasTransparentColor = true;
+            } else if (header.colorType == kPngColorTypeRGB && length >= 6) {
+                transparentColor[0] = chunk[1];
+                transparentColor[1] = chunk[3];
+                transparentColor[2] = chunk[5];
+                hasTransparentColor = true;
+            }
+
+        } else if (std::memcmp(type, "IDAT", 4) == 0) {
+            compressed.insert(compressed.end(), chunk, chunk + length);
+
+        } else if (std::memcmp(type, "IEND", 4) == 0) {
+            isEnd = true;
+        }
+
+        offset += static_cast<size_t>(length) + 12;
+    }
+
+    // 対応していない形式はfalseを返して呼び出し側に任せる
+    if (!hasHeader || !IsValidImageSize(header.width, header.height) || header.interlace != 0) {
+        return false;
+    }
+    const int channelCount = GetPngChannelCount(header.colorType);
+    if (channelCount == 0) {
+        return false;
+    }
+    const bool isPacked = header.colorType == kPngColorTypePalette || header.colorType == kPngColorTypeGray;
+    if (header.bitDepth != 8 && !(isPacked && (header.bitDepth == 1 || header.bitDepth == 2 || header.bitDepth == 4))) {
+        return false;
+    }
+    if (header.colorType == kPngColorTypePalette && paletteCount == 0) {
+        return false;
+    }
+
+    const size_t bitsPerPixel = static_cast<size_t>(channelCount) * header.bitDepth;
+    const size_t rowBytes = (static_cast<size_t>(header.width) * bitsPerPixel + 7) / 8;
+    const size_t bpp = bitsPerPixel < 8 ? 1 : bitsPerPixel / 8;
+    const size_t stride = rowBytes + 1;
+    const size_t rawSize = stride * header.height;
+
+    // 8バイト単位のコピーがはみ出せるように少し大きめに確保する
+    std::vector<uint8_t> raw(rawSize + 8);
+    size_t writtenSize = 0;
+    if (!InflateZlib(compressed.data(), compressed.size(), raw.data(), raw.size(), writtenSize) || writtenSize < rawSize) {
+        return false;
+    }
+
+    outImage.width = header.width;
+    outImage.height = header.height;
+    outImage.pixels.resize(static_cast<size_t>(header.width) * header.height * 4);
+
+    const std::vector<uint8_t> zeroRow(rowBytes, 0);
+    const uint8_t *prev = zeroRow.data();
+    for (uint32_t y = 0; y < header.height; ++y) {
+        uint8_t *line = raw.data() + stride * y;
+        uint8_t *row = line + 1;
+        if (!UnfilterRow(line[0], row, prev, rowBytes, bpp)) {
+            return false;
+        }
+        ConvertPngRow(header, row, outImage.pixels.data() + static_cast<size_t>(header.width) * 4 * y,
+            palette, transparentColor, hasTransparentColor);
+        prev = row;
+    }
+    return true;
+}
+
+bool DecodeBmp(const uint8_t *data, size_t size, DecodedImage &outImage) {
+    // BITMAPFILEHEADER(14バイト) + BITMAPINFOHEADER(40バイト以上)
+    if (data == nullptr || size < 54 || data[0] != 'B' || data[1] != 'M') {
+        return false;
+    }
+    const uint32_t pixelOffset = ReadLittleEndian32(data + 10);
+    const uint32_t infoSize = ReadLittleEndian32(data + 14);
+    if (infoSize < 40 || 14 + static_cast<size_t>(infoSize) > size) {
+        return false;
+    }
+    const int32_t width = static_cast<int32_t>(ReadLittleEndian32(data + 18));
+    const int32_t rawHeight = static_cast<int32_t>(ReadLittleEndian32(data + 22));
+    const uint16_t bitCount = ReadLittleEndian16(data + 28);
+    const uint32_t compression = ReadLittleEndian32(data + 30);
+
+    // 高さが負なら上から下に並んでいる
+    const bool isTopDown = rawHeight < 0;
+    const int64_t height = isTopDown ? -static_cast<int64_t>(rawHeight) : rawHeight;
+    if (width <= 0 || height <= 0 || !IsValidImageSize(static_cast<uint32_t>(width), static_cast<uint32_t>(height))) {
+        return false;
+    }
+    if (bitCount != 24 && bitCount != 32) {
+        return false;
+    }
+
+    // BI_RGB(0)、32bitのBI_BITFIELDS(3)のみ対応
+    bool useAlpha = false;
+    if (compression == 3) {
+        if (bitCount != 32) {
+            return false;
+        }
+        // V4以降のヘッダーならマスクはヘッダー内、40バイトのヘッダーなら直後に続く
+        const size_t maskOffset = 14 + 40;
+        if (maskOffset + 12 > size) {
+            return false;
+        }
+        const uint32_t maskR = ReadLittleEndian32(data + maskOffset);
+        const uint32_t maskG = ReadLittleEndian32(data + maskOffset + 4);
+        const uint32_t maskB = ReadLittleEndian32(data + maskOffset + 8);
+        if (maskR != 0x00ff0000 || maskG != 0x0000ff00 || maskB != 0x000000ff) {
+            return false;
+        }
+        if (infoSize >= 56) {
+            useAlpha = ReadLittleEndian32(data + maskOffset + 12) == 0xff000000;
+        }
+    } else if (compression != 0) {
+        return false;
+    }
+
+    const size_t pixelBytes = bitCount / 8;
+    const size_t srcStride = (static_cast<size_t>(width) * pixelBytes + 3) & ~size_t(3);
+    if (pixelOffset > size || srcStride * static_cast<size_t>(height) > size - pixelOffset) {
+        return false;
+    }
+
+    outImage.width = static_cast<uint32_t>(width);
+    outImage.height = static_cast<uint32_t>(height);
+    outImage.pixels.resize(static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+
+    for (int64_t y = 0; y < height; ++y) {
+        const int64_t srcY = isTopDown ? y : height - 1 - y;
+        const uint8_t *src = data + pixelOffset + srcStride * static_cast<size_t>(srcY);
+        uint8_t *dst = outImage.pixels.data() + static_cast<size_t>(width) * 4 * static_cast<size_t>(y);
+        if (bitCount == 32) {
+            SwizzleBgraToRgba(src, dst, static_cast<size_t>(width), useAlpha);
+        } else {
+            for (int32_t x = 0; x < width; ++x) {
+                dst[x * 4 + 0] = src[x * 3 + 2];
+                dst[x * 4 + 1] = src[x * 3 + 1];
+                dst[x * 4 + 2] = src[x * 3 + 0];
+                dst[x * 4 + 3] = 255;
+            }
+        }
+    }
+    return true;
+}
+
+bool Decode(const uint8_t *data, size_t size, DecodedImage &outImage) {
+    if (data == nullptr || size < 2) {
+        return false;
+    }
+    if (data[0] == 0x89 && data[1] == 'P') {
+        return DecodePng(data, size, outImage);
+    }
+    if (data[0] == 'B' && data[1] == 'M') {
+        return DecodeBmp(data, size, outImage);
+    }
+    return false;
+}
+
+bool LoadFromFile(const std::string &filePath, DecodedImage &outImage) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    const std::vector<uint8_t> fileData((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return Decode(fileData.data(), fileData.size(), outImage);
+}
+
+} // namespace ImageDecoder
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace KashipanEngine {
+
+/// @brief デコード済みの画像データ
+struct DecodedImage {
+    /// @brief 画像の幅
+    uint32_t width = 0;
+    /// @brief 画像の高さ
+    uint32_t height = 0;
+    /// @brief 上の行から並んだRGBA8のピクセルデータ(width * height * 4バイト)
+    std::vector<uint8_t> pixels;
+};
+
+/*
+WICに依存しない画像デコーダ。
+Windows以外の環境でも動くようにするため、DirectXやWindowsのヘッダーはここでは使わない。
+グローバルな状態を持たないので、別スレッドから同時に呼び出しても問題ない。
+*/
+
+namespace ImageDecoder {
+
+/// @brief zlib形式のデータを展開する
+/// @param src 圧縮データ(zlibヘッダー付き)
+/// @param srcSize 圧縮データのサイズ
+/// @param dst 展開先のバッファ
+/// @param dstSize 展開先のバッファのサイズ
+/// @param writtenSize 実際に展開されたサイズ
+/// @return 展開に成功したかどうか
+[[nodiscard]] bool InflateZlib(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize, size_t &writtenSize);
+
+/// @brief PNGをRGBA8にデコードする
+/// @param data PNGファイルのデータ
+/// @param size PNGファイルのサイズ
+/// @param outImage デコードした画像の出力先
+/// @return 対応している形式でデコードに成功したかどうか
+[[nodiscard]] bool DecodePng(const uint8_t *data, size_t size, DecodedImage &outImage);
+
+/// @brief BMPをRGBA8にデコードする
+/// @param data BMPファイルのデータ
+/// @param size BMPファイルのサイズ
+/// @param outImage デコードした画像の出力先
+/// @return 対応している形式でデコードに成功したかどうか
+[[nodiscard]] bool DecodeBmp(const uint8_t *data, size_t size, DecodedImage &outImage);
+
+/// @brief ファイルの先頭を見て形式を判別し、RGBA8にデコードする
+/// @param data ファイルのデータ
+/// @param size ファイルのサイズ
+/// @param outImage デコードした画像の出力先
+/// @return デコードに成功したかどうか
+[[nodiscard]] bool Decode(const uint8_t *data, size_t size, DecodedImage &outImage);
+
+/// @brief 画像ファイルを読み込んでRGBA8にデコードする
+/// @param filePath 画像ファイルのパス
+/// @param outImage デコードした画像の出力先
+/// @return デコードに成功したかどうか。未対応の形式ならfalse
+[[nodiscard]] bool LoadFromFile(const std::string &filePath, DecodedImage &outImage);
+
+} // namespace ImageDecoder
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "JobSystem.h"
+#include <cassert>
+
+namespace KashipanEngine {
+
+namespace {
+
+// ジョブが見つからなかったときに、眠る前にyieldしながら探し直す回数
+constexpr int kSpinCount = 64;
+
+// 今のスレッドがワーカーとして属するジョブシステムと、そのキューの番号
+thread_local const JobSystem *tCurrentJobSystem = nullptr;
+thread_local uint32_t tQueueIndex = 0;
+
+// 次に作るカウンタの番号
+std::atomic<uint64_t> sNextCounterId = 0;
+
+} // namespace
+
+JobSystem::Counter::Counter() noexcept : id_(sNextCounterId.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+JobSystem::JobSystem(uint32_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    queues_.resize(threadCount);
+    for (auto &queue : queues_) {
+        queue = std::make_unique<Queue>();
+    }
+    workers_.reserve(threadCount - 1);
+    for (uint32_t i = 1; i < threadCount; ++i) {
+        workers_.emplace_back(&JobSystem::WorkerMain, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    isStopping_.store(true);
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    sleepCondition_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+    assert(queuedJobCount_.load() == 0 && deferredJobCount_.load() == 0);
+}
+
+void JobSystem::Run(std::function<void()> function, Counter &counter, const Counter *dependency) {
+    counter.pending_.fetch_add(1, std::memory_order_relaxed);
+    Job job;
+    job.function = std::move(function);
+    job.counter = &counter;
+
+    if (dependency) {
+        // 先に待っている数を増やしてから依存先を調べる(Finishは逆の順番で調べるので、どちらかが必ず気付く)
+        std::lock_guard<std::mutex> lock(deferredMutex_);
+        deferredJobCount_.fetch_add(1);
+        if (dependency->pending_.load() != 0) {
+            deferredJobs_.push_back(DeferredJob{ dependency->id_, std::move(job) });
+            return;
+        }
+        deferredJobCount_.fetch_sub(1);
+    }
+    Push(std::move(job));
+}
+
+void JobSystem::Wait(const Counter &counter) {
+    while (!counter.IsDone()) {
+        if (!TryRunOne()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::Push(Job job) {
+    Queue &queue = *queues_[GetQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    queuedJobCount_.fetch_add(1);
+
+    // 眠っているワーカーがいれば起こす(ロックを取ってから起こすので、眠る直前のワーカーも取りこぼさない)
+    if (sleepingCount_.load() > 0) {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+        }
+        sleepCondition_.notify_one();
+    }
+}
+
+bool JobSystem::TryPop(Job &outJob) {
+    if (queuedJobCount_.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+
+    // 自分のキューは後ろから(最後に積んだ小さい範囲から)取り出す
+    const uint32_t index = GetQueueIndex();
+    {
+        Queue &queue = *queues_[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            outJob = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            queuedJobCount_.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // 他のスレッドのキューからは前から(古く大きい範囲から)盗む
+    const uint32_t queueCount = static_cast<uint32_t>(queues_.size());
+    for (uint32_t offset = 1; offset < queueCount; ++offset) {
+        Queue &queue = *queues_[(index + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            outJob = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            queuedJobCount_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::TryRunOne() {
+    Job job;
+    if (!TryPop(job)) {
+        return false;
+    }
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Execute(Job &job) {
+    if (job.rangeFunction) {
+        // grainSize以下になるまで後ろ半分を積み、前半分をこのスレッドで続ける
+        uint32_t end = job.end;
+        while (end - job.begin > job.grainSize) {
+            const uint32_t middle = job.begin + (end - job.begin) / 2;
+            Job rest = job;
+            rest.begin = middle;
+            rest.end = end;
+            // このジョブの分が残っているのでカウンタは0にならない
+            job.counter->pending_.fetch_add(1, std::memory_order_relaxed);
+            Push(std::move(rest));
+            end = middle;
+        }
+        job.rangeFunction(job.context, job.begin, end);
+    } else {
+        job.function();
+        job.function = nullptr;
+    }
+    Finish(*job.counter);
+}
+
+void JobSystem::Finish(Counter &counter) {
+    // 0になった後はカウンタに触らない(Waitから戻った側がすぐに破棄してもよいように)。
+    // 破棄された後に同じアドレスに作られた別のカウンタを待つジョブを積まないよう、待っているジョブは番号で探す
+    const uint64_t counterId = counter.id_;
+    if (counter.pending_.fetch_sub(1) != 1 || deferredJobCount_.load() == 0) {
+        return;
+    }
+
+    // このカウンタを待っていたジョブを積む
+    std::vector<Job> readyJobs;
+    {
+        std::lock_guard<std::mutex> lock(deferredMutex_);
+        for (size_t i = 0; i < deferredJobs_.size();) {
+            if (deferredJobs_[i].dependencyId == counterId) {
+                readyJobs.push_back(std::move(deferredJobs_[i].job));
+                deferredJobs_[i] = std::move(deferredJobs_.back());
+                deferredJobs_.pop_back();
+            } else {
+                ++i;
+            }
+        }
+        deferredJobCount_.fetch_sub(static_cast<uint32_t>(readyJobs.size()));
+    }
+    for (Job &job : readyJobs) {
+        Push(std::move(job));
+    }
+}
+
+void JobSystem::WorkerMain(uint32_t index) {
+    tCurrentJobSystem = this;
+    tQueueIndex = index;
+
+    while (!isStopping_.load()) {
+        bool isFound = false;
+        for (int i = 0; i < kSpinCount && !isFound; ++i) {
+            isFound = TryRunOne();
+            if (!isFound) {
+                std::this_thread::yield();
+            }
+        }
+        if (isFound) {
+            continue;
+        }
+
+        // 先に眠る数を増やしてから積まれたジョブを調べる(Pushは逆の順番で調べるので、どちらかが必ず気付く)
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepingCount_.fetch_add(1);
+        sleepCondition_.wait(lock, [this]() {
+            return isStopping_.load() || queuedJobCount_.load() > 0;
+        });
+        sleepingCount_.fetch_sub(1);
+    }
+}
+
+uint32_t JobSystem::GetQueueIndex() const noexcept {
+    return tCurrentJobSystem == this ? tQueueIndex : 0;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
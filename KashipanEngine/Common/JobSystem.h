@@ -0,0 +1,168 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace KashipanEngine {
+
+/*
+ワークスティーリングのジョブシステム。ループや処理をジョブに分けて、ワーカースレッドと呼び出し元のスレッドで実行する。
+  Run         : 関数を1つのジョブとして積む。依存するカウンタを渡すと、そのカウンタが0になってから実行される
+  ParallelFor : [begin, end)を範囲に分けて並列に実行し、全て終わるまで待つ
+  Wait        : カウンタが0になるまで、待っている間も積まれたジョブを実行する(メインスレッドも遊ばない)
+スレッドごとに両端キューを持ち、自分のキューは後ろから(最後に積んだものから)取り出し、空なら他のスレッドのキューの
+前から(古く大きいものから)盗む。ParallelForの範囲は実行する時に半分ずつに分けて後ろ半分を積むので、
+盗まれるのは分ける前の大きな範囲になり、盗む回数は範囲の数ではなくスレッドの数の程度で済む。
+ジョブの中からRun・ParallelFor・Waitを呼んでも良い(待つ間は他のジョブを実行するので、入れ子にしても止まらない)。
+ワーカーのスレッドの数はthreadCount - 1で、呼び出し元のスレッドはWaitとParallelForの間だけ実行に加わる。
+threadCountが1ならワーカーを作らず、全て呼び出し元のスレッドで実行する。
+*/
+
+/// @brief ワークスティーリングのジョブシステム
+class JobSystem {
+public:
+    /// @brief 終わっていないジョブの数を数えるカウンタ。Runで増え、ジョブが終わると減る
+    class Counter {
+    public:
+        Counter() noexcept;
+        Counter(const Counter &) = delete;
+        Counter &operator=(const Counter &) = delete;
+
+        /// @brief 全てのジョブが終わったか
+        [[nodiscard]] bool IsDone() const noexcept {
+            return pending_.load(std::memory_order_acquire) == 0;
+        }
+
+    private:
+        friend class JobSystem;
+        std::atomic<uint32_t> pending_ = 0;
+        // カウンタごとに違う番号(破棄された後に同じアドレスに作られたカウンタと区別する)
+        const uint64_t id_;
+    };
+
+    /// @brief コンストラクタ
+    /// @param threadCount 呼び出し元を含めたスレッドの数(0ならハードウェアのスレッドの数)
+    explicit JobSystem(uint32_t threadCount = 0);
+    /// @brief デストラクタ。ワーカーを止める(積まれたジョブは全て待ち終えていること)
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    /// @brief 呼び出し元を含めたスレッドの数を取得
+    [[nodiscard]] uint32_t GetThreadCount() const noexcept {
+        return static_cast<uint32_t>(queues_.size());
+    }
+
+    /// @brief 関数をジョブとして積む
+    /// @param function 実行する関数
+    /// @param counter ジョブが終わると減るカウンタ(ジョブが終わるまで破棄しないこと)
+    /// @param dependency このカウンタが0になってから実行する(nullptrならすぐに実行できる)
+    void Run(std::function<void()> function, Counter &counter, const Counter *dependency = nullptr);
+
+    /// @brief カウンタが0になるまで、積まれたジョブを実行しながら待つ
+    /// @param counter 待つカウンタ
+    void Wait(const Counter &counter);
+
+    /// @brief [begin, end)を範囲に分けて並列に実行し、全て終わるまで待つ
+    /// @param begin 最初の添字
+    /// @param end 最後の添字の次
+    /// @param grainSize 1つのジョブで実行する範囲の最大の大きさ(これより小さくは分けない)
+    /// @param function 範囲ごとに呼ぶ関数 void(uint32_t begin, uint32_t end)。複数のスレッドから同時に呼ばれる
+    template <class Function>
+    void ParallelFor(uint32_t begin, uint32_t end, uint32_t grainSize, const Function &function);
+
+private:
+    /// @brief ジョブ
+    struct Job {
+        // 範囲のジョブ(ParallelFor)の関数と、その関数へのポインタ
+        void (*rangeFunction)(const void *context, uint32_t begin, uint32_t end) = nullptr;
+        const void *context = nullptr;
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        uint32_t grainSize = 1;
+        // 範囲のジョブでない場合に実行する関数
+        std::function<void()> function;
+        // ジョブが終わると減るカウンタ
+        Counter *counter = nullptr;
+    };
+    /// @brief スレッドごとのジョブのキュー
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+    /// @brief 依存するカウンタが0になるのを待っているジョブ
+    struct DeferredJob {
+        // 依存するカウンタの番号(アドレスは破棄された後に別のカウンタで使われることがあるので使わない)
+        uint64_t dependencyId;
+        Job job;
+    };
+
+    /// @brief 今のスレッドのキューに積む
+    void Push(Job job);
+    /// @brief 自分のキューの後ろか、他のスレッドのキューの前からジョブを1つ取り出す
+    bool TryPop(Job &outJob);
+    /// @brief ジョブを1つ取り出せれば実行する
+    bool TryRunOne();
+    /// @brief ジョブを実行し、カウンタを減らす
+    void Execute(Job &job);
+    /// @brief カウンタを1つ減らし、0になれば待っていたジョブを積む
+    void Finish(Counter &counter);
+    /// @brief ワーカースレッドの処理
+    void WorkerMain(uint32_t index);
+    /// @brief 今のスレッドのキューの番号(このジョブシステムのワーカー以外は0)
+    uint32_t GetQueueIndex() const noexcept;
+
+    // スレッドごとのキュー(0は呼び出し元のスレッド、1以降がワーカー)
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    // 積まれていてまだ取り出されていないジョブの数
+    std::atomic<uint32_t> queuedJobCount_ = 0;
+
+    // 依存するカウンタを待っているジョブ
+    std::mutex deferredMutex_;
+    std::vector<DeferredJob> deferredJobs_;
+    std::atomic<uint32_t> deferredJobCount_ = 0;
+
+    // ジョブが無い間ワーカーを眠らせる
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+    std::atomic<uint32_t> sleepingCount_ = 0;
+    std::atomic<bool> isStopping_ = false;
+};
+
+template <class Function>
+void JobSystem::ParallelFor(uint32_t begin, uint32_t end, uint32_t grainSize, const Function &function) {
+    if (begin >= end) {
+        return;
+    }
+    grainSize = std::max(grainSize, 1u);
+    if (workers_.empty() || end - begin <= grainSize) {
+        function(begin, end);
+        return;
+    }
+
+    // 全体を1つのジョブとしてこのスレッドで実行し始める(実行しながら半分ずつ分けて積む)
+    Counter counter;
+    counter.pending_.store(1, std::memory_order_relaxed);
+    Job job;
+    job.rangeFunction = [](const void *context, uint32_t rangeBegin, uint32_t rangeEnd) {
+        (*static_cast<const Function *>(context))(rangeBegin, rangeEnd);
+    };
+    job.context = &function;
+    job.begin = begin;
+    job.end = end;
+    job.grainSize = grainSize;
+    job.counter = &counter;
+    Execute(job);
+    Wait(counter);
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
-#include "KashipanEngine.h"
 #include "KeyFrameAnimation.h"
 
 namespace KashipanEngine {
@@ -14,17 +14,17 @@ bool TimeCompare(const KeyFrame &a, const KeyFrame &b) {
 
 } // namespace
 
-void KeyFrameAnimation::Update() {
+void KeyFrameAnimation::Update(float deltaTime) {
     if (!isPlaying_ ||
         duration_ <= 0.0f ||
         keyFrameElements_.empty()) {
         return;
     }
 
-    currentTime_ += Engine::GetDeltaTime() * playSpeed_;
+    currentTime_ += deltaTime * playSpeed_;
     if (currentTime_ >= duration_) {
         if (isLoop_) {
-            currentTime_ = fmod(currentTime_, duration_);
+            currentTime_ = std::fmod(currentTime_, duration_);
         } else {
             isPlaying_ = false;
             currentTime_ = duration_;
@@ -86,7 +86,7 @@ void KeyFrameAnimation::SetCurrentTime(float time) {
         time = 0.0f;
     } else if (time > duration_) {
         if (isLoop_) {
-            time = fmod(time, duration_);
+            time = std::fmod(time, duration_);
         } else {
             time = duration_;
         }
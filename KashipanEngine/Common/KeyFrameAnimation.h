@@ -63,7 +63,9 @@ public:
         Reset();
     }
     
-    void Update();
+    /// @brief アニメーションを進める
+    /// @param deltaTime 経過時間(秒)。通常はEngine::GetDeltaTime()を渡す
+    void Update(float deltaTime);
 
     void AddKeyFrame(KeyFrameElementType type, const KeyFrame &keyFrame);
     void RemoveKeyFrame(KeyFrameElementType type, size_t index);
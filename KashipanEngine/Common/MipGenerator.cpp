@@ -0,0 +1,265 @@
+#include "MipGenerator.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define KASHIPAN_MIP_GENERATOR_SSE2
+#endif
+
+namespace KashipanEngine {
+
+namespace MipGenerator {
+
+namespace {
+
+/// @brief リニアからsRGBへの変換テーブルの分割数
+constexpr int kEncodeTableSize = 4096;
+
+/// @brief sRGBとリニアの変換テーブル
+struct SrgbTables {
+    /// @brief sRGBの値からリニアの値
+    std::array<float, 256> toLinear;
+    /// @brief sRGBの値ごとの、その値に丸められるリニアの下限
+    std::array<float, 257> threshold;
+    /// @brief リニアの値を分割した区間ごとの、sRGBの値の候補
+    std::array<uint8_t, kEncodeTableSize + 1> encode;
+};
+
+double SrgbToLinear(double value) {
+    return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+}
+
+const SrgbTables &GetSrgbTables() {
+    static const SrgbTables tables = [] {
+        SrgbTables result{};
+        for (int i = 0; i < 256; ++i) {
+            result.toLinear[i] = static_cast<float>(SrgbToLinear(i / 255.0));
+        }
+        result.threshold[0] = -1.0f;
+        for (int i = 1; i < 256; ++i) {
+            result.threshold[i] = static_cast<float>(SrgbToLinear((i - 0.5) / 255.0));
+        }
+        result.threshold[256] = 2.0f;
+        for (int i = 0; i <= kEncodeTableSize; ++i) {
+            const float linear = static_cast<float>(i) / kEncodeTableSize;
+            int code = 0;
+            while (code < 255 && linear >= result.threshold[code + 1]) {
+                ++code;
+            }
+            result.encode[i] = static_cast<uint8_t>(code);
+        }
+        return result;
+    }();
+    return tables;
+}
+
+/// @brief リニアの値をsRGBの8bitに変換する
+/// @param tables 変換テーブル
+/// @param linear 0～1に収めたリニアの値
+/// @param index linearをテーブルの区間に割り当てた位置
+uint8_t EncodeSrgb(const SrgbTables &tables, float linear, int index) {
+    // テーブルは区間の下端の値なので、しきい値を超えている分だけ繰り上げる
+    int code = tables.encode[index];
+    while (code < 255 && linear >= tables.threshold[code + 1]) {
+        ++code;
+    }
+    return static_cast<uint8_t>(code);
+}
+
+/// @brief 縮小時に1ピクセルが参照する元ピクセルと重み
+struct FilterTaps {
+    int first = 0;
+    int count = 0;
+    float weights[3] = {};
+};
+
+/// @brief 1次元の縮小に使うタップを計算する
+/// @param srcSize 元のサイズ
+/// @param dstSize 縮小後のサイズ
+/// @param index 縮小後の位置
+FilterTaps CalcTaps(uint32_t srcSize, uint32_t dstSize, uint32_t index) {
+    FilterTaps taps;
+    if (srcSize == dstSize) {
+        taps.first = static_cast<int>(index);
+        taps.count = 1;
+        taps.weights[0] = 1.0f;
+    } else if (srcSize == dstSize * 2) {
+        taps.first = static_cast<int>(index * 2);
+        taps.count = 2;
+        taps.weights[0] = 0.5f;
+        taps.weights[1] = 0.5f;
+    } else {
+        // 奇数サイズは元の2n+1ピクセルをn区間に均等に割り当てたときの重なり具合で重み付けする
+        const float scale = 1.0f / static_cast<float>(srcSize);
+        taps.first = static_cast<int>(index * 2);
+        taps.count = 3;
+        taps.weights[0] = static_cast<float>(dstSize - index) * scale;
+        taps.weights[1] = static_cast<float>(dstSize) * scale;
+        taps.weights[2] = static_cast<float>(index + 1) * scale;
+    }
+    return taps;
+}
+
+/// @brief sRGBのRGBA8をリニアのfloatに変換する
+void DecodeLevel(const DecodedImage &image, std::vector<float> &outLinear) {
+    const SrgbTables &tables = GetSrgbTables();
+    const int height = static_cast<int>(image.height);
+    const size_t rowSize = static_cast<size_t>(image.width) * 4;
+    outLinear.resize(rowSize * image.height);
+
+#pragma omp parallel for
+    for (int y = 0; y < height; ++y) {
+        const uint8_t *src = image.pixels.data() + rowSize * y;
+        float *dst = outLinear.data() + rowSize * y;
+        for (size_t i = 0; i < rowSize; i += 4) {
+            dst[i + 0] = tables.toLinear[src[i + 0]];
+            dst[i + 1] = tables.toLinear[src[i + 1]];
+            dst[i + 2] = tables.toLinear[src[i + 2]];
+            dst[i + 3] = src[i + 3] * (1.0f / 255.0f);
+        }
+    }
+}
+
+/// @brief リニアのfloatの1ピクセルをsRGBのRGBA8に変換する
+void EncodePixel(const SrgbTables &tables, const float *linear, uint8_t *dst) {
+#ifdef KASHIPAN_MIP_GENERATOR_SSE2
+    __m128 value = _mm_loadu_ps(linear);
+    value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    alignas(16) float clamped[4];
+    alignas(16) int32_t indices[4];
+    _mm_store_ps(clamped, value);
+    _mm_store_si128(reinterpret_cast<__m128i *>(indices),
+        _mm_cvttps_epi32(_mm_mul_ps(value, _mm_set1_ps(static_cast<float>(kEncodeTableSize)))));
+    dst[0] = EncodeSrgb(tables, clamped[0], indices[0]);
+    dst[1] = EncodeSrgb(tables, clamped[1], indices[1]);
+    dst[2] = EncodeSrgb(tables, clamped[2], indices[2]);
+    dst[3] = static_cast<uint8_t>(clamped[3] * 255.0f + 0.5f);
+#else
+    float clamped[4];
+    for (int i = 0; i < 4; ++i) {
+        clamped[i] = std::min(std::max(linear[i], 0.0f), 1.0f);
+    }
+    for (int i = 0; i < 3; ++i) {
+        dst[i] = EncodeSrgb(tables, clamped[i], static_cast<int>(clamped[i] * static_cast<float>(kEncodeTableSize)));
+    }
+    dst[3] = static_cast<uint8_t>(clamped[3] * 255.0f + 0.5f);
+#endif
+}
+
+/// @brief リニアのfloatの画像を1段階縮小する
+/// @param src 元のレベル
+/// @param srcWidth 元のレベルの幅
+/// @param srcHeight 元のレベルの高さ
+/// @param dstLinear 縮小したリニアの画像の出力先
+/// @param dstImage 縮小したsRGBの画像の出力先(サイズは設定済み)
+void DownsampleLevel(const std::vector<float> &src, uint32_t srcWidth, uint32_t srcHeight,
+    std::vector<float> &dstLinear, DecodedImage &dstImage) {
+    const SrgbTables &tables = GetSrgbTables();
+    const uint32_t dstWidth = dstImage.width;
+    const int dstHeight = static_cast<int>(dstImage.height);
+    const size_t srcRowSize = static_cast<size_t>(srcWidth) * 4;
+    const size_t dstRowSize = static_cast<size_t>(dstWidth) * 4;
+    dstLinear.resize(dstRowSize * dstImage.height);
+
+    // 横方向のタップはどの行でも同じなので先に計算しておく
+    std::vector<FilterTaps> horizontalTaps(dstWidth);
+    for (uint32_t x = 0; x < dstWidth; ++x) {
+        horizontalTaps[x] = CalcTaps(srcWidth, dstWidth, x);
+    }
+
+#pragma omp parallel for
+    for (int y = 0; y < dstHeight; ++y) {
+        const FilterTaps verticalTaps = CalcTaps(srcHeight, static_cast<uint32_t>(dstHeight), static_cast<uint32_t>(y));
+        float *dstRow = dstLinear.data() + dstRowSize * y;
+        uint8_t *dstPixels = dstImage.pixels.data() + dstRowSize * y;
+
+        for (uint32_t x = 0; x < dstWidth; ++x) {
+            const FilterTaps &taps = horizontalTaps[x];
+            float *dstPixel = dstRow + static_cast<size_t>(x) * 4;
+#ifdef KASHIPAN_MIP_GENERATOR_SSE2
+            __m128 sum = _mm_setzero_ps();
+            for (int ty = 0; ty < verticalTaps.count; ++ty) {
+                const float *srcRow = src.data() + srcRowSize * (verticalTaps.first + ty);
+                __m128 rowSum = _mm_setzero_ps();
+                for (int tx = 0; tx < taps.count; ++tx) {
+                    const __m128 pixel = _mm_loadu_ps(srcRow + static_cast<size_t>(taps.first + tx) * 4);
+                    rowSum = _mm_add_ps(rowSum, _mm_mul_ps(pixel, _mm_set1_ps(taps.weights[tx])));
+                }
+                sum = _mm_add_ps(sum, _mm_mul_ps(rowSum, _mm_set1_ps(verticalTaps.weights[ty])));
+            }
+            _mm_storeu_ps(dstPixel, sum);
+#else
+            float sum[4] = {};
+            for (int ty = 0; ty < verticalTaps.count; ++ty) {
+                const float *srcRow = src.data() + srcRowSize * (verticalTaps.first + ty);
+                float rowSum[4] = {};
+                for (int tx = 0; tx < taps.count; ++tx) {
+                    const float *pixel = srcRow + static_cast<size_t>(taps.first + tx) * 4;
+                    for (int c = 0; c < 4; ++c) {
+                        rowSum[c] += pixel[c] * taps.weights[tx];
+                    }
+                }
+                for (int c = 0; c < 4; ++c) {
+                    sum[c] += rowSum[c] * verticalTaps.weights[ty];
+                }
+            }
+            for (int c = 0; c < 4; ++c) {
+                dstPixel[c] = sum[c];
+            }
+#endif
+            EncodePixel(tables, dstPixel, dstPixels + static_cast<size_t>(x) * 4);
+        }
+    }
+}
+
+} // namespace
+
+uint32_t CalcMipLevels(uint32_t width, uint32_t height) {
+    uint32_t size = std::max(width, height);
+    uint32_t levels = 1;
+    while (size > 1) {
+        size >>= 1;
+        ++levels;
+    }
+    return levels;
+}
+
+bool Generate(const DecodedImage &baseImage, std::vector<DecodedImage> &outMipLevels, uint32_t mipLevels) {
+    outMipLevels.clear();
+    if (baseImage.width == 0 || baseImage.height == 0 ||
+        baseImage.pixels.size() != static_cast<size_t>(baseImage.width) * baseImage.height * 4) {
+        return false;
+    }
+    const uint32_t maxLevels = CalcMipLevels(baseImage.width, baseImage.height);
+    if (mipLevels == 0 || mipLevels > maxLevels) {
+        mipLevels = maxLevels;
+    }
+    if (mipLevels <= 1) {
+        return true;
+    }
+    outMipLevels.resize(mipLevels - 1);
+
+    std::vector<float> srcLinear;
+    std::vector<float> dstLinear;
+    DecodeLevel(baseImage, srcLinear);
+
+    uint32_t srcWidth = baseImage.width;
+    uint32_t srcHeight = baseImage.height;
+    for (auto &level : outMipLevels) {
+        level.width = std::max(srcWidth / 2, 1u);
+        level.height = std::max(srcHeight / 2, 1u);
+        level.pixels.resize(static_cast<size_t>(level.width) * level.height * 4);
+        DownsampleLevel(srcLinear, srcWidth, srcHeight, dstLinear, level);
+
+        srcLinear.swap(dstLinear);
+        srcWidth = level.width;
+        srcHeight = level.height;
+    }
+    return true;
+}
+
+} // namespace MipGenerator
+
+} // namespace KashipanEngine
\ No newline at end of file
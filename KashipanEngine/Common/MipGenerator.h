@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Common/ImageDecoder.h"
+
+namespace KashipanEngine {
+
+/*
+sRGBのRGBA8画像からミップマップを生成する。
+フィルタはリニア空間でのボックスフィルタで、奇数サイズのレベルは3タップの重み付きボックスで縮小する。
+1つ前のレベルをリニアのfloatで保持したまま次のレベルを作るので、sRGBへの変換誤差は積み重ならない。
+各レベルの行はOpenMPで並列に処理する。
+*/
+
+namespace MipGenerator {
+
+/// @brief 1x1まで縮小したときのミップマップのレベル数を計算する
+/// @param width 元画像の幅
+/// @param height 元画像の高さ
+/// @return 元画像を含めたレベル数
+[[nodiscard]] uint32_t CalcMipLevels(uint32_t width, uint32_t height);
+
+/// @brief ミップマップを生成する
+/// @param baseImage 元画像(sRGBのRGBA8)
+/// @param outMipLevels 生成したレベル1以降の画像の出力先(元画像は含まない)
+/// @param mipLevels 元画像を含めたレベル数。0なら1x1まで生成する
+/// @return 生成に成功したかどうか
+[[nodiscard]] bool Generate(const DecodedImage &baseImage, std::vector<DecodedImage> &outMipLevels, uint32_t mipLevels = 0);
+
+} // namespace MipGenerator
+
+} // namespace KashipanEngine
\ No newline at end of file
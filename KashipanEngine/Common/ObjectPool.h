@@ -0,0 +1,133 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace KashipanEngine {
+
+/*
+同じ型のオブジェクトを使い回すプール。弾や敵のように頻繁に出たり消えたりするものを、毎回作って破棄する代わりに使い回す。
+オブジェクトが持つリソース(モデルのメッシュ・マテリアル・ワールド変換のバッファなど)も一緒に使い回されるので、
+一番多かった時の数まで作り終えた後は、新しいリソースを作らない。
+  WarmUp  : 指定した数になるまで先に作っておく(ゲーム中に作らずに済むように)
+  Acquire : 空いているオブジェクトを取り出す(無ければ作る)。中身は前に使った時のままなので、取り出した側で初期化する
+  Handle  : 取り出したオブジェクトを持つunique_ptr。破棄するとオブジェクトは破棄されずにプールに戻る
+プールに戻す時に呼ぶ関数を渡すと、衝突判定の登録の解除など、使っていない間に残したくない状態を片付けられる。
+オブジェクトは全てプールが持つので、Handleは全てプールより先に破棄すること。
+*/
+
+/// @brief 同じ型のオブジェクトを使い回すプール
+template<class T>
+class ObjectPool {
+public:
+    /// @brief Handleが破棄された時に、オブジェクトをプールに戻す
+    class Releaser {
+    public:
+        Releaser() noexcept = default;
+        explicit Releaser(ObjectPool *pool) noexcept : pool_(pool) {}
+        void operator()(T *object) const {
+            pool_->Release(object);
+        }
+
+    private:
+        ObjectPool *pool_ = nullptr;
+    };
+
+    /// @brief 取り出したオブジェクト。破棄するとプールに戻る
+    using Handle = std::unique_ptr<T, Releaser>;
+    /// @brief オブジェクトを作る関数
+    using Factory = std::function<std::unique_ptr<T>()>;
+    /// @brief オブジェクトをプールに戻す時に呼ぶ関数
+    using ReleaseCallback = std::function<void(T &)>;
+
+    /// @brief コンストラクタ
+    /// @param factory オブジェクトを作る関数
+    /// @param onRelease オブジェクトをプールに戻す時に呼ぶ関数(nullptrなら何もしない)
+    explicit ObjectPool(Factory factory, ReleaseCallback onRelease = nullptr) :
+        factory_(std::move(factory)), onRelease_(std::move(onRelease)) {
+    }
+    ~ObjectPool() {
+        assert(activeCount_ == 0 && "ObjectPool destroyed while handles are still alive");
+    }
+
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    /// @brief 作ったオブジェクトの数がcountになるまで作っておく
+    /// @param count 作っておく数
+    void WarmUp(size_t count) {
+        while (objects_.size() < count) {
+            freeObjects_.push_back(Create());
+        }
+    }
+
+    /// @brief 空いているオブジェクトを取り出す(無ければ作る)
+    /// @return 取り出したオブジェクト(前に使った時の状態のまま)
+    [[nodiscard]] Handle Acquire() {
+        T *object;
+        if (freeObjects_.empty()) {
+            object = Create();
+            ++grownCount_;
+        } else {
+            object = freeObjects_.back();
+            freeObjects_.pop_back();
+        }
+        ++activeCount_;
+        highWaterMark_ = std::max(highWaterMark_, activeCount_);
+        return Handle(object, Releaser(this));
+    }
+
+    /// @brief 作ったオブジェクトの数を取得
+    [[nodiscard]] size_t GetCreatedCount() const noexcept {
+        return objects_.size();
+    }
+    /// @brief 取り出されているオブジェクトの数を取得
+    [[nodiscard]] size_t GetActiveCount() const noexcept {
+        return activeCount_;
+    }
+    /// @brief 空いているオブジェクトの数を取得
+    [[nodiscard]] size_t GetFreeCount() const noexcept {
+        return freeObjects_.size();
+    }
+    /// @brief 同時に取り出されていたオブジェクトの数の最大を取得
+    [[nodiscard]] size_t GetHighWaterMark() const noexcept {
+        return highWaterMark_;
+    }
+    /// @brief 空きが無かったためにAcquireの中で作った数を取得(WarmUpの数が足りていれば0のまま)
+    [[nodiscard]] size_t GetGrownCount() const noexcept {
+        return grownCount_;
+    }
+
+private:
+    /// @brief オブジェクトを作る。空きの配列は作った数まで先に確保しておき、戻す時に確保しないようにする
+    T *Create() {
+        objects_.push_back(factory_());
+        freeObjects_.reserve(objects_.size());
+        return objects_.back().get();
+    }
+
+    /// @brief オブジェクトをプールに戻す
+    void Release(T *object) {
+        assert(activeCount_ > 0);
+        if (onRelease_) {
+            onRelease_(*object);
+        }
+        freeObjects_.push_back(object);
+        --activeCount_;
+    }
+
+    Factory factory_;
+    ReleaseCallback onRelease_;
+    // 作った全てのオブジェクトと、その中で空いているもの
+    std::vector<std::unique_ptr<T>> objects_;
+    std::vector<T *> freeObjects_;
+
+    size_t activeCount_ = 0;
+    size_t highWaterMark_ = 0;
+    size_t grownCount_ = 0;
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
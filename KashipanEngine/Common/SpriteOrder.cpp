@@ -0,0 +1,73 @@
+#include <algorithm>
+#include "SpriteOrder.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+/// @brief 同じ描画にまとめられるかどうか
+bool IsSameRun(const SpriteSortKey &a, const SpriteSortKey &b) {
+    return a.layer == b.layer &&
+        a.blendMode == b.blendMode &&
+        a.textureIndex == b.textureIndex &&
+        a.enableLighting == b.enableLighting &&
+        a.color.x == b.color.x && a.color.y == b.color.y &&
+        a.color.z == b.color.z && a.color.w == b.color.w;
+}
+
+/// @brief テクスチャでまとめる時の順番(レイヤー、ブレンドモード、テクスチャ、色の順)
+bool IsDrawnBefore(const SpriteSortKey &lhs, const SpriteSortKey &rhs) {
+    if (lhs.layer != rhs.layer) return lhs.layer < rhs.layer;
+    if (lhs.blendMode != rhs.blendMode) return lhs.blendMode < rhs.blendMode;
+    if (lhs.textureIndex != rhs.textureIndex) return lhs.textureIndex < rhs.textureIndex;
+    if (lhs.enableLighting != rhs.enableLighting) return lhs.enableLighting < rhs.enableLighting;
+    if (lhs.color.x != rhs.color.x) return lhs.color.x < rhs.color.x;
+    if (lhs.color.y != rhs.color.y) return lhs.color.y < rhs.color.y;
+    if (lhs.color.z != rhs.color.z) return lhs.color.z < rhs.color.z;
+    return lhs.color.w < rhs.color.w;
+}
+
+} // namespace
+
+void SpriteOrder::Build(std::span<const SpriteSortKey> keys, std::span<const uint32_t> breaks, SpriteSortMode mode,
+    std::vector<uint32_t> &outOrder, std::vector<SpriteRange> &outRanges) {
+    const uint32_t count = static_cast<uint32_t>(keys.size());
+    outOrder.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        outOrder[i] = i;
+    }
+    outRanges.clear();
+
+    // 区切りごとに並べ替える。どちらの並べ方でも、同じ条件のものは追加した順番を保つ
+    size_t nextBreak = 0;
+    uint32_t begin = 0;
+    while (begin < count) {
+        while (nextBreak < breaks.size() && breaks[nextBreak] <= begin) {
+            ++nextBreak;
+        }
+        const uint32_t end = nextBreak < breaks.size() ? std::min(breaks[nextBreak], count) : count;
+        const auto first = outOrder.begin() + begin;
+        const auto last = outOrder.begin() + end;
+        if (mode == SpriteSortMode::kTexture) {
+            std::stable_sort(first, last, [&keys](uint32_t a, uint32_t b) {
+                return IsDrawnBefore(keys[a], keys[b]);
+                });
+        } else {
+            std::stable_sort(first, last, [&keys](uint32_t a, uint32_t b) {
+                return keys[a].layer < keys[b].layer;
+                });
+        }
+
+        // 条件が変わったら新しい範囲を始める
+        for (uint32_t i = begin; i < end; ++i) {
+            if (i > begin && IsSameRun(keys[outOrder[i - 1]], keys[outOrder[i]])) {
+                ++outRanges.back().count;
+            } else {
+                outRanges.push_back(SpriteRange{ i, 1 });
+            }
+        }
+        begin = end;
+    }
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
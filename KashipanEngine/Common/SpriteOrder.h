@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Math/Vector4.h"
+
+namespace KashipanEngine {
+
+/// @brief スプライトの並べ方
+enum class SpriteSortMode {
+    /// @brief 追加した順番のまま描く(レイヤーが違うものだけ並べ替える)。続けて追加された同じ条件のスプライトだけをまとめる
+    kSubmissionOrder,
+    /// @brief レイヤーの中でブレンドモード・テクスチャ・色の順に並べ替えて描画の数を減らす。
+    /// 同じレイヤーで重なるスプライトの前後が変わってもよい場合だけ使う
+    kTexture,
+};
+
+/// @brief 並べ替えと、まとめて描けるかの判定に使うスプライトの情報
+struct SpriteSortKey {
+    /// @brief 描画順のレイヤー。小さいほど先に描画する
+    int layer = 0;
+    /// @brief ブレンドモード
+    int blendMode = 0;
+    /// @brief テクスチャのインデックス
+    int textureIndex = -1;
+    /// @brief Lightingの有効無効
+    bool enableLighting = false;
+    /// @brief 色
+    Vector4 color = { 255.0f, 255.0f, 255.0f, 255.0f };
+};
+
+/// @brief 1回の描画でまとめて描くスプライトの範囲(並べ替えた後の位置)
+struct SpriteRange {
+    /// @brief 最初のスプライトの位置
+    uint32_t first = 0;
+    /// @brief スプライトの数
+    uint32_t count = 0;
+};
+
+/*
+スプライトを描く順番と、1回の描画にまとめる範囲を決める(SpriteBatchのGPUに依存しない部分)。
+区切りはスプライトの間に別の2Dオブジェクトを描く位置などで、区切りをまたいで並べ替えたりまとめたりはしない。
+*/
+
+namespace SpriteOrder {
+
+/// @brief 描く順番とまとめて描く範囲を決める
+/// @param keys 追加した順のスプライトの情報
+/// @param breaks 区切りの位置(その添字のスプライトから新しい区切りになる。昇順)
+/// @param mode 並べ方
+/// @param outOrder 描く順に並べたスプライトの添字の出力先(中身は置き換えられる)
+/// @param outRanges まとめて描く範囲の出力先(中身は置き換えられる)
+void Build(std::span<const SpriteSortKey> keys, std::span<const uint32_t> breaks, SpriteSortMode mode,
+    std::vector<uint32_t> &outOrder, std::vector<SpriteRange> &outRanges);
+
+} // namespace SpriteOrder
+
+} // namespace KashipanEngine
\ No newline at end of file
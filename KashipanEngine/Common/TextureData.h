@@ -2,6 +2,7 @@
 #include <d3d12.h>
 #include <wrl.h>
 #include <string>
+#include "Math/Vector2.h"
 
 namespace KashipanEngine {
 
@@ -22,6 +23,10 @@ struct TextureData {
     uint32_t width;
     /// @brief テクスチャの高さ
     uint32_t height;
+    /// @brief アトラス内でのUVの左上。アトラスでなければ(0, 0)
+    Vector2 uvOffset = { 0.0f, 0.0f };
+    /// @brief アトラス内でのUVの大きさ。アトラスでなければ(1, 1)
+    Vector2 uvScale = { 1.0f, 1.0f };
 };
 
 } // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "TextureResidency.h"
+#include <algorithm>
+
+namespace KashipanEngine {
+
+void TextureResidency::SetBudget(uint64_t budgetBytes, uint32_t minIdleFrames) {
+    budgetBytes_ = budgetBytes;
+    minIdleFrames_ = minIdleFrames;
+}
+
+void TextureResidency::Register(uint32_t id, uint64_t sizeInBytes, bool isPinned) {
+    if (id >= entries_.size()) {
+        entries_.resize(static_cast<size_t>(id) + 1);
+    }
+    Entry &entry = entries_[id];
+    if (entry.isResident) {
+        residentBytes_ -= entry.sizeInBytes;
+    }
+    entry.sizeInBytes = sizeInBytes;
+    entry.lastUsedFrame = frame_;
+    entry.isRegistered = true;
+    entry.isResident = true;
+    entry.isPinned = isPinned;
+    entry.isReloadRequested = false;
+    residentBytes_ += sizeInBytes;
+}
+
+bool TextureResidency::Touch(uint32_t id) {
+    if (id >= entries_.size() || !entries_[id].isRegistered) {
+        return false;
+    }
+    Entry &entry = entries_[id];
+    entry.lastUsedFrame = frame_;
+    if (entry.isResident) {
+        return false;
+    }
+    // 同じフレームに何度使われても要求は1回だけにする
+    if (!entry.isReloadRequested) {
+        entry.isReloadRequested = true;
+        reloadRequests_.push_back(id);
+    }
+    return true;
+}
+
+void TextureResidency::TakeReloadRequests(std::vector<uint32_t> &outReloadIds) {
+    outReloadIds.clear();
+    outReloadIds.swap(reloadRequests_);
+}
+
+void TextureResidency::MarkResident(uint32_t id) {
+    if (id >= entries_.size() || !entries_[id].isRegistered || entries_[id].isResident) {
+        return;
+    }
+    entries_[id].isResident = true;
+    entries_[id].isReloadRequested = false;
+    residentBytes_ += entries_[id].sizeInBytes;
+}
+
+void TextureResidency::EndFrame(std::vector<uint32_t> &outEvictedIds) {
+    outEvictedIds.clear();
+    ++frame_;
+    if (budgetBytes_ == 0 || residentBytes_ <= budgetBytes_) {
+        return;
+    }
+
+    // しばらく使われていない常駐テクスチャを候補にする
+    candidates_.clear();
+    for (uint32_t id = 0; id < entries_.size(); ++id) {
+        const Entry &entry = entries_[id];
+        if (entry.isResident && !entry.isPinned &&
+            entry.lastUsedFrame + minIdleFrames_ < frame_) {
+            candidates_.push_back(id);
+        }
+    }
+
+    // 最後に使われたのが古い順に、予算に収まるまで追い出す
+    std::sort(candidates_.begin(), candidates_.end(), [this](uint32_t a, uint32_t b) {
+        if (entries_[a].lastUsedFrame != entries_[b].lastUsedFrame) {
+            return entries_[a].lastUsedFrame < entries_[b].lastUsedFrame;
+        }
+        return a < b;
+    });
+    for (uint32_t id : candidates_) {
+        if (residentBytes_ <= budgetBytes_) {
+            break;
+        }
+        entries_[id].isResident = false;
+        residentBytes_ -= entries_[id].sizeInBytes;
+        outEvictedIds.push_back(id);
+    }
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace KashipanEngine {
+
+/*
+テクスチャのGPUメモリの予算を管理し、最後に使われたフレームが古いものから追い出す(LRU)。
+GPUには触らず、どれを追い出すか・読み込み直す必要があるかだけを判断するので、GPU無しでも動かせる。
+追い出しはフレームの終わり(GPUが待機済み)で行い、直近minIdleFramesフレームに使われたものは追い出さない。
+追い出されたものが使われたら読み込み直しの要求として溜めておき、描画の途中ではなく次のフレームの始めにまとめて読み込み直す。
+*/
+
+/// @brief テクスチャのメモリ予算とLRUでの追い出しの管理
+class TextureResidency {
+public:
+    /// @brief 予算を設定する
+    /// @param budgetBytes GPUメモリの予算(バイト)。0なら無制限
+    /// @param minIdleFrames 追い出すまでに最低限使われていないフレーム数
+    void SetBudget(uint64_t budgetBytes, uint32_t minIdleFrames);
+
+    /// @brief テクスチャを登録する。登録直後は常駐している扱い
+    /// @param id テクスチャのID
+    /// @param sizeInBytes GPU上のサイズ(バイト)
+    /// @param isPinned 追い出さないかどうか
+    void Register(uint32_t id, uint64_t sizeInBytes, bool isPinned);
+
+    /// @brief 使用したことを記録する。追い出されていれば読み込み直しを要求する
+    /// @param id テクスチャのID
+    /// @return 追い出されていて今は使えないかどうか
+    [[nodiscard]] bool Touch(uint32_t id);
+
+    /// @brief 溜まっている読み込み直しの要求を取り出す。フレームの始めに呼ぶ
+    /// @param outReloadIds 読み込み直すテクスチャのIDの出力先(要求された順)
+    void TakeReloadRequests(std::vector<uint32_t> &outReloadIds);
+
+    /// @brief 読み込み直して常駐に戻ったことを記録する
+    /// @param id テクスチャのID
+    void MarkResident(uint32_t id);
+
+    /// @brief フレームを進め、予算を超えていれば追い出すテクスチャを選ぶ
+    /// @param outEvictedIds 追い出したテクスチャのIDの出力先
+    void EndFrame(std::vector<uint32_t> &outEvictedIds);
+
+    /// @brief 常駐しているテクスチャの合計サイズの取得
+    /// @return 合計サイズ(バイト)
+    uint64_t GetResidentBytes() const { return residentBytes_; }
+
+    /// @brief 予算の取得
+    /// @return 予算(バイト)。0なら無制限
+    uint64_t GetBudget() const { return budgetBytes_; }
+
+    /// @brief 現在のフレームの取得
+    /// @return フレーム番号
+    uint64_t GetFrame() const { return frame_; }
+
+    /// @brief 常駐しているかどうか
+    /// @param id テクスチャのID
+    /// @return 常駐しているかどうか
+    bool IsResident(uint32_t id) const {
+        return id < entries_.size() && entries_[id].isResident;
+    }
+
+private:
+    /// @brief テクスチャごとの情報
+    struct Entry {
+        /// @brief GPU上のサイズ
+        uint64_t sizeInBytes = 0;
+        /// @brief 最後に使われたフレーム
+        uint64_t lastUsedFrame = 0;
+        /// @brief 登録されているかどうか
+        bool isRegistered = false;
+        /// @brief 常駐しているかどうか
+        bool isResident = false;
+        /// @brief 追い出さないかどうか
+        bool isPinned = false;
+        /// @brief 読み込み直しを要求済みかどうか
+        bool isReloadRequested = false;
+    };
+
+    /// @brief IDごとの情報
+    std::vector<Entry> entries_;
+    /// @brief 追い出し候補の作業用
+    std::vector<uint32_t> candidates_;
+    /// @brief 読み込み直しを要求されたテクスチャ
+    std::vector<uint32_t> reloadRequests_;
+    /// @brief 常駐しているテクスチャの合計サイズ
+    uint64_t residentBytes_ = 0;
+    /// @brief 予算。0なら無制限
+    uint64_t budgetBytes_ = 0;
+    /// @brief 追い出すまでに最低限使われていないフレーム数
+    uint32_t minIdleFrames_ = 0;
+    /// @brief 現在のフレーム
+    uint64_t frame_ = 0;
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <cstring>
+
+#include "VertexShadow.h"
+
+namespace KashipanEngine {
+
+void VertexShadow::Create(uint32_t vertexCount) {
+    vertices_.assign(vertexCount, VertexData{});
+    isDirty_ = true;
+    isNormalValid_ = false;
+}
+
+bool VertexShadow::UpdateNormals(bool enableLighting, NormalType normalType, const Vector3 &unlitNormal) {
+    // 設定が変わっていなければ法線も変わらない
+    if (isNormalValid_ &&
+        normalEnableLighting_ == enableLighting &&
+        normalType_ == normalType) {
+        return false;
+    }
+    normalEnableLighting_ = enableLighting;
+    normalType_ = normalType;
+    isNormalValid_ = true;
+    isDirty_ = true;
+
+    if (enableLighting == false) {
+        for (auto &vertex : vertices_) {
+            vertex.normal = unlitNormal;
+        }
+    } else if (normalType == kNormalTypeVertex) {
+        for (auto &vertex : vertices_) {
+            vertex.normal = Vector3(vertex.position);
+        }
+    } else if (normalType == kNormalTypeFace && vertices_.size() >= 3) {
+        const Vector3 position[3] = {
+            Vector3(vertices_[0].position),
+            Vector3(vertices_[1].position),
+            Vector3(vertices_[2].position),
+        };
+        const Vector3 normal = (position[1] - position[0]).Cross(position[2] - position[1]).Normalize();
+        for (auto &vertex : vertices_) {
+            vertex.normal = normal;
+        }
+    }
+    return true;
+}
+
+bool VertexShadow::Transfer(VertexData *vertexBufferMap) {
+    if (!isDirty_ || vertices_.empty()) {
+        return false;
+    }
+    // マップ先は読まずに、先頭から順番にまとめて書き込む
+    std::memcpy(vertexBufferMap, vertices_.data(), sizeof(VertexData) * vertices_.size());
+    isDirty_ = false;
+    ++sTransferCount;
+    return true;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Common/VertexData.h"
+
+namespace KashipanEngine {
+
+/*
+頂点データのCPU側の控え。頂点バッファは書き込み結合メモリなので、読み出しや部分的な書き換えは控えに対して行い、
+変更があったときだけTransferで頂点バッファにまとめて転送する。
+法線はライティングの有効無効と法線のタイプから計算し、設定が前回から変わっていなければ計算も転送もしない。
+GPUには触らず、転送先のポインタを受け取るだけなので、GPU無しでも動かせる。
+*/
+
+enum NormalType {
+    kNormalTypeVertex,
+    kNormalTypeFace,
+};
+
+/// @brief 頂点データのCPU側の控え
+class VertexShadow {
+public:
+    /// @brief 控えを作成する。作成直後は転送が必要な状態になる
+    /// @param vertexCount 頂点数
+    void Create(uint32_t vertexCount);
+
+    /// @brief 頂点を編集する。編集したものとして次のTransferで転送する
+    /// @return 控えの頂点データ
+    [[nodiscard]] std::vector<VertexData> &Edit() {
+        isDirty_ = true;
+        return vertices_;
+    }
+
+    /// @brief 控えの頂点データの取得
+    /// @return 控えの頂点データ
+    [[nodiscard]] const std::vector<VertexData> &GetVertices() const {
+        return vertices_;
+    }
+
+    /// @brief 法線をライティングと法線のタイプに合わせて計算する。設定が前回から変わっていなければ何もしない
+    /// @param enableLighting ライティングが有効かどうか
+    /// @param normalType 法線のタイプ
+    /// @param unlitNormal ライティングが無効なときの法線
+    /// @return 法線を計算し直したかどうか
+    bool UpdateNormals(bool enableLighting, NormalType normalType, const Vector3 &unlitNormal);
+
+    /// @brief 変更されていれば頂点バッファに転送する
+    /// @param vertexBufferMap 頂点バッファのマップ先
+    /// @return 転送したかどうか
+    bool Transfer(VertexData *vertexBufferMap);
+
+    /// @brief 転送が必要かどうか
+    /// @return 前回の転送から変更されているかどうか
+    [[nodiscard]] bool IsDirty() const {
+        return isDirty_;
+    }
+
+    /// @brief 頂点バッファへの転送回数の取得
+    /// @return 前回のリセットからの転送回数
+    [[nodiscard]] static uint32_t GetTransferCount() {
+        return sTransferCount;
+    }
+
+    /// @brief 頂点バッファへの転送回数をリセットする
+    static void ResetTransferCount() {
+        sTransferCount = 0;
+    }
+
+private:
+    /// @brief 控えの頂点データ
+    std::vector<VertexData> vertices_;
+    /// @brief 転送後に変更されたかどうか
+    bool isDirty_ = false;
+    /// @brief 法線を計算したときのライティングの有効無効
+    bool normalEnableLighting_ = false;
+    /// @brief 法線を計算したときの法線のタイプ
+    NormalType normalType_ = kNormalTypeVertex;
+    /// @brief 法線を計算済みかどうか
+    bool isNormalValid_ = false;
+
+    /// @brief 頂点バッファへの転送回数
+    static inline uint32_t sTransferCount = 0;
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "Common/ConvertColor.h"
 #include "Common/Logs.h"
 #include "Common/GridLine.h"
+#include "Common/JobSystem.h"
 #include "Common/Descriptors/RTV.h"
 #include "Common/Descriptors/SRV.h"
 #include "Common/Descriptors/DSV.h"
@@ -51,6 +52,7 @@ std::unique_ptr<WinApp> sWinApp;
 std::unique_ptr<DirectXCommon> sDxCommon;
 std::unique_ptr<ImGuiManager> sImGuiManager;
 std::unique_ptr<Renderer> sRenderer;
+std::unique_ptr<JobSystem> sJobSystem;
 
 // フレーム時間計算用変数
 int sFrameRate = 60;
@@ -80,6 +82,9 @@ Engine::Engine(const char *title, int width, int height, bool enableDebugLayer,
     // 誰も捕捉しなかった場合に(Unhandled)、捕捉する関数を登録
     SetUnhandledExceptionFilter(ExportDump);
 
+    // ジョブシステム初期化(ハードウェアのスレッドの数だけ使う)
+    sJobSystem = std::make_unique<JobSystem>();
+
     // タイトル名がそのままだと使えないので変換
     std::wstring wTitle = ConvertString(title);
     // Windowsアプリ初期化
@@ -138,6 +143,7 @@ Engine::~Engine() {
     DSV::Finalize();
     SRV::Finalize();
     CoUninitialize();
+    sJobSystem.reset();
     // 終了処理完了のログを出力
     Log("Engine Finalized.");
     LogInsertPartition("\n============= Engine Finalize Finish =============\n");
@@ -215,6 +221,10 @@ KashipanEngine::Renderer *Engine::GetRenderer() const {
     return sRenderer.get();
 }
 
+KashipanEngine::JobSystem *Engine::GetJobSystem() const {
+    return sJobSystem.get();
+}
+
 int Engine::ProccessMessage() {
     return sWinApp->ProccessMessage();
 }
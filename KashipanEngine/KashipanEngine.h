@@ -14,6 +14,7 @@ namespace KashipanEngine {
 class WinApp;
 class DirectXCommon;
 class Renderer;
+class JobSystem;
 
 } // namespace KashipanEngine
 
@@ -58,6 +59,10 @@ public:
     /// @return レンダラーへのポインタ
     KashipanEngine::Renderer *GetRenderer() const;
 
+    /// @brief ジョブシステムのポインタ取得
+    /// @return ジョブシステムへのポインタ
+    KashipanEngine::JobSystem *GetJobSystem() const;
+
     /// @brief メッセージ処理
     /// @return メッセージ処理結果。-1の場合は終了
     int ProccessMessage();
@@ -79,6 +79,10 @@ public:
     /// @return 平行移動行列の逆行列
     [[nodiscard]] Matrix4x4 InverseTranslate() const noexcept;
 
+    /// @brief ワールド行列の逆行列を計算する
+    /// @return ワールド行列の逆行列
+    [[nodiscard]] Matrix4x4 InverseWorld() const noexcept;
+
     /// @brief 拡大縮小行列を取得する
     /// @return 拡大縮小行列
     [[nodiscard]] const Matrix4x4 &GetScaleMatrix() const noexcept {
@@ -110,4 +114,163 @@ private:
     Matrix4x4 worldMatrix;
 };
 
+inline AffineMatrix::AffineMatrix(const Matrix4x4 &scale, const Matrix4x4 &rotate, const Matrix4x4 &translate) noexcept {
+    scaleMatrix = scale;
+    rotateMatrix = rotate;
+    translateMatrix = translate;
+    worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+}
+
+inline AffineMatrix::AffineMatrix(const Vector3 &scale, const Vector3 &rotate, const Vector3 &translate) noexcept {
+    scaleMatrix.MakeScale(scale);
+    rotateMatrix.MakeRotate(rotate);
+    translateMatrix.MakeTranslate(translate);
+    // ワールド行列は掛け算せずに回転行列の各行を拡大縮小して組み立てる
+    for (int i = 0; i < 3; ++i) {
+        const float s = (i == 0) ? scale.x : (i == 1) ? scale.y : scale.z;
+        worldMatrix.m[i][0] = rotateMatrix.m[i][0] * s;
+        worldMatrix.m[i][1] = rotateMatrix.m[i][1] * s;
+        worldMatrix.m[i][2] = rotateMatrix.m[i][2] * s;
+        worldMatrix.m[i][3] = 0.0f;
+    }
+    worldMatrix.m[3][0] = translate.x;
+    worldMatrix.m[3][1] = translate.y;
+    worldMatrix.m[3][2] = translate.z;
+    worldMatrix.m[3][3] = 1.0f;
+}
+
+inline AffineMatrix::AffineMatrix(const AffineMatrix &affine) noexcept {
+    scaleMatrix = affine.GetScaleMatrix();
+    rotateMatrix = affine.rotateMatrix;
+    translateMatrix = affine.translateMatrix;
+    worldMatrix = affine.worldMatrix;
+}
+
+inline AffineMatrix &AffineMatrix::operator=(const AffineMatrix &affine) noexcept {
+    scaleMatrix = affine.scaleMatrix;
+    rotateMatrix = affine.rotateMatrix;
+    translateMatrix = affine.translateMatrix;
+    worldMatrix = affine.worldMatrix;
+    return *this;
+}
+
+inline AffineMatrix &AffineMatrix::operator*=(const AffineMatrix &affine) noexcept {
+    scaleMatrix *= affine.scaleMatrix;
+    rotateMatrix *= affine.rotateMatrix;
+    translateMatrix *= affine.translateMatrix;
+    worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+    return *this;
+}
+
+inline AffineMatrix &AffineMatrix::operator*=(const Matrix4x4 &mat) noexcept {
+    scaleMatrix *= mat;
+    rotateMatrix *= mat;
+    translateMatrix *= mat;
+    worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+    return *this;
+}
+
+inline void AffineMatrix::SetSRT(const Vector3 &scale, const Vector3 &rotate, const Vector3 &translate) {
+    scaleMatrix.MakeScale(scale);
+    rotateMatrix.MakeRotate(rotate);
+    translateMatrix.MakeTranslate(translate);
+    // ワールド行列は掛け算せずに回転行列の各行を拡大縮小して組み立てる
+    for (int i = 0; i < 3; ++i) {
+        const float s = (i == 0) ? scale.x : (i == 1) ? scale.y : scale.z;
+        worldMatrix.m[i][0] = rotateMatrix.m[i][0] * s;
+        worldMatrix.m[i][1] = rotateMatrix.m[i][1] * s;
+        worldMatrix.m[i][2] = rotateMatrix.m[i][2] * s;
+        worldMatrix.m[i][3] = 0.0f;
+    }
+    worldMatrix.m[3][0] = translate.x;
+    worldMatrix.m[3][1] = translate.y;
+    worldMatrix.m[3][2] = translate.z;
+    worldMatrix.m[3][3] = 1.0f;
+}
+
+inline void AffineMatrix::SetScale(const Vector3 &scale) noexcept {
+    scaleMatrix.MakeScale(scale);
+    worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+}
+
+inline void AffineMatrix::SetScale(const Matrix4x4 &scale) noexcept {
+    scaleMatrix = scale;
+    worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+}
+
+inline void AffineMatrix::SetScale(float scaleX, float scaleY, float scaleZ) noexcept {
+    scaleMatrix.MakeScale({ scaleX, scaleY, scaleZ });
+    worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+}
+
+inline void AffineMatrix::SetScale(float scale) noexcept {
+    scaleMatrix.MakeScale({ scale, scale, scale });
+    worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+}
+
+inline void AffineMatrix::SetRotate(const Vector3 &rotate) noexcept {
+    rotateMatrix.MakeRotate(rotate);
+    worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+}
+
+inline void AffineMatrix::SetRotate(const Matrix4x4 &rotate) noexcept {
+    rotateMatrix = rotate;
+    worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+}
+
+inline void AffineMatrix::SetRotate(float radianX, float radianY, float radianZ) noexcept {
+    rotateMatrix.MakeRotate(radianX, radianY, radianZ);
+    worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+}
+
+inline void AffineMatrix::SetTranslate(const Vector3 &translate) noexcept {
+    translateMatrix.MakeTranslate(translate);
+    worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+}
+
+inline void AffineMatrix::SetTranslate(const Matrix4x4 &translate) noexcept {
+    translateMatrix = translate;
+    worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+}
+
+inline void AffineMatrix::SetTranslate(float translateX, float translateY, float translateZ) noexcept {
+    translateMatrix.MakeTranslate({ translateX, translateY, translateZ });
+    worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+}
+
+inline Matrix4x4 AffineMatrix::InverseScale() const noexcept {
+    return Matrix4x4(
+        1.0f / scaleMatrix.m[0][0], 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f / scaleMatrix.m[1][1], 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f / scaleMatrix.m[2][2], 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    );
+}
+
+inline Matrix4x4 AffineMatrix::InverseRotate() const noexcept {
+    return Matrix4x4(
+        rotateMatrix.m[0][0], rotateMatrix.m[1][0], rotateMatrix.m[2][0], 0.0f,
+        rotateMatrix.m[0][1], rotateMatrix.m[1][1], rotateMatrix.m[2][1], 0.0f,
+        rotateMatrix.m[0][2], rotateMatrix.m[1][2], rotateMatrix.m[2][2], 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    );
+}
+
+inline Matrix4x4 AffineMatrix::InverseTranslate() const noexcept {
+    return Matrix4x4(
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        -translateMatrix.m[3][0], -translateMatrix.m[3][1], -translateMatrix.m[3][2], 1.0f
+    );
+}
+
+inline Matrix4x4 AffineMatrix::InverseWorld() const noexcept {
+    // 拡大縮小が無ければ回転の転置で済む
+    if (scaleMatrix.m[0][0] == 1.0f && scaleMatrix.m[1][1] == 1.0f && scaleMatrix.m[2][2] == 1.0f) {
+        return worldMatrix.InverseRigid();
+    }
+    return worldMatrix.InverseAffine();
+}
+
 } // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,368 @@
+#include "Broadphase.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numeric>
+
+namespace KashipanEngine {
+
+namespace Math {
+
+namespace {
+
+// セルの座標の範囲(21ビットずつキーに詰める)
+constexpr int32_t kCellLimit = 1 << 20;
+// セルの一辺の最小値(半径が全て0の場合に使う)
+constexpr float kMinCellSize = 1.0e-4f;
+// 挿入ソートで許容する移動回数(要素数に対する倍率)。超えたら並びが崩れたとみなしてstd::sortで並べ直す
+constexpr size_t kInsertionSortBudget = 8;
+
+/// @brief 座標をセルの座標にする(範囲外やNaNは端のセルにまとめる)
+int32_t ToCell(float value, float inverseCellSize) noexcept {
+    float cell = std::floor(value * inverseCellSize);
+    if (!(cell >= static_cast<float>(-kCellLimit))) {
+        cell = static_cast<float>(-kCellLimit);
+    } else if (cell > static_cast<float>(kCellLimit - 1)) {
+        cell = static_cast<float>(kCellLimit - 1);
+    }
+    return static_cast<int32_t>(cell);
+}
+
+/// @brief セルの座標をキーにする
+uint64_t MakeCellKey(int32_t x, int32_t y, int32_t z) noexcept {
+    return (static_cast<uint64_t>(x + kCellLimit) << 42) |
+        (static_cast<uint64_t>(y + kCellLimit) << 21) |
+        static_cast<uint64_t>(z + kCellLimit);
+}
+
+/// @brief キーからバケットを求める
+uint32_t GetBucket(uint64_t key, int bucketBits) noexcept {
+    return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> (64 - bucketBits));
+}
+
+/// @brief 2つの球の境界ボックスが重なっているか
+bool IsOverlapBounds(const SphereSoA &spheresA, uint32_t a, const SphereSoA &spheresB, uint32_t b) noexcept {
+    const float radiusA = spheresA.radius[a];
+    const float radiusB = spheresB.radius[b];
+    return spheresA.centerX[a] - radiusA <= spheresB.centerX[b] + radiusB &&
+        spheresB.centerX[b] - radiusB <= spheresA.centerX[a] + radiusA &&
+        spheresA.centerY[a] - radiusA <= spheresB.centerY[b] + radiusB &&
+        spheresB.centerY[b] - radiusB <= spheresA.centerY[a] + radiusA &&
+        spheresA.centerZ[a] - radiusA <= spheresB.centerZ[b] + radiusB &&
+        spheresB.centerZ[b] - radiusB <= spheresA.centerZ[a] + radiusA;
+}
+
+/// @brief 2つの区間の残りの軸が重なっているか
+template <class Interval>
+bool IsOverlapOtherAxes(const Interval &a, const Interval &b) noexcept {
+    return a.otherMin[0] <= b.otherMax[0] && b.otherMin[0] <= a.otherMax[0] &&
+        a.otherMin[1] <= b.otherMax[1] && b.otherMin[1] <= a.otherMax[1];
+}
+
+} // namespace
+
+//==================================================
+// HashGridBroadphase
+//==================================================
+
+void HashGridBroadphase::FindPairs(const SphereSoA &spheres, std::vector<CollisionPair> &outPairs) {
+    outPairs.clear();
+    if (spheres.Size() < 2) {
+        return;
+    }
+    Insert(spheres, GetInverseCellSize(spheres.radius, {}));
+
+    // 同じセルに登録された組を調べる
+    const size_t bucketCount = size_t{ 1 } << bucketBits_;
+    for (size_t bucket = 0; bucket < bucketCount; ++bucket) {
+        const uint32_t begin = bucketStarts_[bucket];
+        const uint32_t end = bucketStarts_[bucket + 1];
+        for (uint32_t a = begin; a + 1 < end; ++a) {
+            const Entry &entryA = sortedEntries_[a];
+            const Cell cell{
+                static_cast<int32_t>((entryA.key >> 42) & 0x1FFFFF) - kCellLimit,
+                static_cast<int32_t>((entryA.key >> 21) & 0x1FFFFF) - kCellLimit,
+                static_cast<int32_t>(entryA.key & 0x1FFFFF) - kCellLimit
+            };
+            const Cell &minCellA = minCells_[entryA.index];
+            for (uint32_t b = a + 1; b < end; ++b) {
+                const Entry &entryB = sortedEntries_[b];
+                if (entryB.key != entryA.key) {
+                    continue;
+                }
+                // 複数のセルで重なる組は、両者の最小側のセルのうち大きい方のセルでだけ出力する
+                const Cell &minCellB = minCells_[entryB.index];
+                if (std::max(minCellA.x, minCellB.x) != cell.x ||
+                    std::max(minCellA.y, minCellB.y) != cell.y ||
+                    std::max(minCellA.z, minCellB.z) != cell.z) {
+                    continue;
+                }
+                if (IsOverlapBounds(spheres, entryA.index, spheres, entryB.index)) {
+                    outPairs.push_back(CollisionPair{ entryA.index, entryB.index });
+                }
+            }
+        }
+    }
+}
+
+void HashGridBroadphase::FindPairs(const SphereSoA &spheresA, const SphereSoA &spheresB, std::vector<CollisionPair> &outPairs) {
+    outPairs.clear();
+    const size_t countA = spheresA.Size();
+    if (countA == 0 || spheresB.Size() == 0) {
+        return;
+    }
+    // Bをグリッドに登録し、Aの球が重なるセルを調べる
+    const float inverseCellSize = GetInverseCellSize(spheresA.radius, spheresB.radius);
+    Insert(spheresB, inverseCellSize);
+
+    for (uint32_t a = 0; a < countA; ++a) {
+        const float radius = spheresA.radius[a];
+        const Cell minCellA{
+            ToCell(spheresA.centerX[a] - radius, inverseCellSize),
+            ToCell(spheresA.centerY[a] - radius, inverseCellSize),
+            ToCell(spheresA.centerZ[a] - radius, inverseCellSize)
+        };
+        const Cell maxCellA{
+            ToCell(spheresA.centerX[a] + radius, inverseCellSize),
+            ToCell(spheresA.centerY[a] + radius, inverseCellSize),
+            ToCell(spheresA.centerZ[a] + radius, inverseCellSize)
+        };
+        for (int32_t x = minCellA.x; x <= maxCellA.x; ++x) {
+            for (int32_t y = minCellA.y; y <= maxCellA.y; ++y) {
+                for (int32_t z = minCellA.z; z <= maxCellA.z; ++z) {
+                    const uint64_t key = MakeCellKey(x, y, z);
+                    const uint32_t bucket = GetBucket(key, bucketBits_);
+                    for (uint32_t b = bucketStarts_[bucket]; b < bucketStarts_[bucket + 1]; ++b) {
+                        const Entry &entryB = sortedEntries_[b];
+                        if (entryB.key != key) {
+                            continue;
+                        }
+                        // 1つの配列の場合と同じく、最小側のセルのうち大きい方のセルでだけ出力する
+                        const Cell &minCellB = minCells_[entryB.index];
+                        if (std::max(minCellA.x, minCellB.x) != x ||
+                            std::max(minCellA.y, minCellB.y) != y ||
+                            std::max(minCellA.z, minCellB.z) != z) {
+                            continue;
+                        }
+                        if (IsOverlapBounds(spheresA, a, spheresB, entryB.index)) {
+                            outPairs.push_back(CollisionPair{ a, entryB.index });
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+float HashGridBroadphase::GetInverseCellSize(std::span<const float> radiusA, std::span<const float> radiusB) const noexcept {
+    // セルの大きさを決める(最大の球の直径の2倍。どの球もどの軸も2セルまでにしか跨らず、登録数が少なく済む)
+    float cellSize = cellSize_;
+    if (cellSize <= 0.0f) {
+        float maxRadius = 0.0f;
+        for (const float radius : radiusA) {
+            maxRadius = std::max(maxRadius, radius);
+        }
+        for (const float radius : radiusB) {
+            maxRadius = std::max(maxRadius, radius);
+        }
+        cellSize = std::max(maxRadius * 4.0f, kMinCellSize);
+    }
+    return 1.0f / cellSize;
+}
+
+void HashGridBroadphase::Insert(const SphereSoA &spheres, float inverseCellSize) {
+    // 球の境界ボックスが重なるセル全てに登録する(添字の小さい順に登録される)
+    const size_t count = spheres.Size();
+    minCells_.resize(count);
+    entries_.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        const float radius = spheres.radius[i];
+        const Cell minCell{
+            ToCell(spheres.centerX[i] - radius, inverseCellSize),
+            ToCell(spheres.centerY[i] - radius, inverseCellSize),
+            ToCell(spheres.centerZ[i] - radius, inverseCellSize)
+        };
+        const Cell maxCell{
+            ToCell(spheres.centerX[i] + radius, inverseCellSize),
+            ToCell(spheres.centerY[i] + radius, inverseCellSize),
+            ToCell(spheres.centerZ[i] + radius, inverseCellSize)
+        };
+        minCells_[i] = minCell;
+        for (int32_t x = minCell.x; x <= maxCell.x; ++x) {
+            for (int32_t y = minCell.y; y <= maxCell.y; ++y) {
+                for (int32_t z = minCell.z; z <= maxCell.z; ++z) {
+                    entries_.push_back(Entry{ MakeCellKey(x, y, z), i });
+                }
+            }
+        }
+    }
+
+    // バケットごとに並べ替える(計数ソートなので同じバケット内は添字の小さい順のまま)
+    bucketBits_ = std::max(1, static_cast<int>(std::bit_width(entries_.size() * 2 - 1)));
+    const size_t bucketCount = size_t{ 1 } << bucketBits_;
+    bucketStarts_.assign(bucketCount + 1, 0);
+    for (const auto &entry : entries_) {
+        ++bucketStarts_[GetBucket(entry.key, bucketBits_) + 1];
+    }
+    for (size_t bucket = 0; bucket < bucketCount; ++bucket) {
+        bucketStarts_[bucket + 1] += bucketStarts_[bucket];
+    }
+    sortedEntries_.resize(entries_.size());
+    for (const auto &entry : entries_) {
+        sortedEntries_[bucketStarts_[GetBucket(entry.key, bucketBits_)]++] = entry;
+    }
+    // 書き込みで進めた開始位置を戻す
+    for (size_t bucket = bucketCount; bucket > 0; --bucket) {
+        bucketStarts_[bucket] = bucketStarts_[bucket - 1];
+    }
+    bucketStarts_[0] = 0;
+}
+
+//==================================================
+// SweepAndPruneBroadphase
+//==================================================
+
+void SweepAndPruneBroadphase::FindPairs(const SphereSoA &spheres, std::vector<CollisionPair> &outPairs) {
+    outPairs.clear();
+    const size_t count = spheres.Size();
+    if (count < 2) {
+        return;
+    }
+
+    // 物体の数と軸が前フレームと同じなら、前フレームの並びから始める
+    const int axis = SelectAxis(spheres, nullptr);
+    sortedA_.Build(spheres, axis, axis == axis_ && sortedA_.GetCount() == count);
+    axis_ = axis;
+
+    // 区間の最小値の順に見ていき、区間が重なる間だけ残りの軸を調べる
+    const std::vector<Interval> &intervals = sortedA_.GetIntervals();
+    for (size_t i = 0; i < count; ++i) {
+        const Interval &intervalA = intervals[i];
+        for (size_t j = i + 1; j < count && intervals[j].min <= intervalA.max; ++j) {
+            const Interval &intervalB = intervals[j];
+            if (IsOverlapOtherAxes(intervalA, intervalB)) {
+                outPairs.push_back(CollisionPair{
+                    std::min(intervalA.index, intervalB.index), std::max(intervalA.index, intervalB.index) });
+            }
+        }
+    }
+}
+
+void SweepAndPruneBroadphase::FindPairs(const SphereSoA &spheresA, const SphereSoA &spheresB, std::vector<CollisionPair> &outPairs) {
+    outPairs.clear();
+    const size_t countA = spheresA.Size();
+    const size_t countB = spheresB.Size();
+    if (countA == 0 || countB == 0) {
+        return;
+    }
+
+    const int axis = SelectAxis(spheresA, &spheresB);
+    sortedA_.Build(spheresA, axis, axis == axis_ && sortedA_.GetCount() == countA);
+    sortedB_.Build(spheresB, axis, axis == axis_ && sortedB_.GetCount() == countB);
+    axis_ = axis;
+
+    // 2つの並びを最小値の順にまとめて見ていき、相手側の並びだけを調べる(同じ配列の中の組は調べない)
+    const std::vector<Interval> &intervalsA = sortedA_.GetIntervals();
+    const std::vector<Interval> &intervalsB = sortedB_.GetIntervals();
+    size_t a = 0;
+    size_t b = 0;
+    while (a < countA && b < countB) {
+        // 最小値が同じときはAを先に処理する(Bの側からはそのAを見ないので重複しない)
+        if (intervalsA[a].min <= intervalsB[b].min) {
+            const Interval &interval = intervalsA[a];
+            for (size_t j = b; j < countB && intervalsB[j].min <= interval.max; ++j) {
+                if (IsOverlapOtherAxes(interval, intervalsB[j])) {
+                    outPairs.push_back(CollisionPair{ interval.index, intervalsB[j].index });
+                }
+            }
+            ++a;
+        } else {
+            const Interval &interval = intervalsB[b];
+            for (size_t j = a; j < countA && intervalsA[j].min <= interval.max; ++j) {
+                if (IsOverlapOtherAxes(intervalsA[j], interval)) {
+                    outPairs.push_back(CollisionPair{ intervalsA[j].index, interval.index });
+                }
+            }
+            ++b;
+        }
+    }
+}
+
+int SweepAndPruneBroadphase::SelectAxis(const SphereSoA &spheresA, const SphereSoA *spheresB) {
+    const SphereSoA *sets[2] = { &spheresA, spheresB };
+    float sums[3] = {};
+    float sumsSquared[3] = {};
+    size_t count = 0;
+    for (const SphereSoA *spheres : sets) {
+        if (!spheres) {
+            continue;
+        }
+        const std::span<const float> centers[3] = { spheres->centerX, spheres->centerY, spheres->centerZ };
+        for (int axis = 0; axis < 3; ++axis) {
+            for (const float center : centers[axis]) {
+                sums[axis] += center;
+                sumsSquared[axis] += center * center;
+            }
+        }
+        count += spheres->Size();
+    }
+    float variances[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        const float mean = sums[axis] / static_cast<float>(count);
+        variances[axis] = sumsSquared[axis] / static_cast<float>(count) - mean * mean;
+    }
+    return static_cast<int>(std::max_element(variances, variances + 3) - variances);
+}
+
+void SweepAndPruneBroadphase::SortedIntervals::Build(const SphereSoA &spheres, int axis, bool isCoherent) {
+    const size_t count = spheres.Size();
+    if (!isCoherent) {
+        order_.resize(count);
+        std::iota(order_.begin(), order_.end(), 0u);
+    }
+
+    const std::span<const float> centers[3] = { spheres.centerX, spheres.centerY, spheres.centerZ };
+    const std::span<const float> axisCenters = centers[axis];
+    const std::span<const float> otherCenters0 = centers[(axis + 1) % 3];
+    const std::span<const float> otherCenters1 = centers[(axis + 2) % 3];
+    intervals_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t index = order_[i];
+        const float radius = spheres.radius[index];
+        intervals_[i] = Interval{
+            axisCenters[index] - radius, axisCenters[index] + radius,
+            { otherCenters0[index] - radius, otherCenters1[index] - radius },
+            { otherCenters0[index] + radius, otherCenters1[index] + radius },
+            index
+        };
+    }
+
+    const auto isLess = [](const Interval &a, const Interval &b) { return a.min < b.min; };
+    bool isSorted = false;
+    if (isCoherent) {
+        // 前フレームからほとんど動いていなければ挿入ソートでほぼO(n)で済む
+        const size_t budget = count * kInsertionSortBudget;
+        size_t moveCount = 0;
+        isSorted = true;
+        for (size_t i = 1; i < count && isSorted; ++i) {
+            const Interval interval = intervals_[i];
+            size_t j = i;
+            for (; j > 0 && isLess(interval, intervals_[j - 1]); --j) {
+                intervals_[j] = intervals_[j - 1];
+            }
+            intervals_[j] = interval;
+            moveCount += i - j;
+            isSorted = moveCount <= budget;
+        }
+    }
+    if (!isSorted) {
+        std::sort(intervals_.begin(), intervals_.end(), isLess);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        order_[i] = intervals_[i].index;
+    }
+}
+
+} // namespace Math
+
+} // namespace KashipanEngine
\ No newline at end of file
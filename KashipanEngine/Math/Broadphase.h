@@ -0,0 +1,123 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "ColliderBatch.h"
+
+namespace KashipanEngine {
+
+/*
+衝突判定の広域判定(ブロードフェーズ)。球の配列から、境界ボックス(中心±半径)が重なる組だけを候補として列挙する。
+  FindPairs(spheres)           : 1つの配列の中の組(indexA < indexB)
+  FindPairs(spheresA, spheresB): 2つの配列の間の組(indexAはA、indexBはBの添字)。同じ配列の中の組は調べない
+同じ組は1度しか出力しない。順番は実装ごとに異なる。
+  HashGridBroadphase      : 一様グリッドのハッシュ。大きさの近い物体が広く散らばっている場合に向く
+  SweepAndPruneBroadphase : 1軸に沿って並べ替えて重なる区間を探す。前フレームの並びを使い回すので物体の動きが少ないほど速い。
+                            物体が空間全体に密に散らばると1軸では絞り切れないので、その場合はHashGridBroadphaseの方が速い
+どちらも内部のバッファを使い回すので、物体の数が増えない限り毎フレームのメモリ確保は発生しない。
+前フレームの結果を使い回す実装があるので、毎フレーム同じ配列(の組み合わせ)には同じインスタンスを使うこと。
+*/
+
+namespace Math {
+
+/// @brief 広域判定のインターフェース
+class Broadphase {
+public:
+    virtual ~Broadphase() = default;
+
+    /// @brief 1つの配列の中で境界ボックスが重なる球の組を列挙する
+    /// @param spheres 球の配列
+    /// @param outPairs 候補の組の出力先(中身は置き換えられる)
+    virtual void FindPairs(const SphereSoA &spheres, std::vector<CollisionPair> &outPairs) = 0;
+
+    /// @brief 2つの配列の間で境界ボックスが重なる球の組を列挙する
+    /// @param spheresA 球の配列A
+    /// @param spheresB 球の配列B
+    /// @param outPairs 候補の組の出力先(中身は置き換えられる)
+    virtual void FindPairs(const SphereSoA &spheresA, const SphereSoA &spheresB, std::vector<CollisionPair> &outPairs) = 0;
+};
+
+/// @brief 一様グリッドのハッシュによる広域判定
+class HashGridBroadphase final : public Broadphase {
+public:
+    /// @brief コンストラクタ
+    /// @param cellSize セルの一辺の長さ(0以下なら毎フレーム最大の球の直径の2倍に合わせる)
+    explicit HashGridBroadphase(float cellSize = 0.0f) noexcept : cellSize_(cellSize) {}
+
+    void FindPairs(const SphereSoA &spheres, std::vector<CollisionPair> &outPairs) override;
+    void FindPairs(const SphereSoA &spheresA, const SphereSoA &spheresB, std::vector<CollisionPair> &outPairs) override;
+
+    /// @brief セルの一辺の長さを設定
+    /// @param cellSize セルの一辺の長さ(0以下なら毎フレーム最大の球の直径の2倍に合わせる)
+    void SetCellSize(float cellSize) noexcept { cellSize_ = cellSize; }
+
+private:
+    /// @brief セルの座標
+    struct Cell {
+        int32_t x;
+        int32_t y;
+        int32_t z;
+    };
+    /// @brief セルに登録した球
+    struct Entry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    /// @brief セルの一辺の長さの逆数を求める
+    float GetInverseCellSize(std::span<const float> radiusA, std::span<const float> radiusB) const noexcept;
+    /// @brief 球をグリッドに登録し、ハッシュのバケットごとに並べ替える
+    void Insert(const SphereSoA &spheres, float inverseCellSize);
+
+    float cellSize_;
+    int bucketBits_ = 1;
+    // 各球の境界ボックスの最小側のセル(重複した組を出力しないために使う)
+    std::vector<Cell> minCells_;
+    std::vector<Entry> entries_;
+    // ハッシュのバケットごとに並べ替えた登録
+    std::vector<Entry> sortedEntries_;
+    std::vector<uint32_t> bucketStarts_;
+};
+
+/// @brief 1軸のスイープ&プルーンによる広域判定
+class SweepAndPruneBroadphase final : public Broadphase {
+public:
+    void FindPairs(const SphereSoA &spheres, std::vector<CollisionPair> &outPairs) override;
+    void FindPairs(const SphereSoA &spheresA, const SphereSoA &spheresB, std::vector<CollisionPair> &outPairs) override;
+
+private:
+    /// @brief 並べ替える軸上の区間と、残りの軸の範囲
+    struct Interval {
+        float min;
+        float max;
+        // 残りの2軸の範囲(判定中に元の配列を参照しなくて済むよう一緒に並べ替える)
+        float otherMin[2];
+        float otherMax[2];
+        uint32_t index;
+    };
+
+    /// @brief 1つの配列の区間を最小値の順に並べたもの
+    class SortedIntervals {
+    public:
+        /// @brief 区間を作って並べ替える(isCoherentなら前フレームの並びから挿入ソートする)
+        void Build(const SphereSoA &spheres, int axis, bool isCoherent);
+
+        const std::vector<Interval> &GetIntervals() const noexcept { return intervals_; }
+        size_t GetCount() const noexcept { return order_.size(); }
+
+    private:
+        // 前フレームの並び(球の添字)
+        std::vector<uint32_t> order_;
+        std::vector<Interval> intervals_;
+    };
+
+    /// @brief 中心の散らばりが一番大きい軸を選ぶ
+    static int SelectAxis(const SphereSoA &spheresA, const SphereSoA *spheresB);
+
+    SortedIntervals sortedA_;
+    SortedIntervals sortedB_;
+    int axis_ = -1;
+};
+
+} // namespace Math
+
+} // namespace KashipanEngine
\ No newline at end of file
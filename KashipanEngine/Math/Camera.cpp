@@ -60,9 +60,7 @@ Camera::Camera() {
     cameraScale_ = { 1.0f, 1.0f, 1.0f };
     cameraRotate_ = { 0.0f, 0.0f, 0.0f };
     cameraTranslate_ = { 0.0f, 0.0f, 0.0f };
-    cameraMatrix_.SetScale(cameraScale_);
-    cameraMatrix_.SetRotate(cameraRotate_);
-    cameraMatrix_.SetTranslate(cameraTranslate_);
+    cameraMatrix_.SetSRT(cameraScale_, cameraRotate_, cameraTranslate_);
     worldMatrix_.MakeAffine({ 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f });
 }
 
@@ -71,9 +69,7 @@ Camera::Camera(const Vector3 &cameraTranslate, const Vector3 &cameraRotate, cons
     cameraScale_ = cameraScale;
     cameraRotate_ = cameraRotate;
     cameraTranslate_ = cameraTranslate;
-    cameraMatrix_.SetScale(cameraScale);
-    cameraMatrix_.SetRotate(cameraRotate);
-    cameraMatrix_.SetTranslate(cameraTranslate);
+    cameraMatrix_.SetSRT(cameraScale, cameraRotate, cameraTranslate);
     worldMatrix_.MakeAffine({ 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f });
 }
 
@@ -97,9 +93,7 @@ void Camera::SetCamera(const Vector3 &cameraTranslate, const Vector3 &cameraRota
     cameraTranslate_ = cameraTranslate;
     cameraRotate_ = cameraRotate;
     cameraScale_ = cameraScale;
-    cameraMatrix_.SetTranslate(cameraTranslate);
-    cameraMatrix_.SetRotate(cameraRotate);
-    cameraMatrix_.SetScale(cameraScale);
+    cameraMatrix_.SetSRT(cameraScale, cameraRotate, cameraTranslate);
 }
 
 void Camera::SetTranslate(const Vector3 &cameraTranslate) noexcept {
@@ -155,10 +149,8 @@ void Camera::CalculateMatrixForDecart() noexcept {
         cameraRotate_.x = pitch;
         cameraRotate_.y = -yaw;
     }
-    cameraMatrix_.SetTranslate(cameraTranslate_);
-    cameraMatrix_.SetRotate(cameraRotate_);
-    cameraMatrix_.SetScale(cameraScale_);
-    viewMatrix_ = cameraMatrix_.InverseTranslate() * cameraMatrix_.InverseRotate() * cameraMatrix_.InverseScale();
+    cameraMatrix_.SetSRT(cameraScale_, cameraRotate_, cameraTranslate_);
+    viewMatrix_ = cameraMatrix_.InverseWorld();
     projectionMatrix_ = MakePerspectiveFovMatrix(0.45f, static_cast<float>(sWinApp_->GetClientWidth()) / static_cast<float>(sWinApp_->GetClientHeight()), 0.1f, 2048.0f);
     wvpMatrix_ = worldMatrix_ * viewMatrix_ * projectionMatrix_;
     viewportMatrix_ = MakeViewportMatrix(0.0f, 0.0f, static_cast<float>(sWinApp_->GetClientWidth()), static_cast<float>(sWinApp_->GetClientHeight()), 0.0f, 1.0f);
@@ -167,10 +159,8 @@ void Camera::CalculateMatrixForDecart() noexcept {
 void Camera::CalculateMatrixForSpherical() noexcept {
     cameraTranslate_ = sphericalCoordinateSystem_.ToVector3();
     //viewMatrix_ = MakeViewMatrix(cameraTranslate_, sphericalCoordinateSystem_.origin, Vector3(0.0f, 1.0f, 0.0f));
-    cameraMatrix_.SetTranslate(cameraTranslate_);
-    cameraMatrix_.SetRotate(cameraRotate_);
-    cameraMatrix_.SetScale(cameraScale_);
-    viewMatrix_ = cameraMatrix_.InverseTranslate() * cameraMatrix_.InverseRotate() * cameraMatrix_.InverseScale();
+    cameraMatrix_.SetSRT(cameraScale_, cameraRotate_, cameraTranslate_);
+    viewMatrix_ = cameraMatrix_.InverseWorld();
     projectionMatrix_ = MakePerspectiveFovMatrix(0.45f, static_cast<float>(sWinApp_->GetClientWidth()) / static_cast<float>(sWinApp_->GetClientHeight()), 0.1f, 2048.0f);
     wvpMatrix_ = worldMatrix_ * viewMatrix_ * projectionMatrix_;
     viewportMatrix_ = MakeViewportMatrix(0.0f, 0.0f, static_cast<float>(sWinApp_->GetClientWidth()), static_cast<float>(sWinApp_->GetClientHeight()), 0.0f, 1.0f);
@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "CatmullRomSpline.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+// 小区間内のパラメータをNewton法で詰める回数
+constexpr int kNewtonIterations = 1;
+
+// [0, 1]に写したGauss-Legendre 3点の節点と重み(小区間は十分短いので3点で足りる)
+constexpr float kGaussNodes[3] = { 0.1127016654f, 0.5f, 0.8872983346f };
+constexpr float kGaussWeights[3] = { 0.2777777778f, 0.4444444444f, 0.2777777778f };
+
+} // namespace
+
+Vector3 CatmullRomSpline::Segment::Position(float t) const noexcept {
+    return ((a * t + b) * t + c) * t + d;
+}
+
+Vector3 CatmullRomSpline::Segment::Derivative(float t) const noexcept {
+    return (a * (3.0f * t) + b * 2.0f) * t + c;
+}
+
+float CatmullRomSpline::Segment::ArcLength(float t0, float t1) const noexcept {
+    const float width = t1 - t0;
+    float sum = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        sum += kGaussWeights[i] * Derivative(t0 + width * kGaussNodes[i]).Length();
+    }
+    return sum * width;
+}
+
+CatmullRomSpline::CatmullRomSpline(const std::vector<Vector3> &points, bool isLoop, int samplesPerSegment) {
+    SetControlPoints(points, isLoop, samplesPerSegment);
+}
+
+void CatmullRomSpline::SetControlPoints(const std::vector<Vector3> &points, bool isLoop, int samplesPerSegment) {
+    points_ = points;
+    isLoop_ = isLoop;
+    samplesPerSegment_ = std::max(samplesPerSegment, 1);
+    Build();
+}
+
+void CatmullRomSpline::SetLoop(bool isLoop) {
+    if (isLoop_ == isLoop) {
+        return;
+    }
+    isLoop_ = isLoop;
+    Build();
+}
+
+float CatmullRomSpline::WrapDistance(float distance) const noexcept {
+    if (isLoop_ && length_ > 0.0f) {
+        distance = std::fmod(distance, length_);
+        return distance < 0.0f ? distance + length_ : distance;
+    }
+    return std::clamp(distance, 0.0f, length_);
+}
+
+float CatmullRomSpline::GetParameter(float distance) const noexcept {
+    size_t segmentIndex = 0;
+    float t = 0.0f;
+    Locate(distance, segmentIndex, t);
+    return (static_cast<float>(segmentIndex) + t) / static_cast<float>(segments_.size());
+}
+
+Vector3 CatmullRomSpline::GetPosition(float distance) const noexcept {
+    size_t segmentIndex = 0;
+    float t = 0.0f;
+    Locate(distance, segmentIndex, t);
+    return segments_[segmentIndex].Position(t);
+}
+
+Vector3 CatmullRomSpline::GetTangent(float distance) const noexcept {
+    size_t segmentIndex = 0;
+    float t = 0.0f;
+    Locate(distance, segmentIndex, t);
+    return segments_[segmentIndex].Derivative(t).Normalize();
+}
+
+CatmullRomSpline::Frame CatmullRomSpline::GetFrame(float distance, const Vector3 &worldUp) const noexcept {
+    size_t segmentIndex = 0;
+    float t = 0.0f;
+    Locate(distance, segmentIndex, t);
+    const Segment &segment = segments_[segmentIndex];
+
+    Frame frame;
+    frame.position = segment.Position(t);
+    frame.forward = segment.Derivative(t).Normalize();
+
+    // 進行方向と上方向がほぼ平行なら別の軸を基準にする
+    Vector3 up = worldUp;
+    if (std::abs(frame.forward.Dot(up.Normalize())) > 0.999f) {
+        up = std::abs(frame.forward.z) < 0.9f ? Vector3(0.0f, 0.0f, 1.0f) : Vector3(1.0f, 0.0f, 0.0f);
+    }
+    frame.right = up.Cross(frame.forward).Normalize();
+    frame.up = frame.forward.Cross(frame.right);
+    return frame;
+}
+
+void CatmullRomSpline::Build() {
+    segments_.clear();
+    cumulativeDistances_.clear();
+    distanceToSample_.clear();
+    length_ = 0.0f;
+    inverseTableStep_ = 0.0f;
+
+    assert(points_.size() >= 4);
+    if (points_.size() < 4) {
+        return;
+    }
+
+    // 区間の式を作る(制御点の選び方はVector3::CatmullRomPositionと同じ)
+    const int pointCount = static_cast<int>(points_.size());
+    auto GetIndex = [&](int i) -> size_t {
+        if (isLoop_) {
+            return static_cast<size_t>((i + pointCount) % pointCount);
+        } else {
+            return static_cast<size_t>(std::clamp(i, 0, pointCount - 1));
+        }
+    };
+    const size_t segmentCount = isLoop_ ? points_.size() : points_.size() - 1;
+    segments_.resize(segmentCount);
+    for (size_t i = 0; i < segmentCount; ++i) {
+        const int index = static_cast<int>(i);
+        const Vector3 &p0 = points_[GetIndex(index - 1)];
+        const Vector3 &p1 = points_[GetIndex(index)];
+        const Vector3 &p2 = points_[GetIndex(index + 1)];
+        const Vector3 &p3 = points_[GetIndex(index + 2)];
+        // Vector3::CatmullRomInterpolationをtの多項式として展開したもの
+        segments_[i].a = (-p0 + (3.0f * p1) - (3.0f * p2) + p3) * 0.5f;
+        segments_[i].b = ((2.0f * p0) - (5.0f * p1) + (4.0f * p2) - p3) * 0.5f;
+        segments_[i].c = (-p0 + p2) * 0.5f;
+        segments_[i].d = p1;
+    }
+
+    // 各区間を等分した小区間の始点までの累積弧長
+    const size_t sampleCount = segmentCount * static_cast<size_t>(samplesPerSegment_);
+    const float sampleWidth = 1.0f / static_cast<float>(samplesPerSegment_);
+    cumulativeDistances_.resize(sampleCount + 1);
+    cumulativeDistances_[0] = 0.0f;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        const Segment &segment = segments_[i / samplesPerSegment_];
+        const float t0 = static_cast<float>(i % samplesPerSegment_) * sampleWidth;
+        cumulativeDistances_[i + 1] = cumulativeDistances_[i] + segment.ArcLength(t0, t0 + sampleWidth);
+    }
+    length_ = cumulativeDistances_[sampleCount];
+
+    // 距離を等間隔に区切った点ごとに、その点を含む小区間を記録する
+    distanceToSample_.resize(sampleCount + 1);
+    if (length_ <= 0.0f) {
+        // 全ての制御点が同じ位置
+        return;
+    }
+    const float tableStep = length_ / static_cast<float>(sampleCount);
+    inverseTableStep_ = 1.0f / tableStep;
+    uint32_t sample = 0;
+    for (size_t i = 0; i <= sampleCount; ++i) {
+        const float distance = tableStep * static_cast<float>(i);
+        while (sample + 1 < sampleCount && cumulativeDistances_[sample + 1] <= distance) {
+            ++sample;
+        }
+        distanceToSample_[i] = sample;
+    }
+}
+
+void CatmullRomSpline::Locate(float distance, size_t &segmentIndex, float &t) const noexcept {
+    assert(!segments_.empty());
+    distance = WrapDistance(distance);
+
+    // テーブルから小区間を引く(テーブルの間隔と小区間の平均長さが同じなので、進めるのは数回で済む)
+    const size_t sampleCount = cumulativeDistances_.size() - 1;
+    const size_t tableIndex = std::min(static_cast<size_t>(distance * inverseTableStep_), sampleCount);
+    size_t sample = distanceToSample_[tableIndex];
+    while (sample + 1 < sampleCount && cumulativeDistances_[sample + 1] <= distance) {
+        ++sample;
+    }
+
+    segmentIndex = sample / samplesPerSegment_;
+    const Segment &segment = segments_[segmentIndex];
+    const float sampleWidth = 1.0f / static_cast<float>(samplesPerSegment_);
+    const float t0 = static_cast<float>(sample % samplesPerSegment_) * sampleWidth;
+    const float t1 = t0 + sampleWidth;
+    const float sampleLength = cumulativeDistances_[sample + 1] - cumulativeDistances_[sample];
+    const float remaining = distance - cumulativeDistances_[sample];
+
+    // 小区間内は線形に近似してからNewton法で詰める
+    t = t0 + (sampleLength > 0.0f ? sampleWidth * std::min(remaining / sampleLength, 1.0f) : 0.0f);
+    for (int iteration = 0; iteration < kNewtonIterations; ++iteration) {
+        const float speed = segment.Derivative(t).Length();
+        if (speed <= 0.0f) {
+            break;
+        }
+        t = std::clamp(t - (segment.ArcLength(t0, t) - remaining) / speed, t0, t1);
+    }
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
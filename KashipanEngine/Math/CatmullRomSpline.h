@@ -0,0 +1,113 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Vector3.h"
+
+namespace KashipanEngine {
+
+/// @brief 弧長でパラメータ化したCatmull-Romスプライン
+/// @details 制御点を設定したときに累積弧長のテーブルを作っておき、
+/// 「始点から距離distanceの位置・接線」をO(1)で返す(テーブルで小区間を引き、小区間内はNewton法で詰める)。
+/// 区間の分け方はVector3::CatmullRomPositionと同じなので、同じ制御点なら同じ曲線になる。
+class CatmullRomSpline {
+public:
+    /// @brief 1区間あたりの弧長テーブルの分割数の既定値
+    static constexpr int kDefaultSamplesPerSegment = 32;
+
+    /// @brief カメラ等の向きに使う座標軸
+    struct Frame {
+        Vector3 position;   // 位置
+        Vector3 forward;    // 進行方向(正規化済み)
+        Vector3 right;      // 右方向(正規化済み)
+        Vector3 up;         // 上方向(正規化済み)
+    };
+
+    CatmullRomSpline() = default;
+    /// @brief コンストラクタ
+    /// @param points 制御点(4つ以上)
+    /// @param isLoop ループするかどうか
+    /// @param samplesPerSegment 1区間あたりの弧長テーブルの分割数
+    CatmullRomSpline(const std::vector<Vector3> &points, bool isLoop, int samplesPerSegment = kDefaultSamplesPerSegment);
+
+    /// @brief 制御点を設定して弧長テーブルを作り直す
+    /// @param points 制御点(4つ以上)
+    /// @param isLoop ループするかどうか
+    /// @param samplesPerSegment 1区間あたりの弧長テーブルの分割数
+    void SetControlPoints(const std::vector<Vector3> &points, bool isLoop, int samplesPerSegment = kDefaultSamplesPerSegment);
+
+    /// @brief ループするかどうかを設定して弧長テーブルを作り直す
+    /// @param isLoop ループするかどうか
+    void SetLoop(bool isLoop);
+
+    /// @brief 距離を曲線上の範囲に収める(ループ時は周回、そうでなければ0～全長に制限)
+    /// @param distance 始点からの距離
+    /// @return 範囲に収めた距離
+    [[nodiscard]] float WrapDistance(float distance) const noexcept;
+
+    /// @brief 距離に対応するVector3::CatmullRomPositionのパラメータ(0～1)を取得
+    /// @param distance 始点からの距離
+    /// @return 曲線全体を0～1としたパラメータ
+    [[nodiscard]] float GetParameter(float distance) const noexcept;
+
+    /// @brief 始点から距離distanceの位置を取得
+    /// @param distance 始点からの距離
+    /// @return 位置
+    [[nodiscard]] Vector3 GetPosition(float distance) const noexcept;
+
+    /// @brief 始点から距離distanceの接線を取得
+    /// @param distance 始点からの距離
+    /// @return 進行方向の単位ベクトル
+    [[nodiscard]] Vector3 GetTangent(float distance) const noexcept;
+
+    /// @brief 始点から距離distanceの座標軸を取得
+    /// @param distance 始点からの距離
+    /// @param worldUp 基準にする上方向(進行方向と平行なときは代わりにZ軸かX軸を使う)
+    /// @return 位置と進行方向・右方向・上方向
+    [[nodiscard]] Frame GetFrame(float distance, const Vector3 &worldUp = Vector3(0.0f, 1.0f, 0.0f)) const noexcept;
+
+    /// @brief 曲線の全長を取得
+    [[nodiscard]] float GetLength() const noexcept { return length_; }
+    /// @brief ループするかどうかを取得
+    [[nodiscard]] bool IsLoop() const noexcept { return isLoop_; }
+    /// @brief 制御点を取得
+    [[nodiscard]] const std::vector<Vector3> &GetControlPoints() const noexcept { return points_; }
+
+private:
+    /// @brief 区間の3次式 P(t) = ((a * t + b) * t + c) * t + d
+    struct Segment {
+        Vector3 a;
+        Vector3 b;
+        Vector3 c;
+        Vector3 d;
+
+        Vector3 Position(float t) const noexcept;
+        Vector3 Derivative(float t) const noexcept;
+        /// @brief t0からt1までの弧長(Gauss-Legendre 3点)
+        float ArcLength(float t0, float t1) const noexcept;
+    };
+
+    /// @brief 制御点から区間の式と弧長テーブルを作る
+    void Build();
+    /// @brief 距離から区間番号と区間内のパラメータを取得
+    void Locate(float distance, size_t &segmentIndex, float &t) const noexcept;
+
+    // 制御点
+    std::vector<Vector3> points_;
+    // 各区間の式
+    std::vector<Segment> segments_;
+    // 各区間をsamplesPerSegment_等分した小区間の始点までの累積弧長
+    std::vector<float> cumulativeDistances_;
+    // 距離を等間隔に区切った点ごとに、その点を含む小区間の番号
+    std::vector<uint32_t> distanceToSample_;
+
+    // 曲線の全長
+    float length_ = 0.0f;
+    // distanceToSample_の1要素あたりの距離の逆数
+    float inverseTableStep_ = 0.0f;
+    // 1区間あたりの弧長テーブルの分割数
+    int samplesPerSegment_ = kDefaultSamplesPerSegment;
+    // ループするかどうか
+    bool isLoop_ = false;
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -14,11 +14,92 @@ namespace Math {
 
 namespace Collider {
 
+namespace {
+
+/// @brief 点が移動量diffで動くとき、球に入る最初の時刻を求める(点は球の外にあること)
+/// @return 0～1の間に入るかどうか
+bool IntersectMovingPointSphere(const Vector3 &point, const Vector3 &diff,
+    const Vector3 &center, float radius, float &outTime) {
+    // |point + diff * t - center|^2 = radius^2 の小さい方の解を求める
+    const Vector3 m = point - center;
+    const float a = diff.LengthSquared();
+    const float b = m.Dot(diff);
+    const float c = m.LengthSquared() - radius * radius;
+    // 止まっているか、遠ざかっている
+    if (a == 0.0f || b >= 0.0f) {
+        return false;
+    }
+    const float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) {
+        return false;
+    }
+    const float t = (-b - std::sqrt(discriminant)) / a;
+    if (t > 1.0f) {
+        return false;
+    }
+    outTime = std::max(t, 0.0f);
+    return true;
+}
+
+/// @brief 点が移動量diffで動くとき、start-endを軸とする半径radiusのカプセルに入る最初の時刻を求める(点はカプセルの外にあること)
+/// @return 0～1の間に入るかどうか
+bool IntersectMovingPointCapsule(const Vector3 &point, const Vector3 &diff,
+    const Vector3 &start, const Vector3 &end, float radius, float &outTime) {
+    float time = 2.0f;
+    float t;
+    // 両端の球
+    if (IntersectMovingPointSphere(point, diff, start, radius, t)) {
+        time = std::min(time, t);
+    }
+    if (IntersectMovingPointSphere(point, diff, end, radius, t)) {
+        time = std::min(time, t);
+    }
+
+    // 円柱の側面(軸に垂直な成分だけで球と同じ式を解き、軸方向の範囲に入っているかを調べる)
+    const Vector3 axis = end - start;
+    const float axisLengthSquared = axis.LengthSquared();
+    const Vector3 m = point - start;
+    const Vector3 mPerpendicular = m - axis * (m.Dot(axis) / axisLengthSquared);
+    const Vector3 diffPerpendicular = diff - axis * (diff.Dot(axis) / axisLengthSquared);
+    const float a = diffPerpendicular.LengthSquared();
+    const float b = mPerpendicular.Dot(diffPerpendicular);
+    const float c = mPerpendicular.LengthSquared() - radius * radius;
+    // 軸と平行に動く場合と、最初から円柱の内側にある場合は両端の球に先に当たる
+    if (a > 0.0f && b < 0.0f && c > 0.0f) {
+        const float discriminant = b * b - a * c;
+        if (discriminant >= 0.0f) {
+            t = (-b - std::sqrt(discriminant)) / a;
+            const float s = (m + diff * t).Dot(axis) / axisLengthSquared;
+            if (t <= 1.0f && s >= 0.0f && s <= 1.0f) {
+                time = std::min(time, t);
+            }
+        }
+    }
+
+    if (time > 1.0f) {
+        return false;
+    }
+    outTime = time;
+    return true;
+}
+
+/// @brief AABBの角の座標を取得する(bitsの各ビットが立っている軸はmax、それ以外はmin)
+Vector3 GetCorner(const AABB &aabb, int bits) {
+    return Vector3(
+        (bits & 1) ? aabb.max.x : aabb.min.x,
+        (bits & 2) ? aabb.max.y : aabb.min.y,
+        (bits & 4) ? aabb.max.z : aabb.min.z
+    );
+}
+
+} // namespace
+
 bool IsCollision(const Sphere &sphere1, const Sphere &sphere2) {
-    // 球の中心間の距離を求める
-    const float distance = (sphere1.center - sphere2.center).Length();
-    // 球の半径の和と距離を比較する
-    return distance <= (sphere1.radius + sphere2.radius);
+    // 球の中心間の距離の2乗を求める
+    const float distanceSquared = (sphere1.center - sphere2.center).LengthSquared();
+    // 球の半径の和の2乗と比較する(平方根を取らない)
+    const float radiusSum = sphere1.radius + sphere2.radius;
+    return distanceSquared <= radiusSum * radiusSum;
 }
 
 bool IsCollision(const Sphere &sphere, const Plane &plane) {
@@ -28,6 +109,21 @@ bool IsCollision(const Sphere &sphere, const Plane &plane) {
     return std::abs(k) <= sphere.radius;
 }
 
+bool IsCollision(const Sphere &sphere, const Ray &ray) {
+    // 球の中心に最も近い半直線上の点の媒介変数tを求める(始点より後ろなら始点)
+    const float diffLengthSquared = ray.diff.LengthSquared();
+    float t = 0.0f;
+    if (diffLengthSquared > 0.0f) {
+        t = (sphere.center - ray.origin).Dot(ray.diff) / diffLengthSquared;
+    }
+    t = std::max(t, 0.0f);
+    // 最近接点と球の中心との距離の2乗を求める
+    const Vector3 closestPoint = ray.origin + ray.diff * t;
+    const float distanceSquared = (closestPoint - sphere.center).LengthSquared();
+    // 球の半径の2乗と比較する
+    return distanceSquared <= sphere.radius * sphere.radius;
+}
+
 bool IsCollision(const Plane &plane, const Line &line) {
     // 法線と線の内積を求める
     const float dot = plane.normal.Dot(line.diff);
@@ -159,10 +255,10 @@ bool IsCollision(const AABB &aabb, const Sphere &sphere) {
         std::clamp(sphere.center.y, aabb.min.y, aabb.max.y),
         std::clamp(sphere.center.z, aabb.min.z, aabb.max.z)
     );
-    // 最近接点と球の中心との距離を求める
-    const float distance = (closestPoint - sphere.center).Length();
-    // 球の半径と距離を比較する
-    return distance <= sphere.radius;
+    // 最近接点と球の中心との距離の2乗を求める
+    const float distanceSquared = (closestPoint - sphere.center).LengthSquared();
+    // 球の半径の2乗と比較する(平方根を取らない)
+    return distanceSquared <= sphere.radius * sphere.radius;
 }
 
 bool IsCollision(const AABB &aabb, const Line &line) {
@@ -264,6 +360,94 @@ bool IsCollision(const AABB &aabb, const Segment &segment) {
     return tNearMax <= tFarMin && tFarMin >= 0.0f && tNearMax <= 1.0f;
 }
 
+bool IsCollision(const Sphere &sphere1, const Vector3 &velocity1,
+    const Sphere &sphere2, const Vector3 &velocity2, float &outTime) {
+    // 移動前から重なっている
+    if (IsCollision(sphere1, sphere2)) {
+        outTime = 0.0f;
+        return true;
+    }
+    // 球2から見た球1の中心の動きを、半径の和の球と点の判定にする
+    return IntersectMovingPointSphere(sphere1.center, velocity1 - velocity2,
+        sphere2.center, sphere1.radius + sphere2.radius, outTime);
+}
+
+bool IsCollision(const Sphere &sphere, const Vector3 &velocity, const AABB &aabb, float &outTime) {
+    // 移動前から重なっている
+    if (IsCollision(aabb, sphere)) {
+        outTime = 0.0f;
+        return true;
+    }
+
+    // 球の中心が、半径の分だけ広げたAABBに入る時刻を求める(角と辺が丸まっていない分だけ本当の形より大きい)
+    float tEnter = 0.0f;
+    float tExit = 1.0f;
+    const float origin[3] = { sphere.center.x, sphere.center.y, sphere.center.z };
+    const float diff[3] = { velocity.x, velocity.y, velocity.z };
+    const float boxMin[3] = { aabb.min.x - sphere.radius, aabb.min.y - sphere.radius, aabb.min.z - sphere.radius };
+    const float boxMax[3] = { aabb.max.x + sphere.radius, aabb.max.y + sphere.radius, aabb.max.z + sphere.radius };
+    for (int axis = 0; axis < 3; ++axis) {
+        if (diff[axis] == 0.0f) {
+            // この軸には動かないので、範囲の外なら当たらない
+            if (origin[axis] < boxMin[axis] || origin[axis] > boxMax[axis]) {
+                return false;
+            }
+            continue;
+        }
+        const float inverse = 1.0f / diff[axis];
+        float t0 = (boxMin[axis] - origin[axis]) * inverse;
+        float t1 = (boxMax[axis] - origin[axis]) * inverse;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        tEnter = std::max(tEnter, t0);
+        tExit = std::min(tExit, t1);
+        if (tEnter > tExit) {
+            return false;
+        }
+    }
+
+    // 入った点が元のAABBのどの面の外側にあるかで、当たる場所が面・辺・角のどれかを決める
+    const Vector3 point = sphere.center + velocity * tEnter;
+    int minBits = 0;
+    int maxBits = 0;
+    if (point.x < aabb.min.x) minBits |= 1;
+    if (point.x > aabb.max.x) maxBits |= 1;
+    if (point.y < aabb.min.y) minBits |= 2;
+    if (point.y > aabb.max.y) maxBits |= 2;
+    if (point.z < aabb.min.z) minBits |= 4;
+    if (point.z > aabb.max.z) maxBits |= 4;
+    const int bits = minBits | maxBits;
+
+    // 面(外側にある軸が1つ以下)なら広げたAABBに入った時刻がそのまま当たった時刻
+    if (bits != 3 && bits != 5 && bits != 6 && bits != 7) {
+        outTime = tEnter;
+        return true;
+    }
+
+    // 辺なら、その辺を軸にしたカプセルと判定する
+    if (bits != 7) {
+        return IntersectMovingPointCapsule(sphere.center, velocity,
+            GetCorner(aabb, minBits ^ 7), GetCorner(aabb, maxBits), sphere.radius, outTime);
+    }
+
+    // 角なら、その角につながる3つの辺のカプセルのうち最初に当たるもの
+    const Vector3 corner = GetCorner(aabb, maxBits);
+    float time = 2.0f;
+    float t;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (IntersectMovingPointCapsule(sphere.center, velocity,
+            corner, GetCorner(aabb, maxBits ^ (1 << axis)), sphere.radius, t)) {
+            time = std::min(time, t);
+        }
+    }
+    if (time > 1.0f) {
+        return false;
+    }
+    outTime = time;
+    return true;
+}
+
 } // namespace Collider
 
 } // namespace Math
@@ -2,6 +2,8 @@
 
 namespace KashipanEngine {
 
+struct Vector3;
+
 namespace Math {
 
 struct Sphere;
@@ -26,6 +28,12 @@ namespace Collider {
 /// @return 衝突しているかどうか
 [[nodiscard]] bool IsCollision(const Sphere &sphere, const Plane &plane);
 
+/// @brief 球と半直線の衝突判定
+/// @param sphere 衝突判定を行う球
+/// @param ray 衝突判定を行う半直線
+/// @return 衝突しているかどうか
+[[nodiscard]] bool IsCollision(const Sphere &sphere, const Ray &ray);
+
 /// @brief 平面と直線の衝突判定
 /// @param plane 衝突判定を行う平面
 /// @param line 衝突判定を行う直線
@@ -92,6 +100,24 @@ namespace Collider {
 /// @return 衝突しているかどうか
 [[nodiscard]] bool IsCollision(const AABB &aabb, const Segment &segment);
 
+/// @brief 移動する球と移動する球の連続衝突判定(1回の移動の間に一度でも接触するか)
+/// @param sphere1 衝突判定を行う球1(移動前)
+/// @param velocity1 球1の1回の移動量
+/// @param sphere2 衝突判定を行う球2(移動前)
+/// @param velocity2 球2の1回の移動量
+/// @param outTime 最初に接触する時刻(移動量に対する割合0～1。移動前から重なっていれば0)
+/// @return 衝突しているかどうか
+[[nodiscard]] bool IsCollision(const Sphere &sphere1, const Vector3 &velocity1,
+    const Sphere &sphere2, const Vector3 &velocity2, float &outTime);
+
+/// @brief 移動する球とAABBの連続衝突判定(1回の移動の間に一度でも接触するか)
+/// @param sphere 衝突判定を行う球(移動前)
+/// @param velocity 球の1回の移動量
+/// @param aabb 衝突判定を行うAABB
+/// @param outTime 最初に接触する時刻(移動量に対する割合0～1。移動前から重なっていれば0)
+/// @return 衝突しているかどうか
+[[nodiscard]] bool IsCollision(const Sphere &sphere, const Vector3 &velocity, const AABB &aabb, float &outTime);
+
 } // namespace Collider
 
 } // namespace Math
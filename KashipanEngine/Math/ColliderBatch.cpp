@@ -0,0 +1,383 @@
+#include "ColliderBatch.h"
+#include "Collider.h"
+#include "MatrixSimd.h"
+#include "Vector3.h"
+#include "Math/MathObjects/Sphere.h"
+#include "Math/MathObjects/Lines.h"
+#include "Math/MathObjects/AABB.h"
+#include <algorithm>
+#include <bit>
+
+namespace KashipanEngine {
+
+namespace Math {
+
+namespace Collider {
+
+namespace {
+
+#if defined(KASHIPAN_MATH_AVX2)
+
+/// @brief AVX2で8要素ずつ計算する
+struct LaneOps {
+    using Type = __m256;
+    static constexpr size_t kWidth = 8;
+
+    static Type Load(const float *p) noexcept { return _mm256_loadu_ps(p); }
+    static Type Set(float value) noexcept { return _mm256_set1_ps(value); }
+    static Type Add(Type a, Type b) noexcept { return _mm256_add_ps(a, b); }
+    static Type Sub(Type a, Type b) noexcept { return _mm256_sub_ps(a, b); }
+    static Type Mul(Type a, Type b) noexcept { return _mm256_mul_ps(a, b); }
+    static Type Div(Type a, Type b) noexcept { return _mm256_div_ps(a, b); }
+    // std::min(a, b) / std::max(a, b)と同じ結果になるよう引数を入れ替えて渡す(NaNや同値のときに返す側が揃う)
+    static Type Min(Type a, Type b) noexcept { return _mm256_min_ps(b, a); }
+    static Type Max(Type a, Type b) noexcept { return _mm256_max_ps(b, a); }
+    static Type Less(Type a, Type b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Type LessEqual(Type a, Type b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static Type GreaterEqual(Type a, Type b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static Type And(Type a, Type b) noexcept { return _mm256_and_ps(a, b); }
+    static Type Select(Type mask, Type a, Type b) noexcept { return _mm256_blendv_ps(b, a, mask); }
+    static uint32_t MoveMask(Type mask) noexcept { return static_cast<uint32_t>(_mm256_movemask_ps(mask)); }
+};
+
+#elif defined(KASHIPAN_MATH_SSE2)
+
+/// @brief SSE2で4要素ずつ計算する
+struct LaneOps {
+    using Type = __m128;
+    static constexpr size_t kWidth = 4;
+
+    static Type Load(const float *p) noexcept { return _mm_loadu_ps(p); }
+    static Type Set(float value) noexcept { return _mm_set1_ps(value); }
+    static Type Add(Type a, Type b) noexcept { return _mm_add_ps(a, b); }
+    static Type Sub(Type a, Type b) noexcept { return _mm_sub_ps(a, b); }
+    static Type Mul(Type a, Type b) noexcept { return _mm_mul_ps(a, b); }
+    static Type Div(Type a, Type b) noexcept { return _mm_div_ps(a, b); }
+    // std::min(a, b) / std::max(a, b)と同じ結果になるよう引数を入れ替えて渡す(NaNや同値のときに返す側が揃う)
+    static Type Min(Type a, Type b) noexcept { return _mm_min_ps(b, a); }
+    static Type Max(Type a, Type b) noexcept { return _mm_max_ps(b, a); }
+    static Type Less(Type a, Type b) noexcept { return _mm_cmplt_ps(a, b); }
+    static Type LessEqual(Type a, Type b) noexcept { return _mm_cmple_ps(a, b); }
+    static Type GreaterEqual(Type a, Type b) noexcept { return _mm_cmpge_ps(a, b); }
+    static Type And(Type a, Type b) noexcept { return _mm_and_ps(a, b); }
+    static Type Select(Type mask, Type a, Type b) noexcept { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+    static uint32_t MoveMask(Type mask) noexcept { return static_cast<uint32_t>(_mm_movemask_ps(mask)); }
+};
+
+#endif
+
+#if defined(KASHIPAN_MATH_SSE2)
+#define KASHIPAN_COLLIDER_BATCH_SIMD
+using V = LaneOps::Type;
+using L = LaneOps;
+
+/// @brief std::clamp(value, lo, hi)と同じ結果を返す
+inline V Clamp(V value, V lo, V hi) noexcept {
+    return L::Select(L::Less(value, lo), lo, L::Select(L::Less(hi, value), hi, value));
+}
+
+/// @brief Vector3::LengthSquaredと同じ順番で長さの2乗を求める
+inline V LengthSquared(V x, V y, V z) noexcept {
+    return L::Add(L::Add(L::Mul(x, x), L::Mul(y, y)), L::Mul(z, z));
+}
+#endif
+
+/// @brief 判定結果をマスクに書き込む
+class MaskEmitter {
+public:
+    explicit MaskEmitter(std::span<uint64_t> outMask) noexcept : mask_(outMask) {}
+
+    /// @brief index番目から始まるビット列を書き込む(ビット列は64ビットの境界をまたがない)
+    void Emit(size_t index, uint32_t bits) noexcept {
+        mask_[index / 64] |= static_cast<uint64_t>(bits) << (index % 64);
+        count_ += static_cast<size_t>(std::popcount(bits));
+    }
+    size_t GetCount() const noexcept { return count_; }
+
+private:
+    std::span<uint64_t> mask_;
+    size_t count_ = 0;
+};
+
+/// @brief 判定結果を添字の配列に書き込む
+class IndexEmitter {
+public:
+    IndexEmitter(std::span<uint32_t> outIndices, uint32_t indexOffset) noexcept
+        : indices_(outIndices), indexOffset_(indexOffset) {}
+
+    /// @brief index番目から始まるビット列の立っている位置を書き込む
+    void Emit(size_t index, uint32_t bits) noexcept {
+        while (bits != 0) {
+            indices_[count_++] = indexOffset_ + static_cast<uint32_t>(index) + static_cast<uint32_t>(std::countr_zero(bits));
+            bits &= bits - 1;
+        }
+    }
+    size_t GetCount() const noexcept { return count_; }
+
+private:
+    std::span<uint32_t> indices_;
+    uint32_t indexOffset_;
+    size_t count_ = 0;
+};
+
+/// @brief 幅ごとにSIMDで判定し、余りをスカラー版で判定する
+/// @param count 要素数
+/// @param simdTest 先頭の添字を受け取り、判定結果のビット列を返す
+/// @param scalarTest 添字を受け取り、判定結果を返す
+/// @param emitter 結果の書き込み先
+template <class SimdTest, class ScalarTest, class Emitter>
+inline void Run(size_t count, [[maybe_unused]] SimdTest simdTest, ScalarTest scalarTest, Emitter &emitter) {
+    size_t i = 0;
+#if defined(KASHIPAN_COLLIDER_BATCH_SIMD)
+    for (; i + L::kWidth <= count; i += L::kWidth) {
+        const uint32_t bits = simdTest(i);
+        if (bits != 0) {
+            emitter.Emit(i, bits);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (scalarTest(i)) {
+            emitter.Emit(i, 1u);
+        }
+    }
+}
+
+template <class Emitter>
+void SphereVsSpheres(const Sphere &sphere, const SphereSoA &spheres, Emitter &emitter) {
+    const size_t count = spheres.Size();
+#if defined(KASHIPAN_COLLIDER_BATCH_SIMD)
+    const V centerX = L::Set(sphere.center.x);
+    const V centerY = L::Set(sphere.center.y);
+    const V centerZ = L::Set(sphere.center.z);
+    const V radius = L::Set(sphere.radius);
+#endif
+    Run(count,
+        [&](size_t i) -> uint32_t {
+#if defined(KASHIPAN_COLLIDER_BATCH_SIMD)
+            const V distanceSquared = LengthSquared(
+                L::Sub(centerX, L::Load(&spheres.centerX[i])),
+                L::Sub(centerY, L::Load(&spheres.centerY[i])),
+                L::Sub(centerZ, L::Load(&spheres.centerZ[i])));
+            const V radiusSum = L::Add(radius, L::Load(&spheres.radius[i]));
+            return L::MoveMask(L::LessEqual(distanceSquared, L::Mul(radiusSum, radiusSum)));
+#else
+            static_cast<void>(i);
+            return 0;
+#endif
+        },
+        [&](size_t i) {
+            const Sphere other(Vector3(spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i]), spheres.radius[i]);
+            return Collider::IsCollision(sphere, other);
+        },
+        emitter);
+}
+
+template <class Emitter>
+void SphereVsAABBs(const Sphere &sphere, const AABBSoA &aabbs, Emitter &emitter) {
+    const size_t count = aabbs.Size();
+#if defined(KASHIPAN_COLLIDER_BATCH_SIMD)
+    const V centerX = L::Set(sphere.center.x);
+    const V centerY = L::Set(sphere.center.y);
+    const V centerZ = L::Set(sphere.center.z);
+    const V radius = L::Set(sphere.radius);
+    const V radiusSquared = L::Mul(radius, radius);
+#endif
+    Run(count,
+        [&](size_t i) -> uint32_t {
+#if defined(KASHIPAN_COLLIDER_BATCH_SIMD)
+            const V closestX = Clamp(centerX, L::Load(&aabbs.minX[i]), L::Load(&aabbs.maxX[i]));
+            const V closestY = Clamp(centerY, L::Load(&aabbs.minY[i]), L::Load(&aabbs.maxY[i]));
+            const V closestZ = Clamp(centerZ, L::Load(&aabbs.minZ[i]), L::Load(&aabbs.maxZ[i]));
+            const V distanceSquared = LengthSquared(
+                L::Sub(closestX, centerX), L::Sub(closestY, centerY), L::Sub(closestZ, centerZ));
+            return L::MoveMask(L::LessEqual(distanceSquared, radiusSquared));
+#else
+            static_cast<void>(i);
+            return 0;
+#endif
+        },
+        [&](size_t i) {
+            const AABB aabb(Vector3(aabbs.minX[i], aabbs.minY[i], aabbs.minZ[i]),
+                Vector3(aabbs.maxX[i], aabbs.maxY[i], aabbs.maxZ[i]));
+            return Collider::IsCollision(aabb, sphere);
+        },
+        emitter);
+}
+
+template <class Emitter>
+void RayVsSpheres(const Ray &ray, const SphereSoA &spheres, Emitter &emitter) {
+    const size_t count = spheres.Size();
+#if defined(KASHIPAN_COLLIDER_BATCH_SIMD)
+    const V originX = L::Set(ray.origin.x);
+    const V originY = L::Set(ray.origin.y);
+    const V originZ = L::Set(ray.origin.z);
+    const V diffX = L::Set(ray.diff.x);
+    const V diffY = L::Set(ray.diff.y);
+    const V diffZ = L::Set(ray.diff.z);
+    const float diffLengthSquaredScalar = ray.diff.LengthSquared();
+    const bool hasLength = diffLengthSquaredScalar > 0.0f;
+    const V diffLengthSquared = L::Set(diffLengthSquaredScalar);
+    const V zero = L::Set(0.0f);
+#endif
+    Run(count,
+        [&](size_t i) -> uint32_t {
+#if defined(KASHIPAN_COLLIDER_BATCH_SIMD)
+            const V sphereX = L::Load(&spheres.centerX[i]);
+            const V sphereY = L::Load(&spheres.centerY[i]);
+            const V sphereZ = L::Load(&spheres.centerZ[i]);
+            V t = zero;
+            if (hasLength) {
+                const V dot = L::Add(L::Add(
+                    L::Mul(L::Sub(sphereX, originX), diffX),
+                    L::Mul(L::Sub(sphereY, originY), diffY)),
+                    L::Mul(L::Sub(sphereZ, originZ), diffZ));
+                t = L::Div(dot, diffLengthSquared);
+            }
+            t = L::Max(t, zero);
+            const V distanceSquared = LengthSquared(
+                L::Sub(L::Add(originX, L::Mul(diffX, t)), sphereX),
+                L::Sub(L::Add(originY, L::Mul(diffY, t)), sphereY),
+                L::Sub(L::Add(originZ, L::Mul(diffZ, t)), sphereZ));
+            const V radius = L::Load(&spheres.radius[i]);
+            return L::MoveMask(L::LessEqual(distanceSquared, L::Mul(radius, radius)));
+#else
+            static_cast<void>(i);
+            return 0;
+#endif
+        },
+        [&](size_t i) {
+            const Sphere sphere(Vector3(spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i]), spheres.radius[i]);
+            return Collider::IsCollision(sphere, ray);
+        },
+        emitter);
+}
+
+template <class Emitter>
+void RayVsAABBs(const Ray &ray, const AABBSoA &aabbs, Emitter &emitter) {
+    const size_t count = aabbs.Size();
+#if defined(KASHIPAN_COLLIDER_BATCH_SIMD)
+    const V originX = L::Set(ray.origin.x);
+    const V originY = L::Set(ray.origin.y);
+    const V originZ = L::Set(ray.origin.z);
+    const V diffX = L::Set(ray.diff.x);
+    const V diffY = L::Set(ray.diff.y);
+    const V diffZ = L::Set(ray.diff.z);
+    const V zero = L::Set(0.0f);
+#endif
+    Run(count,
+        [&](size_t i) -> uint32_t {
+#if defined(KASHIPAN_COLLIDER_BATCH_SIMD)
+            // スカラー版と同じく逆数を掛けずに割る(結果を一致させるため)
+            const V tMinX = L::Div(L::Sub(L::Load(&aabbs.minX[i]), originX), diffX);
+            const V tMinY = L::Div(L::Sub(L::Load(&aabbs.minY[i]), originY), diffY);
+            const V tMinZ = L::Div(L::Sub(L::Load(&aabbs.minZ[i]), originZ), diffZ);
+            const V tMaxX = L::Div(L::Sub(L::Load(&aabbs.maxX[i]), originX), diffX);
+            const V tMaxY = L::Div(L::Sub(L::Load(&aabbs.maxY[i]), originY), diffY);
+            const V tMaxZ = L::Div(L::Sub(L::Load(&aabbs.maxZ[i]), originZ), diffZ);
+            const V tNearMax = L::Max(L::Min(tMinX, tMaxX), L::Max(L::Min(tMinY, tMaxY), L::Min(tMinZ, tMaxZ)));
+            const V tFarMin = L::Min(L::Max(tMinX, tMaxX), L::Min(L::Max(tMinY, tMaxY), L::Max(tMinZ, tMaxZ)));
+            return L::MoveMask(L::And(L::LessEqual(tNearMax, tFarMin), L::GreaterEqual(tFarMin, zero)));
+#else
+            static_cast<void>(i);
+            return 0;
+#endif
+        },
+        [&](size_t i) {
+            const AABB aabb(Vector3(aabbs.minX[i], aabbs.minY[i], aabbs.minZ[i]),
+                Vector3(aabbs.maxX[i], aabbs.maxY[i], aabbs.maxZ[i]));
+            return Collider::IsCollision(aabb, ray);
+        },
+        emitter);
+}
+
+/// @brief マスクを初期化して判定する
+template <class Query, class SoA, class Kernel>
+size_t RunMask(const Query &query, const SoA &soa, std::span<uint64_t> outMask, Kernel kernel) {
+    const size_t wordCount = GetMaskWordCount(soa.Size());
+    assert(outMask.size() >= wordCount);
+    std::fill_n(outMask.begin(), wordCount, uint64_t{ 0 });
+    MaskEmitter emitter(outMask);
+    kernel(query, soa, emitter);
+    return emitter.GetCount();
+}
+
+/// @brief 添字の配列に書き込んで判定する
+template <class Query, class SoA, class Kernel>
+size_t RunIndices(const Query &query, const SoA &soa, std::span<uint32_t> outIndices, Kernel kernel) {
+    assert(outIndices.size() >= soa.Size());
+    IndexEmitter emitter(outIndices, 0);
+    kernel(query, soa, emitter);
+    return emitter.GetCount();
+}
+
+} // namespace
+
+size_t IsCollision(const Sphere &sphere, const SphereSoA &spheres, std::span<uint64_t> outMask) {
+    return RunMask(sphere, spheres, outMask, SphereVsSpheres<MaskEmitter>);
+}
+
+size_t IsCollision(const Sphere &sphere, const AABBSoA &aabbs, std::span<uint64_t> outMask) {
+    return RunMask(sphere, aabbs, outMask, SphereVsAABBs<MaskEmitter>);
+}
+
+size_t IsCollision(const Ray &ray, const SphereSoA &spheres, std::span<uint64_t> outMask) {
+    return RunMask(ray, spheres, outMask, RayVsSpheres<MaskEmitter>);
+}
+
+size_t IsCollision(const Ray &ray, const AABBSoA &aabbs, std::span<uint64_t> outMask) {
+    return RunMask(ray, aabbs, outMask, RayVsAABBs<MaskEmitter>);
+}
+
+size_t GetCollisionIndices(const Sphere &sphere, const SphereSoA &spheres, std::span<uint32_t> outIndices) {
+    return RunIndices(sphere, spheres, outIndices, SphereVsSpheres<IndexEmitter>);
+}
+
+size_t GetCollisionIndices(const Sphere &sphere, const AABBSoA &aabbs, std::span<uint32_t> outIndices) {
+    return RunIndices(sphere, aabbs, outIndices, SphereVsAABBs<IndexEmitter>);
+}
+
+size_t GetCollisionIndices(const Ray &ray, const SphereSoA &spheres, std::span<uint32_t> outIndices) {
+    return RunIndices(ray, spheres, outIndices, RayVsSpheres<IndexEmitter>);
+}
+
+size_t GetCollisionIndices(const Ray &ray, const AABBSoA &aabbs, std::span<uint32_t> outIndices) {
+    return RunIndices(ray, aabbs, outIndices, RayVsAABBs<IndexEmitter>);
+}
+
+size_t GetCollisionPairs(const SphereSoA &spheresA, const SphereSoA &spheresB, std::vector<CollisionPair> &outPairs) {
+    const size_t countA = spheresA.Size();
+    std::vector<uint32_t> indices(spheresB.Size());
+    const size_t firstPair = outPairs.size();
+    for (size_t a = 0; a < countA; ++a) {
+        const Sphere sphere(Vector3(spheresA.centerX[a], spheresA.centerY[a], spheresA.centerZ[a]), spheresA.radius[a]);
+        IndexEmitter emitter(indices, 0);
+        SphereVsSpheres(sphere, spheresB, emitter);
+        for (size_t i = 0; i < emitter.GetCount(); ++i) {
+            outPairs.push_back(CollisionPair{ static_cast<uint32_t>(a), indices[i] });
+        }
+    }
+    return outPairs.size() - firstPair;
+}
+
+size_t GetCollisionPairs(const SphereSoA &spheres, std::vector<CollisionPair> &outPairs) {
+    const size_t count = spheres.Size();
+    std::vector<uint32_t> indices(count);
+    const size_t firstPair = outPairs.size();
+    for (size_t a = 0; a + 1 < count; ++a) {
+        const Sphere sphere(Vector3(spheres.centerX[a], spheres.centerY[a], spheres.centerZ[a]), spheres.radius[a]);
+        // 自分より後ろの球とだけ判定する
+        IndexEmitter emitter(indices, static_cast<uint32_t>(a + 1));
+        SphereVsSpheres(sphere, spheres.Subspan(a + 1), emitter);
+        for (size_t i = 0; i < emitter.GetCount(); ++i) {
+            outPairs.push_back(CollisionPair{ static_cast<uint32_t>(a), indices[i] });
+        }
+    }
+    return outPairs.size() - firstPair;
+}
+
+} // namespace Collider
+
+} // namespace Math
+
+} // namespace KashipanEngine
\ No newline at end of file
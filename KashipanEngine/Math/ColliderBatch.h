@@ -0,0 +1,155 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace KashipanEngine {
+
+/*
+1つの形状とN個の形状の衝突判定をまとめて行う。AVX2が有効なビルドでは8個ずつ、それ以外ではSSE2で4個ずつ判定する。
+判定される側はx, y, z, 半径などを別々の配列で持つ(SoA)。
+結果は次のどちらかで受け取る。
+  IsCollision          : 衝突している要素のビットを立てたマスク(要素iはmask[i / 64]の(i % 64)ビット目)
+  GetCollisionIndices  : 衝突している要素の添字を小さい順に詰めた配列
+演算の順番をMath::Colliderのスカラー版と揃えているので、1つずつIsCollisionを呼んだ場合と結果は完全に一致する。
+(AABBはmin <= maxであること。スカラー版のstd::clampと同じ前提)
+*/
+
+namespace Math {
+
+struct Sphere;
+struct Ray;
+struct AABB;
+
+/// @brief 球の配列(SoA)の参照
+struct SphereSoA {
+    std::span<const float> centerX;
+    std::span<const float> centerY;
+    std::span<const float> centerZ;
+    std::span<const float> radius;
+
+    /// @brief 要素数を取得
+    [[nodiscard]] size_t Size() const noexcept {
+        assert(centerY.size() == centerX.size() && centerZ.size() == centerX.size() && radius.size() == centerX.size());
+        return centerX.size();
+    }
+    /// @brief 一部分の参照を取得
+    [[nodiscard]] SphereSoA Subspan(size_t offset, size_t count = std::dynamic_extent) const noexcept {
+        return SphereSoA{ centerX.subspan(offset, count), centerY.subspan(offset, count),
+            centerZ.subspan(offset, count), radius.subspan(offset, count) };
+    }
+};
+
+/// @brief AABBの配列(SoA)の参照
+struct AABBSoA {
+    std::span<const float> minX;
+    std::span<const float> minY;
+    std::span<const float> minZ;
+    std::span<const float> maxX;
+    std::span<const float> maxY;
+    std::span<const float> maxZ;
+
+    /// @brief 要素数を取得
+    [[nodiscard]] size_t Size() const noexcept {
+        assert(minY.size() == minX.size() && minZ.size() == minX.size());
+        assert(maxX.size() == minX.size() && maxY.size() == minX.size() && maxZ.size() == minX.size());
+        return minX.size();
+    }
+    /// @brief 一部分の参照を取得
+    [[nodiscard]] AABBSoA Subspan(size_t offset, size_t count = std::dynamic_extent) const noexcept {
+        return AABBSoA{ minX.subspan(offset, count), minY.subspan(offset, count), minZ.subspan(offset, count),
+            maxX.subspan(offset, count), maxY.subspan(offset, count), maxZ.subspan(offset, count) };
+    }
+};
+
+/// @brief 衝突している組の添字
+struct CollisionPair {
+    uint32_t indexA;
+    uint32_t indexB;
+};
+
+namespace Collider {
+
+/// @brief 要素数に対して必要なマスクのワード数を取得
+/// @param count 要素数
+/// @return マスクのワード数
+[[nodiscard]] constexpr size_t GetMaskWordCount(size_t count) noexcept {
+    return (count + 63) / 64;
+}
+
+/// @brief 球と球の配列の衝突判定
+/// @param sphere 衝突判定を行う球
+/// @param spheres 衝突判定を行う球の配列
+/// @param outMask 結果のマスク(GetMaskWordCount(spheres.Size())ワード以上)
+/// @return 衝突している数
+size_t IsCollision(const Sphere &sphere, const SphereSoA &spheres, std::span<uint64_t> outMask);
+
+/// @brief 球とAABBの配列の衝突判定
+/// @param sphere 衝突判定を行う球
+/// @param aabbs 衝突判定を行うAABBの配列
+/// @param outMask 結果のマスク(GetMaskWordCount(aabbs.Size())ワード以上)
+/// @return 衝突している数
+size_t IsCollision(const Sphere &sphere, const AABBSoA &aabbs, std::span<uint64_t> outMask);
+
+/// @brief 半直線と球の配列の衝突判定
+/// @param ray 衝突判定を行う半直線
+/// @param spheres 衝突判定を行う球の配列
+/// @param outMask 結果のマスク(GetMaskWordCount(spheres.Size())ワード以上)
+/// @return 衝突している数
+size_t IsCollision(const Ray &ray, const SphereSoA &spheres, std::span<uint64_t> outMask);
+
+/// @brief 半直線とAABBの配列の衝突判定
+/// @param ray 衝突判定を行う半直線
+/// @param aabbs 衝突判定を行うAABBの配列
+/// @param outMask 結果のマスク(GetMaskWordCount(aabbs.Size())ワード以上)
+/// @return 衝突している数
+size_t IsCollision(const Ray &ray, const AABBSoA &aabbs, std::span<uint64_t> outMask);
+
+/// @brief 球と球の配列の衝突判定
+/// @param sphere 衝突判定を行う球
+/// @param spheres 衝突判定を行う球の配列
+/// @param outIndices 衝突している球の添字の出力先(spheres.Size()個以上)
+/// @return 衝突している数
+size_t GetCollisionIndices(const Sphere &sphere, const SphereSoA &spheres, std::span<uint32_t> outIndices);
+
+/// @brief 球とAABBの配列の衝突判定
+/// @param sphere 衝突判定を行う球
+/// @param aabbs 衝突判定を行うAABBの配列
+/// @param outIndices 衝突しているAABBの添字の出力先(aabbs.Size()個以上)
+/// @return 衝突している数
+size_t GetCollisionIndices(const Sphere &sphere, const AABBSoA &aabbs, std::span<uint32_t> outIndices);
+
+/// @brief 半直線と球の配列の衝突判定
+/// @param ray 衝突判定を行う半直線
+/// @param spheres 衝突判定を行う球の配列
+/// @param outIndices 衝突している球の添字の出力先(spheres.Size()個以上)
+/// @return 衝突している数
+size_t GetCollisionIndices(const Ray &ray, const SphereSoA &spheres, std::span<uint32_t> outIndices);
+
+/// @brief 半直線とAABBの配列の衝突判定
+/// @param ray 衝突判定を行う半直線
+/// @param aabbs 衝突判定を行うAABBの配列
+/// @param outIndices 衝突しているAABBの添字の出力先(aabbs.Size()個以上)
+/// @return 衝突している数
+size_t GetCollisionIndices(const Ray &ray, const AABBSoA &aabbs, std::span<uint32_t> outIndices);
+
+/// @brief 球の配列同士の衝突判定(N×M)
+/// @param spheresA 衝突判定を行う球の配列A
+/// @param spheresB 衝突判定を行う球の配列B
+/// @param outPairs 衝突している組の追加先(indexAの昇順、同じindexAの中ではindexBの昇順)
+/// @return 追加した組の数
+size_t GetCollisionPairs(const SphereSoA &spheresA, const SphereSoA &spheresB, std::vector<CollisionPair> &outPairs);
+
+/// @brief 同じ球の配列内での衝突判定(indexA < indexBの組だけを返す)
+/// @param spheres 衝突判定を行う球の配列
+/// @param outPairs 衝突している組の追加先(indexAの昇順、同じindexAの中ではindexBの昇順)
+/// @return 追加した組の数
+size_t GetCollisionPairs(const SphereSoA &spheres, std::vector<CollisionPair> &outPairs);
+
+} // namespace Collider
+
+} // namespace Math
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,464 @@
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numbers>
+#include <span>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#ifndef KASHIPAN_MATH_SSE2
+#define KASHIPAN_MATH_SSE2
+#endif
+#endif
+
+// 1のときMath::Gameplayの関数は近似版を使い、0のときは標準ライブラリを使う。
+// 誤差で見た目や判定が変わらないことを確かめてから使うものなので、既定は0にしてビルドの設定で有効にする
+#ifndef KASHIPAN_FAST_MATH
+#define KASHIPAN_FAST_MATH 0
+#endif
+
+namespace KashipanEngine {
+
+/*
+ゲームプレイ用の近似の超越関数。多項式はミニマックス近似で、誤差はlibm(double)との比較で測った最大値。
+Atan2以外は範囲内の全てのfloatで、Atan2はランダムな3億組で測った。
+  SinCos : |x| <= 8192 で絶対誤差 9.4e-8(範囲を広げるほど引数の縮約の誤差が増える)
+  Atan2  : 絶対誤差 2.0e-6 ラジアン
+  Acos   : 絶対誤差 4.4e-7 ラジアン(入力は[-1, 1]に丸める)
+  Rsqrt  : 相対誤差 2.5e-7(SSEのrsqrtをニュートン法で1回補正)。SSEが無ければビット演算の初期値から2回補正で 4.8e-6
+  Exp    : 相対誤差 8.2e-8(xは-87.3～88.3に丸める)
+Tests/FastMathTests.cppでこの値を超えないことを確かめている。
+配列版はSSE2で4要素ずつ計算する。スカラー版と同じ多項式を使うので誤差も同じ。
+呼び出し側はMath::Gameplayの関数を使えば、KASHIPAN_FAST_MATHで標準ライブラリと切り替えられる。
+*/
+
+namespace Math::Fast {
+
+namespace Internal {
+
+// π/2を3つに分けたもの(引数の縮約で桁落ちしないように)
+inline constexpr float kPiOver2A = 1.5703125f;
+inline constexpr float kPiOver2B = 4.837512969970703125e-4f;
+inline constexpr float kPiOver2C = 7.54978995489188216e-8f;
+inline constexpr float kTwoOverPi = 0.636619772367581343f;
+
+// sinの係数(r + r^3 * (S1 + r^2 * (S2 + r^2 * S3)))
+inline constexpr float kSin1 = -1.6666654611e-1f;
+inline constexpr float kSin2 = 8.3321608736e-3f;
+inline constexpr float kSin3 = -1.9515295891e-4f;
+// cosの係数(1 - r^2 / 2 + r^4 * (C1 + r^2 * (C2 + r^2 * C3)))
+inline constexpr float kCos1 = 4.166664568298827e-2f;
+inline constexpr float kCos2 = -1.388731625493765e-3f;
+inline constexpr float kCos3 = 2.443315711809948e-5f;
+
+// [0, 1]でのatanの係数(奇数次)
+inline constexpr float kAtan1 = 0.99997726f;
+inline constexpr float kAtan3 = -0.33262347f;
+inline constexpr float kAtan5 = 0.19354346f;
+inline constexpr float kAtan7 = -0.11643287f;
+inline constexpr float kAtan9 = 0.05265332f;
+inline constexpr float kAtan11 = -0.01172120f;
+
+// [0, 1]でのacos(x) / sqrt(1 - x)の係数
+inline constexpr float kAcos0 = 1.5707963050f;
+inline constexpr float kAcos1 = -0.2145988016f;
+inline constexpr float kAcos2 = 0.0889789874f;
+inline constexpr float kAcos3 = -0.0501743046f;
+inline constexpr float kAcos4 = 0.0308918810f;
+inline constexpr float kAcos5 = -0.0170881256f;
+inline constexpr float kAcos6 = 0.0066700901f;
+inline constexpr float kAcos7 = -0.0012624911f;
+
+// [-ln2/2, ln2/2]でのe^rの係数(1 + r + r^2 * (E1 + r * (E2 + ...)))
+inline constexpr float kExp1 = 5.0000001201e-1f;
+inline constexpr float kExp2 = 1.6666665459e-1f;
+inline constexpr float kExp3 = 4.1665795894e-2f;
+inline constexpr float kExp4 = 8.3334519073e-3f;
+inline constexpr float kExp5 = 1.3981999507e-3f;
+inline constexpr float kExp6 = 1.9875691500e-4f;
+// ln2を2つに分けたもの
+inline constexpr float kLn2A = 0.693359375f;
+inline constexpr float kLn2B = -2.12194440e-4f;
+inline constexpr float kLog2E = 1.44269504088896341f;
+inline constexpr float kExpMin = -87.3f;
+inline constexpr float kExpMax = 88.3f;
+
+inline float BitsToFloat(uint32_t bits) noexcept {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline uint32_t FloatToBits(float value) noexcept {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+#ifdef KASHIPAN_MATH_SSE2
+
+inline __m128 Abs4(__m128 v) noexcept {
+    return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+}
+
+inline __m128 Select4(__m128 mask, __m128 a, __m128 b) noexcept {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline void SinCos4(__m128 x, __m128 &outSin, __m128 &outCos) noexcept {
+    const __m128i k = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(kTwoOverPi)));
+    const __m128 kf = _mm_cvtepi32_ps(k);
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(kf, _mm_set1_ps(kPiOver2A)));
+    r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(kPiOver2B)));
+    r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(kPiOver2C)));
+    const __m128 z = _mm_mul_ps(r, r);
+
+    __m128 s = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(kSin3)), _mm_set1_ps(kSin2));
+    s = _mm_add_ps(_mm_mul_ps(z, s), _mm_set1_ps(kSin1));
+    s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), s));
+
+    __m128 c = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(kCos3)), _mm_set1_ps(kCos2));
+    c = _mm_add_ps(_mm_mul_ps(z, c), _mm_set1_ps(kCos1));
+    c = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_mul_ps(_mm_mul_ps(z, z), c));
+
+    // 象限に応じてsinとcosを入れ替え、符号を反転する
+    const __m128 swapMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(k, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+    const __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(k, _mm_set1_epi32(2)), 30));
+    const __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(k, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+    outSin = _mm_xor_ps(Select4(swapMask, c, s), sinSign);
+    outCos = _mm_xor_ps(Select4(swapMask, s, c), cosSign);
+}
+
+inline __m128 Atan2_4(__m128 y, __m128 x) noexcept {
+    const __m128 absY = Abs4(y);
+    const __m128 absX = Abs4(x);
+    const __m128 maxValue = _mm_max_ps(absX, absY);
+    const __m128 minValue = _mm_min_ps(absX, absY);
+    // 両方0のときは0を返す
+    const __m128 isZero = _mm_cmpeq_ps(maxValue, _mm_setzero_ps());
+    const __m128 a = _mm_andnot_ps(isZero, _mm_div_ps(minValue, Select4(isZero, _mm_set1_ps(1.0f), maxValue)));
+    const __m128 s = _mm_mul_ps(a, a);
+
+    __m128 p = _mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(kAtan11)), _mm_set1_ps(kAtan9));
+    p = _mm_add_ps(_mm_mul_ps(s, p), _mm_set1_ps(kAtan7));
+    p = _mm_add_ps(_mm_mul_ps(s, p), _mm_set1_ps(kAtan5));
+    p = _mm_add_ps(_mm_mul_ps(s, p), _mm_set1_ps(kAtan3));
+    p = _mm_add_ps(_mm_mul_ps(s, p), _mm_set1_ps(kAtan1));
+    p = _mm_mul_ps(a, p);
+
+    p = Select4(_mm_cmpgt_ps(absY, absX), _mm_sub_ps(_mm_set1_ps(std::numbers::pi_v<float> * 0.5f), p), p);
+    p = Select4(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(std::numbers::pi_v<float>), p), p);
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+    return _mm_or_ps(p, _mm_and_ps(y, signMask));
+}
+
+inline __m128 Acos4(__m128 x) noexcept {
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+    const __m128 a = Abs4(x);
+
+    __m128 p = _mm_add_ps(_mm_mul_ps(a, _mm_set1_ps(kAcos7)), _mm_set1_ps(kAcos6));
+    p = _mm_add_ps(_mm_mul_ps(a, p), _mm_set1_ps(kAcos5));
+    p = _mm_add_ps(_mm_mul_ps(a, p), _mm_set1_ps(kAcos4));
+    p = _mm_add_ps(_mm_mul_ps(a, p), _mm_set1_ps(kAcos3));
+    p = _mm_add_ps(_mm_mul_ps(a, p), _mm_set1_ps(kAcos2));
+    p = _mm_add_ps(_mm_mul_ps(a, p), _mm_set1_ps(kAcos1));
+    p = _mm_add_ps(_mm_mul_ps(a, p), _mm_set1_ps(kAcos0));
+    p = _mm_mul_ps(p, _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), a)));
+
+    return Select4(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(std::numbers::pi_v<float>), p), p);
+}
+
+inline __m128 Rsqrt4(__m128 x) noexcept {
+    const __m128 r = _mm_rsqrt_ps(x);
+    // ニュートン法で1回補正する
+    const __m128 halfXrr = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), _mm_mul_ps(r, r));
+    return _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), halfXrr));
+}
+
+inline __m128 Exp4(__m128 x) noexcept {
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(kExpMin)), _mm_set1_ps(kExpMax));
+    // e^x = 2^n * e^r (nはx / ln2に最も近い整数、rは-ln2/2～ln2/2)
+    const __m128i n = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(kLog2E)));
+    const __m128 nf = _mm_cvtepi32_ps(n);
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(nf, _mm_set1_ps(kLn2A)));
+    r = _mm_sub_ps(r, _mm_mul_ps(nf, _mm_set1_ps(kLn2B)));
+
+    __m128 p = _mm_add_ps(_mm_mul_ps(r, _mm_set1_ps(kExp6)), _mm_set1_ps(kExp5));
+    p = _mm_add_ps(_mm_mul_ps(r, p), _mm_set1_ps(kExp4));
+    p = _mm_add_ps(_mm_mul_ps(r, p), _mm_set1_ps(kExp3));
+    p = _mm_add_ps(_mm_mul_ps(r, p), _mm_set1_ps(kExp2));
+    p = _mm_add_ps(_mm_mul_ps(r, p), _mm_set1_ps(kExp1));
+    p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(r, r), p), r), _mm_set1_ps(1.0f));
+
+    const __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+    return _mm_mul_ps(p, scale);
+}
+
+#endif // KASHIPAN_MATH_SSE2
+
+} // namespace Internal
+
+/// @brief sinとcosを同時に計算する
+/// @param x 角度(ラジアン)
+/// @param outSin sinの出力先
+/// @param outCos cosの出力先
+inline void SinCos(float x, float &outSin, float &outCos) noexcept {
+    using namespace Internal;
+    const float q = x * kTwoOverPi;
+    const int32_t k = static_cast<int32_t>(q + std::copysign(0.5f, q));
+    const float kf = static_cast<float>(k);
+    float r = x - kf * kPiOver2A;
+    r = r - kf * kPiOver2B;
+    r = r - kf * kPiOver2C;
+    const float z = r * r;
+
+    const float s = r + (r * z) * (kSin1 + z * (kSin2 + z * kSin3));
+    const float c = (1.0f - z * 0.5f) + (z * z) * (kCos1 + z * (kCos2 + z * kCos3));
+
+    // 象限に応じてsinとcosを入れ替え、符号を反転する
+    const bool isSwap = (k & 1) != 0;
+    const uint32_t sinSign = static_cast<uint32_t>(k & 2) << 30;
+    const uint32_t cosSign = static_cast<uint32_t>((k + 1) & 2) << 30;
+    outSin = BitsToFloat(FloatToBits(isSwap ? c : s) ^ sinSign);
+    outCos = BitsToFloat(FloatToBits(isSwap ? s : c) ^ cosSign);
+}
+
+/// @brief sinを計算する
+/// @param x 角度(ラジアン)
+/// @return sin(x)
+inline float Sin(float x) noexcept {
+    float s, c;
+    SinCos(x, s, c);
+    return s;
+}
+
+/// @brief cosを計算する
+/// @param x 角度(ラジアン)
+/// @return cos(x)
+inline float Cos(float x) noexcept {
+    float s, c;
+    SinCos(x, s, c);
+    return c;
+}
+
+/// @brief atan2を計算する
+/// @param y y成分
+/// @param x x成分
+/// @return 角度(-π～π)。x, yが両方0なら0
+inline float Atan2(float y, float x) noexcept {
+    using namespace Internal;
+    const float absY = std::fabs(y);
+    const float absX = std::fabs(x);
+    const float maxValue = (absX > absY) ? absX : absY;
+    const float minValue = (absX > absY) ? absY : absX;
+    const float a = (maxValue == 0.0f) ? 0.0f : minValue / maxValue;
+    const float s = a * a;
+
+    float p = a * (kAtan1 + s * (kAtan3 + s * (kAtan5 + s * (kAtan7 + s * (kAtan9 + s * kAtan11)))));
+    // 分岐予測が外れないよう、条件分岐ではなく選択で象限を戻す
+    p = (absY > absX) ? std::numbers::pi_v<float> * 0.5f - p : p;
+    p = (x < 0.0f) ? std::numbers::pi_v<float> - p : p;
+    return std::copysign(p, y);
+}
+
+/// @brief acosを計算する
+/// @param x 値(-1～1の範囲外は丸める)
+/// @return 角度(0～π)
+inline float Acos(float x) noexcept {
+    using namespace Internal;
+    x = (x < -1.0f) ? -1.0f : (x > 1.0f) ? 1.0f : x;
+    const float a = std::fabs(x);
+    float p = kAcos0 + a * (kAcos1 + a * (kAcos2 + a * (kAcos3 + a * (kAcos4 + a * (kAcos5 + a * (kAcos6 + a * kAcos7))))));
+    p *= std::sqrt(1.0f - a);
+    return (x < 0.0f) ? std::numbers::pi_v<float> - p : p;
+}
+
+/// @brief 平方根の逆数を計算する
+/// @param x 値(正の数)
+/// @return 1 / sqrt(x)
+inline float Rsqrt(float x) noexcept {
+#ifdef KASHIPAN_MATH_SSE2
+    return _mm_cvtss_f32(Internal::Rsqrt4(_mm_set_ss(x)));
+#else
+    // 指数を半分にする初期値からニュートン法で2回補正する
+    float r = Internal::BitsToFloat(0x5f375a86u - (Internal::FloatToBits(x) >> 1));
+    r = r * (1.5f - 0.5f * x * r * r);
+    r = r * (1.5f - 0.5f * x * r * r);
+    return r;
+#endif
+}
+
+/// @brief expを計算する
+/// @param x 指数
+/// @return e^x
+inline float Exp(float x) noexcept {
+    using namespace Internal;
+    x = (x < kExpMin) ? kExpMin : (x > kExpMax) ? kExpMax : x;
+    // e^x = 2^n * e^r (nはx / ln2に最も近い整数、rは-ln2/2～ln2/2)
+    const float t = x * kLog2E;
+    const int32_t n = static_cast<int32_t>(t + std::copysign(0.5f, t));
+    const float nf = static_cast<float>(n);
+    float r = x - nf * kLn2A;
+    r = r - nf * kLn2B;
+    const float p = 1.0f + (r + (r * r) * (kExp1 + r * (kExp2 + r * (kExp3 + r * (kExp4 + r * (kExp5 + r * kExp6))))));
+    return p * BitsToFloat(static_cast<uint32_t>(n + 127) << 23);
+}
+
+/// @brief 配列の各要素のsinとcosを計算する
+/// @param x 角度(ラジアン)の配列
+/// @param outSin sinの出力先(xと同じ要素数)
+/// @param outCos cosの出力先(xと同じ要素数)
+inline void SinCos(std::span<const float> x, std::span<float> outSin, std::span<float> outCos) noexcept {
+    assert(outSin.size() >= x.size() && outCos.size() >= x.size());
+    size_t i = 0;
+#ifdef KASHIPAN_MATH_SSE2
+    for (; i + 4 <= x.size(); i += 4) {
+        __m128 s, c;
+        Internal::SinCos4(_mm_loadu_ps(&x[i]), s, c);
+        _mm_storeu_ps(&outSin[i], s);
+        _mm_storeu_ps(&outCos[i], c);
+    }
+#endif
+    for (; i < x.size(); ++i) {
+        SinCos(x[i], outSin[i], outCos[i]);
+    }
+}
+
+/// @brief 配列の各要素のatan2を計算する
+/// @param y y成分の配列
+/// @param x x成分の配列(yと同じ要素数)
+/// @param out 出力先(yと同じ要素数)
+inline void Atan2(std::span<const float> y, std::span<const float> x, std::span<float> out) noexcept {
+    assert(x.size() >= y.size() && out.size() >= y.size());
+    size_t i = 0;
+#ifdef KASHIPAN_MATH_SSE2
+    for (; i + 4 <= y.size(); i += 4) {
+        _mm_storeu_ps(&out[i], Internal::Atan2_4(_mm_loadu_ps(&y[i]), _mm_loadu_ps(&x[i])));
+    }
+#endif
+    for (; i < y.size(); ++i) {
+        out[i] = Atan2(y[i], x[i]);
+    }
+}
+
+/// @brief 配列の各要素のacosを計算する
+/// @param x 値の配列
+/// @param out 出力先(xと同じ要素数)
+inline void Acos(std::span<const float> x, std::span<float> out) noexcept {
+    assert(out.size() >= x.size());
+    size_t i = 0;
+#ifdef KASHIPAN_MATH_SSE2
+    for (; i + 4 <= x.size(); i += 4) {
+        _mm_storeu_ps(&out[i], Internal::Acos4(_mm_loadu_ps(&x[i])));
+    }
+#endif
+    for (; i < x.size(); ++i) {
+        out[i] = Acos(x[i]);
+    }
+}
+
+/// @brief 配列の各要素の平方根の逆数を計算する
+/// @param x 値の配列
+/// @param out 出力先(xと同じ要素数)
+inline void Rsqrt(std::span<const float> x, std::span<float> out) noexcept {
+    assert(out.size() >= x.size());
+    size_t i = 0;
+#ifdef KASHIPAN_MATH_SSE2
+    for (; i + 4 <= x.size(); i += 4) {
+        _mm_storeu_ps(&out[i], Internal::Rsqrt4(_mm_loadu_ps(&x[i])));
+    }
+#endif
+    for (; i < x.size(); ++i) {
+        out[i] = Rsqrt(x[i]);
+    }
+}
+
+/// @brief 配列の各要素のexpを計算する
+/// @param x 指数の配列
+/// @param out 出力先(xと同じ要素数)
+inline void Exp(std::span<const float> x, std::span<float> out) noexcept {
+    assert(out.size() >= x.size());
+    size_t i = 0;
+#ifdef KASHIPAN_MATH_SSE2
+    for (; i + 4 <= x.size(); i += 4) {
+        _mm_storeu_ps(&out[i], Internal::Exp4(_mm_loadu_ps(&x[i])));
+    }
+#endif
+    for (; i < x.size(); ++i) {
+        out[i] = Exp(x[i]);
+    }
+}
+
+} // namespace Math::Fast
+
+namespace Math::Gameplay {
+
+/// @brief sinとcosを同時に計算する(KASHIPAN_FAST_MATHで近似版と切り替え)
+inline void SinCos(float x, float &outSin, float &outCos) noexcept {
+#if KASHIPAN_FAST_MATH
+    Fast::SinCos(x, outSin, outCos);
+#else
+    outSin = std::sin(x);
+    outCos = std::cos(x);
+#endif
+}
+
+/// @brief sinを計算する(KASHIPAN_FAST_MATHで近似版と切り替え)
+inline float Sin(float x) noexcept {
+#if KASHIPAN_FAST_MATH
+    return Fast::Sin(x);
+#else
+    return std::sin(x);
+#endif
+}
+
+/// @brief cosを計算する(KASHIPAN_FAST_MATHで近似版と切り替え)
+inline float Cos(float x) noexcept {
+#if KASHIPAN_FAST_MATH
+    return Fast::Cos(x);
+#else
+    return std::cos(x);
+#endif
+}
+
+/// @brief atan2を計算する(KASHIPAN_FAST_MATHで近似版と切り替え)
+inline float Atan2(float y, float x) noexcept {
+#if KASHIPAN_FAST_MATH
+    return Fast::Atan2(y, x);
+#else
+    return std::atan2(y, x);
+#endif
+}
+
+/// @brief acosを計算する(KASHIPAN_FAST_MATHで近似版と切り替え)
+inline float Acos(float x) noexcept {
+#if KASHIPAN_FAST_MATH
+    return Fast::Acos(x);
+#else
+    return std::acos(x);
+#endif
+}
+
+/// @brief 平方根の逆数を計算する(KASHIPAN_FAST_MATHで近似版と切り替え)
+inline float Rsqrt(float x) noexcept {
+#if KASHIPAN_FAST_MATH
+    return Fast::Rsqrt(x);
+#else
+    return 1.0f / std::sqrt(x);
+#endif
+}
+
+/// @brief expを計算する(KASHIPAN_FAST_MATHで近似版と切り替え)
+inline float Exp(float x) noexcept {
+#if KASHIPAN_FAST_MATH
+    return Fast::Exp(x);
+#else
+    return std::exp(x);
+#endif
+}
+
+} // namespace Math::Gameplay
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -1,7 +1,6 @@
 #include "Sphere.h"
 #include "Math/Collider.h"
 #include <cmath>
-#define M_PI (4.0f * std::atanf(1.0f))
 
 namespace KashipanEngine {
 
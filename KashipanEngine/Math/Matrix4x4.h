@@ -1,8 +1,12 @@
 #pragma once
+#include <cmath>
+#include <type_traits>
+#include "MatrixSimd.h"
 
 namespace KashipanEngine {
 
 struct Vector3;
+struct Quaternion;
 
 struct Matrix4x4 {
     // 大量に呼び出されるであろうデフォルトコンストラクタは軽量化のため何もしないようにしておく
@@ -54,10 +58,10 @@ struct Matrix4x4 {
         float m[3][3];
     };
 
-    Matrix4x4 &operator+=(const Matrix4x4 &matrix) noexcept;
-    Matrix4x4 &operator-=(const Matrix4x4 &matrix) noexcept;
-    Matrix4x4 &operator*=(const float scalar) noexcept;
-    Matrix4x4 &operator*=(const Matrix4x4 &matrix) noexcept;
+    constexpr Matrix4x4 &operator+=(const Matrix4x4 &matrix) noexcept;
+    constexpr Matrix4x4 &operator-=(const Matrix4x4 &matrix) noexcept;
+    constexpr Matrix4x4 &operator*=(const float scalar) noexcept;
+    constexpr Matrix4x4 &operator*=(const Matrix4x4 &matrix) noexcept;
     constexpr const Matrix4x4 operator+(const Matrix4x4 &matrix) const noexcept;
     constexpr const Matrix4x4 operator-(const Matrix4x4 &matrix) const noexcept;
     constexpr const Matrix4x4 operator*(const float scalar) const noexcept;
@@ -65,38 +69,48 @@ struct Matrix4x4 {
 
     /// @brief 単位行列を取得する
     /// @return 単位行列
-    [[nodiscard]] static const Matrix4x4 Identity() noexcept;
+    [[nodiscard]] static constexpr const Matrix4x4 Identity() noexcept;
 
     /// @brief 転置行列を取得する
     /// @return 転置行列
-    [[nodiscard]] const Matrix4x4 Transpose() noexcept;
+    [[nodiscard]] constexpr const Matrix4x4 Transpose() noexcept;
 
     /// @brief 行列式を計算する
     /// @return 行列式
-    [[nodiscard]] const float Determinant() const noexcept;
+    [[nodiscard]] constexpr const float Determinant() const noexcept;
 
     /// @brief 逆行列を計算する
     /// @return 逆行列
-    [[nodiscard]] Matrix4x4 Inverse() const;
+    [[nodiscard]] constexpr Matrix4x4 Inverse() const;
+
+    /// @brief 回転と平行移動だけの行列(剛体変換)の逆行列を計算する
+    /// @return 逆行列
+    /// @note 拡大縮小を含む行列には使えない。回転部分の転置で済むので一般の逆行列より速い
+    [[nodiscard]] constexpr Matrix4x4 InverseRigid() const noexcept;
+
+    /// @brief 4列目が(0, 0, 0, 1)のアフィン行列の逆行列を計算する
+    /// @return 逆行列
+    /// @note 3x3部分の逆行列と平行移動の変換だけで済むので一般の逆行列より速い
+    [[nodiscard]] constexpr Matrix4x4 InverseAffine() const;
 
     /// @brief 自身を単位行列にする
-    void MakeIdentity() noexcept;
+    constexpr void MakeIdentity() noexcept;
 
     /// @brief 自身を転置行列にする
-    void MakeTranspose() noexcept;
+    constexpr void MakeTranspose() noexcept;
 
     /// @brief 自身を逆行列にする
-    void MakeInverse() noexcept;
+    constexpr void MakeInverse() noexcept;
 
     /// @brief 平行移動行列を生成する
     /// @param translate 平行移動ベクトル
     /// @return 平行移動行列
-    void MakeTranslate(const Vector3 &translate) noexcept;
+    constexpr void MakeTranslate(const Vector3 &translate) noexcept;
 
     /// @brief 拡大縮小行列を生成する
     /// @param scale 拡大縮小ベクトル
     /// @return 拡大縮小行列
-    void MakeScale(const Vector3 &scale) noexcept;
+    constexpr void MakeScale(const Vector3 &scale) noexcept;
 
     /// @brief 回転行列を生成する
     /// @param rotate 回転角度
@@ -137,7 +151,549 @@ struct Matrix4x4 {
         const Vector3 &rotate,
         const Vector3 &translate) noexcept;
 
+    /// @brief アフィン行列を生成する
+    /// @param scale 拡大縮小ベクトル
+    /// @param rotate 回転クォータニオン(正規化済み)
+    /// @param translate 平行移動ベクトル
+    constexpr void MakeAffine(
+        const Vector3 &scale,
+        const Quaternion &rotate,
+        const Vector3 &translate) noexcept;
+
     float m[4][4];
 };
 
+} // namespace KashipanEngine
+
+// Vector3とQuaternionはMatrix4x4の定義の後に読み込む(互いに読み込み合っても定義の順番が崩れないように)
+#include "Vector3.h"
+#include "Quaternion.h"
+
+namespace KashipanEngine {
+
+inline constexpr float Matrix4x4::Matrix2x2::Determinant() const noexcept {
+    return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+}
+
+inline constexpr float Matrix4x4::Matrix3x3::Determinant() const noexcept {
+    float c00 = Matrix2x2(m[1][1], m[1][2], m[2][1], m[2][2]).Determinant();
+    float c01 = -(Matrix2x2(m[1][0], m[1][2], m[2][0], m[2][2]).Determinant());
+    float c02 = Matrix2x2(m[1][0], m[1][1], m[2][0], m[2][1]).Determinant();
+    return m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+}
+
+inline constexpr Matrix4x4 &Matrix4x4::operator+=(const Matrix4x4 &matrix) noexcept {
+    // 少しでも速度を稼ぐためにループではなく展開する
+    m[0][0] += matrix.m[0][0];
+    m[0][1] += matrix.m[0][1];
+    m[0][2] += matrix.m[0][2];
+    m[0][3] += matrix.m[0][3];
+
+    m[1][0] += matrix.m[1][0];
+    m[1][1] += matrix.m[1][1];
+    m[1][2] += matrix.m[1][2];
+    m[1][3] += matrix.m[1][3];
+
+    m[2][0] += matrix.m[2][0];
+    m[2][1] += matrix.m[2][1];
+    m[2][2] += matrix.m[2][2];
+    m[2][3] += matrix.m[2][3];
+
+    m[3][0] += matrix.m[3][0];
+    m[3][1] += matrix.m[3][1];
+    m[3][2] += matrix.m[3][2];
+    m[3][3] += matrix.m[3][3];
+
+    return *this;
+}
+
+inline constexpr Matrix4x4 &Matrix4x4::operator-=(const Matrix4x4 &matrix) noexcept {
+    // 少しでも速度を稼ぐためにループではなく展開する
+    m[0][0] -= matrix.m[0][0];
+    m[0][1] -= matrix.m[0][1];
+    m[0][2] -= matrix.m[0][2];
+    m[0][3] -= matrix.m[0][3];
+
+    m[1][0] -= matrix.m[1][0];
+    m[1][1] -= matrix.m[1][1];
+    m[1][2] -= matrix.m[1][2];
+    m[1][3] -= matrix.m[1][3];
+
+    m[2][0] -= matrix.m[2][0];
+    m[2][1] -= matrix.m[2][1];
+    m[2][2] -= matrix.m[2][2];
+    m[2][3] -= matrix.m[2][3];
+
+    m[3][0] -= matrix.m[3][0];
+    m[3][1] -= matrix.m[3][1];
+    m[3][2] -= matrix.m[3][2];
+    m[3][3] -= matrix.m[3][3];
+
+    return *this;
+}
+
+inline constexpr Matrix4x4 &Matrix4x4::operator*=(const float scalar) noexcept {
+    // 少しでも速度を稼ぐためにループではなく展開する
+    m[0][0] *= scalar;
+    m[0][1] *= scalar;
+    m[0][2] *= scalar;
+    m[0][3] *= scalar;
+
+    m[1][0] *= scalar;
+    m[1][1] *= scalar;
+    m[1][2] *= scalar;
+    m[1][3] *= scalar;
+
+    m[2][0] *= scalar;
+    m[2][1] *= scalar;
+    m[2][2] *= scalar;
+    m[2][3] *= scalar;
+
+    m[3][0] *= scalar;
+    m[3][1] *= scalar;
+    m[3][2] *= scalar;
+    m[3][3] *= scalar;
+
+    return *this;
+}
+
+inline constexpr Matrix4x4 &Matrix4x4::operator*=(const Matrix4x4 &matrix) noexcept {
+    *this = *this * matrix;
+    return *this;
+}
+
+inline constexpr const Matrix4x4 Matrix4x4::operator+(const Matrix4x4 &matrix) const noexcept {
+    // 少しでも速度を稼ぐためにループではなく展開する
+    return Matrix4x4(
+        m[0][0] + matrix.m[0][0], m[0][1] + matrix.m[0][1], m[0][2] + matrix.m[0][2], m[0][3] + matrix.m[0][3],
+        m[1][0] + matrix.m[1][0], m[1][1] + matrix.m[1][1], m[1][2] + matrix.m[1][2], m[1][3] + matrix.m[1][3],
+        m[2][0] + matrix.m[2][0], m[2][1] + matrix.m[2][1], m[2][2] + matrix.m[2][2], m[2][3] + matrix.m[2][3],
+        m[3][0] + matrix.m[3][0], m[3][1] + matrix.m[3][1], m[3][2] + matrix.m[3][2], m[3][3] + matrix.m[3][3]
+    );
+}
+
+inline constexpr const Matrix4x4 Matrix4x4::operator-(const Matrix4x4 &matrix) const noexcept {
+    // 少しでも速度を稼ぐためにループではなく展開する
+    return Matrix4x4(
+        m[0][0] - matrix.m[0][0], m[0][1] - matrix.m[0][1], m[0][2] - matrix.m[0][2], m[0][3] - matrix.m[0][3],
+        m[1][0] - matrix.m[1][0], m[1][1] - matrix.m[1][1], m[1][2] - matrix.m[1][2], m[1][3] - matrix.m[1][3],
+        m[2][0] - matrix.m[2][0], m[2][1] - matrix.m[2][1], m[2][2] - matrix.m[2][2], m[2][3] - matrix.m[2][3],
+        m[3][0] - matrix.m[3][0], m[3][1] - matrix.m[3][1], m[3][2] - matrix.m[3][2], m[3][3] - matrix.m[3][3]
+    );
+}
+
+inline constexpr const Matrix4x4 Matrix4x4::operator*(const float scalar) const noexcept {
+    // 少しでも速度を稼ぐためにループではなく展開する
+    return Matrix4x4(
+        m[0][0] * scalar, m[0][1] * scalar, m[0][2] * scalar, m[0][3] * scalar,
+        m[1][0] * scalar, m[1][1] * scalar, m[1][2] * scalar, m[1][3] * scalar,
+        m[2][0] * scalar, m[2][1] * scalar, m[2][2] * scalar, m[2][3] * scalar,
+        m[3][0] * scalar, m[3][1] * scalar, m[3][2] * scalar, m[3][3] * scalar
+    );
+}
+
+inline constexpr const Matrix4x4 Matrix4x4::operator*(const Matrix4x4 &matrix) const noexcept {
+    // 実行時はSIMDで計算する
+    if (!std::is_constant_evaluated()) {
+        Matrix4x4 result;
+        MatrixSimd::Multiply(&m[0][0], &matrix.m[0][0], &result.m[0][0]);
+        return result;
+    }
+    // 少しでも速度を稼ぐためにループではなく展開する
+    return Matrix4x4(
+        m[0][0] * matrix.m[0][0] + m[0][1] * matrix.m[1][0] + m[0][2] * matrix.m[2][0] + m[0][3] * matrix.m[3][0],
+        m[0][0] * matrix.m[0][1] + m[0][1] * matrix.m[1][1] + m[0][2] * matrix.m[2][1] + m[0][3] * matrix.m[3][1],
+        m[0][0] * matrix.m[0][2] + m[0][1] * matrix.m[1][2] + m[0][2] * matrix.m[2][2] + m[0][3] * matrix.m[3][2],
+        m[0][0] * matrix.m[0][3] + m[0][1] * matrix.m[1][3] + m[0][2] * matrix.m[2][3] + m[0][3] * matrix.m[3][3],
+        m[1][0] * matrix.m[0][0] + m[1][1] * matrix.m[1][0] + m[1][2] * matrix.m[2][0] + m[1][3] * matrix.m[3][0],
+        m[1][0] * matrix.m[0][1] + m[1][1] * matrix.m[1][1] + m[1][2] * matrix.m[2][1] + m[1][3] * matrix.m[3][1],
+        m[1][0] * matrix.m[0][2] + m[1][1] * matrix.m[1][2] + m[1][2] * matrix.m[2][2] + m[1][3] * matrix.m[3][2],
+        m[1][0] * matrix.m[0][3] + m[1][1] * matrix.m[1][3] + m[1][2] * matrix.m[2][3] + m[1][3] * matrix.m[3][3],
+        m[2][0] * matrix.m[0][0] + m[2][1] * matrix.m[1][0] + m[2][2] * matrix.m[2][0] + m[2][3] * matrix.m[3][0],
+        m[2][0] * matrix.m[0][1] + m[2][1] * matrix.m[1][1] + m[2][2] * matrix.m[2][1] + m[2][3] * matrix.m[3][1],
+        m[2][0] * matrix.m[0][2] + m[2][1] * matrix.m[1][2] + m[2][2] * matrix.m[2][2] + m[2][3] * matrix.m[3][2],
+        m[2][0] * matrix.m[0][3] + m[2][1] * matrix.m[1][3] + m[2][2] * matrix.m[2][3] + m[2][3] * matrix.m[3][3],
+        m[3][0] * matrix.m[0][0] + m[3][1] * matrix.m[1][0] + m[3][2] * matrix.m[2][0] + m[3][3] * matrix.m[3][0],
+        m[3][0] * matrix.m[0][1] + m[3][1] * matrix.m[1][1] + m[3][2] * matrix.m[2][1] + m[3][3] * matrix.m[3][1],
+        m[3][0] * matrix.m[0][2] + m[3][1] * matrix.m[1][2] + m[3][2] * matrix.m[2][2] + m[3][3] * matrix.m[3][2],
+        m[3][0] * matrix.m[0][3] + m[3][1] * matrix.m[1][3] + m[3][2] * matrix.m[2][3] + m[3][3] * matrix.m[3][3]
+    );
+}
+
+inline constexpr const Matrix4x4 Matrix4x4::Identity() noexcept {
+    return Matrix4x4(
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    );
+}
+
+inline constexpr const Matrix4x4 Matrix4x4::Transpose() noexcept {
+    if (!std::is_constant_evaluated()) {
+        Matrix4x4 result;
+        MatrixSimd::Transpose(&m[0][0], &result.m[0][0]);
+        return result;
+    }
+    return Matrix4x4(
+        m[0][0], m[1][0], m[2][0], m[3][0],
+        m[0][1], m[1][1], m[2][1], m[3][1],
+        m[0][2], m[1][2], m[2][2], m[3][2],
+        m[0][3], m[1][3], m[2][3], m[3][3]
+    );
+}
+
+inline constexpr const float Matrix4x4::Determinant() const noexcept {
+    float c00 = Matrix3x3(
+        m[1][1], m[1][2], m[1][3],
+        m[2][1], m[2][2], m[2][3],
+        m[3][1], m[3][2], m[3][3]).Determinant();
+    float c01 = -(Matrix3x3(
+        m[1][0], m[1][2], m[1][3],
+        m[2][0], m[2][2], m[2][3],
+        m[3][0], m[3][2], m[3][3]).Determinant());
+    float c02 = Matrix3x3(
+        m[1][0], m[1][1], m[1][3],
+        m[2][0], m[2][1], m[2][3],
+        m[3][0], m[3][1], m[3][3]).Determinant();
+    float c03 = -(Matrix3x3(
+        m[1][0], m[1][1], m[1][2],
+        m[2][0], m[2][1], m[2][2],
+        m[3][0], m[3][1], m[3][2]).Determinant());
+    return (m[0][0] * c00) + (m[0][1] * c01) + (m[0][2] * c02) + (m[0][3] * c03);
+}
+
+inline constexpr Matrix4x4 Matrix4x4::Inverse() const {
+    // 実行時は2x2のブロックに分けてSIMDで計算する
+    if (!std::is_constant_evaluated()) {
+        Matrix4x4 result;
+        MatrixSimd::Inverse(&m[0][0], &result.m[0][0]);
+        return result;
+    }
+    float c00 = Matrix3x3(
+        m[1][1], m[1][2], m[1][3],
+        m[2][1], m[2][2], m[2][3],
+        m[3][1], m[3][2], m[3][3]).Determinant();
+    float c01 = -(Matrix3x3(
+        m[1][0], m[1][2], m[1][3],
+        m[2][0], m[2][2], m[2][3],
+        m[3][0], m[3][2], m[3][3]).Determinant());
+    float c02 = Matrix3x3(
+        m[1][0], m[1][1], m[1][3],
+        m[2][0], m[2][1], m[2][3],
+        m[3][0], m[3][1], m[3][3]).Determinant();
+    float c03 = -(Matrix3x3(
+        m[1][0], m[1][1], m[1][2],
+        m[2][0], m[2][1], m[2][2],
+        m[3][0], m[3][1], m[3][2]).Determinant());
+
+    float c10 = -(Matrix3x3(
+        m[0][1], m[0][2], m[0][3],
+        m[2][1], m[2][2], m[2][3],
+        m[3][1], m[3][2], m[3][3]).Determinant());
+    float c11 = Matrix3x3(
+        m[0][0], m[0][2], m[0][3],
+        m[2][0], m[2][2], m[2][3],
+        m[3][0], m[3][2], m[3][3]).Determinant();
+    float c12 = -(Matrix3x3(
+        m[0][0], m[0][1], m[0][3],
+        m[2][0], m[2][1], m[2][3],
+        m[3][0], m[3][1], m[3][3]).Determinant());
+    float c13 = Matrix3x3(
+        m[0][0], m[0][1], m[0][2],
+        m[2][0], m[2][1], m[2][2],
+        m[3][0], m[3][1], m[3][2]).Determinant();
+
+    float c20 = Matrix3x3(
+        m[0][1], m[0][2], m[0][3],
+        m[1][1], m[1][2], m[1][3],
+        m[3][1], m[3][2], m[3][3]).Determinant();
+    float c21 = -(Matrix3x3(
+        m[0][0], m[0][2], m[0][3],
+        m[1][0], m[1][2], m[1][3],
+        m[3][0], m[3][2], m[3][3]).Determinant());
+    float c22 = Matrix3x3(
+        m[0][0], m[0][1], m[0][3],
+        m[1][0], m[1][1], m[1][3],
+        m[3][0], m[3][1], m[3][3]).Determinant();
+    float c23 = -(Matrix3x3(
+        m[0][0], m[0][1], m[0][2],
+        m[1][0], m[1][1], m[1][2],
+        m[3][0], m[3][1], m[3][2]).Determinant());
+
+    float c30 = -(Matrix3x3(
+        m[0][1], m[0][2], m[0][3],
+        m[1][1], m[1][2], m[1][3],
+        m[2][1], m[2][2], m[2][3]).Determinant());
+    float c31 = Matrix3x3(
+        m[0][0], m[0][2], m[0][3],
+        m[1][0], m[1][2], m[1][3],
+        m[2][0], m[2][2], m[2][3]).Determinant();
+    float c32 = -(Matrix3x3(
+        m[0][0], m[0][1], m[0][3],
+        m[1][0], m[1][1], m[1][3],
+        m[2][0], m[2][1], m[2][3]).Determinant());
+    float c33 = Matrix3x3(
+        m[0][0], m[0][1], m[0][2],
+        m[1][0], m[1][1], m[1][2],
+        m[2][0], m[2][1], m[2][2]).Determinant();
+
+    float det = 1.0f / (m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02 + m[0][3] * c03);
+
+    return Matrix4x4(
+        c00 * det, c10 * det, c20 * det, c30 * det,
+        c01 * det, c11 * det, c21 * det, c31 * det,
+        c02 * det, c12 * det, c22 * det, c32 * det,
+        c03 * det, c13 * det, c23 * det, c33 * det
+    );
+}
+
+inline constexpr Matrix4x4 Matrix4x4::InverseRigid() const noexcept {
+    // 回転部分は転置、平行移動は転置した回転で逆向きに変換する
+    const float tx = m[3][0];
+    const float ty = m[3][1];
+    const float tz = m[3][2];
+    return Matrix4x4(
+        m[0][0], m[1][0], m[2][0], 0.0f,
+        m[0][1], m[1][1], m[2][1], 0.0f,
+        m[0][2], m[1][2], m[2][2], 0.0f,
+        -(tx * m[0][0] + ty * m[0][1] + tz * m[0][2]),
+        -(tx * m[1][0] + ty * m[1][1] + tz * m[1][2]),
+        -(tx * m[2][0] + ty * m[2][1] + tz * m[2][2]),
+        1.0f
+    );
+}
+
+inline constexpr Matrix4x4 Matrix4x4::InverseAffine() const {
+    // 3x3部分の余因子
+    const float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    const float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    const float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    const float invDet = 1.0f / (m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02);
+
+    const float i00 = c00 * invDet;
+    const float i01 = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * invDet;
+    const float i02 = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * invDet;
+    const float i10 = c01 * invDet;
+    const float i11 = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * invDet;
+    const float i12 = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * invDet;
+    const float i20 = c02 * invDet;
+    const float i21 = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * invDet;
+    const float i22 = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * invDet;
+
+    // 平行移動は3x3の逆行列で逆向きに変換する
+    const float tx = m[3][0];
+    const float ty = m[3][1];
+    const float tz = m[3][2];
+    return Matrix4x4(
+        i00, i01, i02, 0.0f,
+        i10, i11, i12, 0.0f,
+        i20, i21, i22, 0.0f,
+        -(tx * i00 + ty * i10 + tz * i20),
+        -(tx * i01 + ty * i11 + tz * i21),
+        -(tx * i02 + ty * i12 + tz * i22),
+        1.0f
+    );
+}
+
+inline constexpr void Matrix4x4::MakeIdentity() noexcept {
+    m[0][0] = 1.0f;
+    m[0][1] = 0.0f;
+    m[0][2] = 0.0f;
+    m[0][3] = 0.0f;
+    m[1][0] = 0.0f;
+    m[1][1] = 1.0f;
+    m[1][2] = 0.0f;
+    m[1][3] = 0.0f;
+    m[2][0] = 0.0f;
+    m[2][1] = 0.0f;
+    m[2][2] = 1.0f;
+    m[2][3] = 0.0f;
+    m[3][0] = 0.0f;
+    m[3][1] = 0.0f;
+    m[3][2] = 0.0f;
+    m[3][3] = 1.0f;
+}
+
+inline constexpr void Matrix4x4::MakeTranspose() noexcept {
+    if (!std::is_constant_evaluated()) {
+        MatrixSimd::Transpose(&m[0][0], &m[0][0]);
+        return;
+    }
+    float tmp;
+    tmp = m[0][1];
+    m[0][1] = m[1][0];
+    m[1][0] = tmp;
+    tmp = m[0][2];
+    m[0][2] = m[2][0];
+    m[2][0] = tmp;
+    tmp = m[0][3];
+    m[0][3] = m[3][0];
+    m[3][0] = tmp;
+    tmp = m[1][2];
+    m[1][2] = m[2][1];
+    m[2][1] = tmp;
+    tmp = m[1][3];
+    m[1][3] = m[3][1];
+    m[3][1] = tmp;
+    tmp = m[2][3];
+    m[2][3] = m[3][2];
+    m[3][2] = tmp;
+}
+
+inline constexpr void Matrix4x4::MakeInverse() noexcept {
+    *this = Inverse();
+}
+
+inline constexpr void Matrix4x4::MakeTranslate(const Vector3 &translate) noexcept {
+    m[0][0] = 1.0f;
+    m[0][1] = 0.0f;
+    m[0][2] = 0.0f;
+    m[0][3] = 0.0f;
+    m[1][0] = 0.0f;
+    m[1][1] = 1.0f;
+    m[1][2] = 0.0f;
+    m[1][3] = 0.0f;
+    m[2][0] = 0.0f;
+    m[2][1] = 0.0f;
+    m[2][2] = 1.0f;
+    m[2][3] = 0.0f;
+    m[3][0] = translate.x;
+    m[3][1] = translate.y;
+    m[3][2] = translate.z;
+    m[3][3] = 1.0f;
+}
+
+inline constexpr void Matrix4x4::MakeScale(const Vector3 &scale) noexcept {
+    m[0][0] = scale.x;
+    m[0][1] = 0.0f;
+    m[0][2] = 0.0f;
+    m[0][3] = 0.0f;
+    m[1][0] = 0.0f;
+    m[1][1] = scale.y;
+    m[1][2] = 0.0f;
+    m[1][3] = 0.0f;
+    m[2][0] = 0.0f;
+    m[2][1] = 0.0f;
+    m[2][2] = scale.z;
+    m[2][3] = 0.0f;
+    m[3][0] = 0.0f;
+    m[3][1] = 0.0f;
+    m[3][2] = 0.0f;
+    m[3][3] = 1.0f;
+}
+
+inline void Matrix4x4::MakeRotate(const Vector3 &rotate) noexcept {
+    MakeRotate(rotate.x, rotate.y, rotate.z);
+}
+
+inline void Matrix4x4::MakeRotate(const float radianX, const float radianY, const float radianZ) noexcept {
+    // X * Y * Z の積を展開した形で直接書き込む
+    MakeAffine({ 1.0f, 1.0f, 1.0f }, { radianX, radianY, radianZ }, { 0.0f, 0.0f, 0.0f });
+}
+
+inline void Matrix4x4::MakeRotateX(const float radian) noexcept {
+    m[0][0] = 1.0f;
+    m[0][1] = 0.0f;
+    m[0][2] = 0.0f;
+    m[0][3] = 0.0f;
+    m[1][0] = 0.0f;
+    m[1][1] = std::cos(radian);
+    m[1][2] = std::sin(radian);
+    m[1][3] = 0.0f;
+    m[2][0] = 0.0f;
+    m[2][1] = -std::sin(radian);
+    m[2][2] = std::cos(radian);
+    m[2][3] = 0.0f;
+    m[3][0] = 0.0f;
+    m[3][1] = 0.0f;
+    m[3][2] = 0.0f;
+    m[3][3] = 1.0f;
+}
+
+inline void Matrix4x4::MakeRotateY(const float radian) noexcept {
+    m[0][0] = std::cos(radian);
+    m[0][1] = 0.0f;
+    m[0][2] = -std::sin(radian);
+    m[0][3] = 0.0f;
+    m[1][0] = 0.0f;
+    m[1][1] = 1.0f;
+    m[1][2] = 0.0f;
+    m[1][3] = 0.0f;
+    m[2][0] = std::sin(radian);
+    m[2][1] = 0.0f;
+    m[2][2] = std::cos(radian);
+    m[2][3] = 0.0f;
+    m[3][0] = 0.0f;
+    m[3][1] = 0.0f;
+    m[3][2] = 0.0f;
+    m[3][3] = 1.0f;
+}
+
+inline void Matrix4x4::MakeRotateZ(const float radian) noexcept {
+    m[0][0] = std::cos(radian);
+    m[0][1] = std::sin(radian);
+    m[0][2] = 0.0f;
+    m[0][3] = 0.0f;
+    m[1][0] = -std::sin(radian);
+    m[1][1] = std::cos(radian);
+    m[1][2] = 0.0f;
+    m[1][3] = 0.0f;
+    m[2][0] = 0.0f;
+    m[2][1] = 0.0f;
+    m[2][2] = 1.0f;
+    m[2][3] = 0.0f;
+    m[3][0] = 0.0f;
+    m[3][1] = 0.0f;
+    m[3][2] = 0.0f;
+    m[3][3] = 1.0f;
+}
+
+inline void Matrix4x4::MakeAffine(const Vector3 &scale, const Vector3 &rotate, const Vector3 &translate) noexcept {
+    // S * (X * Y * Z) * T を展開した形で直接書き込む(軸ごとにsin・cosを1回ずつ)
+    const float sx = std::sin(rotate.x);
+    const float cx = std::cos(rotate.x);
+    const float sy = std::sin(rotate.y);
+    const float cy = std::cos(rotate.y);
+    const float sz = std::sin(rotate.z);
+    const float cz = std::cos(rotate.z);
+
+    const float sxsy = sx * sy;
+    const float cxsy = cx * sy;
+
+    m[0][0] = scale.x * (cy * cz);
+    m[0][1] = scale.x * (cy * sz);
+    m[0][2] = scale.x * (-sy);
+    m[0][3] = 0.0f;
+    m[1][0] = scale.y * (sxsy * cz - cx * sz);
+    m[1][1] = scale.y * (sxsy * sz + cx * cz);
+    m[1][2] = scale.y * (sx * cy);
+    m[1][3] = 0.0f;
+    m[2][0] = scale.z * (cxsy * cz + sx * sz);
+    m[2][1] = scale.z * (cxsy * sz - sx * cz);
+    m[2][2] = scale.z * (cx * cy);
+    m[2][3] = 0.0f;
+    m[3][0] = translate.x;
+    m[3][1] = translate.y;
+    m[3][2] = translate.z;
+    m[3][3] = 1.0f;
+}
+
+inline constexpr void Matrix4x4::MakeAffine(const Vector3 &scale, const Quaternion &rotate, const Vector3 &translate) noexcept {
+    // 回転行列の各行を拡大縮小して平行移動を書き込む
+    *this = rotate.ToMatrix();
+    m[0][0] *= scale.x;
+    m[0][1] *= scale.x;
+    m[0][2] *= scale.x;
+    m[1][0] *= scale.y;
+    m[1][1] *= scale.y;
+    m[1][2] *= scale.y;
+    m[2][0] *= scale.z;
+    m[2][1] *= scale.z;
+    m[2][2] *= scale.z;
+    m[3][0] = translate.x;
+    m[3][1] = translate.y;
+    m[3][2] = translate.z;
+}
+
 } // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,460 @@
+#pragma once
+#include <cstddef>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define KASHIPAN_MATH_SSE2
+#endif
+#if defined(KASHIPAN_MATH_SSE2) && defined(__AVX2__)
+#include <immintrin.h>
+#define KASHIPAN_MATH_AVX2
+#endif
+
+namespace KashipanEngine {
+
+/*
+Matrix4x4の積・転置・逆行列と、ベクトルの変換のSIMD実装。
+SSE2を基本とし、AVX2が有効なビルド(/arch:AVX2)では行列の積を2行ずつ計算する。どちらも使えない環境ではスカラーで計算する。
+行列は行優先のfloat[16]、ベクトルは行ベクトル(v * M)として扱う。
+積と変換は積和の順番をスカラー版と揃えているので結果は一致し、逆行列は数ULPの誤差の範囲で一致する。
+配列の変換は4点ずつSoAに並べ替えて計算し、スカラーで変換した場合と同じ結果になる。
+ただしFMAが有効なビルドではコンパイラが積和をまとめる場所が経路ごとに違うことがあり、積和の丸め誤差の範囲でずれる。
+Matrix4x4やVector3を読み込まずに使えるよう、引数はfloatのポインタで受け取る。
+*/
+
+namespace MatrixSimd {
+
+#ifdef KASHIPAN_MATH_SSE2
+
+namespace Internal {
+
+/// @brief _mm_shuffle_psのマスクを作る
+constexpr int ShuffleMask(int x, int y, int z, int w) {
+    return x | (y << 2) | (z << 4) | (w << 6);
+}
+
+/// @brief 1つのベクトル内で要素を並べ替える
+template <int X, int Y, int Z, int W>
+inline __m128 Swizzle(__m128 v) noexcept {
+    return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v), ShuffleMask(X, Y, Z, W)));
+}
+
+/// @brief 2x2行列(行優先で1つのベクトルに格納)の積 a * b
+inline __m128 Mat2Mul(__m128 a, __m128 b) noexcept {
+    return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)),
+        _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+}
+
+/// @brief 2x2行列の余因子行列との積 adj(a) * b
+inline __m128 Mat2AdjMul(__m128 a, __m128 b) noexcept {
+    return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b),
+        _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+}
+
+/// @brief 2x2行列と余因子行列の積 a * adj(b)
+inline __m128 Mat2MulAdj(__m128 a, __m128 b) noexcept {
+    return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)),
+        _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+}
+
+/// @brief 行ベクトルvと行列の積。mの各行はrow0～row3
+inline __m128 RowTransform(__m128 v, __m128 row0, __m128 row1, __m128 row2, __m128 row3) noexcept {
+    __m128 result = _mm_mul_ps(Swizzle<0, 0, 0, 0>(v), row0);
+    result = _mm_add_ps(result, _mm_mul_ps(Swizzle<1, 1, 1, 1>(v), row1));
+    result = _mm_add_ps(result, _mm_mul_ps(Swizzle<2, 2, 2, 2>(v), row2));
+    return _mm_add_ps(result, _mm_mul_ps(Swizzle<3, 3, 3, 3>(v), row3));
+}
+
+} // namespace Internal
+
+#endif // KASHIPAN_MATH_SSE2
+
+/// @brief 行列の積 out = a * b。outはaやbと同じでも良い
+/// @param a 左の行列(float[16])
+/// @param b 右の行列(float[16])
+/// @param out 結果の出力先(float[16])
+inline void Multiply(const float *a, const float *b, float *out) noexcept {
+#if defined(KASHIPAN_MATH_AVX2)
+    const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 0));
+    const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 4));
+    const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 8));
+    const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 12));
+    const __m256 a01 = _mm256_loadu_ps(a + 0);
+    const __m256 a23 = _mm256_loadu_ps(a + 8);
+    // 2行ずつ、各行の要素kをその行のレーン全体に広げてbのk行目に掛ける
+    __m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x00), b0);
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x55), b1));
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xaa), b2));
+    r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xff), b3));
+    __m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x00), b0);
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x55), b1));
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xaa), b2));
+    r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xff), b3));
+    _mm256_storeu_ps(out + 0, r01);
+    _mm256_storeu_ps(out + 8, r23);
+#elif defined(KASHIPAN_MATH_SSE2)
+    const __m128 b0 = _mm_loadu_ps(b + 0);
+    const __m128 b1 = _mm_loadu_ps(b + 4);
+    const __m128 b2 = _mm_loadu_ps(b + 8);
+    const __m128 b3 = _mm_loadu_ps(b + 12);
+    const __m128 a0 = _mm_loadu_ps(a + 0);
+    const __m128 a1 = _mm_loadu_ps(a + 4);
+    const __m128 a2 = _mm_loadu_ps(a + 8);
+    const __m128 a3 = _mm_loadu_ps(a + 12);
+    _mm_storeu_ps(out + 0, Internal::RowTransform(a0, b0, b1, b2, b3));
+    _mm_storeu_ps(out + 4, Internal::RowTransform(a1, b0, b1, b2, b3));
+    _mm_storeu_ps(out + 8, Internal::RowTransform(a2, b0, b1, b2, b3));
+    _mm_storeu_ps(out + 12, Internal::RowTransform(a3, b0, b1, b2, b3));
+#else
+    float result[16];
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            result[row * 4 + column] =
+                a[row * 4 + 0] * b[0 + column] + a[row * 4 + 1] * b[4 + column] +
+                a[row * 4 + 2] * b[8 + column] + a[row * 4 + 3] * b[12 + column];
+        }
+    }
+    for (int i = 0; i < 16; ++i) {
+        out[i] = result[i];
+    }
+#endif
+}
+
+/// @brief 転置行列を計算する。outはmと同じでも良い
+/// @param m 元の行列(float[16])
+/// @param out 結果の出力先(float[16])
+inline void Transpose(const float *m, float *out) noexcept {
+#ifdef KASHIPAN_MATH_SSE2
+    __m128 row0 = _mm_loadu_ps(m + 0);
+    __m128 row1 = _mm_loadu_ps(m + 4);
+    __m128 row2 = _mm_loadu_ps(m + 8);
+    __m128 row3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+    _mm_storeu_ps(out + 0, row0);
+    _mm_storeu_ps(out + 4, row1);
+    _mm_storeu_ps(out + 8, row2);
+    _mm_storeu_ps(out + 12, row3);
+#else
+    float result[16];
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            result[column * 4 + row] = m[row * 4 + column];
+        }
+    }
+    for (int i = 0; i < 16; ++i) {
+        out[i] = result[i];
+    }
+#endif
+}
+
+/// @brief 逆行列を計算する。2x2のブロックに分けて余因子を求める。
+/// 行列式が0の場合の結果は不定(スカラー版と同じく確認はしない)
+/// @param m 元の行列(float[16])
+/// @param out 結果の出力先(float[16])。mと同じでも良い
+inline void Inverse(const float *m, float *out) noexcept {
+#ifdef KASHIPAN_MATH_SSE2
+    using namespace Internal;
+    const __m128 row0 = _mm_loadu_ps(m + 0);
+    const __m128 row1 = _mm_loadu_ps(m + 4);
+    const __m128 row2 = _mm_loadu_ps(m + 8);
+    const __m128 row3 = _mm_loadu_ps(m + 12);
+
+    // 2x2の小行列 | A B |
+    //            | C D |
+    const __m128 a = _mm_movelh_ps(row0, row1);
+    const __m128 b = _mm_movehl_ps(row1, row0);
+    const __m128 c = _mm_movelh_ps(row2, row3);
+    const __m128 d = _mm_movehl_ps(row3, row2);
+
+    // 小行列の行列式 (|A|, |B|, |C|, |D|)
+    const __m128 detSub = _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(row0, row2, ShuffleMask(0, 2, 0, 2)), _mm_shuffle_ps(row1, row3, ShuffleMask(1, 3, 1, 3))),
+        _mm_mul_ps(_mm_shuffle_ps(row0, row2, ShuffleMask(1, 3, 1, 3)), _mm_shuffle_ps(row1, row3, ShuffleMask(0, 2, 0, 2)))
+    );
+    const __m128 detA = Swizzle<0, 0, 0, 0>(detSub);
+    const __m128 detB = Swizzle<1, 1, 1, 1>(detSub);
+    const __m128 detC = Swizzle<2, 2, 2, 2>(detSub);
+    const __m128 detD = Swizzle<3, 3, 3, 3>(detSub);
+
+    const __m128 dc = Mat2AdjMul(d, c);
+    const __m128 ab = Mat2AdjMul(a, b);
+    __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Mat2Mul(b, dc));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Mat2Mul(c, ab));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), Mat2MulAdj(d, ab));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), Mat2MulAdj(a, dc));
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+    __m128 detM = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+    __m128 trace = _mm_mul_ps(ab, Swizzle<0, 2, 1, 3>(dc));
+    trace = _mm_add_ps(trace, Swizzle<2, 3, 0, 1>(trace));
+    trace = _mm_add_ps(trace, Swizzle<1, 0, 3, 2>(trace));
+    detM = _mm_sub_ps(detM, trace);
+
+    const __m128 invDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+    x = _mm_mul_ps(x, invDetM);
+    y = _mm_mul_ps(y, invDetM);
+    z = _mm_mul_ps(z, invDetM);
+    w = _mm_mul_ps(w, invDetM);
+
+    // 余因子行列の並べ替えと行への格納をまとめて行う
+    _mm_storeu_ps(out + 0, _mm_shuffle_ps(x, y, ShuffleMask(3, 1, 3, 1)));
+    _mm_storeu_ps(out + 4, _mm_shuffle_ps(x, y, ShuffleMask(2, 0, 2, 0)));
+    _mm_storeu_ps(out + 8, _mm_shuffle_ps(z, w, ShuffleMask(3, 1, 3, 1)));
+    _mm_storeu_ps(out + 12, _mm_shuffle_ps(z, w, ShuffleMask(2, 0, 2, 0)));
+#else
+    // 2x2の小行列式から余因子を求める
+    const float s0 = m[0] * m[5] - m[4] * m[1];
+    const float s1 = m[0] * m[6] - m[4] * m[2];
+    const float s2 = m[0] * m[7] - m[4] * m[3];
+    const float s3 = m[1] * m[6] - m[5] * m[2];
+    const float s4 = m[1] * m[7] - m[5] * m[3];
+    const float s5 = m[2] * m[7] - m[6] * m[3];
+    const float c5 = m[10] * m[15] - m[14] * m[11];
+    const float c4 = m[9] * m[15] - m[13] * m[11];
+    const float c3 = m[9] * m[14] - m[13] * m[10];
+    const float c2 = m[8] * m[15] - m[12] * m[11];
+    const float c1 = m[8] * m[14] - m[12] * m[10];
+    const float c0 = m[8] * m[13] - m[12] * m[9];
+    const float invDet = 1.0f / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+    float result[16];
+    result[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) * invDet;
+    result[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * invDet;
+    result[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) * invDet;
+    result[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * invDet;
+    result[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * invDet;
+    result[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) * invDet;
+    result[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * invDet;
+    result[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) * invDet;
+    result[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) * invDet;
+    result[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * invDet;
+    result[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) * invDet;
+    result[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * invDet;
+    result[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * invDet;
+    result[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) * invDet;
+    result[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * invDet;
+    result[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) * invDet;
+    for (int i = 0; i < 16; ++i) {
+        out[i] = result[i];
+    }
+#endif
+}
+
+/// @brief 位置ベクトル(x, y, z, 1)を変換し、wで割る。wが0の場合は0を返す
+/// @param m 変換行列(float[16])
+/// @param x X座標
+/// @param y Y座標
+/// @param z Z座標
+/// @param out 結果の出力先(float[3])
+inline void TransformPoint(const float *m, float x, float y, float z, float *out) noexcept {
+#ifdef KASHIPAN_MATH_SSE2
+    const __m128 result = Internal::RowTransform(_mm_setr_ps(x, y, z, 1.0f),
+        _mm_loadu_ps(m + 0), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12));
+    alignas(16) float values[4];
+    _mm_store_ps(values, result);
+    const float w = values[3];
+#else
+    float values[4];
+    for (int i = 0; i < 4; ++i) {
+        values[i] = x * m[0 + i] + y * m[4 + i] + z * m[8 + i] + 1.0f * m[12 + i];
+    }
+    const float w = values[3];
+#endif
+    if (w == 0.0f) {
+        out[0] = 0.0f;
+        out[1] = 0.0f;
+        out[2] = 0.0f;
+        return;
+    }
+    out[0] = values[0] / w;
+    out[1] = values[1] / w;
+    out[2] = values[2] / w;
+}
+
+/// @brief 方向ベクトル(x, y, z, 0)を変換する。平行移動は無視される
+/// @param m 変換行列(float[16])
+/// @param x X成分
+/// @param y Y成分
+/// @param z Z成分
+/// @param out 結果の出力先(float[3])
+inline void TransformDirection(const float *m, float x, float y, float z, float *out) noexcept {
+#ifdef KASHIPAN_MATH_SSE2
+    const __m128 result = Internal::RowTransform(_mm_setr_ps(x, y, z, 0.0f),
+        _mm_loadu_ps(m + 0), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_setzero_ps());
+    alignas(16) float values[4];
+    _mm_store_ps(values, result);
+    out[0] = values[0];
+    out[1] = values[1];
+    out[2] = values[2];
+#else
+    for (int i = 0; i < 3; ++i) {
+        out[i] = x * m[0 + i] + y * m[4 + i] + z * m[8 + i];
+    }
+#endif
+}
+
+#ifdef KASHIPAN_MATH_SSE2
+
+namespace Internal {
+
+/// @brief 行列の各要素を4レーンに複製したもの
+struct BroadcastMatrix {
+    __m128 m[16];
+};
+
+inline BroadcastMatrix Broadcast(const float *m) noexcept {
+    BroadcastMatrix result;
+    for (int i = 0; i < 16; ++i) {
+        result.m[i] = _mm_set1_ps(m[i]);
+    }
+    return result;
+}
+
+/// @brief SoAの4点を変換する。積和の順番はTransformPointと同じ
+template <bool kIsPoint, bool kIsProjective>
+inline void Transform4(const BroadcastMatrix &b, __m128 x, __m128 y, __m128 z, __m128 &outX, __m128 &outY, __m128 &outZ) noexcept {
+    __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, b.m[0]), _mm_mul_ps(y, b.m[4])), _mm_mul_ps(z, b.m[8]));
+    __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, b.m[1]), _mm_mul_ps(y, b.m[5])), _mm_mul_ps(z, b.m[9]));
+    __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, b.m[2]), _mm_mul_ps(y, b.m[6])), _mm_mul_ps(z, b.m[10]));
+    if constexpr (kIsPoint) {
+        rx = _mm_add_ps(rx, b.m[12]);
+        ry = _mm_add_ps(ry, b.m[13]);
+        rz = _mm_add_ps(rz, b.m[14]);
+    }
+    if constexpr (kIsProjective) {
+        const __m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, b.m[3]), _mm_mul_ps(y, b.m[7])), _mm_mul_ps(z, b.m[11])), b.m[15]);
+        // wが0の点は0にする
+        const __m128 isValid = _mm_cmpneq_ps(w, _mm_setzero_ps());
+        rx = _mm_and_ps(isValid, _mm_div_ps(rx, w));
+        ry = _mm_and_ps(isValid, _mm_div_ps(ry, w));
+        rz = _mm_and_ps(isValid, _mm_div_ps(rz, w));
+    }
+    outX = rx;
+    outY = ry;
+    outZ = rz;
+}
+
+/// @brief xyzが並んだ4点分(float[12])を読み込んでSoAにする
+inline void LoadAoS4(const float *p, __m128 &x, __m128 &y, __m128 &z) noexcept {
+    const __m128 a = _mm_loadu_ps(p + 0);   // x0 y0 z0 x1
+    const __m128 b = _mm_loadu_ps(p + 4);   // y1 z1 x2 y2
+    const __m128 c = _mm_loadu_ps(p + 8);   // z2 x3 y3 z3
+    const __m128 t0 = _mm_shuffle_ps(b, c, ShuffleMask(2, 3, 0, 1));    // x2 y2 z2 x3
+    const __m128 t1 = _mm_shuffle_ps(a, b, ShuffleMask(1, 2, 0, 1));    // y0 z0 y1 z1
+    const __m128 t2 = _mm_shuffle_ps(t0, c, ShuffleMask(1, 2, 2, 3));   // y2 z2 y3 z3
+    x = _mm_shuffle_ps(a, t0, ShuffleMask(0, 3, 0, 3));
+    y = _mm_shuffle_ps(t1, t2, ShuffleMask(0, 2, 0, 2));
+    z = _mm_shuffle_ps(t1, t2, ShuffleMask(1, 3, 1, 3));
+}
+
+/// @brief SoAの4点をxyzが並んだ形(float[12])で書き込む
+inline void StoreAoS4(float *p, __m128 x, __m128 y, __m128 z) noexcept {
+    const __m128 xy01 = _mm_unpacklo_ps(x, y);                              // x0 y0 x1 y1
+    const __m128 xy23 = _mm_unpackhi_ps(x, y);                              // x2 y2 x3 y3
+    const __m128 zx = _mm_shuffle_ps(z, x, ShuffleMask(0, 0, 1, 1));       // z0 z0 x1 x1
+    const __m128 yz = _mm_shuffle_ps(xy01, z, ShuffleMask(3, 3, 1, 1));    // y1 y1 z1 z1
+    const __m128 zxy = _mm_shuffle_ps(z, xy23, ShuffleMask(2, 2, 2, 3));   // z2 z2 x3 y3
+    const __m128 yzz = _mm_shuffle_ps(xy23, z, ShuffleMask(3, 3, 3, 3));   // y3 y3 z3 z3
+    _mm_storeu_ps(p + 0, _mm_shuffle_ps(xy01, zx, ShuffleMask(0, 1, 0, 2)));
+    _mm_storeu_ps(p + 4, _mm_shuffle_ps(yz, xy23, ShuffleMask(0, 2, 0, 1)));
+    _mm_storeu_ps(p + 8, _mm_shuffle_ps(zxy, yzz, ShuffleMask(0, 2, 0, 2)));
+}
+
+} // namespace Internal
+
+#endif // KASHIPAN_MATH_SSE2
+
+namespace Internal {
+
+/// @brief 1点を変換する。積和の順番はTransformPointと同じ
+template <bool kIsPoint, bool kIsProjective>
+inline void Transform1(const float *m, float x, float y, float z, float *out) noexcept {
+    float rx = x * m[0] + y * m[4] + z * m[8];
+    float ry = x * m[1] + y * m[5] + z * m[9];
+    float rz = x * m[2] + y * m[6] + z * m[10];
+    if constexpr (kIsPoint) {
+        rx += m[12];
+        ry += m[13];
+        rz += m[14];
+    }
+    if constexpr (kIsProjective) {
+        const float w = x * m[3] + y * m[7] + z * m[11] + m[15];
+        if (w == 0.0f) {
+            rx = 0.0f;
+            ry = 0.0f;
+            rz = 0.0f;
+        } else {
+            rx /= w;
+            ry /= w;
+            rz /= w;
+        }
+    }
+    out[0] = rx;
+    out[1] = ry;
+    out[2] = rz;
+}
+
+} // namespace Internal
+
+/// @brief xyzが並んだ配列の各点を変換する。inとoutは同じでも良い
+/// @tparam kIsPoint 平行移動を加えるか(位置ならtrue、方向ならfalse)
+/// @tparam kIsProjective wで割るかどうか
+/// @param m 変換行列(float[16])
+/// @param in 入力(float[count * 3])
+/// @param out 出力先(float[count * 3])
+/// @param count 点の数
+template <bool kIsPoint, bool kIsProjective>
+inline void TransformArray(const float *m, const float *in, float *out, size_t count) noexcept {
+    size_t i = 0;
+#ifdef KASHIPAN_MATH_SSE2
+    const Internal::BroadcastMatrix b = Internal::Broadcast(m);
+    for (; i + 4 <= count; i += 4) {
+        __m128 x, y, z;
+        Internal::LoadAoS4(in + i * 3, x, y, z);
+        Internal::Transform4<kIsPoint, kIsProjective>(b, x, y, z, x, y, z);
+        Internal::StoreAoS4(out + i * 3, x, y, z);
+    }
+#endif
+    for (; i < count; ++i) {
+        Internal::Transform1<kIsPoint, kIsProjective>(m, in[i * 3 + 0], in[i * 3 + 1], in[i * 3 + 2], out + i * 3);
+    }
+}
+
+/// @brief x, y, zが別々の配列(SoA)の各点を変換する。入力と出力は同じでも良い
+/// @tparam kIsPoint 平行移動を加えるか(位置ならtrue、方向ならfalse)
+/// @tparam kIsProjective wで割るかどうか
+/// @param m 変換行列(float[16])
+/// @param inX 入力のX(float[count])
+/// @param inY 入力のY(float[count])
+/// @param inZ 入力のZ(float[count])
+/// @param outX 出力先のX(float[count])
+/// @param outY 出力先のY(float[count])
+/// @param outZ 出力先のZ(float[count])
+/// @param count 点の数
+template <bool kIsPoint, bool kIsProjective>
+inline void TransformArraySoA(const float *m, const float *inX, const float *inY, const float *inZ,
+    float *outX, float *outY, float *outZ, size_t count) noexcept {
+    size_t i = 0;
+#ifdef KASHIPAN_MATH_SSE2
+    const Internal::BroadcastMatrix b = Internal::Broadcast(m);
+    for (; i + 4 <= count; i += 4) {
+        __m128 x, y, z;
+        Internal::Transform4<kIsPoint, kIsProjective>(b,
+            _mm_loadu_ps(inX + i), _mm_loadu_ps(inY + i), _mm_loadu_ps(inZ + i), x, y, z);
+        _mm_storeu_ps(outX + i, x);
+        _mm_storeu_ps(outY + i, y);
+        _mm_storeu_ps(outZ + i, z);
+    }
+#endif
+    for (; i < count; ++i) {
+        float result[3];
+        Internal::Transform1<kIsPoint, kIsProjective>(m, inX[i], inY[i], inZ[i], result);
+        outX[i] = result[0];
+        outY[i] = result[1];
+        outZ[i] = result[2];
+    }
+}
+
+} // namespace MatrixSimd
+
+} // namespace KashipanEngine
\ No newline at end of file
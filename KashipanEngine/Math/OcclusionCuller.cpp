@@ -0,0 +1,453 @@
+#include "OcclusionCuller.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+#include "MatrixSimd.h"
+
+namespace KashipanEngine {
+
+namespace Math {
+
+namespace {
+
+// 視錐台の外にある面のビット
+constexpr uint32_t kOutsideLeft = 1 << 0;       // x < -w
+constexpr uint32_t kOutsideRight = 1 << 1;      // x > w
+constexpr uint32_t kOutsideBottom = 1 << 2;     // y < -w
+constexpr uint32_t kOutsideTop = 1 << 3;        // y > w
+constexpr uint32_t kOutsideNear = 1 << 4;       // z < 0
+constexpr uint32_t kOutsideFar = 1 << 5;        // z > w
+constexpr uint32_t kOutsideFrustum = (1 << 6) - 1;
+// ガードバンドの外(|x| > kGuardBand * w または |y| > kGuardBand * w)。切り取りが必要かどうかだけに使う
+constexpr uint32_t kOutsideGuardBand = 1 << 6;
+
+// ガードバンドの広さ(画面の幅・高さに対する倍率)
+constexpr float kGuardBand = 4.0f;
+// 切り取りに使う面の数(近平面と、ガードバンドの上下左右)
+constexpr int kClipPlaneCount = 5;
+// 切り取った多角形の頂点数の上限(面ごとに1つ増える)
+constexpr int kMaxPolygonVertexCount = 3 + kClipPlaneCount;
+
+/// @brief 行ベクトルの位置(w = 1)と行列の積
+template <class ClipVertex>
+ClipVertex TransformToClip(const Vector3 &p, const Matrix4x4 &m) noexcept {
+    return {
+        p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0],
+        p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1],
+        p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2],
+        p.x * m.m[0][3] + p.y * m.m[1][3] + p.z * m.m[2][3] + m.m[3][3],
+    };
+}
+
+/// @brief クリップ座標の頂点の、視錐台の外にある面のビット
+template <class ClipVertex>
+uint32_t ComputeOutcode(const ClipVertex &v) noexcept {
+    uint32_t code = 0;
+    code |= (v.x < -v.w) ? kOutsideLeft : 0;
+    code |= (v.x > v.w) ? kOutsideRight : 0;
+    code |= (v.y < -v.w) ? kOutsideBottom : 0;
+    code |= (v.y > v.w) ? kOutsideTop : 0;
+    code |= (v.z < 0.0f) ? kOutsideNear : 0;
+    code |= (v.z > v.w) ? kOutsideFar : 0;
+    const float guardBand = kGuardBand * v.w;
+    code |= (std::abs(v.x) > guardBand || std::abs(v.y) > guardBand) ? kOutsideGuardBand : 0;
+    return code;
+}
+
+/// @brief 切り取りに使う面からの距離(0以上が内側)
+template <class ClipVertex>
+float GetClipPlaneDistance(const ClipVertex &v, int plane) noexcept {
+    switch (plane) {
+        case 0:
+            return v.z;
+        case 1:
+            return kGuardBand * v.w + v.x;
+        case 2:
+            return kGuardBand * v.w - v.x;
+        case 3:
+            return kGuardBand * v.w + v.y;
+        default:
+            return kGuardBand * v.w - v.y;
+    }
+}
+
+#ifdef KASHIPAN_MATH_SSE2
+/// @brief 4要素の最小値
+inline float HorizontalMin(__m128 v) noexcept {
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(v);
+}
+
+/// @brief 4要素の最大値
+inline float HorizontalMax(__m128 v) noexcept {
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(v);
+}
+#endif
+
+} // namespace
+
+OcclusionCuller::OcclusionCuller() {
+    uint32_t offset = 0;
+    for (uint32_t level = 0; level < kLevelCount; ++level) {
+        levelOffsets_[level] = offset;
+        offset += (kWidth >> level) * (kHeight >> level);
+    }
+    depth_.assign(offset, 1.0f);
+}
+
+void OcclusionCuller::BeginFrame(const Matrix4x4 &viewProjection) {
+    viewProjection_ = viewProjection;
+    std::fill_n(depth_.begin(), kWidth * kHeight, 1.0f);
+    rasterizedTriangleCount_ = 0;
+}
+
+void OcclusionCuller::RenderOccluder(std::span<const Vector3> positions, std::span<const uint32_t> indices, const Matrix4x4 &worldMatrix) {
+    assert(indices.size() % 3 == 0);
+    const Matrix4x4 worldViewProjection = worldMatrix * viewProjection_;
+
+    // 頂点は複数の三角形で共有されるので、先にまとめて変換しておく
+    clipVertices_.resize(positions.size());
+    outcodes_.resize(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        clipVertices_[i] = TransformToClip<ClipVertex>(positions[i], worldViewProjection);
+        outcodes_[i] = ComputeOutcode(clipVertices_[i]);
+    }
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const uint32_t i0 = indices[i];
+        const uint32_t i1 = indices[i + 1];
+        const uint32_t i2 = indices[i + 2];
+        assert(i0 < positions.size() && i1 < positions.size() && i2 < positions.size());
+        // 3頂点とも同じ面の外にあれば描かない
+        if ((outcodes_[i0] & outcodes_[i1] & outcodes_[i2] & kOutsideFrustum) != 0) {
+            continue;
+        }
+        ClipAndRasterize(clipVertices_[i0], clipVertices_[i1], clipVertices_[i2], outcodes_[i0] | outcodes_[i1] | outcodes_[i2]);
+    }
+}
+
+void OcclusionCuller::ClipAndRasterize(const ClipVertex &v0, const ClipVertex &v1, const ClipVertex &v2, uint32_t outcodes) {
+    if ((outcodes & (kOutsideNear | kOutsideGuardBand)) == 0) {
+        RasterizeTriangle(ToScreen(v0), ToScreen(v1), ToScreen(v2));
+        return;
+    }
+
+    // Sutherland-Hodgmanで近平面とガードバンドの内側に切り取る
+    ClipVertex polygon[2][kMaxPolygonVertexCount] = { { v0, v1, v2 } };
+    int count = 3;
+    int current = 0;
+    for (int plane = 0; plane < kClipPlaneCount && count >= 3; ++plane) {
+        const ClipVertex *input = polygon[current];
+        ClipVertex *output = polygon[current ^ 1];
+        int outputCount = 0;
+        for (int i = 0; i < count; ++i) {
+            const ClipVertex &a = input[i];
+            const ClipVertex &b = input[(i + 1) % count];
+            const float distanceA = GetClipPlaneDistance(a, plane);
+            const float distanceB = GetClipPlaneDistance(b, plane);
+            if (distanceA >= 0.0f) {
+                output[outputCount++] = a;
+            }
+            if ((distanceA >= 0.0f) != (distanceB >= 0.0f)) {
+                const float t = distanceA / (distanceA - distanceB);
+                output[outputCount++] = {
+                    a.x + (b.x - a.x) * t,
+                    a.y + (b.y - a.y) * t,
+                    a.z + (b.z - a.z) * t,
+                    a.w + (b.w - a.w) * t,
+                };
+            }
+        }
+        count = outputCount;
+        current ^= 1;
+    }
+    if (count < 3) {
+        return;
+    }
+
+    // 切り取った多角形は凸なので、扇形に分けて描く
+    const ClipVertex *vertices = polygon[current];
+    for (int i = 0; i < count; ++i) {
+        if (!(vertices[i].w > 0.0f)) {
+            return;
+        }
+    }
+    const ScreenVertex first = ToScreen(vertices[0]);
+    ScreenVertex previous = ToScreen(vertices[1]);
+    for (int i = 2; i < count; ++i) {
+        const ScreenVertex next = ToScreen(vertices[i]);
+        RasterizeTriangle(first, previous, next);
+        previous = next;
+    }
+}
+
+OcclusionCuller::ScreenVertex OcclusionCuller::ToScreen(const ClipVertex &v) noexcept {
+    const float inverseW = 1.0f / v.w;
+    return {
+        (v.x * inverseW * 0.5f + 0.5f) * static_cast<float>(kWidth),
+        (0.5f - v.y * inverseW * 0.5f) * static_cast<float>(kHeight),
+        v.z * inverseW,
+    };
+}
+
+void OcclusionCuller::RasterizeTriangle(ScreenVertex v0, ScreenVertex v1, ScreenVertex v2) {
+    // 両面を描くので、向きを揃える(面積が0やNaNなら描かない)
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+    if (area < 0.0f) {
+        std::swap(v1, v2);
+        area = -area;
+    }
+    if (!(area > 0.0f)) {
+        return;
+    }
+
+    // 中心が三角形の境界ボックスに入る画素の範囲
+    const float minX = std::min({ v0.x, v1.x, v2.x });
+    const float maxX = std::max({ v0.x, v1.x, v2.x });
+    const float minY = std::min({ v0.y, v1.y, v2.y });
+    const float maxY = std::max({ v0.y, v1.y, v2.y });
+    const int32_t x0 = std::max(0, static_cast<int32_t>(std::ceil(minX - 0.5f)));
+    const int32_t x1 = std::min(static_cast<int32_t>(kWidth) - 1, static_cast<int32_t>(std::floor(maxX - 0.5f)));
+    const int32_t y0 = std::max(0, static_cast<int32_t>(std::ceil(minY - 0.5f)));
+    const int32_t y1 = std::min(static_cast<int32_t>(kHeight) - 1, static_cast<int32_t>(std::floor(maxY - 0.5f)));
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+    ++rasterizedTriangleCount_;
+
+    // 辺の関数 E(x, y) = A * x + B * y + C。3つとも0以上なら三角形の中(Eiは頂点iの向かいの辺で、Ei / areaが頂点iの重み)
+    const float a0 = v1.y - v2.y, b0 = v2.x - v1.x, c0 = -(a0 * v1.x + b0 * v1.y);
+    const float a1 = v2.y - v0.y, b1 = v0.x - v2.x, c1 = -(a1 * v2.x + b1 * v2.y);
+    const float a2 = v0.y - v1.y, b2 = v1.x - v0.x, c2 = -(a2 * v0.x + b2 * v0.y);
+    // 深度も画面上で線形なので、同じ形の平面の式にする
+    const float inverseArea = 1.0f / area;
+    const float za = (a0 * v0.z + a1 * v1.z + a2 * v2.z) * inverseArea;
+    const float zb = (b0 * v0.z + b1 * v1.z + b2 * v2.z) * inverseArea;
+    const float zc = (c0 * v0.z + c1 * v1.z + c2 * v2.z) * inverseArea;
+
+#ifdef KASHIPAN_MATH_SSE2
+    // 4画素ずつ判定する。行の幅は4の倍数なので、4の倍数に切り下げた位置から始めれば行の外には出ない
+    static_assert(kWidth % 4 == 0);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 edgeA0 = _mm_set1_ps(a0);
+    const __m128 edgeA1 = _mm_set1_ps(a1);
+    const __m128 edgeA2 = _mm_set1_ps(a2);
+    const __m128 depthA = _mm_set1_ps(za);
+#endif
+    const float edgeA[3] = { a0, a1, a2 };
+    const float inverseEdgeA[3] = { 1.0f / a0, 1.0f / a1, 1.0f / a2 };
+    for (int32_t y = y0; y <= y1; ++y) {
+        const float pixelY = static_cast<float>(y) + 0.5f;
+        const float rowEdge[3] = { b0 * pixelY + c0, b1 * pixelY + c1, b2 * pixelY + c2 };
+        const float rowDepth = zb * pixelY + zc;
+
+        // 行の中で3つの辺の関数が0以上になる範囲に絞る(丸め誤差の分だけ1画素広げ、中かどうかは画素ごとに判定する)
+        float spanMin = static_cast<float>(x0);
+        float spanMax = static_cast<float>(x1);
+        for (int i = 0; i < 3; ++i) {
+            if (edgeA[i] > 0.0f) {
+                spanMin = std::max(spanMin, -rowEdge[i] * inverseEdgeA[i] - 0.5f);
+            } else if (edgeA[i] < 0.0f) {
+                spanMax = std::min(spanMax, -rowEdge[i] * inverseEdgeA[i] - 0.5f);
+            }
+        }
+        const int32_t rowX0 = std::max(x0, static_cast<int32_t>(std::min(spanMin, static_cast<float>(x1))) - 1);
+        const int32_t rowX1 = std::min(x1, static_cast<int32_t>(std::max(spanMax, static_cast<float>(x0))) + 1);
+        if (rowX0 > rowX1) {
+            continue;
+        }
+
+        float *row = depth_.data() + static_cast<size_t>(y) * kWidth;
+#ifdef KASHIPAN_MATH_SSE2
+        const __m128 row0 = _mm_set1_ps(rowEdge[0]);
+        const __m128 row1 = _mm_set1_ps(rowEdge[1]);
+        const __m128 row2 = _mm_set1_ps(rowEdge[2]);
+        const __m128 rowDepth4 = _mm_set1_ps(rowDepth);
+        for (int32_t x = rowX0 & ~3; x <= rowX1; x += 4) {
+            const __m128 pixelX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+            const __m128 edge0 = _mm_add_ps(_mm_mul_ps(edgeA0, pixelX), row0);
+            const __m128 edge1 = _mm_add_ps(_mm_mul_ps(edgeA1, pixelX), row1);
+            const __m128 edge2 = _mm_add_ps(_mm_mul_ps(edgeA2, pixelX), row2);
+            const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)), _mm_cmpge_ps(edge2, zero));
+            const __m128 depth = _mm_add_ps(_mm_mul_ps(depthA, pixelX), rowDepth4);
+            const __m128 old = _mm_loadu_ps(row + x);
+            const __m128 nearer = _mm_min_ps(old, depth);
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, old)));
+        }
+#else
+        for (int32_t x = rowX0; x <= rowX1; ++x) {
+            const float pixelX = static_cast<float>(x) + 0.5f;
+            if (a0 * pixelX + rowEdge[0] >= 0.0f && a1 * pixelX + rowEdge[1] >= 0.0f && a2 * pixelX + rowEdge[2] >= 0.0f) {
+                row[x] = std::min(row[x], za * pixelX + rowDepth);
+            }
+        }
+#endif
+    }
+}
+
+void OcclusionCuller::EndOccluders() {
+    // 各段の1テクセルは、1つ上の段の2x2のうち最も奥の深度
+    for (uint32_t level = 1; level < kLevelCount; ++level) {
+        const uint32_t width = kWidth >> level;
+        const uint32_t height = kHeight >> level;
+        const float *source = depth_.data() + levelOffsets_[level - 1];
+        float *destination = depth_.data() + levelOffsets_[level];
+        for (uint32_t y = 0; y < height; ++y) {
+            const float *sourceRow0 = source + (y * 2) * (width * 2);
+            const float *sourceRow1 = sourceRow0 + width * 2;
+            for (uint32_t x = 0; x < width; ++x) {
+                destination[y * width + x] = std::max(
+                    std::max(sourceRow0[x * 2], sourceRow0[x * 2 + 1]),
+                    std::max(sourceRow1[x * 2], sourceRow1[x * 2 + 1]));
+            }
+        }
+    }
+}
+
+bool OcclusionCuller::IsVisible(const Vector3 &localMin, const Vector3 &localMax, const Matrix4x4 &worldMatrix) const {
+    const Matrix4x4 worldViewProjection = worldMatrix * viewProjection_;
+
+    // 画面上の範囲と、最も手前の深度
+    float minX = static_cast<float>(kWidth);
+    float maxX = 0.0f;
+    float minY = static_cast<float>(kHeight);
+    float maxY = 0.0f;
+    float minDepth = 1.0f;
+
+#ifdef KASHIPAN_MATH_SSE2
+    // 角は最小点に各軸の辺を足したものなので、行列との積は最小点と3つの辺の4回で済む
+    const __m128 row0 = _mm_loadu_ps(worldViewProjection.m[0]);
+    const __m128 row1 = _mm_loadu_ps(worldViewProjection.m[1]);
+    const __m128 row2 = _mm_loadu_ps(worldViewProjection.m[2]);
+    const __m128 row3 = _mm_loadu_ps(worldViewProjection.m[3]);
+    const __m128 base = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(localMin.x), row0), _mm_mul_ps(_mm_set1_ps(localMin.y), row1)),
+        _mm_add_ps(_mm_mul_ps(_mm_set1_ps(localMin.z), row2), row3));
+    const __m128 edgeX = _mm_mul_ps(_mm_set1_ps(localMax.x - localMin.x), row0);
+    const __m128 edgeY = _mm_mul_ps(_mm_set1_ps(localMax.y - localMin.y), row1);
+    const __m128 edgeZ = _mm_mul_ps(_mm_set1_ps(localMax.z - localMin.z), row2);
+    // 4つの角ずつ、x, y, z, wの並びに入れ替える
+    __m128 x[2], y[2], z[2], w[2];
+    for (int i = 0; i < 2; ++i) {
+        __m128 corner0 = (i == 0) ? base : _mm_add_ps(base, edgeZ);
+        __m128 corner1 = _mm_add_ps(corner0, edgeX);
+        __m128 corner2 = _mm_add_ps(corner0, edgeY);
+        __m128 corner3 = _mm_add_ps(corner2, edgeX);
+        _MM_TRANSPOSE4_PS(corner0, corner1, corner2, corner3);
+        x[i] = corner0;
+        y[i] = corner1;
+        z[i] = corner2;
+        w[i] = corner3;
+    }
+
+    // 全ての角が同じ面の外にあれば視錐台の外
+    const __m128 zero = _mm_setzero_ps();
+    __m128 outside[6];
+    for (int i = 0; i < 2; ++i) {
+        const __m128 negativeW = _mm_sub_ps(zero, w[i]);
+        const __m128 masks[6] = {
+            _mm_cmplt_ps(x[i], negativeW), _mm_cmpgt_ps(x[i], w[i]),
+            _mm_cmplt_ps(y[i], negativeW), _mm_cmpgt_ps(y[i], w[i]),
+            _mm_cmplt_ps(z[i], zero), _mm_cmpgt_ps(z[i], w[i]),
+        };
+        for (int plane = 0; plane < 6; ++plane) {
+            outside[plane] = (i == 0) ? masks[plane] : _mm_and_ps(outside[plane], masks[plane]);
+        }
+    }
+    for (const __m128 &mask : outside) {
+        if (_mm_movemask_ps(mask) == 0xF) {
+            return false;
+        }
+    }
+    // 近平面をまたぐボックスは画面上の範囲が求まらないので、見えるとみなす
+    if (_mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(z[0], zero), _mm_cmplt_ps(z[1], zero))) != 0) {
+        return true;
+    }
+
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128 minX4 = _mm_set1_ps(minX), maxX4 = _mm_set1_ps(maxX);
+    __m128 minY4 = _mm_set1_ps(minY), maxY4 = _mm_set1_ps(maxY);
+    __m128 minDepth4 = _mm_set1_ps(minDepth);
+    for (int i = 0; i < 2; ++i) {
+        const __m128 inverseW = _mm_div_ps(_mm_set1_ps(1.0f), w[i]);
+        const __m128 screenX = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(x[i], inverseW), half), half), _mm_set1_ps(static_cast<float>(kWidth)));
+        const __m128 screenY = _mm_mul_ps(_mm_sub_ps(half, _mm_mul_ps(_mm_mul_ps(y[i], inverseW), half)), _mm_set1_ps(static_cast<float>(kHeight)));
+        minX4 = _mm_min_ps(minX4, screenX);
+        maxX4 = _mm_max_ps(maxX4, screenX);
+        minY4 = _mm_min_ps(minY4, screenY);
+        maxY4 = _mm_max_ps(maxY4, screenY);
+        minDepth4 = _mm_min_ps(minDepth4, _mm_mul_ps(z[i], inverseW));
+    }
+    minX = HorizontalMin(minX4);
+    maxX = HorizontalMax(maxX4);
+    minY = HorizontalMin(minY4);
+    maxY = HorizontalMax(maxY4);
+    minDepth = HorizontalMin(minDepth4);
+#else
+    // 8つの角をクリップ座標にする
+    ClipVertex corners[8];
+    uint32_t outcodeAnd = kOutsideFrustum;
+    uint32_t outcodeOr = 0;
+    for (int i = 0; i < 8; ++i) {
+        const Vector3 corner(
+            (i & 1) ? localMax.x : localMin.x,
+            (i & 2) ? localMax.y : localMin.y,
+            (i & 4) ? localMax.z : localMin.z);
+        corners[i] = TransformToClip<ClipVertex>(corner, worldViewProjection);
+        const uint32_t outcode = ComputeOutcode(corners[i]);
+        outcodeAnd &= outcode;
+        outcodeOr |= outcode;
+    }
+    // 全ての角が同じ面の外にあれば視錐台の外
+    if (outcodeAnd != 0) {
+        return false;
+    }
+    // 近平面をまたぐボックスは画面上の範囲が求まらないので、見えるとみなす
+    if ((outcodeOr & kOutsideNear) != 0) {
+        return true;
+    }
+
+    for (const ClipVertex &corner : corners) {
+        const ScreenVertex screen = ToScreen(corner);
+        minX = std::min(minX, screen.x);
+        maxX = std::max(maxX, screen.x);
+        minY = std::min(minY, screen.y);
+        maxY = std::max(maxY, screen.y);
+        minDepth = std::min(minDepth, screen.z);
+    }
+#endif
+
+    // ボックスが掛かる画素の範囲(画面の中に収める。std::maxとstd::minの引数の順番で、NaNは0になる)
+    const float lastX = static_cast<float>(kWidth - 1);
+    const float lastY = static_cast<float>(kHeight - 1);
+    const uint32_t x0 = static_cast<uint32_t>(std::min(lastX, std::max(0.0f, minX)));
+    const uint32_t x1 = static_cast<uint32_t>(std::min(lastX, std::max(0.0f, maxX)));
+    const uint32_t y0 = static_cast<uint32_t>(std::min(lastY, std::max(0.0f, minY)));
+    const uint32_t y1 = static_cast<uint32_t>(std::min(lastY, std::max(0.0f, maxY)));
+
+    // 範囲が2x2テクセル以内に収まる段を選ぶ(最後の段は2x1なので必ず収まる)
+    uint32_t level = 0;
+    while (level + 1 < kLevelCount && (((x1 >> level) - (x0 >> level)) > 1 || ((y1 >> level) - (y0 >> level)) > 1)) {
+        ++level;
+    }
+
+    // いずれかのテクセルで遮蔽物の最も奥がボックスの最も手前より奥(か同じ)なら見える
+    const uint32_t width = kWidth >> level;
+    const float *texels = depth_.data() + levelOffsets_[level];
+    for (uint32_t y = y0 >> level; y <= (y1 >> level); ++y) {
+        for (uint32_t x = x0 >> level; x <= (x1 >> level); ++x) {
+            if (!(texels[y * width + x] < minDepth)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace Math
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Vector3.h"
+#include "Matrix4x4.h"
+
+namespace KashipanEngine {
+
+/*
+CPUで行うオクルージョンカリング。大きな遮蔽物(地面や大きな敵)のメッシュを低解像度の深度バッファに描き、
+物体の境界ボックスがその裏に完全に隠れているかを、描画のキューに積む前に調べる。
+  BeginFrame     : ビュープロジェクション行列を設定し、深度バッファを一番奥(1)で埋める
+  RenderOccluder : 遮蔽物の三角形を深度バッファに描く(手前の深度を残す)
+  EndOccluders   : 深度バッファから、2x2の最も奥の深度を取っていく階層(Hi-Z)を作る
+  IsVisible      : 境界ボックスが見えるかどうか(Hi-Zの2x2テクセルだけと比べる)
+深度はクリップ座標のz/w(DirectXと同じく手前が0、奥が1)。三角形は両面を描き、画素の中心で覆うかを判定する。
+近平面とガードバンド(画面の4倍の範囲)で三角形を切り取ってから描くので、カメラの後ろや画面の遠く外へ伸びる地面も描ける。
+1行の画素は4つずつSSE2で判定して書き込む。SSE2が使えない環境ではスカラーで同じ計算をする。
+見えるかの判定は保守的で、近平面をまたぐボックスや視錐台と重なるかが分からないボックスは見えるとみなす。
+隠れていると判定されるのは、ボックスを囲む画素の全てで、遮蔽物がボックスの最も手前より手前にある場合だけ。
+*/
+
+namespace Math {
+
+/// @brief 低解像度の深度バッファによるオクルージョンカリング
+class OcclusionCuller {
+public:
+    /// @brief 深度バッファの幅
+    static constexpr uint32_t kWidth = 256;
+    /// @brief 深度バッファの高さ
+    static constexpr uint32_t kHeight = 128;
+    /// @brief Hi-Zの段数(kWidth x kHeightから2x1まで)
+    static constexpr uint32_t kLevelCount = 8;
+
+    OcclusionCuller();
+
+    /// @brief フレームの開始。深度バッファを一番奥で埋める
+    /// @param viewProjection ビュープロジェクション行列
+    void BeginFrame(const Matrix4x4 &viewProjection);
+
+    /// @brief 遮蔽物のメッシュを深度バッファに描く
+    /// @param positions 頂点の位置(ローカル座標)
+    /// @param indices インデックス(3つで1つの三角形)
+    /// @param worldMatrix ワールド行列
+    void RenderOccluder(std::span<const Vector3> positions, std::span<const uint32_t> indices, const Matrix4x4 &worldMatrix);
+
+    /// @brief 遮蔽物を描き終えたらHi-Zを作る(IsVisibleの前に呼ぶ)
+    void EndOccluders();
+
+    /// @brief 境界ボックスが見えるか
+    /// @param localMin 境界ボックスの最小点(ローカル座標)
+    /// @param localMax 境界ボックスの最大点(ローカル座標)
+    /// @param worldMatrix ワールド行列
+    /// @return 見える可能性があればtrue、遮蔽物に完全に隠れているか視錐台の外にあればfalse
+    [[nodiscard]] bool IsVisible(const Vector3 &localMin, const Vector3 &localMax, const Matrix4x4 &worldMatrix) const;
+
+    /// @brief 深度バッファ(kWidth x kHeight、行優先)を取得
+    [[nodiscard]] std::span<const float> GetDepthBuffer() const noexcept {
+        return { depth_.data(), kWidth * kHeight };
+    }
+
+    /// @brief BeginFrameから今までに深度バッファに描いた三角形の数(切り取りで分かれたものも含む)を取得
+    [[nodiscard]] uint32_t GetRasterizedTriangleCount() const noexcept {
+        return rasterizedTriangleCount_;
+    }
+
+private:
+    /// @brief クリップ座標の頂点
+    struct ClipVertex {
+        float x;
+        float y;
+        float z;
+        float w;
+    };
+    /// @brief 画面上の頂点(x, yは画素単位、zは深度)
+    struct ScreenVertex {
+        float x;
+        float y;
+        float z;
+    };
+
+    /// @brief 近平面とガードバンドで切り取ってから描く
+    void ClipAndRasterize(const ClipVertex &v0, const ClipVertex &v1, const ClipVertex &v2, uint32_t outcodes);
+    /// @brief 画面上の三角形を深度バッファに描く
+    void RasterizeTriangle(ScreenVertex v0, ScreenVertex v1, ScreenVertex v2);
+    /// @brief クリップ座標を画面上の位置にする
+    static ScreenVertex ToScreen(const ClipVertex &v) noexcept;
+
+    // ビュープロジェクション行列
+    Matrix4x4 viewProjection_ = Matrix4x4::Identity();
+    // Hi-Zの全ての段を1つの配列に並べたもの(先頭の段が深度バッファ)
+    std::vector<float> depth_;
+    // 各段の先頭の位置
+    uint32_t levelOffsets_[kLevelCount] = {};
+    // 描いた三角形の数
+    uint32_t rasterizedTriangleCount_ = 0;
+    // RenderOccluderの中だけで使う、頂点のクリップ座標と視錐台の外にある面のビット
+    std::vector<ClipVertex> clipVertices_;
+    std::vector<uint32_t> outcodes_;
+};
+
+} // namespace Math
+
+} // namespace KashipanEngine
\ No newline at end of file
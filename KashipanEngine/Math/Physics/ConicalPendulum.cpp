@@ -1,6 +1,7 @@
 #include "ConicalPendulum.h"
 #include "Math/MathObjects/Lines.h"
 #include "Math/MathObjects/Sphere.h"
+#include "Math/FastMath.h"
 #include <cmath>
 
 namespace KashipanEngine {
@@ -9,16 +10,20 @@ void ConicalPendulum::CalculateAngle(const float deltaTime) {
     // 重力加速度
     static const float g = 9.8f;
 
-    angularVelocity = std::sqrt(g / (length * std::cos(halfApexAngle)));
+    float sinApex, cosApex;
+    Math::Gameplay::SinCos(halfApexAngle, sinApex, cosApex);
+    angularVelocity = std::sqrt(g / (length * cosApex));
     angle += angularVelocity * deltaTime;
 
-    float radius = std::sin(halfApexAngle) * length;
-    float height = std::cos(halfApexAngle) * length;
+    float radius = sinApex * length;
+    float height = cosApex * length;
 
     // 振り子の先端位置を計算
-    bob.x = anchor.x + std::cos(angle) * radius;
+    float sinAngle, cosAngle;
+    Math::Gameplay::SinCos(angle, sinAngle, cosAngle);
+    bob.x = anchor.x + cosAngle * radius;
     bob.y = anchor.y - height;
-    bob.z = anchor.z - std::sin(angle) * radius;
+    bob.z = anchor.z - sinAngle * radius;
 }
 
 } // namespace KashipanEngine
\ No newline at end of file
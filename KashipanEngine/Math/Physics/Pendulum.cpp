@@ -1,6 +1,7 @@
 #include "Pendulum.h"
 #include "Math/MathObjects/Lines.h"
 #include "Math/MathObjects/Sphere.h"
+#include "Math/FastMath.h"
 #include <cmath>
 
 namespace KashipanEngine {
@@ -9,12 +10,14 @@ void Pendulum::CalculateAngle(const float deltaTime) {
     // 重力加速度
     static const float g = 9.8f;
 
-    angularAcceleration = (-g / length) * std::sin(angle);
+    angularAcceleration = (-g / length) * Math::Gameplay::Sin(angle);
     angularVelocity += angularAcceleration * deltaTime;
     angle += angularVelocity * deltaTime;
 
-    bob.x = anchor.x + std::sin(angle) * length;
-    bob.y = anchor.y - std::cos(angle) * length;
+    float sinAngle, cosAngle;
+    Math::Gameplay::SinCos(angle, sinAngle, cosAngle);
+    bob.x = anchor.x + sinAngle * length;
+    bob.y = anchor.y - cosAngle * length;
     bob.z = anchor.z;
 }
 
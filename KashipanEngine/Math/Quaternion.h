@@ -0,0 +1,328 @@
+#pragma once
+#include <cmath>
+#include <algorithm>
+
+namespace KashipanEngine {
+
+struct Vector3;
+struct Matrix4x4;
+
+/*
+回転を表すクォータニオン(x, y, zが虚部、wが実部)。
+掛け算はハミルトン積で、a * b は b の回転をしてから a の回転をする。
+エンジンの行列は行ベクトル(v * M)なので、ToMatrix は Matrix4x4::MakeRotate と同じ並びの行列を返す。
+*/
+
+struct Quaternion final {
+    /// @brief 単位クォータニオンを取得する
+    /// @return 単位クォータニオン
+    [[nodiscard]] static constexpr Quaternion Identity() noexcept;
+
+    /// @brief 軸と角度からクォータニオンを生成する
+    /// @param axis 回転軸(正規化済み)
+    /// @param radian 回転角度
+    /// @return クォータニオン
+    [[nodiscard]] static Quaternion FromAxisAngle(const Vector3 &axis, float radian) noexcept;
+
+    /// @brief XYZ順のオイラー角からクォータニオンを生成する
+    /// @param rotate 回転角度(Matrix4x4::MakeRotateと同じ順番)
+    /// @return クォータニオン
+    [[nodiscard]] static Quaternion FromEuler(const Vector3 &rotate) noexcept;
+
+    /// @brief 回転行列からクォータニオンを生成する
+    /// @param matrix 回転行列(拡大縮小を含まないもの)
+    /// @return クォータニオン
+    [[nodiscard]] static Quaternion FromMatrix(const Matrix4x4 &matrix) noexcept;
+
+    /// @brief 指定の方向を向く回転を生成する(+Zがforward、+Yがupに近くなる)
+    /// @param forward 向かせたい方向
+    /// @param up 上方向
+    /// @return クォータニオン
+    [[nodiscard]] static Quaternion LookRotation(const Vector3 &forward, const Vector3 &up) noexcept;
+
+    /// @brief 正規化線形補間。最短経路を通り、角速度は一定ではないが軽い
+    /// @param start 開始
+    /// @param end 終了
+    /// @param t 補間係数
+    /// @return 補間結果
+    [[nodiscard]] static Quaternion Nlerp(const Quaternion &start, const Quaternion &end, float t) noexcept;
+
+    /// @brief 球面線形補間
+    /// @param start 開始
+    /// @param end 終了
+    /// @param t 補間係数
+    /// @return 補間結果
+    [[nodiscard]] static Quaternion Slerp(const Quaternion &start, const Quaternion &end, float t) noexcept;
+
+    /// @brief 補間係数を多項式で補正したNlerpで球面線形補間を近似する(acos・sinを使わない)
+    /// @param start 開始
+    /// @param end 終了
+    /// @param t 補間係数
+    /// @return 補間結果
+    /// @note Slerpとの角度の誤差は最大で約1e-3ラジアン
+    [[nodiscard]] static Quaternion SlerpFast(const Quaternion &start, const Quaternion &end, float t) noexcept;
+
+    Quaternion() noexcept = default;
+    constexpr Quaternion(float x, float y, float z, float w) noexcept : x(x), y(y), z(z), w(w) {}
+    constexpr Quaternion(const Quaternion &quaternion) noexcept = default;
+
+    constexpr Quaternion &operator=(const Quaternion &quaternion) noexcept = default;
+    constexpr Quaternion &operator*=(const Quaternion &quaternion) noexcept;
+    constexpr bool operator==(const Quaternion &quaternion) const noexcept;
+    constexpr bool operator!=(const Quaternion &quaternion) const noexcept;
+
+    [[nodiscard]] constexpr float Dot(const Quaternion &quaternion) const noexcept;
+    [[nodiscard]] constexpr float LengthSquared() const noexcept;
+    [[nodiscard]] float Length() const noexcept;
+    [[nodiscard]] Quaternion Normalize() const noexcept;
+    [[nodiscard]] constexpr Quaternion Conjugate() const noexcept;
+    [[nodiscard]] constexpr Quaternion Inverse() const noexcept;
+
+    /// @brief ベクトルを回転させる
+    /// @param vector 回転させるベクトル
+    /// @return 回転後のベクトル
+    [[nodiscard]] constexpr Vector3 RotateVector(const Vector3 &vector) const noexcept;
+
+    /// @brief 回転行列に変換する
+    /// @return 回転行列
+    [[nodiscard]] constexpr Matrix4x4 ToMatrix() const noexcept;
+
+    float x;
+    float y;
+    float z;
+    float w;
+};
+
+inline constexpr Quaternion operator-(const Quaternion &q) noexcept {
+    return Quaternion(-q.x, -q.y, -q.z, -q.w);
+}
+
+inline constexpr Quaternion operator+(const Quaternion &a, const Quaternion &b) noexcept {
+    return Quaternion(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+}
+
+inline constexpr Quaternion operator-(const Quaternion &a, const Quaternion &b) noexcept {
+    return Quaternion(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);
+}
+
+inline constexpr Quaternion operator*(const Quaternion &q, float scalar) noexcept {
+    return Quaternion(q.x * scalar, q.y * scalar, q.z * scalar, q.w * scalar);
+}
+
+inline constexpr Quaternion operator*(float scalar, const Quaternion &q) noexcept {
+    return q * scalar;
+}
+
+inline constexpr Quaternion operator*(const Quaternion &a, const Quaternion &b) noexcept {
+    return Quaternion(
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+    );
+}
+
+} // namespace KashipanEngine
+
+// 変換に使う型はQuaternionの定義の後に読み込む(互いに読み込み合っても定義の順番が崩れないように)
+#include "Vector3.h"
+#include "Matrix4x4.h"
+
+namespace KashipanEngine {
+
+inline constexpr Quaternion Quaternion::Identity() noexcept {
+    return Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+inline Quaternion Quaternion::FromAxisAngle(const Vector3 &axis, float radian) noexcept {
+    const float half = radian * 0.5f;
+    const float s = std::sin(half);
+    return Quaternion(axis.x * s, axis.y * s, axis.z * s, std::cos(half));
+}
+
+inline Quaternion Quaternion::FromEuler(const Vector3 &rotate) noexcept {
+    const float sx = std::sin(rotate.x * 0.5f);
+    const float cx = std::cos(rotate.x * 0.5f);
+    const float sy = std::sin(rotate.y * 0.5f);
+    const float cy = std::cos(rotate.y * 0.5f);
+    const float sz = std::sin(rotate.z * 0.5f);
+    const float cz = std::cos(rotate.z * 0.5f);
+    // X → Y → Z の順に回すので qZ * qY * qX を展開したもの
+    return Quaternion(
+        sx * cy * cz - cx * sy * sz,
+        cx * sy * cz + sx * cy * sz,
+        cx * cy * sz - sx * sy * cz,
+        cx * cy * cz + sx * sy * sz
+    );
+}
+
+inline Quaternion Quaternion::FromMatrix(const Matrix4x4 &matrix) noexcept {
+    const auto &m = matrix.m;
+    const float trace = m[0][0] + m[1][1] + m[2][2];
+    if (trace > 0.0f) {
+        const float s = std::sqrt(trace + 1.0f) * 2.0f;
+        const float invS = 1.0f / s;
+        return Quaternion(
+            (m[1][2] - m[2][1]) * invS,
+            (m[2][0] - m[0][2]) * invS,
+            (m[0][1] - m[1][0]) * invS,
+            0.25f * s
+        );
+    }
+    // 対角成分が最大の軸を基準にして桁落ちを避ける
+    if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+        const float s = std::sqrt(1.0f + m[0][0] - m[1][1] - m[2][2]) * 2.0f;
+        const float invS = 1.0f / s;
+        return Quaternion(
+            0.25f * s,
+            (m[0][1] + m[1][0]) * invS,
+            (m[0][2] + m[2][0]) * invS,
+            (m[1][2] - m[2][1]) * invS
+        );
+    }
+    if (m[1][1] > m[2][2]) {
+        const float s = std::sqrt(1.0f + m[1][1] - m[0][0] - m[2][2]) * 2.0f;
+        const float invS = 1.0f / s;
+        return Quaternion(
+            (m[0][1] + m[1][0]) * invS,
+            0.25f * s,
+            (m[1][2] + m[2][1]) * invS,
+            (m[2][0] - m[0][2]) * invS
+        );
+    }
+    const float s = std::sqrt(1.0f + m[2][2] - m[0][0] - m[1][1]) * 2.0f;
+    const float invS = 1.0f / s;
+    return Quaternion(
+        (m[0][2] + m[2][0]) * invS,
+        (m[1][2] + m[2][1]) * invS,
+        0.25f * s,
+        (m[0][1] - m[1][0]) * invS
+    );
+}
+
+inline Quaternion Quaternion::LookRotation(const Vector3 &forward, const Vector3 &up) noexcept {
+    const float forwardLength = forward.Length();
+    if (forwardLength == 0.0f) {
+        return Identity();
+    }
+    const Vector3 axisZ = forward / forwardLength;
+    Vector3 axisX = up.Cross(axisZ);
+    float rightLength = axisX.Length();
+    // forwardとupが平行な場合はforwardと最も平行でない軸を使う
+    if (rightLength < 1e-6f) {
+        const Vector3 fallback = (std::fabs(axisZ.x) < 0.9f) ? Vector3(1.0f, 0.0f, 0.0f) : Vector3(0.0f, 1.0f, 0.0f);
+        axisX = fallback - axisZ * axisZ.Dot(fallback);
+        rightLength = axisX.Length();
+    }
+    axisX /= rightLength;
+    const Vector3 axisY = axisZ.Cross(axisX);
+
+    return FromMatrix(Matrix4x4(
+        axisX.x, axisX.y, axisX.z, 0.0f,
+        axisY.x, axisY.y, axisY.z, 0.0f,
+        axisZ.x, axisZ.y, axisZ.z, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    ));
+}
+
+inline Quaternion Quaternion::Nlerp(const Quaternion &start, const Quaternion &end, float t) noexcept {
+    // 最短経路を通るように符号を揃える
+    const Quaternion target = (start.Dot(end) < 0.0f) ? -end : end;
+    return (start * (1.0f - t) + target * t).Normalize();
+}
+
+inline Quaternion Quaternion::Slerp(const Quaternion &start, const Quaternion &end, float t) noexcept {
+    float dot = start.Dot(end);
+    Quaternion target = end;
+    if (dot < 0.0f) {
+        dot = -dot;
+        target = -end;
+    }
+    // ほぼ同じ向きの場合はsinが0に近くなるのでNlerpで補間する
+    if (dot > 0.9995f) {
+        return (start * (1.0f - t) + target * t).Normalize();
+    }
+    const float theta = std::acos(dot);
+    const float invSinTheta = 1.0f / std::sin(theta);
+    const float t1 = std::sin(theta * (1.0f - t)) * invSinTheta;
+    const float t2 = std::sin(theta * t) * invSinTheta;
+    return start * t1 + target * t2;
+}
+
+inline Quaternion Quaternion::SlerpFast(const Quaternion &start, const Quaternion &end, float t) noexcept {
+    const float dot = start.Dot(end);
+    const float d = std::fabs(dot);
+    // 角度に応じて補間係数をSlerpの角速度に近づける補正(cosの3次式でフィッティングしたもの)
+    const float a = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    const float b = 0.848013f + d * (-1.06021f + d * 0.215638f);
+    const float k = a * (t - 0.5f) * (t - 0.5f) + b;
+    const float correctedT = t + t * (t - 0.5f) * (t - 1.0f) * k;
+    const Quaternion target = (dot < 0.0f) ? -end : end;
+    return (start * (1.0f - correctedT) + target * correctedT).Normalize();
+}
+
+inline constexpr Quaternion &Quaternion::operator*=(const Quaternion &quaternion) noexcept {
+    *this = *this * quaternion;
+    return *this;
+}
+
+inline constexpr bool Quaternion::operator==(const Quaternion &quaternion) const noexcept {
+    return x == quaternion.x && y == quaternion.y && z == quaternion.z && w == quaternion.w;
+}
+
+inline constexpr bool Quaternion::operator!=(const Quaternion &quaternion) const noexcept {
+    return !(*this == quaternion);
+}
+
+inline constexpr float Quaternion::Dot(const Quaternion &quaternion) const noexcept {
+    return x * quaternion.x + y * quaternion.y + z * quaternion.z + w * quaternion.w;
+}
+
+inline constexpr float Quaternion::LengthSquared() const noexcept {
+    return Dot(*this);
+}
+
+inline float Quaternion::Length() const noexcept {
+    return std::sqrt(LengthSquared());
+}
+
+inline Quaternion Quaternion::Normalize() const noexcept {
+    const float len = Length();
+    return (len != 0.0f) ? *this * (1.0f / len) : Identity();
+}
+
+inline constexpr Quaternion Quaternion::Conjugate() const noexcept {
+    return Quaternion(-x, -y, -z, w);
+}
+
+inline constexpr Quaternion Quaternion::Inverse() const noexcept {
+    const float lengthSquared = LengthSquared();
+    return (lengthSquared != 0.0f) ? Conjugate() * (1.0f / lengthSquared) : Identity();
+}
+
+inline constexpr Vector3 Quaternion::RotateVector(const Vector3 &vector) const noexcept {
+    // v' = v + 2w(u × v) + 2u × (u × v)
+    const Vector3 u(x, y, z);
+    const Vector3 t = u.Cross(vector) * 2.0f;
+    return vector + t * w + u.Cross(t);
+}
+
+inline constexpr Matrix4x4 Quaternion::ToMatrix() const noexcept {
+    const float xx = x * x;
+    const float yy = y * y;
+    const float zz = z * z;
+    const float xy = x * y;
+    const float xz = x * z;
+    const float yz = y * z;
+    const float wx = w * x;
+    const float wy = w * y;
+    const float wz = w * z;
+    return Matrix4x4(
+        1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f,
+        2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f,
+        2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    );
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,301 @@
+#include "SpatialQuery.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+namespace KashipanEngine {
+
+namespace Math {
+
+namespace {
+
+// セルの一辺を自動で決めるときの、1つのセルあたりの点の数の目安
+constexpr float kPointsPerCell = 4.0f;
+// 1つの軸のセルの数の上限
+constexpr int32_t kMaxCellsPerAxis = 256;
+// セルの一辺の最小値(点が全て同じ位置にある場合に使う)
+constexpr float kMinCellSize = 1.0e-4f;
+// 距離をまとめて求める点の数
+constexpr uint32_t kBlockSize = 64;
+
+/// @brief 距離が近い方(同じなら添字の小さい方)が先
+bool IsNearer(const SpatialQuery::Result &a, const SpatialQuery::Result &b) noexcept {
+    return a.distanceSquared < b.distanceSquared ||
+        (a.distanceSquared == b.distanceSquared && a.index < b.index);
+}
+
+/// @brief 座標をセルの座標にする(範囲外やNaNは端のセルにまとめる)
+/// @details 分岐せずに範囲に収めてから整数にする(0以上なので切り捨てでstd::floorと同じになる)。
+/// std::maxとstd::minの引数の順番で、NaNは0になる
+int32_t ToCell(float value, float origin, float inverseCellSize, int32_t cellCount) noexcept {
+    const float cell = std::min(static_cast<float>(cellCount - 1), std::max(0.0f, (value - origin) * inverseCellSize));
+    return static_cast<int32_t>(cell);
+}
+
+/// @brief 区間[min, max]とvalueの距離
+float GetDistanceToRange(float value, float min, float max) noexcept {
+    return std::max({ 0.0f, min - value, value - max });
+}
+
+} // namespace
+
+void SpatialQuery::Build(std::span<const float> x, std::span<const float> y, std::span<const float> z, float cellSize) {
+    assert(y.size() == x.size() && z.size() == x.size());
+    const uint32_t count = static_cast<uint32_t>(x.size());
+
+    if (cellSize == kNoGrid) {
+        // 並べ替えずにそのまま持ち、1つのセルとして扱う
+        origin_[0] = origin_[1] = origin_[2] = 0.0f;
+        cellSize_ = kNoGrid;
+        inverseCellSize_ = 0.0f;
+        cellCounts_[0] = cellCounts_[1] = cellCounts_[2] = 1;
+        cellStarts_.assign({ 0u, count });
+        x_.assign(x.begin(), x.end());
+        y_.assign(y.begin(), y.end());
+        z_.assign(z.begin(), z.end());
+        indices_.resize(count);
+        std::iota(indices_.begin(), indices_.end(), 0u);
+        return;
+    }
+
+    // 点の範囲
+    float min[3] = { 0.0f, 0.0f, 0.0f };
+    float max[3] = { 0.0f, 0.0f, 0.0f };
+    if (count > 0) {
+        min[0] = max[0] = x[0];
+        min[1] = max[1] = y[0];
+        min[2] = max[2] = z[0];
+    }
+    for (uint32_t i = 1; i < count; ++i) {
+        min[0] = std::min(min[0], x[i]);
+        min[1] = std::min(min[1], y[i]);
+        min[2] = std::min(min[2], z[i]);
+        max[0] = std::max(max[0], x[i]);
+        max[1] = std::max(max[1], y[i]);
+        max[2] = std::max(max[2], z[i]);
+    }
+    const float extent[3] = { max[0] - min[0], max[1] - min[1], max[2] - min[2] };
+    const float maxExtent = std::max({ extent[0], extent[1], extent[2] });
+
+    // セルの一辺を決める。自動なら、範囲の広い軸だけで数えてセルの数が点の数/kPointsPerCellくらいになるようにする
+    const float targetCellCount = std::max(1.0f, static_cast<float>(count) / kPointsPerCell);
+    if (cellSize <= 0.0f) {
+        cellSize = maxExtent / std::cbrt(targetCellCount);
+        for (int i = 0; i < 8; ++i) {
+            float cellCount = 1.0f;
+            for (int axis = 0; axis < 3; ++axis) {
+                cellCount *= std::floor(extent[axis] / cellSize) + 1.0f;
+            }
+            if (cellCount * 2.0f >= targetCellCount) {
+                break;
+            }
+            cellSize *= 0.5f;
+        }
+    }
+    // セルが多すぎるとセルの走査の方が重くなるので、軸ごとと全体の数を制限する
+    cellSize = std::max({ cellSize, maxExtent / static_cast<float>(kMaxCellsPerAxis - 1), kMinCellSize });
+    while (true) {
+        float cellCount = 1.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            cellCount *= std::floor(extent[axis] / cellSize) + 1.0f;
+        }
+        if (cellCount <= targetCellCount * kPointsPerCell * 2.0f + 64.0f) {
+            break;
+        }
+        cellSize *= 2.0f;
+    }
+
+    cellSize_ = cellSize;
+    inverseCellSize_ = 1.0f / cellSize;
+    for (int axis = 0; axis < 3; ++axis) {
+        origin_[axis] = min[axis];
+        cellCounts_[axis] = static_cast<int32_t>(std::floor(extent[axis] * inverseCellSize_)) + 1;
+    }
+
+    // 点をセルの順に並べる(計数ソートなので、同じセルの中は元の添字の順)
+    // メンバーへの書き込みで他のメンバーを読み直さないよう、ループで使う値はローカルに置く
+    const float origin[3] = { origin_[0], origin_[1], origin_[2] };
+    const float inverseCellSize = inverseCellSize_;
+    const int32_t cellCounts[3] = { cellCounts_[0], cellCounts_[1], cellCounts_[2] };
+    const size_t cellCount = static_cast<size_t>(cellCounts[0]) * cellCounts[1] * cellCounts[2];
+    cellStarts_.assign(cellCount + 1, 0);
+    pointCells_.resize(count);
+    uint32_t *cellStarts = cellStarts_.data();
+    uint32_t *pointCells = pointCells_.data();
+    for (uint32_t i = 0; i < count; ++i) {
+        const int32_t cellX = ToCell(x[i], origin[0], inverseCellSize, cellCounts[0]);
+        const int32_t cellY = ToCell(y[i], origin[1], inverseCellSize, cellCounts[1]);
+        const int32_t cellZ = ToCell(z[i], origin[2], inverseCellSize, cellCounts[2]);
+        pointCells[i] = static_cast<uint32_t>((cellZ * cellCounts[1] + cellY) * cellCounts[0] + cellX);
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        ++cellStarts[pointCells[i] + 1];
+    }
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+        cellStarts[cell + 1] += cellStarts[cell];
+    }
+
+    x_.resize(count);
+    y_.resize(count);
+    z_.resize(count);
+    indices_.resize(count);
+    float *sortedX = x_.data();
+    float *sortedY = y_.data();
+    float *sortedZ = z_.data();
+    uint32_t *indices = indices_.data();
+    // 各セルの書き込み位置として先頭を使い、書き終わったら1つずれた分を戻す
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t position = cellStarts[pointCells[i]]++;
+        sortedX[position] = x[i];
+        sortedY[position] = y[i];
+        sortedZ[position] = z[i];
+        indices[position] = i;
+    }
+    for (size_t cell = cellCount; cell > 0; --cell) {
+        cellStarts[cell] = cellStarts[cell - 1];
+    }
+    cellStarts[0] = 0;
+}
+
+size_t SpatialQuery::FindNearest(const Vector3 &center, float radius, std::span<Result> outResults) const {
+    return Find(center, radius, [](const Vector3 &, const Vector3 &, float) { return true; }, outResults);
+}
+
+size_t SpatialQuery::FindNearestInCone(const Vector3 &center, float radius, const Vector3 &direction, float cosHalfAngle,
+    std::span<Result> outResults) const {
+    // 角度を比べる代わりに、内積と距離の2乗で比べる(平方根を取らない)
+    const float cosSquared = cosHalfAngle * cosHalfAngle;
+    const bool isNarrow = cosHalfAngle >= 0.0f;
+    return Find(center, radius, [&](const Vector3 &, const Vector3 &offset, float distanceSquared) {
+        const float dot = offset.Dot(direction);
+        const float dotSquared = dot * dot;
+        if (isNarrow) {
+            return dot >= 0.0f && dotSquared >= cosSquared * distanceSquared;
+        }
+        return dot >= 0.0f || dotSquared <= cosSquared * distanceSquared;
+        }, outResults);
+}
+
+size_t SpatialQuery::FindNearestInFrustum(const Vector3 &center, float radius, const Matrix4x4 &viewProjection,
+    std::span<Result> outResults) const {
+    const auto &m = viewProjection.m;
+    return Find(center, radius, [&](const Vector3 &position, const Vector3 &, float) {
+        const float clipX = position.x * m[0][0] + position.y * m[1][0] + position.z * m[2][0] + m[3][0];
+        const float clipY = position.x * m[0][1] + position.y * m[1][1] + position.z * m[2][1] + m[3][1];
+        const float clipZ = position.x * m[0][2] + position.y * m[1][2] + position.z * m[2][2] + m[3][2];
+        const float clipW = position.x * m[0][3] + position.y * m[1][3] + position.z * m[2][3] + m[3][3];
+        return -clipW <= clipX && clipX <= clipW &&
+            -clipW <= clipY && clipY <= clipW &&
+            0.0f <= clipZ && clipZ <= clipW;
+        }, outResults);
+}
+
+size_t SpatialQuery::SelectNearest(std::span<Result> candidates, size_t count) {
+    count = std::min(count, candidates.size());
+    if (count < candidates.size()) {
+        std::nth_element(candidates.begin(), candidates.begin() + count, candidates.end(), IsNearer);
+    }
+    std::sort(candidates.begin(), candidates.begin() + count, IsNearer);
+    return count;
+}
+
+template <class Filter>
+size_t SpatialQuery::Find(const Vector3 &center, float radius, const Filter &filter, std::span<Result> outResults) const {
+    const size_t maxCount = outResults.size();
+    if (maxCount == 0 || indices_.empty() || !(radius >= 0.0f)) {
+        return 0;
+    }
+
+    // 見つかったものはoutResultsの先頭に最も遠いものが根の最大ヒープとして持つ
+    float worstDistanceSquared = radius * radius;
+    size_t count = 0;
+    const float *x = x_.data();
+    const float *y = y_.data();
+    const float *z = z_.data();
+    const auto findInRange = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t blockBegin = begin; blockBegin < end; blockBegin += kBlockSize) {
+            const uint32_t blockSize = std::min(kBlockSize, end - blockBegin);
+            // 距離の2乗はまとめて求める(分岐が無いのでベクトル化される)
+            float distances[kBlockSize];
+            for (uint32_t i = 0; i < blockSize; ++i) {
+                const float dx = x[blockBegin + i] - center.x;
+                const float dy = y[blockBegin + i] - center.y;
+                const float dz = z[blockBegin + i] - center.z;
+                distances[i] = dx * dx + dy * dy + dz * dz;
+            }
+            for (uint32_t i = 0; i < blockSize; ++i) {
+                const float distanceSquared = distances[i];
+                // NaNの点もここで除く
+                if (!(distanceSquared <= worstDistanceSquared)) {
+                    continue;
+                }
+                const uint32_t point = blockBegin + i;
+                const Result result{ indices_[point], distanceSquared };
+                if (count == maxCount && !IsNearer(result, outResults[0])) {
+                    continue;
+                }
+                const Vector3 position(x[point], y[point], z[point]);
+                if (!filter(position, position - center, distanceSquared)) {
+                    continue;
+                }
+                if (count == maxCount) {
+                    std::pop_heap(outResults.begin(), outResults.begin() + count, IsNearer);
+                    outResults[count - 1] = result;
+                } else {
+                    outResults[count++] = result;
+                }
+                std::push_heap(outResults.begin(), outResults.begin() + count, IsNearer);
+                if (count == maxCount) {
+                    worstDistanceSquared = outResults[0].distanceSquared;
+                }
+            }
+        }
+        };
+
+    if (cellStarts_.size() == 2) {
+        // セルが1つなら全ての点を調べる
+        findInRange(0, static_cast<uint32_t>(indices_.size()));
+    } else {
+        const float centerArray[3] = { center.x, center.y, center.z };
+        int32_t cellMin[3];
+        int32_t cellMax[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            cellMin[axis] = ToCell(centerArray[axis] - radius, origin_[axis], inverseCellSize_, cellCounts_[axis]);
+            cellMax[axis] = ToCell(centerArray[axis] + radius, origin_[axis], inverseCellSize_, cellCounts_[axis]);
+        }
+
+        // セルの境界上の点を丸め誤差で飛ばさないよう、セルを少し広げて距離を測る
+        const float margin = cellSize_ * 1.0e-3f;
+        const float size = cellSize_ + margin * 2.0f;
+        for (int32_t cellZ = cellMin[2]; cellZ <= cellMax[2]; ++cellZ) {
+            const float minZ = origin_[2] + static_cast<float>(cellZ) * cellSize_ - margin;
+            const float distanceZ = GetDistanceToRange(center.z, minZ, minZ + size);
+            for (int32_t cellY = cellMin[1]; cellY <= cellMax[1]; ++cellY) {
+                const float minY = origin_[1] + static_cast<float>(cellY) * cellSize_ - margin;
+                const float distanceY = GetDistanceToRange(center.y, minY, minY + size);
+                const float distanceYZSquared = distanceY * distanceY + distanceZ * distanceZ;
+                if (distanceYZSquared > worstDistanceSquared) {
+                    continue;
+                }
+                const size_t row = static_cast<size_t>(cellZ * cellCounts_[1] + cellY) * cellCounts_[0];
+                for (int32_t cellX = cellMin[0]; cellX <= cellMax[0]; ++cellX) {
+                    // 見つかったものより遠いセルは飛ばす
+                    const float minX = origin_[0] + static_cast<float>(cellX) * cellSize_ - margin;
+                    const float distanceX = GetDistanceToRange(center.x, minX, minX + size);
+                    if (distanceX * distanceX + distanceYZSquared > worstDistanceSquared) {
+                        continue;
+                    }
+                    findInRange(cellStarts_[row + cellX], cellStarts_[row + cellX + 1]);
+                }
+            }
+        }
+    }
+
+    std::sort_heap(outResults.begin(), outResults.begin() + count, IsNearer);
+    return count;
+}
+
+} // namespace Math
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "Vector3.h"
+#include "Matrix4x4.h"
+
+namespace KashipanEngine {
+
+/*
+点(敵などの位置)の集合に対する近傍探索。毎フレームBuildで位置を入れ直してから、次の探索を何度でも行える。
+  FindNearest          : 半径の中で近い順にk個
+  FindNearestInCone    : 半径の中で、さらに円錐(向きと半角)の中にあるものを近い順にk個
+  FindNearestInFrustum : 半径の中で、さらにビュープロジェクション行列の視錐台の中にあるものを近い順にk個
+  SelectNearest        : 候補の配列の先頭k個を近い順にする(全体を並べ替えない、nth_element)
+点は一様グリッドのセルの順に並べ替えて持ち、探索では半径の球と重なるセルだけを、見つかったk個より遠いセルを飛ばしながら調べる。
+1回のBuildに対して探索が数回しかない場合(毎フレーム1回探すロックオンなど)はグリッドを作る方が高く付くので、
+cellSizeにkNoGridを渡して、並べ替えずに全ての点を調べる。誘導弾のように1回のBuildで何度も探す場合はグリッドを作る。
+結果は呼び出し側が用意したk個の配列に書き込む(k個の最大ヒープで選ぶ)ので、探索中にメモリを確保しない。
+Buildも内部のバッファを使い回すので、点の数が増えない限りメモリを確保しない。
+距離が同じ場合は番号の小さい方を近いとみなすので、結果は点の並びだけで決まる。
+*/
+
+namespace Math {
+
+/// @brief 点の集合の近傍探索
+class SpatialQuery {
+public:
+    /// @brief 探索結果
+    struct Result {
+        // Buildに渡した配列での添字
+        uint32_t index;
+        // 探索の中心からの距離の2乗
+        float distanceSquared;
+    };
+
+    /// @brief グリッドを作らずに全ての点を調べる場合のセルの大きさ
+    static constexpr float kNoGrid = std::numeric_limits<float>::infinity();
+
+    /// @brief 点の集合を設定する
+    /// @param x 点のx座標
+    /// @param y 点のy座標
+    /// @param z 点のz座標
+    /// @param cellSize グリッドのセルの一辺の長さ(0以下なら点の数と範囲から決める。kNoGridならグリッドを作らない)
+    void Build(std::span<const float> x, std::span<const float> y, std::span<const float> z, float cellSize = 0.0f);
+
+    /// @brief 半径の中で近い順にoutResults.size()個まで探す
+    /// @param center 探索の中心
+    /// @param radius 探索の半径
+    /// @param outResults 結果の出力先(近い順)
+    /// @return 見つかった数
+    size_t FindNearest(const Vector3 &center, float radius, std::span<Result> outResults) const;
+
+    /// @brief 半径の中かつ円錐の中で近い順にoutResults.size()個まで探す
+    /// @param center 探索の中心(円錐の頂点)
+    /// @param radius 探索の半径
+    /// @param direction 円錐の向き(単位ベクトル)
+    /// @param cosHalfAngle 円錐の半角のcos
+    /// @param outResults 結果の出力先(近い順)
+    /// @return 見つかった数
+    size_t FindNearestInCone(const Vector3 &center, float radius, const Vector3 &direction, float cosHalfAngle,
+        std::span<Result> outResults) const;
+
+    /// @brief 半径の中かつ視錐台の中で近い順にoutResults.size()個まで探す
+    /// @param center 探索の中心
+    /// @param radius 探索の半径
+    /// @param viewProjection ビュープロジェクション行列(クリップ座標で-w≦x,y≦w、0≦z≦wを視錐台の中とする)
+    /// @param outResults 結果の出力先(近い順)
+    /// @return 見つかった数
+    size_t FindNearestInFrustum(const Vector3 &center, float radius, const Matrix4x4 &viewProjection,
+        std::span<Result> outResults) const;
+
+    /// @brief 候補の先頭count個を近い順にする(残りの順番は不定)
+    /// @param candidates 候補
+    /// @param count 選ぶ数
+    /// @return 選んだ数
+    static size_t SelectNearest(std::span<Result> candidates, size_t count);
+
+    /// @brief 点の数を取得
+    size_t GetPointCount() const noexcept {
+        return indices_.size();
+    }
+
+private:
+    /// @brief 半径の中で、条件を満たすものを近い順に探す
+    template <class Filter>
+    size_t Find(const Vector3 &center, float radius, const Filter &filter, std::span<Result> outResults) const;
+
+    // グリッドの原点とセルの一辺の長さの逆数、各軸のセルの数
+    float origin_[3] = {};
+    float cellSize_ = 1.0f;
+    float inverseCellSize_ = 1.0f;
+    int32_t cellCounts_[3] = {};
+    // セルごとの点の範囲(cellStarts_[cell]～cellStarts_[cell + 1])
+    std::vector<uint32_t> cellStarts_;
+    // セルの順に並べた点の座標と、元の添字
+    std::vector<float> x_;
+    std::vector<float> y_;
+    std::vector<float> z_;
+    std::vector<uint32_t> indices_;
+    // 構築中だけ使う各点のセル
+    std::vector<uint32_t> pointCells_;
+};
+
+} // namespace Math
+
+} // namespace KashipanEngine
\ No newline at end of file
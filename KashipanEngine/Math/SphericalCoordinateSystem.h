@@ -1,5 +1,6 @@
 #pragma once
 #include "Vector3.h"
+#include "FastMath.h"
 #include <numbers>
 #include <algorithm>
 
@@ -18,8 +19,8 @@ public:
     void ToSpherical(const Vector3& vector) {
         radius = vector.Length();
         if (radius > 0.0f) {
-            theta = atan2(vector.z, vector.x);
-            phi = acos(vector.y / radius);
+            theta = Math::Gameplay::Atan2(vector.z, vector.x);
+            phi = Math::Gameplay::Acos(vector.y / radius);
         } else {
             theta = 0.0f;
             phi = 0.0f;
@@ -29,10 +30,13 @@ public:
     /// @brief 球面座標系を3次元ベクトルに変換
     /// @return 変換後の3次元ベクトル
     Vector3 ToVector3() const {
+        float sinPhi, cosPhi, sinTheta, cosTheta;
+        Math::Gameplay::SinCos(phi, sinPhi, cosPhi);
+        Math::Gameplay::SinCos(theta, sinTheta, cosTheta);
         return origin + Vector3(
-            radius * sin(phi) * cos(theta),
-            radius * cos(phi),
-            radius * sin(phi) * sin(theta)
+            radius * sinPhi * cosTheta,
+            radius * cosPhi,
+            radius * sinPhi * sinTheta
         );
     }
 
@@ -40,7 +44,7 @@ public:
     /// @return 3次元の回転ベクトル
     Vector3 ToRotatedVector3() const {
         Vector3 forward = (origin - ToVector3()).Normalize();
-        float yaw = atan2(forward.x, forward.z);
+        float yaw = Math::Gameplay::Atan2(forward.x, forward.z);
         float pitch = asinf(-forward.y /*std::clamp(-forward.y, -1.0f, 1.0f)*/);
         float roll = 0.0f;
         return Vector3(
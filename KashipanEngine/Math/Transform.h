@@ -1,5 +1,6 @@
 #pragma once
 #include "Vector3.h"
+#include "Quaternion.h"
 
 namespace KashipanEngine {
 
@@ -7,6 +8,9 @@ struct Transform {
     Vector3 scale = { 1.0f, 1.0f, 1.0f };
     Vector3 rotate = { 0.0f, 0.0f, 0.0f };
     Vector3 translate = { 0.0f, 0.0f, 0.0f };
+    // isUseQuaternionがtrueのときはrotateの代わりに使う回転
+    Quaternion rotateQuaternion = Quaternion::Identity();
+    bool isUseQuaternion = false;
 };
 
 }
\ No newline at end of file
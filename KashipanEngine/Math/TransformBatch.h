@@ -0,0 +1,111 @@
+#pragma once
+#include <cassert>
+#include <span>
+#include "Vector3.h"
+#include "Matrix4x4.h"
+#include "MatrixSimd.h"
+
+namespace KashipanEngine {
+
+/*
+Vector3の配列をまとめて変換する。1点ずつVector3::Transformを呼ぶより速い。
+積と和をFMAにまとめないビルドでは、結果はVector3::Transform(TransformDirection)と一致する。
+FMAが有効なビルド(-mfmaや-march=nativeなど)ではコンパイラが積和をまとめる場所が1点ずつの変換と違うことがあり、
+各成分は最大で8ε * Σ|積和の各項|(位置はさらにwで割った分)ずれる(Tests/TransformBatchTests.cppで確かめている)。
+  TransformPoints          : 位置を変換してwで割る(Vector3::Transformと同じ)
+  TransformPointsAffine    : 位置を変換する。4列目が(0, 0, 0, 1)の行列用で、wで割らない
+  TransformDirections      : 方向を変換する。平行移動は無視される
+x, y, zを別々の配列で持つ場合(SoA)は末尾にSoAが付いた版を使う。
+入力と出力は同じ配列でも良い。
+*/
+
+namespace Math {
+
+static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 must be tightly packed to be treated as float[3].");
+
+namespace Internal {
+
+template <bool kIsPoint, bool kIsProjective>
+inline void TransformBatch(std::span<const Vector3> in, const Matrix4x4 &matrix, std::span<Vector3> out) noexcept {
+    assert(out.size() >= in.size());
+    MatrixSimd::TransformArray<kIsPoint, kIsProjective>(&matrix.m[0][0],
+        reinterpret_cast<const float *>(in.data()), reinterpret_cast<float *>(out.data()), in.size());
+}
+
+template <bool kIsPoint, bool kIsProjective>
+inline void TransformBatchSoA(std::span<const float> inX, std::span<const float> inY, std::span<const float> inZ,
+    const Matrix4x4 &matrix, std::span<float> outX, std::span<float> outY, std::span<float> outZ) noexcept {
+    assert(inY.size() >= inX.size() && inZ.size() >= inX.size());
+    assert(outX.size() >= inX.size() && outY.size() >= inX.size() && outZ.size() >= inX.size());
+    MatrixSimd::TransformArraySoA<kIsPoint, kIsProjective>(&matrix.m[0][0],
+        inX.data(), inY.data(), inZ.data(), outX.data(), outY.data(), outZ.data(), inX.size());
+}
+
+} // namespace Internal
+
+/// @brief 位置をまとめて変換し、wで割る
+/// @param points 変換する位置
+/// @param matrix 変換行列
+/// @param out 出力先(pointsと同じ要素数以上)
+inline void TransformPoints(std::span<const Vector3> points, const Matrix4x4 &matrix, std::span<Vector3> out) noexcept {
+    Internal::TransformBatch<true, true>(points, matrix, out);
+}
+
+/// @brief 位置をまとめて変換する(4列目が(0, 0, 0, 1)の行列用で、wで割らない)
+/// @param points 変換する位置
+/// @param matrix 変換行列
+/// @param out 出力先(pointsと同じ要素数以上)
+inline void TransformPointsAffine(std::span<const Vector3> points, const Matrix4x4 &matrix, std::span<Vector3> out) noexcept {
+    Internal::TransformBatch<true, false>(points, matrix, out);
+}
+
+/// @brief 方向をまとめて変換する(平行移動は無視される)
+/// @param directions 変換する方向
+/// @param matrix 変換行列
+/// @param out 出力先(directionsと同じ要素数以上)
+inline void TransformDirections(std::span<const Vector3> directions, const Matrix4x4 &matrix, std::span<Vector3> out) noexcept {
+    Internal::TransformBatch<false, false>(directions, matrix, out);
+}
+
+/// @brief SoAの位置をまとめて変換し、wで割る
+/// @param inX 変換する位置のX
+/// @param inY 変換する位置のY
+/// @param inZ 変換する位置のZ
+/// @param matrix 変換行列
+/// @param outX 出力先のX
+/// @param outY 出力先のY
+/// @param outZ 出力先のZ
+inline void TransformPointsSoA(std::span<const float> inX, std::span<const float> inY, std::span<const float> inZ,
+    const Matrix4x4 &matrix, std::span<float> outX, std::span<float> outY, std::span<float> outZ) noexcept {
+    Internal::TransformBatchSoA<true, true>(inX, inY, inZ, matrix, outX, outY, outZ);
+}
+
+/// @brief SoAの位置をまとめて変換する(4列目が(0, 0, 0, 1)の行列用で、wで割らない)
+/// @param inX 変換する位置のX
+/// @param inY 変換する位置のY
+/// @param inZ 変換する位置のZ
+/// @param matrix 変換行列
+/// @param outX 出力先のX
+/// @param outY 出力先のY
+/// @param outZ 出力先のZ
+inline void TransformPointsAffineSoA(std::span<const float> inX, std::span<const float> inY, std::span<const float> inZ,
+    const Matrix4x4 &matrix, std::span<float> outX, std::span<float> outY, std::span<float> outZ) noexcept {
+    Internal::TransformBatchSoA<true, false>(inX, inY, inZ, matrix, outX, outY, outZ);
+}
+
+/// @brief SoAの方向をまとめて変換する(平行移動は無視される)
+/// @param inX 変換する方向のX
+/// @param inY 変換する方向のY
+/// @param inZ 変換する方向のZ
+/// @param matrix 変換行列
+/// @param outX 出力先のX
+/// @param outY 出力先のY
+/// @param outZ 出力先のZ
+inline void TransformDirectionsSoA(std::span<const float> inX, std::span<const float> inY, std::span<const float> inZ,
+    const Matrix4x4 &matrix, std::span<float> outX, std::span<float> outY, std::span<float> outZ) noexcept {
+    Internal::TransformBatchSoA<false, false>(inX, inY, inZ, matrix, outX, outY, outZ);
+}
+
+} // namespace Math
+
+} // namespace KashipanEngine
\ No newline at end of file
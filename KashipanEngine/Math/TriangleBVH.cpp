@@ -0,0 +1,526 @@
+#include "TriangleBVH.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include "Common/VertexData.h"
+#include "Math/MathObjects/Lines.h"
+#include "Math/MathObjects/Sphere.h"
+
+namespace KashipanEngine {
+
+namespace Math {
+
+namespace {
+
+// SAHで分割位置を探すときの区間の数
+constexpr uint32_t kBinCount = 16;
+// これより多い三角形は、分割した方が高く付いても葉にしない
+constexpr uint32_t kMaxLeafTriangles = 4;
+// 探索中に保留する節点の数の上限(木の深さの上限)
+constexpr uint32_t kMaxDepth = 64;
+// 節点を1つ辿る手間(三角形1つの判定の手間に対する比)
+constexpr float kTraversalCost = 1.0f;
+
+/// @brief 構築中に使う境界ボックス
+struct Bounds {
+    Vector3 min = Vector3(std::numeric_limits<float>::max());
+    Vector3 max = Vector3(-std::numeric_limits<float>::max());
+
+    void Grow(const Vector3 &point) noexcept {
+        min = Vector3(std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z));
+        max = Vector3(std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z));
+    }
+    void Grow(const Bounds &bounds) noexcept {
+        Grow(bounds.min);
+        Grow(bounds.max);
+    }
+    /// @brief 表面積の半分(空なら0)
+    float GetHalfArea() const noexcept {
+        if (min.x > max.x) {
+            return 0.0f;
+        }
+        const Vector3 size = max - min;
+        return size.x * size.y + size.y * size.z + size.z * size.x;
+    }
+};
+
+/// @brief 三角形の境界ボックス
+Bounds GetBounds(const Triangle &triangle) noexcept {
+    Bounds bounds;
+    bounds.Grow(triangle.vertices[0]);
+    bounds.Grow(triangle.vertices[1]);
+    bounds.Grow(triangle.vertices[2]);
+    return bounds;
+}
+
+/// @brief ベクトルの成分を添字で取得
+float GetAxis(const Vector3 &vector, int axis) noexcept {
+    return axis == 0 ? vector.x : (axis == 1 ? vector.y : vector.z);
+}
+
+/// @brief 半直線と境界ボックスの判定(スラブ法)
+/// @param outTime 入る時刻
+/// @return 0～maxTimeの間にボックスを通るか
+bool IntersectBounds(const float (&min)[3], const float (&max)[3],
+    const float (&origin)[3], const float (&inverseDiff)[3], float maxTime, float &outTime) noexcept {
+    float tEnter = 0.0f;
+    float tExit = maxTime;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float t0 = (min[axis] - origin[axis]) * inverseDiff[axis];
+        const float t1 = (max[axis] - origin[axis]) * inverseDiff[axis];
+        // 軸に平行な半直線が面の上にあるとNaNになるが、std::max/std::minの第2引数なら無視される
+        tEnter = std::max(tEnter, std::min(t0, t1));
+        tExit = std::min(tExit, std::max(t0, t1));
+    }
+    outTime = tEnter;
+    return tEnter <= tExit;
+}
+
+/// @brief 半直線と三角形の判定(Möller–Trumbore、両面)
+bool IntersectTriangle(const Triangle &triangle, const Vector3 &origin, const Vector3 &diff, float maxTime,
+    float &outTime, float &outU, float &outV) noexcept {
+    const Vector3 edge1 = triangle.vertices[1] - triangle.vertices[0];
+    const Vector3 edge2 = triangle.vertices[2] - triangle.vertices[0];
+    const Vector3 p = diff.Cross(edge2);
+    const float determinant = edge1.Dot(p);
+    // 三角形と平行
+    if (determinant == 0.0f) {
+        return false;
+    }
+    const float inverseDeterminant = 1.0f / determinant;
+    const Vector3 s = origin - triangle.vertices[0];
+    const float u = s.Dot(p) * inverseDeterminant;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+    const Vector3 q = s.Cross(edge1);
+    const float v = diff.Dot(q) * inverseDeterminant;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+    const float t = edge2.Dot(q) * inverseDeterminant;
+    if (t < 0.0f || t > maxTime) {
+        return false;
+    }
+    outTime = t;
+    outU = u;
+    outV = v;
+    return true;
+}
+
+/// @brief 三角形上の点で、pointに最も近いものを求める
+Vector3 GetClosestPoint(const Triangle &triangle, const Vector3 &point) noexcept {
+    const Vector3 &a = triangle.vertices[0];
+    const Vector3 &b = triangle.vertices[1];
+    const Vector3 &c = triangle.vertices[2];
+    const Vector3 ab = b - a;
+    const Vector3 ac = c - a;
+
+    // 頂点a, b, cの外側の領域
+    const Vector3 ap = point - a;
+    const float d1 = ab.Dot(ap);
+    const float d2 = ac.Dot(ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        return a;
+    }
+    const Vector3 bp = point - b;
+    const float d3 = ab.Dot(bp);
+    const float d4 = ac.Dot(bp);
+    if (d3 >= 0.0f && d4 <= d3) {
+        return b;
+    }
+    const Vector3 cp = point - c;
+    const float d5 = ab.Dot(cp);
+    const float d6 = ac.Dot(cp);
+    if (d6 >= 0.0f && d5 <= d6) {
+        return c;
+    }
+
+    // 辺ab, ac, bcの外側の領域
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return a + ab * (d1 / (d1 - d3));
+    }
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return a + ac * (d2 / (d2 - d6));
+    }
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    // 面の内側
+    const float denominator = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+/// @brief 球と境界ボックスの判定
+bool IsOverlap(const float (&min)[3], const float (&max)[3], const Sphere &sphere) noexcept {
+    const float center[3] = { sphere.center.x, sphere.center.y, sphere.center.z };
+    float distanceSquared = 0.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float d = center[axis] - std::clamp(center[axis], min[axis], max[axis]);
+        distanceSquared += d * d;
+    }
+    return distanceSquared <= sphere.radius * sphere.radius;
+}
+
+/// @brief 頂点データから位置だけを取り出す
+std::vector<Vector3> GetPositions(std::span<const VertexData> vertices) {
+    std::vector<Vector3> positions(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        positions[i] = Vector3(vertices[i].position);
+    }
+    return positions;
+}
+
+} // namespace
+
+void TriangleBVH::Build(std::span<const Vector3> positions, std::span<const uint32_t> indices) {
+    assert(indices.size() % 3 == 0);
+    const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    indices_.assign(indices.begin(), indices.end());
+    triangleIndices_.resize(triangleCount);
+    std::iota(triangleIndices_.begin(), triangleIndices_.end(), 0u);
+
+    // 構築中は元の順番のまま三角形を持ち、triangleIndices_を並べ替える
+    triangles_.resize(triangleCount);
+    centroids_.resize(triangleCount);
+    for (uint32_t i = 0; i < triangleCount; ++i) {
+        triangles_[i] = Triangle(positions[indices[i * 3 + 0]], positions[indices[i * 3 + 1]], positions[indices[i * 3 + 2]]);
+        centroids_[i] = (triangles_[i].vertices[0] + triangles_[i].vertices[1] + triangles_[i].vertices[2]) * (1.0f / 3.0f);
+    }
+
+    nodes_.clear();
+    if (triangleCount > 0) {
+        nodes_.reserve(static_cast<size_t>(triangleCount) * 2 - 1);
+        BuildNode(0, triangleCount, 1);
+    }
+    nodes_.shrink_to_fit();
+    centroids_.clear();
+    centroids_.shrink_to_fit();
+
+    // 葉の順に並べ直す
+    UpdateTriangles(positions);
+}
+
+void TriangleBVH::Build(std::span<const VertexData> vertices, std::span<const uint32_t> indices) {
+    Build(GetPositions(vertices), indices);
+}
+
+void TriangleBVH::Refit(std::span<const Vector3> positions) {
+    UpdateTriangles(positions);
+    // 子は親より後ろにあるので、後ろから求めれば子は求め終わっている
+    for (size_t i = nodes_.size(); i > 0; --i) {
+        UpdateNodeBounds(nodes_[i - 1], static_cast<uint32_t>(i - 1));
+    }
+}
+
+void TriangleBVH::Refit(std::span<const VertexData> vertices) {
+    Refit(GetPositions(vertices));
+}
+
+bool TriangleBVH::Raycast(const Ray &ray, RaycastHit &outHit) const {
+    return Intersect(ray.origin, ray.diff, std::numeric_limits<float>::infinity(), false, &outHit);
+}
+
+bool TriangleBVH::Raycast(const Segment &segment, RaycastHit &outHit) const {
+    return Intersect(segment.origin, segment.diff, 1.0f, false, &outHit);
+}
+
+bool TriangleBVH::IsCollision(const Ray &ray) const {
+    return Intersect(ray.origin, ray.diff, std::numeric_limits<float>::infinity(), true, nullptr);
+}
+
+bool TriangleBVH::IsCollision(const Segment &segment) const {
+    return Intersect(segment.origin, segment.diff, 1.0f, true, nullptr);
+}
+
+bool TriangleBVH::IsCollision(const Sphere &sphere) const {
+    if (nodes_.empty()) {
+        return false;
+    }
+    const float radiusSquared = sphere.radius * sphere.radius;
+    uint32_t stack[kMaxDepth];
+    uint32_t stackSize = 0;
+    uint32_t nodeIndex = 0;
+    while (true) {
+        const Node &node = nodes_[nodeIndex];
+        if (IsOverlap(node.min, node.max, sphere)) {
+            if (node.count == 0) {
+                stack[stackSize++] = node.firstOrRight;
+                nodeIndex = nodeIndex + 1;
+                continue;
+            }
+            for (uint32_t i = node.firstOrRight; i < node.firstOrRight + node.count; ++i) {
+                if ((GetClosestPoint(triangles_[i], sphere.center) - sphere.center).LengthSquared() <= radiusSquared) {
+                    return true;
+                }
+            }
+        }
+        if (stackSize == 0) {
+            return false;
+        }
+        nodeIndex = stack[--stackSize];
+    }
+}
+
+size_t TriangleBVH::GetOverlappingTriangles(const Sphere &sphere, std::vector<uint32_t> &outTriangles) const {
+    if (nodes_.empty()) {
+        return 0;
+    }
+    const size_t startSize = outTriangles.size();
+    const float radiusSquared = sphere.radius * sphere.radius;
+    uint32_t stack[kMaxDepth];
+    uint32_t stackSize = 0;
+    uint32_t nodeIndex = 0;
+    while (true) {
+        const Node &node = nodes_[nodeIndex];
+        if (IsOverlap(node.min, node.max, sphere)) {
+            if (node.count == 0) {
+                stack[stackSize++] = node.firstOrRight;
+                nodeIndex = nodeIndex + 1;
+                continue;
+            }
+            for (uint32_t i = node.firstOrRight; i < node.firstOrRight + node.count; ++i) {
+                if ((GetClosestPoint(triangles_[i], sphere.center) - sphere.center).LengthSquared() <= radiusSquared) {
+                    outTriangles.push_back(triangleIndices_[i]);
+                }
+            }
+        }
+        if (stackSize == 0) {
+            return outTriangles.size() - startSize;
+        }
+        nodeIndex = stack[--stackSize];
+    }
+}
+
+bool TriangleBVH::Intersect(const Vector3 &origin, const Vector3 &diff, float maxTime, bool isAnyHit, RaycastHit *outHit) const {
+    if (nodes_.empty()) {
+        return false;
+    }
+    const float originArray[3] = { origin.x, origin.y, origin.z };
+    const float inverseDiff[3] = { 1.0f / diff.x, 1.0f / diff.y, 1.0f / diff.z };
+    float closestTime = maxTime;
+    uint32_t hitTriangle = 0;
+    float hitU = 0.0f;
+    float hitV = 0.0f;
+    bool isHit = false;
+
+    // 保留した節点と、その節点に入る時刻
+    struct StackEntry {
+        uint32_t node;
+        float time;
+    };
+    StackEntry stack[kMaxDepth];
+    uint32_t stackSize = 0;
+    float rootTime;
+    if (!IntersectBounds(nodes_[0].min, nodes_[0].max, originArray, inverseDiff, closestTime, rootTime)) {
+        return false;
+    }
+    uint32_t nodeIndex = 0;
+    while (true) {
+        const Node &node = nodes_[nodeIndex];
+        if (node.count > 0) {
+            for (uint32_t i = node.firstOrRight; i < node.firstOrRight + node.count; ++i) {
+                float t, u, v;
+                if (!IntersectTriangle(triangles_[i], origin, diff, closestTime, t, u, v)) {
+                    continue;
+                }
+                if (isAnyHit) {
+                    return true;
+                }
+                closestTime = t;
+                hitTriangle = i;
+                hitU = u;
+                hitV = v;
+                isHit = true;
+            }
+        } else {
+            // 近い方の子から辿り、遠い方は保留する
+            const uint32_t left = nodeIndex + 1;
+            const uint32_t right = node.firstOrRight;
+            float leftTime;
+            float rightTime;
+            const bool isLeftHit = IntersectBounds(nodes_[left].min, nodes_[left].max, originArray, inverseDiff, closestTime, leftTime);
+            const bool isRightHit = IntersectBounds(nodes_[right].min, nodes_[right].max, originArray, inverseDiff, closestTime, rightTime);
+            if (isLeftHit && isRightHit) {
+                const bool isLeftNear = leftTime <= rightTime;
+                stack[stackSize++] = isLeftNear ? StackEntry{ right, rightTime } : StackEntry{ left, leftTime };
+                nodeIndex = isLeftNear ? left : right;
+                continue;
+            }
+            if (isLeftHit || isRightHit) {
+                nodeIndex = isLeftHit ? left : right;
+                continue;
+            }
+        }
+
+        // 保留した節点のうち、今までに見つかった交点より手前にあるもの
+        bool isFound = false;
+        while (stackSize > 0) {
+            const StackEntry &entry = stack[--stackSize];
+            if (entry.time <= closestTime) {
+                nodeIndex = entry.node;
+                isFound = true;
+                break;
+            }
+        }
+        if (!isFound) {
+            break;
+        }
+    }
+
+    if (!isHit) {
+        return false;
+    }
+    const Triangle &triangle = triangles_[hitTriangle];
+    Vector3 normal = (triangle.vertices[1] - triangle.vertices[0]).Cross(triangle.vertices[2] - triangle.vertices[0]).Normalize();
+    if (normal.Dot(diff) > 0.0f) {
+        normal = -normal;
+    }
+    outHit->time = closestTime;
+    outHit->triangle = triangleIndices_[hitTriangle];
+    outHit->u = hitU;
+    outHit->v = hitV;
+    outHit->normal = normal;
+    return true;
+}
+
+void TriangleBVH::BuildNode(uint32_t begin, uint32_t end, uint32_t depth) {
+    const uint32_t nodeIndex = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+
+    Bounds bounds;
+    Bounds centroidBounds;
+    for (uint32_t i = begin; i < end; ++i) {
+        bounds.Grow(GetBounds(triangles_[triangleIndices_[i]]));
+        centroidBounds.Grow(centroids_[triangleIndices_[i]]);
+    }
+    Node &node = nodes_[nodeIndex];
+    node.min[0] = bounds.min.x;
+    node.min[1] = bounds.min.y;
+    node.min[2] = bounds.min.z;
+    node.max[0] = bounds.max.x;
+    node.max[1] = bounds.max.y;
+    node.max[2] = bounds.max.z;
+    node.firstOrRight = begin;
+    node.count = end - begin;
+
+    const uint32_t count = end - begin;
+    if (count <= 1 || depth >= kMaxDepth) {
+        return;
+    }
+
+    // 各軸の重心の範囲を区間に分け、区間の境界で分けたときのSAHのコストが一番小さいものを探す
+    int bestAxis = -1;
+    uint32_t bestSplit = 0;
+    float bestCost = std::numeric_limits<float>::max();
+    for (int axis = 0; axis < 3; ++axis) {
+        const float axisMin = GetAxis(centroidBounds.min, axis);
+        const float extent = GetAxis(centroidBounds.max, axis) - axisMin;
+        if (extent <= 0.0f) {
+            continue;
+        }
+        const float scale = kBinCount / extent;
+        Bounds binBounds[kBinCount];
+        uint32_t binCounts[kBinCount] = {};
+        for (uint32_t i = begin; i < end; ++i) {
+            const uint32_t triangle = triangleIndices_[i];
+            const uint32_t bin = std::min(kBinCount - 1, static_cast<uint32_t>((GetAxis(centroids_[triangle], axis) - axisMin) * scale));
+            binBounds[bin].Grow(GetBounds(triangles_[triangle]));
+            ++binCounts[bin];
+        }
+
+        // 右から累積した面積と数
+        float rightAreas[kBinCount];
+        uint32_t rightCounts[kBinCount];
+        Bounds rightBounds;
+        uint32_t rightCount = 0;
+        for (uint32_t bin = kBinCount - 1; bin > 0; --bin) {
+            rightBounds.Grow(binBounds[bin]);
+            rightCount += binCounts[bin];
+            rightAreas[bin] = rightBounds.GetHalfArea();
+            rightCounts[bin] = rightCount;
+        }
+        Bounds leftBounds;
+        uint32_t leftCount = 0;
+        for (uint32_t split = 1; split < kBinCount; ++split) {
+            leftBounds.Grow(binBounds[split - 1]);
+            leftCount += binCounts[split - 1];
+            if (leftCount == 0 || rightCounts[split] == 0) {
+                continue;
+            }
+            const float cost = leftBounds.GetHalfArea() * leftCount + rightAreas[split] * rightCounts[split];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = split;
+            }
+        }
+    }
+
+    // 分けない場合のコスト(三角形の数)と比べる
+    const float area = bounds.GetHalfArea();
+    const float splitCost = area > 0.0f ? kTraversalCost + bestCost / area : 0.0f;
+    if (bestAxis < 0 ? count <= kMaxLeafTriangles : (splitCost >= static_cast<float>(count) && count <= kMaxLeafTriangles)) {
+        return;
+    }
+
+    uint32_t middle = begin + count / 2;
+    if (bestAxis >= 0) {
+        const float axisMin = GetAxis(centroidBounds.min, bestAxis);
+        const float scale = kBinCount / (GetAxis(centroidBounds.max, bestAxis) - axisMin);
+        const auto it = std::partition(triangleIndices_.begin() + begin, triangleIndices_.begin() + end, [&](uint32_t triangle) {
+            const uint32_t bin = std::min(kBinCount - 1, static_cast<uint32_t>((GetAxis(centroids_[triangle], bestAxis) - axisMin) * scale));
+            return bin < bestSplit;
+            });
+        middle = static_cast<uint32_t>(it - triangleIndices_.begin());
+    }
+    // 重心が全て同じ位置にある場合は、数で半分に分ける
+    if (middle == begin || middle == end) {
+        middle = begin + count / 2;
+    }
+
+    nodes_[nodeIndex].count = 0;
+    BuildNode(begin, middle, depth + 1);
+    nodes_[nodeIndex].firstOrRight = static_cast<uint32_t>(nodes_.size());
+    BuildNode(middle, end, depth + 1);
+}
+
+void TriangleBVH::UpdateTriangles(std::span<const Vector3> positions) {
+    triangles_.resize(triangleIndices_.size());
+    for (size_t i = 0; i < triangleIndices_.size(); ++i) {
+        const uint32_t *indices = indices_.data() + static_cast<size_t>(triangleIndices_[i]) * 3;
+        triangles_[i] = Triangle(positions[indices[0]], positions[indices[1]], positions[indices[2]]);
+    }
+}
+
+void TriangleBVH::UpdateNodeBounds(Node &node, uint32_t nodeIndex) const {
+    Bounds bounds;
+    if (node.count > 0) {
+        for (uint32_t i = node.firstOrRight; i < node.firstOrRight + node.count; ++i) {
+            bounds.Grow(GetBounds(triangles_[i]));
+        }
+    } else {
+        const Node &left = nodes_[nodeIndex + 1];
+        const Node &right = nodes_[node.firstOrRight];
+        bounds.Grow(Vector3(left.min[0], left.min[1], left.min[2]));
+        bounds.Grow(Vector3(left.max[0], left.max[1], left.max[2]));
+        bounds.Grow(Vector3(right.min[0], right.min[1], right.min[2]));
+        bounds.Grow(Vector3(right.max[0], right.max[1], right.max[2]));
+    }
+    node.min[0] = bounds.min.x;
+    node.min[1] = bounds.min.y;
+    node.min[2] = bounds.min.z;
+    node.max[0] = bounds.max.x;
+    node.max[1] = bounds.max.y;
+    node.max[2] = bounds.max.z;
+}
+
+} // namespace Math
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Math/Vector3.h"
+#include "Math/MathObjects/Triangle.h"
+
+namespace KashipanEngine {
+
+/*
+三角形メッシュの境界ボリューム階層(BVH)。メッシュとの半直線・線分・球の判定を、全ての三角形を調べずに行う。
+  Build  : 頂点とインデックス(3つで1つの三角形)から、表面積ヒューリスティック(SAH)で分割して作る
+  Refit  : 頂点が動いた(形は同じ)メッシュに合わせて、木の形はそのままで境界ボックスだけを作り直す
+  Raycast: 最も近い交点を求める
+  IsCollision: 何かに当たるかどうかだけを調べる(見つかった時点で終わる)
+  GetOverlappingTriangles: 球と重なる三角形を全て求める
+節点は深さ優先の順に1つの配列に並べ、1つ32バイト(キャッシュラインに2つ)に詰めている。左の子は直後の節点なので
+右の子の添字だけを持つ。葉の三角形は葉の順に並べ直して持つので、葉の中の判定は連続したメモリを読むだけで済む。
+三角形の判定は両面。時刻は半直線・線分のdiffに対する割合で、Math::Colliderと同じ。
+*/
+
+struct VertexData;
+
+namespace Math {
+
+struct Ray;
+struct Segment;
+struct Sphere;
+
+/// @brief 三角形メッシュのBVH
+class TriangleBVH {
+public:
+    /// @brief 半直線・線分が当たった三角形の情報
+    struct RaycastHit {
+        // 当たった時刻(diffに対する割合)
+        float time;
+        // 当たった三角形の番号(インデックス配列での先頭の位置 / 3)
+        uint32_t triangle;
+        // 当たった点の重心座標(vertices[1]とvertices[2]の重み)
+        float u;
+        float v;
+        // 当たった三角形の単位法線(半直線と向かい合う向き)
+        Vector3 normal;
+    };
+
+    /// @brief BVHを作る
+    /// @param positions 頂点の位置
+    /// @param indices 三角形のインデックス(3つで1つの三角形)
+    void Build(std::span<const Vector3> positions, std::span<const uint32_t> indices);
+    /// @brief モデルの頂点データからBVHを作る
+    /// @param vertices 頂点データ
+    /// @param indices 三角形のインデックス(3つで1つの三角形)
+    void Build(std::span<const VertexData> vertices, std::span<const uint32_t> indices);
+
+    /// @brief 頂点の位置だけが変わったメッシュに合わせて境界ボックスを作り直す(インデックスはBuildと同じであること)
+    /// @param positions 頂点の位置
+    void Refit(std::span<const Vector3> positions);
+    /// @brief 頂点の位置だけが変わったメッシュに合わせて境界ボックスを作り直す(インデックスはBuildと同じであること)
+    /// @param vertices 頂点データ
+    void Refit(std::span<const VertexData> vertices);
+
+    /// @brief 半直線が最初に当たる三角形を求める
+    /// @param ray 半直線
+    /// @param outHit 当たった三角形の情報
+    /// @return 当たったかどうか
+    [[nodiscard]] bool Raycast(const Ray &ray, RaycastHit &outHit) const;
+    /// @brief 線分が最初に当たる三角形を求める
+    /// @param segment 線分
+    /// @param outHit 当たった三角形の情報
+    /// @return 当たったかどうか
+    [[nodiscard]] bool Raycast(const Segment &segment, RaycastHit &outHit) const;
+
+    /// @brief 半直線がいずれかの三角形に当たるか
+    [[nodiscard]] bool IsCollision(const Ray &ray) const;
+    /// @brief 線分がいずれかの三角形に当たるか
+    [[nodiscard]] bool IsCollision(const Segment &segment) const;
+    /// @brief 球がいずれかの三角形と重なるか
+    [[nodiscard]] bool IsCollision(const Sphere &sphere) const;
+
+    /// @brief 球と重なる三角形を全て求める
+    /// @param sphere 球
+    /// @param outTriangles 重なっている三角形の番号の追加先(順番は木の中の順)
+    /// @return 追加した数
+    size_t GetOverlappingTriangles(const Sphere &sphere, std::vector<uint32_t> &outTriangles) const;
+
+    /// @brief 三角形の数を取得
+    size_t GetTriangleCount() const noexcept {
+        return triangles_.size();
+    }
+    /// @brief 節点の数を取得
+    size_t GetNodeCount() const noexcept {
+        return nodes_.size();
+    }
+
+private:
+    /// @brief 節点(32バイト)
+    struct Node {
+        float min[3];
+        // 葉なら先頭の三角形(葉の順)、それ以外なら右の子の添字(左の子は直後の節点)
+        uint32_t firstOrRight;
+        float max[3];
+        // 葉の三角形の数(0なら葉ではない)
+        uint32_t count;
+    };
+    static_assert(sizeof(Node) == 32);
+
+    /// @brief 半直線・線分の判定
+    bool Intersect(const Vector3 &origin, const Vector3 &diff, float maxTime, bool isAnyHit, RaycastHit *outHit) const;
+    /// @brief [begin, end)の三角形の節点を作り、分割して子を作る
+    void BuildNode(uint32_t begin, uint32_t end, uint32_t depth);
+    /// @brief 三角形の頂点を位置の配列から取得し直す
+    void UpdateTriangles(std::span<const Vector3> positions);
+    /// @brief 節点の境界ボックスを、葉は三角形から、それ以外は子から求める
+    void UpdateNodeBounds(Node &node, uint32_t nodeIndex) const;
+
+    std::vector<Node> nodes_;
+    // 葉の順に並べた三角形と、その元の番号
+    std::vector<Triangle> triangles_;
+    std::vector<uint32_t> triangleIndices_;
+    // Refit用に持っておく元のインデックス
+    std::vector<uint32_t> indices_;
+    // 構築中だけ使う各三角形の重心
+    std::vector<Vector3> centroids_;
+};
+
+} // namespace Math
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -1,7 +1,11 @@
 #pragma once
 #include <stdexcept>
 #include <cmath>
+#include <algorithm>
+#include <type_traits>
 #include <vector>
+#include "MatrixSimd.h"
+#include "FastMath.h"
 
 namespace KashipanEngine {
 
@@ -14,41 +18,42 @@ struct Segment;
 } // namespace Math
 
 struct Vector3 {
-    static Vector3 Lerp(const Vector3 &start, const Vector3 &end, float t) noexcept;
+    static constexpr Vector3 Lerp(const Vector3 &start, const Vector3 &end, float t) noexcept;
     static Vector3 Slerp(const Vector3 &start, const Vector3 &end, float t) noexcept;
-    static Vector3 Bezier(const Vector3 &p0, const Vector3 &p1, const Vector3 &p2, const float t) noexcept;
-    static Vector3 CatmullRomInterpolation(const Vector3 &p0, const Vector3 &p1, const Vector3 &p2, const Vector3 &p3, float t) noexcept;
+    static constexpr Vector3 Bezier(const Vector3 &p0, const Vector3 &p1, const Vector3 &p2, const float t) noexcept;
+    static constexpr Vector3 CatmullRomInterpolation(const Vector3 &p0, const Vector3 &p1, const Vector3 &p2, const Vector3 &p3, float t) noexcept;
     static Vector3 CatmullRomPosition(const std::vector<Vector3> &points, float t, bool isLoop = false);
 
     Vector3() noexcept = default;
     constexpr Vector3(float x, float y, float z) noexcept : x(x), y(y), z(z) {}
     explicit constexpr Vector3(float v) noexcept : x(v), y(v), z(v) {}
-    Vector3(const Vector3 &vector) : x(vector.x), y(vector.y), z(vector.z) {}
-    Vector3(const Vector2 &vector) noexcept;
-    Vector3(const Vector4 &vector) noexcept;
-
-    Vector3 &operator=(const Vector3 &vector) noexcept;
-    Vector3 &operator+=(const Vector3 &vector) noexcept;
-    Vector3 &operator-=(const Vector3 &vector) noexcept;
-    Vector3 &operator*=(const float scalar) noexcept;
-    Vector3 &operator*=(const Vector3 &vector) noexcept;
-    Vector3 &operator/=(const float scalar);
-    Vector3 &operator/=(const Vector3 &vector);
-    bool operator==(const Vector3 &vector) const noexcept;
-    bool operator!=(const Vector3 &vector) const noexcept;
+    constexpr Vector3(const Vector3 &vector) noexcept = default;
+    constexpr Vector3(const Vector2 &vector) noexcept;
+    constexpr Vector3(const Vector4 &vector) noexcept;
+
+    constexpr Vector3 &operator=(const Vector3 &vector) noexcept = default;
+    constexpr Vector3 &operator+=(const Vector3 &vector) noexcept;
+    constexpr Vector3 &operator-=(const Vector3 &vector) noexcept;
+    constexpr Vector3 &operator*=(const float scalar) noexcept;
+    constexpr Vector3 &operator*=(const Vector3 &vector) noexcept;
+    constexpr Vector3 &operator/=(const float scalar);
+    constexpr Vector3 &operator/=(const Vector3 &vector);
+    constexpr bool operator==(const Vector3 &vector) const noexcept;
+    constexpr bool operator!=(const Vector3 &vector) const noexcept;
 
     [[nodiscard]] constexpr float Dot(const Vector3 &vector) const noexcept;
-    [[nodiscard]] Vector3 Cross(const Vector3 &vector) const noexcept;
+    [[nodiscard]] constexpr Vector3 Cross(const Vector3 &vector) const noexcept;
     [[nodiscard]] float Length() const noexcept;
     [[nodiscard]] constexpr float LengthSquared() const noexcept;
     [[nodiscard]] Vector3 Normalize() const;
-    [[nodiscard]] Vector3 Projection(const Vector3 &vector) const noexcept;
+    [[nodiscard]] constexpr Vector3 Projection(const Vector3 &vector) const noexcept;
     [[nodiscard]] Vector3 ClosestPoint(const Math::Segment &segment) const noexcept;
-    [[nodiscard]] Vector3 Perpendicular() const noexcept;
-    [[nodiscard]] Vector3 Rejection(const Vector3 &vector) const noexcept;
-    [[nodiscard]] Vector3 Refrection(const Vector3 &normal) const noexcept;
+    [[nodiscard]] constexpr Vector3 Perpendicular() const noexcept;
+    [[nodiscard]] constexpr Vector3 Rejection(const Vector3 &vector) const noexcept;
+    [[nodiscard]] constexpr Vector3 Refrection(const Vector3 &normal) const noexcept;
     [[nodiscard]] float Distance(const Vector3 &vector) const;
-    [[nodiscard]] Vector3 Transform(const Matrix4x4 &mat) const noexcept;
+    [[nodiscard]] constexpr Vector3 Transform(const Matrix4x4 &mat) const noexcept;
+    [[nodiscard]] constexpr Vector3 TransformDirection(const Matrix4x4 &mat) const noexcept;
 
     float x;
     float y;
@@ -84,7 +89,242 @@ inline constexpr const Vector3 operator/(const Vector3 &vector1, const Vector3 &
     return Vector3(vector1.x / vector2.x, vector1.y / vector2.y, vector1.z / vector2.z);
 }
 
-const Vector3 operator*(const Matrix4x4 &mat, const Vector3 &vector) noexcept;
-const Vector3 operator*(const Vector3 &vector, const Matrix4x4 &mat) noexcept;
+inline constexpr const Vector3 operator*(const Matrix4x4 &mat, const Vector3 &vector) noexcept;
+inline constexpr const Vector3 operator*(const Vector3 &vector, const Matrix4x4 &mat) noexcept;
+
+} // namespace KashipanEngine
+
+// 変換に使う型はVector3の定義の後に読み込む(互いに読み込み合っても定義の順番が崩れないように)
+#include "Vector2.h"
+#include "Vector4.h"
+#include "Matrix4x4.h"
+
+namespace KashipanEngine {
+
+inline constexpr Vector3 Vector3::Lerp(const Vector3 &start, const Vector3 &end, float t) noexcept {
+    return t * start + (1.0f - t) * end;
+}
+
+inline Vector3 Vector3::Slerp(const Vector3 &start, const Vector3 &end, float t) noexcept {
+    Vector3 normalizedStart = start.Normalize();
+    Vector3 normalizedEnd = end.Normalize();
+
+    float dotProduct = normalizedStart.Dot(normalizedEnd);
+    // Dotの値が変な値にならないよう制限
+    dotProduct = std::clamp(dotProduct, -1.0f, 1.0f);
+    float angle = Math::Gameplay::Acos(dotProduct);
+    float sinTheta = Math::Gameplay::Sin(angle);
+    // 角度が0の場合は線形補間を行う
+    if (sinTheta == 0.0f) {
+        return Lerp(start, end, t).Normalize();
+    }
+
+    float t1 = Math::Gameplay::Sin(angle * (1.0f - t));
+    float t2 = Math::Gameplay::Sin(angle * t);
+
+    Vector3 result = (normalizedStart * t1 + normalizedEnd * t2) / sinTheta;
+    return result.Normalize();
+}
+
+inline constexpr Vector3 Vector3::Bezier(const Vector3 &p0, const Vector3 &p1, const Vector3 &p2, float t) noexcept {
+    Vector3 p01 = Vector3::Lerp(p0, p1, t);
+    Vector3 p12 = Vector3::Lerp(p1, p2, t);
+    return Vector3::Lerp(p01, p12, t);
+}
+
+inline constexpr Vector3 Vector3::CatmullRomInterpolation(const Vector3 &p0, const Vector3 &p1, const Vector3 &p2, const Vector3 &p3, float t) noexcept {
+    const float s = 0.5f;
+
+    float t2 = t * t;
+    float t3 = t2 * t;
+
+    auto e3 = (-p0 + (3.0f * p1) - (3.0f * p2) + p3) * t3;
+    auto e2 = ((2.0f * p0) - (5.0f * p1) + (4.0f * p2) - p3) * t2;
+    auto e1 = (-p0 + p2) * t;
+    auto e0 = 2.0f * p1;
+
+    return s * (e3 + e2 + e1 + e0);
+}
+
+inline constexpr Vector3::Vector3(const Vector2 &vector) noexcept : x(vector.x), y(vector.y), z(0.0f) {}
+
+inline constexpr Vector3::Vector3(const Vector4 &vector) noexcept : x(0.0f), y(0.0f), z(0.0f) {
+    if (vector.w != 0.0f) {
+        x = vector.x / vector.w;
+        y = vector.y / vector.w;
+        z = vector.z / vector.w;
+    }
+}
+
+inline constexpr Vector3 &Vector3::operator+=(const Vector3 &vector) noexcept {
+    x += vector.x;
+    y += vector.y;
+    z += vector.z;
+    return *this;
+}
+
+inline constexpr Vector3 &Vector3::operator-=(const Vector3 &vector) noexcept {
+    x -= vector.x;
+    y -= vector.y;
+    z -= vector.z;
+    return *this;
+}
+
+inline constexpr Vector3 &Vector3::operator*=(const float scalar) noexcept {
+    x *= scalar;
+    y *= scalar;
+    z *= scalar;
+    return *this;
+}
+
+inline constexpr Vector3 &Vector3::operator*=(const Vector3 &vector) noexcept {
+    x *= vector.x;
+    y *= vector.y;
+    z *= vector.z;
+    return *this;
+}
+
+inline constexpr Vector3 &Vector3::operator/=(const float scalar) {
+    if (scalar == 0.0f) {
+        x = 0.0f;
+        y = 0.0f;
+        z = 0.0f;
+    } else {
+        x /= scalar;
+        y /= scalar;
+        z /= scalar;
+    }
+    return *this;
+}
+
+inline constexpr Vector3 &Vector3::operator/=(const Vector3 &vector) {
+    if (vector.x == 0.0f) {
+        x = 0.0f;
+    } else {
+        x /= vector.x;
+    }
+    if (vector.y == 0.0f) {
+        y = 0.0f;
+    } else {
+        y /= vector.y;
+    }
+    if (vector.z == 0.0f) {
+        z = 0.0f;
+    } else {
+        z /= vector.z;
+    }
+    return *this;
+}
+
+inline constexpr bool Vector3::operator==(const Vector3 &vector) const noexcept {
+    return x == vector.x && y == vector.y && z == vector.z;
+}
+
+inline constexpr bool Vector3::operator!=(const Vector3 &vector) const noexcept {
+    return x != vector.x || y != vector.y || z != vector.z;
+}
+
+inline constexpr float Vector3::Dot(const Vector3 &vector) const noexcept {
+    return x * vector.x + y * vector.y + z * vector.z;
+}
+
+inline constexpr Vector3 Vector3::Cross(const Vector3 &vector) const noexcept {
+    return Vector3(
+        y * vector.z - z * vector.y,
+        z * vector.x - x * vector.z,
+        x * vector.y - y * vector.x
+    );
+}
+
+inline float Vector3::Length() const noexcept {
+    return std::sqrt(LengthSquared());
+}
+
+inline constexpr float Vector3::LengthSquared() const noexcept {
+    return Dot(*this);
+}
+
+inline Vector3 Vector3::Normalize() const {
+    const float length = Length();
+    if (length == 0.0f) {
+        return Vector3(0.0f, 0.0f, 0.0f);
+    }
+    return *this / length;
+}
+
+inline constexpr Vector3 Vector3::Projection(const Vector3 &vector) const noexcept {
+    return (Dot(vector) / vector.Dot(vector)) * vector;
+}
+
+inline constexpr Vector3 Vector3::Perpendicular() const noexcept {
+    if (x != 0.0f || y != 0.0f) {
+        return Vector3(-y, x, 0.0f);
+    }
+    return Vector3(0.0f, -z, y);
+}
+
+inline constexpr Vector3 Vector3::Rejection(const Vector3 &vector) const noexcept {
+    return *this - Projection(vector);
+}
+
+inline constexpr Vector3 Vector3::Refrection(const Vector3 &normal) const noexcept {
+    return *this - 2.0f * Dot(normal) * normal;
+}
+
+inline float Vector3::Distance(const Vector3 &vector) const {
+    return (vector - *this).Length();
+}
+
+inline constexpr Vector3 Vector3::Transform(const Matrix4x4 &mat) const noexcept {
+    if (!std::is_constant_evaluated()) {
+        float result[3];
+        MatrixSimd::TransformPoint(&mat.m[0][0], x, y, z, result);
+        return Vector3(result[0], result[1], result[2]);
+    }
+    Vector3 result{};
+    result.x = x * mat.m[0][0] + y * mat.m[1][0] + z * mat.m[2][0] + 1.0f * mat.m[3][0];
+    result.y = x * mat.m[0][1] + y * mat.m[1][1] + z * mat.m[2][1] + 1.0f * mat.m[3][1];
+    result.z = x * mat.m[0][2] + y * mat.m[1][2] + z * mat.m[2][2] + 1.0f * mat.m[3][2];
+    float w = x * mat.m[0][3] + y * mat.m[1][3] + z * mat.m[2][3] + 1.0f * mat.m[3][3];
+
+    if (w == 0.0f) {
+        return Vector3(0.0f);
+    }
+
+    result.x /= w;
+    result.y /= w;
+    result.z /= w;
+
+    return result;
+}
+
+inline constexpr Vector3 Vector3::TransformDirection(const Matrix4x4 &mat) const noexcept {
+    if (!std::is_constant_evaluated()) {
+        float result[3];
+        MatrixSimd::TransformDirection(&mat.m[0][0], x, y, z, result);
+        return Vector3(result[0], result[1], result[2]);
+    }
+    return Vector3(
+        x * mat.m[0][0] + y * mat.m[1][0] + z * mat.m[2][0],
+        x * mat.m[0][1] + y * mat.m[1][1] + z * mat.m[2][1],
+        x * mat.m[0][2] + y * mat.m[1][2] + z * mat.m[2][2]
+    );
+}
+
+inline constexpr const Vector3 operator*(const Matrix4x4 &mat, const Vector3 &vector) noexcept {
+    return Vector3(
+        mat.m[0][0] * vector.x + mat.m[0][1] * vector.y + mat.m[0][2] * vector.z + mat.m[0][3],
+        mat.m[1][0] * vector.x + mat.m[1][1] * vector.y + mat.m[1][2] * vector.z + mat.m[1][3],
+        mat.m[2][0] * vector.x + mat.m[2][1] * vector.y + mat.m[2][2] * vector.z + mat.m[2][3]
+    );
+}
+
+inline constexpr const Vector3 operator*(const Vector3 &vector, const Matrix4x4 &mat) noexcept {
+    return Vector3(
+        vector.x * mat.m[0][0] + vector.y * mat.m[1][0] + vector.z * mat.m[2][0] + mat.m[3][0],
+        vector.x * mat.m[0][1] + vector.y * mat.m[1][1] + vector.z * mat.m[2][1] + mat.m[3][1],
+        vector.x * mat.m[0][2] + vector.y * mat.m[1][2] + vector.z * mat.m[2][2] + mat.m[3][2]
+    );
+}
 
 } // namespace KashipanEngine
\ No newline at end of file
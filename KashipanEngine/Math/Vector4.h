@@ -7,15 +7,27 @@ struct Vector3;
 
 struct Vector4 final {
     Vector4() = default;
-    Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
-    Vector4(float value) : x(value), y(value), z(value), w(value) {}
-    Vector4(const Vector2 &vector2);
-    Vector4(const Vector3 &vector3);
-    
+    constexpr Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    constexpr Vector4(float value) : x(value), y(value), z(value), w(value) {}
+    constexpr Vector4(const Vector2 &vector2);
+    constexpr Vector4(const Vector3 &vector3);
+
     float x;
     float y;
     float z;
     float w;
 };
 
+} // namespace KashipanEngine
+
+// 変換に使う型はVector4の定義の後に読み込む(互いに読み込み合っても定義の順番が崩れないように)
+#include "Vector2.h"
+#include "Vector3.h"
+
+namespace KashipanEngine {
+
+inline constexpr Vector4::Vector4(const Vector2 &vector2) : x(vector2.x), y(vector2.y), z(0.0f), w(1.0f) {}
+
+inline constexpr Vector4::Vector4(const Vector3 &vector3) : x(vector3.x), y(vector3.y), z(vector3.z), w(1.0f) {}
+
 } // namespace KashipanEngine
\ No newline at end of file
@@ -12,6 +12,7 @@ BillBoard::BillBoard(Vector3 *cameraRotete) {
     mesh_->indexBufferMap[3] = 1;
     mesh_->indexBufferMap[4] = 3;
     mesh_->indexBufferMap[5] = 2;
+    CreateVertexShadow();
     cameraRotate_ = cameraRotete;
 }
 
@@ -33,27 +34,9 @@ void BillBoard::Draw() {
         transform_.rotate.z = 0.0f;
     }
 
-    if (material_.enableLighting == false) {
-        for (int i = 0; i < 4; i++) {
-            mesh_->vertexBufferMap[i].normal = { 0.0f, 0.0f, -1.0f };
-        }
-    } else {
-        if (normalType_ == kNormalTypeVertex) {
-            for (int i = 0; i < 4; i++) {
-                mesh_->vertexBufferMap[i].normal =
-                    Vector3(mesh_->vertexBufferMap[i].position);
-            }
-        } else if (normalType_ == kNormalTypeFace) {
-            Vector3 position[3] = {};
-            position[0] = Vector3(mesh_->vertexBufferMap[0].position);
-            position[1] = Vector3(mesh_->vertexBufferMap[1].position);
-            position[2] = Vector3(mesh_->vertexBufferMap[2].position);
-            for (int i = 0; i < 4; i++) {
-                mesh_->vertexBufferMap[i].normal =
-                    (position[1] - position[0]).Cross(position[2] - position[1]).Normalize();
-            }
-        }
-    }
+    // 法線は控えで計算し、変更があったときだけ頂点バッファに転送する
+    UpdateShadowNormals({ 0.0f, 0.0f, -1.0f });
+    TransferVertices();
 
     // 描画共通処理を呼び出す
     DrawCommon();
@@ -77,27 +60,9 @@ void BillBoard::Draw(WorldTransform &worldTransform) {
         worldTransform.rotate_.z = 0.0f;
     }
 
-    if (material_.enableLighting == false) {
-        for (int i = 0; i < 4; i++) {
-            mesh_->vertexBufferMap[i].normal = { 0.0f, 0.0f, -1.0f };
-        }
-    } else {
-        if (normalType_ == kNormalTypeVertex) {
-            for (int i = 0; i < 4; i++) {
-                mesh_->vertexBufferMap[i].normal =
-                    Vector3(mesh_->vertexBufferMap[i].position);
-            }
-        } else if (normalType_ == kNormalTypeFace) {
-            Vector3 position[3] = {};
-            position[0] = Vector3(mesh_->vertexBufferMap[0].position);
-            position[1] = Vector3(mesh_->vertexBufferMap[1].position);
-            position[2] = Vector3(mesh_->vertexBufferMap[2].position);
-            for (int i = 0; i < 4; i++) {
-                mesh_->vertexBufferMap[i].normal =
-                    (position[1] - position[0]).Cross(position[2] - position[1]).Normalize();
-            }
-        }
-    }
+    // 法線は控えで計算し、変更があったときだけ頂点バッファに転送する
+    UpdateShadowNormals({ 0.0f, 0.0f, -1.0f });
+    TransferVertices();
 
     // 描画共通処理を呼び出す
     DrawCommon(worldTransform);
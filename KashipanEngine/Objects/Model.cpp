@@ -1,12 +1,15 @@
 #include <fstream>
 #include <sstream>
 #include <cassert>
+#include <algorithm>
 
 #include "Model.h"
 #include "Math/Vector2.h"
 #include "Math/Vector3.h"
 #include "Math/Vector4.h"
+#include "Math/TriangleBVH.h"
 #include "Common/Logs.h"
+#include "Base/Renderer.h"
 #include "Base/Texture.h"
 
 namespace KashipanEngine {
@@ -83,6 +86,30 @@ void ModelData::CreateData(std::vector<VertexData> &vertexData, std::vector<uint
     // メッシュのインデックスバッファにデータをコピー
     std::memcpy(mesh_->indexBufferMap, indexData.data(), sizeof(uint32_t) * indexData.size());
 
+    // 頂点の位置とインデックスのCPU側の控え。アップロードヒープのマップは書き込み結合のメモリで読むと遅いので、
+    // BVHや遮蔽物など頂点を読む処理はこちらを使う
+    positions_.resize(vertexData.size());
+    for (size_t i = 0; i < vertexData.size(); ++i) {
+        const Vector4 &position = vertexData[i].position;
+        positions_[i] = Vector3(position.x, position.y, position.z);
+    }
+    indices_ = indexData;
+
+    // オクルージョンカリング用のローカル座標の境界ボックス
+    hasLocalBounds_ = !positions_.empty();
+    if (hasLocalBounds_) {
+        localBoundsMin_ = positions_[0];
+        localBoundsMax_ = localBoundsMin_;
+        for (const Vector3 &position : positions_) {
+            localBoundsMin_.x = std::min(localBoundsMin_.x, position.x);
+            localBoundsMin_.y = std::min(localBoundsMin_.y, position.y);
+            localBoundsMin_.z = std::min(localBoundsMin_.z, position.z);
+            localBoundsMax_.x = std::max(localBoundsMax_.x, position.x);
+            localBoundsMax_.y = std::max(localBoundsMax_.y, position.y);
+            localBoundsMax_.z = std::max(localBoundsMax_.z, position.z);
+        }
+    }
+
     // マテリアルの設定
     materialData_ = materialData;
     if (materialData_.textureFilePath.empty()) {
@@ -96,11 +123,28 @@ void ModelData::CreateData(std::vector<VertexData> &vertexData, std::vector<uint
 void ModelData::Draw() {
     isUseCamera_ = true;
     DrawCommon();
+    if (isOccluder_ && renderer_) {
+        renderer_->DrawSetOccluder({ positions_, indices_, &worldMatrix_ });
+    }
 }
 
 void ModelData::Draw(WorldTransform &worldTransform) {
     isUseCamera_ = true;
     DrawCommon(worldTransform);
+    if (isOccluder_ && renderer_) {
+        renderer_->DrawSetOccluder({ positions_, indices_, &worldTransform.worldMatrix_ });
+    }
+}
+
+void ModelData::BuildBVH(Math::TriangleBVH &bvh) const {
+    assert(isMeshExist());
+    bvh.Build(positions_, indices_);
+}
+
+void ModelData::SetOccluder(bool isOccluder) {
+    assert(isMeshExist());
+    // 遮蔽物の頂点はCreateDataで作った控えを使うので、ここでは切り替えるだけ
+    isOccluder_ = isOccluder;
 }
 
 Model::Model(std::string directoryPath, std::string fileName) {
@@ -289,4 +333,10 @@ void Model::SetRenderer(Renderer *renderer) {
     }
 }
 
+void Model::SetOccluder(bool isOccluder) {
+    for (auto &model : models_) {
+        model.SetOccluder(isOccluder);
+    }
+}
+
 } // namespace KashipanEngine
\ No newline at end of file
@@ -8,6 +8,9 @@ namespace KashipanEngine {
 
 // 前方宣言
 class Texture;
+namespace Math {
+class TriangleBVH;
+} // namespace Math
 
 /// @brief モデルのマテリアルデータ
 struct MaterialData {
@@ -38,11 +41,27 @@ public:
     /// @param worldTransform ワールド変換データ
     void Draw(WorldTransform &worldTransform);
 
+    /// @brief メッシュの三角形から衝突判定用のBVHを作る(頂点はモデル座標のまま)
+    /// @details CreateDataで作った頂点の位置とインデックスの控えから作る
+    /// @param bvh 作り直すBVH
+    void BuildBVH(Math::TriangleBVH &bvh) const;
+
+    /// @brief 遮蔽物にするかどうかの設定。遮蔽物は描画のたびにレンダラーのオクルージョンカリングに使われる
+    /// @details 頂点はCreateDataで作った位置とインデックスの控えを使うので、いつ切り替えても軽い
+    /// @param isOccluder 遮蔽物にするならtrue
+    void SetOccluder(bool isOccluder);
+
 private:
     /// @brief インデックス数
     UINT indexCount_ = 0;
     /// @brief モデルのマテリアル
     MaterialData materialData_;
+    /// @brief 頂点の位置(モデル座標)とインデックスのCPU側の控え
+    std::vector<Vector3> positions_;
+    std::vector<uint32_t> indices_;
+
+    /// @brief 遮蔽物かどうか
+    bool isOccluder_ = false;
 };
 
 /// @brief モデルクラス
@@ -66,6 +85,10 @@ public:
     /// @param renderer レンダラーへのポインタ
     void SetRenderer(Renderer *renderer);
 
+    /// @brief 遮蔽物にするかどうかの設定(地面や大きな敵など、裏にあるものを隠す大きなモデルに使う)
+    /// @param isOccluder 遮蔽物にするならtrue
+    void SetOccluder(bool isOccluder);
+
     /// @brief transformへのアクセス
     /// @return モデル全体のtransform
     Transform &GetTransform() {
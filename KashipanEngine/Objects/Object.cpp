@@ -20,6 +20,10 @@ Object::Object(Object &&other) noexcept {
     vertexCount_ = other.vertexCount_;
     indexCount_ = other.indexCount_;
     useTextureIndex_ = other.useTextureIndex_;
+    hasLocalBounds_ = other.hasLocalBounds_;
+    localBoundsMin_ = other.localBoundsMin_;
+    localBoundsMax_ = other.localBoundsMax_;
+    vertexShadow_ = std::move(other.vertexShadow_);
 }
 
 void Object::DrawCommon() {
@@ -39,11 +43,19 @@ void Object::DrawCommon() {
     );
 
     // 行列を計算
-    worldMatrix_.MakeAffine(
-        transform_.scale,
-        transform_.rotate,
-        transform_.translate
-    );
+    if (transform_.isUseQuaternion) {
+        worldMatrix_.MakeAffine(
+            transform_.scale,
+            transform_.rotateQuaternion,
+            transform_.translate
+        );
+    } else {
+        worldMatrix_.MakeAffine(
+            transform_.scale,
+            transform_.rotate,
+            transform_.translate
+        );
+    }
     // TransformationMatrixを転送
     transformationMatrixMap_->world = worldMatrix_;
 
@@ -58,6 +70,9 @@ void Object::DrawCommon() {
     objectState.useTextureIndex = useTextureIndex_;
     objectState.fillMode = fillMode_;
     objectState.isUseCamera = isUseCamera_;
+    objectState.hasLocalBounds = hasLocalBounds_;
+    objectState.localBoundsMin = localBoundsMin_;
+    objectState.localBoundsMax = localBoundsMax_;
     bool isSemitransparent = (material_.color.w < 255.0f);
     renderer_->DrawSet(objectState, isUseCamera_, isSemitransparent);
 }
@@ -95,6 +110,9 @@ void Object::DrawCommon(WorldTransform &worldTransform) {
     objectState.useTextureIndex = useTextureIndex_;
     objectState.fillMode = fillMode_;
     objectState.isUseCamera = isUseCamera_;
+    objectState.hasLocalBounds = hasLocalBounds_;
+    objectState.localBoundsMin = localBoundsMin_;
+    objectState.localBoundsMax = localBoundsMax_;
     bool isSemitransparent = (material_.color.w < 255.0f);
     renderer_->DrawSet(objectState, isUseCamera_, isSemitransparent);
 }
@@ -125,4 +143,16 @@ void Object::Create(UINT vertexCount, UINT indexCount) {
     };
 }
 
+void Object::CreateVertexShadow() {
+    vertexShadow_.Create(vertexCount_);
+}
+
+void Object::UpdateShadowNormals(const Vector3 &unlitNormal) {
+    vertexShadow_.UpdateNormals(material_.enableLighting, normalType_, unlitNormal);
+}
+
+void Object::TransferVertices() {
+    vertexShadow_.Transfer(mesh_->vertexBufferMap);
+}
+
 } // namespace KashipanEngine
\ No newline at end of file
@@ -1,10 +1,12 @@
 #pragma once
+#include <vector>
 #include "WorldTransform.h"
 #include "Math/Transform.h"
 #include "Math/Matrix4x4.h"
 #include "Common/VertexData.h"
 #include "Common/TransformationMatrix.h"
 #include "Common/Material.h"
+#include "Common/VertexShadow.h"
 #include "3d/PrimitiveDrawer.h"
 
 namespace KashipanEngine {
@@ -12,11 +14,6 @@ namespace KashipanEngine {
 // 前方宣言
 class Renderer;
 
-enum NormalType {
-    kNormalTypeVertex,
-    kNormalTypeFace,
-};
-
 class Object {
 public:
     struct StatePtr {
@@ -43,6 +40,17 @@ public:
     [[nodiscard]] virtual StatePtr GetStatePtr() {
         return { nullptr, &transform_, &uvTransform_, &material_, &useTextureIndex_, &normalType_, &fillMode_};
     }
+
+    /// @brief 頂点バッファへの転送回数の取得
+    /// @return 前回のリセットからの転送回数
+    [[nodiscard]] static uint32_t GetVertexTransferCount() {
+        return VertexShadow::GetTransferCount();
+    }
+
+    /// @brief 頂点バッファへの転送回数をリセットする
+    static void ResetVertexTransferCount() {
+        VertexShadow::ResetTransferCount();
+    }
     
 protected:
     //==================================================
@@ -61,6 +69,18 @@ protected:
     /// @param worldTransform ワールド変換データ
     void DrawCommon(WorldTransform &worldTransform);
 
+    /// @brief 頂点データのCPU側の控えを作成する。
+    /// 控えを使うオブジェクトは頂点の編集を全て控えに対して行い、TransferVerticesで転送する
+    void CreateVertexShadow();
+
+    /// @brief 控えの頂点データの法線を、ライティングと法線のタイプに合わせて計算する。
+    /// 設定が前回から変わっていなければ何もしない
+    /// @param unlitNormal ライティングが無効なときの法線
+    void UpdateShadowNormals(const Vector3 &unlitNormal);
+
+    /// @brief 控えの頂点データが変更されていれば頂点バッファにまとめて転送する
+    void TransferVertices();
+
     //==================================================
     // メンバ変数
     //==================================================
@@ -110,6 +130,17 @@ protected:
 
     /// @brief カメラ使用フラグ
     bool isUseCamera_ = false;
+
+    /// @brief ローカル座標の境界ボックスがあるかどうか(あればオクルージョンカリングの対象になる)
+    bool hasLocalBounds_ = false;
+    /// @brief ローカル座標の境界ボックスの最小点
+    Vector3 localBoundsMin_{};
+    /// @brief ローカル座標の境界ボックスの最大点
+    Vector3 localBoundsMax_{};
+
+    /// @brief 頂点データのCPU側の控え。
+    /// 頂点バッファは書き込み結合メモリなので、読み出しや部分的な書き換えは控えに対して行う
+    VertexShadow vertexShadow_;
 };
 
 } // namespace KashipanEngine
\ No newline at end of file
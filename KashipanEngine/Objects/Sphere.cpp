@@ -1,6 +1,8 @@
 #include "Sphere.h"
 #include "Math/Collider.h"
+#include "Math/FastMath.h"
 #include <cmath>
+#include <vector>
 #define M_PI (4.0f * std::atanf(1.0f))
 
 namespace KashipanEngine {
@@ -16,13 +18,25 @@ Sphere::Sphere(const int subdivision) :
     const float kLonEvery = pi * 2.0f / static_cast<float>(kSubdivision_);
     // 緯度分割1つ分の角度
     const float kLatEvery = pi / static_cast<float>(kSubdivision_);
+    // 緯度・経度ごとのsin・cosを先にまとめて計算しておく(分割数+1個ずつで済む)
+    std::vector<float> angles(kSubdivision_ + 1);
+    std::vector<float> latSin(kSubdivision_ + 1);
+    std::vector<float> latCos(kSubdivision_ + 1);
+    std::vector<float> lonSin(kSubdivision_ + 1);
+    std::vector<float> lonCos(kSubdivision_ + 1);
+    for (uint32_t i = 0; i <= kSubdivision_; i++) {
+        angles[i] = -pi / 2.0f + (kLatEvery * static_cast<float>(i));
+    }
+    Math::Fast::SinCos(angles, latSin, latCos);
+    for (uint32_t i = 0; i <= kSubdivision_; i++) {
+        angles[i] = static_cast<float>(i) * kLonEvery;
+    }
+    Math::Fast::SinCos(angles, lonSin, lonCos);
+
     // 緯度の方向に分割 -π/2 ～ π/2
     for (uint32_t latIndex = 0; latIndex < kSubdivision_; latIndex++) {
-        const float lat = -pi / 2.0f + (kLatEvery * static_cast<float>(latIndex));
         // 経度の方向に分割 0 ～ 2π
         for (uint32_t lonIndex = 0; lonIndex < kSubdivision_; lonIndex++) {
-            const float lon = static_cast<float>(lonIndex) * kLonEvery;
-
             // インデックスを計算
             const uint32_t startIndex = (latIndex * kSubdivision_ + lonIndex) * 6;
             // 頂点位置を計算
@@ -41,9 +55,9 @@ Sphere::Sphere(const int subdivision) :
 
             // 左下
             mesh_->vertexBufferMap[vertexIndex + 0].position = {
-                std::cosf(lat) * std::cosf(lon),
-                std::sinf(lat),
-                std::cosf(lat) * std::sinf(lon),
+                latCos[latIndex] * lonCos[lonIndex],
+                latSin[latIndex],
+                latCos[latIndex] * lonSin[lonIndex],
                 1.0f
             };
             mesh_->vertexBufferMap[vertexIndex + 0].texCoord = {
@@ -52,9 +66,9 @@ Sphere::Sphere(const int subdivision) :
             };
             // 左上
             mesh_->vertexBufferMap[vertexIndex + 1].position = {
-                std::cosf(lat + kLatEvery) * std::cosf(lon),
-                std::sinf(lat + kLatEvery),
-                std::cosf(lat + kLatEvery) * std::sinf(lon),
+                latCos[latIndex + 1] * lonCos[lonIndex],
+                latSin[latIndex + 1],
+                latCos[latIndex + 1] * lonSin[lonIndex],
                 1.0f
             };
             mesh_->vertexBufferMap[vertexIndex + 1].texCoord = {
@@ -63,9 +77,9 @@ Sphere::Sphere(const int subdivision) :
             };
             // 右下
             mesh_->vertexBufferMap[vertexIndex + 2].position = {
-                std::cosf(lat) * std::cosf(lon + kLonEvery),
-                std::sinf(lat),
-                std::cosf(lat) * std::sinf(lon + kLonEvery),
+                latCos[latIndex] * lonCos[lonIndex + 1],
+                latSin[latIndex],
+                latCos[latIndex] * lonSin[lonIndex + 1],
                 1.0f
             };
             mesh_->vertexBufferMap[vertexIndex + 2].texCoord = {
@@ -74,9 +88,9 @@ Sphere::Sphere(const int subdivision) :
             };
             // 右上
             mesh_->vertexBufferMap[vertexIndex + 3].position = {
-                std::cosf(lat + kLatEvery) * std::cosf(lon + kLonEvery),
-                std::sinf(lat + kLatEvery),
-                std::cosf(lat + kLatEvery) * std::sinf(lon + kLonEvery),
+                latCos[latIndex + 1] * lonCos[lonIndex + 1],
+                latSin[latIndex + 1],
+                latCos[latIndex + 1] * lonSin[lonIndex + 1],
                 1.0f
             };
             mesh_->vertexBufferMap[vertexIndex + 3].texCoord = {
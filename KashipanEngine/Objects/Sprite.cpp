@@ -1,4 +1,5 @@
 #include "Sprite.h"
+#include "Base/Renderer.h"
 #include "Base/Texture.h"
 #include "Common/Logs.h"
 
@@ -25,28 +26,59 @@ void Sprite::SetTexture(const uint32_t textureIndex) {
 }
 
 void Sprite::Draw() {
-    // 法線を設定
-    for (int i = 0; i < 4; i++) {
-        mesh_->vertexBufferMap[i].normal = { 0.0f, 0.0f, -1.0f };
+    // 行列を計算
+    if (transform_.isUseQuaternion) {
+        worldMatrix_.MakeAffine(
+            transform_.scale,
+            transform_.rotateQuaternion,
+            transform_.translate
+        );
+    } else {
+        worldMatrix_.MakeAffine(
+            transform_.scale,
+            transform_.rotate,
+            transform_.translate
+        );
     }
 
-    // 描画共通処理を呼び出す
-    DrawCommon();
+    // ワイヤーフレームはバッチで描画できないので個別に描画する
+    if (fillMode_ == kFillModeWireframe) {
+        CreateMesh();
+        UpdateShadowNormals({ 0.0f, 0.0f, -1.0f });
+        TransferVertices();
+        DrawCommon();
+        return;
+    }
+    DrawBatch(worldMatrix_);
 }
 
 void Sprite::Draw(WorldTransform &worldTransform) {
-    // 法線を設定
-    for (int i = 0; i < 4; i++) {
-        mesh_->vertexBufferMap[i].normal = { 0.0f, 0.0f, -1.0f };
+    if (fillMode_ == kFillModeWireframe) {
+        CreateMesh();
+        UpdateShadowNormals({ 0.0f, 0.0f, -1.0f });
+        TransferVertices();
+        DrawCommon(worldTransform);
+        return;
     }
-    // 描画共通処理を呼び出す
-    DrawCommon(worldTransform);
+    // ワールド行列を計算
+    worldTransform.TransferMatrix();
+    DrawBatch(worldTransform.worldMatrix_);
 }
 
 void Sprite::Initialize() {
-    Create(4, 6);
     isUseCamera_ = false;
     material_.enableLighting = false;
+}
+
+void Sprite::CreateMesh() {
+    // 既に作成済みなら何もしない
+    if (mesh_) {
+        return;
+    }
+    // Createで初期化されるUVのtransformは設定済みのものを残す
+    const Transform uvTransform = uvTransform_;
+    Create(4, 6);
+    uvTransform_ = uvTransform;
 
     mesh_->indexBufferMap[0] = 0;
     mesh_->indexBufferMap[1] = 1;
@@ -55,20 +87,56 @@ void Sprite::Initialize() {
     mesh_->indexBufferMap[4] = 3;
     mesh_->indexBufferMap[5] = 2;
 
-    mesh_->vertexBufferMap[0].texCoord = { 0.0f, 1.0f };
-    mesh_->vertexBufferMap[1].texCoord = { 0.0f, 0.0f };
-    mesh_->vertexBufferMap[2].texCoord = { 1.0f, 1.0f };
-    mesh_->vertexBufferMap[3].texCoord = { 1.0f, 0.0f };
+    // 頂点は控えに作ってからまとめて転送する
+    CreateVertexShadow();
+    auto &vertices = vertexShadow_.Edit();
+    vertices[0].position = { 0.0f,    size_.y,    0.0f, 1.0f };
+    vertices[1].position = { 0.0f,    0.0f,       0.0f, 1.0f };
+    vertices[2].position = { size_.x, size_.y,    0.0f, 1.0f };
+    vertices[3].position = { size_.x, 0.0f,       0.0f, 1.0f };
+
+    vertices[0].texCoord = { uvMin_.x, uvMax_.y };
+    vertices[1].texCoord = { uvMin_.x, uvMin_.y };
+    vertices[2].texCoord = { uvMax_.x, uvMax_.y };
+    vertices[3].texCoord = { uvMax_.x, uvMin_.y };
+}
+
+void Sprite::DrawBatch(const Matrix4x4 &worldMatrix) {
+    // レンダラーが設定されていない場合はログを出力して終了
+    if (renderer_ == nullptr) {
+        Log("Renderer is not set.", kLogLevelFlagError);
+        return;
+    }
+
+    SpriteBatch::SpriteState spriteState;
+    spriteState.worldMatrix = worldMatrix;
+    spriteState.uvTransform.MakeAffine(
+        uvTransform_.scale,
+        uvTransform_.rotate,
+        uvTransform_.translate
+    );
+    spriteState.size = size_;
+    spriteState.uvMin = uvMin_;
+    spriteState.uvMax = uvMax_;
+    spriteState.color = material_.color;
+    spriteState.textureIndex = useTextureIndex_;
+    spriteState.layer = layer_;
+    spriteState.enableLighting = material_.enableLighting;
+    renderer_->DrawSetSprite(spriteState);
 }
 
 void Sprite::LoadTexture(const TextureData &textureData) {
-    float width = static_cast<float>(textureData.width);
-    float height = static_cast<float>(textureData.height);
+    size_ = Vector2(static_cast<float>(textureData.width), static_cast<float>(textureData.height));
+
+    // アトラスに詰められたテクスチャならその範囲のUVにする
+    uvMin_ = textureData.uvOffset;
+    uvMax_ = textureData.uvOffset + textureData.uvScale;
 
-    mesh_->vertexBufferMap[0].position = { 0.0f,    height, 0.0f, 1.0f };
-    mesh_->vertexBufferMap[1].position = { 0.0f,    0.0f,   0.0f, 1.0f };
-    mesh_->vertexBufferMap[2].position = { width,   height, 0.0f, 1.0f };
-    mesh_->vertexBufferMap[3].position = { width,   0.0f,   0.0f, 1.0f };
+    // 個別のメッシュを作成済みなら書き換える
+    if (mesh_) {
+        mesh_.reset();
+        CreateMesh();
+    }
 }
 
 } // namespace KashipanEngine
\ No newline at end of file
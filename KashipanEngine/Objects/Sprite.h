@@ -18,6 +18,12 @@ public:
     /// @param textureIndex テクスチャのインデックス
     void SetTexture(const uint32_t textureIndex);
 
+    /// @brief 描画順のレイヤーの設定。小さいほど先に描画される
+    /// @param layer レイヤー
+    void SetLayer(int layer) {
+        layer_ = layer;
+    }
+
     /// @brief 描画処理
     void Draw();
 
@@ -29,12 +35,27 @@ private:
     /// @brief 初期化処理
     void Initialize();
 
+    /// @brief ワイヤーフレーム描画用の個別のメッシュを作成する
+    void CreateMesh();
+
+    /// @brief スプライトバッチに描画を登録する
+    /// @param worldMatrix ワールド行列
+    void DrawBatch(const Matrix4x4 &worldMatrix);
+
     /// @brief テクスチャのロード
     /// @param textureData テクスチャデータ
     void LoadTexture(const TextureData &textureData);
 
     /// @brief テクスチャの左上を(0, 0)、右下を(1, 1)とするアンカーポイント
     Vector2 anchor_ = { 0.0f, 0.0f };
+    /// @brief スプライトの大きさ
+    Vector2 size_ = { 0.0f, 0.0f };
+    /// @brief UVの左上
+    Vector2 uvMin_ = { 0.0f, 0.0f };
+    /// @brief UVの右下
+    Vector2 uvMax_ = { 1.0f, 1.0f };
+    /// @brief 描画順のレイヤー
+    int layer_ = 0;
 };
 
 } // namespace KashipanEngine
\ No newline at end of file
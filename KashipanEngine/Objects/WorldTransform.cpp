@@ -12,7 +12,11 @@ WorldTransform::WorldTransform() {
 
 void WorldTransform::TransferMatrix() {
     // ワールド変換行列を計算
-    worldMatrix_.MakeAffine(scale_, rotate_, translate_);
+    if (isUseQuaternion_) {
+        worldMatrix_.MakeAffine(scale_, rotateQuaternion_, translate_);
+    } else {
+        worldMatrix_.MakeAffine(scale_, rotate_, translate_);
+    }
 
     // 親のワールド変換がある場合は親のワールド行列とかける
     if (parentTransform_ != nullptr) {
@@ -1,5 +1,6 @@
 #pragma once
 #include "Math/AffineMatrix.h"
+#include "Math/Quaternion.h"
 #include "Common/TransformationMatrix.h"
 #include <wrl.h>
 #include <d3d12.h>
@@ -16,6 +17,9 @@ public:
     Vector3 translate_ = { 0.0f, 0.0f, 0.0f };
     Vector3 rotate_ = { 0.0f, 0.0f, 0.0f };
     Vector3 scale_ = { 1.0f, 1.0f, 1.0f };
+    // isUseQuaternion_がtrueのときはrotate_の代わりに使う回転
+    Quaternion rotateQuaternion_ = Quaternion::Identity();
+    bool isUseQuaternion_ = false;
     // ワールド行列
     Matrix4x4 worldMatrix_;
     // 親のWorldTransformへのポインタ
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "Common/AtlasPacker.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// ページの大きさ・ガターの幅・配置を揃える単位
+constexpr uint32_t kPageSize = 256;
+constexpr uint32_t kGutter = 2;
+constexpr uint32_t kAlignment = 4;
+
+/// @brief ピクセルごとに違う色の画像を作る(どの画像のどのピクセルか色から分かるようにする)
+DecodedImage MakeImage(uint32_t index, uint32_t width, uint32_t height) {
+    DecodedImage image;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t *pixel = image.pixels.data() + (static_cast<size_t>(y) * width + x) * 4;
+            pixel[0] = static_cast<uint8_t>(index);
+            pixel[1] = static_cast<uint8_t>(x);
+            pixel[2] = static_cast<uint8_t>(y);
+            pixel[3] = 255;
+        }
+    }
+    return image;
+}
+
+/// @brief ページのピクセルと画像のピクセルが一致するか
+bool IsSamePixel(const DecodedImage &page, uint32_t pageX, uint32_t pageY, const DecodedImage &image, uint32_t x, uint32_t y) {
+    const uint8_t *a = page.pixels.data() + (static_cast<size_t>(pageY) * page.width + pageX) * 4;
+    const uint8_t *b = image.pixels.data() + (static_cast<size_t>(y) * image.width + x) * 4;
+    return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+}
+
+/// @brief 1ページに収まらない数の画像を作る
+std::vector<DecodedImage> MakeImages() {
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<uint32_t> distSize(1, 60);
+    std::vector<DecodedImage> images;
+    for (uint32_t i = 0; i < 48; ++i) {
+        images.push_back(MakeImage(i, distSize(random), distSize(random)));
+    }
+    return images;
+}
+
+} // namespace
+
+KASHIPAN_TEST(Texture_AtlasPackerPlacesEveryImageWithoutOverlap) {
+    const std::vector<DecodedImage> images = MakeImages();
+    std::vector<const DecodedImage *> imagePointers;
+    for (const DecodedImage &image : images) {
+        imagePointers.push_back(&image);
+    }
+
+    std::vector<AtlasPage> pages;
+    std::vector<AtlasPlacement> placements;
+    KASHIPAN_REQUIRE(AtlasPacker::Pack(imagePointers, kPageSize, kGutter, kAlignment, pages, placements));
+    KASHIPAN_REQUIRE(placements.size() == images.size());
+    // 画像の面積の合計がページ1枚より大きいので、2枚以上に分かれる
+    KASHIPAN_EXPECT(pages.size() >= 2);
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        const AtlasPlacement &a = placements[i];
+        KASHIPAN_REQUIRE(a.pageIndex < pages.size());
+        const DecodedImage &page = pages[a.pageIndex].image;
+        KASHIPAN_EXPECT_EQ(a.width, images[i].width);
+        KASHIPAN_EXPECT_EQ(a.height, images[i].height);
+        // ガターを含めた範囲がページに収まり、左上がalignmentの倍数に揃っている
+        KASHIPAN_EXPECT(a.x >= kGutter && a.y >= kGutter);
+        KASHIPAN_EXPECT((a.x - kGutter) % kAlignment == 0 && (a.y - kGutter) % kAlignment == 0);
+        KASHIPAN_REQUIRE(a.x + a.width + kGutter <= page.width && a.y + a.height + kGutter <= page.height);
+
+        // 同じページの他の画像とガターを含めて重ならない
+        for (size_t j = i + 1; j < images.size(); ++j) {
+            const AtlasPlacement &b = placements[j];
+            if (a.pageIndex != b.pageIndex) {
+                continue;
+            }
+            const bool isSeparated =
+                a.x + a.width + kGutter <= b.x - kGutter || b.x + b.width + kGutter <= a.x - kGutter ||
+                a.y + a.height + kGutter <= b.y - kGutter || b.y + b.height + kGutter <= a.y - kGutter;
+            KASHIPAN_EXPECT(isSeparated);
+        }
+
+        // 中身は元の画像と一致し、ガターには一番近い端のピクセルが入っている
+        uint32_t mismatchCount = 0;
+        for (uint32_t y = 0; y < a.height + kGutter * 2; ++y) {
+            for (uint32_t x = 0; x < a.width + kGutter * 2; ++x) {
+                const uint32_t sourceX = std::min(x > kGutter ? x - kGutter : 0, a.width - 1);
+                const uint32_t sourceY = std::min(y > kGutter ? y - kGutter : 0, a.height - 1);
+                if (!IsSamePixel(page, a.x - kGutter + x, a.y - kGutter + y, images[i], sourceX, sourceY)) {
+                    ++mismatchCount;
+                }
+            }
+        }
+        KASHIPAN_EXPECT_EQ(mismatchCount, 0u);
+    }
+}
+
+KASHIPAN_TEST(Texture_AtlasPackerSkipsImagesLargerThanAPage) {
+    const DecodedImage small = MakeImage(0, 16, 16);
+    const DecodedImage large = MakeImage(1, kPageSize, 8);
+    std::vector<AtlasPage> pages;
+    std::vector<AtlasPlacement> placements;
+    KASHIPAN_REQUIRE(AtlasPacker::Pack({ &small, &large }, kPageSize, kGutter, kAlignment, pages, placements));
+    KASHIPAN_EXPECT_EQ(pages.size(), 1u);
+    KASHIPAN_EXPECT_EQ(placements[0].pageIndex, 0u);
+    // ガターを付けるとページの幅を超えるので詰めない
+    KASHIPAN_EXPECT_EQ(placements[1].pageIndex, AtlasPlacement::kNotPacked);
+}
\ No newline at end of file
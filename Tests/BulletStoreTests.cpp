@@ -0,0 +1,182 @@
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Test.h"
+#include "BulletStore.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 弾の数と、追う目標の数
+constexpr uint32_t kBulletCount = 100;
+constexpr uint32_t kTargetCount = 5;
+// 目標へ向かう速さ
+constexpr float kHomingSpeed = 16.0f;
+// 向きと速さの許容誤差
+constexpr float kTolerance = 1e-4f;
+
+const Vector4 kStraightColor(255.0f, 255.0f, 255.0f, 255.0f);
+const Vector4 kHomingColor(255.0f, 0.0f, 0.0f, 255.0f);
+const Vector3 kForward(0.0f, 0.0f, 1.0f);
+
+/// @brief 添字ごとに違う値を持つ弾を追加する(どの列も添字から値が分かる)
+/// @details 3つに1つは真っすぐ、3つに1つは曲がる、残りは添字を目標の数で割った余りの番号の目標を追う
+void SpawnNumbered(BulletStore &bullets) {
+    for (uint32_t i = 0; i < kBulletCount; ++i) {
+        const float value = static_cast<float>(i);
+        const Vector3 position(value, value * 0.5f, -value);
+        const Vector3 velocity(1.0f, 0.0f, value);
+        const Vector4 color(value, 0.0f, 0.0f, 255.0f);
+        switch (i % 3) {
+            case 0:
+                bullets.Spawn(position, velocity, value * 0.01f, value, BulletStore::State::kStraight, color);
+                break;
+            case 1:
+                bullets.Spawn(position, velocity, value * 0.01f, value, BulletStore::State::kSteer, color);
+                break;
+            default:
+                bullets.Spawn(position, velocity, value * 0.01f, value, BulletStore::State::kHoming, color, i % kTargetCount);
+                break;
+        }
+    }
+}
+
+/// @brief 弾の列が、SpawnNumberedで追加した同じ添字の弾のままかを調べる
+/// @return 食い違った弾の数
+uint32_t CountMismatchedRows(const BulletStore &bullets) {
+    uint32_t mismatches = 0;
+    for (uint32_t index = 0; index < bullets.GetCount(); ++index) {
+        // 元の添字は色から分かる
+        const float value = bullets.GetColors()[index].x;
+        const uint32_t original = static_cast<uint32_t>(value);
+        const Vector3 position = bullets.GetPositions()[index];
+        const bool isHoming = original % 3 == 2;
+        const bool isMatched =
+            position.x == value && position.y == value * 0.5f && position.z == -value &&
+            bullets.GetVelocities()[index].z == value &&
+            bullets.GetRadii()[index] == value * 0.01f &&
+            bullets.GetLifeTimes()[index] == value &&
+            bullets.GetStates()[index] == (original % 3 == 0 ? BulletStore::State::kStraight :
+                original % 3 == 1 ? BulletStore::State::kSteer : BulletStore::State::kHoming) &&
+            bullets.GetTargetIds()[index] == (isHoming ? original % kTargetCount : BulletStore::kNoTarget);
+        mismatches += isMatched ? 0 : 1;
+    }
+    return mismatches;
+}
+
+} // namespace
+
+KASHIPAN_TEST(Object_BulletStoreRemoveDeadKeepsColumnsTogether) {
+    BulletStore bullets;
+    SpawnNumbered(bullets);
+    KASHIPAN_EXPECT_EQ(CountMismatchedRows(bullets), 0u);
+
+    // 先頭・末尾・連続した弾を消しても、残った弾の列は揃ったまま
+    std::vector<bool> isKilled(kBulletCount, false);
+    for (uint32_t i = 0; i < kBulletCount; ++i) {
+        isKilled[i] = i == 0 || i == kBulletCount - 1 || (i >= 40 && i < 60) || i % 7 == 3;
+        if (isKilled[i]) {
+            bullets.Kill(i);
+        }
+    }
+    bullets.RemoveDead();
+    KASHIPAN_EXPECT_EQ(CountMismatchedRows(bullets), 0u);
+
+    // 消した弾だけが無くなり、残すはずの弾は1つずつ残る
+    std::vector<uint32_t> found(kBulletCount, 0);
+    for (const Vector4 &color : bullets.GetColors()) {
+        ++found[static_cast<uint32_t>(color.x)];
+    }
+    uint32_t errors = 0;
+    for (uint32_t i = 0; i < kBulletCount; ++i) {
+        errors += found[i] == (isKilled[i] ? 0u : 1u) ? 0 : 1;
+    }
+    KASHIPAN_EXPECT_EQ(errors, 0u);
+
+    bullets.Clear();
+    KASHIPAN_EXPECT_EQ(bullets.GetCount(), 0u);
+    KASHIPAN_EXPECT(bullets.GetColors().empty());
+    KASHIPAN_EXPECT(bullets.GetTargetIds().empty());
+}
+
+KASHIPAN_TEST(Object_BulletStoreHomingFollowsEachTarget) {
+    BulletStore bullets;
+    SpawnNumbered(bullets);
+    const std::vector<Vector3> velocities(bullets.GetVelocities().begin(), bullets.GetVelocities().end());
+
+    // 目標の番号と位置の添字は一致しない(目標の入れ物で詰め直された後を想定する)
+    const std::vector<uint32_t> targetIndices = { 3, 0, 4, 1, 2 };
+    const std::vector<Vector3> targetPositions = {
+        Vector3(50.0f, 0.0f, 0.0f), Vector3(0.0f, 50.0f, 0.0f), Vector3(0.0f, 0.0f, 50.0f),
+        Vector3(-50.0f, 10.0f, 0.0f), Vector3(20.0f, -30.0f, 40.0f),
+    };
+    bullets.Home(targetIndices, targetPositions, kHomingSpeed);
+
+    uint32_t wrongDirections = 0;
+    uint32_t changedOthers = 0;
+    for (uint32_t i = 0; i < bullets.GetCount(); ++i) {
+        const Vector3 velocity = bullets.GetVelocities()[i];
+        if (bullets.GetStates()[i] != BulletStore::State::kHoming) {
+            // 真っすぐ進む弾と曲がる弾はHomeでは変わらない
+            changedOthers += velocity.x == velocities[i].x && velocity.y == velocities[i].y && velocity.z == velocities[i].z ? 0 : 1;
+            continue;
+        }
+        const Vector3 target = targetPositions[targetIndices[bullets.GetTargetIds()[i]]];
+        const Vector3 expected = (target - bullets.GetPositions()[i]).Normalize() * kHomingSpeed;
+        const Vector3 forward = bullets.GetRotations()[i].RotateVector(kForward);
+        const bool isFollowing = (velocity - expected).Length() < kTolerance * kHomingSpeed &&
+            (forward - expected.Normalize()).Length() < kTolerance;
+        wrongDirections += isFollowing ? 0 : 1;
+    }
+    KASHIPAN_EXPECT_EQ(wrongDirections, 0u);
+    KASHIPAN_EXPECT_EQ(changedOthers, 0u);
+}
+
+KASHIPAN_TEST(Object_BulletStoreReleaseTargetsGoesStraight) {
+    BulletStore bullets;
+    SpawnNumbered(bullets);
+    const std::vector<Vector3> velocities(bullets.GetVelocities().begin(), bullets.GetVelocities().end());
+    const std::vector<Vector4> colors(bullets.GetColors().begin(), bullets.GetColors().end());
+
+    // 番号1と3の目標が居なくなった
+    const std::vector<uint32_t> releasedIds = { 1, 3 };
+    bullets.ReleaseTargets(releasedIds, kStraightColor);
+
+    uint32_t errors = 0;
+    uint32_t releasedCount = 0;
+    for (uint32_t i = 0; i < bullets.GetCount(); ++i) {
+        const bool isReleased = i % 3 == 2 && (i % kTargetCount == 1 || i % kTargetCount == 3);
+        const Vector3 velocity = bullets.GetVelocities()[i];
+        const Vector4 color = bullets.GetColors()[i];
+        // 速度はどの弾も変わらず、外れた弾だけが真っすぐ進む色に変わる
+        bool isExpected = velocity.x == velocities[i].x && velocity.y == velocities[i].y && velocity.z == velocities[i].z;
+        if (isReleased) {
+            ++releasedCount;
+            isExpected = isExpected && bullets.GetStates()[i] == BulletStore::State::kStraight &&
+                bullets.GetTargetIds()[i] == BulletStore::kNoTarget &&
+                color.x == kStraightColor.x && color.y == kStraightColor.y && color.z == kStraightColor.z;
+        } else {
+            isExpected = isExpected && color.x == colors[i].x &&
+                (i % 3 != 2 || bullets.GetTargetIds()[i] == i % kTargetCount);
+        }
+        errors += isExpected ? 0 : 1;
+    }
+    KASHIPAN_EXPECT_EQ(errors, 0u);
+    KASHIPAN_EXPECT(releasedCount > 0);
+
+    // 外れた弾は、残った目標の位置しか渡さなくてもHomeで調べられない
+    const std::vector<uint32_t> targetIndices = { 0, UINT32_MAX, 1, UINT32_MAX, 2 };
+    const std::vector<Vector3> targetPositions = {
+        Vector3(50.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 50.0f), Vector3(20.0f, -30.0f, 40.0f),
+    };
+    bullets.Home(targetIndices, targetPositions, kHomingSpeed);
+    uint32_t movedReleased = 0;
+    for (uint32_t i = 0; i < bullets.GetCount(); ++i) {
+        if (i % 3 == 2 && (i % kTargetCount == 1 || i % kTargetCount == 3)) {
+            movedReleased += bullets.GetVelocities()[i].z == velocities[i].z ? 0 : 1;
+        }
+    }
+    KASHIPAN_EXPECT_EQ(movedReleased, 0u);
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Test.h"
+#include "Math/CatmullRomSpline.h"
+#include "Math/Vector3.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 一定の距離ずつ進める回数
+constexpr int kStepCount = 4000;
+// 弦の長さと1歩の距離の相対誤差の許容値
+// (測ると最大5e-3。ほとんどはfloatの位置の丸め誤差で、ループの継ぎ目近くの急なカーブでは弦と弧の差が加わる)
+constexpr double kChordTolerance = 1e-2;
+// 位置の許容誤差(制御点の座標の大きさに対する丸め誤差)
+constexpr double kPositionTolerance = 1e-3;
+
+/// @brief RailCameraControllerと同じ制御点
+std::vector<Vector3> RailPoints() {
+    return {
+        Vector3(0.0f, 0.0f, 0.0f),
+        Vector3(50.0f, 0.0f, 0.0f),
+        Vector3(50.0f, 30.0f, 50.0f),
+        Vector3(-20.0f, 70.0f, 50.0f),
+    };
+}
+
+/// @brief 間隔が大きく違う制御点(パラメータで等間隔に進めると速さが何倍も変わる)
+std::vector<Vector3> UnevenPoints() {
+    return {
+        Vector3(0.0f, 0.0f, 0.0f),
+        Vector3(4.0f, 1.0f, 0.0f),
+        Vector3(14.0f, 2.0f, 3.0f),
+        Vector3(50.0f, 6.0f, 10.0f),
+        Vector3(70.0f, 0.0f, 40.0f),
+        Vector3(30.0f, -4.0f, 50.0f),
+    };
+}
+
+/// @brief 2点間の距離
+double Distance(const Vector3 &a, const Vector3 &b) {
+    const double dx = static_cast<double>(a.x) - b.x;
+    const double dy = static_cast<double>(a.y) - b.y;
+    const double dz = static_cast<double>(a.z) - b.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+/// @brief 一定の距離ずつ進めた時の弦の長さの、1歩の距離に対する相対誤差の最大
+/// @param spline 調べる曲線
+/// @param start 進め始める距離
+/// @param stepCount 進める回数
+/// @param step 1歩の距離
+double MaxChordError(const CatmullRomSpline &spline, float start, int stepCount, float step) {
+    double maxError = 0.0;
+    Vector3 previous = spline.GetPosition(spline.WrapDistance(start));
+    for (int i = 1; i <= stepCount; ++i) {
+        const Vector3 position = spline.GetPosition(spline.WrapDistance(start + step * static_cast<float>(i)));
+        maxError = std::max(maxError, std::abs(Distance(previous, position) - step) / step);
+        previous = position;
+    }
+    return maxError;
+}
+
+} // namespace
+
+KASHIPAN_TEST(Spline_ConstantSpeedOnOpenRails) {
+    for (const auto &points : { RailPoints(), UnevenPoints() }) {
+        const CatmullRomSpline spline(points, false);
+        KASHIPAN_REQUIRE(spline.GetLength() > 0.0f);
+        const float step = spline.GetLength() / static_cast<float>(kStepCount);
+        KASHIPAN_EXPECT_NEAR(MaxChordError(spline, 0.0f, kStepCount, step), 0.0, kChordTolerance);
+
+        // 端はちょうど最初と最後の制御点で、範囲の外は端に止まる
+        KASHIPAN_EXPECT_NEAR(Distance(spline.GetPosition(0.0f), points.front()), 0.0, kPositionTolerance);
+        KASHIPAN_EXPECT_NEAR(Distance(spline.GetPosition(spline.GetLength()), points.back()), 0.0, kPositionTolerance);
+        KASHIPAN_EXPECT_EQ(spline.WrapDistance(-1.0f), 0.0f);
+        KASHIPAN_EXPECT_EQ(spline.WrapDistance(spline.GetLength() + 1.0f), spline.GetLength());
+    }
+}
+
+KASHIPAN_TEST(Spline_ConstantSpeedOnLoopRails) {
+    for (const auto &points : { RailPoints(), UnevenPoints() }) {
+        const CatmullRomSpline spline(points, true);
+        KASHIPAN_REQUIRE(spline.GetLength() > 0.0f);
+        const float step = spline.GetLength() / static_cast<float>(kStepCount);
+        KASHIPAN_EXPECT_NEAR(MaxChordError(spline, 0.0f, kStepCount, step), 0.0, kChordTolerance);
+        // 継ぎ目をまたいで2周目に入っても同じ速さで進む
+        const float seamStart = spline.GetLength() - step * static_cast<float>(kStepCount / 8);
+        KASHIPAN_EXPECT_NEAR(MaxChordError(spline, seamStart, kStepCount / 4, step), 0.0, kChordTolerance);
+
+        // 始点と終点は同じ位置で、全長を足しても同じ位置に戻る
+        KASHIPAN_EXPECT_NEAR(Distance(spline.GetPosition(0.0f), points.front()), 0.0, kPositionTolerance);
+        KASHIPAN_EXPECT_NEAR(Distance(spline.GetPosition(spline.GetLength()), points.front()), 0.0, kPositionTolerance);
+        const float distance = spline.GetLength() * 0.3f;
+        KASHIPAN_EXPECT_NEAR(Distance(spline.GetPosition(distance), spline.GetPosition(distance + spline.GetLength())),
+            0.0, kPositionTolerance);
+    }
+}
+
+KASHIPAN_TEST(Spline_ParameterStepsAreNotConstantSpeed) {
+    // 弧長で進めない場合(以前のRailCameraController)は、同じ調べ方で許容値を大きく超えることを確かめておく
+    const std::vector<Vector3> points = UnevenPoints();
+    const CatmullRomSpline spline(points, false);
+    const double step = spline.GetLength() / static_cast<double>(kStepCount);
+    double maxError = 0.0;
+    Vector3 previous = Vector3::CatmullRomPosition(points, 0.0f, false);
+    for (int i = 1; i <= kStepCount; ++i) {
+        const Vector3 position = Vector3::CatmullRomPosition(points, static_cast<float>(i) / kStepCount, false);
+        maxError = std::max(maxError, std::abs(Distance(previous, position) - step) / step);
+        previous = position;
+    }
+    KASHIPAN_EXPECT(maxError > kChordTolerance * 10.0);
+}
+
+KASHIPAN_TEST(Spline_PositionsLieOnCatmullRomCurve) {
+    for (bool isLoop : { false, true }) {
+        const std::vector<Vector3> points = UnevenPoints();
+        const CatmullRomSpline spline(points, isLoop);
+        for (int i = 0; i <= 100; ++i) {
+            const float distance = spline.GetLength() * static_cast<float>(i) / 100.0f;
+            const Vector3 expected = Vector3::CatmullRomPosition(points, spline.GetParameter(distance), isLoop);
+            KASHIPAN_EXPECT_NEAR(Distance(spline.GetPosition(distance), expected), 0.0, kPositionTolerance);
+        }
+    }
+}
\ No newline at end of file
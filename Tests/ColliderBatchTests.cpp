@@ -0,0 +1,226 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "Math/Collider.h"
+#include "Math/ColliderBatch.h"
+#include "Math/MathObjects/AABB.h"
+#include "Math/MathObjects/Lines.h"
+#include "Math/MathObjects/Sphere.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 判定される側の要素数(SSE2の4・AVX2の8の倍数とその前後、マスクの1ワードの前後。余りのレーンが全て出るようにする)
+constexpr size_t kCounts[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 11, 15, 16, 17, 31, 63, 64, 65, 100, 129 };
+// 1つの要素数あたりに試す判定する側の形状の数
+constexpr int kQueryCount = 64;
+// 配列の先頭をずらして試す量(SIMDの読み込みがレーンの幅に揃っていない場合)
+constexpr size_t kMaxOffset = 7;
+
+/// @brief 座標を作る。半分は0.5刻みにして、ちょうど接する・境界上に乗る場合が多く出るようにする
+float RandomCoordinate(std::mt19937 &random, float range) {
+    std::uniform_real_distribution<float> dist(-range, range);
+    const float value = dist(random);
+    return (random() & 1) != 0 ? std::round(value * 2.0f) * 0.5f : value;
+}
+
+Vector3 RandomVector3(std::mt19937 &random, float range) {
+    return Vector3(RandomCoordinate(random, range), RandomCoordinate(random, range), RandomCoordinate(random, range));
+}
+
+/// @brief 半直線を作る。軸に平行な向き(差分の成分が0)も混ぜる
+Math::Ray RandomRay(std::mt19937 &random) {
+    Math::Ray ray;
+    ray.origin = RandomVector3(random, 8.0f);
+    ray.diff = RandomVector3(random, 4.0f);
+    if (random() % 4 == 0) {
+        ray.diff.x = 0.0f;
+    }
+    if (random() % 4 == 0) {
+        ray.diff.y = 0.0f;
+    }
+    return ray;
+}
+
+/// @brief 球の配列をSoAに並べ替えて持つ
+struct SphereArrays {
+    explicit SphereArrays(const std::vector<Math::Sphere> &spheres) {
+        for (const auto &sphere : spheres) {
+            centerX.push_back(sphere.center.x);
+            centerY.push_back(sphere.center.y);
+            centerZ.push_back(sphere.center.z);
+            radius.push_back(sphere.radius);
+        }
+    }
+    Math::SphereSoA GetSoA() const {
+        return Math::SphereSoA{ centerX, centerY, centerZ, radius };
+    }
+
+    std::vector<float> centerX, centerY, centerZ, radius;
+};
+
+/// @brief AABBの配列をSoAに並べ替えて持つ
+struct AABBArrays {
+    explicit AABBArrays(const std::vector<Math::AABB> &aabbs) {
+        for (const auto &aabb : aabbs) {
+            minX.push_back(aabb.min.x);
+            minY.push_back(aabb.min.y);
+            minZ.push_back(aabb.min.z);
+            maxX.push_back(aabb.max.x);
+            maxY.push_back(aabb.max.y);
+            maxZ.push_back(aabb.max.z);
+        }
+    }
+    Math::AABBSoA GetSoA() const {
+        return Math::AABBSoA{ minX, minY, minZ, maxX, maxY, maxZ };
+    }
+
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+};
+
+std::vector<Math::Sphere> RandomSpheres(std::mt19937 &random, size_t count) {
+    std::uniform_real_distribution<float> radius(0.25f, 3.0f);
+    std::vector<Math::Sphere> result;
+    for (size_t i = 0; i < count; ++i) {
+        result.emplace_back(RandomVector3(random, 8.0f), std::round(radius(random) * 2.0f) * 0.5f);
+    }
+    return result;
+}
+
+std::vector<Math::AABB> RandomAABBs(std::mt19937 &random, size_t count) {
+    std::uniform_real_distribution<float> size(0.0f, 4.0f);
+    std::vector<Math::AABB> result;
+    for (size_t i = 0; i < count; ++i) {
+        const Vector3 min = RandomVector3(random, 8.0f);
+        result.emplace_back(min, min + Vector3(size(random), size(random), size(random)));
+    }
+    return result;
+}
+
+/// @brief バッチ版の結果(マスク・添字・数)が、1つずつスカラー版で判定した結果と完全に一致するか調べる
+/// @param query 判定する側の形状
+/// @param shapes 判定される側の形状(スカラー版用)
+/// @param soa 判定される側の形状(バッチ版用)
+/// @param scalarTest スカラー版の判定
+/// @return 一致したかどうか
+template <class Query, class Shape, class SoA, class ScalarTest>
+bool MatchesScalar(const Query &query, const std::vector<Shape> &shapes, const SoA &soa, ScalarTest scalarTest) {
+    const size_t count = shapes.size();
+    std::vector<uint32_t> expected;
+    for (size_t i = 0; i < count; ++i) {
+        if (scalarTest(query, shapes[i])) {
+            expected.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    // マスクは前の結果が残っていても、要素数の分のワードは全て書き直される
+    std::vector<uint64_t> mask(Math::Collider::GetMaskWordCount(count), ~uint64_t{ 0 });
+    const size_t maskCount = Math::Collider::IsCollision(query, soa, mask);
+    std::vector<uint32_t> fromMask;
+    for (size_t word = 0; word < mask.size(); ++word) {
+        for (uint32_t bit = 0; bit < 64; ++bit) {
+            if ((mask[word] >> bit) & 1) {
+                fromMask.push_back(static_cast<uint32_t>(word * 64 + bit));
+            }
+        }
+    }
+
+    std::vector<uint32_t> indices(count);
+    const size_t indexCount = Math::Collider::GetCollisionIndices(query, soa, indices);
+    indices.resize(indexCount);
+
+    return maskCount == expected.size() && fromMask == expected && indices == expected;
+}
+
+/// @brief 全ての要素数と先頭のずらし方で、バッチ版がスカラー版と一致するか調べる
+/// @return 一致しなかった組み合わせの数
+template <class Shape, class Arrays, class MakeQuery, class MakeShapes, class ScalarTest>
+int CountMismatches(uint32_t seed, MakeQuery makeQuery, MakeShapes makeShapes, ScalarTest scalarTest) {
+    std::mt19937 random(seed);
+    int mismatches = 0;
+    for (size_t count : kCounts) {
+        const std::vector<Shape> shapes = makeShapes(random, count + kMaxOffset);
+        const Arrays arrays(shapes);
+        for (size_t offset = 0; offset <= kMaxOffset; ++offset) {
+            const std::vector<Shape> part(shapes.begin() + offset, shapes.begin() + offset + count);
+            const auto soa = arrays.GetSoA().Subspan(offset, count);
+            for (int i = 0; i < kQueryCount; ++i) {
+                mismatches += MatchesScalar(makeQuery(random), part, soa, scalarTest) ? 0 : 1;
+            }
+        }
+    }
+    return mismatches;
+}
+
+Math::Sphere RandomQuerySphere(std::mt19937 &random) {
+    return RandomSpheres(random, 1).front();
+}
+
+} // namespace
+
+KASHIPAN_TEST(Collision_BatchSphereVsSpheresMatchesScalar) {
+    const int mismatches = CountMismatches<Math::Sphere, SphereArrays>(11, RandomQuerySphere, RandomSpheres,
+        [](const Math::Sphere &query, const Math::Sphere &sphere) { return Math::Collider::IsCollision(query, sphere); });
+    KASHIPAN_EXPECT_EQ(mismatches, 0);
+}
+
+KASHIPAN_TEST(Collision_BatchSphereVsAABBsMatchesScalar) {
+    const int mismatches = CountMismatches<Math::AABB, AABBArrays>(22, RandomQuerySphere, RandomAABBs,
+        [](const Math::Sphere &query, const Math::AABB &aabb) { return Math::Collider::IsCollision(aabb, query); });
+    KASHIPAN_EXPECT_EQ(mismatches, 0);
+}
+
+KASHIPAN_TEST(Collision_BatchRayVsSpheresMatchesScalar) {
+    const int mismatches = CountMismatches<Math::Sphere, SphereArrays>(33, RandomRay, RandomSpheres,
+        [](const Math::Ray &query, const Math::Sphere &sphere) { return Math::Collider::IsCollision(sphere, query); });
+    KASHIPAN_EXPECT_EQ(mismatches, 0);
+}
+
+KASHIPAN_TEST(Collision_BatchRayVsAABBsMatchesScalar) {
+    const int mismatches = CountMismatches<Math::AABB, AABBArrays>(44, RandomRay, RandomAABBs,
+        [](const Math::Ray &query, const Math::AABB &aabb) { return Math::Collider::IsCollision(aabb, query); });
+    KASHIPAN_EXPECT_EQ(mismatches, 0);
+}
+
+KASHIPAN_TEST(Collision_BatchPairsMatchScalar) {
+    std::mt19937 random(55);
+    for (size_t count : kCounts) {
+        const std::vector<Math::Sphere> spheresA = RandomSpheres(random, count);
+        const std::vector<Math::Sphere> spheresB = RandomSpheres(random, count + 3);
+        const SphereArrays arraysA(spheresA);
+        const SphereArrays arraysB(spheresB);
+
+        std::vector<Math::CollisionPair> pairs;
+        Math::Collider::GetCollisionPairs(arraysA.GetSoA(), arraysB.GetSoA(), pairs);
+        size_t index = 0;
+        bool isMatch = true;
+        for (uint32_t a = 0; a < spheresA.size(); ++a) {
+            for (uint32_t b = 0; b < spheresB.size(); ++b) {
+                if (Math::Collider::IsCollision(spheresA[a], spheresB[b])) {
+                    isMatch = isMatch && index < pairs.size() && pairs[index].indexA == a && pairs[index].indexB == b;
+                    ++index;
+                }
+            }
+        }
+        KASHIPAN_EXPECT(isMatch && index == pairs.size());
+
+        // 同じ配列内の組は、2つ目の球が1つ目より後ろのものだけ
+        pairs.clear();
+        Math::Collider::GetCollisionPairs(arraysA.GetSoA(), pairs);
+        index = 0;
+        isMatch = true;
+        for (uint32_t a = 0; a < spheresA.size(); ++a) {
+            for (uint32_t b = a + 1; b < spheresA.size(); ++b) {
+                if (Math::Collider::IsCollision(spheresA[a], spheresA[b])) {
+                    isMatch = isMatch && index < pairs.size() && pairs[index].indexA == a && pairs[index].indexB == b;
+                    ++index;
+                }
+            }
+        }
+        KASHIPAN_EXPECT(isMatch && index == pairs.size());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "CollisionManager.h"
+#include "Common/JobSystem.h"
+#include "Math/Broadphase.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 自機・自弾・敵・敵弾と、全てと衝突するもの(アイテムなど)の属性
+constexpr uint32_t kPlayer = 0b00001;
+constexpr uint32_t kPlayerBullet = 0b00010;
+constexpr uint32_t kEnemy = 0b00100;
+constexpr uint32_t kEnemyBullet = 0b01000;
+constexpr uint32_t kItem = 0b10000;
+
+// オブジェクトの数と動き回る箱の大きさ(検出の範囲が複数に分かれるくらい候補が出るように密にする)
+constexpr size_t kColliderCount = 3000;
+constexpr float kHalfExtent = 15.0f;
+constexpr float kDeltaTime = 1.0f / 60.0f;
+// 比べるフレーム数
+constexpr int kFrameCount = 20;
+// CollisionManagerが1つのスレッドにまとめて渡す候補の数(CollisionManager.cppのkChunkSize)
+constexpr size_t kChunkSize = 1024;
+
+/// @brief 位置と半径だけを持ち、呼ばれたOnCollisionを記録する衝突判定オブジェクト
+class TestCollider : public Collider {
+public:
+    TestCollider(uint32_t id, const Vector3 &position, float radius, uint32_t attribute, uint32_t mask,
+        std::vector<uint32_t> *log) : id_(id), position_(position), log_(log) {
+        SetRadius(radius);
+        SetCollisionAttribute(attribute);
+        SetCollisionMask(mask);
+    }
+
+    void OnCollision() override {
+        log_->push_back(id_);
+    }
+    Vector3 GetWorldPosition() override {
+        return position_;
+    }
+    void SetPosition(const Vector3 &position) {
+        position_ = position;
+    }
+
+private:
+    uint32_t id_;
+    Vector3 position_;
+    std::vector<uint32_t> *log_;
+};
+
+/// @brief 1回のUpdateの結果
+struct FrameResult {
+    std::vector<CollisionManager::Contact> contacts;
+    // OnCollisionが呼ばれたオブジェクトの番号(呼ばれた順)
+    std::vector<uint32_t> dispatchOrder;
+};
+
+/// @brief 箱の中を跳ね返りながら動き回るオブジェクトを、決まった順番で作って動かす
+class Scene {
+public:
+    Scene() {
+        std::mt19937 random(97531);
+        std::uniform_real_distribution<float> distPosition(-kHalfExtent, kHalfExtent);
+        std::uniform_real_distribution<float> distVelocity(-40.0f, 40.0f);
+        std::uniform_real_distribution<float> distRadius(0.5f, 1.5f);
+        constexpr uint32_t kAttributes[] = { kPlayer, kPlayerBullet, kEnemy, kEnemyBullet, kItem };
+        constexpr uint32_t kMasks[] = {
+            kEnemy | kEnemyBullet | kItem, kEnemy, kPlayer | kPlayerBullet, kPlayer, ~0u,
+        };
+        for (uint32_t i = 0; i < kColliderCount; ++i) {
+            const uint32_t kind = i % 5;
+            const Vector3 position(distPosition(random), distPosition(random), distPosition(random));
+            colliders_.push_back(std::make_unique<TestCollider>(i, position, distRadius(random),
+                kAttributes[kind], kMasks[kind], &dispatchOrder_));
+            velocities_.emplace_back(distVelocity(random), distVelocity(random), distVelocity(random));
+        }
+    }
+
+    /// @brief 全てのオブジェクトを登録する
+    void Register(CollisionManager &manager) {
+        for (auto &collider : colliders_) {
+            manager.RegisterCollider(collider.get());
+        }
+    }
+
+    /// @brief 1フレーム分動かしてから判定する
+    FrameResult Step(CollisionManager &manager) {
+        for (size_t i = 0; i < colliders_.size(); ++i) {
+            Vector3 position = colliders_[i]->GetWorldPosition() + velocities_[i] * kDeltaTime;
+            Vector3 &velocity = velocities_[i];
+            if (position.x < -kHalfExtent || position.x > kHalfExtent) velocity.x = -velocity.x;
+            if (position.y < -kHalfExtent || position.y > kHalfExtent) velocity.y = -velocity.y;
+            if (position.z < -kHalfExtent || position.z > kHalfExtent) velocity.z = -velocity.z;
+            colliders_[i]->SetPosition(position);
+        }
+        dispatchOrder_.clear();
+        manager.Update();
+        return FrameResult{ manager.GetContacts(), dispatchOrder_ };
+    }
+
+private:
+    std::vector<std::unique_ptr<TestCollider>> colliders_;
+    std::vector<Vector3> velocities_;
+    std::vector<uint32_t> dispatchOrder_;
+};
+
+/// @brief 接触情報が全て(浮動小数点数はビット単位で)一致するか
+bool IsSameContacts(const std::vector<CollisionManager::Contact> &a, const std::vector<CollisionManager::Contact> &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        const auto &contactA = a[i];
+        const auto &contactB = b[i];
+        if (contactA.groupA != contactB.groupA || contactA.indexA != contactB.indexA ||
+            contactA.groupB != contactB.groupB || contactA.indexB != contactB.indexB ||
+            std::memcmp(&contactA.normal, &contactB.normal, sizeof(contactA.normal)) != 0 ||
+            std::memcmp(&contactA.depth, &contactB.depth, sizeof(contactA.depth)) != 0 ||
+            std::memcmp(&contactA.time, &contactB.time, sizeof(contactA.time)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief 同じ場面を指定した広域判定とスレッドの数で進め、フレームごとの結果を返す
+/// @param factory 広域判定を作る関数
+/// @param threadCount ジョブシステムのスレッドの数(0ならジョブシステムを使わない)
+/// @param outMaxCandidates 候補の組の数の最大の出力先
+std::vector<FrameResult> Run(CollisionManager::BroadphaseFactory factory, uint32_t threadCount, size_t &outMaxCandidates) {
+    std::unique_ptr<JobSystem> jobSystem = threadCount > 0 ? std::make_unique<JobSystem>(threadCount) : nullptr;
+    Scene scene;
+    CollisionManager manager;
+    manager.SetBroadphase(std::move(factory));
+    manager.SetJobSystem(jobSystem.get());
+    scene.Register(manager);
+
+    std::vector<FrameResult> results;
+    outMaxCandidates = 0;
+    for (int frame = 0; frame < kFrameCount; ++frame) {
+        results.push_back(scene.Step(manager));
+        outMaxCandidates = std::max(outMaxCandidates, manager.GetCandidatePairCount());
+    }
+    return results;
+}
+
+template <class T>
+CollisionManager::BroadphaseFactory MakeBroadphaseFactory() {
+    return []() { return std::make_unique<T>(); };
+}
+
+} // namespace
+
+KASHIPAN_TEST(Collision_ContactsAreIndependentOfThreadsAndBroadphase) {
+    size_t maxCandidates = 0;
+    const std::vector<FrameResult> expected = Run(MakeBroadphaseFactory<Math::SweepAndPruneBroadphase>(), 0, maxCandidates);
+    // 検出の範囲が複数に分かれ、スレッドの数で分け方が変わる場面になっていること
+    KASHIPAN_REQUIRE(maxCandidates > kChunkSize * 4);
+    size_t contactCount = 0;
+    for (const auto &frame : expected) {
+        contactCount += frame.contacts.size();
+    }
+    KASHIPAN_REQUIRE(contactCount > 0);
+
+    struct Config {
+        CollisionManager::BroadphaseFactory factory;
+        uint32_t threadCount;
+    };
+    const Config configs[] = {
+        { MakeBroadphaseFactory<Math::SweepAndPruneBroadphase>(), 1 },
+        { MakeBroadphaseFactory<Math::SweepAndPruneBroadphase>(), 4 },
+        { MakeBroadphaseFactory<Math::SweepAndPruneBroadphase>(), 7 },
+        { MakeBroadphaseFactory<Math::HashGridBroadphase>(), 0 },
+        { MakeBroadphaseFactory<Math::HashGridBroadphase>(), 1 },
+        { MakeBroadphaseFactory<Math::HashGridBroadphase>(), 4 },
+        { MakeBroadphaseFactory<Math::HashGridBroadphase>(), 7 },
+    };
+    for (const Config &config : configs) {
+        size_t candidates = 0;
+        const std::vector<FrameResult> actual = Run(config.factory, config.threadCount, candidates);
+        KASHIPAN_REQUIRE(actual.size() == expected.size());
+        int contactMismatches = 0;
+        int dispatchMismatches = 0;
+        for (size_t frame = 0; frame < expected.size(); ++frame) {
+            contactMismatches += IsSameContacts(actual[frame].contacts, expected[frame].contacts) ? 0 : 1;
+            dispatchMismatches += actual[frame].dispatchOrder == expected[frame].dispatchOrder ? 0 : 1;
+        }
+        KASHIPAN_EXPECT_EQ(contactMismatches, 0);
+        KASHIPAN_EXPECT_EQ(dispatchMismatches, 0);
+    }
+}
\ No newline at end of file
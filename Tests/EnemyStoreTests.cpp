@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "Easings.h"
+#include "EnemyStore.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 1フレームの時間
+constexpr float kDeltaTime = 1.0f / 60.0f;
+// 出し入れを調べる敵の数と、繰り返す回数
+constexpr uint32_t kEnemyCount = 64;
+constexpr int kRoundCount = 20;
+
+const Vector4 kColor(255.0f, 255.0f, 255.0f, 255.0f);
+
+/// @brief 番号から添字を引いた敵が、その番号で出した敵のままかを調べる
+/// @param tagById 番号ごとの、出した時に色のxに入れた値
+/// @return 食い違った数
+uint32_t CountWrongIndices(const EnemyStore &enemies, const std::vector<float> &tagById) {
+    uint32_t errors = 0;
+    for (uint32_t index = 0; index < enemies.GetCount(); ++index) {
+        const uint32_t id = enemies.GetIds()[index];
+        errors += enemies.FindIndex(id) == index ? 0 : 1;
+        errors += id < tagById.size() && enemies.GetColors()[index].x == tagById[id] ? 0 : 1;
+    }
+    // 番号ごとの添字の配列は、居る敵の数だけ添字を持つ
+    const auto indices = enemies.GetIndicesById();
+    const auto present = std::count_if(indices.begin(), indices.end(), [](uint32_t index) { return index != EnemyStore::kNoIndex; });
+    errors += static_cast<uint32_t>(present) == enemies.GetCount() ? 0 : 1;
+    return errors;
+}
+
+} // namespace
+
+KASHIPAN_TEST(Object_EnemyStoreFollowsEaseAndDiesAtEnd) {
+    const Vector3 start(-10.0f, 5.0f, 40.0f);
+    const Vector3 end(10.0f, -5.0f, 20.0f);
+    constexpr float kEaseTime = 1.0f;
+    EnemyStore enemies;
+    enemies.Spawn(start, end, EASE_IN_OUT_SINE, kEaseTime, 100.0f, 1.0f, kColor);
+
+    // 以前のEnemy::Moveと同じく、経過時間の位置へ動かしてから時間を進め、最後まで進んだら消える
+    std::vector<uint32_t> fired;
+    float timer = 0.0f;
+    Vector3 previous = start;
+    uint32_t errors = 0;
+    int frame = 0;
+    for (; frame < 600 && enemies.IsAlive(0); ++frame) {
+        enemies.Update(kDeltaTime, fired);
+        const Vector3 expected(
+            Ease::Auto(timer, kEaseTime, start.x, end.x, EASE_IN_OUT_SINE),
+            Ease::Auto(timer, kEaseTime, start.y, end.y, EASE_IN_OUT_SINE),
+            Ease::Auto(timer, kEaseTime, start.z, end.z, EASE_IN_OUT_SINE));
+        timer += kDeltaTime;
+        const Vector3 position = enemies.GetPositions()[0];
+        const Vector3 previousPosition = enemies.GetPreviousPositions()[0];
+        errors += position.x == expected.x && position.y == expected.y && position.z == expected.z ? 0 : 1;
+        errors += previousPosition.x == previous.x && previousPosition.y == previous.y && previousPosition.z == previous.z ? 0 : 1;
+        errors += enemies.IsAlive(0) == (timer < kEaseTime) ? 0 : 1;
+        previous = position;
+    }
+    KASHIPAN_EXPECT_EQ(errors, 0u);
+    // 1秒を1/60秒ずつ進めるので、60フレーム前後で消える
+    KASHIPAN_EXPECT(frame >= 60 && frame <= 61);
+    KASHIPAN_EXPECT(fired.empty());
+}
+
+KASHIPAN_TEST(Object_EnemyStoreFiresOnce) {
+    constexpr float kFireTime = 2.0f;
+    EnemyStore enemies;
+    enemies.Spawn(Vector3(0.0f), Vector3(0.0f, 0.0f, 10.0f), EASE_NONE, 10.0f, kFireTime, 1.0f, kColor);
+    enemies.Spawn(Vector3(0.0f), Vector3(0.0f, 0.0f, 10.0f), EASE_NONE, 10.0f, kFireTime * 2.0f, 1.0f, kColor);
+
+    // 以前のTimedCallと同じく、経過時間が撃つまでの時間を超えたフレームに1回だけ撃つ
+    std::vector<uint32_t> fired;
+    std::vector<int> firedFrames[2];
+    for (int frame = 0; frame < 600; ++frame) {
+        enemies.Update(kDeltaTime, fired);
+        for (uint32_t index : fired) {
+            firedFrames[index].push_back(frame);
+        }
+    }
+    KASHIPAN_REQUIRE(firedFrames[0].size() == 1);
+    KASHIPAN_REQUIRE(firedFrames[1].size() == 1);
+    // 2秒は120フレーム目(丸めでずれても1フレームまで)
+    KASHIPAN_EXPECT(firedFrames[0][0] >= 118 && firedFrames[0][0] <= 120);
+    KASHIPAN_EXPECT(firedFrames[1][0] >= 238 && firedFrames[1][0] <= 240);
+}
+
+KASHIPAN_TEST(Object_EnemyStoreIdsSurviveRemoveDead) {
+    EnemyStore enemies;
+    std::mt19937 random(1357);
+    std::vector<float> tagById;
+    std::vector<uint32_t> removedIds;
+    float nextTag = 0.0f;
+    uint32_t indexErrors = 0;
+    uint32_t reportErrors = 0;
+    for (int round = 0; round < kRoundCount; ++round) {
+        // 足りない分を出す(出すたびに違う値を色のxに入れ、番号ごとに覚えておく)
+        while (enemies.GetCount() < kEnemyCount) {
+            const uint32_t id = enemies.Spawn(Vector3(nextTag), Vector3(nextTag), EASE_NONE, 10.0f, 10.0f, 1.0f,
+                Vector4(nextTag, 0.0f, 0.0f, 255.0f));
+            if (id >= tagById.size()) {
+                tagById.resize(id + 1);
+            }
+            tagById[id] = nextTag;
+            nextTag += 1.0f;
+        }
+        indexErrors += CountWrongIndices(enemies, tagById);
+
+        // 消す敵を選び、RemoveDeadがその番号をちょうど返すかを調べる
+        std::vector<uint32_t> killedIds;
+        for (uint32_t index = 0; index < enemies.GetCount(); ++index) {
+            if (random() % 3 == 0) {
+                enemies.Kill(index);
+                killedIds.push_back(enemies.GetIds()[index]);
+            }
+        }
+        enemies.RemoveDead(removedIds);
+        std::sort(killedIds.begin(), killedIds.end());
+        std::sort(removedIds.begin(), removedIds.end());
+        reportErrors += killedIds == removedIds ? 0 : 1;
+        for (uint32_t id : removedIds) {
+            reportErrors += enemies.FindIndex(id) == EnemyStore::kNoIndex ? 0 : 1;
+        }
+        indexErrors += CountWrongIndices(enemies, tagById);
+    }
+    KASHIPAN_EXPECT_EQ(indexErrors, 0u);
+    KASHIPAN_EXPECT_EQ(reportErrors, 0u);
+    // 消えた敵の番号を使い回すので、番号は同時に居た数までしか増えない
+    KASHIPAN_EXPECT_EQ(enemies.GetIndicesById().size(), static_cast<size_t>(kEnemyCount));
+
+    enemies.Clear();
+    KASHIPAN_EXPECT_EQ(enemies.GetCount(), 0u);
+    KASHIPAN_EXPECT_EQ(enemies.FindIndex(0), EnemyStore::kNoIndex);
+}
+
+KASHIPAN_TEST(Object_EnemyStoreFindsSweptHits) {
+    constexpr float kRadius = 0.5f;
+    // 0: z=10からz=-30へ2秒かけて動く途中で、1フレームにz=10からz=-10付近まで動き、x=0の経路を横切る
+    //    (前の位置でも今の位置でも球から離れている)
+    // 1: 同じように横切るが、消える印が付いている
+    // 2: 球の経路から遠い
+    EnemyStore enemies;
+    enemies.Spawn(Vector3(0.0f, 0.0f, 10.0f), Vector3(0.0f, 0.0f, -30.0f), EASE_IN_OUT_SINE, 1.0f, 10.0f, kRadius, kColor);
+    enemies.Spawn(Vector3(0.0f, 0.0f, 10.0f), Vector3(0.0f, 0.0f, -30.0f), EASE_IN_OUT_SINE, 1.0f, 10.0f, kRadius, kColor);
+    enemies.Spawn(Vector3(30.0f, 0.0f, 0.0f), Vector3(30.0f, 0.0f, 0.0f), EASE_IN_OUT_SINE, 1.0f, 10.0f, kRadius, kColor);
+    std::vector<uint32_t> fired;
+    // 1回目は最初の位置のまま時間だけ進み、2回目で半分の時間の位置へ動く
+    enemies.Update(0.5f, fired);
+    enemies.Update(0.0f, fired);
+    KASHIPAN_REQUIRE(enemies.GetPreviousPositions()[0].z == 10.0f);
+    KASHIPAN_REQUIRE(enemies.GetPositions()[0].z < -5.0f);
+    enemies.Kill(1);
+
+    // 球は同じフレームにx=-5からx=5へ進む(今の位置だけでは当たらない)
+    std::vector<uint32_t> hits;
+    enemies.FindHits(Math::Sphere(Vector3(5.0f, 0.0f, 0.0f), kRadius), Vector3(-5.0f, 0.0f, 0.0f), hits);
+    KASHIPAN_REQUIRE(hits.size() == 1);
+    KASHIPAN_EXPECT_EQ(hits[0], 0u);
+
+    // 止まっている球は当たらない
+    enemies.FindHits(Math::Sphere(Vector3(5.0f, 0.0f, 0.0f), kRadius), Vector3(5.0f, 0.0f, 0.0f), hits);
+    KASHIPAN_EXPECT(hits.empty());
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Test.h"
+#include "Math/FastMath.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// FastMath.hに書いてある誤差の上限。これを超えたら失敗にする
+constexpr double kSinCosMaxError = 9.4e-8;
+constexpr double kAtan2MaxError = 2.0e-6;
+constexpr double kAcosMaxError = 4.4e-7;
+#ifdef KASHIPAN_MATH_SSE2
+constexpr double kRsqrtMaxRelativeError = 2.5e-7;
+#else
+constexpr double kRsqrtMaxRelativeError = 4.8e-6;
+#endif
+constexpr double kExpMaxRelativeError = 8.2e-8;
+
+// SinCosの誤差を保証する引数の範囲
+constexpr float kSinCosRange = 8192.0f;
+// 1つの関数で調べる値の数。配列版が4要素ずつの残りも通るように4の倍数にしない。
+// FastMath.hの値は全ての値で測ったものなので、ここではその一部と、最大の誤差が出た値を調べる
+constexpr size_t kSampleCount = 1000003;
+
+/// @brief minからmaxまで等間隔に並べた値
+std::vector<float> Linspace(float min, float max, size_t count) {
+    std::vector<float> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<float>(min + (static_cast<double>(max) - min) * static_cast<double>(i) / static_cast<double>(count - 1));
+    }
+    return values;
+}
+
+/// @brief 誤差の最大を記録する
+struct MaxError {
+    double value = 0.0;
+    float at = 0.0f;
+
+    void Add(double error, float x) {
+        if (error > value) {
+            value = error;
+            at = x;
+        }
+    }
+};
+
+} // namespace
+
+KASHIPAN_TEST(Math_FastSinCosWithinDocumentedError) {
+    std::vector<float> x = Linspace(-kSinCosRange, kSinCosRange, kSampleCount);
+    x.push_back(2100.9021f);
+    std::vector<float> batchSin(x.size());
+    std::vector<float> batchCos(x.size());
+    Math::Fast::SinCos(x, batchSin, batchCos);
+
+    MaxError scalarError;
+    MaxError batchError;
+    for (size_t i = 0; i < x.size(); ++i) {
+        const double referenceSin = std::sin(static_cast<double>(x[i]));
+        const double referenceCos = std::cos(static_cast<double>(x[i]));
+        float sin, cos;
+        Math::Fast::SinCos(x[i], sin, cos);
+        scalarError.Add(std::max(std::abs(sin - referenceSin), std::abs(cos - referenceCos)), x[i]);
+        scalarError.Add(std::abs(Math::Fast::Sin(x[i]) - referenceSin), x[i]);
+        scalarError.Add(std::abs(Math::Fast::Cos(x[i]) - referenceCos), x[i]);
+        batchError.Add(std::max(std::abs(batchSin[i] - referenceSin), std::abs(batchCos[i] - referenceCos)), x[i]);
+    }
+    KASHIPAN_EXPECT_NEAR(scalarError.value, 0.0, kSinCosMaxError);
+    KASHIPAN_EXPECT_NEAR(batchError.value, 0.0, kSinCosMaxError);
+}
+
+KASHIPAN_TEST(Math_FastAtan2WithinDocumentedError) {
+    // 全ての象限と軸の上(0を含む)を通るように格子状に並べる
+    const std::vector<float> values = Linspace(-10.0f, 10.0f, 1001);
+    std::vector<float> y;
+    std::vector<float> x;
+    for (float vy : values) {
+        for (float vx : values) {
+            y.push_back(vy);
+            x.push_back(vx);
+        }
+    }
+    y.push_back(1e-30f);
+    x.push_back(-1.0f);
+    std::vector<float> batch(x.size());
+    Math::Fast::Atan2(y, x, batch);
+
+    MaxError scalarError;
+    MaxError batchError;
+    for (size_t i = 0; i < x.size(); ++i) {
+        const double reference = std::atan2(static_cast<double>(y[i]), static_cast<double>(x[i]));
+        scalarError.Add(std::abs(Math::Fast::Atan2(y[i], x[i]) - reference), y[i]);
+        batchError.Add(std::abs(batch[i] - reference), y[i]);
+    }
+    KASHIPAN_EXPECT_NEAR(scalarError.value, 0.0, kAtan2MaxError);
+    KASHIPAN_EXPECT_NEAR(batchError.value, 0.0, kAtan2MaxError);
+}
+
+KASHIPAN_TEST(Math_FastAcosWithinDocumentedError) {
+    std::vector<float> x = Linspace(-1.0f, 1.0f, kSampleCount);
+    x.push_back(-0.469560236f);
+    std::vector<float> batch(x.size());
+    Math::Fast::Acos(x, batch);
+
+    MaxError scalarError;
+    MaxError batchError;
+    for (size_t i = 0; i < x.size(); ++i) {
+        const double reference = std::acos(static_cast<double>(x[i]));
+        scalarError.Add(std::abs(Math::Fast::Acos(x[i]) - reference), x[i]);
+        batchError.Add(std::abs(batch[i] - reference), x[i]);
+    }
+    KASHIPAN_EXPECT_NEAR(scalarError.value, 0.0, kAcosMaxError);
+    KASHIPAN_EXPECT_NEAR(batchError.value, 0.0, kAcosMaxError);
+
+    // 範囲外の入力は[-1, 1]に丸める
+    KASHIPAN_EXPECT_NEAR(Math::Fast::Acos(1.5f), 0.0, kAcosMaxError);
+    KASHIPAN_EXPECT_NEAR(Math::Fast::Acos(-1.5f), std::acos(-1.0), kAcosMaxError);
+}
+
+KASHIPAN_TEST(Math_FastRsqrtWithinDocumentedError) {
+    // 仮数の全体を、2^-40～2^40の指数で調べる
+    std::vector<float> x(kSampleCount);
+    for (size_t i = 0; i < x.size(); ++i) {
+        const float mantissa = 1.0f + static_cast<float>(i) / static_cast<float>(x.size());
+        x[i] = std::ldexp(mantissa, static_cast<int>(i % 81) - 40);
+    }
+    x.push_back(3.36648814e+38f);
+    std::vector<float> batch(x.size());
+    Math::Fast::Rsqrt(x, batch);
+
+    MaxError scalarError;
+    MaxError batchError;
+    for (size_t i = 0; i < x.size(); ++i) {
+        const double reference = 1.0 / std::sqrt(static_cast<double>(x[i]));
+        scalarError.Add(std::abs(Math::Fast::Rsqrt(x[i]) - reference) / reference, x[i]);
+        batchError.Add(std::abs(batch[i] - reference) / reference, x[i]);
+    }
+    KASHIPAN_EXPECT_NEAR(scalarError.value, 0.0, kRsqrtMaxRelativeError);
+    KASHIPAN_EXPECT_NEAR(batchError.value, 0.0, kRsqrtMaxRelativeError);
+}
+
+KASHIPAN_TEST(Math_FastExpWithinDocumentedError) {
+    std::vector<float> x = Linspace(-87.3f, 88.3f, kSampleCount);
+    x.push_back(15.5968428f);
+    std::vector<float> batch(x.size());
+    Math::Fast::Exp(x, batch);
+
+    MaxError scalarError;
+    MaxError batchError;
+    for (size_t i = 0; i < x.size(); ++i) {
+        const double reference = std::exp(static_cast<double>(x[i]));
+        scalarError.Add(std::abs(Math::Fast::Exp(x[i]) - reference) / reference, x[i]);
+        batchError.Add(std::abs(batch[i] - reference) / reference, x[i]);
+    }
+    KASHIPAN_EXPECT_NEAR(scalarError.value, 0.0, kExpMaxRelativeError);
+    KASHIPAN_EXPECT_NEAR(batchError.value, 0.0, kExpMaxRelativeError);
+
+    // 範囲外の入力は端の値に丸める(無限大や0にならない)
+    KASHIPAN_EXPECT(std::isfinite(Math::Fast::Exp(1000.0f)));
+    KASHIPAN_EXPECT(Math::Fast::Exp(-1000.0f) > 0.0f);
+}
+
+KASHIPAN_TEST(Math_GameplayUsesSelectedImplementation) {
+    // KASHIPAN_FAST_MATHが0(既定)なら標準ライブラリと、1なら近似版と完全に一致する
+    const std::vector<float> x = Linspace(-4.0f, 4.0f, 1001);
+    for (float v : x) {
+#if KASHIPAN_FAST_MATH
+        KASHIPAN_EXPECT_EQ(Math::Gameplay::Sin(v), Math::Fast::Sin(v));
+        KASHIPAN_EXPECT_EQ(Math::Gameplay::Atan2(v, 1.0f), Math::Fast::Atan2(v, 1.0f));
+        KASHIPAN_EXPECT_EQ(Math::Gameplay::Exp(v), Math::Fast::Exp(v));
+#else
+        KASHIPAN_EXPECT_EQ(Math::Gameplay::Sin(v), std::sin(v));
+        KASHIPAN_EXPECT_EQ(Math::Gameplay::Atan2(v, 1.0f), std::atan2(v, 1.0f));
+        KASHIPAN_EXPECT_EQ(Math::Gameplay::Exp(v), std::exp(v));
+#endif
+    }
+}
\ No newline at end of file
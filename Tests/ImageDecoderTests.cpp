@@ -0,0 +1,409 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Test.h"
+#include "Common/ImageDecoder.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief ピクセルデータのFNV-1aハッシュ(参照のデコード結果と比べる)
+uint64_t HashPixels(const std::vector<uint8_t> &pixels) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (uint8_t value : pixels) {
+        hash ^= value;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/// @brief Resources以下の画像と、別の実装(zlibでの展開とフィルタ解除を別に書いたもの)でデコードした結果
+struct ReferenceImage {
+    const char *path;
+    uint32_t width;
+    uint32_t height;
+    uint64_t pixelHash;
+};
+constexpr ReferenceImage kReferenceImages[] = {
+    { "reticle.png",              128,  128,  0x9b953bc616904a50ull },
+    { "target_reticle.png",       128,  128,  0x93e32f1d24406b5dull },
+    { "uvChecker.png",            512,  512,  0xebb9bf2dd80e1459ull },
+    { "white1x1.png",             1,    1,    0x994f76653e2a3951ull },
+    { "Bullet/bullet.png",        512,  512,  0xebb9bf2dd80e1459ull },
+    { "Enemy/enemy.png",          512,  512,  0xebb9bf2dd80e1459ull },
+    { "Skydome/skydome.png",      2160, 1080, 0x9c1fde2191b47109ull },
+    { "Ground/perlin_noise.bmp",  200,  200,  0x5010c528a3504c5dull },
+};
+
+//--------- テスト用のPNG・BMPを作る ---------//
+
+void AppendBigEndian32(std::vector<uint8_t> &out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void AppendLittleEndian(std::vector<uint8_t> &out, uint32_t value, int byteCount) {
+    for (int i = 0; i < byteCount; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+uint32_t Crc32(const uint8_t *data, size_t size) {
+    uint32_t crc = 0xffffffffu;
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+void AppendChunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data) {
+    AppendBigEndian32(out, static_cast<uint32_t>(data.size()));
+    const size_t typeOffset = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    AppendBigEndian32(out, Crc32(out.data() + typeOffset, out.size() - typeOffset));
+}
+
+/// @brief 無圧縮のブロックだけでzlib形式にする(blockSizeごとにブロックを分ける)
+std::vector<uint8_t> StoreZlib(const std::vector<uint8_t> &data, size_t blockSize) {
+    std::vector<uint8_t> out = { 0x78, 0x01 };
+    size_t offset = 0;
+    do {
+        const size_t size = std::min(blockSize, data.size() - offset);
+        const bool isLast = offset + size == data.size();
+        out.push_back(isLast ? 1 : 0);
+        AppendLittleEndian(out, static_cast<uint32_t>(size), 2);
+        AppendLittleEndian(out, static_cast<uint32_t>(~size & 0xffff), 2);
+        out.insert(out.end(), data.begin() + offset, data.begin() + offset + size);
+        offset += size;
+    } while (offset < data.size());
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (uint8_t value : data) {
+        a = (a + value) % 65521;
+        b = (b + a) % 65521;
+    }
+    AppendBigEndian32(out, (b << 16) | a);
+    return out;
+}
+
+uint8_t Paeth(int a, int b, int c) {
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    return static_cast<uint8_t>(pa <= pb && pa <= pc ? a : (pb <= pc ? b : c));
+}
+
+/// @brief テスト用のPNGの中身
+struct PngSource {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint8_t bitDepth = 8;
+    uint8_t colorType = 6;
+    // ピクセルごとのサンプル(チャンネル数 * 幅 * 高さ)
+    std::vector<uint8_t> samples;
+    std::vector<std::array<uint8_t, 3>> palette;
+    std::vector<uint8_t> transparency;
+
+    uint32_t GetChannelCount() const {
+        return colorType == 2 ? 3 : colorType == 4 ? 2 : colorType == 6 ? 4 : 1;
+    }
+};
+
+/// @brief 行ごとにフィルタの種類を変えながらPNGにする
+std::vector<uint8_t> EncodePng(const PngSource &source) {
+    const uint32_t channelCount = source.GetChannelCount();
+    const size_t bitsPerPixel = static_cast<size_t>(channelCount) * source.bitDepth;
+    const size_t rowBytes = (source.width * bitsPerPixel + 7) / 8;
+    const size_t bpp = std::max<size_t>(1, bitsPerPixel / 8);
+
+    std::vector<uint8_t> raw;
+    std::vector<uint8_t> previous(rowBytes, 0);
+    for (uint32_t y = 0; y < source.height; ++y) {
+        // サンプルを行のバイト列に詰める(8bit未満は上位ビットから)
+        std::vector<uint8_t> row(rowBytes, 0);
+        const size_t rowSampleOffset = static_cast<size_t>(y) * source.width * channelCount;
+        for (size_t i = 0; i < static_cast<size_t>(source.width) * channelCount; ++i) {
+            const uint8_t sample = source.samples[rowSampleOffset + i];
+            if (source.bitDepth == 8) {
+                row[i] = sample;
+            } else {
+                const size_t bitOffset = i * source.bitDepth;
+                row[bitOffset / 8] |= static_cast<uint8_t>(sample << (8 - source.bitDepth - bitOffset % 8));
+            }
+        }
+        const uint8_t filter = static_cast<uint8_t>(y % 5);
+        raw.push_back(filter);
+        for (size_t i = 0; i < rowBytes; ++i) {
+            const int a = i >= bpp ? row[i - bpp] : 0;
+            const int b = previous[i];
+            const int c = i >= bpp ? previous[i - bpp] : 0;
+            int predictor = 0;
+            switch (filter) {
+                case 1: predictor = a; break;
+                case 2: predictor = b; break;
+                case 3: predictor = (a + b) / 2; break;
+                case 4: predictor = Paeth(a, b, c); break;
+            }
+            raw.push_back(static_cast<uint8_t>(row[i] - predictor));
+        }
+        previous = row;
+    }
+
+    std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    std::vector<uint8_t> header;
+    AppendBigEndian32(header, source.width);
+    AppendBigEndian32(header, source.height);
+    header.insert(header.end(), { source.bitDepth, source.colorType, 0, 0, 0 });
+    AppendChunk(png, "IHDR", header);
+    if (!source.palette.empty()) {
+        std::vector<uint8_t> palette;
+        for (const auto &color : source.palette) {
+            palette.insert(palette.end(), color.begin(), color.end());
+        }
+        AppendChunk(png, "PLTE", palette);
+    }
+    if (!source.transparency.empty()) {
+        AppendChunk(png, "tRNS", source.transparency);
+    }
+    // IDATは2つに分けて、つなげて展開できるかも調べる
+    const std::vector<uint8_t> compressed = StoreZlib(raw, 1000);
+    const size_t half = compressed.size() / 2;
+    AppendChunk(png, "IDAT", std::vector<uint8_t>(compressed.begin(), compressed.begin() + half));
+    AppendChunk(png, "IDAT", std::vector<uint8_t>(compressed.begin() + half, compressed.end()));
+    AppendChunk(png, "IEND", {});
+    return png;
+}
+
+/// @brief PNGの仕様どおりにRGBA8へ変換した結果
+std::vector<uint8_t> ExpectedRgba(const PngSource &source) {
+    const uint32_t channelCount = source.GetChannelCount();
+    const uint32_t maxSample = (1u << source.bitDepth) - 1;
+    std::vector<uint8_t> pixels;
+    for (size_t i = 0; i < static_cast<size_t>(source.width) * source.height; ++i) {
+        const uint8_t *s = source.samples.data() + i * channelCount;
+        switch (source.colorType) {
+            case 0: {
+                const uint8_t value = static_cast<uint8_t>(s[0] * 255 / maxSample);
+                const bool isTransparent = source.transparency.size() >= 2 && s[0] == source.transparency[1];
+                pixels.insert(pixels.end(), { value, value, value, static_cast<uint8_t>(isTransparent ? 0 : 255) });
+                break;
+            }
+            case 2: {
+                const bool isTransparent = source.transparency.size() >= 6 &&
+                    s[0] == source.transparency[1] && s[1] == source.transparency[3] && s[2] == source.transparency[5];
+                pixels.insert(pixels.end(), { s[0], s[1], s[2], static_cast<uint8_t>(isTransparent ? 0 : 255) });
+                break;
+            }
+            case 3: {
+                const auto &color = source.palette[s[0]];
+                const uint8_t alpha = s[0] < source.transparency.size() ? source.transparency[s[0]] : 255;
+                pixels.insert(pixels.end(), { color[0], color[1], color[2], alpha });
+                break;
+            }
+            case 4:
+                pixels.insert(pixels.end(), { s[0], s[0], s[0], s[1] });
+                break;
+            case 6:
+                pixels.insert(pixels.end(), { s[0], s[1], s[2], s[3] });
+                break;
+        }
+    }
+    return pixels;
+}
+
+/// @brief ランダムなサンプルでテスト用のPNGの中身を作る
+PngSource MakePngSource(uint8_t colorType, uint8_t bitDepth, uint32_t width, uint32_t height, std::mt19937 &random) {
+    PngSource source;
+    source.width = width;
+    source.height = height;
+    source.bitDepth = bitDepth;
+    source.colorType = colorType;
+    const uint32_t maxSample = (1u << bitDepth) - 1;
+    if (colorType == 3) {
+        // パレットの数はビット深度で表せる数より少なくし、tRNSも一部の色だけに付ける
+        const uint32_t paletteCount = std::min(maxSample + 1, 200u);
+        for (uint32_t i = 0; i < paletteCount; ++i) {
+            source.palette.push_back({ static_cast<uint8_t>(random()), static_cast<uint8_t>(random()), static_cast<uint8_t>(random()) });
+        }
+        for (uint32_t i = 0; i < paletteCount / 2; ++i) {
+            source.transparency.push_back(static_cast<uint8_t>(random()));
+        }
+        std::uniform_int_distribution<uint32_t> distIndex(0, paletteCount - 1);
+        for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i) {
+            source.samples.push_back(static_cast<uint8_t>(distIndex(random)));
+        }
+        return source;
+    }
+    // 値の種類を少なくして、透明色に一致するピクセルが出るようにする
+    std::uniform_int_distribution<uint32_t> distSample(0, maxSample);
+    for (size_t i = 0; i < static_cast<size_t>(width) * height * source.GetChannelCount(); ++i) {
+        const uint32_t sample = distSample(random);
+        source.samples.push_back(static_cast<uint8_t>(bitDepth == 8 ? sample & 0xf3 : sample));
+    }
+    if (colorType == 0) {
+        source.transparency = { 0, source.samples[0] };
+    } else if (colorType == 2) {
+        source.transparency = { 0, source.samples[0], 0, source.samples[1], 0, source.samples[2] };
+    }
+    return source;
+}
+
+/// @brief BMPを作る(24bitか32bit。heightが負なら上の行から)
+std::vector<uint8_t> EncodeBmp(const std::vector<uint8_t> &rgba, uint32_t width, int32_t height, uint16_t bitCount,
+    bool useAlphaMask) {
+    const uint32_t absHeight = static_cast<uint32_t>(std::abs(height));
+    const size_t pixelBytes = bitCount / 8;
+    const size_t stride = (width * pixelBytes + 3) & ~size_t(3);
+    const uint32_t infoSize = useAlphaMask ? 56 : 40;
+    const uint32_t pixelOffset = 14 + infoSize;
+
+    std::vector<uint8_t> bmp = { 'B', 'M' };
+    AppendLittleEndian(bmp, static_cast<uint32_t>(pixelOffset + stride * absHeight), 4);
+    AppendLittleEndian(bmp, 0, 4);
+    AppendLittleEndian(bmp, pixelOffset, 4);
+    AppendLittleEndian(bmp, infoSize, 4);
+    AppendLittleEndian(bmp, width, 4);
+    AppendLittleEndian(bmp, static_cast<uint32_t>(height), 4);
+    AppendLittleEndian(bmp, 1, 2);
+    AppendLittleEndian(bmp, bitCount, 2);
+    AppendLittleEndian(bmp, useAlphaMask ? 3 : 0, 4);
+    AppendLittleEndian(bmp, static_cast<uint32_t>(stride * absHeight), 4);
+    AppendLittleEndian(bmp, 2835, 4);
+    AppendLittleEndian(bmp, 2835, 4);
+    AppendLittleEndian(bmp, 0, 4);
+    AppendLittleEndian(bmp, 0, 4);
+    if (useAlphaMask) {
+        AppendLittleEndian(bmp, 0x00ff0000, 4);
+        AppendLittleEndian(bmp, 0x0000ff00, 4);
+        AppendLittleEndian(bmp, 0x000000ff, 4);
+        AppendLittleEndian(bmp, 0xff000000, 4);
+    }
+    for (uint32_t row = 0; row < absHeight; ++row) {
+        const uint32_t y = height < 0 ? row : absHeight - 1 - row;
+        const size_t rowStart = bmp.size();
+        for (uint32_t x = 0; x < width; ++x) {
+            const uint8_t *pixel = rgba.data() + (static_cast<size_t>(y) * width + x) * 4;
+            bmp.insert(bmp.end(), { pixel[2], pixel[1], pixel[0] });
+            if (bitCount == 32) {
+                bmp.push_back(pixel[3]);
+            }
+        }
+        bmp.resize(rowStart + stride, 0);
+    }
+    return bmp;
+}
+
+} // namespace
+
+KASHIPAN_TEST(Texture_DecodeResourceImagesMatchReference) {
+    for (const ReferenceImage &reference : kReferenceImages) {
+        DecodedImage image;
+        const std::string path = std::string(KASHIPAN_RESOURCE_DIRECTORY) + "/" + reference.path;
+        if (!KASHIPAN_EXPECT(ImageDecoder::LoadFromFile(path, image))) {
+            std::printf("  %s\n", reference.path);
+            continue;
+        }
+        KASHIPAN_EXPECT_EQ(image.width, reference.width);
+        KASHIPAN_EXPECT_EQ(image.height, reference.height);
+        KASHIPAN_EXPECT_EQ(image.pixels.size(), static_cast<size_t>(reference.width) * reference.height * 4);
+        if (!KASHIPAN_EXPECT_EQ(HashPixels(image.pixels), reference.pixelHash)) {
+            std::printf("  %s\n", reference.path);
+        }
+    }
+}
+
+KASHIPAN_TEST(Texture_DecodePngEveryColorTypeAndFilter) {
+    struct Format {
+        uint8_t colorType;
+        uint8_t bitDepth;
+    };
+    constexpr Format kFormats[] = {
+        { 0, 1 }, { 0, 2 }, { 0, 4 }, { 0, 8 },
+        { 2, 8 },
+        { 3, 1 }, { 3, 2 }, { 3, 4 }, { 3, 8 },
+        { 4, 8 },
+        { 6, 8 },
+    };
+    std::mt19937 random(2468);
+    for (const Format &format : kFormats) {
+        // 幅は1バイトに収まらない半端な値にして、行末の詰め方も調べる
+        const PngSource source = MakePngSource(format.colorType, format.bitDepth, 37, 23, random);
+        const std::vector<uint8_t> png = EncodePng(source);
+        DecodedImage image;
+        if (!KASHIPAN_EXPECT(ImageDecoder::Decode(png.data(), png.size(), image))) {
+            std::printf("  colorType=%d bitDepth=%d\n", format.colorType, format.bitDepth);
+            continue;
+        }
+        KASHIPAN_EXPECT_EQ(image.width, source.width);
+        KASHIPAN_EXPECT_EQ(image.height, source.height);
+        if (!KASHIPAN_EXPECT(image.pixels == ExpectedRgba(source))) {
+            std::printf("  colorType=%d bitDepth=%d\n", format.colorType, format.bitDepth);
+        }
+    }
+}
+
+KASHIPAN_TEST(Texture_DecodeBmpLayouts) {
+    struct Layout {
+        uint16_t bitCount;
+        bool isTopDown;
+        bool useAlphaMask;
+    };
+    constexpr Layout kLayouts[] = {
+        { 24, false, false }, { 24, true, false },
+        { 32, false, false }, { 32, true, false },
+        { 32, false, true },
+    };
+    std::mt19937 random(1357);
+    // 幅は行末に詰め物が入る値にする
+    constexpr uint32_t kWidth = 13;
+    constexpr uint32_t kHeight = 7;
+    std::vector<uint8_t> rgba(kWidth * kHeight * 4);
+    for (uint8_t &value : rgba) {
+        value = static_cast<uint8_t>(random());
+    }
+    for (const Layout &layout : kLayouts) {
+        const std::vector<uint8_t> bmp = EncodeBmp(rgba, kWidth,
+            layout.isTopDown ? -static_cast<int32_t>(kHeight) : static_cast<int32_t>(kHeight), layout.bitCount, layout.useAlphaMask);
+        DecodedImage image;
+        KASHIPAN_REQUIRE(ImageDecoder::Decode(bmp.data(), bmp.size(), image));
+        KASHIPAN_EXPECT_EQ(image.width, kWidth);
+        KASHIPAN_EXPECT_EQ(image.height, kHeight);
+        // アルファのマスクが無ければ不透明として読む
+        std::vector<uint8_t> expected = rgba;
+        if (!layout.useAlphaMask) {
+            for (size_t i = 3; i < expected.size(); i += 4) {
+                expected[i] = 255;
+            }
+        }
+        if (!KASHIPAN_EXPECT(image.pixels == expected)) {
+            std::printf("  bitCount=%d topDown=%d alphaMask=%d\n", layout.bitCount, layout.isTopDown, layout.useAlphaMask);
+        }
+    }
+}
+
+KASHIPAN_TEST(Texture_DecodeRejectsBrokenData) {
+    std::mt19937 random(97531);
+    const PngSource source = MakePngSource(6, 8, 16, 16, random);
+    std::vector<uint8_t> png = EncodePng(source);
+    DecodedImage image;
+    // 途中で切れたデータは読まない
+    for (size_t size : { size_t(0), size_t(8), size_t(33), png.size() / 2, png.size() - 13 }) {
+        KASHIPAN_EXPECT(!ImageDecoder::Decode(png.data(), size, image));
+    }
+    // 未対応の形式(インターレース)は読まない
+    png[8 + 8 + 12] = 1;
+    KASHIPAN_EXPECT(!ImageDecoder::Decode(png.data(), png.size(), image));
+}
\ No newline at end of file
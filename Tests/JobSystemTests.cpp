@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "Test.h"
+#include "Common/JobSystem.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// スレッドの数(コアが少ない環境でも取り合いが起きるように4以上にする)
+const uint32_t kStressThreadCount = std::max(std::thread::hardware_concurrency(), 4u);
+// カウンタを作り直して調べる回数
+constexpr int kReuseCount = 20000;
+// 取り合いのタイミングを変えて同じ調べ方を繰り返す回数
+constexpr int kRoundCount = 20;
+
+// ParallelForで調べる要素の数
+constexpr uint32_t kElementCount = 100000;
+// 入れ子のParallelForの外側と内側の数
+constexpr uint32_t kOuterCount = 64;
+constexpr uint32_t kInnerCount = 1000;
+// 依存関係でつないだジョブの列の数と長さ
+constexpr uint32_t kChainCount = 64;
+constexpr uint32_t kChainLength = 16;
+// 小さいジョブの数
+constexpr uint32_t kSmallJobCount = 10000;
+// 1つのスレッドの結果と比べる要素の数
+constexpr uint32_t kResultElementCount = 1u << 14;
+
+/// @brief 1回も実行されなかったか、2回以上実行された要素の数
+uint32_t CountNotOnce(const std::vector<uint32_t> &visits) {
+    return static_cast<uint32_t>(std::count_if(visits.begin(), visits.end(), [](uint32_t v) { return v != 1; }));
+}
+
+/// @brief 範囲が全ての要素をちょうど1回ずつ覆い、grainSizeより大きい範囲が無いかを調べる
+/// @return 食い違った数
+uint32_t CountCoverageErrors(uint32_t grainSize) {
+    JobSystem jobSystem(kStressThreadCount);
+    std::vector<uint32_t> visits(kElementCount);
+    std::atomic<uint32_t> oversizedRanges = 0;
+    uint32_t errors = 0;
+    for (int round = 0; round < kRoundCount; ++round) {
+        std::fill(visits.begin(), visits.end(), 0u);
+        jobSystem.ParallelFor(0, kElementCount, grainSize, [&](uint32_t begin, uint32_t end) {
+            if (end - begin > grainSize) {
+                oversizedRanges.fetch_add(1, std::memory_order_relaxed);
+            }
+            for (uint32_t i = begin; i < end; ++i) {
+                ++visits[i];
+            }
+            });
+        errors += CountNotOnce(visits);
+    }
+    return errors + oversizedRanges.load();
+}
+
+/// @brief 要素ごとに結果が決まる計算
+float Work(uint32_t index) {
+    float value = static_cast<float>(index) * 0.001f;
+    for (int i = 0; i < 8; ++i) {
+        value = std::sin(value) * 0.5f + std::cos(value * 1.3f) * 0.5f + 0.01f;
+    }
+    return value;
+}
+
+} // namespace
+
+KASHIPAN_TEST(JobSystem_DependentsWaitForCounterAtReusedAddress) {
+    JobSystem jobSystem(kStressThreadCount);
+    // 依存するカウンタが0になるのを待っているジョブを常に残し、0になったカウンタごとに待っているジョブを探させる
+    std::atomic<bool> isStopping = false;
+    JobSystem::Counter gate;
+    JobSystem::Counter parked;
+    jobSystem.Run([&]() {
+        while (!isStopping.load()) {
+            std::this_thread::yield();
+        }
+        }, gate);
+    jobSystem.Run([]() {}, parked, &gate);
+
+    // 同じアドレスにカウンタを作り直す
+    std::optional<JobSystem::Counter> counter;
+    uint32_t earlyRunCount = 0;
+    for (int i = 0; i < kReuseCount; ++i) {
+        // ワーカーに0にさせ、Finishの途中でも0になったらすぐに破棄する
+        counter.emplace();
+        jobSystem.Run([]() {}, *counter);
+        while (!counter->IsDone()) {
+            std::this_thread::yield();
+        }
+        counter.reset();
+
+        // 同じアドレスの新しいカウンタに依存するジョブは、そのカウンタのジョブが終わるまで実行されない
+        counter.emplace();
+        std::atomic<bool> isReleased = false;
+        std::atomic<bool> isProduced = false;
+        std::atomic<bool> isEarly = false;
+        jobSystem.Run([&]() {
+            while (!isReleased.load()) {
+                std::this_thread::yield();
+            }
+            isProduced.store(true);
+            }, *counter);
+        JobSystem::Counter dependent;
+        jobSystem.Run([&]() { isEarly.store(!isProduced.load()); }, dependent, &*counter);
+        isReleased.store(true);
+        jobSystem.Wait(*counter);
+        jobSystem.Wait(dependent);
+        counter.reset();
+        earlyRunCount += isEarly.load() ? 1 : 0;
+    }
+    KASHIPAN_EXPECT_EQ(earlyRunCount, 0u);
+
+    isStopping.store(true);
+    jobSystem.Wait(gate);
+    jobSystem.Wait(parked);
+}
+
+KASHIPAN_TEST(JobSystem_ParallelForCoversEveryElementOnce) {
+    for (uint32_t grainSize : { 1u, 7u, 1000u }) {
+        KASHIPAN_EXPECT_EQ(CountCoverageErrors(grainSize), 0u);
+    }
+}
+
+KASHIPAN_TEST(JobSystem_NestedParallelForRunsEveryElementOnce) {
+    // ジョブの中からParallelForを呼んでも止まらずに全て実行される
+    JobSystem jobSystem(kStressThreadCount);
+    std::vector<uint32_t> visits(kOuterCount * kInnerCount);
+    uint32_t errors = 0;
+    for (int round = 0; round < kRoundCount; ++round) {
+        std::fill(visits.begin(), visits.end(), 0u);
+        jobSystem.ParallelFor(0, kOuterCount, 1, [&](uint32_t outerBegin, uint32_t outerEnd) {
+            for (uint32_t outer = outerBegin; outer < outerEnd; ++outer) {
+                jobSystem.ParallelFor(0, kInnerCount, 16, [&, outer](uint32_t begin, uint32_t end) {
+                    for (uint32_t inner = begin; inner < end; ++inner) {
+                        ++visits[outer * kInnerCount + inner];
+                    }
+                    });
+            }
+            });
+        errors += CountNotOnce(visits);
+    }
+    KASHIPAN_EXPECT_EQ(errors, 0u);
+}
+
+KASHIPAN_TEST(JobSystem_DependentJobsRunInOrder) {
+    JobSystem jobSystem(kStressThreadCount);
+    std::vector<uint32_t> steps(kChainCount);
+    std::atomic<uint32_t> outOfOrder = 0;
+    uint32_t unfinished = 0;
+    for (int round = 0; round < kRoundCount; ++round) {
+        std::fill(steps.begin(), steps.end(), 0u);
+        std::vector<JobSystem::Counter> counters(kChainCount * kChainLength);
+        // 積んでいる間にも前のジョブが実行されるので、依存先がまだ終わっていない場合と終わった場合の両方を通る
+        for (uint32_t s = 0; s < kChainLength; ++s) {
+            for (uint32_t c = 0; c < kChainCount; ++c) {
+                const JobSystem::Counter *dependency = s > 0 ? &counters[c * kChainLength + s - 1] : nullptr;
+                jobSystem.Run([&, c, s]() {
+                    if (steps[c] != s) {
+                        outOfOrder.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    steps[c] = s + 1;
+                    }, counters[c * kChainLength + s], dependency);
+            }
+        }
+        // 列の途中のジョブも全て終わってからカウンタを破棄する
+        for (const JobSystem::Counter &counter : counters) {
+            jobSystem.Wait(counter);
+        }
+        unfinished += static_cast<uint32_t>(std::count_if(steps.begin(), steps.end(), [](uint32_t s) { return s != kChainLength; }));
+    }
+    KASHIPAN_EXPECT_EQ(outOfOrder.load(), 0u);
+    KASHIPAN_EXPECT_EQ(unfinished, 0u);
+}
+
+KASHIPAN_TEST(JobSystem_SmallJobsRunOnce) {
+    JobSystem jobSystem(kStressThreadCount);
+    std::vector<uint32_t> visits(kSmallJobCount);
+    uint32_t errors = 0;
+    for (int round = 0; round < kRoundCount; ++round) {
+        std::fill(visits.begin(), visits.end(), 0u);
+        JobSystem::Counter counter;
+        // 半分はジョブの中から積む
+        for (uint32_t i = 0; i < kSmallJobCount; i += 2) {
+            jobSystem.Run([&, i]() {
+                ++visits[i];
+                jobSystem.Run([&, i]() { ++visits[i + 1]; }, counter);
+                }, counter);
+        }
+        jobSystem.Wait(counter);
+        errors += CountNotOnce(visits);
+    }
+    KASHIPAN_EXPECT_EQ(errors, 0u);
+}
+
+KASHIPAN_TEST(JobSystem_ParallelForMatchesSerial) {
+    std::vector<float> expected(kResultElementCount);
+    for (uint32_t i = 0; i < kResultElementCount; ++i) {
+        expected[i] = Work(i);
+    }
+    for (uint32_t threadCount : { 1u, 2u, 4u, 8u }) {
+        JobSystem jobSystem(threadCount);
+        std::vector<float> results(kResultElementCount);
+        jobSystem.ParallelFor(0, kResultElementCount, 256, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                results[i] = Work(i);
+            }
+            });
+        KASHIPAN_EXPECT(results == expected);
+    }
+}
\ No newline at end of file
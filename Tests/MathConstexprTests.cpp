@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "Test.h"
+#include "Math/Matrix4x4.h"
+#include "Math/Quaternion.h"
+#include "Math/Vector3.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 値は2のべき乗や小さい整数にして、コンパイル時の計算でも誤差無く比べられるようにする
+constexpr Vector3 kA(1.0f, 2.0f, 3.0f);
+constexpr Vector3 kB(4.0f, -5.0f, 6.0f);
+constexpr Vector3 kScale(2.0f, 4.0f, 0.5f);
+constexpr Vector3 kTranslate(10.0f, -3.0f, 7.0f);
+// z軸周りに180度回転するクォータニオン
+constexpr Quaternion kRotateZ180(0.0f, 0.0f, 1.0f, 0.0f);
+
+/// @brief 2つの行列の全ての要素が一致するか
+constexpr bool IsSameMatrix(const Matrix4x4 &a, const Matrix4x4 &b) {
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            if (a.m[row][column] != b.m[row][column]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// @brief 拡大縮小・回転・平行移動を個別の行列の積で作る
+constexpr Matrix4x4 ComposeAffine(const Vector3 &scale, const Quaternion &rotate, const Vector3 &translate) {
+    Matrix4x4 scaleMatrix{};
+    scaleMatrix.MakeScale(scale);
+    Matrix4x4 translateMatrix{};
+    translateMatrix.MakeTranslate(translate);
+    return scaleMatrix * rotate.ToMatrix() * translateMatrix;
+}
+
+/// @brief MakeAffineでアフィン行列を作る
+constexpr Matrix4x4 MakeAffine(const Vector3 &scale, const Quaternion &rotate, const Vector3 &translate) {
+    Matrix4x4 matrix{};
+    matrix.MakeAffine(scale, rotate, translate);
+    return matrix;
+}
+
+//==================================================
+// Vector3
+//==================================================
+
+static_assert(kA + kB == Vector3(5.0f, -3.0f, 9.0f));
+static_assert(kA - kB == Vector3(-3.0f, 7.0f, -3.0f));
+static_assert(kA * 2.0f == Vector3(2.0f, 4.0f, 6.0f));
+static_assert(-kA == Vector3(-1.0f, -2.0f, -3.0f));
+static_assert(kA.Dot(kB) == 12.0f);
+static_assert(kA.Cross(kB) == Vector3(27.0f, 6.0f, -13.0f));
+static_assert(kA.Cross(kB).Dot(kA) == 0.0f && kA.Cross(kB).Dot(kB) == 0.0f);
+static_assert(kA.LengthSquared() == 14.0f);
+static_assert(Vector3::Lerp(kA, kB, 0.5f) == Vector3(2.5f, -1.5f, 4.5f));
+
+//==================================================
+// Matrix4x4
+//==================================================
+
+constexpr Matrix4x4 kAffine = MakeAffine(kScale, kRotateZ180, kTranslate);
+
+static_assert(IsSameMatrix(Matrix4x4::Identity() * kAffine, kAffine));
+static_assert(IsSameMatrix(kAffine * Matrix4x4::Identity(), kAffine));
+static_assert(kAffine.Determinant() == kScale.x * kScale.y * kScale.z);
+static_assert(IsSameMatrix(kAffine * kAffine.Inverse(), Matrix4x4::Identity()));
+static_assert(IsSameMatrix(kAffine.InverseAffine(), kAffine.Inverse()));
+
+// 行ベクトルに右から掛けるので、拡大縮小・回転・平行移動の順に適用される
+static_assert(Vector3(1.0f, 1.0f, 2.0f).Transform(kAffine) == Vector3(8.0f, -7.0f, 8.0f));
+static_assert(Vector3(1.0f, 1.0f, 2.0f).TransformDirection(kAffine) == Vector3(-2.0f, -4.0f, 1.0f));
+
+//==================================================
+// MakeAffine
+//==================================================
+
+static_assert(IsSameMatrix(kAffine, ComposeAffine(kScale, kRotateZ180, kTranslate)));
+static_assert(IsSameMatrix(MakeAffine({ 1.0f, 1.0f, 1.0f }, Quaternion::Identity(), { 0.0f, 0.0f, 0.0f }), Matrix4x4::Identity()));
+static_assert(kAffine.m[3][0] == kTranslate.x && kAffine.m[3][1] == kTranslate.y && kAffine.m[3][2] == kTranslate.z);
+static_assert(kAffine.m[0][3] == 0.0f && kAffine.m[1][3] == 0.0f && kAffine.m[2][3] == 0.0f && kAffine.m[3][3] == 1.0f);
+
+//==================================================
+// ランダムな行列(コンパイル時にスカラーの経路で結果を求め、実行時のSIMDの経路と比べる)
+//==================================================
+
+// 比べる行列の数
+constexpr int kRandomCaseCount = 64;
+// floatの計算機イプシロン
+constexpr float kEpsilon = std::numeric_limits<float>::epsilon();
+// 4項の積和の許容誤差(ε * Σ|項|の何倍か)。4項の積和の丸め誤差はどちらの経路も4ε * Σ|項|以下なので、その差の上限
+constexpr float kDotErrorUlps = 8.0f;
+// 逆行列の許容誤差(ε * 逆行列の要素の絶対値の最大値の何倍か)。
+// 対角要素を大きくして条件数を抑えた行列なので、計算の順番が違っても誤差はこの範囲に収まる
+constexpr float kInverseErrorUlps = 16.0f;
+
+/// @brief コンパイル時にも使える乱数(xorshift)
+constexpr uint32_t NextRandom(uint32_t &state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/// @brief [min, max)の乱数
+constexpr float RandomFloat(uint32_t &state, float min, float max) {
+    return min + (max - min) * static_cast<float>(NextRandom(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+/// @brief 全ての要素がランダムな射影行列を作る。対角要素を大きくして正則にする
+constexpr Matrix4x4 RandomMatrix(uint32_t &state) {
+    Matrix4x4 matrix{};
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            matrix.m[row][column] = RandomFloat(state, -1.0f, 1.0f) + (row == column ? 4.0f : 0.0f);
+        }
+    }
+    return matrix;
+}
+
+/// @brief ランダムな入力と、コンパイル時に求めた結果
+struct RandomCase {
+    Matrix4x4 a;
+    Matrix4x4 b;
+    Vector3 v;
+    Matrix4x4 product;
+    Matrix4x4 transpose;
+    Matrix4x4 inverse;
+    Vector3 point;
+    Vector3 direction;
+};
+
+constexpr std::array<RandomCase, kRandomCaseCount> MakeRandomCases() {
+    std::array<RandomCase, kRandomCaseCount> cases{};
+    uint32_t state = 0x12345678u;
+    for (RandomCase &c : cases) {
+        c.a = RandomMatrix(state);
+        c.b = RandomMatrix(state);
+        c.v = Vector3(RandomFloat(state, -1.0f, 1.0f), RandomFloat(state, -1.0f, 1.0f), RandomFloat(state, -1.0f, 1.0f));
+        c.product = c.a * c.b;
+        Matrix4x4 a = c.a;
+        c.transpose = a.Transpose();
+        c.inverse = c.a.Inverse();
+        // 対角要素が大きいのでwは0から十分に離れている
+        c.point = c.v.Transform(c.a);
+        c.direction = c.v.TransformDirection(c.a);
+    }
+    return cases;
+}
+
+constexpr std::array<RandomCase, kRandomCaseCount> kRandomCases = MakeRandomCases();
+
+/// @brief 2つの値の差がε * magnitudeのulps倍以内か
+bool IsWithin(float value, float expected, float magnitude, float ulps) {
+    return std::abs(value - expected) <= ulps * kEpsilon * magnitude;
+}
+
+/// @brief 行ベクトル(x, y, z, w)と行列のcolumn列目の積和の項の絶対値の和
+float SumAbsTerms(const Vector3 &v, float w, const Matrix4x4 &m, int column) {
+    return std::abs(v.x * m.m[0][column]) + std::abs(v.y * m.m[1][column]) +
+        std::abs(v.z * m.m[2][column]) + std::abs(w * m.m[3][column]);
+}
+
+} // namespace
+
+KASHIPAN_TEST(Math_ConstexprResultsMatchRuntime) {
+    // 実行時はSIMDの経路を通るので、コンパイル時と同じ結果になるか比べる
+    volatile float scaleX = kScale.x;
+    const Vector3 scale(scaleX, kScale.y, kScale.z);
+    const Matrix4x4 affine = MakeAffine(scale, kRotateZ180, kTranslate);
+    KASHIPAN_EXPECT(IsSameMatrix(affine, kAffine));
+    KASHIPAN_EXPECT(IsSameMatrix(affine * affine.Inverse(), Matrix4x4::Identity()));
+    KASHIPAN_EXPECT(Vector3(1.0f, 1.0f, 2.0f).Transform(affine) == Vector3(8.0f, -7.0f, 8.0f));
+    KASHIPAN_EXPECT(scale.Cross(kB) == kScale.Cross(kB));
+}
+
+KASHIPAN_TEST(Math_MakeAffineEulerMatchesComposedMatrices) {
+    // オイラー角のMakeAffineは S * (X * Y * Z) * T を展開した形なので、行列の積と比べる
+    const Vector3 rotates[] = {
+        { 0.0f, 0.0f, 0.0f },
+        { 0.3f, -1.2f, 2.1f },
+        { -2.9f, 0.7f, -0.4f },
+        { 1.5707964f, 0.0f, 3.1415927f },
+    };
+    for (const Vector3 &rotate : rotates) {
+        Matrix4x4 affine;
+        affine.MakeAffine(kScale, rotate, kTranslate);
+
+        Matrix4x4 scaleMatrix, rotateX, rotateY, rotateZ, translateMatrix;
+        scaleMatrix.MakeScale(kScale);
+        rotateX.MakeRotateX(rotate.x);
+        rotateY.MakeRotateY(rotate.y);
+        rotateZ.MakeRotateZ(rotate.z);
+        translateMatrix.MakeTranslate(kTranslate);
+        const Matrix4x4 composed = scaleMatrix * (rotateX * rotateY * rotateZ) * translateMatrix;
+
+        for (int row = 0; row < 4; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                KASHIPAN_EXPECT_NEAR(affine.m[row][column], composed.m[row][column], 1e-5);
+            }
+        }
+    }
+}
+
+KASHIPAN_TEST(Math_SimdMultiplyMatchesConstexprOnRandomMatrices) {
+    for (const RandomCase &c : kRandomCases) {
+        const Matrix4x4 product = c.a * c.b;
+        for (int row = 0; row < 4; ++row) {
+            const Vector3 aRow(c.a.m[row][0], c.a.m[row][1], c.a.m[row][2]);
+            for (int column = 0; column < 4; ++column) {
+                const float magnitude = SumAbsTerms(aRow, c.a.m[row][3], c.b, column);
+                KASHIPAN_EXPECT(IsWithin(product.m[row][column], c.product.m[row][column], magnitude, kDotErrorUlps));
+#if !defined(__FMA__)
+                // 積和をまとめない環境では、積和の順番が同じなので一致する
+                KASHIPAN_EXPECT_EQ(product.m[row][column], c.product.m[row][column]);
+#endif
+            }
+        }
+    }
+}
+
+KASHIPAN_TEST(Math_SimdTransformMatchesConstexprOnRandomMatrices) {
+    for (const RandomCase &c : kRandomCases) {
+        const Vector3 point = c.v.Transform(c.a);
+        const Vector3 direction = c.v.TransformDirection(c.a);
+        const float w = c.v.x * c.a.m[0][3] + c.v.y * c.a.m[1][3] + c.v.z * c.a.m[2][3] + c.a.m[3][3];
+        const float wMagnitude = SumAbsTerms(c.v, 1.0f, c.a, 3);
+        const float pointResults[] = { point.x, point.y, point.z };
+        const float pointExpected[] = { c.point.x, c.point.y, c.point.z };
+        const float directionResults[] = { direction.x, direction.y, direction.z };
+        const float directionExpected[] = { c.direction.x, c.direction.y, c.direction.z };
+        for (int i = 0; i < 3; ++i) {
+            // 位置はwで割るので、分子とwの誤差が割った後の値に伝わる分と、割り算の丸めの分を足す
+            const float result = std::abs(pointExpected[i]);
+            const float pointMagnitude = (SumAbsTerms(c.v, 1.0f, c.a, i) + result * wMagnitude) / std::abs(w) + result;
+            KASHIPAN_EXPECT(IsWithin(pointResults[i], pointExpected[i], pointMagnitude, kDotErrorUlps));
+            KASHIPAN_EXPECT(IsWithin(directionResults[i], directionExpected[i], SumAbsTerms(c.v, 0.0f, c.a, i), kDotErrorUlps));
+#if !defined(__FMA__)
+            KASHIPAN_EXPECT_EQ(pointResults[i], pointExpected[i]);
+            KASHIPAN_EXPECT_EQ(directionResults[i], directionExpected[i]);
+#endif
+        }
+    }
+}
+
+KASHIPAN_TEST(Math_SimdTransposeMatchesConstexprOnRandomMatrices) {
+    for (const RandomCase &c : kRandomCases) {
+        Matrix4x4 a = c.a;
+        KASHIPAN_EXPECT(IsSameMatrix(a.Transpose(), c.transpose));
+        a.MakeTranspose();
+        KASHIPAN_EXPECT(IsSameMatrix(a, c.transpose));
+    }
+}
+
+KASHIPAN_TEST(Math_SimdInverseMatchesConstexprOnRandomMatrices) {
+    for (const RandomCase &c : kRandomCases) {
+        // 一般の射影行列の逆行列は、スカラー版(余因子展開)とSIMD版(2x2のブロック)で計算の順番が違う
+        const Matrix4x4 inverse = c.a.Inverse();
+        float magnitude = 0.0f;
+        for (int row = 0; row < 4; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                magnitude = std::max(magnitude, std::abs(c.inverse.m[row][column]));
+            }
+        }
+        for (int row = 0; row < 4; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                KASHIPAN_EXPECT(IsWithin(inverse.m[row][column], c.inverse.m[row][column], magnitude, kInverseErrorUlps));
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Test.h"
+#include "Common/ImageDecoder.h"
+#include "Common/MipGenerator.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+//--------- doubleで1ピクセルずつ計算する参照の実装 ---------//
+
+double SrgbToLinear(double value) {
+    return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+}
+
+double LinearToSrgb(double value) {
+    return value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+}
+
+/// @brief 1次元の縮小で、縮小後のindexが参照する元の位置と重み(2倍ならボックス、奇数なら重なり具合で重み付け)
+void ReferenceTaps(uint32_t srcSize, uint32_t dstSize, uint32_t index, uint32_t &first, std::vector<double> &weights) {
+    if (srcSize == dstSize) {
+        first = index;
+        weights = { 1.0 };
+    } else if (srcSize == dstSize * 2) {
+        first = index * 2;
+        weights = { 0.5, 0.5 };
+    } else {
+        // 元の2n+1ピクセルをn区間に均等に分けたとき、区間[index, index+1) * (2n+1)/nと各ピクセルの重なり
+        first = index * 2;
+        weights = {
+            static_cast<double>(dstSize - index) / srcSize,
+            static_cast<double>(dstSize) / srcSize,
+            static_cast<double>(index + 1) / srcSize,
+        };
+    }
+}
+
+/// @brief 参照の各レベルと、丸める前の値が丸めの境目(x.5)からどれだけ離れているか(8bitの単位)
+struct ReferenceMipChain {
+    std::vector<DecodedImage> levels;
+    std::vector<std::vector<double>> boundaryDistances;
+};
+
+/// @brief リニアのdoubleのまま1段階ずつ縮小し、各レベルをsRGBに丸めたもの
+ReferenceMipChain ReferenceMips(const DecodedImage &base) {
+    std::vector<double> linear(base.pixels.size());
+    for (size_t i = 0; i < base.pixels.size(); ++i) {
+        linear[i] = (i % 4 == 3) ? base.pixels[i] / 255.0 : SrgbToLinear(base.pixels[i] / 255.0);
+    }
+    uint32_t width = base.width;
+    uint32_t height = base.height;
+    ReferenceMipChain chain;
+    while (width > 1 || height > 1) {
+        DecodedImage &level = chain.levels.emplace_back();
+        std::vector<double> &boundaryDistances = chain.boundaryDistances.emplace_back();
+        level.width = std::max(width / 2, 1u);
+        level.height = std::max(height / 2, 1u);
+        level.pixels.resize(static_cast<size_t>(level.width) * level.height * 4);
+        std::vector<double> next(level.pixels.size());
+        boundaryDistances.resize(level.pixels.size());
+        uint32_t firstX;
+        uint32_t firstY;
+        std::vector<double> weightsX;
+        std::vector<double> weightsY;
+        for (uint32_t y = 0; y < level.height; ++y) {
+            ReferenceTaps(height, level.height, y, firstY, weightsY);
+            for (uint32_t x = 0; x < level.width; ++x) {
+                ReferenceTaps(width, level.width, x, firstX, weightsX);
+                for (int c = 0; c < 4; ++c) {
+                    double sum = 0.0;
+                    for (size_t ty = 0; ty < weightsY.size(); ++ty) {
+                        for (size_t tx = 0; tx < weightsX.size(); ++tx) {
+                            sum += weightsY[ty] * weightsX[tx] *
+                                linear[((firstY + ty) * static_cast<size_t>(width) + firstX + tx) * 4 + c];
+                        }
+                    }
+                    const size_t index = (static_cast<size_t>(y) * level.width + x) * 4 + c;
+                    next[index] = sum;
+                    const double clamped = std::clamp(sum, 0.0, 1.0);
+                    const double encoded = (c == 3 ? clamped : LinearToSrgb(clamped)) * 255.0;
+                    level.pixels[index] = static_cast<uint8_t>(std::lround(encoded));
+                    boundaryDistances[index] = std::abs(encoded - std::floor(encoded) - 0.5);
+                }
+            }
+        }
+        linear.swap(next);
+        width = level.width;
+        height = level.height;
+    }
+    return chain;
+}
+
+// floatで計算した値が、doubleで計算した値と丸めの境目の反対側に来てもよい距離(8bitの単位)
+constexpr double kBoundaryTolerance = 1e-3;
+
+/// @brief 生成したミップマップと参照を比べた結果
+struct MipComparison {
+    bool isSameShape = true;
+    int maxDifference = 0;
+    size_t differentCount = 0;
+    // 丸めの境目から離れているのに違った値の数
+    size_t unexpectedCount = 0;
+    size_t valueCount = 0;
+};
+
+MipComparison Compare(const std::vector<DecodedImage> &actual, const ReferenceMipChain &referenceChain) {
+    const std::vector<DecodedImage> &reference = referenceChain.levels;
+    MipComparison result;
+    if (actual.size() != reference.size()) {
+        result.isSameShape = false;
+        return result;
+    }
+    for (size_t level = 0; level < actual.size(); ++level) {
+        if (actual[level].width != reference[level].width || actual[level].height != reference[level].height ||
+            actual[level].pixels.size() != reference[level].pixels.size()) {
+            result.isSameShape = false;
+            return result;
+        }
+        for (size_t i = 0; i < actual[level].pixels.size(); ++i) {
+            const int difference = std::abs(actual[level].pixels[i] - reference[level].pixels[i]);
+            result.maxDifference = std::max(result.maxDifference, difference);
+            result.differentCount += difference != 0 ? 1 : 0;
+            if (difference != 0 && referenceChain.boundaryDistances[level][i] > kBoundaryTolerance) {
+                ++result.unexpectedCount;
+            }
+        }
+        result.valueCount += actual[level].pixels.size();
+    }
+    return result;
+}
+
+/// @brief ランダムな色の画像を作る
+DecodedImage MakeRandomImage(uint32_t width, uint32_t height, uint32_t seed) {
+    std::mt19937 random(seed);
+    DecodedImage image;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (uint8_t &value : image.pixels) {
+        value = static_cast<uint8_t>(random());
+    }
+    return image;
+}
+
+/// @brief 参照と比べて、違いがfloatの誤差で丸めの境目をまたいだ1段階だけに収まっているか調べる
+void ExpectMatchesReference(const DecodedImage &image, const char *name) {
+    std::vector<DecodedImage> mips;
+    if (!KASHIPAN_EXPECT(MipGenerator::Generate(image, mips))) {
+        return;
+    }
+    const MipComparison comparison = Compare(mips, ReferenceMips(image));
+    KASHIPAN_EXPECT(comparison.isSameShape);
+    KASHIPAN_EXPECT(comparison.maxDifference <= 1);
+    KASHIPAN_EXPECT_EQ(comparison.unexpectedCount, 0u);
+    std::printf("  %s: %zu levels, max difference %d, %zu of %zu values differ\n",
+        name, mips.size(), comparison.maxDifference, comparison.differentCount, comparison.valueCount);
+}
+
+} // namespace
+
+KASHIPAN_TEST(Texture_MipLevelCountAndSizes) {
+    KASHIPAN_EXPECT_EQ(MipGenerator::CalcMipLevels(1, 1), 1u);
+    KASHIPAN_EXPECT_EQ(MipGenerator::CalcMipLevels(512, 512), 10u);
+    KASHIPAN_EXPECT_EQ(MipGenerator::CalcMipLevels(2160, 1080), 12u);
+    KASHIPAN_EXPECT_EQ(MipGenerator::CalcMipLevels(37, 5), 6u);
+
+    std::vector<DecodedImage> mips;
+    KASHIPAN_REQUIRE(MipGenerator::Generate(MakeRandomImage(37, 5, 1), mips));
+    const uint32_t expectedSizes[][2] = { { 18, 2 }, { 9, 1 }, { 4, 1 }, { 2, 1 }, { 1, 1 } };
+    KASHIPAN_REQUIRE(mips.size() == std::size(expectedSizes));
+    for (size_t i = 0; i < mips.size(); ++i) {
+        KASHIPAN_EXPECT_EQ(mips[i].width, expectedSizes[i][0]);
+        KASHIPAN_EXPECT_EQ(mips[i].height, expectedSizes[i][1]);
+    }
+
+    // レベル数を指定したらそこで止める
+    KASHIPAN_REQUIRE(MipGenerator::Generate(MakeRandomImage(64, 64, 2), mips, 3));
+    KASHIPAN_EXPECT_EQ(mips.size(), 2u);
+    // サイズとピクセル数が合わない画像は作らない
+    DecodedImage broken = MakeRandomImage(8, 8, 3);
+    broken.pixels.pop_back();
+    KASHIPAN_EXPECT(!MipGenerator::Generate(broken, mips));
+}
+
+KASHIPAN_TEST(Texture_MipOfUniformImageKeepsColor) {
+    // 全て同じ色なら、どのレベルも丸めの誤差なしで同じ色になる
+    for (uint32_t value = 0; value < 256; value += 17) {
+        DecodedImage image;
+        image.width = 33;
+        image.height = 10;
+        image.pixels.assign(static_cast<size_t>(image.width) * image.height * 4, static_cast<uint8_t>(value));
+        std::vector<DecodedImage> mips;
+        KASHIPAN_REQUIRE(MipGenerator::Generate(image, mips));
+        for (const DecodedImage &level : mips) {
+            KASHIPAN_EXPECT(std::all_of(level.pixels.begin(), level.pixels.end(),
+                [value](uint8_t pixel) { return pixel == value; }));
+        }
+    }
+}
+
+KASHIPAN_TEST(Texture_MipMatchesReferenceOnOddSizes) {
+    ExpectMatchesReference(MakeRandomImage(37, 23, 10), "37x23");
+    ExpectMatchesReference(MakeRandomImage(255, 3, 11), "255x3");
+    ExpectMatchesReference(MakeRandomImage(64, 64, 12), "64x64");
+}
+
+KASHIPAN_TEST(Texture_MipMatchesReferenceOnResources) {
+    for (const char *path : { "uvChecker.png", "reticle.png", "Skydome/skydome.png" }) {
+        DecodedImage image;
+        KASHIPAN_REQUIRE(ImageDecoder::LoadFromFile(std::string(KASHIPAN_RESOURCE_DIRECTORY) + "/" + path, image));
+        ExpectMatchesReference(image, path);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "Test.h"
+#include "Common/ObjectPool.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 先に作っておく数(GameSceneの敵のプールと同じ)
+constexpr size_t kWarmUpCount = 32;
+// 出したり消したりを繰り返すフレーム数
+constexpr int kFrameCount = 600;
+
+/// @brief 出現と消滅を繰り返すオブジェクトの代わり
+struct PooledObject {
+    int spawnCount = 0;
+    bool isRegistered = false;
+};
+
+/// @brief 決まった順に値を返す乱数(xorshift32)
+uint32_t NextRandom(uint32_t &state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+} // namespace
+
+KASHIPAN_TEST(Object_PoolDoesNotGrowAfterWarmUp) {
+    int createCount = 0;
+    int releaseCount = 0;
+    ObjectPool<PooledObject> pool(
+        [&]() { ++createCount; return std::make_unique<PooledObject>(); },
+        [&](PooledObject &object) { ++releaseCount; object.isRegistered = false; });
+    pool.WarmUp(kWarmUpCount);
+    KASHIPAN_EXPECT_EQ(pool.GetCreatedCount(), kWarmUpCount);
+    KASHIPAN_EXPECT_EQ(pool.GetFreeCount(), kWarmUpCount);
+
+    // WarmUpで作ったものだけが取り出される
+    std::set<const PooledObject *> warmedUp;
+    {
+        std::vector<ObjectPool<PooledObject>::Handle> handles;
+        for (size_t i = 0; i < kWarmUpCount; ++i) {
+            handles.push_back(pool.Acquire());
+            warmedUp.insert(handles.back().get());
+        }
+    }
+    KASHIPAN_EXPECT_EQ(warmedUp.size(), kWarmUpCount);
+
+    // GameSceneと同じく、毎フレーム出現させて寿命が来たものをリストから消す
+    std::list<ObjectPool<PooledObject>::Handle> objects;
+    uint32_t state = 0x12345678u;
+    int acquireCount = 0;
+    int foreignCount = 0;
+    for (int frame = 0; frame < kFrameCount; ++frame) {
+        uint32_t spawn = NextRandom(state) % 4;
+        for (uint32_t i = 0; i < spawn && objects.size() < kWarmUpCount; ++i) {
+            ObjectPool<PooledObject>::Handle object = pool.Acquire();
+            foreignCount += warmedUp.count(object.get()) ? 0 : 1;
+            ++object->spawnCount;
+            object->isRegistered = true;
+            objects.push_back(std::move(object));
+            ++acquireCount;
+        }
+        objects.remove_if([&](const ObjectPool<PooledObject>::Handle &) { return NextRandom(state) % 3 == 0; });
+    }
+    objects.clear();
+
+    KASHIPAN_EXPECT_EQ(pool.GetGrownCount(), 0u);
+    KASHIPAN_EXPECT_EQ(pool.GetCreatedCount(), kWarmUpCount);
+    KASHIPAN_EXPECT_EQ(createCount, static_cast<int>(kWarmUpCount));
+    KASHIPAN_EXPECT_EQ(foreignCount, 0);
+    KASHIPAN_EXPECT_EQ(pool.GetActiveCount(), 0u);
+    KASHIPAN_EXPECT_EQ(pool.GetFreeCount(), kWarmUpCount);
+    KASHIPAN_EXPECT(pool.GetHighWaterMark() <= kWarmUpCount);
+    // 戻す時の関数は戻した回数だけ呼ばれ、戻したものに登録が残らない
+    KASHIPAN_EXPECT_EQ(releaseCount, static_cast<int>(kWarmUpCount) + acquireCount);
+    int registeredCount = 0;
+    for (const PooledObject *object : warmedUp) {
+        registeredCount += object->isRegistered ? 1 : 0;
+    }
+    KASHIPAN_EXPECT_EQ(registeredCount, 0);
+}
+
+KASHIPAN_TEST(Object_PoolGrowsOnlyBeyondWarmUp) {
+    ObjectPool<PooledObject> pool([]() { return std::make_unique<PooledObject>(); });
+    pool.WarmUp(kWarmUpCount);
+
+    std::vector<ObjectPool<PooledObject>::Handle> handles;
+    for (size_t i = 0; i < kWarmUpCount + 3; ++i) {
+        handles.push_back(pool.Acquire());
+    }
+    KASHIPAN_EXPECT_EQ(pool.GetGrownCount(), 3u);
+    KASHIPAN_EXPECT_EQ(pool.GetCreatedCount(), kWarmUpCount + 3);
+    KASHIPAN_EXPECT_EQ(pool.GetHighWaterMark(), kWarmUpCount + 3);
+    handles.clear();
+
+    // 増えた後は、同じ数まで取り出しても作らない
+    for (size_t i = 0; i < kWarmUpCount + 3; ++i) {
+        handles.push_back(pool.Acquire());
+    }
+    KASHIPAN_EXPECT_EQ(pool.GetGrownCount(), 3u);
+    KASHIPAN_EXPECT_EQ(pool.GetCreatedCount(), kWarmUpCount + 3);
+    handles.clear();
+}
\ No newline at end of file
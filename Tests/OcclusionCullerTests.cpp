@@ -0,0 +1,15 @@
+#include "Test.h"
+#include "OcclusionScene.h"
+
+using namespace KashipanEngine;
+
+KASHIPAN_TEST(Occlusion_NeverCullsVisibleObjects) {
+    const Test::OcclusionScene scene = Test::MakeOcclusionScene();
+    const Test::OcclusionVerification verification = Test::VerifyOcclusion(scene);
+    // 画素の中心から1つでも見えている物体は、隠れていると判定しない
+    KASHIPAN_EXPECT_EQ(verification.falseCulls, 0u);
+    // 実際に隠れている物体の多くを隠れていると判定する(保守的な判定なので全てではない)
+    KASHIPAN_REQUIRE(verification.hidden > 0u);
+    KASHIPAN_EXPECT(verification.culled > 0u);
+    KASHIPAN_EXPECT(verification.culled * 2 >= verification.hidden);
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "OcclusionScene.h"
+#include "Math/OcclusionCuller.h"
+#include "Math/RenderingPipeline.h"
+#include "Math/TriangleBVH.h"
+#include "Math/MathObjects/Lines.h"
+
+namespace KashipanEngine {
+
+namespace Test {
+
+namespace {
+
+constexpr size_t kObjectCount = 3000;
+constexpr size_t kOccluderBoxCount = 16;
+constexpr size_t kCameraCount = 8;
+
+/// @brief 原点中心の一辺1の立方体
+SceneOccluder MakeUnitBox() {
+    SceneOccluder box;
+    for (int i = 0; i < 8; ++i) {
+        box.positions.emplace_back((i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f);
+    }
+    box.indices = {
+        0, 2, 1, 1, 2, 3,   // -z
+        4, 5, 6, 5, 7, 6,   // +z
+        0, 1, 4, 1, 5, 4,   // -y
+        2, 6, 3, 3, 6, 7,   // +y
+        0, 4, 2, 2, 4, 6,   // -x
+        1, 3, 5, 3, 7, 5,   // +x
+    };
+    return box;
+}
+
+Matrix4x4 MakeScaleTranslate(const Vector3 &scale, const Vector3 &translate) {
+    Matrix4x4 matrix;
+    matrix.MakeAffine(scale, Vector3(0.0f), translate);
+    return matrix;
+}
+
+/// @brief 半直線と境界ボックスの交差(時刻はrayのdiffに対する割合)
+bool IntersectBox(const Math::Ray &ray, const Vector3 &min, const Vector3 &max, float &outTime) {
+    float enter = 0.0f;
+    float exit = std::numeric_limits<float>::infinity();
+    const float origin[3] = { ray.origin.x, ray.origin.y, ray.origin.z };
+    const float diff[3] = { ray.diff.x, ray.diff.y, ray.diff.z };
+    const float boxMin[3] = { min.x, min.y, min.z };
+    const float boxMax[3] = { max.x, max.y, max.z };
+    for (int axis = 0; axis < 3; ++axis) {
+        const float inverse = 1.0f / diff[axis];
+        float t0 = (boxMin[axis] - origin[axis]) * inverse;
+        float t1 = (boxMax[axis] - origin[axis]) * inverse;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        enter = std::max(enter, t0);
+        exit = std::min(exit, t1);
+    }
+    outTime = enter;
+    return enter <= exit;
+}
+
+} // namespace
+
+OcclusionScene MakeOcclusionScene() {
+    OcclusionScene scene;
+    std::mt19937 random(86420);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    auto range = [&](float min, float max) { return min + (max - min) * dist(random); };
+
+    // 地面(カメラの後ろまで伸びるので近平面で切り取られる)
+    SceneOccluder ground;
+    ground.positions = { Vector3(-500.0f, 0.0f, -100.0f), Vector3(500.0f, 0.0f, -100.0f),
+        Vector3(-500.0f, 0.0f, 1000.0f), Vector3(500.0f, 0.0f, 1000.0f) };
+    ground.indices = { 0, 2, 1, 1, 2, 3 };
+    ground.worldMatrix = Matrix4x4::Identity();
+    scene.occluders.push_back(ground);
+
+    // 大きな敵や建物の代わりの箱
+    const SceneOccluder unitBox = MakeUnitBox();
+    for (size_t i = 0; i < kOccluderBoxCount; ++i) {
+        SceneOccluder box = unitBox;
+        const Vector3 scale(range(6.0f, 14.0f), range(6.0f, 16.0f), range(2.0f, 6.0f));
+        box.worldMatrix = MakeScaleTranslate(scale, Vector3(range(-40.0f, 40.0f), scale.y * 0.5f, range(15.0f, 200.0f)));
+        scene.occluders.push_back(std::move(box));
+    }
+
+    // 小さな物体(一部は地面の下にある)
+    for (size_t i = 0; i < kObjectCount; ++i) {
+        const Vector3 scale(range(0.5f, 2.0f));
+        const Vector3 translate(range(-60.0f, 60.0f), range(-4.0f, 10.0f), range(0.0f, 300.0f));
+        scene.objects.push_back({ MakeScaleTranslate(scale, translate), translate - scale * 0.5f, translate + scale * 0.5f });
+    }
+
+    // レールに沿って進み、少し左右を向くカメラ
+    const Matrix4x4 projection = MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 2048.0f);
+    for (size_t i = 0; i < kCameraCount; ++i) {
+        const float t = static_cast<float>(i);
+        const Vector3 eye(std::sin(t) * 5.0f, 4.0f, -20.0f + t * 10.0f);
+        const Vector3 target = eye + Vector3(std::sin(t * 0.7f) * 4.0f, -1.0f, 20.0f);
+        scene.viewProjections.push_back(MakeViewMatrix(eye, target, Vector3(0.0f, 1.0f, 0.0f)) * projection);
+    }
+    return scene;
+}
+
+void RenderOccluders(Math::OcclusionCuller &culler, const OcclusionScene &scene, const Matrix4x4 &viewProjection) {
+    culler.BeginFrame(viewProjection);
+    for (const auto &occluder : scene.occluders) {
+        culler.RenderOccluder(occluder.positions, occluder.indices, occluder.worldMatrix);
+    }
+    culler.EndOccluders();
+}
+
+OcclusionVerification VerifyOcclusion(const OcclusionScene &scene) {
+    // 物体ごとに、箱が掛かる全ての画素の中心を通る半直線を飛ばし、遮蔽物より先に箱に当たるかで見えるかを決める
+    // 遮蔽物をワールド座標の1つのメッシュにまとめる
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    for (const auto &occluder : scene.occluders) {
+        const uint32_t offset = static_cast<uint32_t>(positions.size());
+        for (const Vector3 &position : occluder.positions) {
+            positions.push_back(position.Transform(occluder.worldMatrix));
+        }
+        for (uint32_t index : occluder.indices) {
+            indices.push_back(offset + index);
+        }
+    }
+    Math::TriangleBVH bvh;
+    bvh.Build(positions, indices);
+
+    OcclusionVerification result;
+    Math::OcclusionCuller culler;
+    constexpr float kWidth = static_cast<float>(Math::OcclusionCuller::kWidth);
+    constexpr float kHeight = static_cast<float>(Math::OcclusionCuller::kHeight);
+    for (const Matrix4x4 &viewProjection : scene.viewProjections) {
+        RenderOccluders(culler, scene, viewProjection);
+        const Matrix4x4 inverseViewProjection = viewProjection.Inverse();
+        for (const auto &object : scene.objects) {
+            const bool isCulled = !culler.IsVisible(Vector3(-0.5f), Vector3(0.5f), object.worldMatrix);
+            result.culled += isCulled;
+
+            // 箱の画面上の範囲(全ての角がカメラの後ろにあれば見えない。近平面をまたぐ箱は見えるとみなして調べない)
+            float minX = kWidth, maxX = 0.0f, minY = kHeight, maxY = 0.0f;
+            int behindCount = 0;
+            for (int i = 0; i < 8; ++i) {
+                const Vector3 corner((i & 1) ? object.worldMax.x : object.worldMin.x,
+                    (i & 2) ? object.worldMax.y : object.worldMin.y, (i & 4) ? object.worldMax.z : object.worldMin.z);
+                const float w = corner.x * viewProjection.m[0][3] + corner.y * viewProjection.m[1][3] +
+                    corner.z * viewProjection.m[2][3] + viewProjection.m[3][3];
+                const Vector3 ndc = corner.Transform(viewProjection);
+                behindCount += (w <= 0.0f || ndc.z < 0.0f);
+                minX = std::min(minX, (ndc.x * 0.5f + 0.5f) * kWidth);
+                maxX = std::max(maxX, (ndc.x * 0.5f + 0.5f) * kWidth);
+                minY = std::min(minY, (0.5f - ndc.y * 0.5f) * kHeight);
+                maxY = std::max(maxY, (0.5f - ndc.y * 0.5f) * kHeight);
+            }
+            if (behindCount == 8) {
+                ++result.hidden;
+                continue;
+            }
+            if (behindCount > 0) {
+                continue;
+            }
+
+            // 画面の外の部分は調べない(大きな値を整数にしないよう、先に画面の範囲に収める)
+            minX = std::clamp(minX, -1.0f, kWidth);
+            maxX = std::clamp(maxX, -1.0f, kWidth);
+            minY = std::clamp(minY, -1.0f, kHeight);
+            maxY = std::clamp(maxY, -1.0f, kHeight);
+
+            bool isSeen = false;
+            const int x0 = std::max(0, static_cast<int>(std::floor(minX - 0.5f)));
+            const int x1 = std::min(static_cast<int>(kWidth) - 1, static_cast<int>(std::ceil(maxX - 0.5f)));
+            const int y0 = std::max(0, static_cast<int>(std::floor(minY - 0.5f)));
+            const int y1 = std::min(static_cast<int>(kHeight) - 1, static_cast<int>(std::ceil(maxY - 0.5f)));
+            for (int y = y0; y <= y1 && !isSeen; ++y) {
+                for (int x = x0; x <= x1 && !isSeen; ++x) {
+                    const float ndcX = (static_cast<float>(x) + 0.5f) / kWidth * 2.0f - 1.0f;
+                    const float ndcY = 1.0f - (static_cast<float>(y) + 0.5f) / kHeight * 2.0f;
+                    Math::Ray ray;
+                    ray.origin = Vector3(ndcX, ndcY, 0.0f).Transform(inverseViewProjection);
+                    ray.diff = Vector3(ndcX, ndcY, 1.0f).Transform(inverseViewProjection) - ray.origin;
+                    float boxTime = 0.0f;
+                    if (!IntersectBox(ray, object.worldMin, object.worldMax, boxTime) || boxTime > 1.0f) {
+                        continue;
+                    }
+                    Math::TriangleBVH::RaycastHit hit;
+                    isSeen = !bvh.Raycast(ray, hit) || hit.time > boxTime;
+                }
+            }
+            result.hidden += !isSeen;
+            result.falseCulls += (isCulled && isSeen);
+        }
+    }
+    return result;
+}
+
+} // namespace Test
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Math/Matrix4x4.h"
+#include "Math/Vector3.h"
+
+/*
+OcclusionCullerのテストとベンチマークで使う場面と、判定が正しいかの検証。
+  MakeOcclusionScene : 地面と16個の大きな箱を遮蔽物に、3000個の小さな箱をカメラ8か所で判定する場面を作る
+  VerifyOcclusion    : 物体ごとに画素の中心を通る半直線を飛ばして実際に見えるかを調べ、OcclusionCullerの判定と比べる
+テスト(Tests/OcclusionCullerTests.cpp)とベンチマーク(Benchmarks/OcclusionBenchmarks.cpp)の両方でビルドする。
+*/
+
+namespace KashipanEngine {
+
+namespace Math {
+class OcclusionCuller;
+} // namespace Math
+
+namespace Test {
+
+/// @brief 遮蔽物のメッシュ(位置とインデックスだけ)とワールド行列
+struct SceneOccluder {
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    Matrix4x4 worldMatrix;
+};
+
+/// @brief 判定する物体(ローカルの境界ボックスは原点中心の一辺1の立方体)
+struct SceneObject {
+    Matrix4x4 worldMatrix;
+    Vector3 worldMin;
+    Vector3 worldMax;
+};
+
+/// @brief 判定に使う場面。レールシューティングのように、地面と大きな遮蔽物の間や裏に小さな物体が散らばっている
+struct OcclusionScene {
+    std::vector<SceneOccluder> occluders;
+    std::vector<SceneObject> objects;
+    std::vector<Matrix4x4> viewProjections;
+};
+
+/// @brief 判定の検証結果
+struct OcclusionVerification {
+    // 隠れていると判定した物体の数
+    size_t culled = 0;
+    // 深度バッファの画素の中心を通る半直線で調べて、実際に見えなかった物体の数
+    size_t hidden = 0;
+    // 隠れていると判定したのに、いずれかの画素の中心から見えていた物体の数(0でなければならない)
+    size_t falseCulls = 0;
+};
+
+/// @brief 場面を作る(乱数の種は固定なので毎回同じ場面になる)
+OcclusionScene MakeOcclusionScene();
+
+/// @brief 遮蔽物を全て描く
+/// @param culler 描く先
+/// @param scene 場面
+/// @param viewProjection ビュープロジェクション行列
+void RenderOccluders(Math::OcclusionCuller &culler, const OcclusionScene &scene, const Matrix4x4 &viewProjection);
+
+/// @brief 全てのカメラで、OcclusionCullerの判定と画素の中心を通る半直線で調べた見え方を比べる
+/// @param scene 場面
+/// @return 検証結果
+OcclusionVerification VerifyOcclusion(const OcclusionScene &scene);
+
+} // namespace Test
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "Math/Matrix4x4.h"
+#include "Math/Quaternion.h"
+#include "Math/Vector3.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 乱数で作る回転の数
+constexpr int kRotationCount = 2000;
+constexpr float kPi = 3.14159265f;
+// 回転行列の要素の許容誤差(floatの三角関数と積の丸め誤差)
+constexpr double kMatrixTolerance = 2e-6;
+// 正規化されたクォータニオンの長さの許容誤差
+constexpr double kLengthTolerance = 1e-6;
+// Slerpの角度の許容誤差(ラジアン)
+constexpr double kAngleTolerance = 1e-5;
+// SlerpFastのSlerpとの角度の誤差の上限(Quaternion.hに書いてある値)
+constexpr double kSlerpFastTolerance = 1e-3;
+
+/// @brief -π～πのオイラー角を作る
+Vector3 RandomEuler(std::mt19937 &random) {
+    std::uniform_real_distribution<float> dist(-kPi, kPi);
+    return Vector3(dist(random), dist(random), dist(random));
+}
+
+/// @brief 2つのクォータニオンが表す回転の間の角度。
+/// 内積のacosは角度が小さいと桁落ちするので、doubleで相対回転 conj(a) * b を求めてatan2で角度にする
+double AngleBetween(const Quaternion &a, const Quaternion &b) {
+    const double ax = -a.x, ay = -a.y, az = -a.z, aw = a.w;
+    const double rx = aw * b.x + ax * b.w + ay * b.z - az * b.y;
+    const double ry = aw * b.y - ax * b.z + ay * b.w + az * b.x;
+    const double rz = aw * b.z + ax * b.y - ay * b.x + az * b.w;
+    const double rw = aw * b.w - ax * b.x - ay * b.y - az * b.z;
+    return 2.0 * std::atan2(std::sqrt(rx * rx + ry * ry + rz * rz), std::abs(rw));
+}
+
+/// @brief 2つの行列の要素の差の最大
+double MaxDifference(const Matrix4x4 &a, const Matrix4x4 &b) {
+    double maxDifference = 0.0;
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            maxDifference = std::max(maxDifference, std::abs(static_cast<double>(a.m[row][column]) - b.m[row][column]));
+        }
+    }
+    return maxDifference;
+}
+
+} // namespace
+
+KASHIPAN_TEST(Math_QuaternionFromEulerMatchesEulerMatrix) {
+    std::mt19937 random(1001);
+    const Vector3 scale(1.5f, 0.5f, 2.0f);
+    const Vector3 translate(3.0f, -2.0f, 8.0f);
+    double maxRotateDifference = 0.0;
+    double maxAffineDifference = 0.0;
+    for (int i = 0; i < kRotationCount; ++i) {
+        const Vector3 rotate = RandomEuler(random);
+        const Quaternion q = Quaternion::FromEuler(rotate);
+
+        Matrix4x4 rotateMatrix;
+        rotateMatrix.MakeRotate(rotate);
+        maxRotateDifference = std::max(maxRotateDifference, MaxDifference(q.ToMatrix(), rotateMatrix));
+
+        // クォータニオンとオイラー角のMakeAffineが同じ行列になる
+        Matrix4x4 affineEuler;
+        Matrix4x4 affineQuaternion;
+        affineEuler.MakeAffine(scale, rotate, translate);
+        affineQuaternion.MakeAffine(scale, q, translate);
+        maxAffineDifference = std::max(maxAffineDifference, MaxDifference(affineQuaternion, affineEuler));
+    }
+    KASHIPAN_EXPECT_NEAR(maxRotateDifference, 0.0, kMatrixTolerance);
+    KASHIPAN_EXPECT_NEAR(maxAffineDifference, 0.0, kMatrixTolerance * 2.0);
+}
+
+KASHIPAN_TEST(Math_QuaternionFromEulerIsAxisProductInXYZOrder) {
+    std::mt19937 random(1002);
+    for (int i = 0; i < kRotationCount; ++i) {
+        const Vector3 rotate = RandomEuler(random);
+        // X → Y → Z の順に回すので qZ * qY * qX
+        const Quaternion composed =
+            Quaternion::FromAxisAngle({ 0.0f, 0.0f, 1.0f }, rotate.z) *
+            Quaternion::FromAxisAngle({ 0.0f, 1.0f, 0.0f }, rotate.y) *
+            Quaternion::FromAxisAngle({ 1.0f, 0.0f, 0.0f }, rotate.x);
+        KASHIPAN_EXPECT_NEAR(AngleBetween(composed, Quaternion::FromEuler(rotate)), 0.0, kAngleTolerance);
+    }
+}
+
+KASHIPAN_TEST(Math_QuaternionRotateVectorMatchesMatrix) {
+    std::mt19937 random(1003);
+    std::uniform_real_distribution<float> distVector(-10.0f, 10.0f);
+    double maxDifference = 0.0;
+    for (int i = 0; i < kRotationCount; ++i) {
+        const Quaternion q = Quaternion::FromEuler(RandomEuler(random));
+        const Vector3 vector(distVector(random), distVector(random), distVector(random));
+        const Vector3 byQuaternion = q.RotateVector(vector);
+        const Vector3 byMatrix = vector.TransformDirection(q.ToMatrix());
+        maxDifference = std::max(maxDifference, static_cast<double>((byQuaternion - byMatrix).Length() / vector.Length()));
+        // 回転なので長さは変わらない
+        KASHIPAN_EXPECT_NEAR(byQuaternion.Length(), vector.Length(), vector.Length() * 1e-5);
+    }
+    KASHIPAN_EXPECT_NEAR(maxDifference, 0.0, 1e-5);
+}
+
+KASHIPAN_TEST(Math_QuaternionFromMatrixRoundTrip) {
+    std::mt19937 random(1004);
+    std::vector<Quaternion> rotations = {
+        Quaternion::Identity(),
+        // 対角成分の和が負になり、x・y・zそれぞれの分岐を通るもの
+        Quaternion::FromAxisAngle({ 1.0f, 0.0f, 0.0f }, kPi),
+        Quaternion::FromAxisAngle({ 0.0f, 1.0f, 0.0f }, kPi),
+        Quaternion::FromAxisAngle({ 0.0f, 0.0f, 1.0f }, kPi),
+        Quaternion::FromAxisAngle(Vector3(1.0f, 1.0f, 0.0f).Normalize(), 3.0f),
+    };
+    for (int i = 0; i < kRotationCount; ++i) {
+        rotations.push_back(Quaternion::FromEuler(RandomEuler(random)));
+    }
+    for (const Quaternion &q : rotations) {
+        const Quaternion restored = Quaternion::FromMatrix(q.ToMatrix());
+        KASHIPAN_EXPECT_NEAR(AngleBetween(restored, q), 0.0, kAngleTolerance);
+        KASHIPAN_EXPECT_NEAR(restored.Length(), 1.0, 1e-5);
+    }
+}
+
+KASHIPAN_TEST(Math_QuaternionSlerpEndpointsAndConstantSpeed) {
+    std::mt19937 random(1005);
+    for (int i = 0; i < kRotationCount / 4; ++i) {
+        const Quaternion start = Quaternion::FromEuler(RandomEuler(random));
+        const Quaternion end = Quaternion::FromEuler(RandomEuler(random));
+        const double totalAngle = AngleBetween(start, end);
+
+        // 端点は開始と終了の回転そのもの(終了は最短経路のために符号が反転していても同じ回転)
+        for (auto interpolate : { &Quaternion::Slerp, &Quaternion::Nlerp, &Quaternion::SlerpFast }) {
+            KASHIPAN_EXPECT_NEAR(AngleBetween(interpolate(start, end, 0.0f), start), 0.0, kAngleTolerance);
+            KASHIPAN_EXPECT_NEAR(AngleBetween(interpolate(start, end, 1.0f), end), 0.0, kAngleTolerance);
+        }
+
+        for (int step = 1; step < 8; ++step) {
+            const float t = static_cast<float>(step) / 8.0f;
+            const Quaternion slerp = Quaternion::Slerp(start, end, t);
+            // 角速度が一定なので、開始からの角度は全体の角度のt倍で、最短経路上にある
+            KASHIPAN_EXPECT_NEAR(AngleBetween(start, slerp), totalAngle * t, kAngleTolerance);
+            KASHIPAN_EXPECT_NEAR(AngleBetween(slerp, end), totalAngle * (1.0 - t), kAngleTolerance);
+            KASHIPAN_EXPECT_NEAR(AngleBetween(Quaternion::SlerpFast(start, end, t), slerp), 0.0, kSlerpFastTolerance);
+        }
+    }
+
+    // ほぼ同じ向き(Nlerpに切り替わる範囲)でも端点と中点がずれない
+    const Quaternion start = Quaternion::FromEuler({ 0.2f, 0.4f, -0.1f });
+    const Quaternion end = Quaternion::FromEuler({ 0.2f, 0.41f, -0.1f });
+    KASHIPAN_EXPECT_NEAR(AngleBetween(Quaternion::Slerp(start, end, 0.0f), start), 0.0, kAngleTolerance);
+    KASHIPAN_EXPECT_NEAR(AngleBetween(Quaternion::Slerp(start, end, 1.0f), end), 0.0, kAngleTolerance);
+    KASHIPAN_EXPECT_NEAR(AngleBetween(Quaternion::Slerp(start, end, 0.5f), start), AngleBetween(start, end) * 0.5, kAngleTolerance);
+}
+
+KASHIPAN_TEST(Math_QuaternionResultsStayNormalized) {
+    std::mt19937 random(1006);
+    std::uniform_real_distribution<float> dist01(0.0f, 1.0f);
+    for (int i = 0; i < kRotationCount; ++i) {
+        const Quaternion a = Quaternion::FromEuler(RandomEuler(random));
+        const Quaternion b = Quaternion::FromEuler(RandomEuler(random));
+        const float t = dist01(random);
+        const Vector3 axis = RandomEuler(random).Normalize();
+        KASHIPAN_EXPECT_NEAR(a.Length(), 1.0, kLengthTolerance);
+        KASHIPAN_EXPECT_NEAR(Quaternion::FromAxisAngle(axis, t * 6.0f).Length(), 1.0, kLengthTolerance);
+        KASHIPAN_EXPECT_NEAR((a * b).Length(), 1.0, kLengthTolerance);
+        KASHIPAN_EXPECT_NEAR(Quaternion::Slerp(a, b, t).Length(), 1.0, kLengthTolerance);
+        KASHIPAN_EXPECT_NEAR(Quaternion::Nlerp(a, b, t).Length(), 1.0, kLengthTolerance);
+        KASHIPAN_EXPECT_NEAR(Quaternion::SlerpFast(a, b, t).Length(), 1.0, kLengthTolerance);
+        KASHIPAN_EXPECT_NEAR((a * 3.5f).Normalize().Length(), 1.0, kLengthTolerance);
+    }
+
+    // 掛け続けて長さがずれても、Normalizeで戻せて回転は変わらない
+    const Quaternion step = Quaternion::FromEuler({ 0.01f, 0.02f, 0.03f });
+    Quaternion accumulated = Quaternion::Identity();
+    for (int i = 0; i < 10000; ++i) {
+        accumulated = accumulated * step;
+    }
+    const Quaternion normalized = accumulated.Normalize();
+    KASHIPAN_EXPECT_NEAR(normalized.Length(), 1.0, kLengthTolerance);
+    KASHIPAN_EXPECT_NEAR(AngleBetween(normalized, accumulated), 0.0, kAngleTolerance);
+
+    // 長さ0は単位クォータニオンにする
+    KASHIPAN_EXPECT(Quaternion(0.0f, 0.0f, 0.0f, 0.0f).Normalize() == Quaternion::Identity());
+}
\ No newline at end of file
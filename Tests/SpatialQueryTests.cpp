@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "Math/RenderingPipeline.h"
+#include "Math/SpatialQuery.h"
+
+using namespace KashipanEngine;
+using Result = Math::SpatialQuery::Result;
+
+namespace {
+
+// 点の数と、点を置く範囲
+constexpr size_t kPointCount = 2000;
+constexpr float kExtent = 50.0f;
+// 同じ位置に重ねて置く点の組の数と、1組の点の数(距離が同じ点の並び順を調べる)
+constexpr size_t kDuplicateGroupCount = 20;
+constexpr size_t kDuplicateCount = 5;
+// 探索の数
+constexpr int kQueryCount = 200;
+// 1回の探索で求める数
+constexpr size_t kResultCounts[] = { 1, 3, 16, 100 };
+// グリッドの作り方(自動・小さいセル・グリッド無し)
+constexpr float kCellSizes[] = { 0.0f, 1.5f, Math::SpatialQuery::kNoGrid };
+
+/// @brief SoAの点の集合
+struct Points {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+
+    Vector3 Get(size_t index) const {
+        return Vector3(x[index], y[index], z[index]);
+    }
+    void Add(const Vector3 &point) {
+        x.push_back(point.x);
+        y.push_back(point.y);
+        z.push_back(point.z);
+    }
+};
+
+Vector3 RandomVector(std::mt19937 &random, float extent) {
+    std::uniform_real_distribution<float> dist(-extent, extent);
+    return Vector3(dist(random), dist(random), dist(random));
+}
+
+/// @brief ばらばらの点と、同じ位置に重なった点を混ぜて作る
+Points RandomPoints(std::mt19937 &random) {
+    Points points;
+    for (size_t i = 0; i < kPointCount; ++i) {
+        points.Add(RandomVector(random, kExtent));
+    }
+    for (size_t group = 0; group < kDuplicateGroupCount; ++group) {
+        const Vector3 point = points.Get(group * 7);
+        for (size_t i = 1; i < kDuplicateCount; ++i) {
+            points.Add(point);
+        }
+    }
+    return points;
+}
+
+/// @brief 全ての点を調べ、半径の中で条件を満たすものを近い順(同じ距離なら添字の小さい順)にmaxCount個まで求める
+std::vector<Result> BruteForce(const Points &points, const Vector3 &center, float radius, size_t maxCount,
+    const std::function<bool(const Vector3 &)> &filter) {
+    std::vector<Result> results;
+    for (size_t i = 0; i < points.x.size(); ++i) {
+        // SpatialQueryと同じ順番で距離の2乗を求める
+        const float dx = points.x[i] - center.x;
+        const float dy = points.y[i] - center.y;
+        const float dz = points.z[i] - center.z;
+        const float distanceSquared = dx * dx + dy * dy + dz * dz;
+        if (distanceSquared <= radius * radius && filter(points.Get(i))) {
+            results.push_back({ static_cast<uint32_t>(i), distanceSquared });
+        }
+    }
+    std::sort(results.begin(), results.end(), [](const Result &a, const Result &b) {
+        return a.distanceSquared < b.distanceSquared || (a.distanceSquared == b.distanceSquared && a.index < b.index);
+    });
+    results.resize(std::min(results.size(), maxCount));
+    return results;
+}
+
+/// @brief 探索結果が総当たりと同じ点を同じ順番で返すか
+bool IsSameResults(std::span<const Result> results, const std::vector<Result> &expected) {
+    if (results.size() != expected.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i].index != expected[i].index || results[i].distanceSquared != expected[i].distanceSquared) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief 全てのグリッドの作り方・求める数・ランダムな中心と半径で、探索を総当たりと比べる
+/// @param find 探索(中心・半径・出力先を受け取り、見つかった数を返す)
+/// @param filter 総当たりで使う条件(中心を受け取り、点を調べる関数を返す)
+void ExpectSameAsBruteForce(uint32_t seed,
+    const std::function<size_t(const Math::SpatialQuery &, const Vector3 &, float, std::span<Result>)> &find,
+    const std::function<std::function<bool(const Vector3 &)>(const Vector3 &)> &filter) {
+    std::mt19937 random(seed);
+    const Points points = RandomPoints(random);
+    std::uniform_real_distribution<float> distRadius(1.0f, kExtent * 2.0f);
+    for (float cellSize : kCellSizes) {
+        Math::SpatialQuery query;
+        query.Build(points.x, points.y, points.z, cellSize);
+        KASHIPAN_EXPECT_EQ(query.GetPointCount(), points.x.size());
+        for (int i = 0; i < kQueryCount; ++i) {
+            // 中心は点のある範囲の少し外まで、半径は範囲全体を覆う大きさまで選ぶ
+            const Vector3 center = i % 4 == 0 ? points.Get(i) : RandomVector(random, kExtent * 1.2f);
+            const float radius = distRadius(random);
+            for (size_t maxCount : kResultCounts) {
+                std::vector<Result> results(maxCount);
+                const size_t count = find(query, center, radius, results);
+                const std::vector<Result> expected = BruteForce(points, center, radius, maxCount, filter(center));
+                KASHIPAN_EXPECT(IsSameResults(std::span<const Result>(results.data(), count), expected));
+            }
+        }
+    }
+}
+
+} // namespace
+
+KASHIPAN_TEST(SpatialQuery_FindNearestMatchesBruteForce) {
+    ExpectSameAsBruteForce(11,
+        [](const Math::SpatialQuery &query, const Vector3 &center, float radius, std::span<Result> out) {
+            return query.FindNearest(center, radius, out);
+        },
+        [](const Vector3 &) {
+            return [](const Vector3 &) { return true; };
+        });
+}
+
+KASHIPAN_TEST(SpatialQuery_FindNearestInConeMatchesBruteForce) {
+    // 半角が90度より大きい円錐(cosが負)も調べる
+    const Vector3 direction = Vector3(0.3f, -0.5f, 0.8f).Normalize();
+    for (float halfAngle : { 0.3f, 1.2f, 1.5707964f, 2.0f, 2.9f }) {
+        const float cosHalfAngle = std::cos(halfAngle);
+        ExpectSameAsBruteForce(static_cast<uint32_t>(halfAngle * 1000.0f),
+            [&](const Math::SpatialQuery &query, const Vector3 &center, float radius, std::span<Result> out) {
+                return query.FindNearestInCone(center, radius, direction, cosHalfAngle, out);
+            },
+            [&](const Vector3 &center) {
+                // 中心から点への向きと円錐の向きの角度のcosが、半角のcos以上なら中
+                return [&, center](const Vector3 &point) {
+                    const Vector3 offset = point - center;
+                    return offset.Dot(direction) >= cosHalfAngle * offset.Length();
+                };
+            });
+    }
+}
+
+KASHIPAN_TEST(SpatialQuery_FindNearestInFrustumMatchesBruteForce) {
+    const Matrix4x4 viewProjection =
+        MakeViewMatrix(Vector3(5.0f, 10.0f, -60.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f)) *
+        MakePerspectiveFovMatrix(0.6f, 16.0f / 9.0f, 0.1f, 100.0f);
+    ExpectSameAsBruteForce(23,
+        [&](const Math::SpatialQuery &query, const Vector3 &center, float radius, std::span<Result> out) {
+            return query.FindNearestInFrustum(center, radius, viewProjection, out);
+        },
+        [&](const Vector3 &) {
+            // クリップ座標で-w≦x,y≦w、0≦z≦wなら中
+            return [&](const Vector3 &point) {
+                const auto &m = viewProjection.m;
+                const float clip[4] = {
+                    point.x * m[0][0] + point.y * m[1][0] + point.z * m[2][0] + m[3][0],
+                    point.x * m[0][1] + point.y * m[1][1] + point.z * m[2][1] + m[3][1],
+                    point.x * m[0][2] + point.y * m[1][2] + point.z * m[2][2] + m[3][2],
+                    point.x * m[0][3] + point.y * m[1][3] + point.z * m[2][3] + m[3][3],
+                };
+                return std::abs(clip[0]) <= clip[3] && std::abs(clip[1]) <= clip[3] && 0.0f <= clip[2] && clip[2] <= clip[3];
+            };
+        });
+}
+
+KASHIPAN_TEST(SpatialQuery_TiesAreBrokenByIndex) {
+    // 中心から同じ距離にある点は、グリッドのどのセルに入っても添字の小さい順に選ばれる
+    Points points;
+    const Vector3 offsets[] = {
+        { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+        { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f },
+    };
+    // 遠い点を先に、同じ距離の点は添字の大きい順にセルへ入るよう逆の順番で並べる
+    points.Add(Vector3(30.0f, 30.0f, 30.0f));
+    for (int i = 5; i >= 0; --i) {
+        points.Add(offsets[i]);
+    }
+    points.Add(Vector3(0.0f, 0.0f, 1.0f));
+    for (float cellSize : kCellSizes) {
+        Math::SpatialQuery query;
+        query.Build(points.x, points.y, points.z, cellSize);
+        Result results[3];
+        KASHIPAN_REQUIRE(query.FindNearest(Vector3(0.0f, 0.0f, 0.0f), 2.0f, results) == 3u);
+        KASHIPAN_EXPECT_EQ(results[0].index, 1u);
+        KASHIPAN_EXPECT_EQ(results[1].index, 2u);
+        KASHIPAN_EXPECT_EQ(results[2].index, 3u);
+        for (const Result &result : results) {
+            KASHIPAN_EXPECT_EQ(result.distanceSquared, 1.0f);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <vector>
+
+#include "Test.h"
+#include "Common/SpriteOrder.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief テクスチャとレイヤーだけを指定したスプライトの情報を作る
+SpriteSortKey MakeKey(int textureIndex, int layer = 0) {
+    SpriteSortKey key;
+    key.textureIndex = textureIndex;
+    key.layer = layer;
+    return key;
+}
+
+/// @brief 範囲が並べ替えた後のスプライトを隙間なく順番に覆っているか
+bool IsCoveredInOrder(const std::vector<SpriteRange> &ranges, uint32_t count) {
+    uint32_t next = 0;
+    for (const SpriteRange &range : ranges) {
+        if (range.first != next || range.count == 0) {
+            return false;
+        }
+        next += range.count;
+    }
+    return next == count;
+}
+
+} // namespace
+
+KASHIPAN_TEST(Sprite_SubmissionOrderKeepsOverlappingSpritesInCallOrder) {
+    // 同じレイヤーで違うテクスチャのスプライトが交互に重なっていても、呼んだ順に描く
+    const std::vector<SpriteSortKey> keys = { MakeKey(1), MakeKey(0), MakeKey(1), MakeKey(0) };
+    std::vector<uint32_t> order;
+    std::vector<SpriteRange> ranges;
+    SpriteOrder::Build(keys, {}, SpriteSortMode::kSubmissionOrder, order, ranges);
+
+    KASHIPAN_EXPECT((order == std::vector<uint32_t>{ 0, 1, 2, 3 }));
+    KASHIPAN_EXPECT_EQ(ranges.size(), 4u);
+    KASHIPAN_EXPECT(IsCoveredInOrder(ranges, 4));
+}
+
+KASHIPAN_TEST(Sprite_SubmissionOrderMergesAdjacentCompatibleSprites) {
+    std::vector<SpriteSortKey> keys = { MakeKey(0), MakeKey(0), MakeKey(0), MakeKey(1), MakeKey(1), MakeKey(0) };
+    // 色が違うものはまとめない
+    keys.push_back(MakeKey(0));
+    keys.back().color = { 255.0f, 0.0f, 0.0f, 255.0f };
+    std::vector<uint32_t> order;
+    std::vector<SpriteRange> ranges;
+    SpriteOrder::Build(keys, {}, SpriteSortMode::kSubmissionOrder, order, ranges);
+
+    KASHIPAN_REQUIRE(ranges.size() == 4u);
+    KASHIPAN_EXPECT_EQ(ranges[0].count, 3u);
+    KASHIPAN_EXPECT_EQ(ranges[1].count, 2u);
+    KASHIPAN_EXPECT_EQ(ranges[2].count, 1u);
+    KASHIPAN_EXPECT_EQ(ranges[3].count, 1u);
+    KASHIPAN_EXPECT(IsCoveredInOrder(ranges, static_cast<uint32_t>(keys.size())));
+}
+
+KASHIPAN_TEST(Sprite_LayersSortStably) {
+    // レイヤーが小さいものを先に描き、同じレイヤーの中は呼んだ順を保つ
+    const std::vector<SpriteSortKey> keys = { MakeKey(0, 1), MakeKey(1, 0), MakeKey(2, 1), MakeKey(3, 0) };
+    std::vector<uint32_t> order;
+    std::vector<SpriteRange> ranges;
+    SpriteOrder::Build(keys, {}, SpriteSortMode::kSubmissionOrder, order, ranges);
+
+    KASHIPAN_EXPECT((order == std::vector<uint32_t>{ 1, 3, 0, 2 }));
+    KASHIPAN_EXPECT(IsCoveredInOrder(ranges, 4));
+}
+
+KASHIPAN_TEST(Sprite_TextureModeGroupsByTexture) {
+    // 明示的に指定した時だけテクスチャでまとめる。同じテクスチャの中は呼んだ順を保つ
+    const std::vector<SpriteSortKey> keys = { MakeKey(1), MakeKey(0), MakeKey(1), MakeKey(0) };
+    std::vector<uint32_t> order;
+    std::vector<SpriteRange> ranges;
+    SpriteOrder::Build(keys, {}, SpriteSortMode::kTexture, order, ranges);
+
+    KASHIPAN_EXPECT((order == std::vector<uint32_t>{ 1, 3, 0, 2 }));
+    KASHIPAN_REQUIRE(ranges.size() == 2u);
+    KASHIPAN_EXPECT_EQ(ranges[0].count, 2u);
+    KASHIPAN_EXPECT_EQ(ranges[1].count, 2u);
+}
+
+KASHIPAN_TEST(Sprite_RangesNeverCrossBreaks) {
+    // 区切りの間に別の2Dオブジェクトを描くので、区切りをまたいで並べ替えたりまとめたりしない
+    const std::vector<SpriteSortKey> keys = { MakeKey(1, 1), MakeKey(0), MakeKey(0), MakeKey(0, 1), MakeKey(0) };
+    const std::vector<uint32_t> breaks = { 2, 2, 4 };
+    for (SpriteSortMode mode : { SpriteSortMode::kSubmissionOrder, SpriteSortMode::kTexture }) {
+        std::vector<uint32_t> order;
+        std::vector<SpriteRange> ranges;
+        SpriteOrder::Build(keys, breaks, mode, order, ranges);
+
+        KASHIPAN_EXPECT((order == std::vector<uint32_t>{ 1, 0, 2, 3, 4 }));
+        KASHIPAN_EXPECT(IsCoveredInOrder(ranges, 5));
+        for (const SpriteRange &range : ranges) {
+            for (uint32_t b : breaks) {
+                KASHIPAN_EXPECT(b <= range.first || range.first + range.count <= b);
+            }
+        }
+    }
+}
+
+KASHIPAN_TEST(Sprite_EmptyInputMakesNoRanges) {
+    std::vector<uint32_t> order = { 5 };
+    std::vector<SpriteRange> ranges = { SpriteRange{ 0, 1 } };
+    SpriteOrder::Build({}, {}, SpriteSortMode::kSubmissionOrder, order, ranges);
+    KASHIPAN_EXPECT(order.empty());
+    KASHIPAN_EXPECT(ranges.empty());
+}
\ No newline at end of file
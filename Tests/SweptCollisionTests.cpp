@@ -0,0 +1,301 @@
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "Test.h"
+#include "BulletStore.h"
+#include "CollisionManager.h"
+#include "Math/Broadphase.h"
+#include "Math/Collider.h"
+#include "Math/MathObjects/AABB.h"
+#include "Math/MathObjects/Sphere.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 試すフレームレート
+constexpr float kFrameRates[] = { 60.0f, 30.0f, 10.0f };
+// 弾の速さと半径(1フレームで的の大きさの何十倍も進む)
+constexpr float kBulletSpeed = 1000.0f;
+constexpr float kBulletRadius = 0.1f;
+// 弾の最初の位置(的の手前。どのフレームレートでもフレームの終わりの位置が的に重ならないようにずらしてある)
+constexpr float kStartX = -47.9f;
+// 弾を進める時間
+constexpr float kFlightTime = 0.2f;
+// 薄い的(球の半径と、壁のAABBの厚さの半分)
+constexpr float kTargetRadius = 0.2f;
+constexpr float kWallHalfThickness = 0.05f;
+// 接触した時刻の許容誤差(秒。1000u/sで1mm)
+constexpr double kTimeTolerance = 1e-6;
+
+/// @brief 1フレームの移動
+struct Step {
+    Vector3 start;
+    Vector3 move;
+};
+
+/// @brief 弾をフレームごとに進めた時の移動を列挙する
+/// @param start 最初の位置
+/// @param direction 進む方向(正規化済み)
+/// @param deltaTime 1フレームの時間
+std::vector<Step> MakeSteps(const Vector3 &start, const Vector3 &direction, float deltaTime) {
+    std::vector<Step> steps;
+    const Vector3 move = direction * (kBulletSpeed * deltaTime);
+    Vector3 position = start;
+    const int frameCount = static_cast<int>(std::ceil(kFlightTime / deltaTime));
+    for (int frame = 0; frame < frameCount; ++frame) {
+        steps.push_back(Step{ position, move });
+        position += move;
+    }
+    return steps;
+}
+
+/// @brief 最初に接触したフレームの時刻と接触した時刻を求める
+/// @param steps フレームごとの移動
+/// @param deltaTime 1フレームの時間
+/// @param sweepTest 1フレームの移動を受け取り、接触すれば時刻(移動に対する割合)を書き込んでtrueを返す
+/// @param outHitCount 接触したフレームの数の出力先
+/// @return 最初に接触した時刻(秒。接触しなければ負の値)
+template <class SweepTest>
+double FindFirstHitTime(const std::vector<Step> &steps, float deltaTime, SweepTest sweepTest, int &outHitCount) {
+    double firstTime = -1.0;
+    outHitCount = 0;
+    for (size_t frame = 0; frame < steps.size(); ++frame) {
+        float time = 0.0f;
+        if (sweepTest(steps[frame], time)) {
+            if (outHitCount++ == 0) {
+                firstTime = (static_cast<double>(frame) + time) * deltaTime;
+            }
+        }
+    }
+    return firstTime;
+}
+
+/// @brief フレームの終わりの位置だけで判定した場合に接触するフレームの数(すり抜けることを確かめる)
+template <class StaticTest>
+int CountStaticHits(const std::vector<Step> &steps, StaticTest staticTest) {
+    int hitCount = 0;
+    for (const Step &step : steps) {
+        hitCount += staticTest(Math::Sphere(step.start + step.move, kBulletRadius)) ? 1 : 0;
+    }
+    return hitCount;
+}
+
+/// @brief 位置と半径だけを持ち、OnCollisionの回数を数える衝突判定オブジェクト
+class TestCollider : public Collider {
+public:
+    TestCollider(const Vector3 &position, float radius, uint32_t attribute, uint32_t mask) : position_(position) {
+        SetRadius(radius);
+        SetCollisionAttribute(attribute);
+        SetCollisionMask(mask);
+    }
+
+    void OnCollision() override {
+        ++hitCount_;
+    }
+    Vector3 GetWorldPosition() override {
+        return position_;
+    }
+    void SetPosition(const Vector3 &position) {
+        position_ = position;
+    }
+    int GetHitCount() const {
+        return hitCount_;
+    }
+
+private:
+    Vector3 position_;
+    int hitCount_ = 0;
+};
+
+template <class T>
+CollisionManager::BroadphaseFactory MakeBroadphaseFactory() {
+    return []() { return std::make_unique<T>(); };
+}
+
+} // namespace
+
+KASHIPAN_TEST(Collision_SweptSphereHitsThinSphereAtEveryFrameRate) {
+    const Math::Sphere target(Vector3(0.0f, 0.0f, 0.0f), kTargetRadius);
+    const Vector3 direction(1.0f, 0.0f, 0.0f);
+    // 中心間の距離が半径の和になった時に接触する
+    const double expectedTime = (-kStartX - (kBulletRadius + kTargetRadius)) / kBulletSpeed;
+    for (float frameRate : kFrameRates) {
+        const float deltaTime = 1.0f / frameRate;
+        const std::vector<Step> steps = MakeSteps(Vector3(kStartX, 0.0f, 0.0f), direction, deltaTime);
+        KASHIPAN_EXPECT_EQ(CountStaticHits(steps, [&](const Math::Sphere &bullet) {
+            return Math::Collider::IsCollision(bullet, target);
+            }), 0);
+
+        int hitCount = 0;
+        const double time = FindFirstHitTime(steps, deltaTime, [&](const Step &step, float &outTime) {
+            return Math::Collider::IsCollision(Math::Sphere(step.start, kBulletRadius), step.move,
+                target, Vector3(0.0f, 0.0f, 0.0f), outTime);
+            }, hitCount);
+        KASHIPAN_EXPECT_EQ(hitCount, 1);
+        KASHIPAN_EXPECT_NEAR(time, expectedTime, kTimeTolerance);
+    }
+}
+
+KASHIPAN_TEST(Collision_SweptSphereHitsMovingSphere) {
+    // 的も弾に向かって動いている場合は、相対的な速さで接触する時刻が決まる
+    const Vector3 targetVelocity(-200.0f, 0.0f, 0.0f);
+    const double expectedTime = (-kStartX - (kBulletRadius + kTargetRadius)) / (kBulletSpeed - targetVelocity.x);
+    for (float frameRate : kFrameRates) {
+        const float deltaTime = 1.0f / frameRate;
+        const std::vector<Step> steps = MakeSteps(Vector3(kStartX, 0.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f), deltaTime);
+        int hitCount = 0;
+        size_t frame = 0;
+        const double time = FindFirstHitTime(steps, deltaTime, [&](const Step &step, float &outTime) {
+            const Vector3 targetMove = targetVelocity * deltaTime;
+            const Math::Sphere target(targetMove * static_cast<float>(frame++), kTargetRadius);
+            return Math::Collider::IsCollision(Math::Sphere(step.start, kBulletRadius), step.move,
+                target, targetMove, outTime);
+            }, hitCount);
+        KASHIPAN_EXPECT_EQ(hitCount, 1);
+        KASHIPAN_EXPECT_NEAR(time, expectedTime, kTimeTolerance);
+    }
+}
+
+KASHIPAN_TEST(Collision_SweptSphereHitsThinWallAtEveryFrameRate) {
+    const Math::AABB wall(Vector3(-kWallHalfThickness, -5.0f, -5.0f), Vector3(kWallHalfThickness, 5.0f, 5.0f));
+    // 少し斜めに進み、壁の面に当たる
+    const Vector3 direction = Vector3(1.0f, 0.02f, -0.01f).Normalize();
+    const double expectedTime = (-kStartX - (kBulletRadius + kWallHalfThickness)) / (kBulletSpeed * direction.x);
+    for (float frameRate : kFrameRates) {
+        const float deltaTime = 1.0f / frameRate;
+        const std::vector<Step> steps = MakeSteps(Vector3(kStartX, 0.0f, 0.0f), direction, deltaTime);
+        KASHIPAN_EXPECT_EQ(CountStaticHits(steps, [&](const Math::Sphere &bullet) {
+            return Math::Collider::IsCollision(wall, bullet);
+            }), 0);
+
+        int hitCount = 0;
+        const double time = FindFirstHitTime(steps, deltaTime, [&](const Step &step, float &outTime) {
+            return Math::Collider::IsCollision(Math::Sphere(step.start, kBulletRadius), step.move, wall, outTime);
+            }, hitCount);
+        KASHIPAN_EXPECT_EQ(hitCount, 1);
+        KASHIPAN_EXPECT_NEAR(time, expectedTime, kTimeTolerance);
+    }
+}
+
+KASHIPAN_TEST(Collision_SweptSphereUsesRoundedAABBEdges) {
+    const Math::AABB box(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f));
+    constexpr float kRadius = 0.5f;
+    for (float frameRate : kFrameRates) {
+        const float deltaTime = 1.0f / frameRate;
+        // 辺(y = z = 1)から0.636離れて通る。半径の分だけ広げたAABBには入るが、丸めた辺には触れない
+        const std::vector<Step> missSteps = MakeSteps(Vector3(kStartX, 1.45f, 1.45f), Vector3(1.0f, 0.0f, 0.0f), deltaTime);
+        int hitCount = 0;
+        FindFirstHitTime(missSteps, deltaTime, [&](const Step &step, float &outTime) {
+            return Math::Collider::IsCollision(Math::Sphere(step.start, kRadius), step.move, box, outTime);
+            }, hitCount);
+        KASHIPAN_EXPECT_EQ(hitCount, 0);
+
+        // 辺から0.424離れて通るので、角(-1, 1, 1)の丸みに当たる
+        const float offset = 1.3f;
+        const std::vector<Step> hitSteps = MakeSteps(Vector3(kStartX, offset, offset), Vector3(1.0f, 0.0f, 0.0f), deltaTime);
+        const double distanceToEdge = std::sqrt(2.0) * (offset - 1.0);
+        const double contactX = -1.0 - std::sqrt(kRadius * kRadius - distanceToEdge * distanceToEdge);
+        const double expectedTime = (contactX - kStartX) / kBulletSpeed;
+        const double time = FindFirstHitTime(hitSteps, deltaTime, [&](const Step &step, float &outTime) {
+            return Math::Collider::IsCollision(Math::Sphere(step.start, kRadius), step.move, box, outTime);
+            }, hitCount);
+        KASHIPAN_EXPECT_EQ(hitCount, 1);
+        KASHIPAN_EXPECT_NEAR(time, expectedTime, kTimeTolerance);
+    }
+}
+
+KASHIPAN_TEST(Collision_ManagerReportsFastBulletAtEveryFrameRate) {
+    constexpr uint32_t kBulletAttribute = 0b01;
+    constexpr uint32_t kTargetAttribute = 0b10;
+    const double expectedTime = (-kStartX - (kBulletRadius + kTargetRadius)) / kBulletSpeed;
+    const CollisionManager::BroadphaseFactory factories[] = {
+        MakeBroadphaseFactory<Math::SweepAndPruneBroadphase>(),
+        MakeBroadphaseFactory<Math::HashGridBroadphase>(),
+    };
+    for (const auto &factory : factories) {
+        for (float frameRate : kFrameRates) {
+            const float deltaTime = 1.0f / frameRate;
+            TestCollider bullet(Vector3(kStartX, 0.0f, 0.0f), kBulletRadius, kBulletAttribute, kTargetAttribute);
+            TestCollider target(Vector3(0.0f, 0.0f, 0.0f), kTargetRadius, kTargetAttribute, kBulletAttribute);
+            CollisionManager manager;
+            manager.SetBroadphase(factory);
+            manager.RegisterCollider(&bullet);
+            manager.RegisterCollider(&target);
+            // 最初のUpdateは移動前の位置を覚えるだけ
+            manager.Update();
+
+            const std::vector<Step> steps = MakeSteps(Vector3(kStartX, 0.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f), deltaTime);
+            int hitFrameCount = 0;
+            double time = -1.0;
+            float depth = -1.0f;
+            for (size_t frame = 0; frame < steps.size(); ++frame) {
+                bullet.SetPosition(steps[frame].start + steps[frame].move);
+                manager.Update();
+                const auto &contacts = manager.GetContacts();
+                if (!contacts.empty()) {
+                    if (hitFrameCount++ == 0) {
+                        time = (static_cast<double>(frame) + contacts.front().time) * deltaTime;
+                        depth = contacts.front().depth;
+                    }
+                }
+            }
+            KASHIPAN_EXPECT_EQ(hitFrameCount, 1);
+            KASHIPAN_EXPECT_EQ(bullet.GetHitCount(), 1);
+            KASHIPAN_EXPECT_EQ(target.GetHitCount(), 1);
+            KASHIPAN_EXPECT_NEAR(time, expectedTime, kTimeTolerance);
+            // フレームの終わりには通り過ぎているので、めり込みは無い
+            KASHIPAN_EXPECT_EQ(depth, 0.0f);
+        }
+    }
+}
+
+KASHIPAN_TEST(Collision_BulletStoreSweepsMovingTargets) {
+    constexpr float kDeltaTime = 1.0f / 60.0f;
+    constexpr float kRadius = 0.3f;
+    // 弾は1フレームでx=-5からx=5へ進む
+    BulletStore bullets;
+    bullets.Spawn(Vector3(-5.0f, 0.0f, 0.0f), Vector3(600.0f, 0.0f, 0.0f), kRadius, 1.0f, BulletStore::State::kStraight,
+        Vector4(255.0f, 255.0f, 255.0f, 255.0f));
+    bullets.Update(kDeltaTime);
+
+    // 0: 弾の経路を横切り、弾がx=-2を通る時にちょうどそこにいる(前の位置でも今の位置でも経路から離れている)
+    // 1: 弾がx=3を通った後に経路に入る(今の位置だけで判定すると当たってしまう)
+    TestCollider crossing(Vector3(-2.0f, 0.0f, -3.0f), kRadius, 0b01, 0b10);
+    TestCollider late(Vector3(3.0f, 0.0f, -10.0f), kRadius, 0b01, 0b10);
+    CollisionManager manager;
+    manager.RegisterCollider(&crossing);
+    manager.RegisterCollider(&late);
+    manager.Update();
+    crossing.SetPosition(Vector3(-2.0f, 0.0f, 7.0f));
+    late.SetPosition(Vector3(3.0f, 0.0f, 0.0f));
+    manager.Update();
+
+    std::vector<float> x, y, z, radius;
+    std::vector<Vector3> previousPositions;
+    std::vector<Vector3> currentPositions;
+    for (TestCollider *target : { &crossing, &late }) {
+        const Vector3 position = target->GetWorldPosition();
+        x.push_back(position.x);
+        y.push_back(position.y);
+        z.push_back(position.z);
+        radius.push_back(target->GetRadius());
+        previousPositions.push_back(manager.GetSweepStart(target));
+        currentPositions.push_back(position);
+    }
+    KASHIPAN_EXPECT_EQ(previousPositions[0].z, -3.0f);
+    KASHIPAN_EXPECT_EQ(previousPositions[1].z, -10.0f);
+    const Math::SphereSoA targets{ x, y, z, radius };
+
+    std::vector<Math::CollisionPair> hits;
+    bullets.FindHits(targets, previousPositions, hits);
+    KASHIPAN_REQUIRE(hits.size() == 1);
+    KASHIPAN_EXPECT_EQ(hits[0].indexA, 0u);
+    KASHIPAN_EXPECT_EQ(hits[0].indexB, 0u);
+
+    // 相手を今の位置で止まっているとみなすと、当たる相手が入れ替わってしまう
+    bullets.FindHits(targets, currentPositions, hits);
+    KASHIPAN_REQUIRE(hits.size() == 1);
+    KASHIPAN_EXPECT_EQ(hits[0].indexB, 1u);
+}
\ No newline at end of file
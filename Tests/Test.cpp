@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "Test.h"
+
+namespace KashipanEngine {
+
+namespace Test {
+
+namespace {
+
+struct Entry {
+    std::string name;
+    std::function<void()> function;
+};
+
+// 静的初期化の順番に依存しないよう、関数内staticで持つ
+std::vector<Entry> &GetEntries() {
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+// 実行中のテストで記録した失敗の数
+int sFailureCount = 0;
+
+} // namespace
+
+bool Register(const char *name, std::function<void()> function) {
+    GetEntries().push_back({ name, std::move(function) });
+    return true;
+}
+
+void Fail(const char *expression, const std::string &detail, const char *file, int line) {
+    ++sFailureCount;
+    if (detail.empty()) {
+        std::printf("  %s:%d: failed: %s\n", file, line, expression);
+    } else {
+        std::printf("  %s:%d: failed: %s (%s)\n", file, line, expression, detail.c_str());
+    }
+}
+
+int RunAll(int argc, char **argv) {
+    std::string_view filter;
+    bool isListOnly = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg.starts_with("--filter=")) {
+            filter = arg.substr(std::strlen("--filter="));
+        } else if (arg == "--list") {
+            isListOnly = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter=<prefix>] [--list]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    auto &entries = GetEntries();
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.name < b.name; });
+
+    int runCount = 0;
+    std::vector<std::string> failedNames;
+    for (const auto &entry : entries) {
+        if (!entry.name.starts_with(filter)) {
+            continue;
+        }
+        if (isListOnly) {
+            std::printf("%s\n", entry.name.c_str());
+            continue;
+        }
+
+        std::printf("[ RUN    ] %s\n", entry.name.c_str());
+        std::fflush(stdout);
+        sFailureCount = 0;
+        entry.function();
+        ++runCount;
+        if (sFailureCount == 0) {
+            std::printf("[     OK ] %s\n", entry.name.c_str());
+        } else {
+            std::printf("[ FAILED ] %s (%d failures)\n", entry.name.c_str(), sFailureCount);
+            failedNames.push_back(entry.name);
+        }
+        std::fflush(stdout);
+    }
+    if (isListOnly) {
+        return 0;
+    }
+
+    // フィルタの書き間違いで1つも実行せずに成功しないようにする
+    if (runCount == 0) {
+        std::printf("no tests matched the filter \"%.*s\"\n", static_cast<int>(filter.size()), filter.data());
+        return 1;
+    }
+    std::printf("%d tests, %zu failed\n", runCount, failedNames.size());
+    for (const std::string &name : failedNames) {
+        std::printf("  %s\n", name.c_str());
+    }
+    return failedNames.empty() ? 0 : 1;
+}
+
+} // namespace Test
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+/*
+CPUだけで動くモジュール(Math / 衝突判定 / JobSystem / テクスチャの読み込みなど)のテスト。
+  KASHIPAN_TEST(名前) { KASHIPAN_EXPECT(条件); ... }
+の形で書くと自動で登録される。テスト名は「グループ_内容」にし、CMakeLists.txtではグループごとにctestへ登録する。
+  KASHIPAN_EXPECT(条件)                : 条件が偽なら失敗を記録して続ける
+  KASHIPAN_EXPECT_EQ(a, b)             : a == b でなければ失敗を記録して続ける(数値なら両方の値を出力する)
+  KASHIPAN_EXPECT_NEAR(a, b, 許容誤差) : |a - b| <= 許容誤差 でなければ失敗を記録して続ける
+  KASHIPAN_REQUIRE(条件)               : 条件が偽なら失敗を記録してテストを抜ける(続けると落ちる場合に使う)
+1つでも失敗したテストがあれば終了コードを1にする。
+*/
+
+#define KASHIPAN_TEST_CONCAT_IMPL(a, b) a##b
+#define KASHIPAN_TEST_CONCAT(a, b) KASHIPAN_TEST_CONCAT_IMPL(a, b)
+
+/// @brief テストを定義して登録する
+#define KASHIPAN_TEST(name)                                                                         \
+    static void name();                                                                             \
+    static const bool KASHIPAN_TEST_CONCAT(kRegistered_, name) =                                   \
+        KashipanEngine::Test::Register(#name, name);                                                \
+    static void name()
+
+#define KASHIPAN_EXPECT(condition) \
+    KashipanEngine::Test::Expect(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+#define KASHIPAN_EXPECT_EQ(a, b) \
+    KashipanEngine::Test::ExpectEqual((a), (b), #a " == " #b, __FILE__, __LINE__)
+#define KASHIPAN_EXPECT_NEAR(a, b, tolerance) \
+    KashipanEngine::Test::ExpectNear((a), (b), (tolerance), #a " ~= " #b, __FILE__, __LINE__)
+#define KASHIPAN_REQUIRE(condition) \
+    if (!KASHIPAN_EXPECT(condition)) return
+
+namespace KashipanEngine {
+
+namespace Test {
+
+/// @brief テストを登録する
+/// @param name テスト名
+/// @param function テスト本体
+/// @return 登録できたかどうか(静的初期化で呼ぶための戻り値)
+bool Register(const char *name, std::function<void()> function);
+
+/// @brief 登録したテストを実行して結果を出力する
+/// @param argc コマンドライン引数の数
+/// @param argv コマンドライン引数
+/// @return 終了コード(全て成功なら0)
+int RunAll(int argc, char **argv);
+
+/// @brief 失敗を記録する
+/// @param expression 失敗した式
+/// @param detail 値などの補足(無ければ空)
+/// @param file ファイル名
+/// @param line 行番号
+void Fail(const char *expression, const std::string &detail, const char *file, int line);
+
+/// @brief 条件を調べ、偽なら失敗を記録する
+/// @return 条件
+inline bool Expect(bool condition, const char *expression, const char *file, int line) {
+    if (!condition) {
+        Fail(expression, std::string(), file, line);
+    }
+    return condition;
+}
+
+/// @brief 値を出力用の文字列にする(出力できない型は空)
+template<typename T>
+std::string ToString(const T &value) {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>) {
+        std::ostringstream stream;
+        stream.precision(9);
+        if constexpr (std::is_enum_v<T>) {
+            stream << static_cast<std::underlying_type_t<T>>(value);
+        } else if constexpr (std::is_same_v<T, uint8_t> || std::is_same_v<T, int8_t>) {
+            stream << static_cast<int>(value);
+        } else {
+            stream << value;
+        }
+        return stream.str();
+    } else {
+        return std::string();
+    }
+}
+
+/// @brief a == b を調べ、違えば両方の値と一緒に失敗を記録する
+template<typename A, typename B>
+bool ExpectEqual(const A &a, const B &b, const char *expression, const char *file, int line) {
+    const bool isEqual = a == b;
+    if (!isEqual) {
+        const std::string valueA = ToString(a);
+        const std::string valueB = ToString(b);
+        Fail(expression, valueA.empty() && valueB.empty() ? std::string() : valueA + " vs " + valueB, file, line);
+    }
+    return isEqual;
+}
+
+/// @brief |a - b| <= tolerance を調べ、外れていれば値と一緒に失敗を記録する
+inline bool ExpectNear(double a, double b, double tolerance, const char *expression, const char *file, int line) {
+    const bool isNear = std::abs(a - b) <= tolerance;
+    if (!isNear) {
+        Fail(expression, ToString(a) + " vs " + ToString(b) + " (tolerance " + ToString(tolerance) + ")", file, line);
+    }
+    return isNear;
+}
+
+} // namespace Test
+
+} // namespace KashipanEngine
\ No newline at end of file
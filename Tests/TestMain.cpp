@@ -0,0 +1,5 @@
+#include "Test.h"
+
+int main(int argc, char **argv) {
+    return KashipanEngine::Test::RunAll(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "Common/TextureResidency.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 乱数で動かす場面のテクスチャの数・フレーム数・追い出すまでのフレーム数
+constexpr uint32_t kSimulationTextureCount = 64;
+constexpr int kSimulationFrameCount = 600;
+constexpr uint32_t kSimulationIdleFrames = 3;
+
+/// @brief フレームを進め、追い出されたテクスチャのIDを返す
+std::vector<uint32_t> EndFrame(TextureResidency &residency) {
+    std::vector<uint32_t> evictedIds;
+    residency.EndFrame(evictedIds);
+    return evictedIds;
+}
+
+/// @brief 溜まっている読み込み直しの要求を取り出し、全て読み込み直したことにする
+std::vector<uint32_t> ReloadRequested(TextureResidency &residency) {
+    std::vector<uint32_t> reloadIds;
+    residency.TakeReloadRequests(reloadIds);
+    for (uint32_t id : reloadIds) {
+        residency.MarkResident(id);
+    }
+    return reloadIds;
+}
+
+} // namespace
+
+KASHIPAN_TEST(Texture_ResidencyEvictsLeastRecentlyUsedFirst) {
+    TextureResidency residency;
+    residency.SetBudget(1000, 2);
+    residency.Register(0, 400, true);
+    residency.Register(1, 300, false);
+    residency.Register(2, 300, false);
+    residency.Register(3, 200, false);
+    residency.Register(4, 200, false);
+    KASHIPAN_EXPECT_EQ(residency.GetResidentBytes(), 1400ull);
+
+    // フレーム0: 全て使う。予算を超えていても直近に使ったものは追い出さない
+    for (uint32_t id = 0; id < 5; ++id) {
+        KASHIPAN_EXPECT(!residency.Touch(id));
+    }
+    KASHIPAN_EXPECT(EndFrame(residency).empty());
+
+    // フレーム1: 2と3を使う
+    KASHIPAN_EXPECT(!residency.Touch(2));
+    KASHIPAN_EXPECT(!residency.Touch(3));
+    KASHIPAN_EXPECT(EndFrame(residency).empty());
+
+    // フレーム2: 3を使う。フレーム0から使われていない1と4が古い順(同じならID順)に追い出される。固定した0は残る
+    KASHIPAN_EXPECT(!residency.Touch(3));
+    KASHIPAN_EXPECT(EndFrame(residency) == (std::vector<uint32_t>{ 1, 4 }));
+    KASHIPAN_EXPECT_EQ(residency.GetResidentBytes(), 900ull);
+    KASHIPAN_EXPECT(residency.IsResident(0));
+    KASHIPAN_EXPECT(!residency.IsResident(1));
+    KASHIPAN_EXPECT(!residency.IsResident(4));
+
+    // フレーム3: 追い出された1を何度使っても、読み込み直しの要求は1回だけ
+    KASHIPAN_EXPECT(residency.Touch(1));
+    KASHIPAN_EXPECT(residency.Touch(1));
+    KASHIPAN_EXPECT(ReloadRequested(residency) == (std::vector<uint32_t>{ 1 }));
+    KASHIPAN_EXPECT(ReloadRequested(residency).empty());
+    KASHIPAN_EXPECT(!residency.Touch(1));
+    KASHIPAN_EXPECT_EQ(residency.GetResidentBytes(), 1200ull);
+
+    // 予算に収まるまでなので、フレーム1に使った2だけが追い出され、フレーム2に使った3は残る
+    KASHIPAN_EXPECT(EndFrame(residency) == (std::vector<uint32_t>{ 2 }));
+    KASHIPAN_EXPECT_EQ(residency.GetResidentBytes(), 900ull);
+    KASHIPAN_EXPECT(residency.IsResident(3));
+}
+
+KASHIPAN_TEST(Texture_ResidencyWithoutBudgetNeverEvicts) {
+    TextureResidency residency;
+    residency.SetBudget(0, 0);
+    for (uint32_t id = 0; id < 8; ++id) {
+        residency.Register(id, 1ull << 20, false);
+    }
+    for (int frame = 0; frame < 100; ++frame) {
+        KASHIPAN_EXPECT(EndFrame(residency).empty());
+    }
+    KASHIPAN_EXPECT_EQ(residency.GetResidentBytes(), 8ull << 20);
+}
+
+KASHIPAN_TEST(Texture_ResidencyMatchesModelOnSyntheticFrames) {
+    std::mt19937 random(24680);
+    std::uniform_int_distribution<uint64_t> distSize(1, 64);
+    std::uniform_real_distribution<float> dist01(0.0f, 1.0f);
+
+    // 大きさがばらばらなテクスチャを登録する。0番はデフォルトのテクスチャと同じく固定する
+    TextureResidency residency;
+    std::vector<uint64_t> sizes(kSimulationTextureCount);
+    uint64_t totalBytes = 0;
+    for (uint32_t id = 0; id < kSimulationTextureCount; ++id) {
+        sizes[id] = distSize(random) * 1024;
+        totalBytes += sizes[id];
+        residency.Register(id, sizes[id], id == 0);
+    }
+    const uint64_t budget = totalBytes * 2 / 5;
+    residency.SetBudget(budget, kSimulationIdleFrames);
+
+    // 期待する状態を別に持ち、フレームごとに比べる
+    std::vector<uint64_t> lastUsedFrames(kSimulationTextureCount, 0);
+    std::vector<bool> isResident(kSimulationTextureCount, true);
+    std::vector<uint32_t> expectedReloadIds;
+    uint64_t evictedCount = 0;
+    uint64_t reloadCount = 0;
+
+    for (uint64_t frame = 0; frame < kSimulationFrameCount; ++frame) {
+        KASHIPAN_REQUIRE(residency.GetFrame() == frame);
+
+        // フレームの始め: 前のフレームで追い出されていて使われたものを、使われた順に1回ずつ読み込み直す
+        KASHIPAN_EXPECT(ReloadRequested(residency) == expectedReloadIds);
+        for (uint32_t id : expectedReloadIds) {
+            isResident[id] = true;
+        }
+        reloadCount += expectedReloadIds.size();
+        expectedReloadIds.clear();
+
+        // 使うテクスチャの範囲を時間とともにずらし、ときどき範囲の外も使う
+        const uint32_t windowStart = static_cast<uint32_t>(frame / 40) * 7 % kSimulationTextureCount;
+        for (uint32_t i = 0; i < kSimulationTextureCount; ++i) {
+            const uint32_t id = (windowStart + i) % kSimulationTextureCount;
+            const float useRate = i < 12 ? 0.8f : 0.03f;
+            if (dist01(random) >= useRate) {
+                continue;
+            }
+            KASHIPAN_EXPECT_EQ(residency.Touch(id), !isResident[id]);
+            lastUsedFrames[id] = frame;
+            if (!isResident[id] &&
+                std::find(expectedReloadIds.begin(), expectedReloadIds.end(), id) == expectedReloadIds.end()) {
+                expectedReloadIds.push_back(id);
+            }
+        }
+
+        uint64_t residentBytesBefore = 0;
+        for (uint32_t id = 0; id < kSimulationTextureCount; ++id) {
+            residentBytesBefore += isResident[id] ? sizes[id] : 0;
+        }
+
+        // フレームの終わり: 追い出されたものが条件を満たし、古い順で、予算に収まったところで止まっているか
+        const std::vector<uint32_t> evictedIds = EndFrame(residency);
+        uint64_t residentBytes = residentBytesBefore;
+        for (size_t i = 0; i < evictedIds.size(); ++i) {
+            const uint32_t id = evictedIds[i];
+            KASHIPAN_REQUIRE(id < kSimulationTextureCount);
+            KASHIPAN_EXPECT(isResident[id]);
+            KASHIPAN_EXPECT(id != 0);
+            KASHIPAN_EXPECT(lastUsedFrames[id] + kSimulationIdleFrames < frame + 1);
+            if (i > 0) {
+                const uint32_t previous = evictedIds[i - 1];
+                KASHIPAN_EXPECT(lastUsedFrames[previous] < lastUsedFrames[id] ||
+                    (lastUsedFrames[previous] == lastUsedFrames[id] && previous < id));
+            }
+            // 追い出す前はまだ予算を超えていた(追い出し過ぎていない)
+            KASHIPAN_EXPECT(residentBytes > budget);
+            isResident[id] = false;
+            residentBytes -= sizes[id];
+        }
+        evictedCount += evictedIds.size();
+
+        KASHIPAN_EXPECT_EQ(residency.GetResidentBytes(), residentBytes);
+        if (residentBytes > budget) {
+            // 予算を超えたままなら、追い出せるものは残っていない
+            for (uint32_t id = 1; id < kSimulationTextureCount; ++id) {
+                KASHIPAN_EXPECT(!isResident[id] || lastUsedFrames[id] + kSimulationIdleFrames >= frame + 1);
+            }
+        } else if (!evictedIds.empty()) {
+            // 残っている候補は全て、最後に追い出したものより新しい
+            const uint32_t last = evictedIds.back();
+            for (uint32_t id = 1; id < kSimulationTextureCount; ++id) {
+                if (isResident[id] && lastUsedFrames[id] + kSimulationIdleFrames < frame + 1) {
+                    KASHIPAN_EXPECT(lastUsedFrames[id] > lastUsedFrames[last] ||
+                        (lastUsedFrames[id] == lastUsedFrames[last] && id > last));
+                }
+            }
+        }
+        for (uint32_t id = 0; id < kSimulationTextureCount; ++id) {
+            KASHIPAN_EXPECT_EQ(residency.IsResident(id), static_cast<bool>(isResident[id]));
+        }
+    }
+
+    // 追い出しと読み込み直しが実際に起きている場面になっているか
+    KASHIPAN_EXPECT(evictedCount > 0);
+    KASHIPAN_EXPECT(reloadCount > 0);
+}
\ No newline at end of file
@@ -0,0 +1,190 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "Math/TransformBatch.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 端数の処理(4点ずつの残り)を全て通る要素数と、4点ずつの処理を何回か通る要素数
+constexpr size_t kCounts[] = { 0, 1, 2, 3, 4, 5, 6, 7, 13, 64 };
+// 出力先の要素数より後ろに書き込んでいないかを調べるための値
+constexpr float kSentinel = 12345.0f;
+// floatの計算機イプシロン
+constexpr float kEpsilon = std::numeric_limits<float>::epsilon();
+// 1点ずつの変換との許容誤差(ε * Σ|項|の何倍か)。TransformBatch.hに書いた値と揃える
+constexpr float kDotErrorUlps = 8.0f;
+
+/// @brief 変換の種類
+enum class Kind {
+    kPoint,
+    kPointAffine,
+    kDirection,
+};
+
+/// @brief 全ての要素がランダムな射影行列を作る。対角要素を大きくしてwが0に近づかないようにする
+Matrix4x4 RandomMatrix(std::mt19937 &random, bool isAffine) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    Matrix4x4 matrix;
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            matrix.m[row][column] = dist(random) + (row == column ? 4.0f : 0.0f);
+        }
+    }
+    if (isAffine) {
+        matrix.m[0][3] = 0.0f;
+        matrix.m[1][3] = 0.0f;
+        matrix.m[2][3] = 0.0f;
+        matrix.m[3][3] = 1.0f;
+    }
+    return matrix;
+}
+
+std::vector<Vector3> RandomVectors(std::mt19937 &random, size_t count) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<Vector3> vectors(count);
+    for (Vector3 &v : vectors) {
+        v = Vector3(dist(random), dist(random), dist(random));
+    }
+    return vectors;
+}
+
+/// @brief 種類に合わせてまとめて変換する
+void TransformBatch(Kind kind, std::span<const Vector3> in, const Matrix4x4 &matrix, std::span<Vector3> out) {
+    switch (kind) {
+        case Kind::kPoint:
+            Math::TransformPoints(in, matrix, out);
+            break;
+        case Kind::kPointAffine:
+            Math::TransformPointsAffine(in, matrix, out);
+            break;
+        case Kind::kDirection:
+            Math::TransformDirections(in, matrix, out);
+            break;
+    }
+}
+
+/// @brief 種類に合わせてSoAのまままとめて変換する
+void TransformBatchSoA(Kind kind, std::span<const float> inX, std::span<const float> inY, std::span<const float> inZ,
+    const Matrix4x4 &matrix, std::span<float> outX, std::span<float> outY, std::span<float> outZ) {
+    switch (kind) {
+        case Kind::kPoint:
+            Math::TransformPointsSoA(inX, inY, inZ, matrix, outX, outY, outZ);
+            break;
+        case Kind::kPointAffine:
+            Math::TransformPointsAffineSoA(inX, inY, inZ, matrix, outX, outY, outZ);
+            break;
+        case Kind::kDirection:
+            Math::TransformDirectionsSoA(inX, inY, inZ, matrix, outX, outY, outZ);
+            break;
+    }
+}
+
+/// @brief 行ベクトル(v, w)と行列のcolumn列目の積和の項の絶対値の和
+float SumAbsTerms(const Vector3 &v, float w, const Matrix4x4 &m, int column) {
+    return std::abs(v.x * m.m[0][column]) + std::abs(v.y * m.m[1][column]) +
+        std::abs(v.z * m.m[2][column]) + std::abs(w * m.m[3][column]);
+}
+
+/// @brief まとめて変換した結果が、1点ずつの変換と許容誤差の範囲で一致するか。FMAを使わないビルドではビット単位で比べる
+bool IsSameAsSingle(Kind kind, const Vector3 &v, const Matrix4x4 &m, const Vector3 &result) {
+    const Vector3 expected = kind == Kind::kDirection ? v.TransformDirection(m) : v.Transform(m);
+    const float w = kind == Kind::kPoint ? v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + m.m[3][3] : 1.0f;
+    const float results[] = { result.x, result.y, result.z };
+    const float expecteds[] = { expected.x, expected.y, expected.z };
+    for (int i = 0; i < 3; ++i) {
+        // 位置はwで割るので、分子とwの誤差が割った後の値に伝わる分と、割り算の丸めの分を足す
+        const float value = std::abs(expecteds[i]);
+        float magnitude = SumAbsTerms(v, kind == Kind::kDirection ? 0.0f : 1.0f, m, i);
+        if (kind == Kind::kPoint) {
+            magnitude = (magnitude + value * SumAbsTerms(v, 1.0f, m, 3)) / std::abs(w) + value;
+        }
+        if (std::abs(results[i] - expecteds[i]) > kDotErrorUlps * kEpsilon * magnitude) {
+            return false;
+        }
+#if !defined(__FMA__)
+        if (results[i] != expecteds[i]) {
+            return false;
+        }
+#endif
+    }
+    return true;
+}
+
+} // namespace
+
+KASHIPAN_TEST(Math_TransformBatchMatchesSingleForEveryTailSize) {
+    std::mt19937 random(20240611);
+    for (Kind kind : { Kind::kPoint, Kind::kPointAffine, Kind::kDirection }) {
+        const Matrix4x4 matrix = RandomMatrix(random, kind == Kind::kPointAffine);
+        for (size_t count : kCounts) {
+            const std::vector<Vector3> in = RandomVectors(random, count);
+            // 出力先は1つ多く取り、要素数より後ろが書き換わらないことも調べる
+            std::vector<Vector3> out(count + 1, Vector3(kSentinel));
+            TransformBatch(kind, in, matrix, out);
+            for (size_t i = 0; i < count; ++i) {
+                KASHIPAN_EXPECT(IsSameAsSingle(kind, in[i], matrix, out[i]));
+            }
+            KASHIPAN_EXPECT(out[count] == Vector3(kSentinel));
+        }
+    }
+}
+
+KASHIPAN_TEST(Math_TransformBatchInPlaceMatchesSeparateOutput) {
+    std::mt19937 random(7);
+    for (Kind kind : { Kind::kPoint, Kind::kPointAffine, Kind::kDirection }) {
+        const Matrix4x4 matrix = RandomMatrix(random, kind == Kind::kPointAffine);
+        for (size_t count : kCounts) {
+            const std::vector<Vector3> in = RandomVectors(random, count);
+            std::vector<Vector3> expected(count);
+            TransformBatch(kind, in, matrix, expected);
+
+            // 入力と出力が同じ配列でも、別の配列に出力した場合と同じ結果になる
+            std::vector<Vector3> inPlace = in;
+            TransformBatch(kind, inPlace, matrix, inPlace);
+            KASHIPAN_EXPECT(inPlace == expected);
+
+            std::vector<float> x(count), y(count), z(count);
+            for (size_t i = 0; i < count; ++i) {
+                x[i] = in[i].x;
+                y[i] = in[i].y;
+                z[i] = in[i].z;
+            }
+            TransformBatchSoA(kind, x, y, z, matrix, x, y, z);
+            for (size_t i = 0; i < count; ++i) {
+                KASHIPAN_EXPECT(Vector3(x[i], y[i], z[i]) == expected[i]);
+            }
+        }
+    }
+}
+
+KASHIPAN_TEST(Math_TransformBatchSoAMatchesAoS) {
+    std::mt19937 random(99);
+    for (Kind kind : { Kind::kPoint, Kind::kPointAffine, Kind::kDirection }) {
+        const Matrix4x4 matrix = RandomMatrix(random, kind == Kind::kPointAffine);
+        for (size_t count : kCounts) {
+            const std::vector<Vector3> in = RandomVectors(random, count);
+            std::vector<Vector3> aos(count);
+            TransformBatch(kind, in, matrix, aos);
+
+            std::vector<float> x(count), y(count), z(count);
+            for (size_t i = 0; i < count; ++i) {
+                x[i] = in[i].x;
+                y[i] = in[i].y;
+                z[i] = in[i].z;
+            }
+            // 出力先は1つ多く取り、要素数より後ろが書き換わらないことも調べる
+            std::vector<float> outX(count + 1, kSentinel), outY(count + 1, kSentinel), outZ(count + 1, kSentinel);
+            TransformBatchSoA(kind, x, y, z, matrix, outX, outY, outZ);
+            // AoSとSoAは同じ計算をするので、ビルドの設定によらずビット単位で一致する
+            for (size_t i = 0; i < count; ++i) {
+                KASHIPAN_EXPECT(Vector3(outX[i], outY[i], outZ[i]) == aos[i]);
+            }
+            KASHIPAN_EXPECT(outX[count] == kSentinel && outY[count] == kSentinel && outZ[count] == kSentinel);
+        }
+    }
+}
\ No newline at end of file
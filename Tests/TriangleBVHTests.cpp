@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "Math/Collider.h"
+#include "Math/TriangleBVH.h"
+#include "Math/MathObjects/Lines.h"
+#include "Math/MathObjects/Sphere.h"
+#include "Math/MathObjects/Triangle.h"
+
+using namespace KashipanEngine;
+using namespace KashipanEngine::Math;
+
+namespace {
+
+// メッシュの三角形の数と、三角形の中心を置く範囲・三角形の大きさ
+constexpr uint32_t kTriangleCount = 500;
+constexpr float kMeshExtent = 8.0f;
+constexpr float kTriangleSize = 1.5f;
+// メッシュごとに調べる半直線・線分・球の数
+constexpr int kQueryCount = 300;
+// 時刻と位置の許容誤差(値の大きさに対する割合)
+constexpr float kRelativeTolerance = 1e-4f;
+// 球の判定で、境界からこの割合より近い三角形はどちらの結果でも良いことにする
+constexpr float kSphereBoundaryMargin = 1e-4f;
+
+/// @brief 頂点の位置とインデックスのメッシュ
+struct Mesh {
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+
+    Triangle GetTriangle(uint32_t triangle) const {
+        return Triangle(positions[indices[triangle * 3 + 0]], positions[indices[triangle * 3 + 1]], positions[indices[triangle * 3 + 2]]);
+    }
+    uint32_t GetTriangleCount() const {
+        return static_cast<uint32_t>(indices.size() / 3);
+    }
+};
+
+Vector3 RandomVector(std::mt19937 &random, float extent) {
+    std::uniform_real_distribution<float> dist(-extent, extent);
+    return Vector3(dist(random), dist(random), dist(random));
+}
+
+/// @brief ばらばらの向きの三角形を散らしたメッシュを作る。頂点は順番を混ぜてインデックスで参照する
+Mesh RandomMesh(std::mt19937 &random) {
+    Mesh mesh;
+    for (uint32_t i = 0; i < kTriangleCount; ++i) {
+        const Vector3 center = RandomVector(random, kMeshExtent);
+        for (int j = 0; j < 3; ++j) {
+            mesh.positions.push_back(center + RandomVector(random, kTriangleSize));
+        }
+    }
+    std::vector<uint32_t> order(mesh.positions.size());
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), random);
+    std::vector<Vector3> shuffled(mesh.positions.size());
+    mesh.indices.resize(mesh.positions.size());
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        shuffled[order[i]] = mesh.positions[i];
+        mesh.indices[i] = order[i];
+    }
+    mesh.positions = std::move(shuffled);
+    return mesh;
+}
+
+/// @brief 半直線・線分が三角形の平面と交わる時刻
+float GetPlaneTime(const Triangle &triangle, const Vector3 &origin, const Vector3 &diff) {
+    const Vector3 normal = (triangle.vertices[1] - triangle.vertices[0]).Cross(triangle.vertices[2] - triangle.vertices[0]);
+    return normal.Dot(triangle.vertices[0] - origin) / normal.Dot(diff);
+}
+
+/// @brief 全ての三角形をMath::Colliderで調べ、最も近い交点の時刻を求める
+/// @return 当たったかどうか
+bool BruteForceRaycast(const Mesh &mesh, const Vector3 &origin, const Vector3 &diff, bool isSegment, float &outTime) {
+    bool isHit = false;
+    outTime = std::numeric_limits<float>::infinity();
+    for (uint32_t i = 0; i < mesh.GetTriangleCount(); ++i) {
+        const Triangle triangle = mesh.GetTriangle(i);
+        const bool isTriangleHit = isSegment ?
+            Collider::IsCollision(triangle, Segment{ origin, diff }) :
+            Collider::IsCollision(triangle, Ray{ origin, diff });
+        if (isTriangleHit) {
+            isHit = true;
+            outTime = std::min(outTime, GetPlaneTime(triangle, origin, diff));
+        }
+    }
+    return isHit;
+}
+
+/// @brief 線分上で点に最も近い点までの距離の2乗
+float DistanceSquaredToSegment(const Vector3 &a, const Vector3 &b, const Vector3 &point) {
+    const Vector3 ab = b - a;
+    const float t = std::clamp((point - a).Dot(ab) / ab.LengthSquared(), 0.0f, 1.0f);
+    return (a + ab * t - point).LengthSquared();
+}
+
+/// @brief 点と三角形の距離の2乗。平面に下ろした点が三角形の中ならその距離、外なら3辺までの距離の最小
+float DistanceSquaredToTriangle(const Triangle &triangle, const Vector3 &point) {
+    const Vector3 &a = triangle.vertices[0];
+    const Vector3 &b = triangle.vertices[1];
+    const Vector3 &c = triangle.vertices[2];
+    const Vector3 normal = (b - a).Cross(c - a);
+    const float distance = normal.Dot(point - a) / normal.Length();
+    const Vector3 projected = point - normal * (normal.Dot(point - a) / normal.LengthSquared());
+    const bool isInside =
+        (b - a).Cross(projected - a).Dot(normal) >= 0.0f &&
+        (c - b).Cross(projected - b).Dot(normal) >= 0.0f &&
+        (a - c).Cross(projected - c).Dot(normal) >= 0.0f;
+    if (isInside) {
+        return distance * distance;
+    }
+    return std::min({ DistanceSquaredToSegment(a, b, point), DistanceSquaredToSegment(b, c, point), DistanceSquaredToSegment(c, a, point) });
+}
+
+/// @brief BVHの結果を総当たりと比べる
+void ExpectSameAsBruteForce(const TriangleBVH &bvh, const Mesh &mesh, std::mt19937 &random) {
+    std::uniform_real_distribution<float> distRadius(0.2f, 2.0f);
+    std::uniform_real_distribution<float> distLength(0.2f, 1.0f);
+    std::vector<uint32_t> overlapping;
+    for (int query = 0; query < kQueryCount; ++query) {
+        // メッシュの外から中に向けて撃つ(半分くらいは当たる)
+        const Vector3 origin = RandomVector(random, kMeshExtent * 2.0f);
+        const Vector3 target = RandomVector(random, kMeshExtent);
+        for (bool isSegment : { false, true }) {
+            const Vector3 diff = (target - origin) * (isSegment ? distLength(random) : 1.0f);
+            float expectedTime = 0.0f;
+            const bool isExpectedHit = BruteForceRaycast(mesh, origin, diff, isSegment, expectedTime);
+
+            TriangleBVH::RaycastHit hit{};
+            const bool isHit = isSegment ? bvh.Raycast(Segment{ origin, diff }, hit) : bvh.Raycast(Ray{ origin, diff }, hit);
+            const bool isAnyHit = isSegment ? bvh.IsCollision(Segment{ origin, diff }) : bvh.IsCollision(Ray{ origin, diff });
+            KASHIPAN_EXPECT_EQ(isHit, isExpectedHit);
+            KASHIPAN_EXPECT_EQ(isAnyHit, isExpectedHit);
+            if (!isHit || !isExpectedHit) {
+                continue;
+            }
+            // 最も近い交点の時刻と、当たった三角形の上の点が一致する(同じ時刻の三角形が複数あってもよいように三角形の番号は比べない)
+            KASHIPAN_EXPECT_NEAR(hit.time, expectedTime, kRelativeTolerance * (1.0f + expectedTime));
+            KASHIPAN_REQUIRE(hit.triangle < mesh.GetTriangleCount());
+            const Triangle triangle = mesh.GetTriangle(hit.triangle);
+            KASHIPAN_EXPECT_NEAR(GetPlaneTime(triangle, origin, diff), expectedTime, kRelativeTolerance * (1.0f + expectedTime));
+            const Vector3 point = origin + diff * hit.time;
+            const Vector3 barycentric = triangle.vertices[0] +
+                (triangle.vertices[1] - triangle.vertices[0]) * hit.u + (triangle.vertices[2] - triangle.vertices[0]) * hit.v;
+            KASHIPAN_EXPECT_NEAR((point - barycentric).Length(), 0.0f, kRelativeTolerance * (1.0f + point.Length()));
+        }
+
+        // 球と重なる三角形。境界のすぐ近くの三角形は、どちらの結果でも良いことにする
+        const Sphere sphere(RandomVector(random, kMeshExtent), distRadius(random));
+        overlapping.clear();
+        bvh.GetOverlappingTriangles(sphere, overlapping);
+        std::sort(overlapping.begin(), overlapping.end());
+        KASHIPAN_EXPECT(std::adjacent_find(overlapping.begin(), overlapping.end()) == overlapping.end());
+        bool isSureOverlap = false;
+        bool isSureSeparate = true;
+        for (uint32_t i = 0; i < mesh.GetTriangleCount(); ++i) {
+            const float distance = std::sqrt(DistanceSquaredToTriangle(mesh.GetTriangle(i), sphere.center));
+            const bool isFound = std::binary_search(overlapping.begin(), overlapping.end(), i);
+            if (distance < sphere.radius * (1.0f - kSphereBoundaryMargin)) {
+                KASHIPAN_EXPECT(isFound);
+                isSureOverlap = true;
+            } else if (distance > sphere.radius * (1.0f + kSphereBoundaryMargin)) {
+                KASHIPAN_EXPECT(!isFound);
+            } else {
+                isSureSeparate = false;
+            }
+        }
+        if (isSureOverlap || isSureSeparate) {
+            KASHIPAN_EXPECT_EQ(bvh.IsCollision(sphere), isSureOverlap);
+        }
+    }
+}
+
+} // namespace
+
+KASHIPAN_TEST(BVH_QueriesMatchBruteForce) {
+    std::mt19937 random(31415);
+    for (int meshIndex = 0; meshIndex < 3; ++meshIndex) {
+        const Mesh mesh = RandomMesh(random);
+        TriangleBVH bvh;
+        bvh.Build(mesh.positions, mesh.indices);
+        KASHIPAN_EXPECT_EQ(bvh.GetTriangleCount(), static_cast<size_t>(kTriangleCount));
+        ExpectSameAsBruteForce(bvh, mesh, random);
+    }
+}
+
+KASHIPAN_TEST(BVH_RefitMatchesBruteForceAfterVerticesMove) {
+    std::mt19937 random(2718);
+    Mesh mesh = RandomMesh(random);
+    TriangleBVH bvh;
+    bvh.Build(mesh.positions, mesh.indices);
+    const size_t nodeCount = bvh.GetNodeCount();
+
+    // 頂点を動かして木の形はそのままで作り直す(元の分割とは合わなくなるくらい大きく動かす)
+    for (int step = 0; step < 3; ++step) {
+        for (Vector3 &position : mesh.positions) {
+            position += RandomVector(random, 2.0f);
+        }
+        bvh.Refit(mesh.positions);
+        KASHIPAN_EXPECT_EQ(bvh.GetNodeCount(), nodeCount);
+        ExpectSameAsBruteForce(bvh, mesh, random);
+    }
+}
+
+KASHIPAN_TEST(BVH_EmptyMeshNeverHits) {
+    TriangleBVH bvh;
+    bvh.Build(std::span<const Vector3>(), std::span<const uint32_t>());
+    TriangleBVH::RaycastHit hit{};
+    const Ray ray{ Vector3(0.0f, 0.0f, -10.0f), Vector3(0.0f, 0.0f, 1.0f) };
+    KASHIPAN_EXPECT(!bvh.Raycast(ray, hit));
+    KASHIPAN_EXPECT(!bvh.IsCollision(ray));
+    KASHIPAN_EXPECT(!bvh.IsCollision(Sphere(Vector3(0.0f, 0.0f, 0.0f), 100.0f)));
+    std::vector<uint32_t> overlapping;
+    KASHIPAN_EXPECT_EQ(bvh.GetOverlappingTriangles(Sphere(Vector3(0.0f, 0.0f, 0.0f), 100.0f), overlapping), 0u);
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include <cstring>
+#include <vector>
+
+#include "Test.h"
+#include "Common/VertexShadow.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 場面に出すスプライトとビルボードの数、進めるフレーム数
+constexpr uint32_t kObjectCount = 100;
+constexpr int kFrameCount = 60;
+// ライティングが無効なときの法線(SpriteとBillBoardが渡すもの)
+const Vector3 kUnlitNormal = { 0.0f, 0.0f, -1.0f };
+
+/// @brief 頂点の控えと、転送先の頂点バッファの代わり
+struct ShadowObject {
+    VertexShadow shadow;
+    std::vector<VertexData> vertexBuffer;
+    bool enableLighting = false;
+    NormalType normalType = kNormalTypeVertex;
+
+    /// @brief Sprite::CreateMeshと同じく、4頂点の板を控えに作る
+    void CreateQuad(float width, float height) {
+        shadow.Create(4);
+        vertexBuffer.assign(4, VertexData{});
+        SetQuadSize(width, height);
+    }
+    /// @brief 板の大きさを変える
+    void SetQuadSize(float width, float height) {
+        auto &vertices = shadow.Edit();
+        vertices[0].position = { 0.0f,  height, 0.0f, 1.0f };
+        vertices[1].position = { 0.0f,  0.0f,   0.0f, 1.0f };
+        vertices[2].position = { width, height, 0.0f, 1.0f };
+        vertices[3].position = { width, 0.0f,   0.0f, 1.0f };
+    }
+    /// @brief SpriteやBillBoardのDrawと同じく、法線を更新して変更があれば転送する
+    void Draw() {
+        shadow.UpdateNormals(enableLighting, normalType, kUnlitNormal);
+        shadow.Transfer(vertexBuffer.data());
+    }
+    /// @brief 頂点バッファの中身が控えと一致するか
+    bool IsBufferUpToDate() const {
+        const auto &vertices = shadow.GetVertices();
+        return std::memcmp(vertexBuffer.data(), vertices.data(), sizeof(VertexData) * vertices.size()) == 0;
+    }
+};
+
+/// @brief 全てのオブジェクトを1フレーム分描画し、その間の転送回数を返す
+uint32_t DrawFrame(std::vector<ShadowObject> &objects) {
+    VertexShadow::ResetTransferCount();
+    for (auto &object : objects) {
+        object.Draw();
+    }
+    return VertexShadow::GetTransferCount();
+}
+
+} // namespace
+
+KASHIPAN_TEST(Object_StaticSpritesTransferOnlyOnce) {
+    std::vector<ShadowObject> sprites(kObjectCount);
+    for (uint32_t i = 0; i < kObjectCount; ++i) {
+        sprites[i].CreateQuad(16.0f + static_cast<float>(i), 32.0f);
+    }
+
+    // 作った直後のフレームだけ転送し、何も変えなければ以降は転送しない
+    KASHIPAN_EXPECT_EQ(DrawFrame(sprites), kObjectCount);
+    for (int frame = 1; frame < kFrameCount; ++frame) {
+        KASHIPAN_EXPECT_EQ(DrawFrame(sprites), 0u);
+    }
+    for (const auto &sprite : sprites) {
+        KASHIPAN_EXPECT(sprite.IsBufferUpToDate());
+        KASHIPAN_EXPECT(sprite.shadow.GetVertices()[0].normal == kUnlitNormal);
+    }
+}
+
+KASHIPAN_TEST(Object_ChangedSpritesTransferOncePerChange) {
+    std::vector<ShadowObject> sprites(kObjectCount);
+    for (auto &sprite : sprites) {
+        sprite.CreateQuad(64.0f, 64.0f);
+    }
+    KASHIPAN_EXPECT_EQ(DrawFrame(sprites), kObjectCount);
+
+    for (int frame = 1; frame < kFrameCount; ++frame) {
+        uint32_t expectedCount = 0;
+        for (uint32_t i = 0; i < kObjectCount; ++i) {
+            ShadowObject &sprite = sprites[i];
+            if (i % 4 == 0 && frame % 10 == 0) {
+                // ライティングを切り替える(法線が変わる)
+                sprite.enableLighting = !sprite.enableLighting;
+                ++expectedCount;
+            } else if (i % 4 == 1 && frame % 15 == 0) {
+                // 大きさを変える(頂点を編集する)
+                sprite.SetQuadSize(64.0f + static_cast<float>(frame), 64.0f);
+                ++expectedCount;
+            } else if (i % 4 == 2 && frame % 5 == 0) {
+                // ライティングが無効な間は法線のタイプは法線に関係しないが、設定が変わったので計算し直す
+                sprite.normalType = sprite.normalType == kNormalTypeVertex ? kNormalTypeFace : kNormalTypeVertex;
+                ++expectedCount;
+            } else if (i % 4 == 3) {
+                // 同じ値を設定し直しても転送しない
+                sprite.enableLighting = false;
+                sprite.normalType = kNormalTypeVertex;
+            }
+        }
+        KASHIPAN_EXPECT_EQ(DrawFrame(sprites), expectedCount);
+    }
+    for (const auto &sprite : sprites) {
+        KASHIPAN_EXPECT(sprite.IsBufferUpToDate());
+    }
+}
+
+KASHIPAN_TEST(Object_BillboardsTransferOnlyWhenNormalsChange) {
+    // BillBoardは頂点を編集せず、向きはワールド行列で変えるので、法線の設定が変わった時だけ転送する
+    std::vector<ShadowObject> billboards(kObjectCount);
+    for (auto &billboard : billboards) {
+        billboard.shadow.Create(4);
+        billboard.vertexBuffer.assign(4, VertexData{});
+        billboard.enableLighting = true;
+    }
+    KASHIPAN_EXPECT_EQ(DrawFrame(billboards), kObjectCount);
+    for (int frame = 1; frame < kFrameCount; ++frame) {
+        KASHIPAN_EXPECT_EQ(DrawFrame(billboards), 0u);
+    }
+
+    // 半分を面の法線にすると、そのフレームだけその数を転送する
+    for (uint32_t i = 0; i < kObjectCount; i += 2) {
+        billboards[i].normalType = kNormalTypeFace;
+    }
+    KASHIPAN_EXPECT_EQ(DrawFrame(billboards), kObjectCount / 2);
+    KASHIPAN_EXPECT_EQ(DrawFrame(billboards), 0u);
+    for (const auto &billboard : billboards) {
+        KASHIPAN_EXPECT(billboard.IsBufferUpToDate());
+    }
+}
+
+KASHIPAN_TEST(Object_ShadowNormalsFollowLightingAndNormalType) {
+    ShadowObject sprite;
+    sprite.CreateQuad(8.0f, 4.0f);
+
+    sprite.Draw();
+    for (const auto &vertex : sprite.shadow.GetVertices()) {
+        KASHIPAN_EXPECT(vertex.normal == kUnlitNormal);
+    }
+
+    // 頂点の法線は位置をそのまま使う
+    sprite.enableLighting = true;
+    sprite.Draw();
+    for (const auto &vertex : sprite.shadow.GetVertices()) {
+        KASHIPAN_EXPECT(vertex.normal == Vector3(vertex.position));
+    }
+
+    // 面の法線は最初の3頂点から計算し、全ての頂点で同じになる
+    sprite.normalType = kNormalTypeFace;
+    sprite.Draw();
+    const auto &vertices = sprite.shadow.GetVertices();
+    const Vector3 expected = (Vector3(vertices[1].position) - Vector3(vertices[0].position))
+        .Cross(Vector3(vertices[2].position) - Vector3(vertices[1].position)).Normalize();
+    KASHIPAN_EXPECT_NEAR(expected.Length(), 1.0f, 1e-6);
+    for (const auto &vertex : vertices) {
+        KASHIPAN_EXPECT(vertex.normal == expected);
+    }
+    KASHIPAN_EXPECT(sprite.IsBufferUpToDate());
+    KASHIPAN_EXPECT(!sprite.shadow.IsDirty());
+}
\ No newline at end of file